@@ -44,6 +44,10 @@ typedef struct netdev_tap {
     int tap_fd;                         /**< host file descriptor for the TAP */
     uint8_t addr[ETHERNET_ADDR_LEN];    /**< The MAC address of the TAP */
     uint8_t promiscous;                 /**< Flag for promiscous mode */
+    uint8_t csum_offload;               /**< Flag for checksum offloading,
+                                             only available on Linux */
+    uint8_t tx_csum;                    /**< Flag to offload the checksum of
+                                             the next frame sent */
 } netdev_tap_t;
 
 /**
@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_netdev
+ * @{
+ *
+ * @file
+ * @brief       Checksum offloading of @ref netdev_tap via virtio-net headers
+ *
+ * Only available on Linux. Only upper-layer headers directly following the
+ * IPv6 header are offloaded (see @ref NETOPT_CSUM_OFFLOAD).
+ *
+ * @author  Martine Lenders <m.lenders@fu-berlin.de>
+ */
+#ifndef NETDEV_TAP_VNET_H
+#define NETDEV_TAP_VNET_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <linux/virtio_net.h>
+
+#include "iolist.h"
+#include "net/netdev/eth.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Prepares an outgoing frame for checksum offloading
+ *
+ * Sets up @p vnet and writes the pseudo-header checksum the host expects
+ * into the checksum field of the upper-layer header.
+ *
+ * @param[in] iolist    The Ethernet frame.
+ * @param[out] vnet     The virtio-net header for the frame.
+ * @param[out] orig     The previous content of the checksum field.
+ *
+ * @return  The checksum field in @p iolist. The packet snips behind
+ *          @p iolist may be shared with other frames, e.g. for multicast
+ *          on several interfaces, so it needs to be set back to @p orig
+ *          once the frame was sent.
+ * @return  NULL, if the checksum of the frame can't be offloaded. @p vnet
+ *          is left untouched in that case.
+ */
+uint8_t *netdev_tap_vnet_send_csum(const iolist_t *iolist,
+                                   struct virtio_net_hdr *vnet,
+                                   uint16_t *orig);
+
+/**
+ * @brief   Handles the checksum information of an incoming frame
+ *
+ * Completes checksums the host left to us, so forwarded frames stay
+ * correct.
+ *
+ * @param[in] vnet      The virtio-net header of the frame.
+ * @param[in,out] buf   The Ethernet frame.
+ * @param[in] len       Length of @p buf.
+ * @param[out] info     Reports the verified checksum via
+ *                      @ref NETDEV_ETH_RX_INFO_FLAG_CSUM_VALID. May be NULL.
+ */
+void netdev_tap_vnet_recv_csum(const struct virtio_net_hdr *vnet,
+                               uint8_t *buf, size_t len,
+                               netdev_eth_rx_info_t *info);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NETDEV_TAP_VNET_H */
+/** @} */
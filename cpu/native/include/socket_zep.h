@@ -23,6 +23,8 @@
 #ifndef SOCKET_ZEP_H
 #define SOCKET_ZEP_H
 
+#include <stdbool.h>
+
 #include "net/netdev.h"
 #include "net/netdev/ieee802154.h"
 #include "net/zep.h"
@@ -31,6 +33,17 @@
 extern "C" {
 #endif
 
+/**
+ * @brief   Frame loss model of a ZEP device
+ *
+ * @param[in] iolist    The frame about to be sent.
+ * @param[in] arg       Argument given to socket_zep_set_loss_cb().
+ *
+ * @return  true, if the frame is lost.
+ * @return  false, if the frame is sent.
+ */
+typedef bool (*socket_zep_loss_cb_t)(const iolist_t *iolist, void *arg);
+
 /**
  * @brief   ZEP device state
  */
@@ -48,6 +61,8 @@ typedef struct {
      */
     uint8_t snd_hdr_buf[sizeof(zep_v2_data_hdr_t)];
     uint16_t chksum_buf;            /**< buffer for send checksum calculation */
+    socket_zep_loss_cb_t loss_cb;   /**< frame loss model (may be NULL) */
+    void *loss_arg;                 /**< argument for socket_zep_t::loss_cb */
 } socket_zep_t;
 
 /**
@@ -75,6 +90,24 @@ void socket_zep_setup(socket_zep_t *dev, const socket_zep_params_t *params);
  */
 void socket_zep_cleanup(socket_zep_t *dev);
 
+/**
+ * @brief   Sets a frame loss model for sending
+ *
+ * Frames for which @p cb returns true are not written to the socket, but
+ * reported as sent to the upper layer. This allows for deterministic tests
+ * of protocols that recover from frame loss.
+ *
+ * @param[in] dev   A socket_zep device handle.
+ * @param[in] cb    The loss model. NULL to send all frames.
+ * @param[in] arg   Argument for @p cb.
+ */
+static inline void socket_zep_set_loss_cb(socket_zep_t *dev,
+                                          socket_zep_loss_cb_t cb, void *arg)
+{
+    dev->loss_arg = arg;
+    dev->loss_cb = cb;
+}
+
 #ifdef __cplusplus
 }
 #endif
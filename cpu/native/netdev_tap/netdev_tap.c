@@ -46,6 +46,8 @@
 #include <net/if.h>
 #include <linux/if_tun.h>
 #include <linux/if_ether.h>
+#include <linux/virtio_net.h>
+#include "netdev_tap_vnet.h"
 #endif
 
 #include "native_internal.h"
@@ -64,6 +66,14 @@
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
+#ifdef IFF_VNET_HDR
+/* every frame is preceded by a virtio-net header, which carries the
+ * checksum offloading information */
+#define _VNET_HDR_LEN   (sizeof(struct virtio_net_hdr))
+#else
+#define _VNET_HDR_LEN   (0U)
+#endif
+
 /* netdev interface */
 static int _init(netdev_t *netdev);
 static int _send(netdev_t *netdev, const iolist_t *iolist);
@@ -94,6 +104,33 @@ static inline int _set_promiscous(netdev_t *netdev, int value)
     return value;
 }
 
+#ifdef IFF_VNET_HDR
+static int _set_csum_offload(netdev_t *netdev, bool enable)
+{
+    netdev_tap_t *dev = (netdev_tap_t*)netdev;
+    /* allows the host to hand us frames with incomplete checksums */
+    unsigned long offloads = (enable) ? TUN_F_CSUM : 0;
+
+    if (real_ioctl(dev->tap_fd, TUNSETOFFLOAD, offloads) == -1) {
+        DEBUG("netdev_tap: unable to set offloads: %d\n", errno);
+        return -ENOTSUP;
+    }
+    dev->csum_offload = enable;
+    return sizeof(netopt_enable_t);
+}
+
+static int _set_tx_csum(netdev_t *netdev, bool enable)
+{
+    netdev_tap_t *dev = (netdev_tap_t*)netdev;
+
+    if (enable && !dev->csum_offload) {
+        return -ENOTSUP;
+    }
+    dev->tx_csum = enable;
+    return sizeof(netopt_enable_t);
+}
+#endif
+
 static inline void _isr(netdev_t *netdev)
 {
     if (netdev->event_callback) {
@@ -124,6 +161,14 @@ static int _get(netdev_t *dev, netopt_t opt, void *value, size_t max_len)
             *((bool*)value) = (bool)_get_promiscous(dev);
             res = sizeof(bool);
             break;
+#ifdef IFF_VNET_HDR
+        case NETOPT_CSUM_OFFLOAD:
+            assert(max_len >= sizeof(netopt_enable_t));
+            *((netopt_enable_t *)value) = (((netdev_tap_t *)dev)->csum_offload)
+                                        ? NETOPT_ENABLE : NETOPT_DISABLE;
+            res = sizeof(netopt_enable_t);
+            break;
+#endif
         default:
             res = netdev_eth_get(dev, opt, value, max_len);
             break;
@@ -147,6 +192,18 @@ static int _set(netdev_t *dev, netopt_t opt, const void *value, size_t value_len
             _set_promiscous(dev, ((const bool *)value)[0]);
             res = sizeof(netopt_enable_t);
             break;
+#ifdef IFF_VNET_HDR
+        case NETOPT_CSUM_OFFLOAD:
+            assert(value_len >= sizeof(netopt_enable_t));
+            res = _set_csum_offload(dev, *((const netopt_enable_t *)value) ==
+                                         NETOPT_ENABLE);
+            break;
+        case NETOPT_TX_CSUM_OFFLOAD:
+            assert(value_len >= sizeof(netopt_enable_t));
+            res = _set_tx_csum(dev, *((const netopt_enable_t *)value) ==
+                                    NETOPT_ENABLE);
+            break;
+#endif
         default:
             res = netdev_eth_set(dev, opt, value, value_len);
             break;
@@ -207,7 +264,6 @@ static void _continue_reading(netdev_tap_t *dev)
 static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
 {
     netdev_tap_t *dev = (netdev_tap_t*)netdev;
-    (void)info;
 
     if (!buf) {
         if (len > 0) {
@@ -222,7 +278,7 @@ static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
             }
             */
 
-            static uint8_t nullbuf[ETHERNET_FRAME_LEN];
+            static uint8_t nullbuf[_VNET_HDR_LEN + ETHERNET_FRAME_LEN];
 
             real_read(dev->tap_fd, nullbuf, sizeof(nullbuf));
 
@@ -234,7 +290,21 @@ static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
         return ETHERNET_FRAME_LEN;
     }
 
+#ifdef IFF_VNET_HDR
+    struct virtio_net_hdr vnet;
+    const struct iovec iov[] = {
+        { .iov_base = &vnet, .iov_len = sizeof(vnet) },
+        { .iov_base = buf, .iov_len = len },
+    };
+    int nread = real_readv(dev->tap_fd, iov, 2);
+
+    if (nread > 0) {
+        nread = (nread > (int)sizeof(vnet)) ? (nread - (int)sizeof(vnet)) : 0;
+    }
+#else
+    (void)info;
     int nread = real_read(dev->tap_fd, buf, len);
+#endif
     DEBUG("netdev_tap: read %d bytes\n", nread);
 
     if (nread > 0) {
@@ -254,6 +324,10 @@ static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
 
         _continue_reading(dev);
 
+#ifdef IFF_VNET_HDR
+        netdev_tap_vnet_recv_csum(&vnet, buf, nread,
+                                  (dev->csum_offload) ? info : NULL);
+#endif
         return nread;
     }
     else if (nread == -1) {
@@ -277,12 +351,40 @@ static int _send(netdev_t *netdev, const iolist_t *iolist)
 {
     netdev_tap_t *dev = (netdev_tap_t*)netdev;
 
+#ifdef IFF_VNET_HDR
+    struct virtio_net_hdr vnet = { .gso_type = VIRTIO_NET_HDR_GSO_NONE };
+    struct iovec iov[iolist_count(iolist) + 1];
+    uint8_t *csum_field = NULL;
+    uint16_t csum_orig;
+
+    unsigned n;
+    /* frames not marked by the stack, e.g. forwarded ones, keep their
+     * checksum */
+    if (dev->csum_offload && dev->tx_csum) {
+        csum_field = netdev_tap_vnet_send_csum(iolist, &vnet, &csum_orig);
+    }
+    dev->tx_csum = 0;
+    iov[0].iov_base = &vnet;
+    iov[0].iov_len = sizeof(vnet);
+    iolist_to_iovec(iolist, &iov[1], &n);
+
+    int res = _native_writev(dev->tap_fd, iov, n + 1);
+    if (csum_field != NULL) {
+        /* the upper-layer header may be shared with frames sent over other
+         * interfaces */
+        memcpy(csum_field, &csum_orig, sizeof(csum_orig));
+    }
+    if (res > 0) {
+        res -= sizeof(vnet);
+    }
+#else
     struct iovec iov[iolist_count(iolist)];
 
     unsigned n;
     iolist_to_iovec(iolist, iov, &n);
 
     int res = _native_writev(dev->tap_fd, iov, n);
+#endif
 
     if (netdev->event_callback) {
         netdev->event_callback(netdev, NETDEV_EVENT_TX_COMPLETE);
@@ -333,6 +435,8 @@ static int _init(netdev_t *netdev)
 #endif
     /* initialize device descriptor */
     dev->promiscous = 0;
+    dev->csum_offload = 0;
+    dev->tx_csum = 0;
     /* implicitly create the tap interface */
     if ((dev->tap_fd = real_open(clonedev, O_RDWR | O_NONBLOCK)) == -1) {
         err(EXIT_FAILURE, "open(%s)", clonedev);
@@ -352,6 +456,9 @@ static int _init(netdev_t *netdev)
 #else /* Linux */
     memset(&ifr, 0, sizeof(ifr));
     ifr.ifr_flags = IFF_TAP | IFF_NO_PI;
+#ifdef IFF_VNET_HDR
+    ifr.ifr_flags |= IFF_VNET_HDR;
+#endif
     strncpy(ifr.ifr_name, name, IFNAMSIZ);
     if (real_ioctl(dev->tap_fd, TUNSETIFF, (void *)&ifr) == -1) {
         _native_in_syscall++;
@@ -375,6 +482,11 @@ static int _init(netdev_t *netdev)
 
     /* change mac addr so it differs from what the host is using */
     dev->addr[5]++;
+
+#ifdef IFF_VNET_HDR
+    /* use checksum offloading by default, if the host supports it */
+    _set_csum_offload(netdev, true);
+#endif
 #endif
     DEBUG("gnrc_tapnet_init(): dev->addr = %02x:%02x:%02x:%02x:%02x:%02x\n",
             dev->addr[0], dev->addr[1], dev->addr[2],
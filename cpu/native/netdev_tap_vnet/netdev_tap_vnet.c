@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @author  Martine Lenders <m.lenders@fu-berlin.de>
+ */
+
+#include <stddef.h>
+#include <string.h>
+
+/* needs to be included before native's declarations of ntohl etc. */
+#include "byteorder.h"
+
+#include "net/ethernet/hdr.h"
+#include "net/ethertype.h"
+#include "net/icmpv6.h"
+#include "net/inet_csum.h"
+#include "net/ipv6/hdr.h"
+#include "net/protnum.h"
+#include "net/tcp.h"
+#include "net/udp.h"
+
+#include "netdev_tap_vnet.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+/* gets len bytes at offset of the frame, if they are in a single entry */
+static uint8_t *_iol_get(const iolist_t *iolist, size_t offset, size_t len)
+{
+    for (; iolist != NULL; iolist = iolist->iol_next) {
+        if (offset < iolist->iol_len) {
+            return ((offset + len) <= iolist->iol_len)
+                   ? ((uint8_t *)iolist->iol_base) + offset : NULL;
+        }
+        offset -= iolist->iol_len;
+    }
+    return NULL;
+}
+
+/* offset of the checksum field in upper-layer headers, 0 if there is none */
+static size_t _csum_offset(uint8_t nh)
+{
+    switch (nh) {
+        case PROTNUM_ICMPV6:
+            return offsetof(icmpv6_hdr_t, csum);
+        case PROTNUM_TCP:
+            return offsetof(tcp_hdr_t, checksum);
+        case PROTNUM_UDP:
+            return offsetof(udp_hdr_t, checksum);
+        default:
+            return 0;
+    }
+}
+
+uint8_t *netdev_tap_vnet_send_csum(const iolist_t *iolist,
+                                   struct virtio_net_hdr *vnet,
+                                   uint16_t *orig)
+{
+    const size_t start = sizeof(ethernet_hdr_t) + sizeof(ipv6_hdr_t);
+    ethernet_hdr_t *eth;
+    ipv6_hdr_t *ipv6;
+    uint8_t *field;
+    uint32_t sum;
+    size_t offset;
+
+    eth = (ethernet_hdr_t *)_iol_get(iolist, 0, sizeof(ethernet_hdr_t));
+    if ((eth == NULL) || (byteorder_ntohs(eth->type) != ETHERTYPE_IPV6)) {
+        return NULL;
+    }
+    ipv6 = (ipv6_hdr_t *)_iol_get(iolist, sizeof(ethernet_hdr_t),
+                                  sizeof(ipv6_hdr_t));
+    if ((ipv6 == NULL) || ((offset = _csum_offset(ipv6->nh)) == 0)) {
+        return NULL;
+    }
+    field = _iol_get(iolist, start + offset, sizeof(network_uint16_t));
+    if (field == NULL) {
+        DEBUG("netdev_tap_vnet: checksum field is split, can't offload\n");
+        return NULL;
+    }
+    /* the host sums up from csum_start on into the pseudo-header checksum
+     * it expects in the checksum field */
+    sum = inet_csum(0, ipv6->src.u8, 2 * sizeof(ipv6_addr_t));
+    sum += byteorder_ntohs(ipv6->len) + ipv6->nh;
+    while (sum >> 16) {
+        sum = (sum & 0xffff) + (sum >> 16);
+    }
+    memcpy(orig, field, sizeof(*orig));
+    field[0] = (uint8_t)(sum >> 8);
+    field[1] = (uint8_t)sum;
+    vnet->flags = VIRTIO_NET_HDR_F_NEEDS_CSUM;
+    vnet->csum_start = start;
+    vnet->csum_offset = offset;
+    return field;
+}
+
+void netdev_tap_vnet_recv_csum(const struct virtio_net_hdr *vnet,
+                               uint8_t *buf, size_t len,
+                               netdev_eth_rx_info_t *info)
+{
+    if (vnet->flags & VIRTIO_NET_HDR_F_NEEDS_CSUM) {
+        /* frame comes from the host's own stack that left the checksum to
+         * us: complete it, in case the frame is forwarded */
+        size_t start = vnet->csum_start;
+        size_t pos = start + vnet->csum_offset;
+        uint16_t csum;
+
+        if ((pos + sizeof(network_uint16_t)) > len) {
+            return;
+        }
+        csum = ~inet_csum(0, &buf[start], len - start);
+        if (csum == 0) {
+            csum = 0xffff;
+        }
+        buf[pos] = (uint8_t)(csum >> 8);
+        buf[pos + 1] = (uint8_t)csum;
+    }
+    else if (!(vnet->flags & VIRTIO_NET_HDR_F_DATA_VALID)) {
+        return;
+    }
+    if (info != NULL) {
+        info->flags |= NETDEV_ETH_RX_INFO_FLAG_CSUM_VALID;
+    }
+}
+
+/** @} */
@@ -114,7 +114,16 @@ static int _send(netdev_t *netdev, const iolist_t *iolist)
         netdev->event_callback(netdev, NETDEV_EVENT_ISR);
         thread_yield();
     }
-    res = writev(dev->sock_fd, v, n + 2);
+    if ((dev->loss_cb != NULL) && dev->loss_cb(iolist, dev->loss_arg)) {
+        DEBUG("socket_zep::send: frame lost\n");
+        res = v[0].iov_len + v[n + 1].iov_len;
+        for (unsigned i = 1; i <= n; i++) {
+            res += v[i].iov_len;
+        }
+    }
+    else {
+        res = writev(dev->sock_fd, v, n + 2);
+    }
     if (res < 0) {
         DEBUG("socket_zep::send: error writing packet: %s\n", strerror(errno));
         return res;
@@ -29,6 +29,24 @@
 extern "C" {
 #endif
 
+/**
+ * @brief   Upper-layer checksum of the received frame was verified by the
+ *          device
+ *
+ * @see     @ref NETOPT_CSUM_OFFLOAD
+ */
+#define NETDEV_ETH_RX_INFO_FLAG_CSUM_VALID  (0x01)
+
+/**
+ * @brief   Received Ethernet frame status information
+ *
+ * Drivers that do not provide any information leave it untouched, so it must
+ * be initialized by the caller.
+ */
+typedef struct {
+    uint8_t flags;      /**< flags, see NETDEV_ETH_RX_INFO_FLAG_* */
+} netdev_eth_rx_info_t;
+
 /**
  * @brief   Fallback function for netdev ethernet devices' _get function
  *
@@ -27,7 +27,9 @@
 
 #include <stdint.h>
 
+#include "msg.h"
 #include "net/netdev.h"
+#include "xtimer.h"
 
 
 #ifdef __cplusplus
@@ -63,6 +65,12 @@ extern "C" {
 #define CSMA_SENDER_BACKOFF_PERIOD_UNIT     (320U)
 #endif
 
+/**
+ * @brief   Message type that signals the end of a backoff period of
+ *          @ref csma_sender_csma_ca_send_async()
+ */
+#define CSMA_SENDER_MSG_TYPE_BACKOFF        (0x0c00)
+
 /**
  * @brief   Configuration type for backoff
  */
@@ -73,6 +81,24 @@ typedef struct {
     uint32_t backoff_period;    /**< backoff period in microseconds */
 } csma_sender_conf_t;
 
+/**
+ * @brief   State of an asynchronous CSMA/CA transmission
+ *
+ * Must be zeroed before its first use.
+ *
+ * @see     csma_sender_csma_ca_send_async()
+ */
+typedef struct {
+    netdev_t *dev;                  /**< device to send over */
+    iolist_t *iolist;               /**< frame to send, NULL if idle */
+    const csma_sender_conf_t *conf; /**< configuration for the backoff */
+    xtimer_t timer;                 /**< backoff timer */
+    msg_t msg;                      /**< message sent on backoff timeout */
+    kernel_pid_t pid;               /**< thread that handles the backoff */
+    uint16_t nb;                    /**< number of backoffs so far */
+    uint8_t be;                     /**< current backoff exponent */
+} csma_sender_t;
+
 /**
  * @brief   Default configuration.
  */
@@ -103,6 +129,60 @@ extern const csma_sender_conf_t CSMA_SENDER_CONF_DEFAULT;
 int csma_sender_csma_ca_send(netdev_t *dev, iolist_t *iolist,
                              const csma_sender_conf_t *conf);
 
+/**
+ * @brief   Sends a 802.15.4 frame using the CSMA/CA method without blocking
+ *
+ * @pre `(csma != NULL) && (dev != NULL)`
+ *
+ * Like @ref csma_sender_csma_ca_send(), but instead of sleeping during the
+ * random backoff periods of the software procedure, a timer sends a message
+ * of type @ref CSMA_SENDER_MSG_TYPE_BACKOFF to the calling thread, with
+ * `content.ptr` pointing to @p csma. That thread then needs to call
+ * @ref csma_sender_backoff_expired() and can handle other messages, e.g.
+ * from the device, in the meantime.
+ *
+ * @p iolist must stay valid until the transmission finished.
+ *
+ * @param[out] csma     state of the transmission
+ * @param[in] dev       netdev device, needs to be already initialized
+ * @param[in] iolist    pointer to the data
+ * @param[in] conf      configuration for the backoff;
+ *                      will be set to @ref CSMA_SENDER_CONF_DEFAULT if NULL.
+ *
+ * @return              0, if the frame will be sent after a backoff period
+ * @return              number of bytes that were actually send out, if the
+ *                      device does hardware-assisted CSMA/CA
+ * @return              -EALREADY if @p csma is still busy with another frame
+ * @return              the errors of @ref csma_sender_csma_ca_send() on
+ *                      failure, except for -EBUSY
+ */
+int csma_sender_csma_ca_send_async(csma_sender_t *csma, netdev_t *dev,
+                                   iolist_t *iolist,
+                                   const csma_sender_conf_t *conf);
+
+/**
+ * @brief   Continues an asynchronous CSMA/CA transmission after a backoff
+ *          period
+ *
+ * @pre `csma` is busy with a frame from @ref csma_sender_csma_ca_send_async()
+ *
+ * Performs a CCA and sends the frame if the medium is available. Otherwise,
+ * the next backoff period is started. If the medium was never available,
+ * @ref NETDEV_EVENT_TX_MEDIUM_BUSY is signaled to the device's event
+ * callback, like a device with hardware-assisted CSMA/CA would do. A
+ * successful transmission is signaled by the device with
+ * @ref NETDEV_EVENT_TX_COMPLETE, as when it is sent without CSMA/CA.
+ *
+ * @param[in,out] csma  state of the transmission
+ *
+ * @return              0, if another backoff period was started
+ * @return              number of bytes that were actually send out
+ * @return              -EBUSY if radio medium never was available
+ *                      to send the given data
+ * @return              the other errors of @ref csma_sender_csma_ca_send()
+ */
+int csma_sender_backoff_expired(csma_sender_t *csma);
+
 /**
  * @brief   Sends a 802.15.4 frame when medium is avaiable.
  *
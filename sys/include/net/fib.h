@@ -11,6 +11,11 @@
  * @ingroup     net
  * @brief       FIB implementation
  *
+ * By default the entries of a single hop table are searched linearly on each
+ * lookup. With the `fib_trie` module the entries are additionally indexed by
+ * a compressed binary (Patricia) trie over their prefixes, so finding the
+ * longest matching prefix takes O(prefix length) steps instead of O(n).
+ *
  * @{
  *
  * @file
@@ -35,10 +35,33 @@ extern "C" {
  */
 #define FIB_MAX_REGISTERED_RP (5)
 
+#if defined(MODULE_FIB_TRIE) || defined(DOXYGEN)
+/**
+ * @brief Node of the prefix trie indexing a FIB table
+ *
+ * @note  Only available with the `fib_trie` module.
+ *
+ * A node either holds an entry, or is a glue node branching at a bit where no
+ * entry exists.
+ */
+typedef struct fib_trie_node {
+    /** parent node, NULL for the root */
+    struct fib_trie_node *parent;
+    /** children, indexed by the key bit following the first `len` bits */
+    struct fib_trie_node *child[2];
+    /** further entries with the same key, next free glue node when unused */
+    struct fib_trie_node *dup;
+    /** entry of this node, NULL for glue nodes and unused entries */
+    struct fib_entry *entry;
+    /** key length in bits: 8 bits address size followed by the prefix */
+    uint16_t len;
+} fib_trie_node_t;
+#endif
+
 /**
  * @brief Container descriptor for a FIB entry
  */
-typedef struct {
+typedef struct fib_entry {
     /** interface ID */
     kernel_pid_t iface_id;
     /** Lifetime of this entry (an absolute time-point is stored by the FIB) */
@@ -51,6 +74,11 @@ typedef struct {
     uint32_t next_hop_flags;
     /** Pointer to the shared generic address */
     universal_address_container_t *next_hop;
+#if defined(MODULE_FIB_TRIE) || defined(DOXYGEN)
+    /** trie node of this entry and one spare glue node for the table.
+     *  Only available with the `fib_trie` module. */
+    fib_trie_node_t trie[2];
+#endif
 } fib_entry_t;
 
 /**
@@ -133,6 +161,14 @@ typedef struct {
     *   e.g. when the unreachable destination is covered by the prefix
     */
     universal_address_container_t* prefix_rp[FIB_MAX_REGISTERED_RP];
+#if defined(MODULE_FIB_TRIE) || defined(DOXYGEN)
+    /** root of the prefix trie of a single hop table.
+     *  Only available with the `fib_trie` module. */
+    fib_trie_node_t *trie_root;
+    /** list of unused glue nodes of a single hop table.
+     *  Only available with the `fib_trie` module. */
+    fib_trie_node_t *trie_free;
+#endif
 } fib_table_t;
 
 #ifdef __cplusplus
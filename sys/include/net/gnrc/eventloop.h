@@ -0,0 +1,201 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_eventloop  Single-threaded GNRC
+ * @ingroup     net_gnrc
+ * @brief       Runs the network layers of GNRC in one shared thread
+ *
+ * With the module `gnrc_eventloop`, @ref net_gnrc_sixlowpan, @ref
+ * net_gnrc_ipv6, @ref net_gnrc_udp and @ref net_gnrc_tcp do not start a
+ * thread of their own.
+ * Instead, each registers a @ref gnrc_eventloop_layer_t, and all of them are
+ * served by one thread that runs an @ref sys_event "event queue".
+ *
+ * Packets dispatched to a layer via @ref net_gnrc_netapi are put into the
+ * mailbox of the layer by a @ref net_gnrc_netapi_callbacks "callback", which
+ * then posts the event of the layer to the shared queue.
+ * Messages sent to the thread directly, e.g. by the timers of the layers, are
+ * passed to the layer that claimed their message type. Layers may also post
+ * timed events to the shared queue with gnrc_eventloop_timeout_init(), which
+ * are never dropped. The external
+ * @ref net_gnrc_netapi and @ref net_gnrc_netreg API stays unchanged. The
+ * thread replies to @ref GNRC_NETAPI_MSG_TYPE_GET and
+ * @ref GNRC_NETAPI_MSG_TYPE_SET with `-ENOTSUP`, as the layers do.
+ *
+ * To use, add the module `gnrc_eventloop` to the `USEMODULE` macro in your
+ * application's Makefile:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ {.mk}
+ * USEMODULE += gnrc_eventloop
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * @{
+ *
+ * @file
+ * @brief   Definitions for the single-threaded GNRC
+ *
+ * @author  Martine Lenders <m.lenders@fu-berlin.de>
+ */
+#ifndef NET_GNRC_EVENTLOOP_H
+#define NET_GNRC_EVENTLOOP_H
+
+#include <stdint.h>
+
+#include "event.h"
+#include "event/timeout.h"
+#include "kernel_types.h"
+#include "mbox.h"
+#include "msg.h"
+#include "net/gnrc/netreg.h"
+#include "net/gnrc/pkt.h"
+#include "thread.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(DOXYGEN)
+/**
+ * @brief   Message queue size for the shared thread
+ *
+ * Receives the messages sent to the thread directly, e.g. by the timers of
+ * the layers. Packets are put into the mailboxes of the layers instead, so
+ * they can't crowd out timer messages, but a timer message that does not
+ * fit into the queue is dropped.
+ *
+ * Defaults to the sum of the message queue sizes of the compiled-in layers
+ * that handle such messages, i.e. @ref GNRC_IPV6_MSG_QUEUE_SIZE and
+ * @ref GNRC_SIXLOWPAN_MSG_QUEUE_SIZE, rounded up to a power of two, so the
+ * thread can hold as many of them as the separate threads could.
+ *
+ * @note    Must be a power of two.
+ */
+#define GNRC_EVENTLOOP_MSG_QUEUE_SIZE
+#endif
+
+/**
+ * @brief   Priority of the shared thread
+ */
+#ifndef GNRC_EVENTLOOP_PRIO
+#define GNRC_EVENTLOOP_PRIO             (THREAD_PRIORITY_MAIN - 3)
+#endif
+
+/**
+ * @brief   Default stack size to use for the shared thread
+ */
+#ifndef GNRC_EVENTLOOP_STACK_SIZE
+#define GNRC_EVENTLOOP_STACK_SIZE       (THREAD_STACKSIZE_DEFAULT)
+#endif
+
+/**
+ * @brief   Message handler of a layer
+ *
+ * @param[in] msg   A message for the layer
+ */
+typedef void (*gnrc_eventloop_handler_t)(msg_t *msg);
+
+/**
+ * @brief   A network layer served by the shared thread
+ */
+typedef struct gnrc_eventloop_layer {
+    event_t super;                      /**< event posted for new messages */
+    struct gnrc_eventloop_layer *next;  /**< next registered layer */
+    mbox_t mbox;                        /**< messages for the layer */
+    gnrc_netreg_entry_cbd_t cbd;        /**< netreg callback data feeding
+                                         *   @ref mbox, to be used for the
+                                         *   netreg entry of the layer */
+    gnrc_eventloop_handler_t handler;   /**< message handler of the layer */
+    uint16_t msg_type_first;            /**< first message type sent directly
+                                         *   to the thread for the layer */
+    uint16_t msg_type_last;             /**< last message type sent directly
+                                         *   to the thread for the layer */
+} gnrc_eventloop_layer_t;
+
+/**
+ * @brief   PID of the shared thread
+ */
+extern kernel_pid_t gnrc_eventloop_pid;
+
+/**
+ * @brief   Starts the shared thread
+ *
+ * Can be called several times, the thread is only started once.
+ *
+ * @return  PID of the shared thread
+ */
+kernel_pid_t gnrc_eventloop_init(void);
+
+/**
+ * @brief   Registers a layer with the shared thread
+ *
+ * @pre `layer != NULL` and `queue_size` is a power of two.
+ *
+ * The layer still needs to register gnrc_eventloop_layer_t::cbd with
+ * @ref net_gnrc_netreg to receive packets.
+ *
+ * @param[out] layer        The layer to register
+ * @param[in] queue         Message queue for the mailbox of @p layer
+ * @param[in] queue_size    Number of entries in @p queue
+ * @param[in] handler       Message handler of @p layer
+ * @param[in] msg_type_first    First message type sent directly to the
+ *                              thread that is handled by @p layer
+ * @param[in] msg_type_last     Last message type sent directly to the
+ *                              thread that is handled by @p layer. If it is
+ *                              lesser than @p msg_type_first, @p layer does
+ *                              not handle such messages.
+ */
+void gnrc_eventloop_register(gnrc_eventloop_layer_t *layer, msg_t *queue,
+                             unsigned queue_size,
+                             gnrc_eventloop_handler_t handler,
+                             uint16_t msg_type_first, uint16_t msg_type_last);
+
+/**
+ * @brief   Passes a packet to a layer
+ *
+ * @param[in] layer The layer
+ * @param[in] cmd   @ref GNRC_NETAPI_MSG_TYPE_RCV or
+ *                  @ref GNRC_NETAPI_MSG_TYPE_SND
+ * @param[in] pkt   The packet
+ *
+ * @return  1, if the packet was passed to @p layer.
+ * @return  0, if the mailbox of @p layer was full. The packet is not released
+ *          in that case.
+ */
+int gnrc_eventloop_put(gnrc_eventloop_layer_t *layer, uint16_t cmd,
+                       gnrc_pktsnip_t *pkt);
+
+/**
+ * @brief   Sets up a timeout that posts an event to the shared thread
+ *
+ * @pre `(timeout != NULL) && (event != NULL)`
+ *
+ * @param[out] timeout  The timeout, to be set with event_timeout_set()
+ * @param[in] event     The event posted when @p timeout expires. Its handler
+ *                      is called in the shared thread.
+ */
+void gnrc_eventloop_timeout_init(event_timeout_t *timeout, event_t *event);
+
+/**
+ * @brief   Removes an event from the queue of the shared thread
+ *
+ * E.g. for an event posted by an expired timeout that was not handled yet.
+ * Does nothing, if @p event is not queued.
+ *
+ * @pre `event != NULL`
+ *
+ * @param[in] event The event to remove
+ */
+void gnrc_eventloop_cancel(event_t *event);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_EVENTLOOP_H */
+/** @} */
@@ -26,6 +26,7 @@
 #define NET_GNRC_IPV6_NIB_H
 
 #include "net/gnrc/ipv6/nib/abr.h"
+#include "net/gnrc/ipv6/nib/dcache.h"
 #include "net/gnrc/ipv6/nib/ft.h"
 #include "net/gnrc/ipv6/nib/nc.h"
 #include "net/gnrc/ipv6/nib/pl.h"
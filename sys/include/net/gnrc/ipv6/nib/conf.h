@@ -76,6 +76,14 @@ extern "C" {
 #define GNRC_IPV6_NIB_CONF_DNS          (1)
 #endif
 
+#ifdef MODULE_GNRC_IPV6_NIB_DCACHE
+#define GNRC_IPV6_NIB_CONF_DCACHE       (1)
+#endif
+
+#ifdef MODULE_GNRC_IPV6_NIB_HASHED
+#define GNRC_IPV6_NIB_CONF_HASHED       (1)
+#endif
+
 /**
  * @name    Compile flags
  * @brief   Compile flags to (de-)activate certain features for NIB
@@ -209,6 +217,30 @@ extern "C" {
 #ifndef GNRC_IPV6_NIB_CONF_MULTIHOP_DAD
 #define GNRC_IPV6_NIB_CONF_MULTIHOP_DAD (0)
 #endif
+
+/**
+ * @brief   Cache next hop, interface and source address per destination
+ *
+ * @see @ref net_gnrc_ipv6_nib_dcache
+ */
+#ifndef GNRC_IPV6_NIB_CONF_DCACHE
+#define GNRC_IPV6_NIB_CONF_DCACHE       (0)
+#endif
+
+/**
+ * @brief   Index NIB entries instead of searching them linearly
+ *
+ * Neighbor lookups walk a hash bucket instead of all
+ * @ref GNRC_IPV6_NIB_NUMOF entries and the cache-out of garbage-collectible
+ * neighbor cache entries spares recently used entries (second chance).
+ * Off-link entries (prefix list and forwarding table) are kept in a prefix
+ * trie, so the longest-prefix match descends at most 128 nodes. Free slots
+ * for new entries are taken from a bitfield.
+ * Use this when @ref GNRC_IPV6_NIB_NUMOF is large, e.g. on a 6LBR.
+ */
+#ifndef GNRC_IPV6_NIB_CONF_HASHED
+#define GNRC_IPV6_NIB_CONF_HASHED       (0)
+#endif
 /** @} */
 
 /**
@@ -256,6 +288,26 @@ extern "C" {
 #define GNRC_IPV6_NIB_NUMOF                 (4)
 #endif
 
+/**
+ * @brief   Number of entries in the destination cache
+ *
+ * @note    Only applicable with @ref GNRC_IPV6_NIB_CONF_DCACHE != 0. Must be
+ *          a power of two.
+ */
+#ifndef GNRC_IPV6_NIB_DCACHE_NUMOF
+#define GNRC_IPV6_NIB_DCACHE_NUMOF          (8U)
+#endif
+
+/**
+ * @brief   Number of hash buckets for on-link entries
+ *
+ * @note    Only applicable with @ref GNRC_IPV6_NIB_CONF_HASHED != 0. Must be
+ *          a power of two.
+ */
+#ifndef GNRC_IPV6_NIB_HASH_BUCKETS
+#define GNRC_IPV6_NIB_HASH_BUCKETS          (32U)
+#endif
+
 /**
  * @brief   Number of off-link entries in NIB
  *
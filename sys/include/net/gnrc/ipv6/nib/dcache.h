@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_ipv6_nib_dcache    Destination cache
+ * @ingroup     net_gnrc_ipv6_nib
+ * @brief       Per-destination cache for next hop determination
+ *
+ * Remembers for a small number of destinations the interface, next hop and
+ * source address that were determined for the last packet to it, so
+ * @ref gnrc_ipv6_nib_get_next_hop_l2addr() can skip the forwarding table,
+ * prefix list and default router lookups for the following packets. Address
+ * resolution for the next hop is still done for every packet.
+ *
+ * The cache is direct-mapped and invalidated as a whole by a generation
+ * counter whenever NIB state that influences these decisions changes (e.g.
+ * routes, prefixes, default routers, neighbor reachability or interface
+ * addresses).
+ *
+ * This component is enabled with the `gnrc_ipv6_nib_dcache` pseudo-module
+ * (see @ref GNRC_IPV6_NIB_CONF_DCACHE).
+ *
+ * @note    Not to be confused with the destination cache of
+ *          [RFC 4861](https://tools.ietf.org/html/rfc4861#section-5.1)
+ *          (see @ref GNRC_IPV6_NIB_CONF_DC), which is part of the forwarding
+ *          table.
+ * @{
+ *
+ * @file
+ * @brief   Destination cache definitions
+ *
+ * @author  Martine Lenders <m.lenders@fu-berlin.de>
+ */
+#ifndef NET_GNRC_IPV6_NIB_DCACHE_H
+#define NET_GNRC_IPV6_NIB_DCACHE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "net/ipv6/addr.h"
+#include "net/gnrc/ipv6/nib/conf.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if GNRC_IPV6_NIB_CONF_DCACHE || defined(DOXYGEN)
+/**
+ * @brief   Destination cache statistics
+ */
+typedef struct {
+    uint32_t hits;      /**< next hop determinations served by the cache */
+    uint32_t misses;    /**< next hop determinations that were not */
+} gnrc_ipv6_nib_dcache_stats_t;
+
+/**
+ * @brief   Gets the cached source address for a destination
+ *
+ * @pre `(dst != NULL) && (src != NULL)`
+ *
+ * @param[in] dst   A destination address.
+ * @param[in] iface The interface the packet to @p dst is sent over.
+ * @param[out] src  The source address stored for @p dst.
+ *
+ * @return  true, if a source address for @p dst over @p iface was cached.
+ * @return  false, otherwise.
+ */
+bool gnrc_ipv6_nib_dcache_get_src(const ipv6_addr_t *dst, unsigned iface,
+                                  ipv6_addr_t *src);
+
+/**
+ * @brief   Stores the source address for a destination
+ *
+ * Nothing is stored if there is no valid cache entry for @p dst over
+ * @p iface, i.e. @ref gnrc_ipv6_nib_get_next_hop_l2addr() needs to be called
+ * for @p dst first.
+ *
+ * @pre `(dst != NULL) && (src != NULL)`
+ *
+ * @param[in] dst   A destination address.
+ * @param[in] iface The interface the packet to @p dst is sent over.
+ * @param[in] src   The source address selected for @p dst.
+ */
+void gnrc_ipv6_nib_dcache_set_src(const ipv6_addr_t *dst, unsigned iface,
+                                  const ipv6_addr_t *src);
+
+/**
+ * @brief   Invalidates all entries of the destination cache
+ *
+ * Needs to be called when state outside of the NIB changes that influences
+ * next hop or source address selection, e.g. the addresses of an interface.
+ */
+void gnrc_ipv6_nib_dcache_invalidate(void);
+
+/**
+ * @brief   Gets the statistics of the destination cache
+ *
+ * @pre `stats != NULL`
+ *
+ * @param[out] stats    The statistics.
+ */
+void gnrc_ipv6_nib_dcache_get_stats(gnrc_ipv6_nib_dcache_stats_t *stats);
+#endif  /* GNRC_IPV6_NIB_CONF_DCACHE || defined(DOXYGEN) */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_IPV6_NIB_DCACHE_H */
+/** @} */
@@ -54,6 +54,40 @@
  * USEMODULE += gnrc_netapi_callbacks
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
  * @}
+ *
+ * @defgroup    net_gnrc_netapi_direct   Direct dispatch extension
+ * @ingroup     net_gnrc_netapi
+ * @brief       Direct function calls between the modules of GNRC
+ * @{
+ * @details The submodule `gnrc_netapi_direct` lets the modules of the stack
+ *          (6LoWPAN, IPv6 and UDP) register a @ref net_gnrc_netapi_callbacks
+ *          "callback" instead of their thread. gnrc_netapi_dispatch() then
+ *          handles a packet synchronously in the dispatching thread.
+ *
+ * A received UDP datagram only changes threads when it enters IPv6 and at
+ * the receiving application, so it is passed up the stack without a context
+ * switch per layer and without the risk of being dropped because of a full
+ * message queue in between. The UDP thread is not started at all. 6LoWPAN
+ * only handles packets directly when `gnrc_sixlowpan_frag` is not used.
+ *
+ * IPv6 always handles packets in its own thread, both on sending and
+ * receiving, due to the lock order of the stack: The NIB holds its lock while
+ * it sends packets and while it calls into the network interfaces with
+ * gnrc_netapi_get() and gnrc_netapi_set(). Those calls block until the
+ * interface's thread replied, so that thread must never wait for the NIB
+ * lock, i.e. it must not run IPv6 itself. Modules that handle packets directly
+ * must in general not take the NIB lock.
+ *
+ * Since 6LoWPAN now runs in the threads of the network interfaces and UDP in
+ * the one of IPv6, their stacks need to be sized for that.
+ *
+ * To use, add the module `gnrc_netapi_direct` to the `USEMODULE` macro in
+ * your application's Makefile:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ {.mk}
+ * USEMODULE += gnrc_netapi_direct
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * @}
  */
 
 #ifndef NET_GNRC_NETAPI_H
@@ -118,10 +118,27 @@ enum {
  */
 #define GNRC_NETIF_FLAGS_6LO_BACKBONE              (0x00000800U)
 
+/**
+ * @brief   This interface uses 6LoWPAN generic header compression (GHC)
+ *
+ * GHC capability is indicated to neighbors with the 6LoWPAN capability
+ * indication option (6CIO) in router solicitations and advertisements.
+ *
+ * @see [RFC 7400](https://tools.ietf.org/html/rfc7400)
+ */
+#define GNRC_NETIF_FLAGS_6LO_GHC                   (0x00001000U)
+
 /**
  * @brief   Network interface is configured in raw mode
  */
 #define GNRC_NETIF_FLAGS_RAWMODE                   (0x00010000U)
+
+/**
+ * @brief   Network device computes the checksums of upper-layer protocols
+ *
+ * @see @ref NETOPT_CSUM_OFFLOAD
+ */
+#define GNRC_NETIF_FLAGS_CSUM_OFFLOAD              (0x00020000U)
 /** @} */
 
 #ifdef __cplusplus
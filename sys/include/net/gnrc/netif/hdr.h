@@ -88,6 +88,41 @@ extern "C" {
  *          @ref IEEE802154_FCF_FRAME_PEND
  */
 #define GNRC_NETIF_HDR_FLAGS_MORE_DATA  (0x10)
+
+/**
+ * @brief   Upper-layer checksum was verified
+ *
+ * @details This flag is set for received packets, if the network device
+ *          already verified the checksum of the upper-layer protocol (UDP,
+ *          TCP or ICMPv6), so it does not need to be checked again.
+ *
+ * @see     @ref NETOPT_CSUM_OFFLOAD
+ */
+#define GNRC_NETIF_HDR_FLAGS_CSUM_VALID (0x08)
+
+/**
+ * @brief   Upper-layer checksum is left to the device
+ *
+ * @details This flag is set for packets to send, if the network layer did
+ *          not calculate the checksum of the upper-layer protocol (UDP, TCP
+ *          or ICMPv6), so the network device needs to. Packets without this
+ *          flag are sent with the checksum they carry.
+ *
+ * @see     @ref NETOPT_TX_CSUM_OFFLOAD
+ */
+#define GNRC_NETIF_HDR_FLAGS_CSUM_OFFLOAD   (0x04)
+
+/**
+ * @brief   Upper-layer payload was already summed up
+ *
+ * @details This flag is set for packets to send, if the checksum field of
+ *          the upper-layer header holds the unnormalized Internet Checksum
+ *          of its payload (e.g. from inet_csum_copy()) instead of 0, so the
+ *          network layer does not need to read the payload again. Only
+ *          supported for UDP. The network layer clears it when it completes
+ *          the checksum.
+ */
+#define GNRC_NETIF_HDR_FLAGS_CSUM_PAYLOAD   (0x02)
 /**
  * @}
  */
@@ -19,7 +19,9 @@
 #define NET_GNRC_NETIF_MAC_H
 
 #include "net/gnrc/mac/types.h"
+#include "net/gnrc/netif/conf.h"
 #include "net/csma_sender.h"
+#include "net/ieee802154.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -45,6 +47,21 @@ extern "C" {
  */
 #define GNRC_NETIF_MAC_INFO_CSMA_ENABLED       (0x0100U)
 
+/**
+ * @brief   Number of frames to queue while software CSMA/CA is busy with
+ *          another frame
+ *
+ * Frames sent to the interface during a backoff period are taken out of
+ * its message queue, so this should be at least
+ * @ref GNRC_NETIF_MSG_QUEUE_SIZE to not drop more frames than the message
+ * queue would, e.g. fragments of a datagram sent back-to-back.
+ *
+ * @note    Only applicable with module `gnrc_netif_csma_async`
+ */
+#ifndef GNRC_NETIF_CSMA_ASYNC_QUEUE_SIZE
+#define GNRC_NETIF_CSMA_ASYNC_QUEUE_SIZE       (GNRC_NETIF_MSG_QUEUE_SIZE)
+#endif
+
 #if defined(MODULE_GNRC_LWMAC) || defined(MODULE_GNRC_GOMACH)
 /**
  * @brief Data type to hold MAC protocols
@@ -80,6 +97,45 @@ typedef struct {
      */
     csma_sender_conf_t csma_conf;
 
+#if defined(MODULE_GNRC_NETIF_CSMA_ASYNC) || DOXYGEN
+    /**
+     * @brief   state of the software CSMA/CA for csma_pkt
+     *
+     * @note    Only available with module `gnrc_netif_csma_async`.
+     */
+    csma_sender_t csma;
+    /**
+     * @brief   packet software CSMA/CA currently runs for; NULL if none
+     *
+     * @note    Only available with module `gnrc_netif_csma_async`.
+     */
+    gnrc_pktsnip_t *csma_pkt;
+    /**
+     * @brief   frame of csma_pkt: its MAC header, followed by its payload
+     *
+     * @note    Only available with module `gnrc_netif_csma_async`.
+     */
+    iolist_t csma_iolist;
+    /**
+     * @brief   buffer for the MAC header of csma_pkt
+     *
+     * @note    Only available with module `gnrc_netif_csma_async`.
+     */
+    uint8_t csma_mhr[IEEE802154_MAX_HDR_LEN];
+    /**
+     * @brief   packets to send after csma_pkt
+     *
+     * @note    Only available with module `gnrc_netif_csma_async`.
+     */
+    gnrc_priority_pktqueue_t csma_queue;
+    /**
+     * @brief   buffer for gnrc_netif_mac_t::csma_queue nodes
+     *
+     * @note    Only available with module `gnrc_netif_csma_async`.
+     */
+    gnrc_priority_pktqueue_node_t csma_queue_nodes[GNRC_NETIF_CSMA_ASYNC_QUEUE_SIZE];
+#endif  /* MODULE_GNRC_NETIF_CSMA_ASYNC || DOXYGEN */
+
 #if ((GNRC_MAC_RX_QUEUE_SIZE != 0) || (GNRC_MAC_DISPATCH_BUFFER_SIZE != 0)) || DOXYGEN
     /**
      * @brief MAC internal object which stores reception parameters, queues, and
@@ -10,6 +10,13 @@
  * @defgroup    net_gnrc_netreg  Network protocol registry
  * @ingroup     net_gnrc
  * @brief       Registry to receive messages of a specified protocol type by GNRC.
+ *
+ * By default the entries of each protocol type are kept in one list, so a
+ * lookup is linear in the number of registered entries of that type. With the
+ * `gnrc_netreg_hashed` module the entries of each type are distributed over
+ * @ref GNRC_NETREG_HASH_BUCKETS lists by their demultiplexing context, which
+ * pays off with many entries of one type, e.g. many bound UDP ports.
+ *
  * @{
  *
  * @file
@@ -72,6 +79,15 @@ typedef enum {
 } gnrc_netreg_type_t;
 #endif
 
+/**
+ * @brief   Number of hash buckets per protocol type with `gnrc_netreg_hashed`
+ *
+ * @note    Must be a power of two.
+ */
+#ifndef GNRC_NETREG_HASH_BUCKETS
+#define GNRC_NETREG_HASH_BUCKETS    (8U)
+#endif
+
 /**
  * @brief   Demux context value to get all packets of a certain type.
  *
@@ -23,6 +23,7 @@
 #define NET_GNRC_PKT_H
 
 #include <inttypes.h>
+#include <stdatomic.h>
 #include <stdlib.h>
 
 #include "kernel_types.h"
@@ -112,9 +113,13 @@ typedef struct gnrc_pktsnip {
     /**
      * @brief   Counter of threads currently having control over this packet.
      *
+     * Changed atomically by @ref gnrc_pktbuf_hold() and
+     * @ref gnrc_pktbuf_release_error(), so the packet buffer only needs to
+     * be locked when the snip is actually freed.
+     *
      * @internal
      */
-    unsigned int users;
+    atomic_uint users;
     gnrc_nettype_t type;            /**< protocol of the packet snip */
 #ifdef MODULE_GNRC_NETERR
     kernel_pid_t err_sub;           /**< subscriber to errors related to this
@@ -58,6 +58,149 @@ extern "C" {
 #define GNRC_PKTBUF_SIZE    (6144)
 #endif  /* GNRC_PKTBUF_SIZE */
 
+/**
+ * @name    Pool configuration of `gnrc_pktbuf_slab`
+ *
+ * `gnrc_pktbuf_slab` takes packet snips from a pool of
+ * @ref GNRC_PKTBUF_SLAB_SNIP_NUMOF descriptors and their data from the
+ * smallest of up to four size classes with a free slot, so allocation and
+ * release are O(1). A class is disabled by setting its `_NUMOF` to 0.
+ * The classes must be ordered by ascending size.
+ * @{
+ */
+/**
+ * @brief   Number of packet snip descriptors
+ */
+#ifndef GNRC_PKTBUF_SLAB_SNIP_NUMOF
+#define GNRC_PKTBUF_SLAB_SNIP_NUMOF     (48U)
+#endif
+
+/**
+ * @brief   Slot size of the smallest class (headers, e.g. IPv6 and UDP)
+ */
+#ifndef GNRC_PKTBUF_SLAB_CLASS0_SIZE
+#define GNRC_PKTBUF_SLAB_CLASS0_SIZE    (64U)
+#endif
+
+/**
+ * @brief   Number of slots in the smallest class
+ */
+#ifndef GNRC_PKTBUF_SLAB_CLASS0_NUMOF
+#define GNRC_PKTBUF_SLAB_CLASS0_NUMOF   (16U)
+#endif
+
+/**
+ * @brief   Slot size of the second class (IEEE 802.15.4 frames and
+ *          6LoWPAN fragments)
+ */
+#ifndef GNRC_PKTBUF_SLAB_CLASS1_SIZE
+#define GNRC_PKTBUF_SLAB_CLASS1_SIZE    (128U)
+#endif
+
+/**
+ * @brief   Number of slots in the second class
+ */
+#ifndef GNRC_PKTBUF_SLAB_CLASS1_NUMOF
+#define GNRC_PKTBUF_SLAB_CLASS1_NUMOF   (12U)
+#endif
+
+/**
+ * @brief   Slot size of the third class (IPv6 minimum MTU, e.g. reassembled
+ *          6LoWPAN datagrams)
+ */
+#ifndef GNRC_PKTBUF_SLAB_CLASS2_SIZE
+#define GNRC_PKTBUF_SLAB_CLASS2_SIZE    (1280U)
+#endif
+
+/**
+ * @brief   Number of slots in the third class
+ */
+#ifndef GNRC_PKTBUF_SLAB_CLASS2_NUMOF
+#define GNRC_PKTBUF_SLAB_CLASS2_NUMOF   (2U)
+#endif
+
+/**
+ * @brief   Slot size of the largest class (Ethernet frames)
+ */
+#ifndef GNRC_PKTBUF_SLAB_CLASS3_SIZE
+#define GNRC_PKTBUF_SLAB_CLASS3_SIZE    (1536U)
+#endif
+
+/**
+ * @brief   Number of slots in the largest class
+ */
+#ifndef GNRC_PKTBUF_SLAB_CLASS3_NUMOF
+#define GNRC_PKTBUF_SLAB_CLASS3_NUMOF   (1U)
+#endif
+
+/**
+ * @brief   Largest data size `gnrc_pktbuf_slab` can allocate
+ */
+#if GNRC_PKTBUF_SLAB_CLASS3_NUMOF > 0
+#define GNRC_PKTBUF_SLAB_MAX_SIZE       (GNRC_PKTBUF_SLAB_CLASS3_SIZE)
+#elif GNRC_PKTBUF_SLAB_CLASS2_NUMOF > 0
+#define GNRC_PKTBUF_SLAB_MAX_SIZE       (GNRC_PKTBUF_SLAB_CLASS2_SIZE)
+#elif GNRC_PKTBUF_SLAB_CLASS1_NUMOF > 0
+#define GNRC_PKTBUF_SLAB_MAX_SIZE       (GNRC_PKTBUF_SLAB_CLASS1_SIZE)
+#else
+#define GNRC_PKTBUF_SLAB_MAX_SIZE       (GNRC_PKTBUF_SLAB_CLASS0_SIZE)
+#endif
+/** @} */
+
+/**
+ * @name    Allocation failure bins of @ref netstats_pktbuf_t
+ *
+ * Failed allocations are counted by requested size in power-of-two bins:
+ * The first bin counts requests up to @ref NETSTATS_PKTBUF_FAIL_BIN0_SIZE
+ * bytes, each following bin requests up to double the size of the previous
+ * one and the last bin all larger requests.
+ * @{
+ */
+/**
+ * @brief   Upper bound of the first bin in bytes (must be a power of two)
+ */
+#ifndef NETSTATS_PKTBUF_FAIL_BIN0_SIZE
+#define NETSTATS_PKTBUF_FAIL_BIN0_SIZE  (32U)
+#endif
+
+/**
+ * @brief   Number of bins
+ */
+#ifndef NETSTATS_PKTBUF_FAIL_BINS
+#define NETSTATS_PKTBUF_FAIL_BINS       (8U)
+#endif
+/** @} */
+
+/**
+ * @brief   Packet buffer statistics
+ *
+ * The counters are only updated when the `netstats_pktbuf` module is used.
+ * The momentary values are always available, but are 0 if the packet buffer
+ * implementation can not provide them (e.g. the free block statistics of
+ * `gnrc_pktbuf_malloc`).
+ *
+ * All implementations count failed allocations by the requested size.
+ * netstats_pktbuf_t::used and netstats_pktbuf_t::high_water count the bytes
+ * taken from the packet buffer, i.e. including alignment (`gnrc_pktbuf_static`)
+ * or size class rounding (`gnrc_pktbuf_slab`). `gnrc_pktbuf_malloc` does not
+ * know the overhead of `malloc()` so it counts the requested sizes.
+ */
+typedef struct {
+    /**
+     * @brief   Failed allocations by requested size
+     *
+     * @see     NETSTATS_PKTBUF_FAIL_BIN0_SIZE
+     */
+    uint32_t alloc_fails[NETSTATS_PKTBUF_FAIL_BINS];
+    uint32_t lock_count;    /**< number of times the mutex was taken */
+    uint32_t lock_time;     /**< time spent with the mutex taken in
+                             *   microseconds (wraps around) */
+    uint32_t high_water;    /**< maximum number of bytes allocated at once */
+    uint32_t used;          /**< number of bytes currently allocated */
+    uint32_t largest_free;  /**< size of the largest free block in bytes */
+    uint32_t holes;         /**< number of free blocks */
+} netstats_pktbuf_t;
+
 /**
  * @brief   Initializes packet buffer module.
  */
@@ -289,11 +432,31 @@ int gnrc_pktbuf_merge(gnrc_pktsnip_t *pkt);
  *
  * @note    Only available with DEVELHELP defined.
  *
- * @details Statistics include maximum number of reserved bytes.
+ * @details Statistics include maximum number of reserved bytes or, for
+ *          `gnrc_pktbuf_slab`, the current and maximum occupancy of each
+ *          size class.
  */
 void gnrc_pktbuf_stats(void);
 #endif
 
+/**
+ * @brief   Gets statistics of the packet buffer
+ *
+ * @param[out] stats    The statistics of the packet buffer
+ */
+void gnrc_pktbuf_netstats_get(netstats_pktbuf_t *stats);
+
+/**
+ * @brief   Checks if a memory location is part of the packet buffer
+ *
+ * @param[in] ptr   A pointer.
+ *
+ * @return  true, if @p ptr points into the packet buffer.
+ * @return  false, if it does not or if the implementation can not tell
+ *          (`gnrc_pktbuf_malloc`).
+ */
+bool gnrc_pktbuf_contains(const void *ptr);
+
 /* for testing */
 #ifdef TEST_SUITES
 /**
@@ -97,6 +97,143 @@ extern "C" {
 #define GNRC_SIXLOWPAN_FRAG_RBUF_AGGRESSIVE_OVERRIDE    (1)
 #endif
 
+/**
+ * @brief   Size of the virtual reassembly buffer
+ *
+ * This is the number of fragmented datagrams that can be forwarded at the
+ * same time.
+ *
+ * @note    Only applicable with
+ *          [gnrc_sixlowpan_frag_vrb](@ref net_gnrc_sixlowpan_frag_vrb) module
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_VRB_SIZE
+#define GNRC_SIXLOWPAN_FRAG_VRB_SIZE        (16U)
+#endif
+
+/**
+ * @brief   Timeout for virtual reassembly buffer entries in microseconds
+ *
+ * @note    Only applicable with
+ *          [gnrc_sixlowpan_frag_vrb](@ref net_gnrc_sixlowpan_frag_vrb) module
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_VRB_TIMEOUT_US
+#define GNRC_SIXLOWPAN_FRAG_VRB_TIMEOUT_US  (GNRC_SIXLOWPAN_FRAG_RBUF_TIMEOUT_US)
+#endif
+
+/**
+ * @brief   Number of fragments sent in one window before the sender waits for
+ *          an RFRAG-ACK
+ *
+ * The last fragment of every window carries an acknowledgment request.
+ *
+ * @note    Only applicable with
+ *          [gnrc_sixlowpan_frag_sfr](@ref net_gnrc_sixlowpan_frag_sfr) module
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_SFR_WIN_SIZE
+#define GNRC_SIXLOWPAN_FRAG_SFR_WIN_SIZE        (5U)
+#endif
+
+/**
+ * @brief   Time in microseconds between two fragments of the same window
+ *
+ * Paces the fragments so that forwarding nodes and the link-layer queue are
+ * not overrun. With 0 a window is handed to the interface in one go.
+ *
+ * @note    Only applicable with
+ *          [gnrc_sixlowpan_frag_sfr](@ref net_gnrc_sixlowpan_frag_sfr) module
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_SFR_INTER_FRAME_GAP_US
+#define GNRC_SIXLOWPAN_FRAG_SFR_INTER_FRAME_GAP_US  (100U)
+#endif
+
+/**
+ * @brief   Time in microseconds the sender waits for an RFRAG-ACK after the
+ *          last fragment of a window
+ *
+ * @note    Only applicable with
+ *          [gnrc_sixlowpan_frag_sfr](@ref net_gnrc_sixlowpan_frag_sfr) module
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_SFR_ARQ_TIMEOUT_US
+#define GNRC_SIXLOWPAN_FRAG_SFR_ARQ_TIMEOUT_US  (700U * US_PER_MS)
+#endif
+
+/**
+ * @brief   Number of times a window is retransmitted without any progress
+ *          before the datagram is aborted
+ *
+ * @note    Only applicable with
+ *          [gnrc_sixlowpan_frag_sfr](@ref net_gnrc_sixlowpan_frag_sfr) module
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_SFR_FRAG_RETRIES
+#define GNRC_SIXLOWPAN_FRAG_SFR_FRAG_RETRIES    (2U)
+#endif
+
+/**
+ * @brief   Number of neighbors that are remembered to support SFR
+ *
+ * Datagrams to other neighbors are fragmented according to RFC 4944. When
+ * full, the oldest entry is replaced.
+ *
+ * @note    Only applicable with
+ *          [gnrc_sixlowpan_frag_sfr](@ref net_gnrc_sixlowpan_frag_sfr) module
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_SFR_PEERS_NUMOF
+#define GNRC_SIXLOWPAN_FRAG_SFR_PEERS_NUMOF     (8U)
+#endif
+
+/**
+ * @brief   Use SFR for all unicast neighbors
+ *
+ * SFR support is otherwise only learned from the RFRAGs a neighbor sends, so
+ * this should be enabled on at least some nodes when all nodes in the network
+ * support SFR.
+ *
+ * @note    Only applicable with
+ *          [gnrc_sixlowpan_frag_sfr](@ref net_gnrc_sixlowpan_frag_sfr) module
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_SFR_ALL_PEERS
+#define GNRC_SIXLOWPAN_FRAG_SFR_ALL_PEERS       (0)
+#endif
+
+/**
+ * @brief   Number of neighbors whose GHC capability is remembered
+ *
+ * When full, the oldest entry is replaced.
+ *
+ * @note    Only applicable with
+ *          [gnrc_sixlowpan_ghc](@ref net_gnrc_sixlowpan_ghc) module
+ */
+#ifndef GNRC_SIXLOWPAN_GHC_PEERS_NUMOF
+#define GNRC_SIXLOWPAN_GHC_PEERS_NUMOF      (8U)
+#endif
+
+/**
+ * @brief   Maximum length of upper-layer header and payload that is GHC
+ *          compressed
+ *
+ * Larger datagrams are sent without GHC. This is also the size of the static
+ * buffer the upper layer is gathered into for compression.
+ *
+ * @note    Only applicable with
+ *          [gnrc_sixlowpan_ghc](@ref net_gnrc_sixlowpan_ghc) module
+ */
+#ifndef GNRC_SIXLOWPAN_GHC_MAX_LEN
+#define GNRC_SIXLOWPAN_GHC_MAX_LEN          (256U)
+#endif
+
+/**
+ * @brief   Use GHC for multicast and broadcast datagrams
+ *
+ * GHC capability is only learned per neighbor, so this should only be enabled
+ * when all nodes in the network support GHC.
+ *
+ * @note    Only applicable with
+ *          [gnrc_sixlowpan_ghc](@ref net_gnrc_sixlowpan_ghc) module
+ */
+#ifndef GNRC_SIXLOWPAN_GHC_MULTICAST
+#define GNRC_SIXLOWPAN_GHC_MULTICAST        (0)
+#endif
+
 /**
  * @brief   Registration lifetime in minutes for the address registration option
  *
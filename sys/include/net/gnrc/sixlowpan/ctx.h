@@ -77,6 +77,10 @@ typedef struct {
 /**
  * @brief   Gets a context matching the given IPv6 address best with its prefix.
  *
+ * The contexts are kept sorted by prefix length, so the first matching
+ * context is the longest prefix match. The results of the most recent lookups
+ * are cached until the contexts change.
+ *
  * @param[in] addr  An IPv6 address.
  *
  * @return  The context associated with the best prefix for @p addr.
@@ -113,17 +117,14 @@ gnrc_sixlowpan_ctx_t *gnrc_sixlowpan_ctx_update(uint8_t id, const ipv6_addr_t *p
                                                 uint8_t prefix_len, uint16_t ltime,
                                                 bool comp);
 
-#ifdef MODULE_GNRC_SIXLOWPAN_CTX
 /**
  * @brief   Removes context.
  *
+ * @note    May be called from interrupt context.
+ *
  * @param[in] id    A context ID.
  */
-static inline void gnrc_sixlowpan_ctx_remove(uint8_t id)
-{
-    gnrc_sixlowpan_ctx_lookup_id(id)->prefix_len = 0;
-}
-#endif
+void gnrc_sixlowpan_ctx_remove(uint8_t id);
 
 #ifdef TEST_SUITES
 /**
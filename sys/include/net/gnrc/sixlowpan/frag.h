@@ -28,6 +28,7 @@
 #include <inttypes.h>
 #include <stdbool.h>
 
+#include "bitfield.h"
 #include "byteorder.h"
 #include "msg.h"
 #include "net/gnrc/pkt.h"
@@ -56,26 +57,24 @@ extern "C" {
  * @brief   Message type for triggering garbage collection reassembly buffer
  */
 #define GNRC_SIXLOWPAN_MSG_FRAG_GC_RBUF     (0x0226)
+
+/**
+ * @brief   Message type for the pacing and retransmission timer of
+ *          @ref net_gnrc_sixlowpan_frag_sfr
+ */
+#define GNRC_SIXLOWPAN_MSG_FRAG_SFR_TIMER   (0x0227)
 /** @} */
 
 /**
- * @brief   Fragment intervals to identify limits of fragments and duplicates.
+ * @brief   Number of bits in the bitmap of received bytes of a reassembly
+ *          buffer entry
  *
- * @note    Fragments MUST NOT overlap and overlapping fragments are to be
- *          discarded
+ * One bit per 8 octets of the largest possible datagram, since fragment
+ * offsets are given in units of 8 octets.
  *
- * @see <a href="https://tools.ietf.org/html/rfc4944#section-5.3">
- *          RFC 4944, section 5.3
- *      </a>
+ * @see gnrc_sixlowpan_rbuf_t::received
  */
-typedef struct gnrc_sixlowpan_rbuf_int {
-    /**
-     * @brief   next element in fragment interval list
-     */
-    struct gnrc_sixlowpan_rbuf_int *next;
-    uint16_t start;             /**< start byte of the fragment interval */
-    uint16_t end;               /**< end byte of the fragment interval */
-} gnrc_sixlowpan_rbuf_int_t;
+#define GNRC_SIXLOWPAN_FRAG_RBUF_UNITS  ((SIXLOWPAN_FRAG_MAX_LEN + 7U) / 8U)
 
 /**
  * @brief   Base class for both reassembly buffer and virtual reassembly buffer
@@ -91,7 +90,6 @@ typedef struct gnrc_sixlowpan_rbuf_int {
  * @see https://tools.ietf.org/html/draft-ietf-lwig-6lowpan-virtual-reassembly-01
  */
 typedef struct {
-    gnrc_sixlowpan_rbuf_int_t *ints;            /**< intervals of already received fragments */
     uint8_t src[IEEE802154_LONG_ADDRESS_LEN];   /**< source address */
     uint8_t dst[IEEE802154_LONG_ADDRESS_LEN];   /**< destination address */
     uint8_t src_len;                            /**< length of gnrc_sixlowpan_rbuf_t::src */
@@ -112,12 +110,41 @@ typedef struct {
  * A recipient of a fragment SHALL use
  *
  */
-typedef struct {
+typedef struct gnrc_sixlowpan_rbuf {
     gnrc_sixlowpan_rbuf_base_t super;           /**< base class */
     /**
      * @brief   The reassembled packet in the packet buffer
      */
     gnrc_pktsnip_t *pkt;
+    /**
+     * @brief   Next entry in the same hash bucket of the reassembly buffer
+     */
+    struct gnrc_sixlowpan_rbuf *bucket_next;
+    /**
+     * @brief   Next entry in the same slot of the garbage collection timer
+     *          wheel
+     */
+    struct gnrc_sixlowpan_rbuf *slot_next;
+    uint8_t slot;   /**< slot of the garbage collection timer wheel */
+    /**
+     * @brief   Bitmap of the already received 8-octet units of the datagram
+     *
+     * Bit `n` is set when byte `8 * n` of the datagram was received.
+     */
+    BITFIELD(received, GNRC_SIXLOWPAN_FRAG_RBUF_UNITS);
+#if defined(MODULE_GNRC_SIXLOWPAN_FRAG_SFR) || defined(DOXYGEN)
+    /**
+     * @brief   Bitmap of the already received fragments of a datagram sent
+     *          with @ref net_gnrc_sixlowpan_frag_sfr
+     *
+     * Uses the layout of the RFRAG-ACK bitmap (see
+     * @ref SIXLOWPAN_SFR_ACK_BITMAP_BIT()). The entry belongs to a datagram
+     * sent with @ref net_gnrc_sixlowpan_frag_sfr if it is not 0.
+     *
+     * @note    Only available with @ref net_gnrc_sixlowpan_frag_sfr
+     */
+    uint32_t sfr_received;
+#endif
 } gnrc_sixlowpan_rbuf_t;
 
 /**
@@ -238,6 +265,30 @@ void gnrc_sixlowpan_frag_rbuf_remove(gnrc_sixlowpan_rbuf_t *rbuf);
  */
 void gnrc_sixlowpan_frag_rbuf_dispatch_when_complete(gnrc_sixlowpan_rbuf_t *rbuf,
                                                      gnrc_netif_hdr_t *netif);
+
+#if defined(MODULE_GNRC_SIXLOWPAN_FRAG_SFR) || defined(DOXYGEN)
+/**
+ * @brief   Gets or creates the reassembly buffer entry of a datagram sent
+ *          with @ref net_gnrc_sixlowpan_frag_sfr
+ *
+ * @pre `netif_hdr != NULL`
+ *
+ * @param[in] netif_hdr     The interface header of the received RFRAG.
+ * @param[in] tag           The datagram tag of the RFRAG.
+ * @param[in] size          The datagram size for the first fragment. 0 to
+ *                          only look up an existing entry.
+ * @param[in] page          Current 6Lo dispatch parsing page.
+ *
+ * @return  The reassembly buffer entry of the datagram.
+ *          gnrc_sixlowpan_rbuf_base_t::current_size is 0 for a newly
+ *          created entry.
+ * @return  NULL, if no entry exists for @p size == 0 or if the reassembly
+ *          buffer is full.
+ */
+gnrc_sixlowpan_rbuf_t *gnrc_sixlowpan_frag_rbuf_get_sfr(const gnrc_netif_hdr_t *netif_hdr,
+                                                        uint8_t tag, size_t size,
+                                                        unsigned page);
+#endif
 #else
 /* NOPs to be used with gnrc_sixlowpan_iphc if gnrc_sixlowpan_frag is not
  * compiled in */
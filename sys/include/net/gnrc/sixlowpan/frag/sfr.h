@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_sixlowpan_frag_sfr Selective Fragment Recovery
+ * @ingroup     net_gnrc_sixlowpan_frag
+ * @brief       6LoWPAN Selective Fragment Recovery (SFR)
+ *
+ * With this module datagrams that are too big for a single frame are sent in
+ * recoverable fragments (RFRAG). The fragments are sent in windows of
+ * @ref GNRC_SIXLOWPAN_FRAG_SFR_WIN_SIZE fragments, paced by
+ * @ref GNRC_SIXLOWPAN_FRAG_SFR_INTER_FRAME_GAP_US. The last fragment of every
+ * window requests an acknowledgment (RFRAG-ACK) from the receiver, which
+ * reports all fragments received so far in a bitmap. Only the fragments
+ * missing from that bitmap are retransmitted, so a single lost frame does not
+ * cost the whole datagram.
+ *
+ * If no RFRAG-ACK arrives within @ref GNRC_SIXLOWPAN_FRAG_SFR_ARQ_TIMEOUT_US,
+ * all unacknowledged fragments are sent again. After
+ * @ref GNRC_SIXLOWPAN_FRAG_SFR_FRAG_RETRIES retransmissions without progress
+ * the datagram is aborted.
+ *
+ * SFR is only used towards neighbors known to support it: neighbors that sent
+ * RFRAGs to this node, neighbors added with
+ * @ref gnrc_sixlowpan_frag_sfr_peer_add(), or all unicast neighbors with
+ * @ref GNRC_SIXLOWPAN_FRAG_SFR_ALL_PEERS. Datagrams to other neighbors and to
+ * multicast or broadcast destinations, which can't acknowledge fragments,
+ * are fragmented according to RFC 4944.
+ *
+ * Receiving of RFC 4944 fragments is still supported alongside. Forwarding
+ * of RFRAGs with the @ref net_gnrc_sixlowpan_frag_vrb is not supported; they
+ * are reassembled at every hop.
+ *
+ * @see     [RFC 8931](https://tools.ietf.org/html/rfc8931)
+ * @{
+ *
+ * @file
+ * @brief   Selective Fragment Recovery definitions
+ *
+ * @author  Martine Lenders <m.lenders@fu-berlin.de>
+ */
+#ifndef NET_GNRC_SIXLOWPAN_FRAG_SFR_H
+#define NET_GNRC_SIXLOWPAN_FRAG_SFR_H
+
+#include <stdint.h>
+
+#include "msg.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/pkt.h"
+#include "net/gnrc/sixlowpan/config.h"
+#include "net/gnrc/sixlowpan/frag.h"
+#include "xtimer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Fragmentation buffer entry of a datagram sent with SFR
+ */
+typedef struct {
+    /**
+     * @brief   The compressed datagram, starting with its
+     *          @ref gnrc_netif_hdr_t
+     *
+     * The entry is unused when NULL.
+     */
+    gnrc_pktsnip_t *pkt;
+    xtimer_t timer;             /**< pacing and retransmission timer */
+    msg_t timer_msg;            /**< message for gnrc_sixlowpan_frag_sfr_fb_t::timer */
+    /**
+     * @brief   Fragments acknowledged by the receiver
+     *
+     * Uses the layout of the RFRAG-ACK bitmap (see
+     * @ref SIXLOWPAN_SFR_ACK_BITMAP_BIT()).
+     */
+    uint32_t acked;
+    /**
+     * @brief   Fragments still to be sent in the current window
+     *
+     * Uses the layout of the RFRAG-ACK bitmap. The sender waits for an
+     * RFRAG-ACK when it is 0.
+     */
+    uint32_t window;
+    uint16_t datagram_size;     /**< size of the uncompressed datagram */
+    uint16_t frag_size;         /**< number of datagram bytes per fragment */
+    uint8_t tag;                /**< datagram tag */
+    uint8_t frags_num;          /**< number of fragments of the datagram */
+    uint8_t next_seq;           /**< sequence number of the next fragment never sent */
+    uint8_t retries;            /**< retransmissions without progress */
+} gnrc_sixlowpan_frag_sfr_fb_t;
+
+/**
+ * @brief   Allocates a @ref gnrc_sixlowpan_frag_sfr_fb_t object
+ *
+ * There are @ref GNRC_SIXLOWPAN_MSG_FRAG_SIZE objects available.
+ *
+ * @return  A @ref gnrc_sixlowpan_frag_sfr_fb_t if available
+ * @return  NULL, otherwise
+ */
+gnrc_sixlowpan_frag_sfr_fb_t *gnrc_sixlowpan_frag_sfr_fb_get(void);
+
+/**
+ * @brief   Notes that a neighbor supports SFR
+ *
+ * @param[in] netif         The interface the neighbor is reachable over.
+ * @param[in] l2addr        Link-layer address of the neighbor.
+ * @param[in] l2addr_len    Length of @p l2addr.
+ */
+void gnrc_sixlowpan_frag_sfr_peer_add(const gnrc_netif_t *netif,
+                                      const uint8_t *l2addr,
+                                      size_t l2addr_len);
+
+/**
+ * @brief   Checks if SFR is to be used for a datagram
+ *
+ * @param[in] netif     The interface the datagram is to be sent over.
+ * @param[in] hdr       The network interface header of the datagram.
+ *
+ * @return  true, if the destination is a unicast neighbor known to support
+ *          SFR (or any unicast neighbor with
+ *          @ref GNRC_SIXLOWPAN_FRAG_SFR_ALL_PEERS set).
+ * @return  false, if the datagram is to be fragmented according to RFC 4944.
+ */
+bool gnrc_sixlowpan_frag_sfr_use(const gnrc_netif_t *netif,
+                                 const gnrc_netif_hdr_t *hdr);
+
+/**
+ * @brief   Sends a packet in recoverable fragments
+ *
+ * @pre `ctx != NULL`
+ * @pre gnrc_sixlowpan_frag_sfr_fb_t::pkt of @p ctx is equal to @p pkt and
+ *      gnrc_sixlowpan_frag_sfr_fb_t::datagram_size is set.
+ *
+ * The packet is released when the receiver acknowledged all fragments or
+ * when the datagram is aborted.
+ *
+ * @param[in] pkt       A packet, starting with its @ref gnrc_netif_hdr_t.
+ * @param[in] ctx       A fragmentation buffer entry of type
+ *                      @ref gnrc_sixlowpan_frag_sfr_fb_t. Must not be NULL.
+ * @param[in] page      Current 6Lo dispatch parsing page.
+ */
+void gnrc_sixlowpan_frag_sfr_send(gnrc_pktsnip_t *pkt, void *ctx,
+                                  unsigned page);
+
+/**
+ * @brief   Handles a packet starting with an RFRAG or an RFRAG-ACK header
+ *
+ * @param[in] pkt       The packet to handle.
+ * @param[in] ctx       Context for the packet. May be NULL.
+ * @param[in] page      Current 6Lo dispatch parsing page.
+ */
+void gnrc_sixlowpan_frag_sfr_recv(gnrc_pktsnip_t *pkt, void *ctx,
+                                  unsigned page);
+
+/**
+ * @brief   Handles a @ref GNRC_SIXLOWPAN_MSG_FRAG_SFR_TIMER message
+ *
+ * Sends the next fragment of the current window or, when the sender waited
+ * for an RFRAG-ACK in vain, retransmits the unacknowledged fragments.
+ *
+ * @param[in] fb    The fragmentation buffer entry of the message.
+ */
+void gnrc_sixlowpan_frag_sfr_timeout(gnrc_sixlowpan_frag_sfr_fb_t *fb);
+
+/**
+ * @brief   Notes that a datagram received with SFR was reassembled
+ *
+ * Later fragments of the datagram, e.g. retransmitted because the final
+ * RFRAG-ACK got lost, are answered with a FULL bitmap instead of starting
+ * a new reassembly. The datagram is forgotten after
+ * @ref GNRC_SIXLOWPAN_FRAG_RBUF_TIMEOUT_US, so the sender can reuse its tag.
+ *
+ * @param[in] base  The reassembly buffer entry of the datagram.
+ */
+void gnrc_sixlowpan_frag_sfr_completed(const gnrc_sixlowpan_rbuf_base_t *base);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_SIXLOWPAN_FRAG_SFR_H */
+/** @} */
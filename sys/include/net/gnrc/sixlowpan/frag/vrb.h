@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_sixlowpan_frag_vrb Virtual reassembly buffer
+ * @ingroup     net_gnrc_sixlowpan_frag
+ * @brief       Virtual reassembly buffer for fragment forwarding
+ *
+ * With this module a 6LoWPAN router does not reassemble fragmented datagrams
+ * that are not addressed to itself. Instead it learns the next hop from the
+ * IPHC header of the first fragment, forwards that fragment right away and
+ * remembers (virtually reassembles) the datagram, so all subsequent fragments
+ * can be forwarded as soon as they arrive with only the datagram tag and the
+ * link-layer addresses rewritten.
+ *
+ * Datagrams to the router itself, to multicast or link-local destinations, or
+ * for which no next hop link-layer address is known yet are still reassembled
+ * as usual.
+ *
+ * @see     [RFC 8930](https://tools.ietf.org/html/rfc8930)
+ * @see     https://tools.ietf.org/html/draft-ietf-lwig-6lowpan-virtual-reassembly-01
+ * @{
+ *
+ * @file
+ * @brief   Virtual reassembly buffer definitions
+ *
+ * @author  Martine Lenders <m.lenders@fu-berlin.de>
+ */
+#ifndef NET_GNRC_SIXLOWPAN_FRAG_VRB_H
+#define NET_GNRC_SIXLOWPAN_FRAG_VRB_H
+
+#include <stdint.h>
+
+#include "net/gnrc/netif.h"
+#include "net/gnrc/pkt.h"
+#include "net/gnrc/sixlowpan/config.h"
+#include "net/gnrc/sixlowpan/frag.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Representation of the virtual reassembly buffer entry
+ */
+typedef struct {
+    /**
+     * @brief   Base class
+     *
+     * gnrc_sixlowpan_rbuf_base_t::src and gnrc_sixlowpan_rbuf_base_t::tag
+     * identify the datagram on the incoming link. The entry is unused when
+     * gnrc_sixlowpan_rbuf_base_t::datagram_size is 0.
+     */
+    gnrc_sixlowpan_rbuf_base_t super;
+    gnrc_netif_t *out_netif;    /**< interface to forward the fragments over */
+    /**
+     * @brief   Link-layer destination address to forward the fragments to
+     */
+    uint8_t out_dst[IEEE802154_LONG_ADDRESS_LEN];
+    uint8_t out_dst_len;        /**< length of gnrc_sixlowpan_frag_vrb_t::out_dst */
+    uint16_t out_tag;           /**< datagram tag on the outgoing link */
+} gnrc_sixlowpan_frag_vrb_t;
+
+/**
+ * @brief   Adds a new entry to the virtual reassembly buffer
+ *
+ * A new datagram tag for the outgoing link is generated with
+ * @ref gnrc_sixlowpan_frag_next_tag(). If the buffer is full, the oldest
+ * entry is replaced if it timed out (see
+ * @ref GNRC_SIXLOWPAN_FRAG_VRB_TIMEOUT_US).
+ *
+ * @pre `(base != NULL) && (out_netif != NULL) && (out_dst != NULL)`
+ * @pre `out_dst_len <= IEEE802154_LONG_ADDRESS_LEN`
+ *
+ * @param[in] base          Identification of the datagram on the incoming
+ *                          link, e.g. from its reassembly buffer entry.
+ * @param[in] out_netif     Interface to forward the fragments over.
+ * @param[in] out_dst       Link-layer destination address of the next hop.
+ * @param[in] out_dst_len   Length of @p out_dst.
+ *
+ * @return  The new virtual reassembly buffer entry.
+ * @return  NULL, if the virtual reassembly buffer is full.
+ */
+gnrc_sixlowpan_frag_vrb_t *gnrc_sixlowpan_frag_vrb_add(
+        const gnrc_sixlowpan_rbuf_base_t *base, gnrc_netif_t *out_netif,
+        const uint8_t *out_dst, size_t out_dst_len);
+
+/**
+ * @brief   Gets the virtual reassembly buffer entry of a datagram
+ *
+ * @param[in] src           Link-layer source address of the fragment.
+ * @param[in] src_len       Length of @p src.
+ * @param[in] dst           Link-layer destination address of the fragment.
+ * @param[in] dst_len       Length of @p dst.
+ * @param[in] datagram_size Datagram size of the fragment.
+ * @param[in] src_tag       Datagram tag of the fragment.
+ *
+ * @return  The virtual reassembly buffer entry of the datagram.
+ * @return  NULL, if no entry for the datagram exists.
+ */
+gnrc_sixlowpan_frag_vrb_t *gnrc_sixlowpan_frag_vrb_get(
+        const uint8_t *src, size_t src_len, const uint8_t *dst, size_t dst_len,
+        size_t datagram_size, unsigned src_tag);
+
+/**
+ * @brief   Forwards a subsequent fragment according to its virtual reassembly
+ *          buffer entry
+ *
+ * The datagram tag of the fragment is replaced by
+ * gnrc_sixlowpan_frag_vrb_t::out_tag and its link-layer header by one to
+ * gnrc_sixlowpan_frag_vrb_t::out_dst. The entry is removed once all bytes of
+ * the datagram were forwarded.
+ *
+ * @pre `(vrbe != NULL) && (pkt != NULL)`
+ * @pre @p pkt starts with a FRAGN header.
+ *
+ * @param[in] vrbe      A virtual reassembly buffer entry.
+ * @param[in] pkt       The fragment as received, including its link-layer
+ *                      header. Is released by this function in any case.
+ * @param[in] frag_size Number of datagram bytes carried in @p pkt.
+ */
+void gnrc_sixlowpan_frag_vrb_forward(gnrc_sixlowpan_frag_vrb_t *vrbe,
+                                     gnrc_pktsnip_t *pkt, size_t frag_size);
+
+/**
+ * @brief   Removes an entry from the virtual reassembly buffer
+ *
+ * @pre `vrbe != NULL`
+ *
+ * @param[in] vrbe  A virtual reassembly buffer entry.
+ */
+void gnrc_sixlowpan_frag_vrb_rm(gnrc_sixlowpan_frag_vrb_t *vrbe);
+
+/**
+ * @brief   Removes all timed out entries from the virtual reassembly buffer
+ *
+ * @see GNRC_SIXLOWPAN_FRAG_VRB_TIMEOUT_US
+ */
+void gnrc_sixlowpan_frag_vrb_gc(void);
+
+#if defined(TEST_SUITES) || defined(DOXYGEN)
+/**
+ * @brief   Resets the virtual reassembly buffer to a clean state
+ *
+ * @note    Only available when @ref TEST_SUITES is defined
+ */
+void gnrc_sixlowpan_frag_vrb_reset(void);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_SIXLOWPAN_FRAG_VRB_H */
+/** @} */
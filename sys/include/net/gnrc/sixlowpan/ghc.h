@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_sixlowpan_ghc  Generic Header Compression
+ * @ingroup     net_gnrc_sixlowpan_iphc
+ * @brief       6LoWPAN Generic Header Compression (GHC) for GNRC
+ *
+ * With this module the UDP or ICMPv6 header and payload of an IPHC-compressed
+ * datagram are compressed with @ref net_sixlowpan_ghc and sent with a GHC next
+ * header compression ID. GHC is only used towards neighbors that indicated
+ * their GHC capability in a 6LoWPAN capability indication option (6CIO) of a
+ * router solicitation or advertisement, and only if the compressed datagram
+ * fits into a single frame. GHC is never used within fragmented datagrams and
+ * GHC-compressed fragments are dropped on reception.
+ *
+ * IPv6 extension headers are not compressed: datagrams with extension headers
+ * are sent with the common next header compression.
+ *
+ * @see     [RFC 7400](https://tools.ietf.org/html/rfc7400)
+ * @{
+ *
+ * @file
+ * @brief   Generic Header Compression definitions
+ *
+ * @author  Martine Lenders <m.lenders@fu-berlin.de>
+ */
+#ifndef NET_GNRC_SIXLOWPAN_GHC_H
+#define NET_GNRC_SIXLOWPAN_GHC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "net/gnrc/netif.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/sixlowpan/ghc.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Sets the GHC capability of a neighbor
+ *
+ * @param[in] netif         The interface the neighbor is reachable over.
+ * @param[in] l2addr        Link-layer address of the neighbor.
+ * @param[in] l2addr_len    Length of @p l2addr.
+ * @param[in] capable       true, if the neighbor indicated GHC capability.
+ */
+void gnrc_sixlowpan_ghc_peer_set(const gnrc_netif_t *netif,
+                                 const uint8_t *l2addr, size_t l2addr_len,
+                                 bool capable);
+
+/**
+ * @brief   Checks if GHC is to be used for a datagram
+ *
+ * @param[in] netif     The interface the datagram is to be sent over.
+ * @param[in] hdr       The network interface header of the datagram.
+ *
+ * @return  true, if @p netif has @ref GNRC_NETIF_FLAGS_6LO_GHC set and the
+ *          destination is known to be GHC capable (or is a multicast or
+ *          broadcast destination and @ref GNRC_SIXLOWPAN_GHC_MULTICAST is
+ *          set).
+ * @return  false, otherwise.
+ */
+bool gnrc_sixlowpan_ghc_use(const gnrc_netif_t *netif,
+                            const gnrc_netif_hdr_t *hdr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_SIXLOWPAN_GHC_H */
+/** @} */
@@ -93,6 +93,19 @@ gnrc_pktsnip_t *gnrc_sixlowpan_nd_opt_6ctx_build(uint8_t prefix_len, uint8_t fla
 gnrc_pktsnip_t *gnrc_sixlowpan_nd_opt_abr_build(uint32_t version, uint16_t ltime,
                                                 ipv6_addr_t *braddr, gnrc_pktsnip_t *next);
 
+/**
+ * @brief   Builds the 6LoWPAN capability indication option.
+ *
+ * @see     [RFC 7400, section 3.3](https://tools.ietf.org/html/rfc7400#section-3.3)
+ *
+ * @param[in] flags     Capability flags (e.g. @ref SIXLOWPAN_ND_OPT_6CIO_FLAGS_G).
+ * @param[in] next      More options in the packet. NULL, if there are none.
+ *
+ * @return  The pkt snip list of options, on success
+ * @return  NULL, if packet buffer is full or on error
+ */
+gnrc_pktsnip_t *gnrc_sixlowpan_nd_opt_6cio_build(uint16_t flags, gnrc_pktsnip_t *next);
+
 #ifdef __cplusplus
 }
 #endif
@@ -22,6 +22,7 @@
 #ifndef NET_GNRC_TCP_H
 #define NET_GNRC_TCP_H
 
+#include <stdbool.h>
 #include <stdint.h>
 #include "net/gnrc/pkt.h"
 #include "net/gnrc/tcp/tcb.h"
@@ -34,10 +35,16 @@
 extern "C" {
 #endif
 
+/**
+ * @brief Timeout duration, that lets gnrc_tcp_accept() wait without timeout
+ */
+#define GNRC_TCP_NO_TIMEOUT (UINT32_MAX)
+
 /**
  * @brief Initialize TCP
  *
- * @returns   PID of TCP thread on success
+ * @returns   PID of TCP thread on success. With the module gnrc_eventloop,
+ *            TCP runs in the shared GNRC thread, whose PID is returned.
  *            -1 if TCB is already running.
  *            -EINVAL, if priority is greater than or equal SCHED_PRIO_LEVELS
  *            -EOVERFLOW, if there are too many threads running.
@@ -52,6 +59,56 @@ int gnrc_tcp_init(void);
  */
 void gnrc_tcp_tcb_init(gnrc_tcp_tcb_t *tcb);
 
+/**
+ * @brief Set the receive buffer size of a connection.
+ *
+ * @pre gnrc_tcp_tcb_init() must have been successfully called.
+ * @pre @p tcb must not be NULL.
+ *
+ * @note The receive buffer is allocated from a pool of GNRC_TCP_RCV_BUF_POOL_SIZE byte,
+ *       when the connection is opened. If less memory is available, the buffer is
+ *       as large as possible. Sizes above 65535 byte require window scaling
+ *       (see GNRC_TCP_WND_SCALE) to be used.
+ *
+ * @param[in,out] tcb    TCB holding the connection information.
+ * @param[in]     size   Receive buffer size in byte. Zero for GNRC_TCP_RCV_BUF_SIZE.
+ *
+ * @returns   Zero on success.
+ *            -EISCONN if TCB is already in use.
+ *            -EINVAL if @p size is larger than GNRC_TCP_RCV_BUF_POOL_SIZE.
+ */
+int gnrc_tcp_tcb_set_rcv_buf_size(gnrc_tcp_tcb_t *tcb, size_t size);
+
+/**
+ * @brief Enable or disable delayed ACKs for a connection.
+ *
+ * @pre gnrc_tcp_tcb_init() must have been successfully called.
+ * @pre @p tcb must not be NULL.
+ *
+ * @note Received data is acknowledged after at most GNRC_TCP_ACK_DELAY, unless the
+ *       ACK is piggybacked on data sent in the meantime. Every second segment is
+ *       acknowledged immediately. The default is GNRC_TCP_DELAYED_ACK.
+ *
+ * @param[in,out] tcb      TCB holding the connection information.
+ * @param[in]     enable   True to delay ACKs, false to send them immediately.
+ */
+void gnrc_tcp_tcb_set_delayed_ack(gnrc_tcp_tcb_t *tcb, bool enable);
+
+/**
+ * @brief Enable or disable Nagle's algorithm for a connection.
+ *
+ * @pre gnrc_tcp_tcb_init() must have been successfully called.
+ * @pre @p tcb must not be NULL.
+ *
+ * @note While sent data is unacknowledged, small writes are collected and sent as one
+ *       segment, once everything was acknowledged or a full segment was collected.
+ *       gnrc_tcp_send() counts collected data as sent. The default is GNRC_TCP_NAGLE.
+ *
+ * @param[in,out] tcb      TCB holding the connection information.
+ * @param[in]     enable   True to coalesce small writes, false to send them immediately.
+ */
+void gnrc_tcp_tcb_set_nagle(gnrc_tcp_tcb_t *tcb, bool enable);
+
 /**
  * @brief Opens a connection actively.
  *
@@ -109,11 +166,90 @@ int gnrc_tcp_open_active(gnrc_tcp_tcb_t *tcb,  uint8_t address_family,
  *                    or @p target_addr is invalid.
  *            -EISCONN if TCB is already in use.
  *            -ENOMEM if the receive buffer for the TCB could not be allocated.
- *            Hint: Increase "GNRC_TCP_RCV_BUFFERS".
+ *            Hint: Increase "GNRC_TCP_RCV_BUF_POOL_SIZE".
  */
 int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb, uint8_t address_family,
                           const char *local_addr, uint16_t local_port);
 
+/**
+ * @brief Initialize listen queue.
+ *
+ * @pre @p queue must not be NULL.
+ *
+ * @param[in,out] queue   Listen queue that should be initialized.
+ */
+void gnrc_tcp_tcb_queue_init(gnrc_tcp_tcb_queue_t *queue);
+
+/**
+ * @brief Listens for incoming connections with several TCBs at once.
+ *
+ * @pre gnrc_tcp_tcb_queue_init() must have been successfully called on @p queue.
+ * @pre gnrc_tcp_tcb_init() must have been successfully called on every TCB in @p tcbs.
+ * @pre @p queue must not be NULL.
+ * @pre @p tcbs must not be NULL, @p tcbs_len must not be zero.
+ * @pre @p local_port must not be zero.
+ *
+ * @note Function does not block. Every TCB handles one connection, so @p tcbs_len
+ *       limits the number of connections that are half-open, established but not
+ *       accepted, or accepted but not closed. Half-open connections are dropped
+ *       after GNRC_TCP_SYN_ACK_RETRIES unanswered SYN+ACKs.
+ *
+ * @param[in,out] queue        Listen queue.
+ * @param[in,out] tcbs         TCBs used for connections on @p local_port.
+ * @param[in]     tcbs_len     Number of TCBs in @p tcbs.
+ * @param[in]     local_addr   Local address to listen on. If NULL, listen on any address.
+ * @param[in]     local_port   Local port number to listen on.
+ *
+ * @returns   Zero on success.
+ *            -EAFNOSUPPORT if local_addr != NULL and the address family is not supported.
+ *            -EINVAL if @p local_addr is invalid.
+ *            -EISCONN if @p queue or a TCB in @p tcbs is already in use.
+ *            -ENOMEM if the receive buffers for the TCBs could not be allocated.
+ *            Hint: Increase "GNRC_TCP_RCV_BUF_POOL_SIZE".
+ */
+int gnrc_tcp_listen(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_tcb_t *tcbs, size_t tcbs_len,
+                    const char *local_addr, uint16_t local_port);
+
+/**
+ * @brief Accepts an established connection of a listen queue.
+ *
+ * @pre gnrc_tcp_listen() must have been successfully called on @p queue.
+ * @pre @p queue must not be NULL.
+ * @pre @p tcb must not be NULL.
+ *
+ * @note Function blocks if user_timeout_duration_us is not zero.
+ *       Closing or aborting the accepted connection returns its TCB to @p queue.
+ *       The TCB must not be used afterwards.
+ *
+ * @param[in,out] queue                      Listen queue.
+ * @param[out]    tcb                        TCB of the accepted connection.
+ * @param[in]     user_timeout_duration_us   Timeout for accept in microseconds.
+ *                                           If zero and no connection is established,
+ *                                           the function returns immediately.
+ *                                           If GNRC_TCP_NO_TIMEOUT, the function waits
+ *                                           until a connection is established.
+ *
+ * @returns   Zero on success.
+ *            -EINVAL if @p queue is not listening or stopped listening while waiting.
+ *            -EAGAIN if user_timeout_duration_us is zero and no connection is established.
+ *            -ETIMEDOUT if @p user_timeout_duration_us expired.
+ */
+int gnrc_tcp_accept(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_tcb_t **tcb,
+                    const uint32_t user_timeout_duration_us);
+
+/**
+ * @brief Stops listening on a listen queue.
+ *
+ * @pre @p queue must not be NULL.
+ *
+ * @note Connections that were not accepted are aborted. Accepted connections are left
+ *       open and are not returned to @p queue when they are closed. A thread waiting in
+ *       gnrc_tcp_accept() on @p queue returns -EINVAL.
+ *
+ * @param[in,out] queue   Listen queue.
+ */
+void gnrc_tcp_stop_listen(gnrc_tcp_tcb_queue_t *queue);
+
 /**
  * @brief Transmit data to connected peer.
  *
@@ -122,6 +258,9 @@ int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb, uint8_t address_family,
  * @pre @p data must not be NULL.
  *
  * @note Blocks until up to @p len bytes were transmitted or an error occured.
+ *       Transmitted data is kept for retransmission until the peer acknowledges it,
+ *       so this function returns as soon as data fits into the send window and does
+ *       not wait for the acknowledgment. See @ref GNRC_TCP_RETRANSMIT_QUEUE_SIZE.
  *
  * @param[in,out] tcb                        TCB holding the connection information.
  * @param[in]     data                       Pointer to the data that should be transmitted.
@@ -158,8 +297,12 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
  *                                           returns immediately. If not zero the function
  *                                           blocks until data is available or
  *                                           @p user_timeout_duration_us microseconds passed.
+ *                                           If GNRC_TCP_NO_TIMEOUT, the function waits
+ *                                           until data is available or the connection
+ *                                           is closed, however long it is idle.
  *
  * @returns   The number of bytes read into @p data.
+ *            Zero if the peer closed the connection and all data was read.
  *            -ENOTCONN if connection is not established.
  *            -EAGAIN if  user_timeout_duration_us is zero and no data is available.
  *            -ECONNRESET if connection was resetted by the peer.
@@ -189,6 +332,36 @@ void gnrc_tcp_close(gnrc_tcp_tcb_t *tcb);
  */
 void gnrc_tcp_abort(gnrc_tcp_tcb_t *tcb);
 
+#if defined(MODULE_GNRC_IPV6) || defined(DOXYGEN)
+/**
+ * @brief Get the local end point of a connection.
+ *
+ * @pre @p tcb must not be NULL.
+ *
+ * @param[in]  tcb    TCB holding the connection information.
+ * @param[out] addr   Local address. May be NULL.
+ * @param[out] port   Local port number. May be NULL.
+ *
+ * @returns   Zero on success.
+ *            -EADDRNOTAVAIL if @p tcb is not opened.
+ */
+int gnrc_tcp_get_local(gnrc_tcp_tcb_t *tcb, ipv6_addr_t *addr, uint16_t *port);
+
+/**
+ * @brief Get the remote end point of a connection.
+ *
+ * @pre @p tcb must not be NULL.
+ *
+ * @param[in]  tcb    TCB holding the connection information.
+ * @param[out] addr   Remote address. May be NULL.
+ * @param[out] port   Remote port number. May be NULL.
+ *
+ * @returns   Zero on success.
+ *            -ENOTCONN if @p tcb is not connected.
+ */
+int gnrc_tcp_get_remote(gnrc_tcp_tcb_t *tcb, ipv6_addr_t *addr, uint16_t *port);
+#endif
+
 /**
  * @brief Calculate and set checksum in TCP header.
  *
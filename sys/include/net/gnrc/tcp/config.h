@@ -68,7 +68,45 @@ extern "C" {
 #endif
 
 /**
- * @brief Number of preallocated receive buffers
+ * @brief Maximum number of unacknowledged segments in flight per connection
+ *
+ * Sent segments are kept in the connections retransmission queue until the
+ * peer acknowledges them. Together with the peers receive window and the
+ * congestion window, this limits the amount of data in flight.
+ */
+#ifndef GNRC_TCP_RETRANSMIT_QUEUE_SIZE
+#define GNRC_TCP_RETRANSMIT_QUEUE_SIZE (4U)
+#endif
+#if GNRC_TCP_RETRANSMIT_QUEUE_SIZE > 32
+#error "GNRC_TCP_RETRANSMIT_QUEUE_SIZE must not exceed 32"
+#endif
+
+/**
+ * @brief Number of duplicate ACKs that trigger a fast retransmit (see RFC 5681)
+ */
+#ifndef GNRC_TCP_DUPACK_THRESHOLD
+#define GNRC_TCP_DUPACK_THRESHOLD (3U)
+#endif
+
+/**
+ * @brief Enables selective acknowledgments (SACK, see RFC 2018), if the peer permits it
+ */
+#ifndef GNRC_TCP_SACK
+#define GNRC_TCP_SACK (1)
+#endif
+
+/**
+ * @brief Maximum number of segments received out of order that are kept per connection
+ *
+ * They are selectively acknowledged, if SACK is permitted, and handed to the
+ * user as soon as the missing data in front of them was received.
+ */
+#ifndef GNRC_TCP_OOO_QUEUE_SIZE
+#define GNRC_TCP_OOO_QUEUE_SIZE (4U)
+#endif
+
+/**
+ * @brief Number of default sized receive buffers that fit into the receive buffer pool
  */
 #ifndef GNRC_TCP_RCV_BUFFERS
 #define GNRC_TCP_RCV_BUFFERS (1U)
@@ -76,11 +114,46 @@ extern "C" {
 
 /**
  * @brief Default receive buffer size
+ *
+ * The size can be changed per connection with gnrc_tcp_tcb_set_rcv_buf_size().
  */
 #ifndef GNRC_TCP_RCV_BUF_SIZE
 #define GNRC_TCP_RCV_BUF_SIZE (GNRC_TCP_DEFAULT_WINDOW)
 #endif
 
+/**
+ * @brief Size of the pool, all receive buffers are allocated from
+ */
+#ifndef GNRC_TCP_RCV_BUF_POOL_SIZE
+#define GNRC_TCP_RCV_BUF_POOL_SIZE (GNRC_TCP_RCV_BUFFERS * GNRC_TCP_RCV_BUF_SIZE)
+#endif
+
+/**
+ * @brief Allocation granularity of the receive buffer pool
+ *
+ * Receive buffer sizes are rounded up to multiples of this size.
+ */
+#ifndef GNRC_TCP_RCV_BUF_BLOCK_SIZE
+#define GNRC_TCP_RCV_BUF_BLOCK_SIZE (GNRC_TCP_MSS)
+#endif
+
+/**
+ * @brief Enables window scaling (see RFC 7323), if the peer supports it
+ *
+ * Required to announce receive windows larger than 65535 byte.
+ */
+#ifndef GNRC_TCP_WND_SCALE
+#define GNRC_TCP_WND_SCALE (1)
+#endif
+
+/**
+ * @brief Number of SYN+ACK retransmissions, before a listen queue drops a half-open
+ *        connection
+ */
+#ifndef GNRC_TCP_SYN_ACK_RETRIES
+#define GNRC_TCP_SYN_ACK_RETRIES (4U)
+#endif
+
 /**
  * @brief Lower bound for RTO = 1 sec (see RFC 6298)
  */
@@ -137,6 +210,32 @@ extern "C" {
 #define GNRC_TCP_PROBE_UPPER_BOUND (60U * US_PER_SEC)
 #endif
 
+/**
+ * @brief Delay ACKs of received data by default (see RFC 1122, section 4.2.3.2)
+ *
+ * Disabled by default, so received data is acknowledged immediately. Can be
+ * changed per TCB with @ref gnrc_tcp_tcb_set_delayed_ack().
+ */
+#ifndef GNRC_TCP_DELAYED_ACK
+#define GNRC_TCP_DELAYED_ACK (0)
+#endif
+
+/**
+ * @brief Maximum time an ACK is delayed, must be less than 500 ms (see RFC 1122)
+ */
+#ifndef GNRC_TCP_ACK_DELAY
+#define GNRC_TCP_ACK_DELAY (200U * US_PER_MS)
+#endif
+
+/**
+ * @brief Coalesce small writes with Nagle's algorithm by default (see RFC 896)
+ *
+ * Can be changed per TCB with @ref gnrc_tcp_tcb_set_nagle().
+ */
+#ifndef GNRC_TCP_NAGLE
+#define GNRC_TCP_NAGLE (0)
+#endif
+
 #ifdef __cplusplus
 }
 #endif
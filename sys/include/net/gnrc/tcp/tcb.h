@@ -36,6 +36,11 @@
 #include "net/gnrc/ipv6.h"
 #endif
 
+#ifdef MODULE_GNRC_EVENTLOOP
+#include "event.h"
+#include "event/timeout.h"
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -45,6 +50,19 @@ extern "C" {
  */
 #define GNRC_TCP_TCB_MBOX_SIZE (8U)
 
+/**
+ * @brief Timer of a TCB.
+ */
+typedef struct {
+#ifdef MODULE_GNRC_EVENTLOOP
+    event_t super;            /**< Event, posted to the shared GNRC thread on timeouts */
+    event_timeout_t timeout;  /**< Timeout posting super */
+#else
+    xtimer_t timer;           /**< Timer struct, sending msg to the TCP thread on timeouts */
+#endif
+    msg_t msg;                /**< Message, handled on timeouts */
+} gnrc_tcp_timer_t;
+
 /**
  * @brief Transmission control block of GNRC TCP.
  */
@@ -58,34 +76,65 @@ typedef struct _transmission_control_block {
     uint16_t local_port;   /**< Local connections port number */
     uint16_t peer_port;    /**< Peer connections port number */
     uint8_t state;         /**< Connections state */
-    uint8_t status;        /**< A connections status flags */
+    uint16_t status;       /**< A connections status flags */
     uint32_t snd_una;      /**< Send unacknowledged */
     uint32_t snd_nxt;      /**< Send next */
-    uint16_t snd_wnd;      /**< Send window */
+    uint32_t snd_wnd;      /**< Send window */
     uint32_t snd_wl1;      /**< SeqNo. from last window update */
     uint32_t snd_wl2;      /**< AckNo. from last window update */
     uint32_t rcv_nxt;      /**< Receive next */
-    uint16_t rcv_wnd;      /**< Receive window */
+    uint32_t rcv_wnd;      /**< Receive window */
     uint32_t iss;          /**< Initial sequence sumber */
     uint32_t irs;          /**< Initial received sequence number */
     uint16_t mss;          /**< The peers MSS */
+    uint8_t snd_wnd_scale; /**< Shift count of the windows announced by the peer */
+    uint8_t rcv_wnd_scale; /**< Shift count of the windows announced to the peer */
+    uint32_t cwnd;         /**< Congestion window */
+    uint32_t ssthresh;     /**< Slow start threshold */
+    uint32_t recover;      /**< Send next, when the last loss recovery started */
+    uint8_t dupacks;       /**< Number of consecutive duplicate ACKs */
     uint32_t rtt_start;    /**< Timer value for rtt estimation */
+    uint32_t rtt_seq;      /**< Sequence number that ends the timed segment */
     int32_t rtt_var;       /**< Round trip time variance */
     int32_t srtt;          /**< Smoothed round trip time */
     int32_t rto;           /**< Retransmission timeout duration */
     uint8_t retries;       /**< Number of retransmissions */
-    xtimer_t tim_tout;     /**< Timer struct for timeouts */
-    msg_t msg_tout;        /**< Message, sent on timeouts */
-    gnrc_pktsnip_t *pkt_retransmit;   /**< Pointer to packet in "retransmit queue" */
+    gnrc_tcp_timer_t tim_tout;  /**< Timer for timeouts */
+    gnrc_tcp_timer_t tim_ack;   /**< Timer for delayed ACKs */
+    /** Packets in "retransmit queue", ordered by sequence number */
+    gnrc_pktsnip_t *pkt_retransmit[GNRC_TCP_RETRANSMIT_QUEUE_SIZE];
+    uint8_t pkt_retransmit_num;       /**< Number of packets in retransmission queue */
+    uint32_t pkt_sacked;              /**< Bitmap of selectively acknowledged packets in
+                                           "retransmit queue" */
+    uint32_t pkt_rexmit;              /**< Bitmap of packets in "retransmit queue" that were
+                                           retransmitted during the current recovery */
+    /** Packets received out of order, ordered by sequence number */
+    gnrc_pktsnip_t *pkt_ooo[GNRC_TCP_OOO_QUEUE_SIZE];
+    uint8_t pkt_ooo_num;              /**< Number of packets received out of order */
+    gnrc_pktsnip_t *pkt_unsent;       /**< Data held back by Nagle's algorithm */
+    uint16_t unsent_len;              /**< Number of bytes in pkt_unsent */
     msg_t mbox_raw[GNRC_TCP_TCB_MBOX_SIZE];   /**< Msg queue for mbox */
     mbox_t mbox;             /**< TCB mbox for synchronization */
     uint8_t *rcv_buf_raw;    /**< Pointer to the receive buffer */
+    uint32_t rcv_buf_size;   /**< Requested receive buffer size */
     ringbuffer_t rcv_buf;    /**< Receive buffer data structure */
     mutex_t fsm_lock;        /**< Mutex for FSM access synchronization */
     mutex_t function_lock;   /**< Mutex for function call synchronization */
+    struct _gnrc_tcp_tcb_queue *queue;          /**< Listen queue the TCB belongs to */
     struct _transmission_control_block *next;   /**< Pointer next TCB */
 } gnrc_tcp_tcb_t;
 
+/**
+ * @brief Listen queue of GNRC TCP.
+ */
+typedef struct _gnrc_tcp_tcb_queue {
+    mutex_t lock;            /**< Mutex for access synchronization */
+    gnrc_tcp_tcb_t *tcbs;    /**< TCBs listening for connections */
+    size_t tcbs_len;         /**< Number of TCBs in tcbs */
+    msg_t mbox_raw[GNRC_TCP_TCB_MBOX_SIZE];   /**< Msg queue for mbox */
+    mbox_t mbox;             /**< Mbox, notified when a connection was established */
+} gnrc_tcp_tcb_queue_t;
+
 #ifdef __cplusplus
 }
 #endif
@@ -22,6 +22,7 @@
 #ifndef NET_GNRC_UDP_H
 #define NET_GNRC_UDP_H
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include "byteorder.h"
@@ -66,6 +67,45 @@ extern "C" {
  */
 int gnrc_udp_calc_csum(gnrc_pktsnip_t *hdr, gnrc_pktsnip_t *pseudo_hdr);
 
+/**
+ * @brief   Calculate the checksum for the given packet, whose payload was
+ *          already summed up
+ *
+ * Same as gnrc_udp_calc_csum(), but the payload is not read. Instead, the
+ * checksum field of @p hdr holds the unnormalized Internet Checksum of the
+ * payload (see @ref GNRC_NETIF_HDR_FLAGS_CSUM_PAYLOAD) and is overwritten
+ * with the final checksum.
+ *
+ * @param[in] hdr           Pointer to the UDP header
+ * @param[in] pseudo_hdr    Pointer to the network layer header
+ *
+ * @return  0 on success
+ * @return  -EBADMSG if @p hdr is not of type GNRC_NETTYPE_UDP
+ * @return  -EFAULT if @p hdr or @p pseudo_hdr is NULL
+ * @return  -ENOENT if gnrc_pktsnip_t::type of @p pseudo_hdr is not known
+ */
+int gnrc_udp_calc_csum_partial(gnrc_pktsnip_t *hdr, gnrc_pktsnip_t *pseudo_hdr);
+
+/**
+ * @brief   Verify the checksum of a received packet, whose payload was
+ *          already summed up
+ *
+ * Allows a receiver to verify the checksum while it copies the payload
+ * (e.g. with inet_csum_copy()). Received packets are only left unverified
+ * by UDP when all receivers of its port do that, which is the case for
+ * @ref net_sock_udp. Packets with @ref GNRC_NETIF_HDR_FLAGS_CSUM_VALID
+ * set do not need to be verified.
+ *
+ * @param[in] hdr           Pointer to the UDP header
+ * @param[in] pseudo_hdr    Pointer to the network layer header
+ * @param[in] payload_sum   Unnormalized Internet Checksum of the payload
+ *
+ * @return  true, if the checksum is valid
+ * @return  false, if the checksum is invalid or zero
+ */
+bool gnrc_udp_check_csum(gnrc_pktsnip_t *hdr, gnrc_pktsnip_t *pseudo_hdr,
+                         uint16_t payload_sum);
+
 /**
  * @brief   Allocate and initialize a fresh UDP header in the packet buffer
  *
@@ -86,6 +126,9 @@ gnrc_pktsnip_t *gnrc_udp_hdr_build(gnrc_pktsnip_t *payload, uint16_t src,
  * @brief   Initialize and start UDP
  *
  * @return  PID of the UDP thread
+ * @return  PID of the shared thread with @ref net_gnrc_eventloop
+ * @return  KERNEL_PID_UNDEF with @ref net_gnrc_netapi_direct, since no thread
+ *          is started in that case
  * @return  negative value on error
  */
 int gnrc_udp_init(void);
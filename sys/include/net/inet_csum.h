@@ -49,6 +49,26 @@ extern "C" {
  */
 uint16_t inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len, size_t accum_len);
 
+/**
+ * @brief   Copies @p src to @p dst and calculates the unnormalized Internet
+ *          Checksum of the copied bytes on the way
+ *
+ * @details Same as inet_csum_slice() on @p src after a memcpy() from @p src
+ *          to @p dst, but the bytes are only read once. This is fastest if
+ *          @p dst and @p src share the same alignment.
+ *
+ * @param[in] sum       An initial value for the checksum.
+ * @param[out] dst      The destination buffer. Must not overlap with @p src.
+ * @param[in] src       The source buffer.
+ * @param[in] len       Number of bytes to copy from @p src to @p dst.
+ * @param[in] accum_len Accumulated length of checksum domain that has already
+ *                      been checksummed.
+ *
+ * @return  The unnormalized Internet Checksum of @p src.
+ */
+uint16_t inet_csum_copy(uint16_t sum, uint8_t *dst, const uint8_t *src,
+                        uint16_t len, size_t accum_len);
+
 /**
  * @brief   Calculates the unnormalized Internet Checksum of @p buf, where the
  *          buffer provides a standalone domain for the checksum.
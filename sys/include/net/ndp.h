@@ -92,6 +92,7 @@ extern "C" {
 #define NDP_OPT_AR                  (33)    /**< address registration option */
 #define NDP_OPT_6CTX                (34)    /**< 6LoWPAN context option */
 #define NDP_OPT_ABR                 (35)    /**< authoritative border router option */
+#define NDP_OPT_6CIO                (36)    /**< 6LoWPAN capability indication option */
 /** @} */
 
 /**
@@ -662,6 +662,30 @@ typedef enum {
      */
     NETOPT_RX_SYMBOL_TIMEOUT,
 
+    /**
+     * @brief   (@ref netopt_enable_t) checksum offloading for upper-layer
+     *          protocols of IPv6 (UDP, TCP and ICMPv6)
+     *
+     * If enabled, the device computes the checksum of outgoing packets where
+     * the upper-layer header directly follows the IPv6 header, if they are
+     * marked with @ref NETOPT_TX_CSUM_OFFLOAD. It also reports incoming
+     * packets whose upper-layer checksum it verified, e.g. for Ethernet
+     * devices via netdev_eth_rx_info_t::flags.
+     */
+    NETOPT_CSUM_OFFLOAD,
+
+    /**
+     * @brief   (@ref netopt_enable_t) the upper-layer checksum of the next
+     *          frame sent is left to the device
+     *
+     * Only the frames the network stack marks like this are offloaded, the
+     * checksum of all other frames (e.g. forwarded ones) is kept as is. The
+     * device resets this option after each send.
+     *
+     * Only supported while @ref NETOPT_CSUM_OFFLOAD is enabled.
+     */
+    NETOPT_TX_CSUM_OFFLOAD,
+
     /* add more options if needed */
 
     /**
@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_sixlowpan_ghc   6LoWPAN Generic Header Compression
+ * @ingroup     net_sixlowpan
+ * @brief       Generic Header Compression (GHC) codec for 6LoWPAN
+ *
+ * GHC compresses upper-layer headers and payloads with a simple LZ77-style
+ * bytecode. The compressor and the decompressor share a dictionary that is
+ * pre-filled with the IPv6 source and destination address of the datagram and
+ * a short static byte sequence (see @ref sixlowpan_ghc_dict_init()).
+ *
+ * @see     [RFC 7400](https://tools.ietf.org/html/rfc7400)
+ * @{
+ *
+ * @file
+ * @brief   Generic Header Compression definitions
+ *
+ * @author  Martine Lenders <m.lenders@fu-berlin.de>
+ */
+#ifndef NET_SIXLOWPAN_GHC_H
+#define NET_SIXLOWPAN_GHC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "net/ipv6/addr.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @name    GHC next header compression (NHC) IDs
+ * @see     [RFC 7400, section 3.1](https://tools.ietf.org/html/rfc7400#section-3.1)
+ * @{
+ */
+#define SIXLOWPAN_GHC_NHC_UDP       (0xd0)  /**< UDP header and payload */
+#define SIXLOWPAN_GHC_NHC_ICMPV6    (0xdf)  /**< ICMPv6 header and payload */
+/** @} */
+
+/**
+ * @name    GHC bytecodes
+ * @see     [RFC 7400, section 2](https://tools.ietf.org/html/rfc7400#section-2)
+ * @{
+ */
+#define SIXLOWPAN_GHC_LITERAL_MAX   (95U)   /**< maximum length of 0kkkkkkk */
+#define SIXLOWPAN_GHC_ZEROS         (0x80)  /**< 1000nnnn: nnnn + 2 zeros */
+#define SIXLOWPAN_GHC_ZEROS_MASK    (0xf0)  /**< mask for SIXLOWPAN_GHC_ZEROS */
+#define SIXLOWPAN_GHC_ZEROS_MAX     (17U)   /**< maximum length of 1000nnnn */
+#define SIXLOWPAN_GHC_STOP          (0x90)  /**< end of compressed data */
+#define SIXLOWPAN_GHC_EXT           (0xa0)  /**< 101nssss: extended arguments */
+#define SIXLOWPAN_GHC_EXT_MASK      (0xe0)  /**< mask for SIXLOWPAN_GHC_EXT */
+#define SIXLOWPAN_GHC_EXT_N         (0x10)  /**< n bit of SIXLOWPAN_GHC_EXT */
+#define SIXLOWPAN_GHC_BACKREF       (0xc0)  /**< 11nnnkkk: backreference */
+#define SIXLOWPAN_GHC_BACKREF_MASK  (0xc0)  /**< mask for SIXLOWPAN_GHC_BACKREF */
+/** @} */
+
+/**
+ * @brief   Length of the pre-filled dictionary
+ *
+ * IPv6 source address, IPv6 destination address and 16 static bytes.
+ */
+#define SIXLOWPAN_GHC_DICT_LEN      (2 * sizeof(ipv6_addr_t) + 16U)
+
+/**
+ * @brief   Checks if a next header compression ID denotes GHC
+ *
+ * @param[in] nhc   A next header compression ID.
+ *
+ * @return  true, if @p nhc is a GHC ID.
+ * @return  false, if @p nhc is not a GHC ID.
+ */
+static inline bool sixlowpan_ghc_nhc_is(uint8_t nhc)
+{
+    return (nhc == SIXLOWPAN_GHC_NHC_UDP) || (nhc == SIXLOWPAN_GHC_NHC_ICMPV6);
+}
+
+/**
+ * @brief   Fills the pre-filled dictionary for a datagram
+ *
+ * @see     [RFC 7400, section 2](https://tools.ietf.org/html/rfc7400#section-2)
+ *
+ * @param[out] dict     Dictionary of length @ref SIXLOWPAN_GHC_DICT_LEN.
+ * @param[in] src       The IPv6 source address of the datagram.
+ * @param[in] dst       The IPv6 destination address of the datagram.
+ */
+void sixlowpan_ghc_dict_init(uint8_t *dict, const ipv6_addr_t *src,
+                             const ipv6_addr_t *dst);
+
+/**
+ * @brief   Compresses data with GHC
+ *
+ * @param[out] out      Buffer for the compressed data.
+ * @param[in] out_len   Length of @p out.
+ * @param[in] in        The data to compress.
+ * @param[in] in_len    Length of @p in.
+ * @param[in] dict      Dictionary of length @ref SIXLOWPAN_GHC_DICT_LEN.
+ *
+ * @return  Length of the compressed data on success.
+ * @return  -ENOBUFS, if the compressed data does not fit into @p out.
+ */
+int sixlowpan_ghc_compress(uint8_t *out, size_t out_len,
+                           const uint8_t *in, size_t in_len,
+                           const uint8_t *dict);
+
+/**
+ * @brief   Decompresses GHC-compressed data
+ *
+ * Decompression ends at the end of @p in or at a @ref SIXLOWPAN_GHC_STOP.
+ *
+ * @param[out] out      Buffer for the decompressed data. May be NULL to only
+ *                      determine the length of the decompressed data.
+ * @param[in] out_len   Length of @p out.
+ * @param[in] in        The compressed data.
+ * @param[in] in_len    Length of @p in.
+ * @param[in] dict      Dictionary of length @ref SIXLOWPAN_GHC_DICT_LEN.
+ *
+ * @return  Length of the decompressed data on success.
+ * @return  -ENOBUFS, if the decompressed data does not fit into @p out.
+ * @return  -EINVAL, if @p in is malformed.
+ */
+int sixlowpan_ghc_decompress(uint8_t *out, size_t out_len,
+                             const uint8_t *in, size_t in_len,
+                             const uint8_t *dict);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_SIXLOWPAN_GHC_H */
+/** @} */
@@ -41,6 +41,7 @@ extern "C" {
 #define SIXLOWPAN_ND_OPT_6CTX_LEN_MAX           (3U)
 #define SIXLOWPAN_ND_OPT_AR_LEN                 (2U)
 #define SIXLOWPAN_ND_OPT_ABR_LEN                (3U)
+#define SIXLOWPAN_ND_OPT_6CIO_LEN               (1U)
 /**
  * @}
  */
@@ -80,6 +81,16 @@ extern "C" {
  * @}
  */
 
+/**
+ * @{
+ * @name    Flags for 6LoWPAN capability indication option
+ * @see     [RFC 7400, section 3.3](https://tools.ietf.org/html/rfc7400#section-3.3)
+ */
+#define SIXLOWPAN_ND_OPT_6CIO_FLAGS_G           (0x0001)    /**< GHC capable */
+/**
+ * @}
+ */
+
 /**
  * @name    6LoWPAN border router constants
  * @see     [RFC 6775, section 9](https://tools.ietf.org/html/rfc6775#section-9)
@@ -194,6 +205,19 @@ typedef struct __attribute__((packed)) {
     ipv6_addr_t braddr;     /**< 6LoWPAN border router address */
 } sixlowpan_nd_opt_abr_t;
 
+/**
+ * @brief   6LoWPAN capability indication option format
+ * @extends ndp_opt_t
+ *
+ * @see     [RFC 7400, section 3.3](https://tools.ietf.org/html/rfc7400#section-3.3)
+ */
+typedef struct __attribute__((packed)) {
+    uint8_t type;                   /**< option type */
+    uint8_t len;                    /**< length in units of 8 octets */
+    network_uint16_t resv_flags;    /**< 15-bit reserved, 1-bit G flag */
+    network_uint32_t resv;          /**< reserved field */
+} sixlowpan_nd_opt_6cio_t;
+
 /**
  * @brief   Checks if a 6LoWPAN context in an 6LoWPAN context option is
  *          valid for compression.
@@ -232,6 +256,21 @@ static inline void sixlowpan_nd_opt_6ctx_set_cid(sixlowpan_nd_opt_6ctx_t *ctx_op
     ctx_opt->resv_c_cid |= (SIXLOWPAN_ND_OPT_6CTX_FLAGS_CID_MASK & cid);
 }
 
+/**
+ * @brief   Checks if a 6LoWPAN capability indication option indicates GHC
+ *          capability.
+ *
+ * @param[in] cio_opt   A 6LoWPAN capability indication option.
+ *
+ * @return  true, if G bit is set in @p cio_opt.
+ * @return  false, if G bit is unset in @p cio_opt.
+ */
+static inline bool sixlowpan_nd_opt_6cio_is_ghc(const sixlowpan_nd_opt_6cio_t *cio_opt)
+{
+    return (bool)(byteorder_ntohs(cio_opt->resv_flags) &
+                  SIXLOWPAN_ND_OPT_6CIO_FLAGS_G);
+}
+
 /**
  * @brief   Gets the version in correct order from an Authoritative Border
  *          Router option
@@ -0,0 +1,322 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_sixlowpan_sfr   6LoWPAN Selective Fragment Recovery
+ * @ingroup     net_sixlowpan
+ * @brief       Header types and helper functions for 6LoWPAN Selective
+ *              Fragment Recovery (SFR)
+ * @see         [RFC 8931, section 5](https://tools.ietf.org/html/rfc8931#section-5)
+ * @{
+ *
+ * @file
+ * @brief   Header type and helper function definitions for 6LoWPAN SFR
+ *
+ * @author  Martine Lenders <m.lenders@fu-berlin.de>
+ */
+#ifndef NET_SIXLOWPAN_SFR_H
+#define NET_SIXLOWPAN_SFR_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "byteorder.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @name    SFR dispatch definitions
+ * @{
+ */
+#define SIXLOWPAN_SFR_DISP_MASK     (0xfe)  /**< mask for SFR dispatches */
+#define SIXLOWPAN_SFR_RFRAG_DISP    (0xe8)  /**< dispatch for RFRAG */
+#define SIXLOWPAN_SFR_ACK_DISP      (0xea)  /**< dispatch for RFRAG-ACK */
+#define SIXLOWPAN_SFR_ECN           (0x01U) /**< explicit congestion notification
+                                             *   flag */
+/** @} */
+
+/**
+ * @name    RFRAG field definitions
+ * @{
+ */
+#define SIXLOWPAN_SFR_ACK_REQ       (0x80U)     /**< acknowledgment request flag
+                                                 *   (in first byte of
+                                                 *   sixlowpan_sfr_rfrag_t::ar_seq_fs) */
+#define SIXLOWPAN_SFR_SEQ_MASK      (0x7cU)     /**< sequence number mask (in first
+                                                 *   byte of
+                                                 *   sixlowpan_sfr_rfrag_t::ar_seq_fs) */
+#define SIXLOWPAN_SFR_SEQ_POS       (2U)        /**< position of the sequence number */
+#define SIXLOWPAN_SFR_SEQ_MAX       (0x1fU)     /**< maximum sequence number */
+#define SIXLOWPAN_SFR_FRAG_SIZE_MASK    (0x03ffU)   /**< fragment size mask */
+#define SIXLOWPAN_SFR_FRAG_SIZE_MAX     (0x03ffU)   /**< maximum fragment size */
+/** @} */
+
+/**
+ * @name    RFRAG-ACK bitmap definitions
+ * @{
+ */
+#define SIXLOWPAN_SFR_ACK_BITMAP_NULL   (0x00000000UL)  /**< NULL bitmap (abort) */
+#define SIXLOWPAN_SFR_ACK_BITMAP_FULL   (0xffffffffUL)  /**< FULL bitmap */
+
+/**
+ * @brief   Bit of the fragment with sequence number @p seq in an RFRAG-ACK
+ *          bitmap (most significant bit is sequence number 0)
+ */
+#define SIXLOWPAN_SFR_ACK_BITMAP_BIT(seq)   (0x80000000UL >> (seq))
+/** @} */
+
+/**
+ * @brief   Generic type for the first two bytes of RFRAG and RFRAG-ACK
+ *
+ * @see [RFC 8931, section 5](https://tools.ietf.org/html/rfc8931#section-5)
+ */
+typedef struct __attribute__((packed)) {
+    uint8_t disp_ecn;   /**< dispatch and ECN flag */
+    uint8_t tag;        /**< datagram tag */
+} sixlowpan_sfr_t;
+
+/**
+ * @brief   Recoverable fragment header (RFRAG)
+ *
+ * @see [RFC 8931, section 5.1](https://tools.ietf.org/html/rfc8931#section-5.1)
+ *
+ * @extends sixlowpan_sfr_t
+ */
+typedef struct __attribute__((packed)) {
+    sixlowpan_sfr_t base;       /**< generic SFR header */
+    /**
+     * @brief   Acknowledgment request flag, sequence number, and fragment size
+     */
+    network_uint16_t ar_seq_fs;
+    /**
+     * @brief   Fragment offset
+     *
+     * For the first fragment (sequence number 0) this is the size of the
+     * uncompressed datagram.
+     */
+    network_uint16_t offset;
+} sixlowpan_sfr_rfrag_t;
+
+/**
+ * @brief   Recoverable fragment acknowledgment (RFRAG-ACK)
+ *
+ * @see [RFC 8931, section 5.2](https://tools.ietf.org/html/rfc8931#section-5.2)
+ *
+ * @extends sixlowpan_sfr_t
+ */
+typedef struct __attribute__((packed)) {
+    sixlowpan_sfr_t base;       /**< generic SFR header */
+    network_uint32_t bitmap;    /**< RFRAG-ACK bitmap */
+} sixlowpan_sfr_ack_t;
+
+/**
+ * @brief   Checks if a header is an SFR header
+ *
+ * @param[in] hdr   A 6LoWPAN header.
+ *
+ * @return  true, if @p hdr is an RFRAG or an RFRAG-ACK.
+ * @return  false, otherwise.
+ */
+static inline bool sixlowpan_sfr_is(const sixlowpan_sfr_t *hdr)
+{
+    return ((hdr->disp_ecn & SIXLOWPAN_SFR_DISP_MASK) ==
+            SIXLOWPAN_SFR_RFRAG_DISP) ||
+           ((hdr->disp_ecn & SIXLOWPAN_SFR_DISP_MASK) ==
+            SIXLOWPAN_SFR_ACK_DISP);
+}
+
+/**
+ * @brief   Checks if a header is an RFRAG
+ *
+ * @param[in] hdr   An SFR header.
+ *
+ * @return  true, if @p hdr is an RFRAG.
+ * @return  false, otherwise.
+ */
+static inline bool sixlowpan_sfr_rfrag_is(const sixlowpan_sfr_t *hdr)
+{
+    return ((hdr->disp_ecn & SIXLOWPAN_SFR_DISP_MASK) ==
+            SIXLOWPAN_SFR_RFRAG_DISP);
+}
+
+/**
+ * @brief   Checks if a header is an RFRAG-ACK
+ *
+ * @param[in] hdr   An SFR header.
+ *
+ * @return  true, if @p hdr is an RFRAG-ACK.
+ * @return  false, otherwise.
+ */
+static inline bool sixlowpan_sfr_ack_is(const sixlowpan_sfr_t *hdr)
+{
+    return ((hdr->disp_ecn & SIXLOWPAN_SFR_DISP_MASK) ==
+            SIXLOWPAN_SFR_ACK_DISP);
+}
+
+/**
+ * @brief   Initializes an RFRAG header
+ *
+ * All fields but the dispatch and the datagram tag are set to 0.
+ *
+ * @param[out] hdr  An RFRAG header.
+ * @param[in] tag   The datagram tag.
+ */
+static inline void sixlowpan_sfr_rfrag_set_disp(sixlowpan_sfr_rfrag_t *hdr,
+                                                uint8_t tag)
+{
+    hdr->base.disp_ecn = SIXLOWPAN_SFR_RFRAG_DISP;
+    hdr->base.tag = tag;
+    hdr->ar_seq_fs = byteorder_htons(0);
+    hdr->offset = byteorder_htons(0);
+}
+
+/**
+ * @brief   Initializes an RFRAG-ACK header
+ *
+ * @param[out] hdr      An RFRAG-ACK header.
+ * @param[in] tag       The datagram tag.
+ * @param[in] bitmap    The RFRAG-ACK bitmap (most significant bit is
+ *                      sequence number 0).
+ */
+static inline void sixlowpan_sfr_ack_set(sixlowpan_sfr_ack_t *hdr, uint8_t tag,
+                                         uint32_t bitmap)
+{
+    hdr->base.disp_ecn = SIXLOWPAN_SFR_ACK_DISP;
+    hdr->base.tag = tag;
+    hdr->bitmap = byteorder_htonl(bitmap);
+}
+
+/**
+ * @brief   Checks if the acknowledgment request flag of an RFRAG is set
+ *
+ * @param[in] hdr   An RFRAG header.
+ *
+ * @return  true, if the acknowledgment request flag is set.
+ * @return  false, otherwise.
+ */
+static inline bool sixlowpan_sfr_rfrag_ack_req(const sixlowpan_sfr_rfrag_t *hdr)
+{
+    return (hdr->ar_seq_fs.u8[0] & SIXLOWPAN_SFR_ACK_REQ) != 0;
+}
+
+/**
+ * @brief   Sets the acknowledgment request flag of an RFRAG
+ *
+ * @param[in,out] hdr   An RFRAG header.
+ */
+static inline void sixlowpan_sfr_rfrag_set_ack_req(sixlowpan_sfr_rfrag_t *hdr)
+{
+    hdr->ar_seq_fs.u8[0] |= SIXLOWPAN_SFR_ACK_REQ;
+}
+
+/**
+ * @brief   Gets the sequence number of an RFRAG
+ *
+ * @param[in] hdr   An RFRAG header.
+ *
+ * @return  The sequence number of @p hdr.
+ */
+static inline unsigned sixlowpan_sfr_rfrag_get_seq(const sixlowpan_sfr_rfrag_t *hdr)
+{
+    return (hdr->ar_seq_fs.u8[0] & SIXLOWPAN_SFR_SEQ_MASK) >>
+           SIXLOWPAN_SFR_SEQ_POS;
+}
+
+/**
+ * @brief   Sets the sequence number of an RFRAG
+ *
+ * @pre `seq <= SIXLOWPAN_SFR_SEQ_MAX`
+ *
+ * @param[in,out] hdr   An RFRAG header.
+ * @param[in] seq       A sequence number.
+ */
+static inline void sixlowpan_sfr_rfrag_set_seq(sixlowpan_sfr_rfrag_t *hdr,
+                                               unsigned seq)
+{
+    hdr->ar_seq_fs.u8[0] &= ~SIXLOWPAN_SFR_SEQ_MASK;
+    hdr->ar_seq_fs.u8[0] |= (seq << SIXLOWPAN_SFR_SEQ_POS) &
+                            SIXLOWPAN_SFR_SEQ_MASK;
+}
+
+/**
+ * @brief   Gets the fragment size of an RFRAG
+ *
+ * @param[in] hdr   An RFRAG header.
+ *
+ * @return  The number of bytes carried in the fragment.
+ */
+static inline size_t sixlowpan_sfr_rfrag_get_frag_size(const sixlowpan_sfr_rfrag_t *hdr)
+{
+    return byteorder_ntohs(hdr->ar_seq_fs) & SIXLOWPAN_SFR_FRAG_SIZE_MASK;
+}
+
+/**
+ * @brief   Sets the fragment size of an RFRAG
+ *
+ * @pre `frag_size <= SIXLOWPAN_SFR_FRAG_SIZE_MAX`
+ *
+ * @param[in,out] hdr       An RFRAG header.
+ * @param[in] frag_size     The number of bytes carried in the fragment.
+ */
+static inline void sixlowpan_sfr_rfrag_set_frag_size(sixlowpan_sfr_rfrag_t *hdr,
+                                                     size_t frag_size)
+{
+    uint16_t ar_seq_fs = byteorder_ntohs(hdr->ar_seq_fs);
+
+    ar_seq_fs &= ~SIXLOWPAN_SFR_FRAG_SIZE_MASK;
+    ar_seq_fs |= frag_size & SIXLOWPAN_SFR_FRAG_SIZE_MASK;
+    hdr->ar_seq_fs = byteorder_htons(ar_seq_fs);
+}
+
+/**
+ * @brief   Gets the fragment offset of an RFRAG
+ *
+ * @param[in] hdr   An RFRAG header.
+ *
+ * @return  The fragment offset of @p hdr or the size of the uncompressed
+ *          datagram if @p hdr is the first fragment.
+ */
+static inline uint16_t sixlowpan_sfr_rfrag_get_offset(const sixlowpan_sfr_rfrag_t *hdr)
+{
+    return byteorder_ntohs(hdr->offset);
+}
+
+/**
+ * @brief   Sets the fragment offset of an RFRAG
+ *
+ * @param[in,out] hdr   An RFRAG header.
+ * @param[in] offset    The fragment offset or the size of the uncompressed
+ *                      datagram for the first fragment.
+ */
+static inline void sixlowpan_sfr_rfrag_set_offset(sixlowpan_sfr_rfrag_t *hdr,
+                                                  uint16_t offset)
+{
+    hdr->offset = byteorder_htons(offset);
+}
+
+/**
+ * @brief   Gets the bitmap of an RFRAG-ACK
+ *
+ * @param[in] hdr   An RFRAG-ACK header.
+ *
+ * @return  The RFRAG-ACK bitmap (most significant bit is sequence number 0).
+ */
+static inline uint32_t sixlowpan_sfr_ack_get_bitmap(const sixlowpan_sfr_ack_t *hdr)
+{
+    return byteorder_ntohl(hdr->bitmap);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_SIXLOWPAN_SFR_H */
+/** @} */
@@ -273,6 +273,7 @@
 #include <stdlib.h>
 #include <sys/types.h>
 
+#include "iolist.h"
 #include "net/sock.h"
 
 #ifdef __cplusplus
@@ -450,6 +451,47 @@ ssize_t sock_ip_recv(sock_ip_t *sock, void *data, size_t max_len,
 ssize_t sock_ip_send(sock_ip_t *sock, const void *data, size_t len,
                      uint8_t proto, const sock_ip_ep_t *remote);
 
+/**
+ * @brief   Sends a message gathered from several buffers over IPv4/IPv6 to
+ *          remote end point
+ *
+ * @pre `((sock != NULL || remote != NULL))`
+ *
+ * The entries of @p snips are sent as the payload of one packet in list
+ * order.
+ *
+ * @note    With GNRC, a packet snip from the packet buffer can be passed as an
+ *          entry of @p snips, see sock_udp_sendv().
+ *
+ * @param[in] sock      A raw IPv4/IPv6 sock object. May be NULL.
+ *                      A sensible local end point should be selected by the
+ *                      implementation in that case.
+ * @param[in] snips     List of payload chunks, will be processed in order.
+ *                      May be `NULL`.
+ * @param[in] proto     Protocol to use in the packet sent, in case
+ *                      `sock == NULL`. If `sock != NULL` this parameter will be
+ *                      ignored.
+ * @param[in] remote    Remote end point for the sent data.
+ *                      May be `NULL`, if @p sock has a remote end point.
+ *                      sock_ip_ep_t::family may be AF_UNSPEC, if local
+ *                      end point of @p sock provides this information.
+ *
+ * @return  The number of bytes sent on success.
+ * @return  -EAFNOSUPPORT, if `remote != NULL` and sock_ip_ep_t::family of
+ *          @p remote is != AF_UNSPEC and not supported.
+ * @return  -EINVAL, if sock_ip_ep_t::addr of @p remote is an invalid address.
+ * @return  -EINVAL, if sock_ip_ep_t::netif of @p remote is not a
+ *          valid interface or contradicts the local interface of @p sock.
+ * @return  -EHOSTUNREACH, if @p remote or remote end point of @p sock is not
+ *          reachable.
+ * @return  -ENOMEM, if no memory was available to send @p snips.
+ * @return  -ENOTCONN, if `remote == NULL`, but @p sock has no remote end point.
+ * @return  -EPROTOTYPE, if `sock == NULL` and @p proto is not by
+ *          sock_ip_ep_t::family of @p remote.
+ */
+ssize_t sock_ip_sendv(sock_ip_t *sock, const iolist_t *snips, uint8_t proto,
+                      const sock_ip_ep_t *remote);
+
 #include "sock_types.h"
 
 #ifdef __cplusplus
@@ -273,6 +273,7 @@
 #include <stdlib.h>
 #include <sys/types.h>
 
+#include "iolist.h"
 #include "net/sock.h"
 
 #ifdef __cplusplus
@@ -390,6 +391,7 @@ int sock_udp_get_remote(sock_udp_t *sock, sock_udp_ep_t *ep);
  * @return  0, if no received data is available, but everything is in order.
  * @return  -EADDRNOTAVAIL, if local of @p sock is not given.
  * @return  -EAGAIN, if @p timeout is `0` and no data is available.
+ * @return  -EBADMSG, if the checksum of the received packet was invalid.
  * @return  -EINVAL, if @p remote is invalid or @p sock is not properly
  *          initialized (or closed while sock_udp_recv() blocks).
  * @return  -ENOBUFS, if buffer space is not large enough to store received
@@ -402,6 +404,64 @@ int sock_udp_get_remote(sock_udp_t *sock, sock_udp_ep_t *ep);
 ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
                       uint32_t timeout, sock_udp_ep_t *remote);
 
+/**
+ * @brief   Provides stack-internal buffer space containing a UDP message from
+ *          a remote end point
+ *
+ * @pre `(sock != NULL) && (data != NULL) && (buf_ctx != NULL)`
+ *
+ * The payload is not copied; @p data points into the buffer of the network
+ * stack instead. The chunks stay valid until the function returns 0 for
+ * @p buf_ctx. A message may be split over several buffer chunks, which are
+ * returned in the order of the payload, so the function should be called in
+ * a loop until it returns 0, e.g.
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * void *data, *ctx = NULL;
+ * ssize_t res;
+ *
+ * while ((res = sock_udp_recv_buf(&sock, &data, &ctx, SOCK_NO_TIMEOUT,
+ *                                 &remote)) > 0) {
+ *     handle(data, res);
+ * }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * @param[in] sock      A UDP sock object.
+ * @param[in,out] data  Pointer to the stack-internal buffer space containing
+ *                      the next chunk of the received data. Must be left
+ *                      as returned by the previous call for the same
+ *                      @p buf_ctx.
+ * @param[in,out] buf_ctx   Stack-internal buffer context. Must be `NULL` to
+ *                      receive a new message. Is reset to `NULL` once the
+ *                      buffer was released.
+ * @param[in] timeout   Timeout for receive in microseconds.
+ *                      If 0 and no data is available, the function returns
+ *                      immediately.
+ *                      May be @ref SOCK_NO_TIMEOUT for no timeout (wait until
+ *                      data is available). Only used when a new message is
+ *                      received.
+ * @param[out] remote   Remote end point of the received data.
+ *                      May be `NULL`, if it is not required by the application.
+ *
+ * @note    Function blocks if no packet is currently waiting.
+ *
+ * @return  The number of bytes available at @p data on success.
+ * @return  0, if no more data is available and the buffer behind @p buf_ctx
+ *          was released. This is also returned on the first call for a
+ *          message with an empty payload, @p buf_ctx is `NULL` then.
+ * @return  -EADDRNOTAVAIL, if local of @p sock is not given.
+ * @return  -EAGAIN, if @p timeout is `0` and no data is available.
+ * @return  -EBADMSG, if the checksum of the received packet was invalid.
+ * @return  -EINVAL, if @p remote is invalid or @p sock is not properly
+ *          initialized (or closed while sock_udp_recv_buf() blocks).
+ * @return  -ENOMEM, if no memory was available to receive @p data.
+ * @return  -EPROTO, if source address of received packet did not equal
+ *          the remote of @p sock.
+ * @return  -ETIMEDOUT, if @p timeout expired.
+ */
+ssize_t sock_udp_recv_buf(sock_udp_t *sock, void **data, void **buf_ctx,
+                          uint32_t timeout, sock_udp_ep_t *remote);
+
 /**
  * @brief   Sends a UDP message to remote end point
  *
@@ -438,6 +498,52 @@ ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
 ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
                       const sock_udp_ep_t *remote);
 
+/**
+ * @brief   Sends a UDP message gathered from several buffers to remote end
+ *          point
+ *
+ * @pre `((sock != NULL || remote != NULL))`
+ *
+ * The entries of @p snips are sent as one UDP message in list order. This
+ * allows e.g. to send a header that was built on the stack in front of a
+ * static payload without assembling both in an intermediate buffer first.
+ *
+ * @note    With GNRC, a packet snip from the packet buffer can be passed as an
+ *          entry of @p snips, as @ref gnrc_pktsnip_t starts with the fields
+ *          of iolist_t. That snip and all snips following it are linked into
+ *          the sent packet without being copied. The caller keeps its
+ *          reference to them.
+ *
+ * @param[in] sock      A raw IPv4/IPv6 sock object. May be `NULL`.
+ *                      A sensible local end point should be selected by the
+ *                      implementation in that case.
+ * @param[in] snips     List of payload chunks, will be processed in order.
+ *                      May be `NULL`.
+ * @param[in] remote    Remote end point for the sent data.
+ *                      May be `NULL`, if @p sock has a remote end point.
+ *                      sock_udp_ep_t::family may be AF_UNSPEC, if local
+ *                      end point of @p sock provides this information.
+ *                      sock_udp_ep_t::port may not be 0.
+ *
+ * @return  The number of bytes sent on success.
+ * @return  -EADDRINUSE, if `sock` has no local end-point or was `NULL` and the
+ *          pool of available ephemeral ports is depleted.
+ * @return  -EAFNOSUPPORT, if `remote != NULL` and sock_udp_ep_t::family of
+ *          @p remote is != AF_UNSPEC and not supported.
+ * @return  -EHOSTUNREACH, if @p remote or remote end point of @p sock is not
+ *          reachable.
+ * @return  -EINVAL, if sock_udp_ep_t::addr of @p remote is an invalid address.
+ * @return  -EINVAL, if sock_udp_ep_t::netif of @p remote is not a valid
+ *          interface or contradicts the given local interface (i.e.
+ *          neither the local end point of `sock` nor remote are assigned to
+ *          `SOCK_ADDR_ANY_NETIF` but are nevertheless different.
+ * @return  -EINVAL, if sock_udp_ep_t::port of @p remote is 0.
+ * @return  -ENOMEM, if no memory was available to send @p snips.
+ * @return  -ENOTCONN, if `remote == NULL`, but @p sock has no remote end point.
+ */
+ssize_t sock_udp_sendv(sock_udp_t *sock, const iolist_t *snips,
+                       const sock_udp_ep_t *remote);
+
 #include "sock_types.h"
 
 #ifdef __cplusplus
@@ -13,13 +13,159 @@
  */
 
 #include <inttypes.h>
+#include <limits.h>
+#include <stdbool.h>
 #include <stdio.h>
+#include <string.h>
+
+#include "byteorder.h"
 #include "od.h"
 #include "net/inet_csum.h"
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
+/* The buffer is summed up in words as wide as the platform can add cheaply:
+ * 64 bit with 64-bit pointers, 16 bit where int is only 16 bit wide and
+ * 32 bit otherwise. The carries of 16- and 32-bit words are collected in the
+ * upper half of the accumulator and only folded in once at the end. */
+#if UINTPTR_MAX > UINT32_MAX
+typedef uint64_t __attribute__((__may_alias__)) _word_t;
+typedef uint64_t _acc_t;
+#elif UINT_MAX >= UINT32_MAX
+typedef uint32_t __attribute__((__may_alias__)) _word_t;
+typedef uint64_t _acc_t;
+#else
+typedef uint16_t __attribute__((__may_alias__)) _word_t;
+typedef uint32_t _acc_t;
+#endif
+typedef uint16_t __attribute__((__may_alias__)) _half_t;
+
+#define _WORD_MASK      (sizeof(_word_t) - 1)
+
+/* The words are added in host byte order. A byte at an even address ends up
+ * in the lower half of a 16-bit word on little endian platforms */
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define _LITTLE_ENDIAN      (true)
+#define _BYTE_EVEN(b)       ((_acc_t)(b))
+#define _BYTE_ODD(b)        ((_acc_t)(b) << 8)
+#else
+#define _LITTLE_ENDIAN      (false)
+#define _BYTE_EVEN(b)       ((_acc_t)(b) << 8)
+#define _BYTE_ODD(b)        ((_acc_t)(b))
+#endif
+
+static inline _acc_t _add(_acc_t acc, _acc_t val)
+{
+    acc += val;
+#if UINTPTR_MAX > UINT32_MAX
+    /* 64-bit words can overflow the accumulator: wrap the carry around */
+    acc += (acc < val);
+#endif
+    return acc;
+}
+
+static inline uint16_t _fold(_acc_t acc)
+{
+    while (acc >> 16) {
+        acc = (acc & 0xffff) + (acc >> 16);
+    }
+    return (uint16_t)acc;
+}
+
+/* Sums up len > 0 bytes from src, starting with the upper half of a 16-bit
+ * word in network byte order. If dst is not NULL, src is also copied to dst,
+ * which then needs to have the same alignment as src in respect to _word_t. */
+static inline __attribute__((always_inline))
+uint16_t _sum(uint8_t *dst, const uint8_t *src, size_t len)
+{
+    const bool odd = (uintptr_t)src & 1;
+    _acc_t acc = 0;
+    uint16_t res;
+
+    if (odd) {
+        acc = _BYTE_ODD(*src);
+        if (dst) {
+            *(dst++) = *src;
+        }
+        src++;
+        len--;
+    }
+    while ((((uintptr_t)src) & _WORD_MASK) && (len >= sizeof(_half_t))) {
+        _half_t w = *((const _half_t *)src);
+
+        if (dst) {
+            *((_half_t *)dst) = w;
+            dst += sizeof(w);
+        }
+        acc = _add(acc, w);
+        src += sizeof(w);
+        len -= sizeof(w);
+    }
+    while (len >= (4 * sizeof(_word_t))) {
+        const _word_t *s = (const _word_t *)src;
+        _word_t w0 = s[0], w1 = s[1], w2 = s[2], w3 = s[3];
+
+        if (dst) {
+            _word_t *d = (_word_t *)dst;
+
+            d[0] = w0;
+            d[1] = w1;
+            d[2] = w2;
+            d[3] = w3;
+            dst += 4 * sizeof(_word_t);
+        }
+        acc = _add(acc, w0);
+        acc = _add(acc, w1);
+        acc = _add(acc, w2);
+        acc = _add(acc, w3);
+        src += 4 * sizeof(_word_t);
+        len -= 4 * sizeof(_word_t);
+    }
+    while (len >= sizeof(_word_t)) {
+        _word_t w = *((const _word_t *)src);
+
+        if (dst) {
+            *((_word_t *)dst) = w;
+            dst += sizeof(w);
+        }
+        acc = _add(acc, w);
+        src += sizeof(w);
+        len -= sizeof(w);
+    }
+    while (len >= sizeof(_half_t)) {
+        _half_t w = *((const _half_t *)src);
+
+        if (dst) {
+            *((_half_t *)dst) = w;
+            dst += sizeof(w);
+        }
+        acc = _add(acc, w);
+        src += sizeof(w);
+        len -= sizeof(w);
+    }
+    if (len) {
+        /* src is aligned again, so the last byte is at an even address */
+        acc = _add(acc, _BYTE_EVEN(*src));
+        if (dst) {
+            *dst = *src;
+        }
+    }
+    res = _fold(acc);
+    /* bytes at even addresses are the upper halves of the words if
+     * src was even on big endian or odd on little endian platforms */
+    return (odd != _LITTLE_ENDIAN) ? byteorder_swaps(res) : res;
+}
+
+static inline uint16_t _fold32(uint32_t csum)
+{
+    while (csum >> 16) {
+        uint16_t carry = csum >> 16;
+        csum = (csum & 0xffff) + carry;
+    }
+    return csum;
+}
+
 uint16_t inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len, size_t accum_len)
 {
     uint32_t csum = sum;
@@ -41,21 +187,47 @@ uint16_t inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len, size_t
         csum += *buf;         /* add first byte as bottom half of 16-byte word */
         buf++;
         len--;
-        accum_len++;
     }
 
-    for (unsigned i = 0; i < (len >> 1); buf += 2, i++) {
-        csum += (uint16_t)(*buf << 8) + *(buf + 1); /* group bytes by 16-byte words */
-                                                    /* and add them */
+    if (len > 0) {
+        csum += _sum(NULL, buf, len);
     }
+    csum = _fold32(csum);
 
-    if ((accum_len + len) & 1)          /* if accumulated length is odd */
-        csum += (uint16_t)(*buf << 8);  /* add last byte as top half of 16-byte word */
+    DEBUG("inet_sum: new sum = 0x%04" PRIx32 "\n", csum);
 
-    while (csum >> 16) {
-        uint16_t carry = csum >> 16;
-        csum = (csum & 0xffff) + carry;
+    return csum;
+}
+
+uint16_t inet_csum_copy(uint16_t sum, uint8_t *dst, const uint8_t *src,
+                        uint16_t len, size_t accum_len)
+{
+    uint32_t csum = sum;
+
+    DEBUG("inet_sum: copy with sum = 0x%04" PRIx16 ", len = %" PRIu16 "\n",
+          sum, len);
+
+    if (len == 0) {
+        return csum;
+    }
+
+    if (accum_len & 1) {      /* if accumulated length is odd */
+        csum += *src;         /* add first byte as bottom half of 16-byte word */
+        *(dst++) = *(src++);
+        len--;
+    }
+
+    if (len > 0) {
+        if (((uintptr_t)dst ^ (uintptr_t)src) & _WORD_MASK) {
+            /* words can't be accessed aligned in both buffers */
+            memcpy(dst, src, len);
+            csum += _sum(NULL, src, len);
+        }
+        else {
+            csum += _sum(dst, src, len);
+        }
     }
+    csum = _fold32(csum);
 
     DEBUG("inet_sum: new sum = 0x%04" PRIx32 "\n", csum);
 
@@ -109,6 +109,8 @@ static const char *_netopt_strmap[] = {
     [NETOPT_SYNCWORD]              = "NETOPT_SYNCWORD",
     [NETOPT_RANDOM]                = "NETOPT_RANDOM",
     [NETOPT_RX_SYMBOL_TIMEOUT]     = "NETOPT_RX_SYMBOL_TIMEOUT",
+    [NETOPT_CSUM_OFFLOAD]          = "NETOPT_CSUM_OFFLOAD",
+    [NETOPT_TX_CSUM_OFFLOAD]       = "NETOPT_TX_CSUM_OFFLOAD",
     [NETOPT_NUMOF]                 = "NETOPT_NUMOF",
 };
 
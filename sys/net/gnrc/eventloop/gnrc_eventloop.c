@@ -0,0 +1,206 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @author  Martine Lenders <m.lenders@fu-berlin.de>
+ */
+
+#include <assert.h>
+#include <errno.h>
+
+#include "irq.h"
+#include "thread_flags.h"
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/pktbuf.h"
+
+#include "net/gnrc/eventloop.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#ifndef GNRC_EVENTLOOP_MSG_QUEUE_SIZE
+#ifdef MODULE_GNRC_IPV6
+#include "net/gnrc/ipv6.h"
+#define _IPV6_MSG_QUEUE_SIZE        (GNRC_IPV6_MSG_QUEUE_SIZE)
+#else
+#define _IPV6_MSG_QUEUE_SIZE        (0U)
+#endif
+#ifdef MODULE_GNRC_SIXLOWPAN
+#include "net/gnrc/sixlowpan/config.h"
+#define _SIXLOWPAN_MSG_QUEUE_SIZE   (GNRC_SIXLOWPAN_MSG_QUEUE_SIZE)
+#else
+#define _SIXLOWPAN_MSG_QUEUE_SIZE   (0U)
+#endif
+
+#define _LAYERS_MSG_QUEUE_SIZE      (_IPV6_MSG_QUEUE_SIZE + \
+                                     _SIXLOWPAN_MSG_QUEUE_SIZE)
+
+#if _LAYERS_MSG_QUEUE_SIZE > 64U
+#error "gnrc_eventloop: define GNRC_EVENTLOOP_MSG_QUEUE_SIZE for such large layer queues"
+#endif
+
+/* msg_init_queue() requires a power of two; get and set requests to the
+ * thread need some room even without any of the layers above */
+#define GNRC_EVENTLOOP_MSG_QUEUE_SIZE \
+    ((_LAYERS_MSG_QUEUE_SIZE <= 4U) ? 4U : \
+     (_LAYERS_MSG_QUEUE_SIZE <= 8U) ? 8U : \
+     (_LAYERS_MSG_QUEUE_SIZE <= 16U) ? 16U : \
+     (_LAYERS_MSG_QUEUE_SIZE <= 32U) ? 32U : 64U)
+#endif
+
+kernel_pid_t gnrc_eventloop_pid = KERNEL_PID_UNDEF;
+
+#if ENABLE_DEBUG
+static char _stack[GNRC_EVENTLOOP_STACK_SIZE + THREAD_EXTRA_STACKSIZE_PRINTF];
+#else
+static char _stack[GNRC_EVENTLOOP_STACK_SIZE];
+#endif
+
+static event_queue_t _queue = EVENT_QUEUE_INIT_DETACHED;
+static gnrc_eventloop_layer_t *_layers = NULL;
+
+static void _netreg_cb(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx)
+{
+    if (gnrc_eventloop_put(ctx, cmd, pkt) < 1) {
+        DEBUG("eventloop: dropped packet to layer %p (was full)\n", ctx);
+        gnrc_pktbuf_release(pkt);
+    }
+}
+
+static void _handle_event(event_t *event)
+{
+    gnrc_eventloop_layer_t *layer = (gnrc_eventloop_layer_t *)event;
+    msg_t msg;
+
+    while (mbox_try_get(&layer->mbox, &msg)) {
+        layer->handler(&msg);
+    }
+}
+
+static void _handle_msg(msg_t *msg)
+{
+    switch (msg->type) {
+        case GNRC_NETAPI_MSG_TYPE_GET:
+        case GNRC_NETAPI_MSG_TYPE_SET: {
+            msg_t reply = { .type = GNRC_NETAPI_MSG_TYPE_ACK,
+                            .content = { .value = (uint32_t)-ENOTSUP } };
+
+            DEBUG("eventloop: reply to unsupported get/set\n");
+            msg_reply(msg, &reply);
+            return;
+        }
+        case GNRC_NETAPI_MSG_TYPE_RCV:
+        case GNRC_NETAPI_MSG_TYPE_SND:
+            /* the layer can't be determined for packets sent to the thread
+             * directly */
+            DEBUG("eventloop: dropped packet without layer\n");
+            gnrc_pktbuf_release(msg->content.ptr);
+            return;
+        default:
+            break;
+    }
+    for (gnrc_eventloop_layer_t *layer = _layers; layer != NULL;
+         layer = layer->next) {
+        if ((msg->type >= layer->msg_type_first) &&
+            (msg->type <= layer->msg_type_last)) {
+            layer->handler(msg);
+            return;
+        }
+    }
+    DEBUG("eventloop: unexpected message type 0x%04x\n", msg->type);
+}
+
+static void *_event_loop(void *args)
+{
+    msg_t msg, msg_q[GNRC_EVENTLOOP_MSG_QUEUE_SIZE];
+
+    (void)args;
+    msg_init_queue(msg_q, GNRC_EVENTLOOP_MSG_QUEUE_SIZE);
+    event_queue_claim(&_queue);
+
+    while (1) {
+        thread_flags_t flags = thread_flags_wait_any(THREAD_FLAG_EVENT |
+                                                     THREAD_FLAG_MSG_WAITING);
+        event_t *event;
+
+        if (flags & THREAD_FLAG_MSG_WAITING) {
+            while (msg_try_receive(&msg) == 1) {
+                _handle_msg(&msg);
+            }
+        }
+        if (flags & THREAD_FLAG_EVENT) {
+            while ((event = event_get(&_queue)) != NULL) {
+                event->handler(event);
+            }
+        }
+    }
+
+    return NULL;
+}
+
+kernel_pid_t gnrc_eventloop_init(void)
+{
+    if (gnrc_eventloop_pid == KERNEL_PID_UNDEF) {
+        gnrc_eventloop_pid = thread_create(_stack, sizeof(_stack),
+                                           GNRC_EVENTLOOP_PRIO,
+                                           THREAD_CREATE_STACKTEST,
+                                           _event_loop, NULL, "gnrc");
+    }
+    return gnrc_eventloop_pid;
+}
+
+void gnrc_eventloop_register(gnrc_eventloop_layer_t *layer, msg_t *queue,
+                             unsigned queue_size,
+                             gnrc_eventloop_handler_t handler,
+                             uint16_t msg_type_first, uint16_t msg_type_last)
+{
+    unsigned state;
+
+    assert(layer != NULL);
+    layer->super.list_node.next = NULL;
+    layer->super.handler = _handle_event;
+    mbox_init(&layer->mbox, queue, queue_size);
+    layer->cbd.cb = _netreg_cb;
+    layer->cbd.ctx = layer;
+    layer->handler = handler;
+    layer->msg_type_first = msg_type_first;
+    layer->msg_type_last = msg_type_last;
+    state = irq_disable();
+    layer->next = _layers;
+    _layers = layer;
+    irq_restore(state);
+}
+
+int gnrc_eventloop_put(gnrc_eventloop_layer_t *layer, uint16_t cmd,
+                       gnrc_pktsnip_t *pkt)
+{
+    msg_t msg = { .type = cmd, .content = { .ptr = pkt } };
+
+    if (!mbox_try_put(&layer->mbox, &msg)) {
+        return 0;
+    }
+    event_post(&_queue, &layer->super);
+    return 1;
+}
+
+void gnrc_eventloop_timeout_init(event_timeout_t *timeout, event_t *event)
+{
+    assert((timeout != NULL) && (event != NULL));
+    event_timeout_init(timeout, &_queue, event);
+}
+
+void gnrc_eventloop_cancel(event_t *event)
+{
+    assert(event != NULL);
+    event_cancel(&_queue, event);
+}
+
+/** @} */
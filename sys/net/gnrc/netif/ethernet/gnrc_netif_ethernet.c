@@ -20,6 +20,7 @@
 #include "net/ethernet/hdr.h"
 #include "net/gnrc.h"
 #include "net/gnrc/netif/ethernet.h"
+#include "net/netdev/eth.h"
 #ifdef MODULE_GNRC_IPV6
 #include "net/ipv6/hdr.h"
 #endif
@@ -151,6 +152,17 @@ static int _send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
         netif->stats.tx_unicast_count++;
     }
 #endif
+    if (netif_hdr->flags & GNRC_NETIF_HDR_FLAGS_CSUM_OFFLOAD) {
+        netopt_enable_t enable = NETOPT_ENABLE;
+
+        /* only the packets the network layer did not sum up are offloaded */
+        if ((res = dev->driver->set(dev, NETOPT_TX_CSUM_OFFLOAD, &enable,
+                                    sizeof(enable))) < 0) {
+            DEBUG("gnrc_netif_ethernet: device can't complete checksum\n");
+            gnrc_pktbuf_release(pkt);
+            return res;
+        }
+    }
     res = dev->driver->send(dev, &iolist);
 
     gnrc_pktbuf_release(pkt);
@@ -178,7 +190,9 @@ static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif)
             goto out;
         }
 
-        int nread = dev->driver->recv(dev, pkt->data, bytes_expected, NULL);
+        netdev_eth_rx_info_t rx_info = { .flags = 0 };
+        int nread = dev->driver->recv(dev, pkt->data, bytes_expected,
+                                      &rx_info);
         if (nread <= 0) {
             DEBUG("gnrc_netif_ethernet: read error.\n");
             goto safe_out;
@@ -231,6 +245,10 @@ static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif)
         gnrc_netif_hdr_set_src_addr(netif_hdr->data, hdr->src, ETHERNET_ADDR_LEN);
         gnrc_netif_hdr_set_dst_addr(netif_hdr->data, hdr->dst, ETHERNET_ADDR_LEN);
         gnrc_netif_hdr_set_netif(netif_hdr->data, netif);
+        if (rx_info.flags & NETDEV_ETH_RX_INFO_FLAG_CSUM_VALID) {
+            ((gnrc_netif_hdr_t *)netif_hdr->data)->flags |=
+                GNRC_NETIF_HDR_FLAGS_CSUM_VALID;
+        }
 
         DEBUG("gnrc_netif_ethernet: received packet from %02x:%02x:%02x:%02x:%02x:%02x "
               "of length %d\n",
@@ -42,6 +42,7 @@ static gnrc_netif_t _netifs[GNRC_NETIF_NUMOF];
 
 static void _update_l2addr_from_dev(gnrc_netif_t *netif);
 static void _configure_netdev(netdev_t *dev);
+static void _update_csum_offload_from_dev(gnrc_netif_t *netif);
 static void *_gnrc_netif_thread(void *args);
 static void _event_cb(netdev_t *dev, netdev_event_t event);
 
@@ -190,14 +191,6 @@ int gnrc_netif_get_from_netdev(gnrc_netif_t *netif, gnrc_netapi_opt_t *opt)
             assert(opt->data_len >= sizeof(eui64_t));
             res = gnrc_netif_ipv6_get_iid(netif, opt->data);
             break;
-        case NETOPT_MAX_PDU_SIZE:
-            if (opt->context == GNRC_NETTYPE_IPV6) {
-                assert(opt->data_len == sizeof(uint16_t));
-                *((uint16_t *)opt->data) = netif->ipv6.mtu;
-                res = sizeof(uint16_t);
-            }
-            /* else ask device */
-            break;
 #if GNRC_IPV6_NIB_CONF_ROUTER
         case NETOPT_IPV6_FORWARDING:
             assert(opt->data_len == sizeof(netopt_enable_t));
@@ -213,6 +206,25 @@ int gnrc_netif_get_from_netdev(gnrc_netif_t *netif, gnrc_netapi_opt_t *opt)
             break;
 #endif  /* GNRC_IPV6_NIB_CONF_ROUTER */
 #endif  /* MODULE_GNRC_IPV6 */
+#if defined(MODULE_GNRC_IPV6) || defined(MODULE_GNRC_SIXLOWPAN)
+        case NETOPT_MAX_PDU_SIZE:
+#ifdef MODULE_GNRC_IPV6
+            if (opt->context == GNRC_NETTYPE_IPV6) {
+                assert(opt->data_len == sizeof(uint16_t));
+                *((uint16_t *)opt->data) = netif->ipv6.mtu;
+                res = sizeof(uint16_t);
+            }
+#endif  /* MODULE_GNRC_IPV6 */
+#ifdef MODULE_GNRC_SIXLOWPAN
+            if (opt->context == GNRC_NETTYPE_SIXLOWPAN) {
+                assert(opt->data_len == sizeof(uint16_t));
+                *((uint16_t *)opt->data) = netif->sixlo.max_frag_size;
+                res = sizeof(uint16_t);
+            }
+#endif  /* MODULE_GNRC_SIXLOWPAN */
+            /* else ask device */
+            break;
+#endif
 #ifdef MODULE_GNRC_SIXLOWPAN_IPHC
         case NETOPT_6LO_IPHC:
             assert(opt->data_len == sizeof(netopt_enable_t));
@@ -265,6 +277,9 @@ int gnrc_netif_set_from_netdev(gnrc_netif_t *netif,
             /* acquire locks a recursive mutex so we are safe calling this
              * public function */
             gnrc_netif_ipv6_addr_remove_internal(netif, opt->data);
+#if defined(MODULE_GNRC_IPV6_NIB) && GNRC_IPV6_NIB_CONF_DCACHE
+            gnrc_ipv6_nib_dcache_invalidate();
+#endif
             res = sizeof(ipv6_addr_t);
             break;
         case NETOPT_IPV6_GROUP:
@@ -283,14 +298,6 @@ int gnrc_netif_set_from_netdev(gnrc_netif_t *netif,
             gnrc_netif_ipv6_group_leave_internal(netif, opt->data);
             res = sizeof(ipv6_addr_t);
             break;
-        case NETOPT_MAX_PDU_SIZE:
-            if (opt->context == GNRC_NETTYPE_IPV6) {
-                assert(opt->data_len == sizeof(uint16_t));
-                netif->ipv6.mtu = *((uint16_t *)opt->data);
-                res = sizeof(uint16_t);
-            }
-            /* else set device */
-            break;
 #if GNRC_IPV6_NIB_CONF_ROUTER
         case NETOPT_IPV6_FORWARDING:
             assert(opt->data_len == sizeof(netopt_enable_t));
@@ -313,6 +320,25 @@ int gnrc_netif_set_from_netdev(gnrc_netif_t *netif,
             break;
 #endif  /* GNRC_IPV6_NIB_CONF_ROUTER */
 #endif  /* MODULE_GNRC_IPV6 */
+#if defined(MODULE_GNRC_IPV6) || defined(MODULE_GNRC_SIXLOWPAN)
+        case NETOPT_MAX_PDU_SIZE:
+#ifdef MODULE_GNRC_IPV6
+            if (opt->context == GNRC_NETTYPE_IPV6) {
+                assert(opt->data_len == sizeof(uint16_t));
+                netif->ipv6.mtu = *((uint16_t *)opt->data);
+                res = sizeof(uint16_t);
+            }
+#endif  /* MODULE_GNRC_IPV6 */
+#ifdef MODULE_GNRC_SIXLOWPAN
+            if (opt->context == GNRC_NETTYPE_SIXLOWPAN) {
+                assert(opt->data_len == sizeof(uint16_t));
+                netif->sixlo.max_frag_size = *((uint16_t *)opt->data);
+                res = sizeof(uint16_t);
+            }
+#endif  /* MODULE_GNRC_SIXLOWPAN */
+            /* else set device */
+            break;
+#endif
 #ifdef MODULE_GNRC_SIXLOWPAN_IPHC
         case NETOPT_6LO_IPHC:
             assert(opt->data_len == sizeof(netopt_enable_t));
@@ -356,6 +382,9 @@ int gnrc_netif_set_from_netdev(gnrc_netif_t *netif,
                         _configure_netdev(netif->dev);
                     }
                     break;
+                case NETOPT_CSUM_OFFLOAD:
+                    _update_csum_offload_from_dev(netif);
+                    break;
                 default:
                     break;
             }
@@ -629,6 +658,11 @@ int gnrc_netif_ipv6_addr_add_internal(gnrc_netif_t *netif,
             gnrc_ipv6_nib_pl_set(netif->pid, addr, pfx_len,
                                  UINT32_MAX, UINT32_MAX);
         }
+#if GNRC_IPV6_NIB_CONF_DCACHE
+        /* only valid addresses are considered for source address selection,
+         * others are invalidated by the NIB when they become valid */
+        gnrc_ipv6_nib_dcache_invalidate();
+#endif
     }
 #if GNRC_IPV6_NIB_CONF_SLAAC
     else if (!gnrc_netif_is_6ln(netif)) {
@@ -1131,6 +1165,21 @@ static void _update_l2addr_from_dev(gnrc_netif_t *netif)
     }
 }
 
+static void _update_csum_offload_from_dev(gnrc_netif_t *netif)
+{
+    netdev_t *dev = netif->dev;
+    netopt_enable_t enable = NETOPT_DISABLE;
+
+    if ((dev->driver->get(dev, NETOPT_CSUM_OFFLOAD, &enable,
+                          sizeof(enable)) == sizeof(enable)) &&
+        (enable == NETOPT_ENABLE)) {
+        netif->flags |= GNRC_NETIF_FLAGS_CSUM_OFFLOAD;
+    }
+    else {
+        netif->flags &= ~GNRC_NETIF_FLAGS_CSUM_OFFLOAD;
+    }
+}
+
 static void _init_from_device(gnrc_netif_t *netif)
 {
     int res;
@@ -1143,6 +1192,7 @@ static void _init_from_device(gnrc_netif_t *netif)
     netif->device_type = (uint8_t)tmp;
     gnrc_netif_ipv6_init_mtu(netif);
     _update_l2addr_from_dev(netif);
+    _update_csum_offload_from_dev(netif);
 }
 
 static void _configure_netdev(netdev_t *dev)
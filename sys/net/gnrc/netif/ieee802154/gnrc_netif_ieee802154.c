@@ -30,12 +30,22 @@
 
 static int _send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt);
 static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif);
+#ifdef MODULE_GNRC_NETIF_CSMA_ASYNC
+static void _init(gnrc_netif_t *netif);
+static void _msg_handler(gnrc_netif_t *netif, msg_t *msg);
+#endif
 
 static const gnrc_netif_ops_t ieee802154_ops = {
+#ifdef MODULE_GNRC_NETIF_CSMA_ASYNC
+    .init = _init,
+#endif
     .send = _send,
     .recv = _recv,
     .get = gnrc_netif_get_from_netdev,
     .set = gnrc_netif_set_from_netdev,
+#ifdef MODULE_GNRC_NETIF_CSMA_ASYNC
+    .msg_handler = _msg_handler,
+#endif
 };
 
 gnrc_netif_t *gnrc_netif_ieee802154_create(char *stack, int stacksize,
@@ -217,6 +227,97 @@ static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif)
     return pkt;
 }
 
+#ifdef MODULE_GNRC_NETIF_CSMA_ASYNC
+static void _init(gnrc_netif_t *netif)
+{
+    /* use software CSMA/CA, unless the device does it in hardware */
+    netif->mac.mac_info |= GNRC_NETIF_MAC_INFO_CSMA_ENABLED;
+    netif->mac.csma_conf = CSMA_SENDER_CONF_DEFAULT;
+    gnrc_priority_pktqueue_init(&netif->mac.csma_queue);
+}
+
+static int _csma_queue(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
+{
+    for (unsigned i = 0; i < GNRC_NETIF_CSMA_ASYNC_QUEUE_SIZE; i++) {
+        gnrc_priority_pktqueue_node_t *node = &netif->mac.csma_queue_nodes[i];
+
+        if (node->pkt == NULL) {
+            /* same priority for all, so packets are sent in order */
+            gnrc_priority_pktqueue_node_init(node, 0, pkt);
+            gnrc_priority_pktqueue_push(&netif->mac.csma_queue, node);
+            return 0;
+        }
+    }
+    DEBUG("_send_ieee802154: CSMA/CA queue full, dropping packet\n");
+    gnrc_pktbuf_release(pkt);
+    return -ENOBUFS;
+}
+
+static int _csma_send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt,
+                      const iolist_t *iolist)
+{
+    int res;
+
+    /* the frame needs to stay valid during the backoff periods */
+    memcpy(netif->mac.csma_mhr, iolist->iol_base, iolist->iol_len);
+    netif->mac.csma_iolist.iol_next = iolist->iol_next;
+    netif->mac.csma_iolist.iol_base = netif->mac.csma_mhr;
+    netif->mac.csma_iolist.iol_len = iolist->iol_len;
+    res = csma_sender_csma_ca_send_async(&netif->mac.csma, netif->dev,
+                                         &netif->mac.csma_iolist,
+                                         &netif->mac.csma_conf);
+    if (res == 0) {
+        /* backing off, keep packet until csma_sender_backoff_expired()
+         * is done with it */
+        netif->mac.csma_pkt = pkt;
+    }
+    else {
+        gnrc_pktbuf_release(pkt);
+    }
+    return res;
+}
+
+static void _csma_sent(gnrc_netif_t *netif, int res)
+{
+    if (res < 0) {
+        DEBUG("_send_ieee802154: error sending packet (code: %i)\n", res);
+    }
+#ifdef MODULE_NETSTATS_L2
+    else {
+        netif->stats.tx_bytes += res;
+    }
+#else
+    (void)netif;
+#endif
+}
+
+static void _msg_handler(gnrc_netif_t *netif, msg_t *msg)
+{
+    gnrc_pktsnip_t *pkt;
+    int res;
+
+    if (msg->type != CSMA_SENDER_MSG_TYPE_BACKOFF) {
+        DEBUG("_msg_handler_ieee802154: unknown message type 0x%04x\n",
+              msg->type);
+        return;
+    }
+    assert(msg->content.ptr == &netif->mac.csma);
+    res = csma_sender_backoff_expired(&netif->mac.csma);
+    if (res == 0) {
+        /* medium busy, backing off again */
+        return;
+    }
+    gnrc_pktbuf_release(netif->mac.csma_pkt);
+    netif->mac.csma_pkt = NULL;
+    _csma_sent(netif, res);
+    /* send queued packets until one needs to back off */
+    while ((netif->mac.csma_pkt == NULL) &&
+           ((pkt = gnrc_priority_pktqueue_pop(&netif->mac.csma_queue)) != NULL)) {
+        _csma_sent(netif, _send(netif, pkt));
+    }
+}
+#endif /* MODULE_GNRC_NETIF_CSMA_ASYNC */
+
 static int _send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
 {
     netdev_t *dev = netif->dev;
@@ -238,6 +339,12 @@ static int _send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
         DEBUG("_send_ieee802154: first header is not generic netif header\n");
         return -EBADMSG;
     }
+#ifdef MODULE_GNRC_NETIF_CSMA_ASYNC
+    if (netif->mac.csma_pkt != NULL) {
+        /* software CSMA/CA is still busy with the previous frame */
+        return _csma_queue(netif, pkt);
+    }
+#endif
     netif_hdr = pkt->data;
     if (netif_hdr->flags & GNRC_NETIF_HDR_FLAGS_MORE_DATA) {
         /* Set frame pending field */
@@ -287,7 +394,11 @@ static int _send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
 #endif
 #ifdef MODULE_GNRC_MAC
     if (netif->mac.mac_info & GNRC_NETIF_MAC_INFO_CSMA_ENABLED) {
+#ifdef MODULE_GNRC_NETIF_CSMA_ASYNC
+        return _csma_send(netif, pkt, &iolist);
+#else
         res = csma_sender_csma_ca_send(dev, &iolist, &netif->mac.csma_conf);
+#endif
     }
     else {
         res = dev->driver->send(dev, &iolist);
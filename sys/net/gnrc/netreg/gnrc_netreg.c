@@ -28,13 +28,41 @@
 
 #define _INVALID_TYPE(type) (((type) < GNRC_NETTYPE_UNDEF) || ((type) >= GNRC_NETTYPE_NUMOF))
 
+#ifdef MODULE_GNRC_NETREG_HASHED
+#if (GNRC_NETREG_HASH_BUCKETS & (GNRC_NETREG_HASH_BUCKETS - 1)) != 0
+#error "GNRC_NETREG_HASH_BUCKETS must be a power of two"
+#endif
+
+/* The registry as lookup table by gnrc_nettype_t and hash of demux_ctx.
+ * Entries with the same demux_ctx always end up in the same bucket, so
+ * gnrc_netreg_getnext() can continue from an entry's successor */
+static gnrc_netreg_entry_t *netreg[GNRC_NETTYPE_NUMOF][GNRC_NETREG_HASH_BUCKETS];
+
+static inline gnrc_netreg_entry_t **_head(gnrc_nettype_t type,
+                                          uint32_t demux_ctx)
+{
+    /* fold all bytes so both ports and GNRC_NETREG_DEMUX_CTX_ALL spread */
+    uint32_t hash = demux_ctx ^ (demux_ctx >> 16);
+
+    hash ^= hash >> 8;
+    return &netreg[type][hash & (GNRC_NETREG_HASH_BUCKETS - 1)];
+}
+#else   /* MODULE_GNRC_NETREG_HASHED */
 /* The registry as lookup table by gnrc_nettype_t */
 static gnrc_netreg_entry_t *netreg[GNRC_NETTYPE_NUMOF];
 
+static inline gnrc_netreg_entry_t **_head(gnrc_nettype_t type,
+                                          uint32_t demux_ctx)
+{
+    (void)demux_ctx;
+    return &netreg[type];
+}
+#endif  /* MODULE_GNRC_NETREG_HASHED */
+
 void gnrc_netreg_init(void)
 {
     /* set all pointers in registry to NULL */
-    memset(netreg, 0, GNRC_NETTYPE_NUMOF * sizeof(gnrc_netreg_entry_t *));
+    memset(netreg, 0, sizeof(netreg));
 }
 
 int gnrc_netreg_register(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
@@ -59,7 +87,7 @@ int gnrc_netreg_register(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
         return -EINVAL;
     }
 
-    LL_PREPEND(netreg[type], entry);
+    LL_PREPEND(*_head(type, entry->demux_ctx), entry);
 
     return 0;
 }
@@ -70,7 +98,7 @@ void gnrc_netreg_unregister(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
         return;
     }
 
-    LL_DELETE(netreg[type], entry);
+    LL_DELETE(*_head(type, entry->demux_ctx), entry);
 }
 
 /**
@@ -92,7 +120,8 @@ static gnrc_netreg_entry_t *_netreg_lookup(gnrc_netreg_entry_t *from,
     gnrc_netreg_entry_t *res = NULL;
 
     if (from || !_INVALID_TYPE(type)) {
-        gnrc_netreg_entry_t *head = (from) ? from->next : netreg[type];
+        gnrc_netreg_entry_t *head = (from) ? from->next
+                                           : *_head(type, demux_ctx);
         LL_SEARCH_SCALAR(head, res, demux_ctx, demux_ctx);
     }
 
@@ -77,7 +77,8 @@ void gnrc_icmpv6_demux(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
 
     hdr = (icmpv6_hdr_t *)icmpv6->data;
 
-    if (_calc_csum(icmpv6, ipv6, pkt)) {
+    if (!(gnrc_netif_hdr_get_flag(pkt) & GNRC_NETIF_HDR_FLAGS_CSUM_VALID) &&
+        _calc_csum(icmpv6, ipv6, pkt)) {
         DEBUG("icmpv6: wrong checksum.\n");
         gnrc_pktbuf_release(pkt);
         return;
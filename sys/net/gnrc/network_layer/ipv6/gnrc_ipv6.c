@@ -20,6 +20,9 @@
 #include "cpu_conf.h"
 #include "kernel_types.h"
 #include "net/gnrc.h"
+#ifdef MODULE_GNRC_EVENTLOOP
+#include "net/gnrc/eventloop.h"
+#endif
 #include "net/gnrc/icmpv6.h"
 #include "net/gnrc/sixlowpan/ctx.h"
 #include "net/gnrc/sixlowpan/nd.h"
@@ -33,13 +36,19 @@
 #include "net/gnrc/ipv6/blacklist.h"
 
 #include "net/gnrc/ipv6.h"
+#ifdef MODULE_GNRC_UDP
+#include "net/gnrc/udp.h"
+#endif
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
 #define _MAX_L2_ADDR_LEN    (8U)
 
-#if ENABLE_DEBUG
+#ifdef MODULE_GNRC_EVENTLOOP
+static gnrc_eventloop_layer_t _layer;
+static msg_t _layer_queue[GNRC_IPV6_MSG_QUEUE_SIZE];
+#elif ENABLE_DEBUG
 static char _stack[GNRC_IPV6_STACK_SIZE + THREAD_EXTRA_STACKSIZE_PRINTF];
 #else
 static char _stack[GNRC_IPV6_STACK_SIZE];
@@ -69,15 +78,32 @@ static void _receive(gnrc_pktsnip_t *pkt);
  * prep_hdr: prepare header for sending (call to _fill_ipv6_hdr()), otherwise
  * assume it is already prepared */
 static void _send(gnrc_pktsnip_t *pkt, bool prep_hdr);
+/* handles messages to IPv6 */
+static void _handle_msg(msg_t *msg);
+#ifdef MODULE_GNRC_EVENTLOOP
+/* registry entry of IPv6 in the shared thread */
+static gnrc_netreg_entry_t _me_reg;
+#else
 /* Main event loop for IPv6 */
 static void *_event_loop(void *args);
+#endif
 
 kernel_pid_t gnrc_ipv6_init(void)
 {
     if (gnrc_ipv6_pid == KERNEL_PID_UNDEF) {
+#ifdef MODULE_GNRC_EVENTLOOP
+        gnrc_ipv6_pid = gnrc_eventloop_init();
+        gnrc_eventloop_register(&_layer, _layer_queue,
+                                GNRC_IPV6_MSG_QUEUE_SIZE, _handle_msg,
+                                GNRC_IPV6_NIB_SND_UC_NS,
+                                GNRC_IPV6_NIB_RDNSS_TIMEOUT);
+        /* register interest in all IPv6 packets */
+        gnrc_netreg_register(GNRC_NETTYPE_IPV6, &_me_reg);
+#else
         gnrc_ipv6_pid = thread_create(_stack, sizeof(_stack), GNRC_IPV6_PRIO,
                                       THREAD_CREATE_STACKTEST,
                                       _event_loop, NULL, "ipv6");
+#endif
     }
 
 #ifdef MODULE_FIB
@@ -162,11 +188,92 @@ static void _dispatch_next_header(gnrc_pktsnip_t *pkt, unsigned nh,
     }
 }
 
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+static void _direct(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx)
+{
+    int res;
+
+    (void)ctx;
+    /* Received packets are only handled directly in the IPv6 thread itself:
+     * the NIB calls into the network interfaces with gnrc_netapi_get() and
+     * gnrc_netapi_set() while holding its lock, so an interface thread must
+     * never wait for that lock in _receive(). The NIB also sends packets while
+     * holding its lock, so sending is always handled by the IPv6 thread */
+    if ((cmd == GNRC_NETAPI_MSG_TYPE_RCV) && (sched_active_pid == gnrc_ipv6_pid)) {
+        DEBUG("ipv6: direct GNRC_NETAPI_MSG_TYPE_RCV\n");
+        _receive(pkt);
+        return;
+    }
+#ifdef MODULE_GNRC_EVENTLOOP
+    res = gnrc_eventloop_put(&_layer, cmd, pkt);
+#else
+    res = _gnrc_netapi_send_recv(gnrc_ipv6_pid, pkt, cmd);
+#endif
+    if (res < 1) {
+        DEBUG("ipv6: unable to pass packet to IPv6 thread\n");
+        gnrc_pktbuf_release(pkt);
+    }
+}
+
+static gnrc_netreg_entry_cbd_t _direct_cbd = { .cb = _direct };
+#endif  /* MODULE_GNRC_NETAPI_DIRECT */
+
+static void _handle_msg(msg_t *msg)
+{
+    switch (msg->type) {
+        case GNRC_NETAPI_MSG_TYPE_RCV:
+            DEBUG("ipv6: GNRC_NETAPI_MSG_TYPE_RCV received\n");
+            _receive(msg->content.ptr);
+            break;
+
+        case GNRC_NETAPI_MSG_TYPE_SND:
+            DEBUG("ipv6: GNRC_NETAPI_MSG_TYPE_SND received\n");
+            _send(msg->content.ptr, true);
+            break;
+
+        case GNRC_IPV6_NIB_SND_UC_NS:
+        case GNRC_IPV6_NIB_SND_MC_NS:
+        case GNRC_IPV6_NIB_SND_NA:
+        case GNRC_IPV6_NIB_SEARCH_RTR:
+        case GNRC_IPV6_NIB_REPLY_RS:
+        case GNRC_IPV6_NIB_SND_MC_RA:
+        case GNRC_IPV6_NIB_REACH_TIMEOUT:
+        case GNRC_IPV6_NIB_DELAY_TIMEOUT:
+        case GNRC_IPV6_NIB_ADDR_REG_TIMEOUT:
+        case GNRC_IPV6_NIB_ABR_TIMEOUT:
+        case GNRC_IPV6_NIB_PFX_TIMEOUT:
+        case GNRC_IPV6_NIB_RTR_TIMEOUT:
+        case GNRC_IPV6_NIB_RECALC_REACH_TIME:
+        case GNRC_IPV6_NIB_REREG_ADDRESS:
+        case GNRC_IPV6_NIB_DAD:
+        case GNRC_IPV6_NIB_VALID_ADDR:
+            DEBUG("ipv6: NIB timer event received\n");
+            gnrc_ipv6_nib_handle_timer_event(msg->content.ptr, msg->type);
+            break;
+        default:
+            break;
+    }
+}
+
+#ifdef MODULE_GNRC_EVENTLOOP
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+static gnrc_netreg_entry_t _me_reg = GNRC_NETREG_ENTRY_INIT_CB(GNRC_NETREG_DEMUX_CTX_ALL,
+                                                               &_direct_cbd);
+#else
+static gnrc_netreg_entry_t _me_reg = GNRC_NETREG_ENTRY_INIT_CB(GNRC_NETREG_DEMUX_CTX_ALL,
+                                                               &_layer.cbd);
+#endif
+#else   /* MODULE_GNRC_EVENTLOOP */
 static void *_event_loop(void *args)
 {
     msg_t msg, reply, msg_q[GNRC_IPV6_MSG_QUEUE_SIZE];
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+    gnrc_netreg_entry_t me_reg = GNRC_NETREG_ENTRY_INIT_CB(GNRC_NETREG_DEMUX_CTX_ALL,
+                                                           &_direct_cbd);
+#else
     gnrc_netreg_entry_t me_reg = GNRC_NETREG_ENTRY_INIT_PID(GNRC_NETREG_DEMUX_CTX_ALL,
                                                             sched_active_pid);
+#endif
 
     (void)args;
     msg_init_queue(msg_q, GNRC_IPV6_MSG_QUEUE_SIZE);
@@ -183,49 +290,21 @@ static void *_event_loop(void *args)
         msg_receive(&msg);
 
         switch (msg.type) {
-            case GNRC_NETAPI_MSG_TYPE_RCV:
-                DEBUG("ipv6: GNRC_NETAPI_MSG_TYPE_RCV received\n");
-                _receive(msg.content.ptr);
-                break;
-
-            case GNRC_NETAPI_MSG_TYPE_SND:
-                DEBUG("ipv6: GNRC_NETAPI_MSG_TYPE_SND received\n");
-                _send(msg.content.ptr, true);
-                break;
-
             case GNRC_NETAPI_MSG_TYPE_GET:
             case GNRC_NETAPI_MSG_TYPE_SET:
                 DEBUG("ipv6: reply to unsupported get/set\n");
                 reply.content.value = -ENOTSUP;
                 msg_reply(&msg, &reply);
                 break;
-
-            case GNRC_IPV6_NIB_SND_UC_NS:
-            case GNRC_IPV6_NIB_SND_MC_NS:
-            case GNRC_IPV6_NIB_SND_NA:
-            case GNRC_IPV6_NIB_SEARCH_RTR:
-            case GNRC_IPV6_NIB_REPLY_RS:
-            case GNRC_IPV6_NIB_SND_MC_RA:
-            case GNRC_IPV6_NIB_REACH_TIMEOUT:
-            case GNRC_IPV6_NIB_DELAY_TIMEOUT:
-            case GNRC_IPV6_NIB_ADDR_REG_TIMEOUT:
-            case GNRC_IPV6_NIB_ABR_TIMEOUT:
-            case GNRC_IPV6_NIB_PFX_TIMEOUT:
-            case GNRC_IPV6_NIB_RTR_TIMEOUT:
-            case GNRC_IPV6_NIB_RECALC_REACH_TIME:
-            case GNRC_IPV6_NIB_REREG_ADDRESS:
-            case GNRC_IPV6_NIB_DAD:
-            case GNRC_IPV6_NIB_VALID_ADDR:
-                DEBUG("ipv6: NIB timer event received\n");
-                gnrc_ipv6_nib_handle_timer_event(msg.content.ptr, msg.type);
-                break;
             default:
+                _handle_msg(&msg);
                 break;
         }
     }
 
     return NULL;
 }
+#endif  /* MODULE_GNRC_EVENTLOOP */
 
 static void _send_to_iface(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
 {
@@ -299,7 +378,14 @@ static bool _is_ipv6_hdr(gnrc_pktsnip_t *hdr)
 #endif
 }
 
-static int _fill_ipv6_hdr(gnrc_netif_t *netif, gnrc_pktsnip_t *ipv6)
+/* checks if the device of netif computes upper-layer checksums */
+static inline bool _csum_offload(const gnrc_netif_t *netif)
+{
+    return (netif->flags & GNRC_NETIF_FLAGS_CSUM_OFFLOAD);
+}
+
+static int _fill_ipv6_hdr(gnrc_netif_t *netif, gnrc_pktsnip_t *ipv6,
+                          uint8_t *netif_hdr_flags, bool to_iface)
 {
     int res;
     ipv6_hdr_t *hdr = ipv6->data;
@@ -339,6 +425,14 @@ static int _fill_ipv6_hdr(gnrc_netif_t *netif, gnrc_pktsnip_t *ipv6)
         if (ipv6_addr_is_loopback(&hdr->dst)) {
             ipv6_addr_set_loopback(&hdr->src);
         }
+#if GNRC_IPV6_NIB_CONF_DCACHE
+        else if ((netif != NULL) &&
+                 gnrc_ipv6_nib_dcache_get_src(&hdr->dst, netif->pid,
+                                              &hdr->src)) {
+            DEBUG("ipv6: set packet source to cached %s\n",
+                  ipv6_addr_to_str(addr_str, &hdr->src, sizeof(addr_str)));
+        }
+#endif
         else {
             ipv6_addr_t *src = gnrc_netif_ipv6_addr_best_src(netif, &hdr->dst,
                                                              false);
@@ -347,6 +441,9 @@ static int _fill_ipv6_hdr(gnrc_netif_t *netif, gnrc_pktsnip_t *ipv6)
                 DEBUG("ipv6: set packet source to %s\n",
                       ipv6_addr_to_str(addr_str, src, sizeof(addr_str)));
                 memcpy(&hdr->src, src, sizeof(ipv6_addr_t));
+#if GNRC_IPV6_NIB_CONF_DCACHE
+                gnrc_ipv6_nib_dcache_set_src(&hdr->dst, netif->pid, src);
+#endif
             }
             /* Otherwise leave unspecified */
         }
@@ -367,8 +464,34 @@ static int _fill_ipv6_hdr(gnrc_netif_t *netif, gnrc_pktsnip_t *ipv6)
         prev->next = payload;
         prev = payload;
     }
+#ifdef MODULE_GNRC_UDP
+    /* the upper layer already summed up the payload while copying it */
+    bool csum_payload = (*netif_hdr_flags & GNRC_NETIF_HDR_FLAGS_CSUM_PAYLOAD) &&
+                        (payload->type == GNRC_NETTYPE_UDP);
+#endif
+
+    *netif_hdr_flags &= ~GNRC_NETIF_HDR_FLAGS_CSUM_PAYLOAD;
+    if (to_iface && (netif != NULL) && _csum_offload(netif) &&
+        (ipv6->next == payload) &&
+        (gnrc_nettype_to_protnum(payload->type) == hdr->nh)) {
+        /* devices only handle upper-layer headers directly after the IPv6
+         * header. The flag tells the device which packets to complete,
+         * forwarded ones keep their checksum */
+        DEBUG("ipv6: leave checksum for upper header to device.\n");
+        *netif_hdr_flags |= GNRC_NETIF_HDR_FLAGS_CSUM_OFFLOAD;
+        return 0;
+    }
     DEBUG("ipv6: calculate checksum for upper header.\n");
-    if ((res = gnrc_netreg_calc_csum(payload, ipv6)) < 0) {
+#ifdef MODULE_GNRC_UDP
+    if (csum_payload) {
+        res = gnrc_udp_calc_csum_partial(payload, ipv6);
+    }
+    else
+#endif
+    {
+        res = gnrc_netreg_calc_csum(payload, ipv6);
+    }
+    if (res < 0) {
         if (res != -ENOENT) {   /* if there is no checksum we are okay */
             DEBUG("ipv6: checksum calculation failed.\n");
             /* packet will be released by caller */
@@ -380,9 +503,11 @@ static int _fill_ipv6_hdr(gnrc_netif_t *netif, gnrc_pktsnip_t *ipv6)
 }
 
 static bool _safe_fill_ipv6_hdr(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt,
-                                bool prep_hdr)
+                                bool prep_hdr, uint8_t *netif_hdr_flags,
+                                bool to_iface)
 {
-    if (prep_hdr && (_fill_ipv6_hdr(netif, pkt) < 0)) {
+    if (prep_hdr &&
+        (_fill_ipv6_hdr(netif, pkt, netif_hdr_flags, to_iface) < 0)) {
         /* error on filling up header */
         gnrc_pktbuf_release(pkt);
         return false;
@@ -407,7 +532,7 @@ static void _send_unicast(gnrc_pktsnip_t *pkt, bool prep_hdr,
     }
     netif = gnrc_netif_get_by_pid(gnrc_ipv6_nib_nc_get_iface(&nce));
     assert(netif != NULL);
-    if (_safe_fill_ipv6_hdr(netif, pkt, prep_hdr)) {
+    if (_safe_fill_ipv6_hdr(netif, pkt, prep_hdr, &netif_hdr_flags, true)) {
         DEBUG("ipv6: add interface header to packet\n");
         if ((pkt = _create_netif_hdr(nce.l2addr, nce.l2addr_len, pkt,
                                      netif_hdr_flags)) == NULL) {
@@ -463,6 +588,8 @@ static void _send_multicast(gnrc_pktsnip_t *pkt, bool prep_hdr,
         gnrc_pktbuf_hold(pkt, ifnum - 1);
 
         while ((netif = gnrc_netif_iter(netif))) {
+            uint8_t flags = netif_hdr_flags;
+
             if (prep_hdr) {
                 DEBUG("ipv6: prepare IPv6 header for sending\n");
                 /* need to get second write access (duplication) to fill IPv6
@@ -475,7 +602,7 @@ static void _send_multicast(gnrc_pktsnip_t *pkt, bool prep_hdr,
                     gnrc_pktbuf_release(pkt);
                     return;
                 }
-                if (_fill_ipv6_hdr(netif, tmp) < 0) {
+                if (_fill_ipv6_hdr(netif, tmp, &flags, true) < 0) {
                     /* error on filling up header */
                     if (tmp != pkt) {
                         gnrc_pktbuf_release(tmp);
@@ -484,11 +611,12 @@ static void _send_multicast(gnrc_pktsnip_t *pkt, bool prep_hdr,
                     return;
                 }
             }
-            _send_multicast_over_iface(pkt, netif, netif_hdr_flags);
+            _send_multicast_over_iface(pkt, netif, flags);
         }
     }
     else {
-        if (_safe_fill_ipv6_hdr(netif, pkt, prep_hdr)) {
+        if (_safe_fill_ipv6_hdr(netif, pkt, prep_hdr, &netif_hdr_flags,
+                                true)) {
             _send_multicast_over_iface(pkt, netif, netif_hdr_flags);
         }
     }
@@ -502,16 +630,17 @@ static void _send_multicast(gnrc_pktsnip_t *pkt, bool prep_hdr,
             return;
         }
     }
-    if (_safe_fill_ipv6_hdr(netif, pkt, prep_hdr)) {
+    if (_safe_fill_ipv6_hdr(netif, pkt, prep_hdr, &netif_hdr_flags, true)) {
         _send_multicast_over_iface(pkt, netif, netif_hdr_flags);
     }
 #endif  /* GNRC_NETIF_NUMOF */
 }
 
 static void _send_to_self(gnrc_pktsnip_t *pkt, bool prep_hdr,
-                          gnrc_netif_t *netif)
+                          gnrc_netif_t *netif, uint8_t netif_hdr_flags)
 {
-    if (!_safe_fill_ipv6_hdr(netif, pkt, prep_hdr) ||
+    /* no device completes the checksum on the way to ourselves */
+    if (!_safe_fill_ipv6_hdr(netif, pkt, prep_hdr, &netif_hdr_flags, false) ||
         /* no netif header so we just merge the whole packet. */
         (gnrc_pktbuf_merge(pkt) != 0)) {
         DEBUG("ipv6: error looping packet to sender.\n");
@@ -594,7 +723,7 @@ static void _send(gnrc_pktsnip_t *pkt, bool prep_hdr)
         if (ipv6_addr_is_loopback(&ipv6_hdr->dst) ||    /* dst is loopback address */
             /* or dst registered to a local interface */
             (tmp_netif != NULL)) {
-            _send_to_self(pkt, prep_hdr, tmp_netif);
+            _send_to_self(pkt, prep_hdr, tmp_netif, netif_hdr_flags);
         }
         else {
             _send_unicast(pkt, prep_hdr, netif, ipv6_hdr, netif_hdr_flags);
@@ -430,8 +430,14 @@ void _set_reachable(gnrc_netif_t *netif, _nib_onl_entry_t *nce)
 void _set_nud_state(gnrc_netif_t *netif, _nib_onl_entry_t *nce,
                     uint16_t state)
 {
+    bool was_reachable = _is_reachable(nce);
+
     nce->info &= ~GNRC_IPV6_NIB_NC_INFO_NUD_STATE_MASK;
     nce->info |= state;
+    if (was_reachable != _is_reachable(nce)) {
+        /* might change default router selection */
+        _nib_dcache_invalidate();
+    }
 
 #if GNRC_IPV6_NIB_CONF_ROUTER
     gnrc_netif_acquire(netif);
@@ -39,6 +39,41 @@ static _nib_onl_entry_t _nodes[GNRC_IPV6_NIB_NUMOF];
 static _nib_offl_entry_t _dsts[GNRC_IPV6_NIB_OFFL_NUMOF];
 static _nib_dr_entry_t _def_routers[GNRC_IPV6_NIB_DEFAULT_ROUTER_NUMOF];
 
+#if GNRC_IPV6_NIB_CONF_HASHED
+#if (GNRC_IPV6_NIB_HASH_BUCKETS & (GNRC_IPV6_NIB_HASH_BUCKETS - 1)) != 0
+#error "GNRC_IPV6_NIB_HASH_BUCKETS must be a power of two"
+#endif
+static _nib_onl_entry_t *_buckets[GNRC_IPV6_NIB_HASH_BUCKETS];
+/* slots of _nodes and _dsts that are in use */
+static BITFIELD(_nodes_used, GNRC_IPV6_NIB_NUMOF);
+static BITFIELD(_dsts_used, GNRC_IPV6_NIB_OFFL_NUMOF);
+
+/**
+ * @brief   Node of the prefix trie indexing the off-link entries
+ *
+ * The trie is compressed and binary like the one of the `fib_trie` module:
+ * a node either holds an entry, or is a glue node branching at a bit where
+ * no entry exists. The key of an entry is the first
+ * _nib_offl_entry_t::pfx_len bits of its prefix.
+ */
+typedef struct _nib_pfx_node {
+    struct _nib_pfx_node *parent;   /**< parent node, NULL for the root */
+    /** children, indexed by the key bit following the first `len` bits */
+    struct _nib_pfx_node *child[2];
+    /** further entries with the same key, next free glue node when unused */
+    struct _nib_pfx_node *dup;
+    _nib_offl_entry_t *entry;       /**< entry of this node, NULL for glue */
+    uint8_t len;                    /**< key length in bits */
+} _nib_pfx_node_t;
+
+/* node of each entry in _dsts and the glue nodes, a trie of n entries needs
+ * at most n - 1 glue nodes */
+static _nib_pfx_node_t _pfx_nodes[GNRC_IPV6_NIB_OFFL_NUMOF];
+static _nib_pfx_node_t _pfx_glue[GNRC_IPV6_NIB_OFFL_NUMOF];
+static _nib_pfx_node_t *_pfx_root;
+static _nib_pfx_node_t *_pfx_free;
+#endif  /* GNRC_IPV6_NIB_CONF_HASHED */
+
 #if GNRC_IPV6_NIB_CONF_MULTIHOP_P6C
 static _nib_abr_entry_t _abrs[GNRC_IPV6_NIB_ABR_NUMOF];
 #endif  /* GNRC_IPV6_NIB_CONF_MULTIHOP_P6C */
@@ -51,6 +86,9 @@ evtimer_msg_t _nib_evtimer;
 static void _override_node(const ipv6_addr_t *addr, unsigned iface,
                            _nib_onl_entry_t *node);
 static inline bool _node_unreachable(_nib_onl_entry_t *node);
+#if GNRC_IPV6_NIB_CONF_HASHED
+static void _pfx_init(void);
+#endif  /* GNRC_IPV6_NIB_CONF_HASHED */
 
 void _nib_init(void)
 {
@@ -58,12 +96,21 @@ void _nib_init(void)
     _prime_def_router = NULL;
     _next_removable.next = NULL;
     memset(_nodes, 0, sizeof(_nodes));
+#if GNRC_IPV6_NIB_CONF_HASHED
+    memset(_buckets, 0, sizeof(_buckets));
+    memset(_nodes_used, 0, sizeof(_nodes_used));
+    memset(_dsts_used, 0, sizeof(_dsts_used));
+#endif  /* GNRC_IPV6_NIB_CONF_HASHED */
     memset(_def_routers, 0, sizeof(_def_routers));
     memset(_dsts, 0, sizeof(_dsts));
 #if GNRC_IPV6_NIB_CONF_MULTIHOP_P6C
     memset(_abrs, 0, sizeof(_abrs));
 #endif  /* GNRC_IPV6_NIB_CONF_MULTIHOP_P6C */
+    _nib_dcache_invalidate();
 #endif  /* TEST_SUITES */
+#if GNRC_IPV6_NIB_CONF_HASHED
+    _pfx_init();
+#endif  /* GNRC_IPV6_NIB_CONF_HASHED */
     evtimer_init_msg(&_nib_evtimer);
     /* TODO: load ABR information from persistent memory */
 }
@@ -75,6 +122,80 @@ static inline bool _addr_equals(const ipv6_addr_t *addr,
            (ipv6_addr_equal(addr, &node->ipv6));
 }
 
+static inline bool _onl_matches(const ipv6_addr_t *addr, unsigned iface,
+                                const _nib_onl_entry_t *node)
+{
+    return (node->mode != _EMPTY) &&
+           /* either requested or current interface undefined or
+            * interfaces equal */
+           ((_nib_onl_get_if(node) == 0) || (iface == 0) ||
+            (_nib_onl_get_if(node) == iface)) &&
+           ipv6_addr_equal(&node->ipv6, addr);
+}
+
+#if GNRC_IPV6_NIB_CONF_HASHED
+static inline _nib_onl_entry_t **_bucket(const ipv6_addr_t *addr)
+{
+    /* fold all words, neighbors on the same link only differ in their IID */
+    uint32_t hash = addr->u32[0].u32 ^ addr->u32[1].u32 ^
+                    addr->u32[2].u32 ^ addr->u32[3].u32;
+
+    hash ^= hash >> 16;
+    hash ^= hash >> 8;
+    return &_buckets[hash & (GNRC_IPV6_NIB_HASH_BUCKETS - 1)];
+}
+
+static void _onl_unhash(_nib_onl_entry_t *node)
+{
+    for (_nib_onl_entry_t **ptr = _bucket(&node->ipv6); *ptr != NULL;
+         ptr = &(*ptr)->hnext) {
+        if (*ptr == node) {
+            *ptr = node->hnext;
+            node->hnext = NULL;
+            return;
+        }
+    }
+}
+
+void _nib_onl_free(_nib_onl_entry_t *node)
+{
+    _onl_unhash(node);
+    bf_unset(_nodes_used, node - _nodes);
+}
+
+static _nib_onl_entry_t *_onl_alloc_match(_nib_onl_entry_t *node,
+                                          const ipv6_addr_t *addr,
+                                          unsigned iface,
+                                          _nib_onl_entry_t *res)
+{
+    for (; node != NULL; node = node->hnext) {
+        /* the linear search returned the first entry in _nodes, so do we */
+        if ((_nib_onl_get_if(node) == iface) && _addr_equals(addr, node) &&
+            ((res == NULL) || (node < res))) {
+            res = node;
+        }
+    }
+    return res;
+}
+#endif  /* GNRC_IPV6_NIB_CONF_HASHED */
+
+static inline void _onl_set_ipv6(_nib_onl_entry_t *node,
+                                 const ipv6_addr_t *addr)
+{
+#if GNRC_IPV6_NIB_CONF_HASHED
+    _onl_unhash(node);
+#endif  /* GNRC_IPV6_NIB_CONF_HASHED */
+    if (addr != NULL) {
+        memcpy(&node->ipv6, addr, sizeof(node->ipv6));
+    }
+#if GNRC_IPV6_NIB_CONF_HASHED
+    _nib_onl_entry_t **bucket = _bucket(&node->ipv6);
+
+    node->hnext = *bucket;
+    *bucket = node;
+#endif  /* GNRC_IPV6_NIB_CONF_HASHED */
+}
+
 _nib_onl_entry_t *_nib_onl_alloc(const ipv6_addr_t *addr, unsigned iface)
 {
     _nib_onl_entry_t *node = NULL;
@@ -82,6 +203,35 @@ _nib_onl_entry_t *_nib_onl_alloc(const ipv6_addr_t *addr, unsigned iface)
     DEBUG("nib: Allocating on-link node entry (addr = %s, iface = %u)\n",
           (addr == NULL) ? "NULL" : ipv6_addr_to_str(addr_str, addr,
                                                      sizeof(addr_str)), iface);
+#if GNRC_IPV6_NIB_CONF_HASHED
+    if (addr != NULL) {
+        _nib_onl_entry_t **bucket = _bucket(addr);
+        /* entries with an unspecified address (reserved by a prefix list
+         * entry) are hashed under the unspecified address */
+        _nib_onl_entry_t **unspec = _bucket(&ipv6_addr_unspecified);
+
+        node = _onl_alloc_match(*bucket, addr, iface, NULL);
+        if (unspec != bucket) {
+            node = _onl_alloc_match(*unspec, addr, iface, node);
+        }
+        if (node != NULL) {
+            DEBUG("  %p is an exact match\n", (void *)node);
+            _override_node(addr, iface, node);
+            return node;
+        }
+        /* no exact match, take the first free slot */
+        int idx = bf_get_unset(_nodes_used, GNRC_IPV6_NIB_NUMOF);
+
+        if (idx < 0) {
+            DEBUG("  NIB full\n");
+            return NULL;
+        }
+        node = &_nodes[idx];
+        DEBUG("  using %p\n", (void *)node);
+        _override_node(addr, iface, node);
+        return node;
+    }
+#endif  /* GNRC_IPV6_NIB_CONF_HASHED */
     for (unsigned i = 0; i < GNRC_IPV6_NIB_NUMOF; i++) {
         _nib_onl_entry_t *tmp = &_nodes[i];
 
@@ -114,9 +264,22 @@ static inline bool _is_gc(_nib_onl_entry_t *node)
             GNRC_IPV6_NIB_NC_INFO_AR_STATE_GC);
 }
 
-static inline _nib_onl_entry_t *_cache_out_onl_entry(const ipv6_addr_t *addr,
-                                                     unsigned iface,
-                                                     uint16_t cstate)
+/* second chance for entries that were looked up since the last round */
+static inline bool _spare(_nib_onl_entry_t *node)
+{
+#if GNRC_IPV6_NIB_CONF_HASHED
+    if (node->used) {
+        node->used = 0;
+        return true;
+    }
+#else   /* GNRC_IPV6_NIB_CONF_HASHED */
+    (void)node;
+#endif  /* GNRC_IPV6_NIB_CONF_HASHED */
+    return false;
+}
+
+static _nib_onl_entry_t *_cache_out_round(const ipv6_addr_t *addr,
+                                          unsigned iface, uint16_t cstate)
 {
     /* Use clist as FIFO for caching */
     _nib_onl_entry_t *first = (_nib_onl_entry_t *)clist_lpop(&_next_removable);
@@ -128,7 +291,7 @@ static inline _nib_onl_entry_t *_cache_out_onl_entry(const ipv6_addr_t *addr,
         return NULL;
     }
     do {
-        if (_is_gc(tmp)) {
+        if (_is_gc(tmp) && !_spare(tmp)) {
             DEBUG("nib: Removing neighbor cache entry (addr = %s, "
                   "iface = %u) ",
                   ipv6_addr_to_str(addr_str, &tmp->ipv6,
@@ -161,6 +324,22 @@ static inline _nib_onl_entry_t *_cache_out_onl_entry(const ipv6_addr_t *addr,
     return res;
 }
 
+static inline _nib_onl_entry_t *_cache_out_onl_entry(const ipv6_addr_t *addr,
+                                                     unsigned iface,
+                                                     uint16_t cstate)
+{
+    _nib_onl_entry_t *res = _cache_out_round(addr, iface, cstate);
+
+#if GNRC_IPV6_NIB_CONF_HASHED
+    if (res == NULL) {
+        /* all garbage-collectible entries might have been spared; their
+         * second chance is used up now */
+        res = _cache_out_round(addr, iface, cstate);
+    }
+#endif  /* GNRC_IPV6_NIB_CONF_HASHED */
+    return res;
+}
+
 _nib_onl_entry_t *_nib_nc_add(const ipv6_addr_t *addr, unsigned iface,
                               uint16_t cstate)
 {
@@ -176,6 +355,7 @@ _nib_onl_entry_t *_nib_nc_add(const ipv6_addr_t *addr, unsigned iface,
     DEBUG("nib: Adding to neighbor cache (addr = %s, iface = %u)\n",
           ipv6_addr_to_str(addr_str, addr, sizeof(addr_str)), iface);
     if (!(node->mode & _NC)) {
+        _nib_dcache_invalidate();
         node->info &= ~GNRC_IPV6_NIB_NC_INFO_NUD_STATE_MASK;
         /* masked above already */
         node->info |= cstate;
@@ -209,19 +389,32 @@ _nib_onl_entry_t *_nib_onl_get(const ipv6_addr_t *addr, unsigned iface)
     assert(addr != NULL);
     DEBUG("nib: Getting on-link node entry (addr = %s, iface = %u)\n",
           ipv6_addr_to_str(addr_str, addr, sizeof(addr_str)), iface);
+#if GNRC_IPV6_NIB_CONF_HASHED
+    _nib_onl_entry_t *res = NULL;
+
+    for (_nib_onl_entry_t *node = *_bucket(addr); node != NULL;
+         node = node->hnext) {
+        /* prefer the first entry in _nodes as the linear search does */
+        if (_onl_matches(addr, iface, node) &&
+            ((res == NULL) || (node < res))) {
+            res = node;
+        }
+    }
+    if (res != NULL) {
+        DEBUG("  Found %p\n", (void *)res);
+        res->used = 1;
+        return res;
+    }
+#else   /* GNRC_IPV6_NIB_CONF_HASHED */
     for (unsigned i = 0; i < GNRC_IPV6_NIB_NUMOF; i++) {
         _nib_onl_entry_t *node = &_nodes[i];
 
-        if ((node->mode != _EMPTY) &&
-            /* either requested or current interface undefined or
-             * interfaces equal */
-            ((_nib_onl_get_if(node) == 0) || (iface == 0) ||
-             (_nib_onl_get_if(node) == iface)) &&
-            ipv6_addr_equal(&node->ipv6, addr)) {
+        if (_onl_matches(addr, iface, node)) {
             DEBUG("  Found %p\n", (void *)node);
             return node;
         }
     }
+#endif  /* GNRC_IPV6_NIB_CONF_HASHED */
     DEBUG("  No suitable entry found\n");
     return NULL;
 }
@@ -231,6 +424,9 @@ void _nib_nc_set_reachable(_nib_onl_entry_t *node)
 #if GNRC_IPV6_NIB_CONF_ARSM
     gnrc_netif_t *netif = gnrc_netif_get_by_pid(_nib_onl_get_if(node));
 
+    if (_node_unreachable(node)) {
+        _nib_dcache_invalidate();
+    }
     node->info &= ~GNRC_IPV6_NIB_NC_INFO_NUD_STATE_MASK;
     node->info |= GNRC_IPV6_NIB_NC_INFO_NUD_STATE_REACHABLE;
 #ifdef TEST_SUITES
@@ -254,6 +450,7 @@ void _nib_nc_remove(_nib_onl_entry_t *node)
     DEBUG("nib: remove from neighbor cache (addr = %s, iface = %u)\n",
           ipv6_addr_to_str(addr_str, &node->ipv6, sizeof(addr_str)),
           _nib_onl_get_if(node));
+    _nib_dcache_invalidate();
     node->mode &= ~(_NC);
     evtimer_del((evtimer_t *)&_nib_evtimer, &node->snd_na.event);
 #if GNRC_IPV6_NIB_CONF_ARSM
@@ -343,6 +540,9 @@ _nib_dr_entry_t *_nib_drl_add(const ipv6_addr_t *router_addr, unsigned iface)
             (ipv6_addr_equal(router_addr, &tmp_node->ipv6))) {
             /* exact match */
             DEBUG("  %p is an exact match\n", (void *)tmp);
+            if (!(tmp_node->mode & _DRL)) {
+                _nib_dcache_invalidate();
+            }
             tmp_node->mode |= _DRL;
             return tmp;
         }
@@ -365,6 +565,7 @@ _nib_dr_entry_t *_nib_drl_add(const ipv6_addr_t *router_addr, unsigned iface)
 
 void _nib_drl_remove(_nib_dr_entry_t *nib_dr)
 {
+    _nib_dcache_invalidate();
     if (nib_dr->next_hop != NULL) {
         nib_dr->next_hop->mode &= ~(_DRL);
         _nib_onl_clear(nib_dr->next_hop);
@@ -455,6 +656,270 @@ void _nib_drl_ft_get(const _nib_dr_entry_t *drl, gnrc_ipv6_nib_ft_t *fte)
     fte->iface = _nib_onl_get_if(drl->next_hop);
 }
 
+#if GNRC_IPV6_NIB_CONF_HASHED
+/**
+ * @brief   Returns bit @p i of @p addr, starting at the MSB
+ */
+static inline unsigned _pfx_bit(const ipv6_addr_t *addr, unsigned i)
+{
+    return (addr->u8[i >> 3] >> (7 - (i & 7))) & 1;
+}
+
+/**
+ * @brief   Returns an entry below @p node, all of them share the first
+ *          node->len bits of their prefix
+ */
+static _nib_offl_entry_t *_pfx_any_entry(_nib_pfx_node_t *node)
+{
+    /* glue nodes always have two children */
+    while (node->entry == NULL) {
+        node = node->child[0];
+    }
+    return node->entry;
+}
+
+/**
+ * @brief   Returns the link pointing to @p node
+ */
+static _nib_pfx_node_t **_pfx_link(_nib_pfx_node_t *node)
+{
+    _nib_pfx_node_t *parent = node->parent;
+
+    if (parent == NULL) {
+        return &_pfx_root;
+    }
+    return &parent->child[parent->child[1] == node];
+}
+
+/**
+ * @brief   Puts @p node in the place of @p old in the trie
+ */
+static void _pfx_replace(_nib_pfx_node_t *old, _nib_pfx_node_t *node)
+{
+    *_pfx_link(old) = node;
+    node->parent = old->parent;
+    node->len = old->len;
+    for (unsigned i = 0; i < 2; i++) {
+        node->child[i] = old->child[i];
+        if (node->child[i] != NULL) {
+            node->child[i]->parent = node;
+        }
+    }
+}
+
+/**
+ * @brief   Takes a glue node from the free list
+ */
+static _nib_pfx_node_t *_pfx_glue_alloc(void)
+{
+    _nib_pfx_node_t *glue = _pfx_free;
+
+    assert(glue != NULL);
+    _pfx_free = glue->dup;
+    memset(glue, 0, sizeof(*glue));
+    return glue;
+}
+
+/**
+ * @brief   Returns a glue node to the free list
+ */
+static void _pfx_glue_free(_nib_pfx_node_t *glue)
+{
+    glue->dup = _pfx_free;
+    _pfx_free = glue;
+}
+
+/**
+ * @brief   Resets the trie with all off-link entries cleared
+ */
+static void _pfx_init(void)
+{
+    _pfx_root = NULL;
+    _pfx_free = NULL;
+    memset(_pfx_nodes, 0, sizeof(_pfx_nodes));
+    for (unsigned i = 0; i < GNRC_IPV6_NIB_OFFL_NUMOF; i++) {
+        _pfx_glue_free(&_pfx_glue[i]);
+    }
+}
+
+/**
+ * @brief   Adds an off-link entry with its prefix set to the trie
+ */
+static void _pfx_insert(_nib_offl_entry_t *dst)
+{
+    _nib_pfx_node_t *node = &_pfx_nodes[dst - _dsts];
+    _nib_pfx_node_t **link = &_pfx_root;
+    _nib_pfx_node_t *parent = NULL;
+
+    memset(node, 0, sizeof(*node));
+    node->entry = dst;
+    node->len = dst->pfx_len;
+    while (*link != NULL) {
+        _nib_pfx_node_t *cur = *link;
+        const ipv6_addr_t *other = &_pfx_any_entry(cur)->pfx;
+        unsigned len = (node->len < cur->len) ? node->len : cur->len;
+        unsigned diff = ipv6_addr_match_prefix(&dst->pfx, other);
+
+        if (diff < len) {
+            /* the prefixes part before either ends: branch with a glue node */
+            _nib_pfx_node_t *glue = _pfx_glue_alloc();
+            unsigned bit = _pfx_bit(&dst->pfx, diff);
+
+            glue->len = diff;
+            glue->parent = parent;
+            glue->child[bit] = node;
+            glue->child[!bit] = cur;
+            cur->parent = glue;
+            node->parent = glue;
+            *link = glue;
+            return;
+        }
+        if (node->len == cur->len) {
+            if (cur->entry == NULL) {
+                /* the entry sits exactly at a branch */
+                _pfx_replace(cur, node);
+                _pfx_glue_free(cur);
+            }
+            else {
+                /* same prefix, e.g. a route via another next hop */
+                node->parent = cur;
+                node->dup = cur->dup;
+                cur->dup = node;
+            }
+            return;
+        }
+        if (node->len < cur->len) {
+            /* the entry covers the subtrie */
+            node->parent = parent;
+            node->child[_pfx_bit(other, node->len)] = cur;
+            cur->parent = node;
+            *link = node;
+            return;
+        }
+        parent = cur;
+        link = &cur->child[_pfx_bit(&dst->pfx, cur->len)];
+    }
+    node->parent = parent;
+    *link = node;
+}
+
+/**
+ * @brief   Removes an off-link entry from the trie
+ */
+static void _pfx_remove(_nib_offl_entry_t *dst)
+{
+    _nib_pfx_node_t *node = &_pfx_nodes[dst - _dsts];
+    _nib_pfx_node_t **link;
+    _nib_pfx_node_t *parent;
+
+    if (node->entry == NULL) {
+        /* not in the trie */
+        return;
+    }
+    node->entry = NULL;
+    link = _pfx_link(node);
+    if (*link != node) {
+        /* only in the list of entries with the same prefix */
+        _nib_pfx_node_t *prev = node->parent;
+
+        while (prev->dup != node) {
+            prev = prev->dup;
+        }
+        prev->dup = node->dup;
+        return;
+    }
+    if (node->dup != NULL) {
+        /* the next entry with the same prefix takes the place of the node */
+        _nib_pfx_node_t *next = node->dup;
+
+        _pfx_replace(node, next);
+        for (_nib_pfx_node_t *dup = next->dup; dup != NULL; dup = dup->dup) {
+            dup->parent = next;
+        }
+        return;
+    }
+    if ((node->child[0] != NULL) && (node->child[1] != NULL)) {
+        /* the branch remains */
+        _pfx_replace(node, _pfx_glue_alloc());
+        return;
+    }
+    parent = node->parent;
+    *link = (node->child[0] != NULL) ? node->child[0] : node->child[1];
+    if (*link != NULL) {
+        (*link)->parent = parent;
+    }
+    else if ((parent != NULL) && (parent->entry == NULL)) {
+        /* the glue node above is left with a single child */
+        _nib_pfx_node_t *child = (parent->child[0] != NULL) ? parent->child[0]
+                                                            : parent->child[1];
+
+        *_pfx_link(parent) = child;
+        child->parent = parent->parent;
+        _pfx_glue_free(parent);
+    }
+}
+
+/**
+ * @brief   Looks up the entries whose prefix covers @p dst
+ *
+ * Of the entries with the same prefix, the first in _dsts is chosen, as the
+ * linear search did.
+ *
+ * @param[in] dst       The destination.
+ * @param[in] mode      Only entries with any of these mode flags are chosen.
+ * @param[in] flags     Only entries with all of these flags are chosen.
+ * @param[in] longest   Choose the entry with the longest prefix. Otherwise
+ *                      the first in _dsts is chosen.
+ *
+ * @return  The chosen entry, NULL if there is none.
+ */
+static _nib_offl_entry_t *_pfx_lookup(const ipv6_addr_t *dst, uint8_t mode,
+                                      uint16_t flags, bool longest)
+{
+    _nib_offl_entry_t *res = NULL;
+
+    for (_nib_pfx_node_t *node = _pfx_root; node != NULL;
+         node = node->child[_pfx_bit(dst, node->len)]) {
+        if (node->entry != NULL) {
+            _nib_offl_entry_t *best = NULL;
+
+            if (ipv6_addr_match_prefix(&node->entry->pfx, dst) < node->len) {
+                /* the whole subtrie shares the mismatching bits */
+                break;
+            }
+            for (_nib_pfx_node_t *dup = node; dup != NULL; dup = dup->dup) {
+                _nib_offl_entry_t *entry = dup->entry;
+
+                if ((entry->mode & mode) && ((entry->flags & flags) == flags) &&
+                    ((best == NULL) || (entry < best))) {
+                    best = entry;
+                }
+            }
+            if ((best != NULL) && (longest || (res == NULL) || (best < res))) {
+                res = best;
+            }
+        }
+        if (node->len == IPV6_ADDR_BIT_LEN) {
+            break;
+        }
+    }
+    return res;
+}
+#endif  /* GNRC_IPV6_NIB_CONF_HASHED */
+
+static _nib_offl_entry_t *_offl_exact_match(_nib_offl_entry_t *dst,
+                                            const ipv6_addr_t *next_hop)
+{
+    /* exact match (or next hop address was previously unset) */
+    DEBUG("  %p is an exact match\n", (void *)dst);
+    if ((next_hop != NULL) && ipv6_addr_is_unspecified(&dst->next_hop->ipv6)) {
+        _nib_dcache_invalidate();
+        _onl_set_ipv6(dst->next_hop, next_hop);
+    }
+    dst->next_hop->mode |= _DST;
+    return dst;
+}
+
 _nib_offl_entry_t *_nib_offl_alloc(const ipv6_addr_t *next_hop, unsigned iface,
                                    const ipv6_addr_t *pfx, unsigned pfx_len)
 {
@@ -469,6 +934,33 @@ _nib_offl_entry_t *_nib_offl_alloc(const ipv6_addr_t *next_hop, unsigned iface,
           iface);
     DEBUG("pfx = %s/%u)\n", ipv6_addr_to_str(addr_str, pfx,
                                              sizeof(addr_str)), pfx_len);
+#if GNRC_IPV6_NIB_CONF_HASHED
+    _nib_pfx_node_t *pnode = _pfx_root;
+    int idx;
+
+    while ((pnode != NULL) && (pnode->len < pfx_len)) {
+        pnode = pnode->child[_pfx_bit(pfx, pnode->len)];
+    }
+    if ((pnode != NULL) && (pnode->len == pfx_len) && (pnode->entry != NULL) &&
+        (ipv6_addr_match_prefix(&pnode->entry->pfx, pfx) >= pfx_len)) {
+        /* the linear search returned the first entry in _dsts, so do we */
+        for (; pnode != NULL; pnode = pnode->dup) {
+            _nib_offl_entry_t *tmp = pnode->entry;
+
+            if ((_nib_onl_get_if(tmp->next_hop) == iface) &&
+                _addr_equals(next_hop, tmp->next_hop) &&
+                ((dst == NULL) || (tmp < dst))) {
+                dst = tmp;
+            }
+        }
+        if (dst != NULL) {
+            return _offl_exact_match(dst, next_hop);
+        }
+    }
+    if ((idx = bf_get_unset(_dsts_used, GNRC_IPV6_NIB_OFFL_NUMOF)) >= 0) {
+        dst = &_dsts[idx];
+    }
+#else   /* GNRC_IPV6_NIB_CONF_HASHED */
     for (unsigned i = 0; i < GNRC_IPV6_NIB_OFFL_NUMOF; i++) {
         _nib_offl_entry_t *tmp = &_dsts[i];
         _nib_onl_entry_t *tmp_node = tmp->next_hop;
@@ -478,30 +970,32 @@ _nib_offl_entry_t *_nib_offl_alloc(const ipv6_addr_t *next_hop, unsigned iface,
             (_nib_onl_get_if(tmp_node) == iface) &&     /* has a matching interface and */
             _addr_equals(next_hop, tmp_node) &&         /* equal address to next_hop, also */
             (ipv6_addr_match_prefix(&tmp->pfx, pfx) >= pfx_len)) {  /* the prefix matches */
-            /* exact match (or next hop address was previously unset) */
-            DEBUG("  %p is an exact match\n", (void *)tmp);
-            if (next_hop != NULL) {
-                memcpy(&tmp_node->ipv6, next_hop, sizeof(tmp_node->ipv6));
-            }
-            tmp->next_hop->mode |= _DST;
-            return tmp;
+            return _offl_exact_match(tmp, next_hop);
         }
         if ((dst == NULL) && (tmp_node == NULL)) {
             dst = tmp;
         }
     }
+#endif  /* GNRC_IPV6_NIB_CONF_HASHED */
     if (dst != NULL) {
         DEBUG("  using %p\n", (void *)dst);
+        _nib_dcache_invalidate();
         dst->next_hop = _nib_onl_alloc(next_hop, iface);
 
         if (dst->next_hop == NULL) {
             memset(dst, 0, sizeof(_nib_offl_entry_t));
+#if GNRC_IPV6_NIB_CONF_HASHED
+            bf_unset(_dsts_used, dst - _dsts);
+#endif  /* GNRC_IPV6_NIB_CONF_HASHED */
             return NULL;
         }
         _override_node(next_hop, iface, dst->next_hop);
         dst->next_hop->mode |= _DST;
         ipv6_addr_init_prefix(&dst->pfx, pfx, pfx_len);
         dst->pfx_len = pfx_len;
+#if GNRC_IPV6_NIB_CONF_HASHED
+        _pfx_insert(dst);
+#endif  /* GNRC_IPV6_NIB_CONF_HASHED */
     }
     return dst;
 }
@@ -521,6 +1015,7 @@ static inline bool _in_abrs(const _nib_abr_entry_t *abr)
 void _nib_offl_clear(_nib_offl_entry_t *dst)
 {
     if (dst->next_hop != NULL) {
+        _nib_dcache_invalidate();
         _nib_offl_entry_t *ptr;
         for (ptr = _dsts; _in_dsts(ptr); ptr++) {
             /* there is another dst pointing to next-hop => only remove dst */
@@ -533,6 +1028,10 @@ void _nib_offl_clear(_nib_offl_entry_t *dst)
             dst->next_hop->mode &= ~(_DST);
             _nib_onl_clear(dst->next_hop);
         }
+#if GNRC_IPV6_NIB_CONF_HASHED
+        _pfx_remove(dst);
+        bf_unset(_dsts_used, dst - _dsts);
+#endif  /* GNRC_IPV6_NIB_CONF_HASHED */
         memset(dst, 0, sizeof(_nib_offl_entry_t));
     }
 }
@@ -558,6 +1057,11 @@ bool _nib_offl_is_entry(const _nib_offl_entry_t *entry)
 
 static _nib_offl_entry_t *_nib_offl_get_match(const ipv6_addr_t *dst)
 {
+#if GNRC_IPV6_NIB_CONF_HASHED
+    DEBUG("nib: get match for destination %s from NIB\n",
+          ipv6_addr_to_str(addr_str, dst, sizeof(addr_str)));
+    return _pfx_lookup(dst, UINT8_MAX, 0, true);
+#else   /* GNRC_IPV6_NIB_CONF_HASHED */
     _nib_offl_entry_t *res = NULL;
     uint8_t best_match = 0;
 
@@ -583,6 +1087,25 @@ static _nib_offl_entry_t *_nib_offl_get_match(const ipv6_addr_t *dst)
         }
     }
     return res;
+#endif  /* GNRC_IPV6_NIB_CONF_HASHED */
+}
+
+_nib_offl_entry_t *_nib_pl_get_on_link(const ipv6_addr_t *dst)
+{
+    assert(dst != NULL);
+#if GNRC_IPV6_NIB_CONF_HASHED
+    return _pfx_lookup(dst, _PL, _PFX_ON_LINK, false);
+#else   /* GNRC_IPV6_NIB_CONF_HASHED */
+    _nib_offl_entry_t *entry = NULL;
+
+    while ((entry = _nib_offl_iter(entry))) {
+        if ((entry->mode & _PL) && (entry->flags & _PFX_ON_LINK) &&
+            (ipv6_addr_match_prefix(dst, &entry->pfx) >= entry->pfx_len)) {
+            return entry;
+        }
+    }
+    return NULL;
+#endif  /* GNRC_IPV6_NIB_CONF_HASHED */
 }
 
 void _nib_ft_get(const _nib_offl_entry_t *dst, gnrc_ipv6_nib_ft_t *fte)
@@ -808,10 +1331,15 @@ _nib_offl_entry_t *_nib_pl_add(unsigned iface,
 static void _override_node(const ipv6_addr_t *addr, unsigned iface,
                            _nib_onl_entry_t *node)
 {
-    _nib_onl_clear(node);
-    if (addr != NULL) {
-        memcpy(&node->ipv6, addr, sizeof(node->ipv6));
+    if (node->mode == _EMPTY) {
+        /* new entry */
+        _nib_dcache_invalidate();
     }
+    _nib_onl_clear(node);
+#if GNRC_IPV6_NIB_CONF_HASHED
+    bf_set(_nodes_used, node - _nodes);
+#endif  /* GNRC_IPV6_NIB_CONF_HASHED */
+    _onl_set_ipv6(node, addr);
     _nib_onl_set_if(node, iface);
 }
 
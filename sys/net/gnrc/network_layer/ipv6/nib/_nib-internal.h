@@ -91,6 +91,14 @@ extern "C" {
  */
 typedef struct _nib_onl_entry {
     struct _nib_onl_entry *next;        /**< next removable entry */
+#if GNRC_IPV6_NIB_CONF_HASHED || defined(DOXYGEN)
+    /**
+     * @brief   next entry in the same hash bucket
+     *
+     * @note    Only available if @ref GNRC_IPV6_NIB_CONF_HASHED != 0.
+     */
+    struct _nib_onl_entry *hnext;
+#endif
 #if GNRC_IPV6_NIB_CONF_QUEUE_PKT || defined(DOXYGEN)
     /**
      * @brief   queue for packets currently in address resolution
@@ -178,6 +186,14 @@ typedef struct _nib_onl_entry {
      */
     uint8_t l2addr_len;
 #endif
+#if GNRC_IPV6_NIB_CONF_HASHED || defined(DOXYGEN)
+    /**
+     * @brief   entry was looked up since the last cache-out round
+     *
+     * @note    Only available if @ref GNRC_IPV6_NIB_CONF_HASHED != 0.
+     */
+    uint8_t used;
+#endif
 } _nib_onl_entry_t;
 
 /**
@@ -241,6 +257,40 @@ typedef struct {
     BITFIELD(ctxs, GNRC_SIXLOWPAN_CTX_SIZE);
 } _nib_abr_entry_t;
 
+/**
+ * @brief   Destination cache entry
+ *
+ * @see @ref net_gnrc_ipv6_nib_dcache
+ */
+typedef struct {
+    ipv6_addr_t dst;        /**< destination address */
+    ipv6_addr_t next_hop;   /**< next hop to _nib_dcache_entry_t::dst */
+    /**
+     * @brief   Source address for _nib_dcache_entry_t::dst
+     *
+     * Unspecified, if not stored yet.
+     */
+    ipv6_addr_t src;
+    uint16_t gen;           /**< NIB generation the entry is valid for */
+    /**
+     * @brief   Interface requested by the caller of
+     *          @ref gnrc_ipv6_nib_get_next_hop_l2addr() (0 for any)
+     */
+    uint8_t req_iface;
+    uint8_t iface;          /**< interface to _nib_dcache_entry_t::next_hop */
+    /**
+     * @brief   Length of the prefix of the route to _nib_dcache_entry_t::dst
+     *
+     * @ref _NIB_DCACHE_ON_LINK, if _nib_dcache_entry_t::dst is on-link.
+     */
+    uint8_t route_len;
+} _nib_dcache_entry_t;
+
+/**
+ * @brief   _nib_dcache_entry_t::route_len for on-link destinations
+ */
+#define _NIB_DCACHE_ON_LINK (UINT8_MAX)
+
 /**
  * @brief   Mutex for locking the NIB
  */
@@ -266,6 +316,65 @@ extern _nib_dr_entry_t *_prime_def_router;
  */
 void _nib_init(void);
 
+#if GNRC_IPV6_NIB_CONF_DCACHE || defined(DOXYGEN)
+/**
+ * @brief   Invalidates all destination cache entries
+ *
+ * Needs to be called on every change of the NIB that might influence the
+ * result of @ref gnrc_ipv6_nib_get_next_hop_l2addr() or source address
+ * selection.
+ *
+ * @note    Only available if @ref GNRC_IPV6_NIB_CONF_DCACHE != 0.
+ */
+void _nib_dcache_invalidate(void);
+
+/**
+ * @brief   Gets a valid destination cache entry
+ *
+ * @param[in] dst       A destination address.
+ * @param[in] req_iface The interface requested for @p dst (0 for any).
+ *
+ * @note    Only available if @ref GNRC_IPV6_NIB_CONF_DCACHE != 0.
+ *
+ * @return  The entry for @p dst, @p req_iface. Counts as a hit.
+ * @return  NULL, if there is none. Counts as a miss.
+ */
+_nib_dcache_entry_t *_nib_dcache_get(const ipv6_addr_t *dst,
+                                     unsigned req_iface);
+
+/**
+ * @brief   Adds an entry to the destination cache
+ *
+ * Replaces whatever entry shares its slot with @p dst.
+ *
+ * @param[in] dst       A destination address.
+ * @param[in] req_iface The interface requested for @p dst (0 for any).
+ * @param[in] iface     The interface to @p next_hop.
+ * @param[in] next_hop  The next hop to @p dst.
+ * @param[in] route_len Prefix length of the route to @p dst or
+ *                      @ref _NIB_DCACHE_ON_LINK.
+ *
+ * @note    Only available if @ref GNRC_IPV6_NIB_CONF_DCACHE != 0.
+ */
+void _nib_dcache_add(const ipv6_addr_t *dst, unsigned req_iface,
+                     unsigned iface, const ipv6_addr_t *next_hop,
+                     uint8_t route_len);
+
+/**
+ * @brief   Removes an entry from the destination cache
+ *
+ * @param[in,out] entry An entry.
+ *
+ * @note    Only available if @ref GNRC_IPV6_NIB_CONF_DCACHE != 0.
+ */
+static inline void _nib_dcache_remove(_nib_dcache_entry_t *entry)
+{
+    entry->gen = 0;
+}
+#else   /* GNRC_IPV6_NIB_CONF_DCACHE || defined(DOXYGEN) */
+#define _nib_dcache_invalidate()
+#endif  /* GNRC_IPV6_NIB_CONF_DCACHE || defined(DOXYGEN) */
+
 /**
  * @brief   Gets interface identifier from a NIB entry
  *
@@ -304,6 +413,20 @@ static inline void _nib_onl_set_if(_nib_onl_entry_t *node, unsigned iface)
  */
 _nib_onl_entry_t *_nib_onl_alloc(const ipv6_addr_t *addr, unsigned iface);
 
+#if GNRC_IPV6_NIB_CONF_HASHED || defined(DOXYGEN)
+/**
+ * @brief   Removes an on-link entry from the address hash index and marks
+ *          its slot as free
+ *
+ * Nothing happens to the index if @p node is not in it.
+ *
+ * @note    Only available if @ref GNRC_IPV6_NIB_CONF_HASHED != 0.
+ *
+ * @param[in] node  An entry.
+ */
+void _nib_onl_free(_nib_onl_entry_t *node);
+#endif
+
 /**
  * @brief   Clears out a NIB entry (on-link version)
  *
@@ -315,6 +438,9 @@ _nib_onl_entry_t *_nib_onl_alloc(const ipv6_addr_t *addr, unsigned iface);
 static inline bool _nib_onl_clear(_nib_onl_entry_t *node)
 {
     if (node->mode == _EMPTY) {
+#if GNRC_IPV6_NIB_CONF_HASHED
+        _nib_onl_free(node);
+#endif
         memset(node, 0, sizeof(_nib_onl_entry_t));
         return true;
     }
@@ -563,6 +689,9 @@ static inline _nib_offl_entry_t *_nib_offl_add(const ipv6_addr_t *next_hop,
     _nib_offl_entry_t *nib_offl = _nib_offl_alloc(next_hop, iface, pfx, pfx_len);
 
     if (nib_offl != NULL) {
+        if ((nib_offl->mode & mode) != mode) {
+            _nib_dcache_invalidate();
+        }
         nib_offl->mode |= mode;
     }
     return nib_offl;
@@ -655,6 +784,19 @@ _nib_offl_entry_t *_nib_pl_add(unsigned iface,
  */
 void _nib_pl_remove(_nib_offl_entry_t *nib_offl);
 
+/**
+ * @brief   Gets the first on-link prefix list entry that covers an address
+ *
+ * @pre     `(dst != NULL)`
+ *
+ * @param[in] dst   An IPv6 address. Must not be NULL.
+ *
+ * @return  The prefix list entry with the @ref _PFX_ON_LINK flag set whose
+ *          prefix covers @p dst.
+ * @return  NULL, if there is no such entry.
+ */
+_nib_offl_entry_t *_nib_pl_get_on_link(const ipv6_addr_t *dst);
+
 #if GNRC_IPV6_NIB_CONF_ROUTER || DOXYGEN
 /**
  * @brief   Creates or gets an existing forwarding table entry by its prefix
@@ -134,6 +134,16 @@ static gnrc_pktsnip_t *_build_ext_opts(gnrc_netif_t *netif,
     _nib_offl_entry_t *pfx = NULL;
     unsigned id = netif->pid;
 
+#ifdef MODULE_GNRC_SIXLOWPAN_GHC
+    if (netif->flags & GNRC_NETIF_FLAGS_6LO_GHC) {
+        ext_opts = gnrc_sixlowpan_nd_opt_6cio_build(SIXLOWPAN_ND_OPT_6CIO_FLAGS_G,
+                                                    ext_opts);
+        if (ext_opts == NULL) {
+            DEBUG("nib: No space left in packet buffer. Not adding 6CIO\n");
+            return NULL;
+        }
+    }
+#endif  /* MODULE_GNRC_SIXLOWPAN_GHC */
 #if GNRC_IPV6_NIB_CONF_DNS && SOCK_HAS_IPV6
     uint32_t rdnss_ltime = _evtimer_lookup(&sock_dns_server,
                                            GNRC_IPV6_NIB_RDNSS_TIMEOUT);
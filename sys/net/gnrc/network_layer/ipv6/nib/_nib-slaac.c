@@ -67,6 +67,7 @@ void _auto_configure_addr(gnrc_netif_t *netif, const ipv6_addr_t *pfx,
          *    locked here) */
         netif->ipv6.addrs_flags[idx] &= ~GNRC_NETIF_IPV6_ADDRS_FLAGS_STATE_MASK;
         netif->ipv6.addrs_flags[idx] |= GNRC_NETIF_IPV6_ADDRS_FLAGS_STATE_VALID;
+        _nib_dcache_invalidate();
     }
 #endif  /* GNRC_IPV6_NIB_CONF_6LN */
 #if GNRC_IPV6_NIB_CONF_6LN
@@ -128,6 +129,7 @@ static bool _try_addr_reconfiguration(gnrc_netif_t *netif)
                 ipv6_addr_t *addr = &netif->ipv6.addrs[i];
                 if (addr->u64[1].u64 == orig_iid.uint64.u64) {
                     gnrc_netif_ipv6_addr_remove_internal(netif, addr);
+                    _nib_dcache_invalidate();
                 }
             }
         }
@@ -143,6 +145,7 @@ void _remove_tentative_addr(gnrc_netif_t *netif, const ipv6_addr_t *addr)
           "=> removing that address\n",
           ipv6_addr_to_str(addr_str, addr, sizeof(addr_str)));
     gnrc_netif_ipv6_addr_remove_internal(netif, addr);
+    _nib_dcache_invalidate();
 
     if (!ipv6_addr_is_link_local(addr) ||
         !_try_addr_reconfiguration(netif)) {
@@ -200,6 +203,7 @@ void _handle_valid_addr(const ipv6_addr_t *addr)
     if (idx >= 0) {
         netif->ipv6.addrs_flags[idx] &= ~GNRC_NETIF_IPV6_ADDRS_FLAGS_STATE_MASK;
         netif->ipv6.addrs_flags[idx] |= GNRC_NETIF_IPV6_ADDRS_FLAGS_STATE_VALID;
+        _nib_dcache_invalidate();
     }
     if (netif != NULL) {
         /* was acquired in `_get_netif_state()` */
@@ -27,6 +27,9 @@
 #include "net/gnrc/sixlowpan/nd.h"
 #include "net/ndp.h"
 #include "net/sixlowpan/nd.h"
+#ifdef MODULE_GNRC_SIXLOWPAN_GHC
+#include "net/gnrc/sixlowpan/ghc.h"
+#endif
 #if GNRC_IPV6_NIB_CONF_DNS
 #include "net/sock/dns.h"
 #endif
@@ -151,7 +154,7 @@ void gnrc_ipv6_nib_init_iface(gnrc_netif_t *netif)
 
 static bool _on_link(const ipv6_addr_t *dst, unsigned *iface)
 {
-    _nib_offl_entry_t *entry = NULL;
+    _nib_offl_entry_t *entry;
 
 #if GNRC_IPV6_NIB_CONF_6LN
     if (*iface != 0) {
@@ -160,21 +163,67 @@ static bool _on_link(const ipv6_addr_t *dst, unsigned *iface)
         }
     }
 #endif  /* GNRC_IPV6_NIB_CONF_6LN */
-    while ((entry = _nib_offl_iter(entry))) {
-        if ((entry->mode & _PL) && (entry->flags & _PFX_ON_LINK) &&
-            (ipv6_addr_match_prefix(dst, &entry->pfx) >= entry->pfx_len)) {
-            *iface = _nib_onl_get_if(entry->next_hop);
-            return true;
-        }
+    if ((entry = _nib_pl_get_on_link(dst)) != NULL) {
+        *iface = _nib_onl_get_if(entry->next_hop);
+        return true;
     }
     return ipv6_addr_is_link_local(dst);
 }
 
+#if GNRC_IPV6_NIB_CONF_DCACHE
+static bool _resolve_cached(_nib_dcache_entry_t *entry, gnrc_netif_t **netif,
+                            gnrc_pktsnip_t *pkt, gnrc_ipv6_nib_nc_t *nce,
+                            int *res)
+{
+    gnrc_netif_t *cached_netif = gnrc_netif_get_by_pid(entry->iface);
+
+    if (cached_netif == NULL) {
+        /* interface is gone, determine next hop again */
+        _nib_dcache_remove(entry);
+        return false;
+    }
+    DEBUG("nib: %s is in destination cache, ",
+          ipv6_addr_to_str(addr_str, &entry->dst, sizeof(addr_str)));
+    DEBUG("next hop is %s%%%u\n",
+          ipv6_addr_to_str(addr_str, &entry->next_hop, sizeof(addr_str)),
+          entry->iface);
+    if (*netif != cached_netif) {
+        gnrc_netif_release(*netif);
+        *netif = cached_netif;
+        gnrc_netif_acquire(*netif);
+    }
+    if (_resolve_addr(&entry->next_hop, *netif, pkt, nce,
+                      _nib_onl_get(&entry->next_hop, entry->iface))) {
+        if (entry->route_len != _NIB_DCACHE_ON_LINK) {
+            ipv6_addr_t route = IPV6_ADDR_UNSPECIFIED;
+
+            ipv6_addr_init_prefix(&route, &entry->dst, entry->route_len);
+            _call_route_info_cb(*netif, GNRC_IPV6_NIB_ROUTE_INFO_TYPE_RN,
+                                &route,
+                                (void *)((intptr_t)entry->route_len));
+        }
+        *res = 0;
+    }
+    else {
+        /* _resolve_addr releases pkt if not queued (in which case
+         * we also shouldn't release). Give other next hops a chance with
+         * the next packet. */
+        _nib_dcache_remove(entry);
+        *res = -EHOSTUNREACH;
+    }
+    return true;
+}
+#endif  /* GNRC_IPV6_NIB_CONF_DCACHE */
+
 int gnrc_ipv6_nib_get_next_hop_l2addr(const ipv6_addr_t *dst,
                                       gnrc_netif_t *netif, gnrc_pktsnip_t *pkt,
                                       gnrc_ipv6_nib_nc_t *nce)
 {
     int res = 0;
+#if GNRC_IPV6_NIB_CONF_DCACHE
+    unsigned req_iface = (netif == NULL) ? 0 : netif->pid;
+    _nib_dcache_entry_t *dce;
+#endif  /* GNRC_IPV6_NIB_CONF_DCACHE */
 
     DEBUG("nib: get next hop link-layer address of %s%%%u\n",
           ipv6_addr_to_str(addr_str, dst, sizeof(addr_str)),
@@ -182,6 +231,12 @@ int gnrc_ipv6_nib_get_next_hop_l2addr(const ipv6_addr_t *dst,
     gnrc_netif_acquire(netif);
     mutex_lock(&_nib_mutex);
     do {    /* XXX: hidden goto ;-) */
+#if GNRC_IPV6_NIB_CONF_DCACHE
+        if (((dce = _nib_dcache_get(dst, req_iface)) != NULL) &&
+            _resolve_cached(dce, &netif, pkt, nce, &res)) {
+            break;
+        }
+#endif  /* GNRC_IPV6_NIB_CONF_DCACHE */
         _nib_onl_entry_t *node = _nib_onl_get(dst,
                                               (netif == NULL) ? 0 : netif->pid);
         /* consider neighbor cache entries first */
@@ -211,6 +266,10 @@ int gnrc_ipv6_nib_get_next_hop_l2addr(const ipv6_addr_t *dst,
                 res = -EHOSTUNREACH;
                 break;
             }
+#if GNRC_IPV6_NIB_CONF_DCACHE
+            _nib_dcache_add(dst, req_iface, netif->pid, dst,
+                            _NIB_DCACHE_ON_LINK);
+#endif  /* GNRC_IPV6_NIB_CONF_DCACHE */
         }
         else {
             gnrc_ipv6_nib_ft_t route;
@@ -258,6 +317,10 @@ int gnrc_ipv6_nib_get_next_hop_l2addr(const ipv6_addr_t *dst,
 #if GNRC_IPV6_NIB_CONF_DC
                 _nib_dc_add(&route.next_hop, netif->pid, dst);
 #endif  /* GNRC_IPV6_NIB_CONF_DC */
+#if GNRC_IPV6_NIB_CONF_DCACHE
+                _nib_dcache_add(dst, req_iface, netif->pid, &route.next_hop,
+                                route.dst_len);
+#endif  /* GNRC_IPV6_NIB_CONF_DCACHE */
             }
             else {
                 /* _resolve_addr releases pkt if not queued (in which case
@@ -415,6 +478,10 @@ static void _handle_mtuo(gnrc_netif_t *netif, const icmpv6_hdr_t *icmpv6,
 static uint32_t _handle_rdnsso(gnrc_netif_t *netif, const icmpv6_hdr_t *icmpv6,
                                const ndp_opt_rdnss_t *rdnsso);
 #endif
+#ifdef MODULE_GNRC_SIXLOWPAN_GHC
+static void _handle_6cio(gnrc_netif_t *netif, const ndp_opt_t *l2ao,
+                         const sixlowpan_nd_opt_6cio_t *cio);
+#endif
 #if GNRC_IPV6_NIB_CONF_MULTIHOP_P6C
 static uint32_t _handle_pio(gnrc_netif_t *netif, const icmpv6_hdr_t *icmpv6,
                             const ndp_opt_pi_t *pio,
@@ -439,6 +506,10 @@ static void _handle_rtr_sol(gnrc_netif_t *netif, const ipv6_hdr_t *ipv6,
     size_t tmp_len = icmpv6_len - sizeof(ndp_rtr_sol_t);
     _nib_onl_entry_t *nce = NULL;
     ndp_opt_t *opt;
+#ifdef MODULE_GNRC_SIXLOWPAN_GHC
+    const ndp_opt_t *sl2ao = NULL;
+    const sixlowpan_nd_opt_6cio_t *cio = NULL;
+#endif
     uint32_t next_ra_delay = random_uint32_range(0, NDP_MAX_RA_DELAY);
 
     assert(netif != NULL);
@@ -489,12 +560,23 @@ static void _handle_rtr_sol(gnrc_netif_t *netif, const ipv6_hdr_t *ipv6,
                         _handle_sl2ao(netif, ipv6, (const icmpv6_hdr_t *)rtr_sol,
                                       opt);
                     }
+#ifdef MODULE_GNRC_SIXLOWPAN_GHC
+                    sl2ao = opt;
+#endif
 
                     break;
+#ifdef MODULE_GNRC_SIXLOWPAN_GHC
+                case NDP_OPT_6CIO:
+                    cio = (sixlowpan_nd_opt_6cio_t *)opt;
+                    break;
+#endif
                 default:
                     break;
             }
         }
+#ifdef MODULE_GNRC_SIXLOWPAN_GHC
+        _handle_6cio(netif, sl2ao, cio);
+#endif
         nce = _nib_onl_get(&ipv6->src, netif->pid);
     }
     if (!gnrc_netif_is_6ln(netif)) {
@@ -543,6 +625,10 @@ static void _handle_rtr_adv(gnrc_netif_t *netif, const ipv6_hdr_t *ipv6,
     size_t tmp_len = icmpv6_len - sizeof(ndp_rtr_adv_t);
     _nib_dr_entry_t *dr = NULL;
     ndp_opt_t *opt;
+#ifdef MODULE_GNRC_SIXLOWPAN_GHC
+    const ndp_opt_t *sl2ao = NULL;
+    const sixlowpan_nd_opt_6cio_t *cio = NULL;
+#endif
 
 #if GNRC_IPV6_NIB_CONF_MULTIHOP_P6C
     sixlowpan_nd_opt_abr_t *abro = NULL;
@@ -691,6 +777,9 @@ static void _handle_rtr_adv(gnrc_netif_t *netif, const ipv6_hdr_t *ipv6,
             case NDP_OPT_SL2A:
                 _handle_sl2ao(netif, ipv6, (const icmpv6_hdr_t *)rtr_adv,
                               opt);
+#ifdef MODULE_GNRC_SIXLOWPAN_GHC
+                sl2ao = opt;
+#endif
 
                 break;
             case NDP_OPT_MTU:
@@ -732,11 +821,19 @@ static void _handle_rtr_adv(gnrc_netif_t *netif, const ipv6_hdr_t *ipv6,
                                                    (ndp_opt_rdnss_t *)opt),
                                     next_timeout);
                 break;
+#endif
+#ifdef MODULE_GNRC_SIXLOWPAN_GHC
+            case NDP_OPT_6CIO:
+                cio = (sixlowpan_nd_opt_6cio_t *)opt;
+                break;
 #endif
             default:
                 break;
         }
     }
+#ifdef MODULE_GNRC_SIXLOWPAN_GHC
+    _handle_6cio(netif, sl2ao, cio);
+#endif
     /* stop sending router solicitations
      * see https://tools.ietf.org/html/rfc4861#section-6.3.7 */
     evtimer_del(&_nib_evtimer, &netif->ipv6.search_rtr.event);
@@ -1268,6 +1365,7 @@ static void _handle_pfx_timeout(_nib_offl_entry_t *pfx)
                 netif->ipv6.addrs_flags[i] |= GNRC_NETIF_IPV6_ADDRS_FLAGS_STATE_DEPRECATED;
             }
         }
+        _nib_dcache_invalidate();
         _evtimer_add(pfx, GNRC_IPV6_NIB_PFX_TIMEOUT, &pfx->pfx_timeout,
                      pfx->valid_until - now);
     }
@@ -1347,6 +1445,28 @@ static void _handle_mtuo(gnrc_netif_t *netif, const icmpv6_hdr_t *icmpv6,
     }
 }
 
+#ifdef MODULE_GNRC_SIXLOWPAN_GHC
+static void _handle_6cio(gnrc_netif_t *netif, const ndp_opt_t *l2ao,
+                         const sixlowpan_nd_opt_6cio_t *cio)
+{
+    int l2addr_len;
+
+    /* without SLLAO we can't tell which neighbor the 6CIO belongs to */
+    if ((l2ao == NULL) ||
+        ((l2addr_len = gnrc_netif_ndp_addr_len_from_l2ao(netif, l2ao)) < 0)) {
+        return;
+    }
+    if ((cio != NULL) && (cio->len != SIXLOWPAN_ND_OPT_6CIO_LEN)) {
+        cio = NULL;
+    }
+    /* a missing 6CIO revokes a previously indicated capability */
+    gnrc_sixlowpan_ghc_peer_set(netif, (const uint8_t *)(l2ao + 1),
+                                l2addr_len,
+                                (cio != NULL) &&
+                                sixlowpan_nd_opt_6cio_is_ghc(cio));
+}
+#endif
+
 #if GNRC_IPV6_NIB_CONF_DNS
 static uint32_t _handle_rdnsso(gnrc_netif_t *netif, const icmpv6_hdr_t *icmpv6,
                                const ndp_opt_rdnss_t *rdnsso)
@@ -1493,7 +1613,9 @@ static uint32_t _handle_pio(gnrc_netif_t *netif, const icmpv6_hdr_t *icmpv6,
                 _nib_abr_add_pfx(abr, pfx);
             }
 #endif  /* GNRC_IPV6_NIB_CONF_MULTIHOP_P6C */
-            if (pio->flags & NDP_OPT_PI_FLAGS_L) {
+            if ((pio->flags & NDP_OPT_PI_FLAGS_L) &&
+                !(pfx->flags & _PFX_ON_LINK)) {
+                _nib_dcache_invalidate();
                 pfx->flags |= _PFX_ON_LINK;
             }
             if (pio->flags & NDP_OPT_PI_FLAGS_A) {
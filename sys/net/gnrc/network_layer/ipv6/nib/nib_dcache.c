@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @author  Martine Lenders <m.lenders@fu-berlin.de>
+ */
+
+#include <string.h>
+
+#include "net/gnrc/ipv6/nib/dcache.h"
+
+#include "_nib-internal.h"
+
+#if GNRC_IPV6_NIB_CONF_DCACHE
+#if (GNRC_IPV6_NIB_DCACHE_NUMOF & (GNRC_IPV6_NIB_DCACHE_NUMOF - 1)) != 0
+#error "GNRC_IPV6_NIB_DCACHE_NUMOF must be a power of two"
+#endif
+
+static _nib_dcache_entry_t _dcache[GNRC_IPV6_NIB_DCACHE_NUMOF];
+/* entries with a different generation are invalid, 0 is never valid */
+static uint16_t _gen = 1;
+static gnrc_ipv6_nib_dcache_stats_t _stats;
+
+static inline _nib_dcache_entry_t *_slot(const ipv6_addr_t *dst)
+{
+    uint32_t hash = dst->u32[0].u32 ^ dst->u32[1].u32 ^
+                    dst->u32[2].u32 ^ dst->u32[3].u32;
+
+    hash ^= hash >> 16;
+    hash ^= hash >> 8;
+    return &_dcache[hash & (GNRC_IPV6_NIB_DCACHE_NUMOF - 1)];
+}
+
+static inline bool _valid(const _nib_dcache_entry_t *entry,
+                          const ipv6_addr_t *dst)
+{
+    return (entry->gen == _gen) && ipv6_addr_equal(&entry->dst, dst);
+}
+
+void _nib_dcache_invalidate(void)
+{
+    if (++_gen == 0) {
+        /* generation wrapped around, so wipe entries of old generations */
+        memset(_dcache, 0, sizeof(_dcache));
+        _gen = 1;
+    }
+}
+
+_nib_dcache_entry_t *_nib_dcache_get(const ipv6_addr_t *dst,
+                                     unsigned req_iface)
+{
+    _nib_dcache_entry_t *entry = _slot(dst);
+
+    if (_valid(entry, dst) && (entry->req_iface == req_iface)) {
+        _stats.hits++;
+        return entry;
+    }
+    _stats.misses++;
+    return NULL;
+}
+
+void _nib_dcache_add(const ipv6_addr_t *dst, unsigned req_iface,
+                     unsigned iface, const ipv6_addr_t *next_hop,
+                     uint8_t route_len)
+{
+    _nib_dcache_entry_t *entry = _slot(dst);
+
+    memcpy(&entry->dst, dst, sizeof(entry->dst));
+    memcpy(&entry->next_hop, next_hop, sizeof(entry->next_hop));
+    ipv6_addr_set_unspecified(&entry->src);
+    entry->gen = _gen;
+    entry->req_iface = req_iface;
+    entry->iface = iface;
+    entry->route_len = route_len;
+}
+
+bool gnrc_ipv6_nib_dcache_get_src(const ipv6_addr_t *dst, unsigned iface,
+                                  ipv6_addr_t *src)
+{
+    bool res = false;
+    _nib_dcache_entry_t *entry = _slot(dst);
+
+    assert((dst != NULL) && (src != NULL));
+    mutex_lock(&_nib_mutex);
+    if (_valid(entry, dst) && (entry->iface == iface) &&
+        !ipv6_addr_is_unspecified(&entry->src)) {
+        memcpy(src, &entry->src, sizeof(entry->src));
+        res = true;
+    }
+    mutex_unlock(&_nib_mutex);
+    return res;
+}
+
+void gnrc_ipv6_nib_dcache_set_src(const ipv6_addr_t *dst, unsigned iface,
+                                  const ipv6_addr_t *src)
+{
+    _nib_dcache_entry_t *entry = _slot(dst);
+
+    assert((dst != NULL) && (src != NULL));
+    mutex_lock(&_nib_mutex);
+    if (_valid(entry, dst) && (entry->iface == iface)) {
+        memcpy(&entry->src, src, sizeof(entry->src));
+    }
+    mutex_unlock(&_nib_mutex);
+}
+
+void gnrc_ipv6_nib_dcache_invalidate(void)
+{
+    mutex_lock(&_nib_mutex);
+    _nib_dcache_invalidate();
+    mutex_unlock(&_nib_mutex);
+}
+
+void gnrc_ipv6_nib_dcache_get_stats(gnrc_ipv6_nib_dcache_stats_t *stats)
+{
+    assert(stats != NULL);
+    mutex_lock(&_nib_mutex);
+    *stats = _stats;
+    mutex_unlock(&_nib_mutex);
+}
+#else
+typedef int dont_be_pedantic;
+#endif  /* GNRC_IPV6_NIB_CONF_DCACHE */
+
+/** @} */
@@ -61,6 +61,9 @@ int gnrc_ipv6_nib_pl_set(unsigned iface,
     if (!gnrc_netif_is_6ln(netif) &&
         ((idx = gnrc_netif_ipv6_addr_match(netif, pfx)) >= 0) &&
         (ipv6_addr_match_prefix(&netif->ipv6.addrs[idx], pfx) >= pfx_len)) {
+        if (!(dst->flags & _PFX_ON_LINK)) {
+            _nib_dcache_invalidate();
+        }
         dst->flags |= _PFX_ON_LINK;
     }
     if (netif->ipv6.aac_mode == GNRC_NETIF_AAC_AUTO) {
@@ -431,12 +431,24 @@ void gnrc_ndp_rtr_sol_send(gnrc_netif_t *netif, const ipv6_addr_t *dst)
             uint8_t l2src[8];
             size_t l2src_len = _get_l2src(netif, l2src);
             if (l2src_len > 0) {
+#ifdef MODULE_GNRC_SIXLOWPAN_GHC
+                if (netif->flags & GNRC_NETIF_FLAGS_6LO_GHC) {
+                    /* indicate GHC capability to routers */
+                    pkt = gnrc_sixlowpan_nd_opt_6cio_build(SIXLOWPAN_ND_OPT_6CIO_FLAGS_G,
+                                                           NULL);
+                    if (pkt == NULL) {
+                        DEBUG("ndp: error allocating 6CIO.\n");
+                        break;
+                    }
+                }
+#endif
                 /* add source address link-layer address option */
-                pkt = gnrc_ndp_opt_sl2a_build(l2src, l2src_len, NULL);
-                if (pkt == NULL) {
+                hdr = gnrc_ndp_opt_sl2a_build(l2src, l2src_len, pkt);
+                if (hdr == NULL) {
                     DEBUG("ndp: error allocating SL2AO.\n");
                     break;
                 }
+                pkt = hdr;
             }
         }
         /* add router solicitation header */
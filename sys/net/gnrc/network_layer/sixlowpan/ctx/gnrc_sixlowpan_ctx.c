@@ -14,7 +14,9 @@
 
 #include <stdbool.h>
 #include <inttypes.h>
+#include <string.h>
 
+#include "irq.h"
 #include "mutex.h"
 #include "net/gnrc/sixlowpan/ctx.h"
 #include "xtimer.h"
@@ -22,12 +24,33 @@
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
+/* number of cached address lookups: IPHC looks up the source and the
+ * destination address of every datagram it compresses */
+#define CACHE_SIZE      (2U)
+
+/**
+ * @brief   Result of a previous lookup by address
+ */
+typedef struct {
+    ipv6_addr_t addr;           /**< the address looked up */
+    gnrc_sixlowpan_ctx_t *ctx;  /**< the result, may be NULL */
+    bool valid;                 /**< entry is in use */
+} _cache_entry_t;
+
 static gnrc_sixlowpan_ctx_t _ctxs[GNRC_SIXLOWPAN_CTX_SIZE];
 static uint32_t _ctx_inval_times[GNRC_SIXLOWPAN_CTX_SIZE];
+/* IDs of registered contexts, sorted by descending prefix length so the
+ * first matching one is the longest prefix match */
+static uint8_t _ctx_order[GNRC_SIXLOWPAN_CTX_SIZE];
+static uint8_t _ctx_order_numof;
+static _cache_entry_t _cache[CACHE_SIZE];
+static uint8_t _cache_next;
 static mutex_t _ctx_mutex = MUTEX_INIT;
 
 static uint32_t _current_minute(void);
 static void _update_lifetime(uint8_t id);
+static void _order_remove(uint8_t id);
+static void _order_insert(uint8_t id);
 
 static char ipv6str[IPV6_ADDR_MAX_STR_LEN];
 
@@ -39,20 +62,43 @@ static inline bool _valid(uint8_t id)
 
 gnrc_sixlowpan_ctx_t *gnrc_sixlowpan_ctx_lookup_addr(const ipv6_addr_t *addr)
 {
-    uint8_t best = 0;
     gnrc_sixlowpan_ctx_t *res = NULL;
+    _cache_entry_t *entry = NULL;
 
     mutex_lock(&_ctx_mutex);
 
-    for (unsigned int id = 0; id < GNRC_SIXLOWPAN_CTX_SIZE; id++) {
-        if (_valid(id)) {
-            uint8_t match = ipv6_addr_match_prefix(&_ctxs[id].prefix, addr);
+    for (unsigned i = 0; i < CACHE_SIZE; i++) {
+        if (_cache[i].valid && ipv6_addr_equal(&_cache[i].addr, addr)) {
+            /* context was invalidated behind our back, look up again */
+            if ((_cache[i].ctx != NULL) && (_cache[i].ctx->prefix_len == 0)) {
+                _cache[i].valid = false;
+                break;
+            }
+            entry = &_cache[i];
+            res = entry->ctx;
+            break;
+        }
+    }
+    if (entry == NULL) {
+        for (unsigned i = 0; i < _ctx_order_numof; i++) {
+            gnrc_sixlowpan_ctx_t *ctx = &_ctxs[_ctx_order[i]];
 
-            if ((_ctxs[id].prefix_len <= match) && (match > best)) {
-                best = match;
-                res = &(_ctxs[id]);
+            if (!_valid(_ctx_order[i])) {
+                continue;
+            }
+            if (ipv6_addr_match_prefix(&ctx->prefix, addr) >= ctx->prefix_len) {
+                res = ctx;
+                break;
             }
         }
+        entry = &_cache[_cache_next];
+        _cache_next = (_cache_next + 1) % CACHE_SIZE;
+        memcpy(&entry->addr, addr, sizeof(entry->addr));
+        entry->ctx = res;
+        entry->valid = true;
+    }
+    if (res != NULL) {
+        _update_lifetime(res->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK);
     }
 
     mutex_unlock(&_ctx_mutex);
@@ -101,6 +147,10 @@ gnrc_sixlowpan_ctx_t *gnrc_sixlowpan_ctx_update(uint8_t id, const ipv6_addr_t *p
 
     mutex_lock(&_ctx_mutex);
 
+    /* the prefix (length) may change, so previous lookups may be stale */
+    memset(_cache, 0, sizeof(_cache));
+    _order_remove(id);
+
     _ctxs[id].ltime = ltime;
 
     if (ltime == 0) {
@@ -124,11 +174,39 @@ gnrc_sixlowpan_ctx_t *gnrc_sixlowpan_ctx_update(uint8_t id, const ipv6_addr_t *p
           id, ipv6_addr_to_str(ipv6str, &_ctxs[id].prefix, sizeof(ipv6str)),
           _ctxs[id].prefix_len, _ctxs[id].ltime);
     _ctx_inval_times[id] = ltime + _current_minute();
+    _order_insert(id);
 
     mutex_unlock(&_ctx_mutex);
     return &(_ctxs[id]);
 }
 
+void gnrc_sixlowpan_ctx_remove(uint8_t id)
+{
+    if (id >= GNRC_SIXLOWPAN_CTX_SIZE) {
+        return;
+    }
+
+    if (irq_is_in()) {
+        /* e.g. from a timer callback: if a lookup is in progress, only
+         * invalidate the context. Lookups skip contexts without a prefix
+         * and it is dropped from the order on its next update */
+        if (!mutex_trylock(&_ctx_mutex)) {
+            _ctxs[id].prefix_len = 0;
+            return;
+        }
+    }
+    else {
+        mutex_lock(&_ctx_mutex);
+    }
+
+    DEBUG("6lo ctx: remove context %u\n", id);
+    memset(_cache, 0, sizeof(_cache));
+    _order_remove(id);
+    _ctxs[id].prefix_len = 0;
+
+    mutex_unlock(&_ctx_mutex);
+}
+
 static uint32_t _current_minute(void)
 {
     return xtimer_now_usec() / (US_PER_SEC * 60);
@@ -155,12 +233,40 @@ static void _update_lifetime(uint8_t id)
     }
 }
 
-#ifdef TEST_SUITES
-#include <string.h>
+static void _order_remove(uint8_t id)
+{
+    for (unsigned i = 0; i < _ctx_order_numof; i++) {
+        if (_ctx_order[i] == id) {
+            _ctx_order_numof--;
+            memmove(&_ctx_order[i], &_ctx_order[i + 1],
+                    _ctx_order_numof - i);
+            return;
+        }
+    }
+}
 
+static void _order_insert(uint8_t id)
+{
+    unsigned i = 0;
+
+    /* on equal prefix length the lower ID goes first */
+    while ((i < _ctx_order_numof) &&
+           ((_ctxs[_ctx_order[i]].prefix_len > _ctxs[id].prefix_len) ||
+            ((_ctxs[_ctx_order[i]].prefix_len == _ctxs[id].prefix_len) &&
+             (_ctx_order[i] < id)))) {
+        i++;
+    }
+    memmove(&_ctx_order[i + 1], &_ctx_order[i], _ctx_order_numof - i);
+    _ctx_order[i] = id;
+    _ctx_order_numof++;
+}
+
+#ifdef TEST_SUITES
 void gnrc_sixlowpan_ctx_reset(void)
 {
     memset(_ctxs, 0, sizeof(_ctxs));
+    memset(_cache, 0, sizeof(_cache));
+    _ctx_order_numof = 0;
 }
 #endif
 
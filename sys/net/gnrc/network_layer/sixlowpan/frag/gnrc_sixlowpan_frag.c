@@ -21,6 +21,12 @@
 #include "net/gnrc/netapi.h"
 #include "net/gnrc/netif/hdr.h"
 #include "net/gnrc/sixlowpan/frag.h"
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+#include "net/gnrc/sixlowpan/frag/sfr.h"
+#endif
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+#include "net/gnrc/sixlowpan/frag/vrb.h"
+#endif
 #include "net/gnrc/sixlowpan/internal.h"
 #include "net/gnrc/netif.h"
 #include "net/sixlowpan.h"
@@ -357,6 +363,31 @@ void gnrc_sixlowpan_frag_recv(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
             return;
     }
 
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+    gnrc_sixlowpan_frag_vrb_t *vrbe;
+
+    gnrc_sixlowpan_frag_vrb_gc();
+    vrbe = gnrc_sixlowpan_frag_vrb_get(gnrc_netif_hdr_get_src_addr(hdr),
+                                       hdr->src_l2addr_len,
+                                       gnrc_netif_hdr_get_dst_addr(hdr),
+                                       hdr->dst_l2addr_len,
+                                       byteorder_ntohs(frag->disp_size) &
+                                       SIXLOWPAN_FRAG_SIZE_MASK,
+                                       byteorder_ntohs(frag->tag));
+    if (vrbe != NULL) {
+        if (offset == 0) {
+            /* the first fragment was already forwarded with a recompressed
+             * header, so we can't just pass on a duplicate of it */
+            DEBUG("6lo frag: duplicate first fragment of forwarded datagram\n");
+            gnrc_pktbuf_release(pkt);
+        }
+        else {
+            gnrc_sixlowpan_frag_vrb_forward(vrbe, pkt,
+                                            pkt->size - sizeof(sixlowpan_frag_n_t));
+        }
+        return;
+    }
+#endif
     rbuf_add(hdr, pkt, offset, page);
 }
 
@@ -367,20 +398,15 @@ uint16_t gnrc_sixlowpan_frag_next_tag(void)
 
 void gnrc_sixlowpan_frag_rbuf_base_rm(gnrc_sixlowpan_rbuf_base_t *entry)
 {
-    while (entry->ints != NULL) {
-        gnrc_sixlowpan_rbuf_int_t *next = entry->ints->next;
-
-        entry->ints->start = 0;
-        entry->ints->end = 0;
-        entry->ints->next = NULL;
-        entry->ints = next;
-    }
     entry->datagram_size = 0;
 }
 
 void gnrc_sixlowpan_frag_rbuf_gc(void)
 {
     rbuf_gc();
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+    gnrc_sixlowpan_frag_vrb_gc();
+#endif
 }
 
 void gnrc_sixlowpan_frag_rbuf_remove(gnrc_sixlowpan_rbuf_t *rbuf)
@@ -389,6 +415,16 @@ void gnrc_sixlowpan_frag_rbuf_remove(gnrc_sixlowpan_rbuf_t *rbuf)
     rbuf_rm(rbuf);
 }
 
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+gnrc_sixlowpan_rbuf_t *gnrc_sixlowpan_frag_rbuf_get_sfr(const gnrc_netif_hdr_t *netif_hdr,
+                                                        uint8_t tag, size_t size,
+                                                        unsigned page)
+{
+    assert(netif_hdr != NULL);
+    return rbuf_get_sfr(netif_hdr, tag, size, page);
+}
+#endif
+
 void gnrc_sixlowpan_frag_rbuf_dispatch_when_complete(gnrc_sixlowpan_rbuf_t *rbuf,
                                                      gnrc_netif_hdr_t *netif_hdr)
 {
@@ -417,6 +453,11 @@ void gnrc_sixlowpan_frag_rbuf_dispatch_when_complete(gnrc_sixlowpan_rbuf_t *rbuf
         new_netif_hdr->lqi = netif_hdr->lqi;
         new_netif_hdr->rssi = netif_hdr->rssi;
         LL_APPEND(rbuf->pkt, netif);
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+        if (rbuf->sfr_received != 0) {
+            gnrc_sixlowpan_frag_sfr_completed(&rbuf->super);
+        }
+#endif
         gnrc_sixlowpan_dispatch_recv(rbuf->pkt, NULL, 0);
         gnrc_sixlowpan_frag_rbuf_remove(rbuf);
     }
@@ -14,6 +14,7 @@
 
 #include <inttypes.h>
 #include <stdbool.h>
+#include <string.h>
 
 #include "rbuf.h"
 #include "net/ipv6.h"
@@ -22,6 +23,9 @@
 #include "net/gnrc/sixlowpan.h"
 #include "net/gnrc/sixlowpan/frag.h"
 #include "net/sixlowpan.h"
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+#include "net/sixlowpan/sfr.h"
+#endif
 #include "thread.h"
 #include "xtimer.h"
 #include "utlist.h"
@@ -29,22 +33,21 @@
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
-/* estimated fragment payload size to determinate RBUF_INT_SIZE, default to
- * MAC payload size - fragment header. */
-#ifndef GNRC_SIXLOWPAN_FRAG_SIZE
-/* assuming 64-bit source/destination address, source PAN ID omitted */
-#define GNRC_SIXLOWPAN_FRAG_SIZE (104 - 5)
+/* number of buckets for the datagram lookup */
+#ifndef RBUF_HASH_SIZE
+#define RBUF_HASH_SIZE      (8U)
 #endif
 
-#ifndef RBUF_INT_SIZE
-/* same as ((int) ceil((double) N / D)) */
-#define DIV_CEIL(N, D) (((N) + (D) - 1) / (D))
-#define RBUF_INT_SIZE (DIV_CEIL(IPV6_MIN_MTU, GNRC_SIXLOWPAN_FRAG_SIZE) * RBUF_SIZE)
+#if (RBUF_HASH_SIZE & (RBUF_HASH_SIZE - 1)) != 0
+#error "RBUF_HASH_SIZE must be a power of two"
 #endif
 
-static gnrc_sixlowpan_rbuf_int_t rbuf_int[RBUF_INT_SIZE];
-
 static gnrc_sixlowpan_rbuf_t rbuf[RBUF_SIZE];
+static gnrc_sixlowpan_rbuf_t *_buckets[RBUF_HASH_SIZE];
+static gnrc_sixlowpan_rbuf_t *_wheel[RBUF_WHEEL_SIZE];
+/* tick of the current timer wheel slot */
+static uint64_t _wheel_tick;
+static unsigned _rbuf_used;
 
 static char l2addr_str[3 * IEEE802154_LONG_ADDRESS_LEN];
 
@@ -54,22 +57,19 @@ static msg_t _gc_timer_msg = { .type = GNRC_SIXLOWPAN_MSG_FRAG_GC_RBUF };
 /* ------------------------------------
  * internal function definitions
  * ------------------------------------*/
-/* checks whether start and end overlaps, but not identical to, given interval i */
-static inline bool _rbuf_int_overlap_partially(gnrc_sixlowpan_rbuf_int_t *i,
-                                               uint16_t start, uint16_t end);
-/* gets a free entry from interval buffer */
-static gnrc_sixlowpan_rbuf_int_t *_rbuf_int_get_free(void);
-/* update interval buffer of entry */
-static bool _rbuf_update_ints(gnrc_sixlowpan_rbuf_base_t *entry,
-                              uint16_t offset, size_t frag_size);
+/* marks the 8-octet units of [offset, offset + frag_size) as received */
+static void _rbuf_set_received(gnrc_sixlowpan_rbuf_t *entry,
+                               uint16_t offset, size_t frag_size);
 /* gets an entry identified by its tupel */
 static gnrc_sixlowpan_rbuf_t *_rbuf_get(const void *src, size_t src_len,
                                         const void *dst, size_t dst_len,
                                         size_t size, uint16_t tag,
-                                        unsigned page);
+                                        unsigned page, bool sfr);
 /* internal add to repeat add when fragments overlapped */
 static int _rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
                      size_t offset, unsigned page);
+/* removes the entries that timed out since the last call */
+static void _rbuf_wheel_advance(void);
 
 /* status codes for _rbuf_add() */
 enum {
@@ -79,28 +79,49 @@ enum {
     RBUF_ADD_DUPLICATE,
 };
 
-static int _check_fragments(gnrc_sixlowpan_rbuf_base_t *entry,
+static inline bool _rbuf_is_sfr(const gnrc_sixlowpan_rbuf_t *entry)
+{
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+    return (entry->sfr_received != 0);
+#else
+    (void)entry;
+    return false;
+#endif
+}
+
+static inline uint8_t _unit_mask(unsigned first, unsigned last)
+{
+    return (uint8_t)((0xffU << first) & (0xffU >> (7U - last)));
+}
+
+static int _check_fragments(gnrc_sixlowpan_rbuf_t *entry,
                             size_t frag_size, size_t offset)
 {
-    gnrc_sixlowpan_rbuf_int_t *ptr = entry->ints;
+    unsigned start = offset / 8U, end = (offset + frag_size - 1) / 8U;
+    bool any = false, all = true;
 
-    /* If the fragment overlaps another fragment and differs in either the size
-     * or the offset of the overlapped fragment, discards the datagram
-     * https://tools.ietf.org/html/rfc4944#section-5.3 */
-    while (ptr != NULL) {
-        if (_rbuf_int_overlap_partially(ptr, offset, offset + frag_size - 1)) {
+    /* check the units of the fragment byte-wise in the received bitmap */
+    for (unsigned i = start / 8U; i <= (end / 8U); i++) {
+        uint8_t mask = _unit_mask((i == (start / 8U)) ? (start % 8U) : 0U,
+                                  (i == (end / 8U)) ? (end % 8U) : 7U);
+        uint8_t received = entry->received[i] & mask;
 
-            /* "A fresh reassembly may be commenced with the most recently
-             * received link fragment"
-             * https://tools.ietf.org/html/rfc4944#section-5.3 */
-            return RBUF_ADD_REPEAT;
-        }
-        /* End was already checked in overlap check */
-        if (ptr->start == offset) {
-            DEBUG("6lo rbuf: fragment already in reassembly buffer");
-            return RBUF_ADD_DUPLICATE;
-        }
-        ptr = ptr->next;
+        any |= (received != 0);
+        all &= (received == mask);
+    }
+    if (all) {
+        DEBUG("6lo rbuf: fragment already in reassembly buffer");
+        return RBUF_ADD_DUPLICATE;
+    }
+    if (any) {
+        /* If the fragment overlaps another fragment and differs in either the
+         * size or the offset of the overlapped fragment, discards the
+         * datagram https://tools.ietf.org/html/rfc4944#section-5.3
+         *
+         * "A fresh reassembly may be commenced with the most recently
+         * received link fragment"
+         * https://tools.ietf.org/html/rfc4944#section-5.3 */
+        return RBUF_ADD_REPEAT;
     }
     return RBUF_ADD_SUCCESS;
 }
@@ -126,11 +147,11 @@ static int _rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
                 SIXLOWPAN_FRAG_1_DISP)) && (offset == 0)) ||
            ((((frag->disp_size.u8[0] & SIXLOWPAN_FRAG_DISP_MASK) ==
                 SIXLOWPAN_FRAG_N_DISP)) && (offset == (frag->offset * 8U))));
-    rbuf_gc();
+    _rbuf_wheel_advance();
     entry = _rbuf_get(gnrc_netif_hdr_get_src_addr(netif_hdr), netif_hdr->src_l2addr_len,
                       gnrc_netif_hdr_get_dst_addr(netif_hdr), netif_hdr->dst_l2addr_len,
                       byteorder_ntohs(frag->disp_size) & SIXLOWPAN_FRAG_SIZE_MASK,
-                      byteorder_ntohs(frag->tag), page);
+                      byteorder_ntohs(frag->tag), page, false);
 
     if (entry == NULL) {
         DEBUG("6lo rbuf: reassembly buffer full.\n");
@@ -150,7 +171,8 @@ static int _rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
         data++; /* FRAGN header is one byte longer (offset) */
     }
 
-    if ((offset + frag_size) > entry->super.datagram_size) {
+    if ((frag_size == 0) ||
+        ((offset + frag_size) > entry->super.datagram_size)) {
         DEBUG("6lo rfrag: fragment too big for resulting datagram, discarding datagram\n");
         gnrc_pktbuf_release(entry->pkt);
         gnrc_pktbuf_release(pkt);
@@ -158,7 +180,7 @@ static int _rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
         return RBUF_ADD_ERROR;
     }
 
-    switch (_check_fragments(&entry->super, frag_size, offset)) {
+    switch (_check_fragments(entry, frag_size, offset)) {
         case RBUF_ADD_REPEAT:
             DEBUG("6lo rfrag: overlapping intervals, discarding datagram\n");
             gnrc_pktbuf_release(entry->pkt);
@@ -171,182 +193,225 @@ static int _rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
             break;
     }
 
-    if (_rbuf_update_ints(&entry->super, offset, frag_size)) {
-        DEBUG("6lo rbuf: add fragment data\n");
-        entry->super.current_size += (uint16_t)frag_size;
-        if (offset == 0) {
+    DEBUG("6lo rbuf: add fragment data\n");
+    _rbuf_set_received(entry, offset, frag_size);
+    entry->super.current_size += (uint16_t)frag_size;
+    if (offset == 0) {
 #ifdef MODULE_GNRC_SIXLOWPAN_IPHC
-            if (sixlowpan_iphc_is(data)) {
-                gnrc_pktsnip_t *frag_hdr = gnrc_pktbuf_mark(pkt,
-                        sizeof(sixlowpan_frag_t), GNRC_NETTYPE_SIXLOWPAN);
-                if (frag_hdr == NULL) {
-                    gnrc_pktbuf_release(entry->pkt);
-                    gnrc_pktbuf_release(pkt);
-                    rbuf_rm(entry);
-                    return RBUF_ADD_ERROR;
-                }
-                gnrc_sixlowpan_iphc_recv(pkt, entry, 0);
-                return RBUF_ADD_SUCCESS;
+        if (sixlowpan_iphc_is(data)) {
+            gnrc_pktsnip_t *frag_hdr = gnrc_pktbuf_mark(pkt,
+                    sizeof(sixlowpan_frag_t), GNRC_NETTYPE_SIXLOWPAN);
+            if (frag_hdr == NULL) {
+                gnrc_pktbuf_release(entry->pkt);
+                gnrc_pktbuf_release(pkt);
+                rbuf_rm(entry);
+                return RBUF_ADD_ERROR;
             }
-            else
+            gnrc_sixlowpan_iphc_recv(pkt, entry, 0);
+            return RBUF_ADD_SUCCESS;
+        }
+        else
 #endif
-            if (data[0] == SIXLOWPAN_UNCOMP) {
-                data++;
-            }
+        if (data[0] == SIXLOWPAN_UNCOMP) {
+            data++;
         }
-        memcpy(((uint8_t *)entry->pkt->data) + offset, data,
-               frag_size);
     }
+    memcpy(((uint8_t *)entry->pkt->data) + offset, data, frag_size);
     gnrc_sixlowpan_frag_rbuf_dispatch_when_complete(entry, netif_hdr);
     gnrc_pktbuf_release(pkt);
     return RBUF_ADD_SUCCESS;
 }
 
-static inline bool _rbuf_int_overlap_partially(gnrc_sixlowpan_rbuf_int_t *i,
-                                               uint16_t start, uint16_t end)
+static void _rbuf_set_received(gnrc_sixlowpan_rbuf_t *entry,
+                               uint16_t offset, size_t frag_size)
 {
-    /* start and ends are both inclusive, so using <= for both */
-    return ((i->start <= end) && (start <= i->end)) && /* overlaps */
-        ((start != i->start) || (end != i->end)); /* not identical */
+    unsigned start = offset / 8U, end = (offset + frag_size - 1) / 8U;
+
+    for (unsigned i = start / 8U; i <= (end / 8U); i++) {
+        entry->received[i] |= _unit_mask((i == (start / 8U)) ? (start % 8U) : 0U,
+                                         (i == (end / 8U)) ? (end % 8U) : 7U);
+    }
+    DEBUG("6lo rfrag: add interval (%u, %u) to entry (%s, ", (unsigned)offset,
+          (unsigned)(offset + frag_size - 1),
+          gnrc_netif_addr_to_str(entry->super.src, entry->super.src_len,
+                                 l2addr_str));
+    DEBUG("%s, %u, %u)\n", gnrc_netif_addr_to_str(entry->super.dst,
+                                                  entry->super.dst_len,
+                                                  l2addr_str),
+          entry->super.datagram_size, entry->super.tag);
 }
 
-static gnrc_sixlowpan_rbuf_int_t *_rbuf_int_get_free(void)
+static unsigned _rbuf_hash(const uint8_t *src, size_t src_len,
+                           const uint8_t *dst, size_t dst_len,
+                           size_t size, uint16_t tag)
 {
-    for (unsigned int i = 0; i < RBUF_INT_SIZE; i++) {
-        if (rbuf_int[i].end == 0) { /* start must be smaller than end anyways*/
-            return rbuf_int + i;
-        }
-    }
+    uint32_t hash = ((uint32_t)size << 16) | tag;
 
-    return NULL;
+    for (unsigned i = 0; i < src_len; i++) {
+        hash = (hash * 31) ^ src[i];
+    }
+    for (unsigned i = 0; i < dst_len; i++) {
+        hash = (hash * 31) ^ dst[i];
+    }
+    hash ^= hash >> 16;
+    hash ^= hash >> 8;
+    return hash & (RBUF_HASH_SIZE - 1);
 }
 
-void rbuf_rm(gnrc_sixlowpan_rbuf_t *entry)
+static inline unsigned _rbuf_entry_hash(const gnrc_sixlowpan_rbuf_t *entry)
 {
-    gnrc_sixlowpan_frag_rbuf_base_rm(&entry->super);
-    entry->pkt = NULL;
+    /* subsequent RFRAGs do not carry the datagram size, so it is not part of
+     * the lookup key for SFR */
+    return _rbuf_hash(entry->super.src, entry->super.src_len,
+                      entry->super.dst, entry->super.dst_len,
+                      _rbuf_is_sfr(entry) ? 0 : entry->super.datagram_size,
+                      entry->super.tag);
 }
 
-static bool _rbuf_update_ints(gnrc_sixlowpan_rbuf_base_t *entry,
-                              uint16_t offset, size_t frag_size)
+static inline void _set_rbuf_timeout(void)
 {
-    gnrc_sixlowpan_rbuf_int_t *new;
-    uint16_t end = (uint16_t)(offset + frag_size - 1);
+    xtimer_set_msg(&_gc_timer, RBUF_WHEEL_TICK, &_gc_timer_msg,
+                   sched_active_pid);
+}
 
-    new = _rbuf_int_get_free();
+/* puts entry into the current slot of the timer wheel */
+static void _rbuf_wheel_put(gnrc_sixlowpan_rbuf_t *entry)
+{
+    entry->slot = (uint8_t)(_wheel_tick % RBUF_WHEEL_SIZE);
+    LL_PREPEND2(_wheel[entry->slot], entry, slot_next);
+}
 
-    if (new == NULL) {
-        DEBUG("6lo rfrag: no space left in rbuf interval buffer.\n");
-        return false;
+void rbuf_rm(gnrc_sixlowpan_rbuf_t *entry)
+{
+    if (entry->pkt != NULL) {
+        /* only entries with a packet are in the lookup structures */
+        LL_DELETE2(_buckets[_rbuf_entry_hash(entry)], entry, bucket_next);
+        LL_DELETE2(_wheel[entry->slot], entry, slot_next);
+        _rbuf_used--;
     }
-
-    new->start = offset;
-    new->end = end;
-
-    DEBUG("6lo rfrag: add interval (%" PRIu16 ", %" PRIu16 ") to entry (%s, ",
-          new->start, new->end, gnrc_netif_addr_to_str(entry->src,
-                                                       entry->src_len,
-                                                       l2addr_str));
-    DEBUG("%s, %u, %u)\n", gnrc_netif_addr_to_str(entry->dst,
-                                                  entry->dst_len,
-                                                  l2addr_str),
-          entry->datagram_size, entry->tag);
-
-    LL_PREPEND(entry->ints, new);
-
-    return true;
+    gnrc_sixlowpan_frag_rbuf_base_rm(&entry->super);
+    memset(entry->received, 0, sizeof(entry->received));
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+    entry->sfr_received = 0;
+#endif
+    entry->bucket_next = NULL;
+    entry->slot_next = NULL;
+    entry->pkt = NULL;
 }
 
-void rbuf_gc(void)
+static void _rbuf_wheel_advance(void)
 {
-    uint32_t now_usec = xtimer_now_usec();
-    unsigned int i;
+    uint64_t now_tick = xtimer_now_usec64() / RBUF_WHEEL_TICK;
 
-    for (i = 0; i < RBUF_SIZE; i++) {
-        /* since pkt occupies pktbuf, aggressivly collect garbage */
-        if ((rbuf[i].pkt != NULL) &&
-              ((now_usec - rbuf[i].super.arrival) > RBUF_TIMEOUT)) {
+    /* every slot passed contains the entries that were not updated for a
+     * full turn of the wheel */
+    while ((_rbuf_used > 0) && (_wheel_tick < now_tick)) {
+        gnrc_sixlowpan_rbuf_t *entry;
+
+        _wheel_tick++;
+        while ((entry = _wheel[_wheel_tick % RBUF_WHEEL_SIZE]) != NULL) {
             DEBUG("6lo rfrag: entry (%s, ",
-                  gnrc_netif_addr_to_str(rbuf[i].super.src,
-                                         rbuf[i].super.src_len,
+                  gnrc_netif_addr_to_str(entry->super.src,
+                                         entry->super.src_len,
                                          l2addr_str));
             DEBUG("%s, %u, %u) timed out\n",
-                  gnrc_netif_addr_to_str(rbuf[i].super.dst,
-                                         rbuf[i].super.dst_len,
+                  gnrc_netif_addr_to_str(entry->super.dst,
+                                         entry->super.dst_len,
                                          l2addr_str),
-                  (unsigned)rbuf[i].super.datagram_size, rbuf[i].super.tag);
-
-            gnrc_pktbuf_release(rbuf[i].pkt);
-            rbuf_rm(&(rbuf[i]));
+                  (unsigned)entry->super.datagram_size, entry->super.tag);
+            gnrc_pktbuf_release(entry->pkt);
+            rbuf_rm(entry);
         }
     }
+    _wheel_tick = now_tick;
 }
 
-static inline void _set_rbuf_timeout(void)
+void rbuf_gc(void)
+{
+    _rbuf_wheel_advance();
+    if (_rbuf_used > 0) {
+        _set_rbuf_timeout();
+    }
+}
+
+static gnrc_sixlowpan_rbuf_t *_rbuf_oldest(void)
 {
-    xtimer_set_msg(&_gc_timer, RBUF_TIMEOUT, &_gc_timer_msg, sched_active_pid);
+    /* the slot after the current one is the oldest */
+    for (unsigned i = 1; i <= RBUF_WHEEL_SIZE; i++) {
+        gnrc_sixlowpan_rbuf_t *entry = _wheel[(_wheel_tick + i) % RBUF_WHEEL_SIZE];
+
+        if (entry != NULL) {
+            /* entries are prepended, so the last is the oldest */
+            while (entry->slot_next != NULL) {
+                entry = entry->slot_next;
+            }
+            return entry;
+        }
+    }
+    return NULL;
 }
 
 static gnrc_sixlowpan_rbuf_t *_rbuf_get(const void *src, size_t src_len,
                                         const void *dst, size_t dst_len,
                                         size_t size, uint16_t tag,
-                                        unsigned page)
+                                        unsigned page, bool sfr)
 {
-    gnrc_sixlowpan_rbuf_t *res = NULL, *oldest = NULL;
-    uint32_t now_usec = xtimer_now_usec();
-
-    for (unsigned int i = 0; i < RBUF_SIZE; i++) {
-        /* check first if entry already available */
-        if ((rbuf[i].pkt != NULL) && (rbuf[i].super.datagram_size == size) &&
-            (rbuf[i].super.tag == tag) && (rbuf[i].super.src_len == src_len) &&
-            (rbuf[i].super.dst_len == dst_len) &&
-            (memcmp(rbuf[i].super.src, src, src_len) == 0) &&
-            (memcmp(rbuf[i].super.dst, dst, dst_len) == 0)) {
-            DEBUG("6lo rfrag: entry %p (%s, ", (void *)(&rbuf[i]),
-                  gnrc_netif_addr_to_str(rbuf[i].super.src,
-                                         rbuf[i].super.src_len,
+    gnrc_sixlowpan_rbuf_t *res;
+    unsigned hash = _rbuf_hash(src, src_len, dst, dst_len, sfr ? 0 : size,
+                               tag);
+
+    /* check first if entry already available */
+    LL_FOREACH2(_buckets[hash], res, bucket_next) {
+        if ((_rbuf_is_sfr(res) == sfr) &&
+            (sfr || (res->super.datagram_size == size)) &&
+            (res->super.tag == tag) && (res->super.src_len == src_len) &&
+            (res->super.dst_len == dst_len) &&
+            (memcmp(res->super.src, src, src_len) == 0) &&
+            (memcmp(res->super.dst, dst, dst_len) == 0)) {
+            DEBUG("6lo rfrag: entry %p (%s, ", (void *)res,
+                  gnrc_netif_addr_to_str(res->super.src,
+                                         res->super.src_len,
                                          l2addr_str));
             DEBUG("%s, %u, %u) found\n",
-                  gnrc_netif_addr_to_str(rbuf[i].super.dst,
-                                         rbuf[i].super.dst_len,
+                  gnrc_netif_addr_to_str(res->super.dst,
+                                         res->super.dst_len,
                                          l2addr_str),
-                  (unsigned)rbuf[i].super.datagram_size, rbuf[i].super.tag);
-            rbuf[i].super.arrival = now_usec;
-            _set_rbuf_timeout();
-            return &(rbuf[i]);
-        }
-
-        /* if there is a free spot: remember it */
-        if ((res == NULL) && rbuf_entry_empty(&rbuf[i])) {
-            res = &(rbuf[i]);
-        }
-
-        /* remember oldest slot */
-        /* note that xtimer_now will overflow in ~1.2 hours */
-        if ((oldest == NULL) ||
-            (oldest->super.arrival - rbuf[i].super.arrival < UINT32_MAX / 2)) {
-            oldest = &(rbuf[i]);
+                  (unsigned)res->super.datagram_size, res->super.tag);
+            res->super.arrival = xtimer_now_usec();
+            /* move to the current slot of the timer wheel */
+            LL_DELETE2(_wheel[res->slot], res, slot_next);
+            _rbuf_wheel_put(res);
+            return res;
         }
     }
 
-    /* entry not in buffer and no empty spot found */
-    if (res == NULL) {
-        assert(oldest != NULL);
-        /* if oldest is not empty, res must not be NULL (because otherwise
-         * oldest could have been picked as res) */
-        assert(!rbuf_entry_empty(oldest));
-        if (GNRC_SIXLOWPAN_FRAG_RBUF_AGGRESSIVE_OVERRIDE ||
-            ((now_usec - oldest->super.arrival) >
-            GNRC_SIXLOWPAN_FRAG_RBUF_TIMEOUT_US)) {
-            DEBUG("6lo rfrag: reassembly buffer full, remove oldest entry\n");
-            gnrc_pktbuf_release(oldest->pkt);
-            rbuf_rm(oldest);
-            res = oldest;
-        }
-        else {
-            return NULL;
+    if (size == 0) {
+        /* only look-up requested */
+        return NULL;
+    }
+    /* a new datagram: find a free spot */
+    res = NULL;
+    if (_rbuf_used < RBUF_SIZE) {
+        for (unsigned int i = 0; i < RBUF_SIZE; i++) {
+            if (rbuf_entry_empty(&rbuf[i])) {
+                res = &(rbuf[i]);
+                break;
+            }
         }
     }
+    /* entry not in buffer and no empty spot found. Timed out entries were
+     * already removed by _rbuf_wheel_advance() */
+    else if (GNRC_SIXLOWPAN_FRAG_RBUF_AGGRESSIVE_OVERRIDE) {
+        res = _rbuf_oldest();
+        assert(res != NULL);
+        DEBUG("6lo rfrag: reassembly buffer full, remove oldest entry\n");
+        gnrc_pktbuf_release(res->pkt);
+        rbuf_rm(res);
+    }
+    else {
+        return NULL;
+    }
+    assert(res != NULL);
 
     /* now we have an empty spot */
 
@@ -370,13 +435,25 @@ static gnrc_sixlowpan_rbuf_t *_rbuf_get(const void *src, size_t src_len,
     *((uint64_t *)res->pkt->data) = 0;  /* clean first few bytes for later
                                                * look-ups */
     res->super.datagram_size = size;
-    res->super.arrival = now_usec;
+    res->super.arrival = xtimer_now_usec();
     memcpy(res->super.src, src, src_len);
     memcpy(res->super.dst, dst, dst_len);
     res->super.src_len = src_len;
     res->super.dst_len = dst_len;
     res->super.tag = tag;
     res->super.current_size = 0;
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+    if (sfr) {
+        /* only the first fragment creates an entry for SFR */
+        res->sfr_received = SIXLOWPAN_SFR_ACK_BITMAP_BIT(0);
+    }
+#endif
+    LL_PREPEND2(_buckets[hash], res, bucket_next);
+    _rbuf_wheel_put(res);
+    if (_rbuf_used++ == 0) {
+        /* the first entry starts the garbage collection timer */
+        _set_rbuf_timeout();
+    }
 
     DEBUG("6lo rfrag: entry %p (%s, ", (void *)res,
           gnrc_netif_addr_to_str(res->super.src, res->super.src_len,
@@ -386,16 +463,25 @@ static gnrc_sixlowpan_rbuf_t *_rbuf_get(const void *src, size_t src_len,
                                  l2addr_str), res->super.datagram_size,
           res->super.tag);
 
-    _set_rbuf_timeout();
-
     return res;
 }
 
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+gnrc_sixlowpan_rbuf_t *rbuf_get_sfr(const gnrc_netif_hdr_t *netif_hdr,
+                                    uint8_t tag, size_t size, unsigned page)
+{
+    _rbuf_wheel_advance();
+    return _rbuf_get(gnrc_netif_hdr_get_src_addr(netif_hdr),
+                     netif_hdr->src_l2addr_len,
+                     gnrc_netif_hdr_get_dst_addr(netif_hdr),
+                     netif_hdr->dst_l2addr_len, size, tag, page, true);
+}
+#endif
+
 #ifdef TEST_SUITES
 void rbuf_reset(void)
 {
     xtimer_remove(&_gc_timer);
-    memset(rbuf_int, 0, sizeof(rbuf_int));
     for (unsigned int i = 0; i < RBUF_SIZE; i++) {
         if ((rbuf[i].pkt != NULL) &&
             (rbuf[i].pkt->users > 0)) {
@@ -403,6 +489,9 @@ void rbuf_reset(void)
         }
     }
     memset(rbuf, 0, sizeof(rbuf));
+    memset(_buckets, 0, sizeof(_buckets));
+    memset(_wheel, 0, sizeof(_wheel));
+    _rbuf_used = 0;
 }
 
 const gnrc_sixlowpan_rbuf_t *rbuf_array(void)
@@ -40,6 +40,22 @@ extern "C" {
 #define RBUF_TIMEOUT        (GNRC_SIXLOWPAN_FRAG_RBUF_TIMEOUT_US)
 /** @} */
 
+/**
+ * @brief   Number of slots of the garbage collection timer wheel
+ */
+#ifndef RBUF_WHEEL_SIZE
+#define RBUF_WHEEL_SIZE     (8U)
+#endif
+
+/**
+ * @brief   Time in microseconds the garbage collection timer wheel advances
+ *          by one slot
+ *
+ * An entry is removed between @ref RBUF_TIMEOUT - @ref RBUF_WHEEL_TICK and
+ * @ref RBUF_TIMEOUT + @ref RBUF_WHEEL_TICK after its last fragment arrived.
+ */
+#define RBUF_WHEEL_TICK     (RBUF_TIMEOUT / RBUF_WHEEL_SIZE)
+
 /**
  * @brief   Adds a new fragment to the reassembly buffer. If the packet is
  *          complete, dispatch the packet with the transmit information of
@@ -57,8 +73,39 @@ extern "C" {
 void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *frag,
               size_t offset, unsigned page);
 
+#if defined(MODULE_GNRC_SIXLOWPAN_FRAG_SFR) || defined(DOXYGEN)
+/**
+ * @brief   Gets the reassembly buffer entry of a datagram sent with
+ *          @ref net_gnrc_sixlowpan_frag_sfr
+ *
+ * SFR datagrams are identified by source, destination and tag only, since
+ * only the first fragment carries the datagram size.
+ *
+ * @param[in] netif_hdr     The interface header of the fragment.
+ * @param[in] tag           The datagram tag of the fragment.
+ * @param[in] size          The datagram size, if the fragment is the first
+ *                          fragment. 0 to only look up an existing entry.
+ * @param[in] page          Current 6Lo dispatch parsing page.
+ *
+ * @return  The reassembly buffer entry of the datagram.
+ *          gnrc_sixlowpan_rbuf_t::super::current_size is 0 for a newly
+ *          created entry.
+ * @return  NULL, if no entry exists for @p size == 0 or if the reassembly
+ *          buffer is full.
+ *
+ * @internal
+ */
+gnrc_sixlowpan_rbuf_t *rbuf_get_sfr(const gnrc_netif_hdr_t *netif_hdr,
+                                    uint8_t tag, size_t size, unsigned page);
+#endif
+
 /**
  * @brief   Checks timeouts and removes entries if necessary
+ *
+ * Timeouts are tracked in a timer wheel that is advanced with every call.
+ * While the reassembly buffer is not empty, a @ref
+ * GNRC_SIXLOWPAN_MSG_FRAG_GC_RBUF message is sent to the calling thread every
+ * time the wheel should advance.
  */
 void rbuf_gc(void);
 
@@ -66,7 +113,8 @@ void rbuf_gc(void);
  * @brief   Unsets a reassembly buffer entry (but does not free
  *          rbuf_t::super::pkt)
  *
- * This functions sets rbuf_t::super::pkt to NULL and removes all rbuf::ints.
+ * This functions sets rbuf_t::super::pkt to NULL, clears the received bitmap
+ * and removes the entry from the lookup structures.
  *
  * @param[in] rbuf  A reassembly buffer entry
  *
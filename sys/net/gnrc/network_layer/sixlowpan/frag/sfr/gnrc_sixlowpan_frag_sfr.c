@@ -0,0 +1,651 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @author  Martine Lenders <m.lenders@fu-berlin.de>
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "mutex.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/sixlowpan/internal.h"
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC
+#include "net/gnrc/sixlowpan/iphc.h"
+#endif
+#include "net/sixlowpan.h"
+#include "net/sixlowpan/sfr.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#include "net/gnrc/sixlowpan/frag/sfr.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+/* number of remembered reassembled datagrams */
+#define SFR_COMPLETED_SIZE  (GNRC_SIXLOWPAN_FRAG_RBUF_SIZE)
+
+/**
+ * @brief   Identifies a datagram that was already reassembled
+ */
+typedef struct {
+    uint8_t src[IEEE802154_LONG_ADDRESS_LEN];   /**< source address */
+    uint8_t src_len;                            /**< length of _completed_t::src */
+    uint8_t tag;                                /**< datagram tag */
+    uint16_t datagram_size;                     /**< datagram size */
+    uint32_t completed;                         /**< time of reassembly in us */
+} _completed_t;
+
+/**
+ * @brief   A neighbor known to support SFR
+ */
+typedef struct {
+    uint8_t l2addr[GNRC_NETIF_L2ADDR_MAXLEN];   /**< link-layer address */
+    uint8_t l2addr_len;     /**< length of l2addr, 0 if entry is empty */
+    kernel_pid_t pid;       /**< interface the neighbor is reachable over */
+} _peer_t;
+
+static gnrc_sixlowpan_frag_sfr_fb_t _fbs[GNRC_SIXLOWPAN_MSG_FRAG_SIZE];
+static _completed_t _completed[SFR_COMPLETED_SIZE];
+static unsigned _completed_next;
+static _peer_t _peers[GNRC_SIXLOWPAN_FRAG_SFR_PEERS_NUMOF];
+static mutex_t _peers_mutex = MUTEX_INIT;
+static unsigned _peers_next;
+
+static char l2addr_str[3 * IEEE802154_LONG_ADDRESS_LEN];
+
+static inline size_t _min(size_t a, size_t b)
+{
+    return (a < b) ? a : b;
+}
+
+/* bitmap of all fragments of a datagram with `frags_num` fragments */
+static inline uint32_t _all_frags(unsigned frags_num)
+{
+    return (frags_num >= (SIXLOWPAN_SFR_SEQ_MAX + 1))
+         ? SIXLOWPAN_SFR_ACK_BITMAP_FULL
+         : ~(SIXLOWPAN_SFR_ACK_BITMAP_FULL >> frags_num);
+}
+
+/* ------------------------------------
+ * Sender
+ * ------------------------------------*/
+static void _copy_payload(const gnrc_pktsnip_t *pkt, size_t offset,
+                          uint8_t *data, size_t len)
+{
+    /* skip snips before offset */
+    while ((pkt != NULL) && (offset >= pkt->size)) {
+        offset -= pkt->size;
+        pkt = pkt->next;
+    }
+    while ((pkt != NULL) && (len > 0)) {
+        size_t clen = _min(len, pkt->size - offset);
+
+        memcpy(data, ((uint8_t *)pkt->data) + offset, clen);
+        data += clen;
+        len -= clen;
+        offset = 0;
+        pkt = pkt->next;
+    }
+}
+
+static bool _send_frag(gnrc_sixlowpan_frag_sfr_fb_t *fb, unsigned seq,
+                       bool ack_req)
+{
+    gnrc_netif_hdr_t *netif_hdr = fb->pkt->data, *new_netif_hdr;
+    gnrc_pktsnip_t *netif, *frag;
+    sixlowpan_sfr_rfrag_t *hdr;
+    size_t payload_len = gnrc_pkt_len(fb->pkt->next);
+    size_t offset = seq * fb->frag_size;
+    size_t frag_size = _min(fb->frag_size, payload_len - offset);
+
+    netif = gnrc_netif_hdr_build(gnrc_netif_hdr_get_src_addr(netif_hdr),
+                                 netif_hdr->src_l2addr_len,
+                                 gnrc_netif_hdr_get_dst_addr(netif_hdr),
+                                 netif_hdr->dst_l2addr_len);
+    if (netif == NULL) {
+        DEBUG("6lo sfr: error allocating new link-layer header\n");
+        return false;
+    }
+    new_netif_hdr = netif->data;
+    new_netif_hdr->if_pid = netif_hdr->if_pid;
+    new_netif_hdr->flags = netif_hdr->flags;
+    frag = gnrc_pktbuf_add(NULL, NULL, sizeof(sixlowpan_sfr_rfrag_t) + frag_size,
+                           GNRC_NETTYPE_SIXLOWPAN);
+    if (frag == NULL) {
+        DEBUG("6lo sfr: error allocating fragment\n");
+        gnrc_pktbuf_release(netif);
+        return false;
+    }
+    hdr = frag->data;
+    sixlowpan_sfr_rfrag_set_disp(hdr, fb->tag);
+    sixlowpan_sfr_rfrag_set_seq(hdr, seq);
+    sixlowpan_sfr_rfrag_set_frag_size(hdr, frag_size);
+    if (ack_req) {
+        sixlowpan_sfr_rfrag_set_ack_req(hdr);
+    }
+    else {
+        /* Tell the link layer that we will send more fragments */
+        new_netif_hdr->flags |= GNRC_NETIF_HDR_FLAGS_MORE_DATA;
+    }
+    /* the first fragment carries the datagram size, all others the offset
+     * within the uncompressed datagram */
+    sixlowpan_sfr_rfrag_set_offset(hdr, (seq == 0)
+            ? fb->datagram_size
+            : (uint16_t)(offset + (fb->datagram_size - payload_len)));
+    _copy_payload(fb->pkt->next, offset, (uint8_t *)(hdr + 1), frag_size);
+    netif->next = frag;
+    DEBUG("6lo sfr: send fragment (tag: %u, seq: %u, offset: %u, size: %u%s)\n",
+          fb->tag, seq, sixlowpan_sfr_rfrag_get_offset(hdr),
+          (unsigned)frag_size, (ack_req) ? ", ack requested" : "");
+    gnrc_sixlowpan_dispatch_send(netif, NULL, 0);
+    return true;
+}
+
+static void _send_abort(gnrc_sixlowpan_frag_sfr_fb_t *fb)
+{
+    gnrc_netif_hdr_t *netif_hdr = fb->pkt->data;
+    gnrc_pktsnip_t *netif, *frag;
+
+    netif = gnrc_netif_hdr_build(gnrc_netif_hdr_get_src_addr(netif_hdr),
+                                 netif_hdr->src_l2addr_len,
+                                 gnrc_netif_hdr_get_dst_addr(netif_hdr),
+                                 netif_hdr->dst_l2addr_len);
+    if (netif == NULL) {
+        return;
+    }
+    ((gnrc_netif_hdr_t *)netif->data)->if_pid = netif_hdr->if_pid;
+    frag = gnrc_pktbuf_add(NULL, NULL, sizeof(sixlowpan_sfr_rfrag_t),
+                           GNRC_NETTYPE_SIXLOWPAN);
+    if (frag == NULL) {
+        gnrc_pktbuf_release(netif);
+        return;
+    }
+    /* a fragment without any data aborts the datagram
+     * https://tools.ietf.org/html/rfc8931#section-6.1.1 */
+    sixlowpan_sfr_rfrag_set_disp(frag->data, fb->tag);
+    netif->next = frag;
+    gnrc_sixlowpan_dispatch_send(netif, NULL, 0);
+}
+
+static void _fb_release(gnrc_sixlowpan_frag_sfr_fb_t *fb, int error)
+{
+    xtimer_remove(&fb->timer);
+    if (error) {
+        gnrc_pktbuf_release_error(fb->pkt, error);
+    }
+    else {
+        gnrc_pktbuf_release(fb->pkt);
+    }
+    fb->pkt = NULL;
+}
+
+/* picks the fragments of the next window: unacknowledged fragments that were
+ * already sent first, then fragments that were never sent */
+static void _open_window(gnrc_sixlowpan_frag_sfr_fb_t *fb)
+{
+    unsigned n = 0;
+
+    fb->window = 0;
+    for (unsigned seq = 0; (seq < fb->next_seq) &&
+                           (n < GNRC_SIXLOWPAN_FRAG_SFR_WIN_SIZE); seq++) {
+        if (!(fb->acked & SIXLOWPAN_SFR_ACK_BITMAP_BIT(seq))) {
+            fb->window |= SIXLOWPAN_SFR_ACK_BITMAP_BIT(seq);
+            n++;
+        }
+    }
+    while ((fb->next_seq < fb->frags_num) &&
+           (n < GNRC_SIXLOWPAN_FRAG_SFR_WIN_SIZE)) {
+        fb->window |= SIXLOWPAN_SFR_ACK_BITMAP_BIT(fb->next_seq++);
+        n++;
+    }
+}
+
+/* sends the next fragment(s) of the current window and arms the timer for
+ * either the next fragment or the RFRAG-ACK */
+static void _send_window(gnrc_sixlowpan_frag_sfr_fb_t *fb)
+{
+    do {
+        unsigned seq = 0;
+
+        while (!(fb->window & SIXLOWPAN_SFR_ACK_BITMAP_BIT(seq))) {
+            seq++;
+        }
+        fb->window &= ~SIXLOWPAN_SFR_ACK_BITMAP_BIT(seq);
+        /* a fragment that can't be sent now is treated as lost */
+        _send_frag(fb, seq, (fb->window == 0));
+    } while ((fb->window != 0) &&
+             (GNRC_SIXLOWPAN_FRAG_SFR_INTER_FRAME_GAP_US == 0));
+    xtimer_set_msg(&fb->timer, (fb->window != 0)
+                                    ? GNRC_SIXLOWPAN_FRAG_SFR_INTER_FRAME_GAP_US
+                                    : GNRC_SIXLOWPAN_FRAG_SFR_ARQ_TIMEOUT_US,
+                   &fb->timer_msg, sched_active_pid);
+}
+
+static _peer_t *_peer_get(kernel_pid_t pid, const uint8_t *l2addr,
+                          size_t l2addr_len)
+{
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_FRAG_SFR_PEERS_NUMOF; i++) {
+        _peer_t *peer = &_peers[i];
+
+        if ((peer->l2addr_len == l2addr_len) && (peer->pid == pid) &&
+            (memcmp(peer->l2addr, l2addr, l2addr_len) == 0)) {
+            return peer;
+        }
+    }
+    return NULL;
+}
+
+static void _peer_add(kernel_pid_t pid, const uint8_t *l2addr,
+                      size_t l2addr_len)
+{
+    if ((l2addr_len == 0) || (l2addr_len > GNRC_NETIF_L2ADDR_MAXLEN)) {
+        return;
+    }
+    mutex_lock(&_peers_mutex);
+    if (_peer_get(pid, l2addr, l2addr_len) == NULL) {
+        /* replace entries round-robin so the oldest one goes first */
+        _peer_t *peer = &_peers[_peers_next];
+
+        _peers_next = (_peers_next + 1) % GNRC_SIXLOWPAN_FRAG_SFR_PEERS_NUMOF;
+        memcpy(peer->l2addr, l2addr, l2addr_len);
+        peer->l2addr_len = l2addr_len;
+        peer->pid = pid;
+        DEBUG("6lo sfr: neighbor %s supports SFR\n",
+              gnrc_netif_addr_to_str(l2addr, l2addr_len, l2addr_str));
+    }
+    mutex_unlock(&_peers_mutex);
+}
+
+void gnrc_sixlowpan_frag_sfr_peer_add(const gnrc_netif_t *netif,
+                                      const uint8_t *l2addr,
+                                      size_t l2addr_len)
+{
+    assert(netif != NULL);
+    _peer_add(netif->pid, l2addr, l2addr_len);
+}
+
+bool gnrc_sixlowpan_frag_sfr_use(const gnrc_netif_t *netif,
+                                 const gnrc_netif_hdr_t *hdr)
+{
+    bool res;
+
+    /* multicast and broadcast receivers can't acknowledge fragments */
+    if ((hdr->dst_l2addr_len == 0) ||
+        (hdr->flags &
+         (GNRC_NETIF_HDR_FLAGS_BROADCAST | GNRC_NETIF_HDR_FLAGS_MULTICAST))) {
+        return false;
+    }
+    if (GNRC_SIXLOWPAN_FRAG_SFR_ALL_PEERS) {
+        return true;
+    }
+    mutex_lock(&_peers_mutex);
+    res = (_peer_get(netif->pid, gnrc_netif_hdr_get_dst_addr(hdr),
+                     hdr->dst_l2addr_len) != NULL);
+    mutex_unlock(&_peers_mutex);
+    return res;
+}
+
+gnrc_sixlowpan_frag_sfr_fb_t *gnrc_sixlowpan_frag_sfr_fb_get(void)
+{
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_MSG_FRAG_SIZE; i++) {
+        if (_fbs[i].pkt == NULL) {
+            return &_fbs[i];
+        }
+    }
+    return NULL;
+}
+
+void gnrc_sixlowpan_frag_sfr_send(gnrc_pktsnip_t *pkt, void *ctx,
+                                  unsigned page)
+{
+    gnrc_sixlowpan_frag_sfr_fb_t *fb = ctx;
+    gnrc_netif_t *netif;
+    size_t payload_len;
+
+    assert(fb != NULL);
+    assert(fb->pkt == pkt);
+    (void)pkt;
+    (void)page;
+    netif = gnrc_netif_hdr_get_netif(fb->pkt->data);
+    payload_len = gnrc_pkt_len(fb->pkt->next);
+    if ((netif == NULL) ||
+        (netif->sixlo.max_frag_size <= sizeof(sixlowpan_sfr_rfrag_t))) {
+        DEBUG("6lo sfr: unable to determine fragment size\n");
+        gnrc_pktbuf_release_error(fb->pkt, EINVAL);
+        fb->pkt = NULL;
+        return;
+    }
+    fb->frag_size = _min(netif->sixlo.max_frag_size -
+                         sizeof(sixlowpan_sfr_rfrag_t),
+                         SIXLOWPAN_SFR_FRAG_SIZE_MAX);
+    if (((payload_len + fb->frag_size - 1) / fb->frag_size) >
+        (SIXLOWPAN_SFR_SEQ_MAX + 1)) {
+        DEBUG("6lo sfr: datagram needs more than %u fragments\n",
+              SIXLOWPAN_SFR_SEQ_MAX + 1);
+        gnrc_pktbuf_release_error(fb->pkt, EMSGSIZE);
+        fb->pkt = NULL;
+        return;
+    }
+    fb->frags_num = (payload_len + fb->frag_size - 1) / fb->frag_size;
+    fb->tag = (uint8_t)gnrc_sixlowpan_frag_next_tag();
+    fb->acked = 0;
+    fb->next_seq = 0;
+    fb->retries = 0;
+    fb->timer_msg.type = GNRC_SIXLOWPAN_MSG_FRAG_SFR_TIMER;
+    fb->timer_msg.content.ptr = fb;
+    DEBUG("6lo sfr: send datagram (tag: %u, size: %u) in %u fragments\n",
+          fb->tag, fb->datagram_size, fb->frags_num);
+    _open_window(fb);
+    _send_window(fb);
+}
+
+void gnrc_sixlowpan_frag_sfr_timeout(gnrc_sixlowpan_frag_sfr_fb_t *fb)
+{
+    if (fb->pkt == NULL) {
+        /* datagram was already completed or aborted */
+        return;
+    }
+    if (fb->window == 0) {
+        if (++fb->retries > GNRC_SIXLOWPAN_FRAG_SFR_FRAG_RETRIES) {
+            DEBUG("6lo sfr: no RFRAG-ACK for datagram %u, aborting\n",
+                  fb->tag);
+            _send_abort(fb);
+            _fb_release(fb, ETIMEDOUT);
+            return;
+        }
+        DEBUG("6lo sfr: no RFRAG-ACK for datagram %u, retransmitting\n",
+              fb->tag);
+        _open_window(fb);
+    }
+    _send_window(fb);
+}
+
+static void _recv_ack(gnrc_netif_hdr_t *netif_hdr, sixlowpan_sfr_ack_t *ack)
+{
+    uint32_t bitmap = sixlowpan_sfr_ack_get_bitmap(ack);
+
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_MSG_FRAG_SIZE; i++) {
+        gnrc_sixlowpan_frag_sfr_fb_t *fb = &_fbs[i];
+        gnrc_netif_hdr_t *fb_netif_hdr;
+
+        if ((fb->pkt == NULL) || (fb->tag != ack->base.tag)) {
+            continue;
+        }
+        fb_netif_hdr = fb->pkt->data;
+        if ((fb_netif_hdr->dst_l2addr_len != netif_hdr->src_l2addr_len) ||
+            (memcmp(gnrc_netif_hdr_get_dst_addr(fb_netif_hdr),
+                    gnrc_netif_hdr_get_src_addr(netif_hdr),
+                    netif_hdr->src_l2addr_len) != 0)) {
+            continue;
+        }
+        DEBUG("6lo sfr: RFRAG-ACK for datagram %u (bitmap: %08lx)\n",
+              fb->tag, (unsigned long)bitmap);
+        if (bitmap == SIXLOWPAN_SFR_ACK_BITMAP_NULL) {
+            DEBUG("6lo sfr: datagram %u aborted by receiver\n", fb->tag);
+            _fb_release(fb, ECONNABORTED);
+            return;
+        }
+        if ((bitmap & ~fb->acked) != 0) {
+            /* progress */
+            fb->retries = 0;
+        }
+        fb->acked |= bitmap;
+        if ((fb->acked & _all_frags(fb->frags_num)) ==
+            _all_frags(fb->frags_num)) {
+            DEBUG("6lo sfr: datagram %u acknowledged\n", fb->tag);
+            _fb_release(fb, 0);
+            return;
+        }
+        /* don't resend fragments of the current window that arrived */
+        fb->window &= ~fb->acked;
+        if (fb->window == 0) {
+            xtimer_remove(&fb->timer);
+            _open_window(fb);
+            _send_window(fb);
+        }
+        return;
+    }
+    DEBUG("6lo sfr: RFRAG-ACK for unknown datagram %u\n", ack->base.tag);
+}
+
+/* ------------------------------------
+ * Receiver
+ * ------------------------------------*/
+static void _send_ack(const gnrc_netif_hdr_t *netif_hdr, uint8_t tag,
+                      uint32_t bitmap)
+{
+    gnrc_pktsnip_t *netif, *ack;
+
+    /* answer from the address the fragment was sent to, so the sender can
+     * identify the datagram */
+    netif = gnrc_netif_hdr_build(gnrc_netif_hdr_get_dst_addr(netif_hdr),
+                                 netif_hdr->dst_l2addr_len,
+                                 gnrc_netif_hdr_get_src_addr(netif_hdr),
+                                 netif_hdr->src_l2addr_len);
+    if (netif == NULL) {
+        DEBUG("6lo sfr: error allocating link-layer header for RFRAG-ACK\n");
+        return;
+    }
+    ((gnrc_netif_hdr_t *)netif->data)->if_pid = netif_hdr->if_pid;
+    ack = gnrc_pktbuf_add(NULL, NULL, sizeof(sixlowpan_sfr_ack_t),
+                          GNRC_NETTYPE_SIXLOWPAN);
+    if (ack == NULL) {
+        DEBUG("6lo sfr: error allocating RFRAG-ACK\n");
+        gnrc_pktbuf_release(netif);
+        return;
+    }
+    sixlowpan_sfr_ack_set(ack->data, tag, bitmap);
+    netif->next = ack;
+    DEBUG("6lo sfr: send RFRAG-ACK for datagram %u to %s (bitmap: %08lx)\n",
+          tag, gnrc_netif_addr_to_str(gnrc_netif_hdr_get_src_addr(netif_hdr),
+                                      netif_hdr->src_l2addr_len, l2addr_str),
+          (unsigned long)bitmap);
+    gnrc_sixlowpan_dispatch_send(netif, NULL, 0);
+}
+
+/* checks if a datagram was already reassembled. `datagram_size` is only
+ * compared if not 0. Datagrams are forgotten after the reassembly timeout, so
+ * the tag can be reused by the sender */
+static bool _completed_has(const gnrc_netif_hdr_t *netif_hdr, uint8_t tag,
+                           uint16_t datagram_size)
+{
+    uint32_t now = xtimer_now_usec();
+
+    for (unsigned i = 0; i < SFR_COMPLETED_SIZE; i++) {
+        _completed_t *c = &_completed[i];
+
+        if ((c->src_len > 0) &&
+            ((now - c->completed) >= GNRC_SIXLOWPAN_FRAG_RBUF_TIMEOUT_US)) {
+            c->src_len = 0;
+        }
+        if ((c->src_len > 0) && (c->tag == tag) &&
+            ((datagram_size == 0) || (c->datagram_size == datagram_size)) &&
+            (c->src_len == netif_hdr->src_l2addr_len) &&
+            (memcmp(c->src, gnrc_netif_hdr_get_src_addr(netif_hdr),
+                    c->src_len) == 0)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void gnrc_sixlowpan_frag_sfr_completed(const gnrc_sixlowpan_rbuf_base_t *base)
+{
+    _completed_t *c = &_completed[_completed_next];
+
+    memcpy(c->src, base->src, base->src_len);
+    c->src_len = base->src_len;
+    c->tag = (uint8_t)base->tag;
+    c->datagram_size = base->datagram_size;
+    c->completed = xtimer_now_usec();
+    _completed_next = (_completed_next + 1) % SFR_COMPLETED_SIZE;
+}
+
+/* adds the data of the fragment to the reassembly buffer entry. `pkt` is
+ * released in any case */
+static void _add_frag(gnrc_sixlowpan_rbuf_t *entry, gnrc_pktsnip_t *pkt,
+                      unsigned seq, uint16_t offset, size_t frag_size,
+                      unsigned page)
+{
+    gnrc_netif_hdr_t *netif_hdr = pkt->next->data;
+    uint8_t *data = ((uint8_t *)pkt->data) + sizeof(sixlowpan_sfr_rfrag_t);
+
+    if (seq == 0) {
+        offset = 0;
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC
+        if (sixlowpan_iphc_is(data)) {
+            gnrc_pktsnip_t *frag_hdr = gnrc_pktbuf_mark(pkt,
+                    sizeof(sixlowpan_sfr_rfrag_t), GNRC_NETTYPE_SIXLOWPAN);
+
+            if (frag_hdr == NULL) {
+                gnrc_pktbuf_release(entry->pkt);
+                gnrc_sixlowpan_frag_rbuf_remove(entry);
+                gnrc_pktbuf_release(pkt);
+                return;
+            }
+            entry->super.current_size += frag_size;
+            /* decompresses into entry and dispatches it when complete */
+            gnrc_sixlowpan_iphc_recv(pkt, entry, page);
+            return;
+        }
+#else
+        (void)page;
+#endif
+        if (data[0] == SIXLOWPAN_UNCOMP) {
+            data++;
+            frag_size--;
+        }
+    }
+    if ((offset + frag_size) > entry->super.datagram_size) {
+        DEBUG("6lo sfr: fragment too big for resulting datagram, "
+              "discarding datagram\n");
+        gnrc_pktbuf_release(entry->pkt);
+        gnrc_sixlowpan_frag_rbuf_remove(entry);
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    memcpy(((uint8_t *)entry->pkt->data) + offset, data, frag_size);
+    entry->super.current_size += frag_size;
+    gnrc_sixlowpan_frag_rbuf_dispatch_when_complete(entry, netif_hdr);
+    gnrc_pktbuf_release(pkt);
+}
+
+static void _recv_rfrag(gnrc_pktsnip_t *pkt, unsigned page)
+{
+    gnrc_pktsnip_t *netif = pkt->next;
+    gnrc_netif_hdr_t *netif_hdr = netif->data;
+    sixlowpan_sfr_rfrag_t *hdr = pkt->data;
+    gnrc_sixlowpan_rbuf_t *entry;
+    unsigned seq = sixlowpan_sfr_rfrag_get_seq(hdr);
+    size_t frag_size = sixlowpan_sfr_rfrag_get_frag_size(hdr);
+    uint16_t offset = sixlowpan_sfr_rfrag_get_offset(hdr);
+    uint8_t tag = hdr->base.tag;
+    bool ack_req = sixlowpan_sfr_rfrag_ack_req(hdr);
+
+    if (frag_size == 0) {
+        DEBUG("6lo sfr: datagram %u aborted by sender\n", tag);
+        if ((entry = gnrc_sixlowpan_frag_rbuf_get_sfr(netif_hdr, tag, 0,
+                                                      page)) != NULL) {
+            gnrc_pktbuf_release(entry->pkt);
+            gnrc_sixlowpan_frag_rbuf_remove(entry);
+        }
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    if ((pkt->size != (sizeof(sixlowpan_sfr_rfrag_t) + frag_size)) ||
+        ((seq == 0) && (offset == 0))) {
+        DEBUG("6lo sfr: malformed fragment\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    if (_completed_has(netif_hdr, tag, (seq == 0) ? offset : 0)) {
+        DEBUG("6lo sfr: fragment %u of already reassembled datagram %u\n",
+              seq, tag);
+        /* the last RFRAG-ACK got lost */
+        _send_ack(netif_hdr, tag, SIXLOWPAN_SFR_ACK_BITMAP_FULL);
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    entry = gnrc_sixlowpan_frag_rbuf_get_sfr(netif_hdr, tag,
+                                             (seq == 0) ? offset : 0, page);
+    if (entry == NULL) {
+        if (seq == 0) {
+            DEBUG("6lo sfr: reassembly buffer full, aborting datagram %u\n",
+                  tag);
+            _send_ack(netif_hdr, tag, SIXLOWPAN_SFR_ACK_BITMAP_NULL);
+        }
+        else {
+            /* the sender will retransmit the first fragment, since it was
+             * never acknowledged */
+            DEBUG("6lo sfr: fragment %u of unknown datagram %u\n", seq, tag);
+        }
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    if ((seq == 0) ? (entry->super.current_size > 0)
+                   : (entry->sfr_received & SIXLOWPAN_SFR_ACK_BITMAP_BIT(seq))) {
+        DEBUG("6lo sfr: duplicate fragment %u of datagram %u\n", seq, tag);
+        if (ack_req) {
+            _send_ack(netif_hdr, tag, entry->sfr_received);
+        }
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    entry->sfr_received |= SIXLOWPAN_SFR_ACK_BITMAP_BIT(seq);
+    /* keep the link-layer header for the RFRAG-ACK */
+    gnrc_pktbuf_hold(netif, 1);
+    _add_frag(entry, pkt, seq, offset, frag_size, page);
+    if (_completed_has(netif_hdr, tag, 0)) {
+        /* acknowledge the complete datagram right away */
+        _send_ack(netif_hdr, tag, SIXLOWPAN_SFR_ACK_BITMAP_FULL);
+    }
+    else if (entry->pkt == NULL) {
+        /* reassembly failed */
+        _send_ack(netif_hdr, tag, SIXLOWPAN_SFR_ACK_BITMAP_NULL);
+    }
+    else if (ack_req) {
+        _send_ack(netif_hdr, tag, entry->sfr_received);
+    }
+    gnrc_pktbuf_release(netif);
+}
+
+void gnrc_sixlowpan_frag_sfr_recv(gnrc_pktsnip_t *pkt, void *ctx,
+                                  unsigned page)
+{
+    sixlowpan_sfr_t *hdr = pkt->data;
+
+    (void)ctx;
+    if (sixlowpan_sfr_rfrag_is(hdr) &&
+        (pkt->size >= sizeof(sixlowpan_sfr_rfrag_t))) {
+        gnrc_netif_hdr_t *netif_hdr = pkt->next->data;
+
+        /* the sender supports SFR, so use it for datagrams to it as well */
+        _peer_add(netif_hdr->if_pid, gnrc_netif_hdr_get_src_addr(netif_hdr),
+                  netif_hdr->src_l2addr_len);
+        _recv_rfrag(pkt, page);
+        return;
+    }
+    if (sixlowpan_sfr_ack_is(hdr) &&
+        (pkt->size >= sizeof(sixlowpan_sfr_ack_t))) {
+        _recv_ack(pkt->next->data, pkt->data);
+    }
+    else {
+        DEBUG("6lo sfr: invalid SFR header\n");
+    }
+    gnrc_pktbuf_release(pkt);
+}
+
+/** @} */
@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @author  Martine Lenders <m.lenders@fu-berlin.de>
+ */
+
+#include <string.h>
+
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/sixlowpan/internal.h"
+#include "net/sixlowpan.h"
+#include "xtimer.h"
+
+#include "net/gnrc/sixlowpan/frag/vrb.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+static gnrc_sixlowpan_frag_vrb_t _vrb[GNRC_SIXLOWPAN_FRAG_VRB_SIZE];
+static char l2addr_str[3 * IEEE802154_LONG_ADDRESS_LEN];
+
+static inline bool _vrbe_empty(const gnrc_sixlowpan_frag_vrb_t *vrbe)
+{
+    return (vrbe->super.datagram_size == 0);
+}
+
+static inline bool _vrbe_timed_out(const gnrc_sixlowpan_frag_vrb_t *vrbe,
+                                   uint32_t now_usec)
+{
+    return (now_usec - vrbe->super.arrival) > GNRC_SIXLOWPAN_FRAG_VRB_TIMEOUT_US;
+}
+
+gnrc_sixlowpan_frag_vrb_t *gnrc_sixlowpan_frag_vrb_add(
+        const gnrc_sixlowpan_rbuf_base_t *base, gnrc_netif_t *out_netif,
+        const uint8_t *out_dst, size_t out_dst_len)
+{
+    gnrc_sixlowpan_frag_vrb_t *vrbe = NULL, *oldest = NULL;
+    uint32_t now_usec = xtimer_now_usec();
+
+    assert((base != NULL) && (out_netif != NULL) && (out_dst != NULL));
+    assert(out_dst_len <= IEEE802154_LONG_ADDRESS_LEN);
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_FRAG_VRB_SIZE; i++) {
+        if (_vrbe_empty(&_vrb[i])) {
+            vrbe = &_vrb[i];
+            break;
+        }
+        /* note that xtimer_now will overflow in ~1.2 hours */
+        if ((oldest == NULL) ||
+            (oldest->super.arrival - _vrb[i].super.arrival < UINT32_MAX / 2)) {
+            oldest = &_vrb[i];
+        }
+    }
+    if (vrbe == NULL) {
+        if ((oldest == NULL) || !_vrbe_timed_out(oldest, now_usec)) {
+            DEBUG("6lo vrb: virtual reassembly buffer full\n");
+            return NULL;
+        }
+        DEBUG("6lo vrb: virtual reassembly buffer full, remove oldest entry\n");
+        vrbe = oldest;
+    }
+    memcpy(vrbe->super.src, base->src, base->src_len);
+    memcpy(vrbe->super.dst, base->dst, base->dst_len);
+    vrbe->super.src_len = base->src_len;
+    vrbe->super.dst_len = base->dst_len;
+    vrbe->super.tag = base->tag;
+    vrbe->super.datagram_size = base->datagram_size;
+    vrbe->super.current_size = 0;
+    vrbe->super.arrival = now_usec;
+    vrbe->out_netif = out_netif;
+    memcpy(vrbe->out_dst, out_dst, out_dst_len);
+    vrbe->out_dst_len = out_dst_len;
+    vrbe->out_tag = gnrc_sixlowpan_frag_next_tag();
+    DEBUG("6lo vrb: forward datagram (%s, %u) ",
+          gnrc_netif_addr_to_str(vrbe->super.src, vrbe->super.src_len,
+                                 l2addr_str), vrbe->super.tag);
+    DEBUG("to (%s, %u) over interface %u\n",
+          gnrc_netif_addr_to_str(vrbe->out_dst, vrbe->out_dst_len,
+                                 l2addr_str), vrbe->out_tag,
+          (unsigned)out_netif->pid);
+    return vrbe;
+}
+
+gnrc_sixlowpan_frag_vrb_t *gnrc_sixlowpan_frag_vrb_get(
+        const uint8_t *src, size_t src_len, const uint8_t *dst, size_t dst_len,
+        size_t datagram_size, unsigned src_tag)
+{
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_FRAG_VRB_SIZE; i++) {
+        gnrc_sixlowpan_frag_vrb_t *vrbe = &_vrb[i];
+
+        /* a datagram is identified by all of source, destination, size and
+         * tag (see RFC 4944, section 5.3) */
+        if (!_vrbe_empty(vrbe) && (vrbe->super.tag == src_tag) &&
+            (vrbe->super.datagram_size == datagram_size) &&
+            (vrbe->super.src_len == src_len) &&
+            (vrbe->super.dst_len == dst_len) &&
+            (memcmp(vrbe->super.src, src, src_len) == 0) &&
+            (memcmp(vrbe->super.dst, dst, dst_len) == 0)) {
+            return vrbe;
+        }
+    }
+    return NULL;
+}
+
+void gnrc_sixlowpan_frag_vrb_forward(gnrc_sixlowpan_frag_vrb_t *vrbe,
+                                     gnrc_pktsnip_t *pkt, size_t frag_size)
+{
+    gnrc_pktsnip_t *netif;
+    gnrc_netif_hdr_t *netif_hdr;
+    sixlowpan_frag_n_t *frag;
+
+    assert((vrbe != NULL) && (pkt != NULL));
+    /* drop the link-layer header of the previous hop */
+    while ((netif = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_NETIF)) != NULL) {
+        pkt = gnrc_pktbuf_remove_snip(pkt, netif);
+    }
+    if ((pkt = gnrc_pktbuf_start_write(pkt)) == NULL) {
+        DEBUG("6lo vrb: unable to get write access to fragment\n");
+        return;
+    }
+    netif = gnrc_netif_hdr_build(NULL, 0, vrbe->out_dst, vrbe->out_dst_len);
+    if (netif == NULL) {
+        DEBUG("6lo vrb: unable to allocate link-layer header\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    frag = pkt->data;
+    assert((frag->disp_size.u8[0] & SIXLOWPAN_FRAG_DISP_MASK) ==
+           SIXLOWPAN_FRAG_N_DISP);
+    frag->tag = byteorder_htons(vrbe->out_tag);
+    netif_hdr = netif->data;
+    netif_hdr->if_pid = vrbe->out_netif->pid;
+    netif->next = pkt;
+    vrbe->super.arrival = xtimer_now_usec();
+    vrbe->super.current_size += frag_size;
+    if (vrbe->super.current_size < vrbe->super.datagram_size) {
+        netif_hdr->flags |= GNRC_NETIF_HDR_FLAGS_MORE_DATA;
+    }
+    else {
+        /* all bytes of the datagram passed through */
+        gnrc_sixlowpan_frag_vrb_rm(vrbe);
+    }
+    DEBUG("6lo vrb: forward fragment (offset: %u, size: %u)\n",
+          frag->offset * 8U, (unsigned)frag_size);
+    gnrc_sixlowpan_dispatch_send(netif, NULL, 0);
+}
+
+void gnrc_sixlowpan_frag_vrb_rm(gnrc_sixlowpan_frag_vrb_t *vrbe)
+{
+    assert(vrbe != NULL);
+    gnrc_sixlowpan_frag_rbuf_base_rm(&vrbe->super);
+    vrbe->out_netif = NULL;
+}
+
+void gnrc_sixlowpan_frag_vrb_gc(void)
+{
+    uint32_t now_usec = xtimer_now_usec();
+
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_FRAG_VRB_SIZE; i++) {
+        if (!_vrbe_empty(&_vrb[i]) && _vrbe_timed_out(&_vrb[i], now_usec)) {
+            DEBUG("6lo vrb: entry (%s, %u) timed out\n",
+                  gnrc_netif_addr_to_str(_vrb[i].super.src,
+                                         _vrb[i].super.src_len,
+                                         l2addr_str), _vrb[i].super.tag);
+            gnrc_sixlowpan_frag_vrb_rm(&_vrb[i]);
+        }
+    }
+}
+
+#ifdef TEST_SUITES
+void gnrc_sixlowpan_frag_vrb_reset(void)
+{
+    memset(_vrb, 0, sizeof(_vrb));
+}
+#endif
+
+/** @} */
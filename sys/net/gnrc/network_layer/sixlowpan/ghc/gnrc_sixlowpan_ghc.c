@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @author  Martine Lenders <m.lenders@fu-berlin.de>
+ */
+
+#include <string.h>
+
+#include "mutex.h"
+#include "net/gnrc/sixlowpan/config.h"
+
+#include "net/gnrc/sixlowpan/ghc.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+/**
+ * @brief   A neighbor known to be GHC capable
+ */
+typedef struct {
+    uint8_t l2addr[GNRC_NETIF_L2ADDR_MAXLEN];   /**< link-layer address */
+    uint8_t l2addr_len;     /**< length of l2addr, 0 if entry is empty */
+    kernel_pid_t pid;       /**< interface the neighbor is reachable over */
+} _peer_t;
+
+static _peer_t _peers[GNRC_SIXLOWPAN_GHC_PEERS_NUMOF];
+static mutex_t _peers_mutex = MUTEX_INIT;
+static unsigned _peers_next;
+
+static _peer_t *_peer_get(kernel_pid_t pid, const uint8_t *l2addr,
+                          size_t l2addr_len)
+{
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_GHC_PEERS_NUMOF; i++) {
+        _peer_t *peer = &_peers[i];
+
+        if ((peer->l2addr_len == l2addr_len) && (peer->pid == pid) &&
+            (memcmp(peer->l2addr, l2addr, l2addr_len) == 0)) {
+            return peer;
+        }
+    }
+    return NULL;
+}
+
+void gnrc_sixlowpan_ghc_peer_set(const gnrc_netif_t *netif,
+                                 const uint8_t *l2addr, size_t l2addr_len,
+                                 bool capable)
+{
+    _peer_t *peer;
+
+    if ((l2addr_len == 0) || (l2addr_len > GNRC_NETIF_L2ADDR_MAXLEN)) {
+        return;
+    }
+    mutex_lock(&_peers_mutex);
+    peer = _peer_get(netif->pid, l2addr, l2addr_len);
+    if (capable && (peer == NULL)) {
+        /* replace entries round-robin so the oldest one goes first */
+        peer = &_peers[_peers_next];
+        _peers_next = (_peers_next + 1) % GNRC_SIXLOWPAN_GHC_PEERS_NUMOF;
+        memcpy(peer->l2addr, l2addr, l2addr_len);
+        peer->l2addr_len = l2addr_len;
+        peer->pid = netif->pid;
+        DEBUG("6lo ghc: neighbor is GHC capable\n");
+    }
+    else if (!capable && (peer != NULL)) {
+        peer->l2addr_len = 0;
+        DEBUG("6lo ghc: neighbor is not GHC capable anymore\n");
+    }
+    mutex_unlock(&_peers_mutex);
+}
+
+bool gnrc_sixlowpan_ghc_use(const gnrc_netif_t *netif,
+                            const gnrc_netif_hdr_t *hdr)
+{
+    bool res;
+
+    if (!(netif->flags & GNRC_NETIF_FLAGS_6LO_GHC)) {
+        return false;
+    }
+    if (hdr->flags &
+        (GNRC_NETIF_HDR_FLAGS_BROADCAST | GNRC_NETIF_HDR_FLAGS_MULTICAST)) {
+        return GNRC_SIXLOWPAN_GHC_MULTICAST;
+    }
+    mutex_lock(&_peers_mutex);
+    res = (_peer_get(netif->pid, gnrc_netif_hdr_get_dst_addr(hdr),
+                     hdr->dst_l2addr_len) != NULL);
+    mutex_unlock(&_peers_mutex);
+    return res;
+}
+
+/** @} */
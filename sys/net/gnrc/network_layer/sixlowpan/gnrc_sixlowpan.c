@@ -17,19 +17,31 @@
 #include "thread.h"
 #include "utlist.h"
 
+#ifdef MODULE_GNRC_EVENTLOOP
+#include "net/gnrc/eventloop.h"
+#endif
 #include "net/gnrc/ipv6/hdr.h"
 #include "net/gnrc/sixlowpan.h"
 #include "net/gnrc/sixlowpan/frag.h"
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+#include "net/gnrc/sixlowpan/frag/sfr.h"
+#endif
 #include "net/gnrc/sixlowpan/iphc.h"
 #include "net/gnrc/netif.h"
 #include "net/sixlowpan.h"
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+#include "net/sixlowpan/sfr.h"
+#endif
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
 static kernel_pid_t _pid = KERNEL_PID_UNDEF;
 
-#if ENABLE_DEBUG
+#ifdef MODULE_GNRC_EVENTLOOP
+static gnrc_eventloop_layer_t _layer;
+static msg_t _layer_queue[GNRC_SIXLOWPAN_MSG_QUEUE_SIZE];
+#elif ENABLE_DEBUG
 static char _stack[GNRC_SIXLOWPAN_STACK_SIZE + THREAD_EXTRA_STACKSIZE_PRINTF];
 #else
 static char _stack[GNRC_SIXLOWPAN_STACK_SIZE];
@@ -40,8 +52,15 @@ static char _stack[GNRC_SIXLOWPAN_STACK_SIZE];
 static void _receive(gnrc_pktsnip_t *pkt);
 /* handles GNRC_NETAPI_MSG_TYPE_SND commands */
 static void _send(gnrc_pktsnip_t *pkt);
+/* handles messages to 6LoWPAN */
+static void _handle_msg(msg_t *msg);
+#ifdef MODULE_GNRC_EVENTLOOP
+/* registry entry of 6LoWPAN in the shared thread */
+static gnrc_netreg_entry_t _me_reg;
+#else
 /* Main event loop for 6LoWPAN */
 static void *_event_loop(void *args);
+#endif
 
 kernel_pid_t gnrc_sixlowpan_init(void)
 {
@@ -49,8 +68,18 @@ kernel_pid_t gnrc_sixlowpan_init(void)
         return _pid;
     }
 
+#ifdef MODULE_GNRC_EVENTLOOP
+    _pid = gnrc_eventloop_init();
+    gnrc_eventloop_register(&_layer, _layer_queue,
+                            GNRC_SIXLOWPAN_MSG_QUEUE_SIZE, _handle_msg,
+                            GNRC_SIXLOWPAN_MSG_FRAG_SND,
+                            GNRC_SIXLOWPAN_MSG_FRAG_SFR_TIMER);
+    /* register interest in all 6LoWPAN packets */
+    gnrc_netreg_register(GNRC_NETTYPE_SIXLOWPAN, &_me_reg);
+#else
     _pid = thread_create(_stack, sizeof(_stack), GNRC_SIXLOWPAN_PRIO,
                          THREAD_CREATE_STACKTEST, _event_loop, NULL, "6lo");
+#endif
 
     return _pid;
 }
@@ -116,7 +145,25 @@ void gnrc_sixlowpan_multiplex_by_size(gnrc_pktsnip_t *pkt,
         DEBUG("6lo: Dispatch for sending\n");
         gnrc_sixlowpan_dispatch_send(pkt, NULL, page);
     }
-#ifdef MODULE_GNRC_SIXLOWPAN_FRAG
+#if defined(MODULE_GNRC_SIXLOWPAN_FRAG_SFR)
+    else if ((orig_datagram_size <= UINT16_MAX) &&
+             gnrc_sixlowpan_frag_sfr_use(netif, pkt->data)) {
+        DEBUG("6lo: Send with SFR (%u > %u)\n",
+              (unsigned int)datagram_size, netif->sixlo.max_frag_size);
+        gnrc_sixlowpan_frag_sfr_fb_t *fb = gnrc_sixlowpan_frag_sfr_fb_get();
+
+        if (fb == NULL) {
+            DEBUG("6lo: Not enough resources to fragment packet. "
+                  "Dropping packet\n");
+            gnrc_pktbuf_release_error(pkt, ENOMEM);
+            return;
+        }
+        fb->pkt = pkt;
+        fb->datagram_size = orig_datagram_size;
+        gnrc_sixlowpan_frag_sfr_send(pkt, fb, page);
+    }
+#endif
+#if defined(MODULE_GNRC_SIXLOWPAN_FRAG)
     else if (orig_datagram_size <= SIXLOWPAN_FRAG_MAX_LEN) {
         DEBUG("6lo: Send fragmented (%u > %u)\n",
               (unsigned int)datagram_size, netif->sixlo.max_frag_size);
@@ -218,6 +265,13 @@ static void _receive(gnrc_pktsnip_t *pkt)
         return;
     }
 #endif
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+    else if (sixlowpan_sfr_is((sixlowpan_sfr_t *)dispatch)) {
+        DEBUG("6lo: received 6LoWPAN recoverable fragment\n");
+        gnrc_sixlowpan_frag_sfr_recv(pkt, NULL, 0);
+        return;
+    }
+#endif
 #ifdef MODULE_GNRC_SIXLOWPAN_IPHC
     else if (sixlowpan_iphc_is(dispatch)) {
         DEBUG("6lo: received 6LoWPAN IPHC comressed datagram\n");
@@ -305,11 +359,85 @@ static void _send(gnrc_pktsnip_t *pkt)
     gnrc_sixlowpan_multiplex_by_size(pkt, datagram_size, netif, 0);
 }
 
+#if defined(MODULE_GNRC_NETAPI_DIRECT) && !defined(MODULE_GNRC_SIXLOWPAN_FRAG)
+static void _direct(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx)
+{
+    (void)ctx;
+    switch (cmd) {
+        case GNRC_NETAPI_MSG_TYPE_RCV:
+            DEBUG("6lo: direct GNRC_NETAPI_MSG_TYPE_RCV\n");
+            _receive(pkt);
+            break;
+        case GNRC_NETAPI_MSG_TYPE_SND:
+            DEBUG("6lo: direct GNRC_NETAPI_MSG_TYPE_SND\n");
+            _send(pkt);
+            break;
+        default:
+            gnrc_pktbuf_release(pkt);
+            break;
+    }
+}
+
+static gnrc_netreg_entry_cbd_t _direct_cbd = { .cb = _direct };
+#endif
+
+static void _handle_msg(msg_t *msg)
+{
+    switch (msg->type) {
+        case GNRC_NETAPI_MSG_TYPE_RCV:
+            DEBUG("6lo: GNRC_NETDEV_MSG_TYPE_RCV received\n");
+            _receive(msg->content.ptr);
+            break;
+
+        case GNRC_NETAPI_MSG_TYPE_SND:
+            DEBUG("6lo: GNRC_NETDEV_MSG_TYPE_SND received\n");
+            _send(msg->content.ptr);
+            break;
+
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG
+        case GNRC_SIXLOWPAN_MSG_FRAG_SND:
+            DEBUG("6lo: send fragmented event received\n");
+            gnrc_sixlowpan_frag_send(NULL, msg->content.ptr, 0);
+            break;
+        case GNRC_SIXLOWPAN_MSG_FRAG_GC_RBUF:
+            DEBUG("6lo: garbage collect reassembly buffer event received\n");
+            gnrc_sixlowpan_frag_rbuf_gc();
+            break;
+#endif
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+        case GNRC_SIXLOWPAN_MSG_FRAG_SFR_TIMER:
+            DEBUG("6lo: SFR timer event received\n");
+            gnrc_sixlowpan_frag_sfr_timeout(msg->content.ptr);
+            break;
+#endif
+
+        default:
+            DEBUG("6lo: operation not supported\n");
+            break;
+    }
+}
+
+#ifdef MODULE_GNRC_EVENTLOOP
+#if defined(MODULE_GNRC_NETAPI_DIRECT) && !defined(MODULE_GNRC_SIXLOWPAN_FRAG)
+static gnrc_netreg_entry_t _me_reg = GNRC_NETREG_ENTRY_INIT_CB(GNRC_NETREG_DEMUX_CTX_ALL,
+                                                               &_direct_cbd);
+#else
+static gnrc_netreg_entry_t _me_reg = GNRC_NETREG_ENTRY_INIT_CB(GNRC_NETREG_DEMUX_CTX_ALL,
+                                                               &_layer.cbd);
+#endif
+#else   /* MODULE_GNRC_EVENTLOOP */
 static void *_event_loop(void *args)
 {
     msg_t msg, reply, msg_q[GNRC_SIXLOWPAN_MSG_QUEUE_SIZE];
+#if defined(MODULE_GNRC_NETAPI_DIRECT) && !defined(MODULE_GNRC_SIXLOWPAN_FRAG)
+    /* fragmentation state is only accessed by the 6LoWPAN thread, so packets
+     * are only handled directly without fragmentation */
+    gnrc_netreg_entry_t me_reg = GNRC_NETREG_ENTRY_INIT_CB(GNRC_NETREG_DEMUX_CTX_ALL,
+                                                           &_direct_cbd);
+#else
     gnrc_netreg_entry_t me_reg = GNRC_NETREG_ENTRY_INIT_PID(GNRC_NETREG_DEMUX_CTX_ALL,
                                                             sched_active_pid);
+#endif
 
     (void)args;
     msg_init_queue(msg_q, GNRC_SIXLOWPAN_MSG_QUEUE_SIZE);
@@ -326,40 +454,20 @@ static void *_event_loop(void *args)
         msg_receive(&msg);
 
         switch (msg.type) {
-            case GNRC_NETAPI_MSG_TYPE_RCV:
-                DEBUG("6lo: GNRC_NETDEV_MSG_TYPE_RCV received\n");
-                _receive(msg.content.ptr);
-                break;
-
-            case GNRC_NETAPI_MSG_TYPE_SND:
-                DEBUG("6lo: GNRC_NETDEV_MSG_TYPE_SND received\n");
-                _send(msg.content.ptr);
-                break;
-
             case GNRC_NETAPI_MSG_TYPE_GET:
             case GNRC_NETAPI_MSG_TYPE_SET:
                 DEBUG("6lo: reply to unsupported get/set\n");
                 reply.content.value = -ENOTSUP;
                 msg_reply(&msg, &reply);
                 break;
-#ifdef MODULE_GNRC_SIXLOWPAN_FRAG
-            case GNRC_SIXLOWPAN_MSG_FRAG_SND:
-                DEBUG("6lo: send fragmented event received\n");
-                gnrc_sixlowpan_frag_send(NULL, msg.content.ptr, 0);
-                break;
-            case GNRC_SIXLOWPAN_MSG_FRAG_GC_RBUF:
-                DEBUG("6lo: garbage collect reassembly buffer event received\n");
-                gnrc_sixlowpan_frag_rbuf_gc();
-                break;
-#endif
-
             default:
-                DEBUG("6lo: operation not supported\n");
+                _handle_msg(&msg);
                 break;
         }
     }
 
     return NULL;
 }
+#endif  /* MODULE_GNRC_EVENTLOOP */
 
 /** @} */
@@ -25,6 +25,14 @@
 #include "net/gnrc/sixlowpan.h"
 #include "net/gnrc/sixlowpan/ctx.h"
 #include "net/gnrc/sixlowpan/frag.h"
+#ifdef MODULE_GNRC_SIXLOWPAN_GHC
+#include "net/gnrc/sixlowpan/config.h"
+#include "net/gnrc/sixlowpan/ghc.h"
+#endif
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+#include "net/gnrc/ipv6/nib.h"
+#include "net/gnrc/sixlowpan/frag/vrb.h"
+#endif
 #include "net/gnrc/sixlowpan/internal.h"
 #include "net/sixlowpan.h"
 #include "utlist.h"
@@ -216,6 +224,113 @@ static size_t _iphc_nhc_udp_decode(gnrc_pktsnip_t *sixlo, size_t offset,
 }
 #endif
 
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+static bool _iphc_encode(gnrc_pktsnip_t *pkt);
+
+/* forwards the first fragment of the datagram in `rbuf` directly to the next
+ * hop and creates a virtual reassembly buffer entry for the subsequent
+ * fragments. `frag_size` is the uncompressed size of the first fragment.
+ * Returns false if the datagram needs to be reassembled */
+static bool _vrb_forward_1st_frag(gnrc_sixlowpan_rbuf_t *rbuf, size_t frag_size)
+{
+    gnrc_sixlowpan_frag_vrb_t *vrbe;
+    gnrc_pktsnip_t *pkt, *frag;
+    gnrc_netif_hdr_t *netif_hdr;
+    gnrc_netif_t *out_netif;
+    gnrc_ipv6_nib_nc_t nce;
+    ipv6_hdr_t *ipv6_hdr = rbuf->pkt->data;
+    sixlowpan_frag_t *frag_hdr;
+    size_t payload_len = frag_size - sizeof(ipv6_hdr_t);
+
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+    if (rbuf->sfr_received != 0) {
+        /* RFRAGs are acknowledged by the reassembling node, so they are
+         * always reassembled */
+        return false;
+    }
+#endif
+    if ((rbuf->super.current_size != frag_size) ||
+        (frag_size >= rbuf->super.datagram_size) ||
+        (payload_len == 0) ||
+        ((ipv6_hdr->nh == PROTNUM_UDP) && (payload_len < sizeof(udp_hdr_t)))) {
+        /* other fragments arrived before the first or the first fragment
+         * contains less than the headers to recompress */
+        return false;
+    }
+    /* leave everything for IPv6 that is for this node, not forwarded, or
+     * requires an ICMPv6 error message */
+    if ((ipv6_hdr->hl <= 1) || ipv6_addr_is_multicast(&ipv6_hdr->dst) ||
+        ipv6_addr_is_link_local(&ipv6_hdr->dst) ||
+        (gnrc_netif_get_by_ipv6_addr(&ipv6_hdr->dst) != NULL) ||
+        (gnrc_ipv6_nib_get_next_hop_l2addr(&ipv6_hdr->dst, NULL, NULL,
+                                           &nce) < 0)) {
+        return false;
+    }
+    out_netif = gnrc_netif_get_by_pid(gnrc_ipv6_nib_nc_get_iface(&nce));
+    if ((out_netif == NULL) || !gnrc_netif_is_6ln(out_netif)) {
+        return false;
+    }
+    /* build a copy of the first fragment with the hop limit decremented and
+     * recompress it for the next hop */
+    pkt = gnrc_pktbuf_add(NULL, ipv6_hdr + 1, payload_len, GNRC_NETTYPE_UNDEF);
+    if (pkt == NULL) {
+        return false;
+    }
+    frag = gnrc_pktbuf_add(pkt, ipv6_hdr, sizeof(ipv6_hdr_t),
+                           GNRC_NETTYPE_IPV6);
+    if (frag == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return false;
+    }
+    pkt = frag;
+    ((ipv6_hdr_t *)pkt->data)->hl--;
+    frag = gnrc_netif_hdr_build(NULL, 0, nce.l2addr, nce.l2addr_len);
+    if (frag == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return false;
+    }
+    frag->next = pkt;
+    pkt = frag;
+    netif_hdr = pkt->data;
+    netif_hdr->if_pid = out_netif->pid;
+    netif_hdr->flags |= GNRC_NETIF_HDR_FLAGS_MORE_DATA;
+    if (!_iphc_encode(pkt)) {
+        return false;
+    }
+    if ((out_netif->sixlo.max_frag_size > 0) &&
+        ((gnrc_pkt_len(pkt->next) + sizeof(sixlowpan_frag_t)) >
+         out_netif->sixlo.max_frag_size)) {
+        DEBUG("6lo iphc: recompressed first fragment too big for next hop\n");
+        gnrc_pktbuf_release(pkt);
+        return false;
+    }
+    if ((vrbe = gnrc_sixlowpan_frag_vrb_add(&rbuf->super, out_netif,
+                                            nce.l2addr,
+                                            nce.l2addr_len)) == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return false;
+    }
+    frag = gnrc_pktbuf_add(pkt->next, NULL, sizeof(sixlowpan_frag_t),
+                           GNRC_NETTYPE_SIXLOWPAN);
+    if (frag == NULL) {
+        gnrc_sixlowpan_frag_vrb_rm(vrbe);
+        gnrc_pktbuf_release(pkt);
+        return false;
+    }
+    pkt->next = frag;
+    frag_hdr = frag->data;
+    frag_hdr->disp_size = byteorder_htons(rbuf->super.datagram_size);
+    frag_hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_1_DISP;
+    frag_hdr->tag = byteorder_htons(vrbe->out_tag);
+    vrbe->super.current_size = frag_size;
+    DEBUG("6lo iphc: forward first fragment (datagram size: %u, "
+          "fragment size: %u)\n", (unsigned)rbuf->super.datagram_size,
+          (unsigned)frag_size);
+    gnrc_sixlowpan_dispatch_send(pkt, NULL, 0);
+    return true;
+}
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_VRB */
+
 static inline void _recv_error_release(gnrc_pktsnip_t *sixlo,
                                        gnrc_pktsnip_t *ipv6,
                                        gnrc_sixlowpan_rbuf_t *rbuf) {
@@ -226,6 +341,48 @@ static inline void _recv_error_release(gnrc_pktsnip_t *sixlo,
     gnrc_pktbuf_release(sixlo);
 }
 
+#ifdef MODULE_GNRC_SIXLOWPAN_GHC
+/* decompresses the GHC-compressed upper layer at `offset` of `sixlo` into
+ * `ipv6` and dispatches the resulting datagram */
+static void _iphc_ghc_decode(gnrc_pktsnip_t *sixlo, size_t offset,
+                             gnrc_pktsnip_t *ipv6, gnrc_sixlowpan_rbuf_t *rbuf,
+                             gnrc_pktsnip_t *netif, unsigned page)
+{
+    uint8_t dict[SIXLOWPAN_GHC_DICT_LEN];
+    uint8_t *payload = sixlo->data;
+    ipv6_hdr_t *ipv6_hdr = ipv6->data;
+    uint8_t nhc = payload[offset++];
+    int res;
+
+    if (rbuf != NULL) {
+        /* GHC is only sent in datagrams that fit into a single frame */
+        DEBUG("6lo iphc: GHC in fragmented datagram not supported\n");
+        _recv_error_release(sixlo, ipv6, rbuf);
+        return;
+    }
+    sixlowpan_ghc_dict_init(dict, &ipv6_hdr->src, &ipv6_hdr->dst);
+    res = sixlowpan_ghc_decompress(NULL, 0, &payload[offset],
+                                   sixlo->size - offset, dict);
+    if ((res < 0) || (res > UINT16_MAX) ||
+        (gnrc_pktbuf_realloc_data(ipv6, sizeof(ipv6_hdr_t) + res) != 0)) {
+        DEBUG("6lo iphc: unable to decompress GHC\n");
+        _recv_error_release(sixlo, ipv6, rbuf);
+        return;
+    }
+    /* re-assign IPv6 header in case realloc changed the address */
+    ipv6_hdr = ipv6->data;
+    sixlowpan_ghc_decompress((uint8_t *)(ipv6_hdr + 1), res, &payload[offset],
+                             sixlo->size - offset, dict);
+    ipv6_hdr->nh = (nhc == SIXLOWPAN_GHC_NHC_UDP) ? PROTNUM_UDP
+                                                  : PROTNUM_ICMPV6;
+    ipv6_hdr->len = byteorder_htons((uint16_t)res);
+    LL_DELETE(sixlo, netif);
+    LL_APPEND(ipv6, netif);
+    gnrc_sixlowpan_dispatch_recv(ipv6, NULL, page);
+    gnrc_pktbuf_release(sixlo);
+}
+#endif
+
 void gnrc_sixlowpan_iphc_recv(gnrc_pktsnip_t *sixlo, void *rbuf_ptr,
                               unsigned page)
 {
@@ -539,7 +696,14 @@ void gnrc_sixlowpan_iphc_recv(gnrc_pktsnip_t *sixlo, void *rbuf_ptr,
             break;
     }
 
-
+#ifdef MODULE_GNRC_SIXLOWPAN_GHC
+    if ((iphc_hdr[IPHC1_IDX] & SIXLOWPAN_IPHC1_NH) &&
+        (payload_offset < sixlo->size) &&
+        sixlowpan_ghc_nhc_is(iphc_hdr[payload_offset])) {
+        _iphc_ghc_decode(sixlo, payload_offset, ipv6, rbuf, netif, page);
+        return;
+    }
+#endif
 #ifdef MODULE_GNRC_SIXLOWPAN_IPHC_NHC
     if (iphc_hdr[IPHC1_IDX] & SIXLOWPAN_IPHC1_NH) {
         switch (iphc_hdr[payload_offset] & NHC_ID_MASK) {
@@ -582,6 +746,16 @@ void gnrc_sixlowpan_iphc_recv(gnrc_pktsnip_t *sixlo, void *rbuf_ptr,
            sixlo->size - payload_offset);
     if (rbuf != NULL) {
         rbuf->super.current_size += (uncomp_hdr_len - payload_offset);
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+        if (_vrb_forward_1st_frag(rbuf, uncomp_hdr_len +
+                                        sixlo->size - payload_offset)) {
+            /* no need to reassemble the datagram anymore */
+            gnrc_pktbuf_release(rbuf->pkt);
+            gnrc_sixlowpan_frag_rbuf_remove(rbuf);
+            gnrc_pktbuf_release(sixlo);
+            return;
+        }
+#endif
         gnrc_sixlowpan_frag_rbuf_dispatch_when_complete(rbuf, netif_hdr);
     }
     else {
@@ -644,6 +818,80 @@ static inline size_t iphc_nhc_udp_encode(uint8_t *nhc_data,
 }
 #endif
 
+#ifdef MODULE_GNRC_SIXLOWPAN_GHC
+/* worst case length of the IPHC header with compressed next header:
+ * dispatch, CID extension, traffic class and flow label, hop limit and both
+ * addresses inline */
+#define IPHC_HDR_LEN_MAX    (SIXLOWPAN_IPHC_HDR_LEN + \
+                             SIXLOWPAN_IPHC_CID_EXT_LEN + 4U + 1U + \
+                             (2 * sizeof(ipv6_addr_t)))
+
+/* compresses the upper-layer header and payload of the IPv6 datagram in
+ * `pkt` with GHC. Returns NULL if GHC is not to be used for `pkt` or if the
+ * result is not shorter than the common NHC encoding or does not fit into a
+ * single frame */
+static gnrc_pktsnip_t *_iphc_ghc_encode(gnrc_pktsnip_t *pkt,
+                                        gnrc_netif_t *iface)
+{
+    static uint8_t ul_buf[GNRC_SIXLOWPAN_GHC_MAX_LEN];
+    uint8_t dict[SIXLOWPAN_GHC_DICT_LEN];
+    gnrc_pktsnip_t *ipv6 = pkt->next, *ghc;
+    ipv6_hdr_t *ipv6_hdr = ipv6->data;
+    size_t ul_len = gnrc_pkt_len(ipv6->next), pos = 0;
+    int max_len = (int)iface->sixlo.max_frag_size - IPHC_HDR_LEN_MAX - 1;
+    int res;
+
+    if ((ipv6->type != GNRC_NETTYPE_IPV6) ||
+        (ipv6->size != sizeof(ipv6_hdr_t)) ||
+        ((ipv6_hdr->nh != PROTNUM_UDP) && (ipv6_hdr->nh != PROTNUM_ICMPV6)) ||
+        (ul_len == 0) || (ul_len > sizeof(ul_buf)) ||
+        !gnrc_sixlowpan_ghc_use(iface, pkt->data)) {
+        return NULL;
+    }
+    if (ipv6_hdr->nh == PROTNUM_UDP) {
+        /* UDP NHC ID, ports inline and checksum */
+        uint8_t nhc_data[1 + 2 * sizeof(network_uint16_t) +
+                         sizeof(network_uint16_t)];
+
+        if (ipv6->next->size < sizeof(udp_hdr_t)) {
+            return NULL;
+        }
+        /* GHC NHC ID + GHC needs to be shorter than UDP NHC + payload */
+        res = (int)iphc_nhc_udp_encode(nhc_data, ipv6->next) +
+              (int)(ul_len - sizeof(udp_hdr_t)) - 2;
+    }
+    else {
+        /* GHC NHC ID + GHC needs to be shorter than inline NH + ICMPv6 */
+        res = (int)ul_len - 1;
+    }
+    if (res < max_len) {
+        max_len = res;
+    }
+    if (max_len <= 0) {
+        return NULL;
+    }
+    for (gnrc_pktsnip_t *ptr = ipv6->next; ptr != NULL; ptr = ptr->next) {
+        memcpy(&ul_buf[pos], ptr->data, ptr->size);
+        pos += ptr->size;
+    }
+    ghc = gnrc_pktbuf_add(NULL, NULL, max_len, GNRC_NETTYPE_SIXLOWPAN);
+    if (ghc == NULL) {
+        DEBUG("6lo iphc: unable to allocate GHC space\n");
+        return NULL;
+    }
+    sixlowpan_ghc_dict_init(dict, &ipv6_hdr->src, &ipv6_hdr->dst);
+    res = sixlowpan_ghc_compress(ghc->data, max_len, ul_buf, ul_len, dict);
+    if (res < 0) {
+        DEBUG("6lo iphc: GHC does not reduce size\n");
+        gnrc_pktbuf_release(ghc);
+        return NULL;
+    }
+    /* NOTE: Since this only shrinks the data nothing bad SHOULD happen ;-) */
+    gnrc_pktbuf_realloc_data(ghc, res);
+    return ghc;
+}
+#endif
+
 static inline bool _compressible(gnrc_pktsnip_t *hdr)
 {
     switch (hdr->type) {
@@ -658,7 +906,20 @@ static inline bool _compressible(gnrc_pktsnip_t *hdr)
     }
 }
 
-void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
+/* releases `pkt` with the dispatch and GHC snips that were allocated for its
+ * IPHC representation but are not part of it yet */
+static inline void _encode_error_release(gnrc_pktsnip_t *pkt,
+                                         gnrc_pktsnip_t *dispatch,
+                                         gnrc_pktsnip_t *ghc)
+{
+    gnrc_pktbuf_release(ghc);
+    gnrc_pktbuf_release(dispatch);
+    gnrc_pktbuf_release(pkt);
+}
+
+/* replaces the compressible headers following the netif header `pkt` with
+ * their IPHC representation. Returns false if `pkt` was dropped */
+static bool _iphc_encode(gnrc_pktsnip_t *pkt)
 {
     assert(pkt != NULL);
     gnrc_netif_hdr_t *netif_hdr = pkt->data;
@@ -667,13 +928,11 @@ void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
     uint8_t *iphc_hdr;
     gnrc_sixlowpan_ctx_t *src_ctx = NULL, *dst_ctx = NULL;
     gnrc_pktsnip_t *dispatch, *ptr = pkt->next;
+    gnrc_pktsnip_t *ghc = NULL;
     bool addr_comp = false;
     size_t dispatch_size = 0;
-    /* datagram size before compression */
-    size_t orig_datagram_size = gnrc_pkt_len(pkt->next);
     uint16_t inline_pos = SIXLOWPAN_IPHC_HDR_LEN;
 
-    (void)ctx;
     dispatch = NULL;    /* use dispatch as temporary pointer for prev */
     /* determine maximum dispatch size and write protect all headers until
      * then because they will be removed */
@@ -685,7 +944,7 @@ void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
             if (addr_comp) {    /* addr_comp was used as release indicator */
                 gnrc_pktbuf_release(pkt);
             }
-            return;
+            return false;
         }
         ptr = tmp;
         if (dispatch == NULL) {
@@ -713,13 +972,20 @@ void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
      * function should not be called */
     assert(dispatch_size > 0);
     ipv6_hdr = pkt->next->data;
+#ifdef MODULE_GNRC_SIXLOWPAN_GHC
+    ghc = _iphc_ghc_encode(pkt, iface);
+    if (ghc != NULL) {
+        /* GHC NHC ID */
+        dispatch_size++;
+    }
+#endif
     dispatch = gnrc_pktbuf_add(NULL, NULL, dispatch_size,
                                GNRC_NETTYPE_SIXLOWPAN);
 
     if (dispatch == NULL) {
         DEBUG("6lo iphc: error allocating dispatch space\n");
-        gnrc_pktbuf_release(pkt);
-        return;
+        _encode_error_release(pkt, NULL, ghc);
+        return false;
     }
 
     iphc_hdr = dispatch->data;
@@ -801,6 +1067,13 @@ void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
 #endif
 
         default:
+#ifdef MODULE_GNRC_SIXLOWPAN_GHC
+            if (ghc != NULL) {
+                /* ICMPv6 is compressed with GHC */
+                iphc_hdr[IPHC1_IDX] |= SIXLOWPAN_IPHC1_NH;
+                break;
+            }
+#endif
             iphc_hdr[inline_pos++] = ipv6_hdr->nh;
             break;
     }
@@ -846,8 +1119,8 @@ void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
             if (gnrc_netif_ipv6_get_iid(iface, &iid) < 0) {
                 DEBUG("6lo iphc: could not get interface's IID\n");
                 gnrc_netif_release(iface);
-                gnrc_pktbuf_release(pkt);
-                return;
+                _encode_error_release(pkt, dispatch, ghc);
+                return false;
             }
             gnrc_netif_release(iface);
 
@@ -965,8 +1238,8 @@ void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
 
         if (gnrc_netif_hdr_ipv6_iid_from_dst(iface, netif_hdr, &iid) < 0) {
             DEBUG("6lo iphc: could not get destination's IID\n");
-            gnrc_pktbuf_release(pkt);
-            return;
+            _encode_error_release(pkt, dispatch, ghc);
+            return false;
         }
 
         if ((ipv6_hdr->dst.u64[1].u64 == iid.uint64.u64) ||
@@ -1000,6 +1273,19 @@ void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
     }
 
 #ifdef MODULE_GNRC_SIXLOWPAN_IPHC_NHC
+#ifdef MODULE_GNRC_SIXLOWPAN_GHC
+    if (ghc != NULL) {
+        gnrc_pktsnip_t *ul = pkt->next->next;
+
+        iphc_hdr[inline_pos++] = (ipv6_hdr->nh == PROTNUM_UDP)
+                               ? SIXLOWPAN_GHC_NHC_UDP
+                               : SIXLOWPAN_GHC_NHC_ICMPV6;
+        /* replace upper layer with its GHC representation */
+        pkt->next->next = ghc;
+        gnrc_pktbuf_release(ul);
+    }
+    else
+#endif
     switch (ipv6_hdr->nh) {
         case PROTNUM_UDP: {
             gnrc_pktsnip_t *udp = pkt->next->next;
@@ -1013,8 +1299,8 @@ void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
 
                 if (udp == NULL) {
                     DEBUG("gnrc_sixlowpan_iphc_encode: unable to mark UDP header\n");
-                    gnrc_pktbuf_release(dispatch);
-                    return;
+                    _encode_error_release(pkt, dispatch, ghc);
+                    return false;
                 }
             }
             gnrc_pktbuf_remove_snip(pkt, udp);
@@ -1035,10 +1321,21 @@ void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
     /* insert dispatch into packet */
     dispatch->next = pkt->next;
     pkt->next = dispatch;
+    return true;
+}
 
-    gnrc_netif_t *netif = gnrc_netif_hdr_get_netif(netif_hdr);
-    assert(netif != NULL);
-    gnrc_sixlowpan_multiplex_by_size(pkt, orig_datagram_size, netif, page);
+void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
+{
+    assert(pkt != NULL);
+    gnrc_netif_t *netif = gnrc_netif_hdr_get_netif(pkt->data);
+    /* datagram size before compression */
+    size_t orig_datagram_size = gnrc_pkt_len(pkt->next);
+
+    (void)ctx;
+    if (_iphc_encode(pkt)) {
+        assert(netif != NULL);
+        gnrc_sixlowpan_multiplex_by_size(pkt, orig_datagram_size, netif, page);
+    }
 }
 
 /** @} */
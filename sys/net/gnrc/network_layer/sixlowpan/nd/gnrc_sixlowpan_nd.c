@@ -81,4 +81,17 @@ gnrc_pktsnip_t *gnrc_sixlowpan_nd_opt_abr_build(uint32_t version, uint16_t ltime
     return pkt;
 }
 
+gnrc_pktsnip_t *gnrc_sixlowpan_nd_opt_6cio_build(uint16_t flags, gnrc_pktsnip_t *next)
+{
+    gnrc_pktsnip_t *pkt = gnrc_ndp_opt_build(NDP_OPT_6CIO, sizeof(sixlowpan_nd_opt_6cio_t), next);
+
+    if (pkt != NULL) {
+        sixlowpan_nd_opt_6cio_t *cio_opt = pkt->data;
+        cio_opt->resv_flags = byteorder_htons(flags);
+        cio_opt->resv.u32 = 0;
+    }
+
+    return pkt;
+}
+
 /** @} */
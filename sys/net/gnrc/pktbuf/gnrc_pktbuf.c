@@ -15,6 +15,13 @@
 
 #include "net/gnrc/pktbuf.h"
 
+#include "pktbuf_internal.h"
+
+#ifdef MODULE_NETSTATS_PKTBUF
+netstats_pktbuf_t gnrc_pktbuf_netstats;
+uint32_t gnrc_pktbuf_lock_start;
+#endif
+
 gnrc_pktsnip_t *gnrc_pktbuf_remove_snip(gnrc_pktsnip_t *pkt,
                                         gnrc_pktsnip_t *snip)
 {
@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup net_gnrc_pktbuf
+ * @{
+ *
+ * @file
+ * @brief   Internal definitions shared by the packet buffer implementations
+ *
+ * @author  Martine Lenders <m.lenders@fu-berlin.de>
+ */
+#ifndef PKTBUF_INTERNAL_H
+#define PKTBUF_INTERNAL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "mutex.h"
+#include "net/gnrc/pktbuf.h"
+#ifdef MODULE_NETSTATS_PKTBUF
+#include "bitarithm.h"
+#include "xtimer.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(MODULE_NETSTATS_PKTBUF) || defined(DOXYGEN)
+/**
+ * @brief   Counters of the packet buffer statistics
+ *
+ * @note    Only the counters are kept here, the momentary values are filled
+ *          in by gnrc_pktbuf_netstats_get() of the implementation.
+ */
+extern netstats_pktbuf_t gnrc_pktbuf_netstats;
+
+/**
+ * @brief   Time the packet buffer mutex was last taken in microseconds
+ */
+extern uint32_t gnrc_pktbuf_lock_start;
+#endif
+
+/**
+ * @brief   Locks the packet buffer mutex of an implementation
+ *
+ * @param[in] mutex The mutex of the implementation
+ */
+static inline void gnrc_pktbuf_lock(mutex_t *mutex)
+{
+    mutex_lock(mutex);
+#ifdef MODULE_NETSTATS_PKTBUF
+    gnrc_pktbuf_netstats.lock_count++;
+    gnrc_pktbuf_lock_start = xtimer_now_usec();
+#endif
+}
+
+/**
+ * @brief   Unlocks the packet buffer mutex of an implementation
+ *
+ * @param[in] mutex The mutex of the implementation
+ */
+static inline void gnrc_pktbuf_unlock(mutex_t *mutex)
+{
+#ifdef MODULE_NETSTATS_PKTBUF
+    gnrc_pktbuf_netstats.lock_time += xtimer_now_usec() - gnrc_pktbuf_lock_start;
+#endif
+    mutex_unlock(mutex);
+}
+
+/**
+ * @brief   Records a failed allocation
+ *
+ * @param[in] size  The requested size in bytes
+ */
+static inline void gnrc_pktbuf_netstats_alloc_fail(size_t size)
+{
+#ifdef MODULE_NETSTATS_PKTBUF
+    unsigned bin = 0;
+
+    if (size > NETSTATS_PKTBUF_FAIL_BIN0_SIZE) {
+        bin = bitarithm_msb(size - 1) - (bitarithm_msb(NETSTATS_PKTBUF_FAIL_BIN0_SIZE) - 1);
+        if (bin >= NETSTATS_PKTBUF_FAIL_BINS) {
+            bin = NETSTATS_PKTBUF_FAIL_BINS - 1;
+        }
+    }
+    gnrc_pktbuf_netstats.alloc_fails[bin]++;
+#else
+    (void)size;
+#endif
+}
+
+/**
+ * @brief   Records the number of bytes currently allocated
+ *
+ * @param[in] used  Number of bytes allocated in the packet buffer
+ */
+static inline void gnrc_pktbuf_netstats_used(size_t used)
+{
+#ifdef MODULE_NETSTATS_PKTBUF
+    if (used > gnrc_pktbuf_netstats.high_water) {
+        gnrc_pktbuf_netstats.high_water = used;
+    }
+#else
+    (void)used;
+#endif
+}
+
+/**
+ * @brief   Copies the counters of the packet buffer statistics
+ *
+ * @pre The mutex of the implementation is locked.
+ *
+ * @param[out] stats    The statistics
+ */
+static inline void gnrc_pktbuf_netstats_copy(netstats_pktbuf_t *stats)
+{
+#ifdef MODULE_NETSTATS_PKTBUF
+    *stats = gnrc_pktbuf_netstats;
+#else
+    memset(stats, 0, sizeof(netstats_pktbuf_t));
+#endif
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PKTBUF_INTERNAL_H */
+/** @} */
@@ -18,6 +18,7 @@
 #include <assert.h>
 #include <errno.h>
 #include <inttypes.h>
+#include <stdatomic.h>
 #include <stdbool.h>
 #include <string.h>
 #include <stdio.h>
@@ -33,31 +34,52 @@
 #include "net/gnrc/nettype.h"
 #include "net/gnrc/pkt.h"
 
+#include "pktbuf_internal.h"
+
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
 static mutex_t _mutex = MUTEX_INIT;
 
+/* number of bytes currently allocated, the allocator's own overhead is not
+ * known so only the requested sizes are counted */
+static size_t _used;
+
 #ifdef TEST_SUITES
 static unsigned mallocs;
+#endif
+
+static inline void _add_used(size_t size)
+{
+    _used += size;
+    gnrc_pktbuf_netstats_used(_used);
+}
 
 static inline void *_malloc(size_t size)
 {
+    void *ptr = malloc(size);
+
+    if (ptr == NULL) {
+        gnrc_pktbuf_netstats_alloc_fail(size);
+        return NULL;
+    }
+#ifdef TEST_SUITES
     mallocs++;
-    return malloc(size);
+#endif
+    _add_used(size);
+    return ptr;
 }
 
-static inline void _free(void *ptr)
+static inline void _free(void *ptr, size_t size)
 {
     if (ptr != NULL) {
+#ifdef TEST_SUITES
         mallocs--;
+#endif
+        _used -= size;
         free(ptr);
     }
 }
-#else
-#define _malloc(size)   malloc(size)
-#define _free(ptr)      free(ptr)
-#endif
 
 /* internal gnrc_pktbuf functions */
 static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, const void *data, size_t size,
@@ -81,6 +103,7 @@ void gnrc_pktbuf_init(void)
 #ifdef TEST_SUITES
     mallocs = 0;
 #endif
+    _used = 0;
 }
 
 gnrc_pktsnip_t *gnrc_pktbuf_add(gnrc_pktsnip_t *next, const void *data, size_t size,
@@ -88,14 +111,16 @@ gnrc_pktsnip_t *gnrc_pktbuf_add(gnrc_pktsnip_t *next, const void *data, size_t s
 {
     gnrc_pktsnip_t *pkt;
 
+    gnrc_pktbuf_lock(&_mutex);
     if (size > GNRC_PKTBUF_SIZE) {
         DEBUG("pktbuf: size (%u) > GNRC_PKTBUF_SIZE (%u)\n",
               (unsigned)size, GNRC_PKTBUF_SIZE);
+        gnrc_pktbuf_netstats_alloc_fail(size);
+        gnrc_pktbuf_unlock(&_mutex);
         return NULL;
     }
-    mutex_lock(&_mutex);
     pkt = _create_snip(next, data, size, type);
-    mutex_unlock(&_mutex);
+    gnrc_pktbuf_unlock(&_mutex);
     return pkt;
 }
 
@@ -127,17 +152,20 @@ static gnrc_pktsnip_t *_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_t ty
     payload = _malloc(pkt->size - size);
     if (payload == NULL) {
         DEBUG("pktbuf: could not reallocate marked section.\n");
-        _free(header);
+        _free(header, sizeof(gnrc_pktsnip_t));
         return NULL;
     }
     memcpy(payload, ((uint8_t *)pkt->data) + size, pkt->size - size);
     header_data = realloc(pkt->data, size);
     if (header_data == NULL) {
+        gnrc_pktbuf_netstats_alloc_fail(size);
         DEBUG("pktbuf: could not reallocate marked section.\n");
-        _free(payload);
-        _free(header);
+        _free(payload, pkt->size - size);
+        _free(header, sizeof(gnrc_pktsnip_t));
         return NULL;
     }
+    /* the payload moved out of the reallocated data */
+    _used -= pkt->size - size;
     pkt->data = payload;
     pkt->size -= size;
     _set_pktsnip(header, pkt->next, header_data, size, type);
@@ -149,9 +177,9 @@ gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_
 {
     gnrc_pktsnip_t *new;
 
-    mutex_lock(&_mutex);
+    gnrc_pktbuf_lock(&_mutex);
     new = _mark(pkt, size, type);
-    mutex_unlock(&_mutex);
+    gnrc_pktbuf_unlock(&_mutex);
     return new;
 }
 
@@ -168,15 +196,22 @@ static int _realloc_data(gnrc_pktsnip_t *pkt, size_t size)
     /* new size is 0 and data pointer isn't already NULL */
     if ((size == 0) && (pkt->data != NULL)) {
         /* set data pointer to NULL */
-        _free(pkt->data);
+        _free(pkt->data, pkt->size);
         pkt->data = NULL;
     }
     else {
         void *data = (pkt->data) ? realloc(pkt->data, size) : _malloc(size);
         if (data == NULL) {
+            if (pkt->data != NULL) {
+                gnrc_pktbuf_netstats_alloc_fail(size);
+            }
             DEBUG("pktbuf: error allocating new data section\n");
             return ENOMEM;
         }
+        if (pkt->data != NULL) {
+            _used -= pkt->size;
+            _add_used(size);
+        }
         pkt->data = data;
     }
     pkt->size = size;
@@ -187,68 +222,85 @@ int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
 {
     int res;
 
-    mutex_lock(&_mutex);
+    gnrc_pktbuf_lock(&_mutex);
     res = _realloc_data(pkt, size);
-    mutex_unlock(&_mutex);
+    gnrc_pktbuf_unlock(&_mutex);
     return res;
 }
 
 void gnrc_pktbuf_hold(gnrc_pktsnip_t *pkt, unsigned int num)
 {
-    mutex_lock(&_mutex);
     while (pkt) {
-        pkt->users += num;
+        atomic_fetch_add(&pkt->users, num);
         pkt = pkt->next;
     }
-    mutex_unlock(&_mutex);
 }
 
-static void _release_error_locked(gnrc_pktsnip_t *pkt, uint32_t err)
+void gnrc_pktbuf_release_error(gnrc_pktsnip_t *pkt, uint32_t err)
 {
+    bool locked = false;
+
     while (pkt) {
         gnrc_pktsnip_t *tmp;
+        assert(pkt->users > 0);
         tmp = pkt->next;
-        if (pkt->users == 1) {
-            pkt->users = 0; /* not necessary but to be on the safe side */
-            _free(pkt->data);
-            _free(pkt);
-        }
-        else {
-            pkt->users--;
-        }
         DEBUG("pktbuf: report status code %" PRIu32 "\n", err);
         gnrc_neterr_report(pkt, err);
+        /* only take the mutex when memory needs to be returned */
+        if (atomic_fetch_sub(&pkt->users, 1) == 1) {
+            if (!locked) {
+                gnrc_pktbuf_lock(&_mutex);
+                locked = true;
+            }
+            _free(pkt->data, pkt->size);
+            _free(pkt, sizeof(gnrc_pktsnip_t));
+        }
         pkt = tmp;
     }
-}
-
-void gnrc_pktbuf_release_error(gnrc_pktsnip_t *pkt, uint32_t err)
-{
-    mutex_lock(&_mutex);
-    _release_error_locked(pkt, err);
-    mutex_unlock(&_mutex);
+    if (locked) {
+        gnrc_pktbuf_unlock(&_mutex);
+    }
 }
 
 gnrc_pktsnip_t *gnrc_pktbuf_start_write(gnrc_pktsnip_t *pkt)
 {
-    mutex_lock(&_mutex);
+    gnrc_pktbuf_lock(&_mutex);
     if (pkt == NULL) {
-        mutex_unlock(&_mutex);
+        gnrc_pktbuf_unlock(&_mutex);
         return NULL;
     }
     if (pkt->users > 1) {
         gnrc_pktsnip_t *new;
         new = _create_snip(pkt->next, pkt->data, pkt->size, pkt->type);
-        if (new != NULL) {
-            pkt->users--;
+        /* other users might have released pkt in the meantime */
+        if ((new != NULL) && (atomic_fetch_sub(&pkt->users, 1) == 1)) {
+            _free(pkt->data, pkt->size);
+            _free(pkt, sizeof(gnrc_pktsnip_t));
         }
-        mutex_unlock(&_mutex);
+        gnrc_pktbuf_unlock(&_mutex);
         return new;
     }
-    mutex_unlock(&_mutex);
+    gnrc_pktbuf_unlock(&_mutex);
     return pkt;
 }
 
+bool gnrc_pktbuf_contains(const void *ptr)
+{
+    /* heap allocations can not be told apart */
+    (void)ptr;
+    return false;
+}
+
+void gnrc_pktbuf_netstats_get(netstats_pktbuf_t *stats)
+{
+    gnrc_pktbuf_lock(&_mutex);
+    /* the heap layout is not known to gnrc_pktbuf_malloc, so there are no
+     * free block statistics */
+    gnrc_pktbuf_netstats_copy(stats);
+    stats->used = _used;
+    gnrc_pktbuf_unlock(&_mutex);
+}
+
 #ifdef DEVELHELP
 void gnrc_pktbuf_stats(void)
 {
@@ -284,7 +336,7 @@ static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, const void *data, size
         _data = _malloc(size);
         if (_data == NULL) {
             DEBUG("pktbuf: error allocating data for new packet snip\n");
-            _free(pkt);
+            _free(pkt, sizeof(gnrc_pktsnip_t));
             return NULL;
         }
     }
@@ -0,0 +1,531 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup net_gnrc_pktbuf
+ * @{
+ *
+ * @file
+ * @brief   Packet buffer backed by a fixed-size pool for packet snips and
+ *          segregated size classes for packet data
+ *
+ * All allocations and releases are O(1): each pool is a @ref sys_memarray
+ * free list and the number of size classes is fixed at compile time.
+ * Since @ref gnrc_pktbuf_mark() may split the data of one slot over several
+ * snips, every data slot carries a reference counter and is only returned to
+ * its class when the last snip pointing into it is released.
+ *
+ * @author  Martine Lenders <m.lenders@fu-berlin.de>
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdio.h>
+#include <sys/types.h>
+
+#include "memarray.h"
+#include "mutex.h"
+#include "utlist.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/nettype.h"
+#include "net/gnrc/pkt.h"
+
+#include "pktbuf_internal.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+/**
+ * @brief   Alignment of data slots
+ */
+#define _ALIGNMENT          (sizeof(void *))
+
+/**
+ * @brief   Size of a data slot of a class
+ */
+#define _SLOT_SIZE(size)    (((size) + _ALIGNMENT - 1) & ~(_ALIGNMENT - 1))
+
+/**
+ * @brief   A data size class
+ */
+typedef struct {
+    memarray_t pool;        /**< free list of the class' slots */
+    uint8_t *buf;           /**< first slot of the class */
+    uint8_t *refs;          /**< number of snips referencing a slot */
+    uint16_t size;          /**< size of a slot in byte */
+    uint16_t numof;         /**< number of slots */
+    uint16_t used;          /**< number of slots currently in use */
+    uint16_t max_used;      /**< maximum of _class_t::used */
+} _class_t;
+
+#define _CLASS_BUF(n)   \
+    static uint8_t _class ## n ## _buf[_SLOT_SIZE(GNRC_PKTBUF_SLAB_CLASS ## n ## _SIZE) * \
+                                       GNRC_PKTBUF_SLAB_CLASS ## n ## _NUMOF] \
+    __attribute__((aligned(sizeof(void *)))); \
+    static uint8_t _class ## n ## _refs[GNRC_PKTBUF_SLAB_CLASS ## n ## _NUMOF]
+
+#define _CLASS_INIT(n) \
+    { .buf = _class ## n ## _buf, .refs = _class ## n ## _refs, \
+      .size = _SLOT_SIZE(GNRC_PKTBUF_SLAB_CLASS ## n ## _SIZE), \
+      .numof = GNRC_PKTBUF_SLAB_CLASS ## n ## _NUMOF }
+
+#if GNRC_PKTBUF_SLAB_CLASS0_NUMOF > 0
+_CLASS_BUF(0);
+#endif
+#if GNRC_PKTBUF_SLAB_CLASS1_NUMOF > 0
+_CLASS_BUF(1);
+#endif
+#if GNRC_PKTBUF_SLAB_CLASS2_NUMOF > 0
+_CLASS_BUF(2);
+#endif
+#if GNRC_PKTBUF_SLAB_CLASS3_NUMOF > 0
+_CLASS_BUF(3);
+#endif
+
+/* classes need to be ordered by size for best-fit allocation */
+static _class_t _classes[] = {
+#if GNRC_PKTBUF_SLAB_CLASS0_NUMOF > 0
+    _CLASS_INIT(0),
+#endif
+#if GNRC_PKTBUF_SLAB_CLASS1_NUMOF > 0
+    _CLASS_INIT(1),
+#endif
+#if GNRC_PKTBUF_SLAB_CLASS2_NUMOF > 0
+    _CLASS_INIT(2),
+#endif
+#if GNRC_PKTBUF_SLAB_CLASS3_NUMOF > 0
+    _CLASS_INIT(3),
+#endif
+};
+
+#define _CLASSES_NUMOF      (sizeof(_classes) / sizeof(_classes[0]))
+
+static mutex_t _mutex = MUTEX_INIT;
+static gnrc_pktsnip_t _snips[GNRC_PKTBUF_SLAB_SNIP_NUMOF];
+static memarray_t _snip_pool;
+static uint16_t _snips_used;
+static uint16_t _snips_max_used;
+/* number of bytes currently allocated */
+static size_t _used;
+
+/* internal gnrc_pktbuf functions */
+static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, const void *data, size_t size,
+                                    gnrc_nettype_t type);
+static void *_data_alloc(size_t size);
+static void _data_free(void *data);
+
+static inline bool _snip_contains(void *ptr)
+{
+    return (unsigned)((uint8_t *)ptr - (uint8_t *)_snips) < sizeof(_snips);
+}
+
+static inline _class_t *_class_of(void *ptr)
+{
+    for (unsigned i = 0; i < _CLASSES_NUMOF; i++) {
+        _class_t *class = &_classes[i];
+
+        if ((unsigned)((uint8_t *)ptr - class->buf) <
+            ((unsigned)class->size * class->numof)) {
+            return class;
+        }
+    }
+    return NULL;
+}
+
+static inline unsigned _slot_idx(const _class_t *class, void *ptr)
+{
+    return ((uint8_t *)ptr - class->buf) / class->size;
+}
+
+static inline bool _pktbuf_contains(void *ptr)
+{
+    return _snip_contains(ptr) || (_class_of(ptr) != NULL);
+}
+
+static inline void _set_pktsnip(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *next,
+                                void *data, size_t size, gnrc_nettype_t type)
+{
+    pkt->next = next;
+    pkt->data = data;
+    pkt->size = size;
+    pkt->type = type;
+    pkt->users = 1;
+#ifdef MODULE_GNRC_NETERR
+    pkt->err_sub = KERNEL_PID_UNDEF;
+#endif
+}
+
+static gnrc_pktsnip_t *_snip_alloc(void)
+{
+    gnrc_pktsnip_t *pkt = memarray_alloc(&_snip_pool);
+
+    if (pkt == NULL) {
+        gnrc_pktbuf_netstats_alloc_fail(sizeof(gnrc_pktsnip_t));
+        return NULL;
+    }
+    if (++_snips_used > _snips_max_used) {
+        _snips_max_used = _snips_used;
+    }
+    _used += sizeof(gnrc_pktsnip_t);
+    gnrc_pktbuf_netstats_used(_used);
+    return pkt;
+}
+
+static void _snip_free(gnrc_pktsnip_t *pkt)
+{
+    assert(_snip_contains(pkt));
+    assert(_snips_used > 0);
+    _snips_used--;
+    _used -= sizeof(gnrc_pktsnip_t);
+    memarray_free(&_snip_pool, pkt);
+}
+
+void gnrc_pktbuf_init(void)
+{
+    gnrc_pktbuf_lock(&_mutex);
+    memarray_init(&_snip_pool, _snips, sizeof(gnrc_pktsnip_t),
+                  GNRC_PKTBUF_SLAB_SNIP_NUMOF);
+    _snips_used = 0;
+    _used = 0;
+    for (unsigned i = 0; i < _CLASSES_NUMOF; i++) {
+        _class_t *class = &_classes[i];
+
+        memarray_init(&class->pool, class->buf, class->size, class->numof);
+        memset(class->refs, 0, class->numof);
+        class->used = 0;
+    }
+    gnrc_pktbuf_unlock(&_mutex);
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_add(gnrc_pktsnip_t *next, const void *data, size_t size,
+                                gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *pkt;
+
+    gnrc_pktbuf_lock(&_mutex);
+    if (size > GNRC_PKTBUF_SLAB_MAX_SIZE) {
+        DEBUG("pktbuf: size (%u) > GNRC_PKTBUF_SLAB_MAX_SIZE (%u)\n",
+              (unsigned)size, (unsigned)GNRC_PKTBUF_SLAB_MAX_SIZE);
+        gnrc_pktbuf_netstats_alloc_fail(size);
+        gnrc_pktbuf_unlock(&_mutex);
+        return NULL;
+    }
+    pkt = _create_snip(next, data, size, type);
+    gnrc_pktbuf_unlock(&_mutex);
+    return pkt;
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *marked_snip;
+    void *marked_data;
+
+    gnrc_pktbuf_lock(&_mutex);
+    if ((size == 0) || (pkt == NULL) || (size > pkt->size) || (pkt->data == NULL)) {
+        DEBUG("pktbuf: size == 0 (was %u) or pkt == NULL (was %p) or "
+              "size > pkt->size (was %u) or pkt->data == NULL (was %p)\n",
+              (unsigned)size, (void *)pkt, (pkt ? (unsigned)pkt->size : 0),
+              (pkt ? pkt->data : NULL));
+        gnrc_pktbuf_unlock(&_mutex);
+        return NULL;
+    }
+    /* create new snip descriptor for marked data */
+    marked_snip = _snip_alloc();
+    if (marked_snip == NULL) {
+        DEBUG("pktbuf: could not reallocate marked section.\n");
+        gnrc_pktbuf_unlock(&_mutex);
+        return NULL;
+    }
+    marked_data = pkt->data;
+    if (pkt->size != size) {
+        _class_t *class = _class_of(pkt->data);
+
+        assert(class != NULL);
+        /* both snips now point into the same slot */
+        assert(class->refs[_slot_idx(class, pkt->data)] < UINT8_MAX);
+        class->refs[_slot_idx(class, pkt->data)]++;
+        pkt->data = ((uint8_t *)pkt->data) + size;
+    }
+    else {
+        /* ownership of slot moves to marked snip */
+        pkt->data = NULL;
+    }
+    pkt->size -= size;
+    _set_pktsnip(marked_snip, pkt->next, marked_data, size, type);
+    pkt->next = marked_snip;
+    gnrc_pktbuf_unlock(&_mutex);
+    return marked_snip;
+}
+
+int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
+{
+    gnrc_pktbuf_lock(&_mutex);
+    assert(pkt != NULL);
+    assert(((pkt->size == 0) && (pkt->data == NULL)) ||
+           ((pkt->size > 0) && (pkt->data != NULL) && _pktbuf_contains(pkt->data)));
+    /* new size and old size are equal */
+    if (size == pkt->size) {
+        /* nothing to do */
+        gnrc_pktbuf_unlock(&_mutex);
+        return 0;
+    }
+    /* new size is 0 and data pointer isn't already NULL */
+    if ((size == 0) && (pkt->data != NULL)) {
+        /* set data pointer to NULL */
+        _data_free(pkt->data);
+        pkt->data = NULL;
+    }
+    /* if new size is bigger than old size */
+    else if (size > pkt->size) {
+        _class_t *class = (pkt->data != NULL) ? _class_of(pkt->data) : NULL;
+
+        /* only grow in place if no other snip points into the slot */
+        if ((class == NULL) || (class->refs[_slot_idx(class, pkt->data)] > 1) ||
+            ((((uint8_t *)pkt->data - class->buf) % class->size) + size > class->size)) {
+            void *new_data = _data_alloc(size);
+
+            if (new_data == NULL) {
+                DEBUG("pktbuf: error allocating new data section\n");
+                gnrc_pktbuf_unlock(&_mutex);
+                return ENOMEM;
+            }
+            if (pkt->data != NULL) {            /* if old data exist */
+                memcpy(new_data, pkt->data, pkt->size);
+                _data_free(pkt->data);
+            }
+            pkt->data = new_data;
+        }
+    }
+    pkt->size = size;
+    gnrc_pktbuf_unlock(&_mutex);
+    return 0;
+}
+
+void gnrc_pktbuf_hold(gnrc_pktsnip_t *pkt, unsigned int num)
+{
+    while (pkt) {
+        atomic_fetch_add(&pkt->users, num);
+        pkt = pkt->next;
+    }
+}
+
+void gnrc_pktbuf_release_error(gnrc_pktsnip_t *pkt, uint32_t err)
+{
+    bool locked = false;
+
+    while (pkt) {
+        gnrc_pktsnip_t *tmp;
+        assert(_snip_contains(pkt));
+        assert(pkt->users > 0);
+        tmp = pkt->next;
+        DEBUG("pktbuf: report status code %" PRIu32 "\n", err);
+        gnrc_neterr_report(pkt, err);
+        /* only take the mutex when memory needs to be returned */
+        if (atomic_fetch_sub(&pkt->users, 1) == 1) {
+            if (!locked) {
+                gnrc_pktbuf_lock(&_mutex);
+                locked = true;
+            }
+            _data_free(pkt->data);
+            _snip_free(pkt);
+        }
+        pkt = tmp;
+    }
+    if (locked) {
+        gnrc_pktbuf_unlock(&_mutex);
+    }
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_start_write(gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktbuf_lock(&_mutex);
+    if (pkt == NULL) {
+        gnrc_pktbuf_unlock(&_mutex);
+        return NULL;
+    }
+    if (pkt->users > 1) {
+        gnrc_pktsnip_t *new;
+        new = _create_snip(pkt->next, pkt->data, pkt->size, pkt->type);
+        /* other users might have released pkt in the meantime */
+        if ((new != NULL) && (atomic_fetch_sub(&pkt->users, 1) == 1)) {
+            _data_free(pkt->data);
+            _snip_free(pkt);
+        }
+        gnrc_pktbuf_unlock(&_mutex);
+        return new;
+    }
+    gnrc_pktbuf_unlock(&_mutex);
+    return pkt;
+}
+
+bool gnrc_pktbuf_contains(const void *ptr)
+{
+    return _pktbuf_contains((void *)ptr);
+}
+
+void gnrc_pktbuf_netstats_get(netstats_pktbuf_t *stats)
+{
+    gnrc_pktbuf_lock(&_mutex);
+    gnrc_pktbuf_netstats_copy(stats);
+    stats->used = _used;
+    stats->largest_free = 0;
+    stats->holes = 0;
+    for (unsigned i = 0; i < _CLASSES_NUMOF; i++) {
+        _class_t *class = &_classes[i];
+
+        if (class->used < class->numof) {
+            stats->largest_free = class->size;
+        }
+        stats->holes += class->numof - class->used;
+    }
+    gnrc_pktbuf_unlock(&_mutex);
+}
+
+#ifdef DEVELHELP
+void gnrc_pktbuf_stats(void)
+{
+    gnrc_pktbuf_lock(&_mutex);
+    printf("packet buffer: snips: %u/%u used (max. %u, size: %u)\n",
+           (unsigned)_snips_used, (unsigned)GNRC_PKTBUF_SLAB_SNIP_NUMOF,
+           (unsigned)_snips_max_used, (unsigned)sizeof(gnrc_pktsnip_t));
+    for (unsigned i = 0; i < _CLASSES_NUMOF; i++) {
+        _class_t *class = &_classes[i];
+
+        printf("  class %u: %u/%u used (max. %u, size: %u)\n", i,
+               (unsigned)class->used, (unsigned)class->numof,
+               (unsigned)class->max_used, (unsigned)class->size);
+    }
+    gnrc_pktbuf_unlock(&_mutex);
+}
+#endif
+
+#ifdef TEST_SUITES
+bool gnrc_pktbuf_is_empty(void)
+{
+    if (_snips_used != 0) {
+        return false;
+    }
+    for (unsigned i = 0; i < _CLASSES_NUMOF; i++) {
+        if (_classes[i].used != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool _pool_is_sane(memarray_t *pool, uint8_t *buf, size_t size,
+                          unsigned numof, unsigned used)
+{
+    unsigned free = 0;
+
+    /* Invariants of this implementation:
+     *  - all elements of a free list are slots of their pool
+     *  - the number of free slots plus the slots in use is the pool size
+     */
+    for (uint8_t *ptr = pool->free_data; ptr != NULL; ptr = *((uint8_t **)ptr)) {
+        if (((unsigned)(ptr - buf) >= (size * numof)) ||
+            (((unsigned)(ptr - buf) % size) != 0) || (++free > numof)) {
+            return false;
+        }
+    }
+    return (free + used) == numof;
+}
+
+bool gnrc_pktbuf_is_sane(void)
+{
+    if (!_pool_is_sane(&_snip_pool, (uint8_t *)_snips, sizeof(gnrc_pktsnip_t),
+                       GNRC_PKTBUF_SLAB_SNIP_NUMOF, _snips_used)) {
+        return false;
+    }
+    for (unsigned i = 0; i < _CLASSES_NUMOF; i++) {
+        _class_t *class = &_classes[i];
+
+        if (!_pool_is_sane(&class->pool, class->buf, class->size,
+                           class->numof, class->used)) {
+            return false;
+        }
+    }
+    return true;
+}
+#endif
+
+static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, const void *data, size_t size,
+                                    gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *pkt = _snip_alloc();
+    void *_data = NULL;
+
+    if (pkt == NULL) {
+        DEBUG("pktbuf: error allocating new packet snip\n");
+        return NULL;
+    }
+    if (size > 0) {
+        _data = _data_alloc(size);
+        if (_data == NULL) {
+            DEBUG("pktbuf: error allocating data for new packet snip\n");
+            _snip_free(pkt);
+            return NULL;
+        }
+        if (data != NULL) {
+            memcpy(_data, data, size);
+        }
+    }
+    _set_pktsnip(pkt, next, _data, size, type);
+    return pkt;
+}
+
+static void *_data_alloc(size_t size)
+{
+    /* take the smallest fitting class, fall back to larger ones if exhausted */
+    for (unsigned i = 0; i < _CLASSES_NUMOF; i++) {
+        _class_t *class = &_classes[i];
+        uint8_t *slot;
+
+        if (size > class->size) {
+            continue;
+        }
+        slot = memarray_alloc(&class->pool);
+        if (slot != NULL) {
+            class->refs[_slot_idx(class, slot)] = 1;
+            if (++class->used > class->max_used) {
+                class->max_used = class->used;
+            }
+            _used += class->size;
+            gnrc_pktbuf_netstats_used(_used);
+            return slot;
+        }
+    }
+    DEBUG("pktbuf: no slot of size >= %u left in packet buffer\n",
+          (unsigned)size);
+    gnrc_pktbuf_netstats_alloc_fail(size);
+    return NULL;
+}
+
+static void _data_free(void *data)
+{
+    _class_t *class;
+    unsigned idx;
+
+    if ((data == NULL) || ((class = _class_of(data)) == NULL)) {
+        return;
+    }
+    idx = _slot_idx(class, data);
+    assert(class->refs[idx] > 0);
+    if (--class->refs[idx] == 0) {
+        assert(class->used > 0);
+        class->used--;
+        _used -= class->size;
+        memarray_free(&class->pool, class->buf + (idx * class->size));
+    }
+}
+
+/** @} */
@@ -18,6 +18,7 @@
 #include <assert.h>
 #include <errno.h>
 #include <inttypes.h>
+#include <stdatomic.h>
 #include <stdbool.h>
 #include <string.h>
 #include <stdio.h>
@@ -30,6 +31,8 @@
 #include "net/gnrc/nettype.h"
 #include "net/gnrc/pkt.h"
 
+#include "pktbuf_internal.h"
+
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
@@ -43,6 +46,8 @@ typedef struct _unused {
 static mutex_t _mutex = MUTEX_INIT;
 static uint8_t _pktbuf[GNRC_PKTBUF_SIZE];
 static _unused_t *_first_unused;
+/* number of bytes currently allocated */
+static size_t _used;
 
 #ifdef DEVELHELP
 /* maximum number of bytes allocated */
@@ -81,11 +86,12 @@ static inline void _set_pktsnip(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *next,
 
 void gnrc_pktbuf_init(void)
 {
-    mutex_lock(&_mutex);
+    gnrc_pktbuf_lock(&_mutex);
     _first_unused = (_unused_t *)_pktbuf;
     _first_unused->next = NULL;
     _first_unused->size = sizeof(_pktbuf);
-    mutex_unlock(&_mutex);
+    _used = 0;
+    gnrc_pktbuf_unlock(&_mutex);
 }
 
 gnrc_pktsnip_t *gnrc_pktbuf_add(gnrc_pktsnip_t *next, const void *data, size_t size,
@@ -93,14 +99,16 @@ gnrc_pktsnip_t *gnrc_pktbuf_add(gnrc_pktsnip_t *next, const void *data, size_t s
 {
     gnrc_pktsnip_t *pkt;
 
+    gnrc_pktbuf_lock(&_mutex);
     if (size > GNRC_PKTBUF_SIZE) {
         DEBUG("pktbuf: size (%u) > GNRC_PKTBUF_SIZE (%u)\n",
               (unsigned)size, GNRC_PKTBUF_SIZE);
+        gnrc_pktbuf_netstats_alloc_fail(size);
+        gnrc_pktbuf_unlock(&_mutex);
         return NULL;
     }
-    mutex_lock(&_mutex);
     pkt = _create_snip(next, data, size, type);
-    mutex_unlock(&_mutex);
+    gnrc_pktbuf_unlock(&_mutex);
     return pkt;
 }
 
@@ -111,20 +119,20 @@ gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_
     size_t required_new_size = _align(size);
     void *new_data_marked;
 
-    mutex_lock(&_mutex);
+    gnrc_pktbuf_lock(&_mutex);
     if ((size == 0) || (pkt == NULL) || (size > pkt->size) || (pkt->data == NULL)) {
         DEBUG("pktbuf: size == 0 (was %u) or pkt == NULL (was %p) or "
               "size > pkt->size (was %u) or pkt->data == NULL (was %p)\n",
               (unsigned)size, (void *)pkt, (pkt ? (unsigned)pkt->size : 0),
               (pkt ? pkt->data : NULL));
-        mutex_unlock(&_mutex);
+        gnrc_pktbuf_unlock(&_mutex);
         return NULL;
     }
     /* create new snip descriptor for marked data */
     marked_snip = _pktbuf_alloc(sizeof(gnrc_pktsnip_t));
     if (marked_snip == NULL) {
         DEBUG("pktbuf: could not reallocate marked section.\n");
-        mutex_unlock(&_mutex);
+        gnrc_pktbuf_unlock(&_mutex);
         return NULL;
     }
     /* marked data would not fit _unused_t marker => move data around to allow
@@ -135,7 +143,7 @@ gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_
         if (new_data_marked == NULL) {
             DEBUG("pktbuf: could not reallocate marked section.\n");
             _pktbuf_free(marked_snip, sizeof(gnrc_pktsnip_t));
-            mutex_unlock(&_mutex);
+            gnrc_pktbuf_unlock(&_mutex);
             return NULL;
         }
         new_data_rest = _pktbuf_alloc(pkt->size - size);
@@ -143,7 +151,7 @@ gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_
             DEBUG("pktbuf: could not reallocate remaining section.\n");
             _pktbuf_free(marked_snip, sizeof(gnrc_pktsnip_t));
             _pktbuf_free(new_data_marked, size);
-            mutex_unlock(&_mutex);
+            gnrc_pktbuf_unlock(&_mutex);
             return NULL;
         }
         memcpy(new_data_marked, pkt->data, size);
@@ -161,7 +169,7 @@ gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_
     pkt->size -= size;
     _set_pktsnip(marked_snip, pkt->next, new_data_marked, size, type);
     pkt->next = marked_snip;
-    mutex_unlock(&_mutex);
+    gnrc_pktbuf_unlock(&_mutex);
     return marked_snip;
 }
 
@@ -169,14 +177,14 @@ int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
 {
     size_t aligned_size = _align(size);
 
-    mutex_lock(&_mutex);
+    gnrc_pktbuf_lock(&_mutex);
     assert(pkt != NULL);
     assert(((pkt->size == 0) && (pkt->data == NULL)) ||
            ((pkt->size > 0) && (pkt->data != NULL) && _pktbuf_contains(pkt->data)));
     /* new size and old size are equal */
     if (size == pkt->size) {
         /* nothing to do */
-        mutex_unlock(&_mutex);
+        gnrc_pktbuf_unlock(&_mutex);
         return 0;
     }
     /* new size is 0 and data pointer isn't already NULL */
@@ -190,7 +198,7 @@ int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
         void *new_data = _pktbuf_alloc(size);
         if (new_data == NULL) {
             DEBUG("pktbuf: error allocating new data section\n");
-            mutex_unlock(&_mutex);
+            gnrc_pktbuf_unlock(&_mutex);
             return ENOMEM;
         }
         if (pkt->data != NULL) {            /* if old data exist */
@@ -204,68 +212,91 @@ int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
                      pkt->size - aligned_size);
     }
     pkt->size = size;
-    mutex_unlock(&_mutex);
+    gnrc_pktbuf_unlock(&_mutex);
     return 0;
 }
 
 void gnrc_pktbuf_hold(gnrc_pktsnip_t *pkt, unsigned int num)
 {
-    mutex_lock(&_mutex);
     while (pkt) {
-        pkt->users += num;
+        atomic_fetch_add(&pkt->users, num);
         pkt = pkt->next;
     }
-    mutex_unlock(&_mutex);
 }
 
-static void _release_error_locked(gnrc_pktsnip_t *pkt, uint32_t err)
+void gnrc_pktbuf_release_error(gnrc_pktsnip_t *pkt, uint32_t err)
 {
+    bool locked = false;
+
     while (pkt) {
         gnrc_pktsnip_t *tmp;
         assert(_pktbuf_contains(pkt));
         assert(pkt->users > 0);
         tmp = pkt->next;
-        if (pkt->users == 1) {
-            pkt->users = 0; /* not necessary but to be on the safe side */
+        DEBUG("pktbuf: report status code %" PRIu32 "\n", err);
+        gnrc_neterr_report(pkt, err);
+        /* only take the mutex when memory needs to be returned */
+        if (atomic_fetch_sub(&pkt->users, 1) == 1) {
+            if (!locked) {
+                gnrc_pktbuf_lock(&_mutex);
+                locked = true;
+            }
             _pktbuf_free(pkt->data, pkt->size);
             _pktbuf_free(pkt, sizeof(gnrc_pktsnip_t));
         }
-        else {
-            pkt->users--;
-        }
-        DEBUG("pktbuf: report status code %" PRIu32 "\n", err);
-        gnrc_neterr_report(pkt, err);
         pkt = tmp;
     }
-}
-
-void gnrc_pktbuf_release_error(gnrc_pktsnip_t *pkt, uint32_t err)
-{
-    mutex_lock(&_mutex);
-    _release_error_locked(pkt, err);
-    mutex_unlock(&_mutex);
+    if (locked) {
+        gnrc_pktbuf_unlock(&_mutex);
+    }
 }
 
 gnrc_pktsnip_t *gnrc_pktbuf_start_write(gnrc_pktsnip_t *pkt)
 {
-    mutex_lock(&_mutex);
+    gnrc_pktbuf_lock(&_mutex);
     if (pkt == NULL) {
-        mutex_unlock(&_mutex);
+        gnrc_pktbuf_unlock(&_mutex);
         return NULL;
     }
     if (pkt->users > 1) {
         gnrc_pktsnip_t *new;
         new = _create_snip(pkt->next, pkt->data, pkt->size, pkt->type);
-        if (new != NULL) {
-            pkt->users--;
+        /* other users might have released pkt in the meantime */
+        if ((new != NULL) && (atomic_fetch_sub(&pkt->users, 1) == 1)) {
+            _pktbuf_free(pkt->data, pkt->size);
+            _pktbuf_free(pkt, sizeof(gnrc_pktsnip_t));
         }
-        mutex_unlock(&_mutex);
+        gnrc_pktbuf_unlock(&_mutex);
         return new;
     }
-    mutex_unlock(&_mutex);
+    gnrc_pktbuf_unlock(&_mutex);
     return pkt;
 }
 
+bool gnrc_pktbuf_contains(const void *ptr)
+{
+    return _pktbuf_contains((void *)ptr);
+}
+
+void gnrc_pktbuf_netstats_get(netstats_pktbuf_t *stats)
+{
+    size_t free = 0;
+
+    gnrc_pktbuf_lock(&_mutex);
+    gnrc_pktbuf_netstats_copy(stats);
+    stats->largest_free = 0;
+    stats->holes = 0;
+    for (_unused_t *ptr = _first_unused; ptr != NULL; ptr = ptr->next) {
+        if (ptr->size > stats->largest_free) {
+            stats->largest_free = ptr->size;
+        }
+        free += ptr->size;
+        stats->holes++;
+    }
+    stats->used = GNRC_PKTBUF_SIZE - free;
+    gnrc_pktbuf_unlock(&_mutex);
+}
+
 #ifdef DEVELHELP
 #ifdef MODULE_OD
 static inline void _print_chunk(void *chunk, size_t size, int num)
@@ -391,6 +422,7 @@ static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, const void *data, size
 static void *_pktbuf_alloc(size_t size)
 {
     _unused_t *prev = NULL, *ptr = _first_unused;
+    size_t req_size = size;
 
     size = _align(size);
     while (ptr && (size > ptr->size)) {
@@ -399,6 +431,8 @@ static void *_pktbuf_alloc(size_t size)
     }
     if (ptr == NULL) {
         DEBUG("pktbuf: no space left in packet buffer\n");
+        /* count by requested size, like the other implementations */
+        gnrc_pktbuf_netstats_alloc_fail(req_size);
         return NULL;
     }
     /* _unused_t struct would fit => add new space at ptr */
@@ -432,6 +466,8 @@ static void *_pktbuf_alloc(size_t size)
         max_byte_count = last_byte;
     }
 #endif
+    _used += size;
+    gnrc_pktbuf_netstats_used(_used);
     return (void *)ptr;
 }
 
@@ -463,6 +499,7 @@ static void _pktbuf_free(void *data, size_t size)
     }
     new->next = ptr;
     new->size = _align(size);
+    _used -= new->size;
     /* calculate number of bytes between new _unused_t chunk and end of packet
      * buffer */
     bytes_at_end = ((&_pktbuf[0] + GNRC_PKTBUF_SIZE) - (((uint8_t *)new) + new->size));
@@ -16,6 +16,7 @@
 #include <errno.h>
 
 #include "net/af.h"
+#include "net/inet_csum.h"
 #include "net/ipv6/hdr.h"
 #include "net/gnrc/ipv6.h"
 #include "net/gnrc/ipv6/hdr.h"
@@ -113,8 +114,69 @@ ssize_t gnrc_sock_recv(gnrc_sock_reg_t *reg, gnrc_pktsnip_t **pkt_out,
     return 0;
 }
 
+gnrc_pktsnip_t *gnrc_sock_build_payload(const iolist_t *snips, uint16_t *csum)
+{
+    gnrc_pktsnip_t *payload, *tail = NULL;
+    const iolist_t *snip;
+    uint8_t *ptr;
+    size_t len = 0;
+    uint16_t sum = 0;
+
+    /* gnrc_pktsnip_t starts like iolist_t, so an entry in the packet buffer
+     * is a packet snip. It and all entries following it are linked into the
+     * payload instead of copied */
+    for (snip = snips; snip != NULL; snip = snip->iol_next) {
+        if (gnrc_pktbuf_contains(snip)) {
+            tail = (gnrc_pktsnip_t *)snip;
+            break;
+        }
+        len += snip->iol_len;
+    }
+    if ((len == 0) && (tail != NULL)) {
+        payload = tail;
+    }
+    else {
+        /* the entries before the tail are copied in a single pass, so there
+         * is no need to assemble them in an intermediate buffer */
+        payload = gnrc_pktbuf_add(NULL, NULL, len, GNRC_NETTYPE_UNDEF);
+        if (payload == NULL) {
+            return NULL;
+        }
+        ptr = payload->data;
+        for (snip = snips; snip != (iolist_t *)tail; snip = snip->iol_next) {
+            assert((snip->iol_len == 0) || (snip->iol_base != NULL));
+            if (csum != NULL) {
+                /* sum up while the bytes pass by anyway */
+                sum = inet_csum_copy(sum, ptr, snip->iol_base,
+                                     (uint16_t)snip->iol_len,
+                                     ptr - (uint8_t *)payload->data);
+            }
+            else {
+                memcpy(ptr, snip->iol_base, snip->iol_len);
+            }
+            ptr += snip->iol_len;
+        }
+        payload->next = tail;
+    }
+    if (tail != NULL) {
+        /* the caller keeps its reference to the snips */
+        gnrc_pktbuf_hold(tail, 1);
+        if (csum != NULL) {
+            for (gnrc_pktsnip_t *tmp = tail; tmp != NULL; tmp = tmp->next) {
+                sum = inet_csum_slice(sum, tmp->data, (uint16_t)tmp->size, len);
+                len += tmp->size;
+            }
+        }
+    }
+    if (csum != NULL) {
+        *csum = sum;
+    }
+    return payload;
+}
+
 ssize_t gnrc_sock_send(gnrc_pktsnip_t *payload, sock_ip_ep_t *local,
-                       const sock_ip_ep_t *remote, uint8_t nh)
+                       const sock_ip_ep_t *remote, uint8_t nh,
+                       uint8_t netif_hdr_flags)
 {
     gnrc_pktsnip_t *pkt;
     kernel_pid_t iface = KERNEL_PID_UNDEF;
@@ -159,7 +221,7 @@ ssize_t gnrc_sock_send(gnrc_pktsnip_t *payload, sock_ip_ep_t *local,
         /* TODO: use API in #5511 */
         iface = (kernel_pid_t)remote->netif;
     }
-    if (iface != KERNEL_PID_UNDEF) {
+    if ((iface != KERNEL_PID_UNDEF) || (netif_hdr_flags != 0)) {
         gnrc_pktsnip_t *netif = gnrc_netif_hdr_build(NULL, 0, NULL, 0);
         gnrc_netif_hdr_t *netif_hdr;
 
@@ -169,6 +231,7 @@ ssize_t gnrc_sock_send(gnrc_pktsnip_t *payload, sock_ip_ep_t *local,
         }
         netif_hdr = netif->data;
         netif_hdr->if_pid = iface;
+        netif_hdr->flags = netif_hdr_flags;
         LL_PREPEND(pkt, netif);
     }
 #ifdef MODULE_GNRC_NETERR
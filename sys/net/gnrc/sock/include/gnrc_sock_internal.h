@@ -25,6 +25,7 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include <string.h>
+#include "iolist.h"
 #include "mbox.h"
 #include "net/af.h"
 #include "net/gnrc.h"
@@ -132,9 +133,30 @@ ssize_t gnrc_sock_recv(gnrc_sock_reg_t *reg, gnrc_pktsnip_t **pkt, uint32_t time
 /**
  * @brief   Send a packet internally
  * @internal
+ *
+ * A generic network interface header is added if an interface is given by
+ * @p local or @p remote, or if @p netif_hdr_flags are not 0.
  */
 ssize_t gnrc_sock_send(gnrc_pktsnip_t *payload, sock_ip_ep_t *local,
-                       const sock_ip_ep_t *remote, uint8_t nh);
+                       const sock_ip_ep_t *remote, uint8_t nh,
+                       uint8_t netif_hdr_flags);
+
+/**
+ * @brief   Gathers the entries of an I/O list into a payload
+ * @internal
+ *
+ * The entries are copied into a single payload snip, up to the first entry
+ * that is located in the packet buffer. That entry is a @ref gnrc_pktsnip_t,
+ * so it and all snips following it are linked to the payload and held
+ * instead.
+ *
+ * @param[in] snips     The I/O list.
+ * @param[out] csum     The unnormalized Internet checksum of the payload,
+ *                      calculated while copying. May be NULL.
+ *
+ * @return  The payload snip, NULL if the packet buffer is full.
+ */
+gnrc_pktsnip_t *gnrc_sock_build_payload(const iolist_t *snips, uint16_t *csum);
 /**
  * @}
  */
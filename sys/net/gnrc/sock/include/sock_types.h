@@ -30,7 +30,11 @@
 #include "net/gnrc.h"
 #include "net/gnrc/netreg.h"
 #include "net/sock/ip.h"
+#include "net/sock/tcp.h"
 #include "net/sock/udp.h"
+#ifdef MODULE_GNRC_SOCK_TCP
+#include "net/gnrc/tcp/tcb.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -75,6 +79,25 @@ struct sock_udp {
     uint16_t flags;                     /**< option flags */
 };
 
+#if defined(MODULE_GNRC_SOCK_TCP) || defined(DOXYGEN)
+/**
+ * @brief   TCP sock type
+ * @internal
+ */
+struct sock_tcp {
+    gnrc_tcp_tcb_t tcb;                 /**< GNRC TCP transmission control block */
+};
+
+/**
+ * @brief   TCP listening queue type
+ * @internal
+ */
+struct sock_tcp_queue {
+    gnrc_tcp_tcb_queue_t queue;         /**< GNRC TCP listen queue */
+    sock_tcp_ep_t local;                /**< local end-point */
+};
+#endif
+
 #ifdef __cplusplus
 }
 #endif
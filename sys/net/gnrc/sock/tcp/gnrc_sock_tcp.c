@@ -0,0 +1,193 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief       GNRC implementation of @ref net_sock_tcp
+ *
+ * @author  Martine Lenders <m.lenders@fu-berlin.de>
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "assert.h"
+#include "kernel_defines.h"
+#include "net/af.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/tcp.h"
+#include "net/ipv6/addr.h"
+#include "net/sock/tcp.h"
+
+/* the TCBs of a listening queue are handed to GNRC TCP as one array */
+static_assert(sizeof(sock_tcp_t) == sizeof(gnrc_tcp_tcb_t),
+              "sock_tcp_t must only contain a gnrc_tcp_tcb_t");
+
+/**
+ * @brief   Maximum length of an address string, including the interface
+ */
+#define ADDR_STR_LEN    (IPV6_ADDR_MAX_STR_LEN + sizeof("%65535"))
+
+static int _check_ep(const sock_tcp_ep_t *ep)
+{
+    if (ep->family != AF_INET6) {
+        return -EAFNOSUPPORT;
+    }
+    if ((ep->netif != SOCK_ADDR_ANY_NETIF) &&
+        (gnrc_netif_get_by_pid(ep->netif) == NULL)) {
+        return -EINVAL;
+    }
+    return 0;
+}
+
+static char *_ep_addr_to_str(char *str, const sock_tcp_ep_t *ep)
+{
+    ipv6_addr_to_str(str, (ipv6_addr_t *)&ep->addr.ipv6, IPV6_ADDR_MAX_STR_LEN);
+    if (ep->netif != SOCK_ADDR_ANY_NETIF) {
+        size_t len = strlen(str);
+        snprintf(&str[len], ADDR_STR_LEN - len, "%%%u", (unsigned)ep->netif);
+    }
+    return str;
+}
+
+int sock_tcp_connect(sock_tcp_t *sock, const sock_tcp_ep_t *remote,
+                     uint16_t local_port, uint16_t flags)
+{
+    char addr[ADDR_STR_LEN];
+    int res;
+
+    assert((sock != NULL) && (remote != NULL) && (remote->port != 0));
+    (void)flags;
+    if ((res = _check_ep(remote)) < 0) {
+        return res;
+    }
+    if (ipv6_addr_is_unspecified((ipv6_addr_t *)&remote->addr.ipv6)) {
+        return -EINVAL;
+    }
+    gnrc_tcp_tcb_init(&sock->tcb);
+    return gnrc_tcp_open_active(&sock->tcb, AF_INET6, _ep_addr_to_str(addr, remote),
+                                remote->port, local_port);
+}
+
+int sock_tcp_listen(sock_tcp_queue_t *queue, const sock_tcp_ep_t *local,
+                    sock_tcp_t *queue_array, unsigned queue_len,
+                    uint16_t flags)
+{
+    char addr[ADDR_STR_LEN];
+    char *local_addr = NULL;
+    int res;
+
+    assert((queue != NULL) && (local != NULL) && (local->port != 0));
+    assert((queue_array != NULL) && (queue_len != 0));
+    (void)flags;
+    if ((res = _check_ep(local)) < 0) {
+        return res;
+    }
+    if (!ipv6_addr_is_unspecified((ipv6_addr_t *)&local->addr.ipv6)) {
+        local_addr = ipv6_addr_to_str(addr, (ipv6_addr_t *)&local->addr.ipv6,
+                                      sizeof(addr));
+    }
+    for (unsigned i = 0; i < queue_len; i++) {
+        gnrc_tcp_tcb_init(&queue_array[i].tcb);
+    }
+    gnrc_tcp_tcb_queue_init(&queue->queue);
+    memcpy(&queue->local, local, sizeof(sock_tcp_ep_t));
+    return gnrc_tcp_listen(&queue->queue, &queue_array[0].tcb, queue_len,
+                           local_addr, local->port);
+}
+
+void sock_tcp_disconnect(sock_tcp_t *sock)
+{
+    assert(sock != NULL);
+    gnrc_tcp_close(&sock->tcb);
+}
+
+void sock_tcp_stop_listen(sock_tcp_queue_t *queue)
+{
+    assert(queue != NULL);
+    gnrc_tcp_stop_listen(&queue->queue);
+}
+
+int sock_tcp_get_local(sock_tcp_t *sock, sock_tcp_ep_t *ep)
+{
+    int res;
+
+    assert((sock != NULL) && (ep != NULL));
+    res = gnrc_tcp_get_local(&sock->tcb, (ipv6_addr_t *)&ep->addr.ipv6,
+                             &ep->port);
+    if (res == 0) {
+        ep->family = AF_INET6;
+        ep->netif = (sock->tcb.ll_iface > 0) ? (uint16_t)sock->tcb.ll_iface
+                                             : SOCK_ADDR_ANY_NETIF;
+    }
+    return res;
+}
+
+int sock_tcp_get_remote(sock_tcp_t *sock, sock_tcp_ep_t *ep)
+{
+    int res;
+
+    assert((sock != NULL) && (ep != NULL));
+    res = gnrc_tcp_get_remote(&sock->tcb, (ipv6_addr_t *)&ep->addr.ipv6,
+                              &ep->port);
+    if (res == 0) {
+        ep->family = AF_INET6;
+        ep->netif = (sock->tcb.ll_iface > 0) ? (uint16_t)sock->tcb.ll_iface
+                                             : SOCK_ADDR_ANY_NETIF;
+    }
+    return res;
+}
+
+int sock_tcp_queue_get_local(sock_tcp_queue_t *queue, sock_tcp_ep_t *ep)
+{
+    assert((queue != NULL) && (ep != NULL));
+    if (queue->queue.tcbs == NULL) {
+        return -EADDRNOTAVAIL;
+    }
+    memcpy(ep, &queue->local, sizeof(sock_tcp_ep_t));
+    return 0;
+}
+
+int sock_tcp_accept(sock_tcp_queue_t *queue, sock_tcp_t **sock,
+                    uint32_t timeout)
+{
+    gnrc_tcp_tcb_t *tcb;
+    int res;
+
+    assert((queue != NULL) && (sock != NULL));
+    res = gnrc_tcp_accept(&queue->queue, &tcb,
+                          (timeout == SOCK_NO_TIMEOUT) ? GNRC_TCP_NO_TIMEOUT
+                                                       : timeout);
+    if (res == 0) {
+        *sock = container_of(tcb, sock_tcp_t, tcb);
+    }
+    return res;
+}
+
+ssize_t sock_tcp_read(sock_tcp_t *sock, void *data, size_t max_len,
+                      uint32_t timeout)
+{
+    assert((sock != NULL) && (data != NULL) && (max_len > 0));
+    return gnrc_tcp_recv(&sock->tcb, data, max_len,
+                         (timeout == SOCK_NO_TIMEOUT) ? GNRC_TCP_NO_TIMEOUT : timeout);
+}
+
+ssize_t sock_tcp_write(sock_tcp_t *sock, const void *data, size_t len)
+{
+    assert(sock != NULL);
+    assert((len == 0) || (data != NULL));
+    if (len == 0) {
+        return 0;
+    }
+    return gnrc_tcp_send(&sock->tcb, data, len, 0);
+}
+
+/** @} */
@@ -20,6 +20,7 @@
 
 #include "byteorder.h"
 #include "net/af.h"
+#include "net/inet_csum.h"
 #include "net/protnum.h"
 #include "net/gnrc/ipv6.h"
 #include "net/gnrc/udp.h"
@@ -175,15 +176,20 @@ int sock_udp_get_remote(sock_udp_t *sock, sock_udp_ep_t *remote)
     return 0;
 }
 
-ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
-                      uint32_t timeout, sock_udp_ep_t *remote)
+/**
+ * @brief   Receives a UDP packet for @p sock and checks its remote
+ *
+ * @return  0 on success, with @p pkt_out pointing to the received packet.
+ * @return  negative errno on error, no packet is held in that case.
+ */
+static ssize_t _udp_recv(sock_udp_t *sock, gnrc_pktsnip_t **pkt_out,
+                         uint32_t timeout, sock_udp_ep_t *remote)
 {
     gnrc_pktsnip_t *pkt, *udp;
     udp_hdr_t *hdr;
     sock_ip_ep_t tmp;
     int res;
 
-    assert((sock != NULL) && (data != NULL) && (max_len > 0));
     if (sock->local.family == AF_UNSPEC) {
         return -EADDRNOTAVAIL;
     }
@@ -192,10 +198,6 @@ ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
     if (res < 0) {
         return res;
     }
-    if (pkt->size > max_len) {
-        gnrc_pktbuf_release(pkt);
-        return -ENOBUFS;
-    }
     udp = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_UDP);
     assert(udp);
     hdr = udp->data;
@@ -214,24 +216,147 @@ ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
         gnrc_pktbuf_release(pkt);
         return -EPROTO;
     }
-    memcpy(data, pkt->data, pkt->size);
-    res = (int)pkt->size;
+    *pkt_out = pkt;
+    return 0;
+}
+
+/* returns the non-empty payload snip right before @p next, which holds the
+ * chunk of payload directly in front of @p next's */
+static gnrc_pktsnip_t *_prev_chunk(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *next)
+{
+    gnrc_pktsnip_t *prev = NULL;
+
+    for (gnrc_pktsnip_t *snip = pkt; (snip != NULL) && (snip != next) &&
+         (snip->type != GNRC_NETTYPE_UDP); snip = snip->next) {
+        if (snip->size > 0) {
+            prev = snip;
+        }
+    }
+    return prev;
+}
+
+/* checks the checksum of @p pkt with the sum of its payload, if UDP left it
+ * to the sock */
+static bool _csum_valid(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *udp, uint16_t sum)
+{
+    return (gnrc_netif_hdr_get_flag(pkt) & GNRC_NETIF_HDR_FLAGS_CSUM_VALID) ||
+           gnrc_udp_check_csum(udp, gnrc_pktsnip_search_type(pkt,
+                                                             GNRC_NETTYPE_IPV6),
+                               sum);
+}
+
+ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
+                      uint32_t timeout, sock_udp_ep_t *remote)
+{
+    gnrc_pktsnip_t *pkt, *udp, *snip;
+    uint8_t *ptr = data;
+    uint16_t sum = 0;
+    size_t len = 0;
+    int res;
+
+    assert((sock != NULL) && (data != NULL) && (max_len > 0));
+    res = _udp_recv(sock, &pkt, timeout, remote);
+    if (res < 0) {
+        return res;
+    }
+    udp = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_UDP);
+    for (snip = pkt; snip != udp; snip = snip->next) {
+        len += snip->size;
+    }
+    if (len > max_len) {
+        gnrc_pktbuf_release(pkt);
+        return -ENOBUFS;
+    }
+    /* the payload snips precede the UDP header in reverse order, the
+     * checksum is verified while the bytes pass by anyway */
+    for (snip = _prev_chunk(pkt, udp); snip != NULL;
+         snip = _prev_chunk(pkt, snip)) {
+        sum = inet_csum_copy(sum, ptr, snip->data, (uint16_t)snip->size,
+                             ptr - (uint8_t *)data);
+        ptr += snip->size;
+    }
+    if (!_csum_valid(pkt, udp, sum)) {
+        gnrc_pktbuf_release(pkt);
+        return -EBADMSG;
+    }
     gnrc_pktbuf_release(pkt);
-    return res;
+    return (ssize_t)len;
+}
+
+ssize_t sock_udp_recv_buf(sock_udp_t *sock, void **data, void **buf_ctx,
+                          uint32_t timeout, sock_udp_ep_t *remote)
+{
+    gnrc_pktsnip_t *pkt = *buf_ctx, *snip;
+    int res;
+
+    assert((sock != NULL) && (data != NULL) && (buf_ctx != NULL));
+    if (pkt == NULL) {
+        res = _udp_recv(sock, &pkt, timeout, remote);
+        if (res < 0) {
+            *data = NULL;
+            return res;
+        }
+        /* the payload snips precede the UDP header in a received packet in
+         * reverse order, so the payload starts right above the UDP header */
+        gnrc_pktsnip_t *udp = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_UDP);
+        uint16_t sum = 0;
+        size_t len = 0;
+
+        for (snip = _prev_chunk(pkt, udp); snip != NULL;
+             snip = _prev_chunk(pkt, snip)) {
+            sum = inet_csum_slice(sum, snip->data, (uint16_t)snip->size, len);
+            len += snip->size;
+        }
+        if (!_csum_valid(pkt, udp, sum)) {
+            gnrc_pktbuf_release(pkt);
+            *data = NULL;
+            return -EBADMSG;
+        }
+        snip = udp;
+    }
+    else {
+        /* *data points to the chunk handed out last */
+        for (snip = pkt; (snip != NULL) && (snip->type != GNRC_NETTYPE_UDP);
+             snip = snip->next) {
+            if ((snip->size > 0) && (snip->data == *data)) {
+                break;
+            }
+        }
+    }
+    /* empty snips are skipped so 0 is only returned at the end of the
+     * payload */
+    if ((snip != NULL) && ((snip = _prev_chunk(pkt, snip)) != NULL)) {
+        *buf_ctx = pkt;
+        *data = snip->data;
+        return (ssize_t)snip->size;
+    }
+    gnrc_pktbuf_release(pkt);
+    *data = NULL;
+    *buf_ctx = NULL;
+    return 0;
 }
 
 ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
                       const sock_udp_ep_t *remote)
+{
+    iolist_t snip = { .iol_next = NULL, .iol_base = (void *)data,
+                      .iol_len = len };
+
+    assert((len == 0) || (data != NULL)); /* (len != 0) => (data != NULL) */
+    return sock_udp_sendv(sock, &snip, remote);
+}
+
+ssize_t sock_udp_sendv(sock_udp_t *sock, const iolist_t *snips,
+                       const sock_udp_ep_t *remote)
 {
     int res;
     gnrc_pktsnip_t *payload, *pkt;
-    uint16_t src_port = 0, dst_port;
+    uint16_t src_port = 0, dst_port, csum;
     sock_ip_ep_t local;
     sock_udp_ep_t remote_cpy;
     sock_ip_ep_t *rem;
 
     assert((sock != NULL) || (remote != NULL));
-    assert((len == 0) || (data != NULL)); /* (len != 0) => (data != NULL) */
 
     if (remote != NULL) {
         if (remote->port == 0) {
@@ -304,7 +429,7 @@ ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
         return -EINVAL;
     }
     /* generate payload and header snips */
-    payload = gnrc_pktbuf_add(NULL, (void *)data, len, GNRC_NETTYPE_UNDEF);
+    payload = gnrc_sock_build_payload(snips, &csum);
     if (payload == NULL) {
         return -ENOMEM;
     }
@@ -313,7 +438,11 @@ ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
         gnrc_pktbuf_release(payload);
         return -ENOMEM;
     }
-    res = gnrc_sock_send(pkt, &local, rem, PROTNUM_UDP);
+    /* IPv6 completes the checksum from the sum of the payload, so the
+     * payload is not read a second time */
+    ((udp_hdr_t *)pkt->data)->checksum = byteorder_htons(csum);
+    res = gnrc_sock_send(pkt, &local, rem, PROTNUM_UDP,
+                         GNRC_NETIF_HDR_FLAGS_CSUM_PAYLOAD);
     if (res > 0) {
         res -= sizeof(udp_hdr_t);
     }
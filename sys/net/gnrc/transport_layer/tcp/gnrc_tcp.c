@@ -38,6 +38,7 @@
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
+#ifndef MODULE_GNRC_EVENTLOOP
 /**
  * @brief Allocate memory for GNRC TCP thread stack.
  */
@@ -46,6 +47,7 @@ static char _stack[TCP_EVENTLOOP_STACK_SIZE + THREAD_EXTRA_STACKSIZE_PRINTF];
 #else
 static char _stack[TCP_EVENTLOOP_STACK_SIZE];
 #endif
+#endif
 
 /**
  * @brief TCPs eventloop pid, declared externally.
@@ -262,10 +264,15 @@ int gnrc_tcp_init(void)
     _list_tcb_head = NULL;
     _rcvbuf_init();
 
+#ifdef MODULE_GNRC_EVENTLOOP
+    /* Process TCP in the shared GNRC thread */
+    return _eventloop_init();
+#else
     /* Start TCP processing thread */
     return thread_create(_stack, sizeof(_stack), TCP_EVENTLOOP_PRIO,
                          THREAD_CREATE_STACKTEST, _event_loop, NULL,
                          "gnrc_tcp");
+#endif
 }
 
 void gnrc_tcp_tcb_init(gnrc_tcp_tcb_t *tcb)
@@ -279,11 +286,66 @@ void gnrc_tcp_tcb_init(gnrc_tcp_tcb_t *tcb)
     tcb->rtt_var = RTO_UNINITIALIZED;
     tcb->srtt = RTO_UNINITIALIZED;
     tcb->rto = RTO_UNINITIALIZED;
+    if (GNRC_TCP_DELAYED_ACK) {
+        tcb->status |= STATUS_DELAYED_ACK;
+    }
+    if (GNRC_TCP_NAGLE) {
+        tcb->status |= STATUS_NAGLE;
+    }
     mbox_init(&(tcb->mbox), tcb->mbox_raw, GNRC_TCP_TCB_MBOX_SIZE);
     mutex_init(&(tcb->fsm_lock));
     mutex_init(&(tcb->function_lock));
 }
 
+int gnrc_tcp_tcb_set_rcv_buf_size(gnrc_tcp_tcb_t *tcb, size_t size)
+{
+    assert(tcb != NULL);
+
+    if (size > GNRC_TCP_RCV_BUF_POOL_SIZE) {
+        return -EINVAL;
+    }
+
+    mutex_lock(&(tcb->function_lock));
+    if (tcb->state != FSM_STATE_CLOSED) {
+        mutex_unlock(&(tcb->function_lock));
+        return -EISCONN;
+    }
+    tcb->rcv_buf_size = size;
+    mutex_unlock(&(tcb->function_lock));
+    return 0;
+}
+
+/**
+ * @brief Sets or clears a status flag of a TCB, synchronized with the FSM.
+ *
+ * @param[in,out] tcb      TCB holding the connection information.
+ * @param[in]     flag     Status flag to change.
+ * @param[in]     enable   True to set @p flag, false to clear it.
+ */
+static void _set_status_flag(gnrc_tcp_tcb_t *tcb, uint16_t flag, bool enable)
+{
+    mutex_lock(&(tcb->fsm_lock));
+    if (enable) {
+        tcb->status |= flag;
+    }
+    else {
+        tcb->status &= ~flag;
+    }
+    mutex_unlock(&(tcb->fsm_lock));
+}
+
+void gnrc_tcp_tcb_set_delayed_ack(gnrc_tcp_tcb_t *tcb, bool enable)
+{
+    assert(tcb != NULL);
+    _set_status_flag(tcb, STATUS_DELAYED_ACK, enable);
+}
+
+void gnrc_tcp_tcb_set_nagle(gnrc_tcp_tcb_t *tcb, bool enable)
+{
+    assert(tcb != NULL);
+    _set_status_flag(tcb, STATUS_NAGLE, enable);
+}
+
 int gnrc_tcp_open_active(gnrc_tcp_tcb_t *tcb, uint8_t address_family,
                          char *target_addr, uint16_t target_port,
                          uint16_t local_port)
@@ -333,6 +395,247 @@ int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb, uint8_t address_family,
     return _gnrc_tcp_open(tcb, NULL, 0, local_addr, local_port, 1);
 }
 
+void gnrc_tcp_tcb_queue_init(gnrc_tcp_tcb_queue_t *queue)
+{
+    memset(queue, 0, sizeof(gnrc_tcp_tcb_queue_t));
+    mutex_init(&(queue->lock));
+    mbox_init(&(queue->mbox), queue->mbox_raw, GNRC_TCP_TCB_MBOX_SIZE);
+}
+
+/**
+ * @brief Opens a TCB of a listen queue without waiting for a connection.
+ *
+ * @param[in,out] queue        Listen queue, the TCB belongs to.
+ * @param[in,out] tcb          TCB to open.
+ * @param[in]     local_addr   Local address to listen on, NULL for any address.
+ * @param[in]     local_port   Local port to listen on.
+ *
+ * @returns   Zero on success.
+ *            -EISCONN if TCB is already in use.
+ *            -EINVAL if @p local_addr is invalid.
+ *            -ENOMEM if the receive buffer for the TCB could not be allocated.
+ */
+static int _gnrc_tcp_listen(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_tcb_t *tcb,
+                            const char *local_addr, uint16_t local_port)
+{
+    int ret = 0;
+
+    /* Lock the TCB for this function call */
+    mutex_lock(&(tcb->function_lock));
+
+    /* Connection is already connected: Return -EISCONN */
+    if (tcb->state != FSM_STATE_CLOSED) {
+        mutex_unlock(&(tcb->function_lock));
+        return -EISCONN;
+    }
+
+    tcb->status |= STATUS_PASSIVE;
+    if (local_addr == NULL) {
+        tcb->status |= STATUS_ALLOW_ANY_ADDR;
+    }
+#ifdef MODULE_GNRC_IPV6
+    else if (ipv6_addr_from_str((ipv6_addr_t *) tcb->local_addr, local_addr) == NULL) {
+        DEBUG("gnrc_tcp.c : _gnrc_tcp_listen() : Invalid local addr\n");
+        mutex_unlock(&(tcb->function_lock));
+        return -EINVAL;
+    }
+#endif
+    tcb->local_port = local_port;
+    tcb->queue = queue;
+
+    /* Call FSM with event: CALL_OPEN, it returns right after entering LISTEN */
+    ret = _fsm(tcb, FSM_EVENT_CALL_OPEN, NULL, NULL, 0);
+    if (ret < 0) {
+        tcb->queue = NULL;
+        tcb->status &= ~(STATUS_PASSIVE | STATUS_ALLOW_ANY_ADDR);
+    }
+    mutex_unlock(&(tcb->function_lock));
+    return ret;
+}
+
+/**
+ * @brief Removes a TCB from its listen queue and returns it to the listen queue, if the
+ *        connection was accepted and is closed now.
+ *
+ * @pre Caller holds tcb->function_lock.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+static void _gnrc_tcp_listen_again(gnrc_tcp_tcb_t *tcb)
+{
+    if (tcb->queue != NULL && tcb->state == FSM_STATE_CLOSED) {
+        tcb->status &= ~STATUS_ACCEPTED;
+        _fsm(tcb, FSM_EVENT_CALL_OPEN, NULL, NULL, 0);
+    }
+}
+
+int gnrc_tcp_listen(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_tcb_t *tcbs, size_t tcbs_len,
+                    const char *local_addr, uint16_t local_port)
+{
+    assert(queue != NULL);
+    assert(tcbs != NULL);
+    assert(tcbs_len > 0);
+    assert(local_port != PORT_UNSPEC);
+
+    int ret = 0;
+
+    /* Check AF-Family support if local address was supplied */
+    if (local_addr != NULL) {
+#ifdef MODULE_GNRC_IPV6
+        if (tcbs[0].address_family != AF_INET6) {
+            return -EAFNOSUPPORT;
+        }
+#else
+        return -EAFNOSUPPORT;
+#endif
+    }
+
+    mutex_lock(&(queue->lock));
+    if (queue->tcbs != NULL) {
+        mutex_unlock(&(queue->lock));
+        return -EISCONN;
+    }
+
+    /* Open all TCBs, close the already opened ones on error */
+    for (size_t i = 0; i < tcbs_len; ++i) {
+        ret = _gnrc_tcp_listen(queue, &tcbs[i], local_addr, local_port);
+        if (ret < 0) {
+            while (i-- > 0) {
+                tcbs[i].queue = NULL;
+                gnrc_tcp_abort(&tcbs[i]);
+                tcbs[i].status &= ~(STATUS_PASSIVE | STATUS_ALLOW_ANY_ADDR);
+            }
+            break;
+        }
+    }
+    if (ret == 0) {
+        queue->tcbs = tcbs;
+        queue->tcbs_len = tcbs_len;
+    }
+    mutex_unlock(&(queue->lock));
+    return ret;
+}
+
+/**
+ * @brief Marks an established connection of a listen queue as accepted.
+ *
+ * @param[in,out] queue   Listen queue holding the connections.
+ *
+ * @returns   TCB of the accepted connection.
+ *            NULL if no connection was established.
+ */
+static gnrc_tcp_tcb_t *_gnrc_tcp_accept(gnrc_tcp_tcb_queue_t *queue)
+{
+    for (size_t i = 0; i < queue->tcbs_len; ++i) {
+        gnrc_tcp_tcb_t *tcb = &(queue->tcbs[i]);
+        bool accepted = false;
+
+        /* Synchronize with the FSM, that returns unaccepted TCBs to the listen queue */
+        mutex_lock(&(tcb->fsm_lock));
+        if (!(tcb->status & STATUS_ACCEPTED) && (tcb->state == FSM_STATE_ESTABLISHED ||
+                                                 tcb->state == FSM_STATE_CLOSE_WAIT)) {
+            tcb->status |= STATUS_ACCEPTED;
+            accepted = true;
+        }
+        mutex_unlock(&(tcb->fsm_lock));
+
+        if (accepted) {
+            return tcb;
+        }
+    }
+    return NULL;
+}
+
+int gnrc_tcp_accept(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_tcb_t **tcb,
+                    const uint32_t user_timeout_duration_us)
+{
+    assert(queue != NULL);
+    assert(tcb != NULL);
+
+    msg_t msg;
+    xtimer_t user_timeout;
+    cb_arg_t user_timeout_arg = {MSG_TYPE_USER_SPEC_TIMEOUT, &(queue->mbox)};
+    bool timeout = (user_timeout_duration_us != 0) &&
+                   (user_timeout_duration_us != GNRC_TCP_NO_TIMEOUT);
+    int ret = 0;
+
+    /* Lock the queue for this function call */
+    mutex_lock(&(queue->lock));
+    if (queue->tcbs == NULL) {
+        mutex_unlock(&(queue->lock));
+        return -EINVAL;
+    }
+
+    /* 'Flush' mbox, connections established up to now are found by the search below */
+    while (mbox_try_get(&(queue->mbox), &msg) != 0) {
+    }
+
+    /* Setup user specified timeout */
+    if (timeout) {
+        _setup_timeout(&user_timeout, user_timeout_duration_us, _cb_mbox_put_msg,
+                       &user_timeout_arg);
+    }
+
+    /* Wait until a connection was established or the timeout fires */
+    while ((*tcb = _gnrc_tcp_accept(queue)) == NULL) {
+        if (user_timeout_duration_us == 0) {
+            ret = -EAGAIN;
+            break;
+        }
+        /* Wait without holding the lock, so the queue can be stopped meanwhile */
+        mutex_unlock(&(queue->lock));
+        mbox_get(&(queue->mbox), &msg);
+        mutex_lock(&(queue->lock));
+        if (queue->tcbs == NULL) {
+            DEBUG("gnrc_tcp.c : gnrc_tcp_accept() : queue was stopped\n");
+            ret = -EINVAL;
+            break;
+        }
+        if (msg.type == MSG_TYPE_USER_SPEC_TIMEOUT) {
+            DEBUG("gnrc_tcp.c : gnrc_tcp_accept() : USER_SPEC_TIMEOUT\n");
+            ret = -ETIMEDOUT;
+            break;
+        }
+    }
+
+    /* Cleanup */
+    if (timeout) {
+        xtimer_remove(&user_timeout);
+    }
+    mutex_unlock(&(queue->lock));
+    return ret;
+}
+
+void gnrc_tcp_stop_listen(gnrc_tcp_tcb_queue_t *queue)
+{
+    assert(queue != NULL);
+
+    mutex_lock(&(queue->lock));
+    for (size_t i = 0; i < queue->tcbs_len; ++i) {
+        gnrc_tcp_tcb_t *tcb = &(queue->tcbs[i]);
+        bool accepted;
+
+        /* Accepted connections are left to the user, all others are closed */
+        mutex_lock(&(tcb->fsm_lock));
+        accepted = (tcb->status & STATUS_ACCEPTED);
+        tcb->queue = NULL;
+        tcb->status &= ~STATUS_ACCEPTED;
+        mutex_unlock(&(tcb->fsm_lock));
+
+        if (!accepted) {
+            gnrc_tcp_abort(tcb);
+            tcb->status &= ~(STATUS_PASSIVE | STATUS_ALLOW_ANY_ADDR);
+        }
+    }
+    queue->tcbs = NULL;
+    queue->tcbs_len = 0;
+
+    /* Wake up threads waiting in gnrc_tcp_accept() */
+    msg_t msg = { .type = MSG_TYPE_NOTIFY_USER };
+    mbox_try_put(&(queue->mbox), &msg);
+    mutex_unlock(&(queue->lock));
+}
+
 ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
                       const uint32_t timeout_duration_us)
 {
@@ -375,8 +678,9 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
         _setup_timeout(&user_timeout, timeout_duration_us, _cb_mbox_put_msg, &user_timeout_arg);
     }
 
-    /* Loop until something was sent and acked */
-    while (ret == 0 || tcb->pkt_retransmit != NULL) {
+    /* Loop until something was sent. Sent data stays in the retransmit queue until it is
+     * acknowledged, so there is no need to wait for the acknowledgment here. */
+    while (ret == 0) {
         /* Check if the connections state is closed. If so, a reset was received */
         if (tcb->state == FSM_STATE_CLOSED) {
             ret = -ECONNRESET;
@@ -395,9 +699,12 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
                            &probe_timeout_arg);
         }
 
-        /* Try to send data in case there nothing has been sent and we are not probing */
-        if (ret == 0 && !probing_mode) {
+        /* Try to send data in case we are not probing */
+        if (!probing_mode) {
             ret = _fsm(tcb, FSM_EVENT_CALL_SEND, NULL, (void *) data, len);
+            if (ret > 0) {
+                break;
+            }
         }
 
         /* Wait for responses */
@@ -411,7 +718,6 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
 
             case MSG_TYPE_USER_SPEC_TIMEOUT:
                 DEBUG("gnrc_tcp.c : gnrc_tcp_send() : USER_SPEC_TIMEOUT\n");
-                _fsm(tcb, FSM_EVENT_CLEAR_RETRANSMIT, NULL, NULL, 0);
                 ret = -ETIMEDOUT;
                 break;
 
@@ -469,6 +775,7 @@ ssize_t gnrc_tcp_recv(gnrc_tcp_tcb_t *tcb, void *data, const size_t max_len,
     cb_arg_t connection_timeout_arg = {MSG_TYPE_CONNECTION_TIMEOUT, &(tcb->mbox)};
     xtimer_t user_timeout;
     cb_arg_t user_timeout_arg = {MSG_TYPE_USER_SPEC_TIMEOUT, &(tcb->mbox)};
+    bool timeout = (timeout_duration_us != GNRC_TCP_NO_TIMEOUT);
     ssize_t ret = 0;
 
     /* Lock the TCB for this function call */
@@ -484,7 +791,7 @@ ssize_t gnrc_tcp_recv(gnrc_tcp_tcb_t *tcb, void *data, const size_t max_len,
     /* If this call is non-blocking (timeout_duration_us == 0): Try to read data and return */
     if (timeout_duration_us == 0) {
         ret = _fsm(tcb, FSM_EVENT_CALL_RECV, NULL, data, max_len);
-        if (ret == 0) {
+        if (ret == 0 && tcb->state != FSM_STATE_CLOSE_WAIT) {
             ret = -EAGAIN;
         }
         mutex_unlock(&(tcb->function_lock));
@@ -498,12 +805,16 @@ ssize_t gnrc_tcp_recv(gnrc_tcp_tcb_t *tcb, void *data, const size_t max_len,
     while (mbox_try_get(&(tcb->mbox), &msg) != 0) {
     }
 
-    /* Setup connection timeout: Put timeout message in tcb's mbox on expiration */
-    _setup_timeout(&connection_timeout, GNRC_TCP_CONNECTION_TIMEOUT_DURATION,
-                   _cb_mbox_put_msg, &connection_timeout_arg);
+    /* Setup connection timeout: Put timeout message in tcb's mbox on expiration.
+     * An idle connection is no error, so waiting without timeout sets up neither */
+    if (timeout) {
+        _setup_timeout(&connection_timeout, GNRC_TCP_CONNECTION_TIMEOUT_DURATION,
+                       _cb_mbox_put_msg, &connection_timeout_arg);
 
-    /* Setup user specified timeout */
-    _setup_timeout(&user_timeout, timeout_duration_us, _cb_mbox_put_msg, &user_timeout_arg);
+        /* Setup user specified timeout */
+        _setup_timeout(&user_timeout, timeout_duration_us, _cb_mbox_put_msg,
+                       &user_timeout_arg);
+    }
 
     /* Processing loop */
     while (ret == 0) {
@@ -516,6 +827,11 @@ ssize_t gnrc_tcp_recv(gnrc_tcp_tcb_t *tcb, void *data, const size_t max_len,
         /* Try to read available data */
         ret = _fsm(tcb, FSM_EVENT_CALL_RECV, NULL, data, max_len);
 
+        /* The peer closed the connection and all data was read */
+        if (ret == 0 && tcb->state == FSM_STATE_CLOSE_WAIT) {
+            break;
+        }
+
         /* If there was no data: Wait for next packet or until the timeout fires */
         if (ret <= 0) {
             mbox_get(&(tcb->mbox), &msg);
@@ -543,8 +859,10 @@ ssize_t gnrc_tcp_recv(gnrc_tcp_tcb_t *tcb, void *data, const size_t max_len,
     }
 
     /* Cleanup */
-    xtimer_remove(&connection_timeout);
-    xtimer_remove(&user_timeout);
+    if (timeout) {
+        xtimer_remove(&connection_timeout);
+        xtimer_remove(&user_timeout);
+    }
     tcb->status &= ~STATUS_WAIT_FOR_MSG;
     mutex_unlock(&(tcb->function_lock));
     return ret;
@@ -563,6 +881,7 @@ void gnrc_tcp_close(gnrc_tcp_tcb_t *tcb)
 
     /* Return if connection is closed */
     if (tcb->state == FSM_STATE_CLOSED) {
+        _gnrc_tcp_listen_again(tcb);
         mutex_unlock(&(tcb->function_lock));
         return;
     }
@@ -602,6 +921,7 @@ void gnrc_tcp_close(gnrc_tcp_tcb_t *tcb)
     /* Cleanup */
     xtimer_remove(&connection_timeout);
     tcb->status &= ~STATUS_WAIT_FOR_MSG;
+    _gnrc_tcp_listen_again(tcb);
     mutex_unlock(&(tcb->function_lock));
 }
 
@@ -615,9 +935,56 @@ void gnrc_tcp_abort(gnrc_tcp_tcb_t *tcb)
         /* Call FSM ABORT event */
         _fsm(tcb, FSM_EVENT_CALL_ABORT, NULL, NULL, 0);
     }
+    _gnrc_tcp_listen_again(tcb);
     mutex_unlock(&(tcb->function_lock));
 }
 
+#ifdef MODULE_GNRC_IPV6
+int gnrc_tcp_get_local(gnrc_tcp_tcb_t *tcb, ipv6_addr_t *addr, uint16_t *port)
+{
+    assert(tcb != NULL);
+
+    int ret = 0;
+
+    mutex_lock(&(tcb->fsm_lock));
+    if (tcb->state == FSM_STATE_CLOSED) {
+        ret = -EADDRNOTAVAIL;
+    }
+    else {
+        if (addr != NULL) {
+            memcpy(addr, tcb->local_addr, sizeof(ipv6_addr_t));
+        }
+        if (port != NULL) {
+            *port = tcb->local_port;
+        }
+    }
+    mutex_unlock(&(tcb->fsm_lock));
+    return ret;
+}
+
+int gnrc_tcp_get_remote(gnrc_tcp_tcb_t *tcb, ipv6_addr_t *addr, uint16_t *port)
+{
+    assert(tcb != NULL);
+
+    int ret = 0;
+
+    mutex_lock(&(tcb->fsm_lock));
+    if (tcb->state == FSM_STATE_CLOSED || tcb->state == FSM_STATE_LISTEN) {
+        ret = -ENOTCONN;
+    }
+    else {
+        if (addr != NULL) {
+            memcpy(addr, tcb->peer_addr, sizeof(ipv6_addr_t));
+        }
+        if (port != NULL) {
+            *port = tcb->peer_port;
+        }
+    }
+    mutex_unlock(&(tcb->fsm_lock));
+    return ret;
+}
+#endif
+
 int gnrc_tcp_calc_csum(const gnrc_pktsnip_t *hdr, const gnrc_pktsnip_t *pseudo_hdr)
 {
     uint16_t csum;
@@ -31,10 +31,29 @@
 #include "net/gnrc/ipv6.h"
 #endif
 
+#ifdef MODULE_GNRC_EVENTLOOP
+#include "net/gnrc/eventloop.h"
+#endif
+
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
+#ifdef MODULE_GNRC_EVENTLOOP
+/**
+ * @brief TCPs layer in the shared GNRC thread.
+ */
+static gnrc_eventloop_layer_t _layer;
+static msg_t _layer_queue[TCP_EVENTLOOP_MSG_QUEUE_SIZE];
+
+/**
+ * @brief Registry entry of TCP.
+ */
+static gnrc_netreg_entry_t _netreg = GNRC_NETREG_ENTRY_INIT_CB(
+        GNRC_NETREG_DEMUX_CTX_ALL, &_layer.cbd
+    );
+#else
 static msg_t _eventloop_msg_queue[TCP_EVENTLOOP_MSG_QUEUE_SIZE];
+#endif
 
 /**
  * @brief Send function, pass paket down the network stack.
@@ -83,6 +102,55 @@ static int _send(gnrc_pktsnip_t *pkt)
     return 0;
 }
 
+/**
+ * @brief Search the TCB list for the TCB of an incoming segment.
+ *
+ * @pre `_list_tcb_lock` is locked.
+ *
+ * @param[in] ip       Network layer header of the segment.
+ * @param[in] src      Source port of the segment.
+ * @param[in] dst      Destination port of the segment.
+ * @param[in] listen   Search for a listening TCB instead of the TCB of an
+ *                     existing connection.
+ *
+ * @returns   The matching TCB.
+ *            NULL if there is no matching TCB.
+ */
+static gnrc_tcp_tcb_t *_find_tcb(gnrc_pktsnip_t *ip, uint16_t src, uint16_t dst, bool listen)
+{
+    gnrc_tcp_tcb_t *tcb = _list_tcb_head;
+
+    while (tcb) {
+#ifdef MODULE_GNRC_IPV6
+        if (ip->type == GNRC_NETTYPE_IPV6 && tcb->address_family == AF_INET6 &&
+            tcb->local_port == dst && (tcb->state == FSM_STATE_LISTEN) == listen) {
+            ipv6_hdr_t *ip6 = (ipv6_hdr_t *)ip->data;
+
+            /* A listening TCB accepts its local addr or any if it is unspecified */
+            if (listen) {
+                if (ipv6_addr_equal((ipv6_addr_t *) tcb->local_addr, &ip6->dst) ||
+                    ipv6_addr_is_unspecified((ipv6_addr_t *) tcb->local_addr)) {
+                    return tcb;
+                }
+            }
+            /* A connected TCB needs the peers port and addr to match */
+            else if (tcb->peer_port == src &&
+                     ipv6_addr_equal((ipv6_addr_t *) tcb->peer_addr, &ip6->src)) {
+                return tcb;
+            }
+        }
+#else
+        /* Supress compiler warnings if TCP is build without network layer */
+        (void) ip;
+        (void) src;
+        (void) dst;
+        (void) listen;
+#endif
+        tcb = tcb->next;
+    }
+    return NULL;
+}
+
 /**
  * @brief Receive function, receive packet from network layer.
  *
@@ -165,46 +233,20 @@ static int _receive(gnrc_pktsnip_t *pkt)
     }
 
     /* Validate checksum */
-    if (byteorder_ntohs(hdr->checksum) != _pkt_calc_csum(tcp, ip, pkt)) {
+    if (!(gnrc_netif_hdr_get_flag(pkt) & GNRC_NETIF_HDR_FLAGS_CSUM_VALID) &&
+        (byteorder_ntohs(hdr->checksum) != _pkt_calc_csum(tcp, ip, pkt))) {
         DEBUG("gnrc_tcp_eventloop.c : _receive() : Invalid checksum\n");
         gnrc_pktbuf_release(pkt);
         return -EINVAL;
     }
 
-    /* Find TCB to for this packet */
+    /* Find TCB for this packet: A TCB of the same connection takes precedence, so that
+     * retransmitted SYNs reach the TCB already handling them. Listening TCBs only get
+     * SYNs of new connections. */
     mutex_lock(&_list_tcb_lock);
-    tcb = _list_tcb_head;
-    while (tcb) {
-#ifdef MODULE_GNRC_IPV6
-        /* Check if current TCB is fitting for the incomming packet */
-        if (ip->type == GNRC_NETTYPE_IPV6 && tcb->address_family == AF_INET6) {
-            /* If SYN is set, a connection is listening on that port ... */
-            ipv6_addr_t *tmp_addr = NULL;
-            if (syn && tcb->local_port == dst && tcb->state == FSM_STATE_LISTEN) {
-                /* ... and local addr is unspec or pre configured */
-                tmp_addr = &((ipv6_hdr_t *)ip->data)->dst;
-                if (ipv6_addr_equal((ipv6_addr_t *) tcb->local_addr, (ipv6_addr_t *) tmp_addr) ||
-                    ipv6_addr_is_unspecified((ipv6_addr_t *) tcb->local_addr)) {
-                    break;
-                }
-            }
-
-            /* If SYN is not set and the ports match ... */
-            if (!syn && tcb->local_port == dst && tcb->peer_port == src) {
-                /* .. and the IPv6 addresses match */
-                tmp_addr = &((ipv6_hdr_t * )ip->data)->src;
-                if (ipv6_addr_equal((ipv6_addr_t *) tcb->peer_addr, (ipv6_addr_t *) tmp_addr)) {
-                    break;
-                }
-            }
-        }
-#else
-        /* Supress compiler warnings if TCP is build without network layer */
-        (void) syn;
-        (void) src;
-        (void) dst;
-#endif
-        tcb = tcb->next;
+    tcb = _find_tcb(ip, src, dst, false);
+    if (tcb == NULL && syn) {
+        tcb = _find_tcb(ip, src, dst, true);
     }
     mutex_unlock(&_list_tcb_lock);
 
@@ -217,7 +259,7 @@ static int _receive(gnrc_pktsnip_t *pkt)
         DEBUG("gnrc_tcp_eventloop.c : _receive() : Can't find fitting tcb\n");
         if ((ctl & MSK_RST) != MSK_RST) {
             _pkt_build_reset_from_pkt(&reset, pkt);
-            gnrc_netapi_send(gnrc_tcp_pid, reset);
+            _eventloop_send(reset);
         }
         return -ENOTCONN;
     }
@@ -225,18 +267,141 @@ static int _receive(gnrc_pktsnip_t *pkt)
     return 0;
 }
 
+/**
+ * @brief Handles a message for GNRC TCP.
+ *
+ * @param[in] msg   The message.
+ */
+static void _handle_msg(msg_t *msg)
+{
+    switch (msg->type) {
+        /* Pass message up the network stack */
+        case GNRC_NETAPI_MSG_TYPE_RCV:
+            DEBUG("gnrc_tcp_eventloop.c : _handle_msg() : GNRC_NETAPI_MSG_TYPE_RCV\n");
+            _receive((gnrc_pktsnip_t *)msg->content.ptr);
+            break;
+
+        /* Pass message down the network stack */
+        case GNRC_NETAPI_MSG_TYPE_SND:
+            DEBUG("gnrc_tcp_eventloop.c : _handle_msg() : GNRC_NETAPI_MSG_TYPE_SND\n");
+            _send((gnrc_pktsnip_t *)msg->content.ptr);
+            break;
+
+        /* Reply to option set and set messages*/
+        case GNRC_NETAPI_MSG_TYPE_SET:
+        case GNRC_NETAPI_MSG_TYPE_GET: {
+            msg_t reply = { .type = GNRC_NETAPI_MSG_TYPE_ACK,
+                            .content = { .value = (uint32_t)-ENOTSUP } };
+
+            msg_reply(msg, &reply);
+            break;
+        }
+
+        /* Retransmission timer expired: Call FSM with retransmission event */
+        case MSG_TYPE_RETRANSMISSION:
+            DEBUG("gnrc_tcp_eventloop.c : _handle_msg() : MSG_TYPE_RETRANSMISSION\n");
+            _fsm((gnrc_tcp_tcb_t *)msg->content.ptr, FSM_EVENT_TIMEOUT_RETRANSMIT,
+                 NULL, NULL, 0);
+            break;
+
+        /* Timewait timer expired: Call FSM with timewait event */
+        case MSG_TYPE_TIMEWAIT:
+            DEBUG("gnrc_tcp_eventloop.c : _handle_msg() : MSG_TYPE_TIMEWAIT\n");
+            _fsm((gnrc_tcp_tcb_t *)msg->content.ptr, FSM_EVENT_TIMEOUT_TIMEWAIT,
+                 NULL, NULL, 0);
+            break;
+
+        /* Delayed ACK timer expired: Call FSM with delayed ACK event */
+        case MSG_TYPE_DELAYED_ACK:
+            DEBUG("gnrc_tcp_eventloop.c : _handle_msg() : MSG_TYPE_DELAYED_ACK\n");
+            _fsm((gnrc_tcp_tcb_t *)msg->content.ptr, FSM_EVENT_TIMEOUT_DELAYED_ACK,
+                 NULL, NULL, 0);
+            break;
+
+        default:
+            DEBUG("gnrc_tcp_eventloop.c : _handle_msg() : received unexpected message\n");
+    }
+}
+
+int _eventloop_send(gnrc_pktsnip_t *pkt)
+{
+#ifdef MODULE_GNRC_EVENTLOOP
+    if (gnrc_eventloop_put(&_layer, GNRC_NETAPI_MSG_TYPE_SND, pkt) < 1) {
+        DEBUG("gnrc_tcp_eventloop.c : _eventloop_send() : mailbox full\n");
+        gnrc_pktbuf_release(pkt);
+        return -ENOBUFS;
+    }
+#else
+    if (gnrc_netapi_send(gnrc_tcp_pid, pkt) < 1) {
+        DEBUG("gnrc_tcp_eventloop.c : _eventloop_send() : message queue full\n");
+        gnrc_pktbuf_release(pkt);
+        return -ENOBUFS;
+    }
+#endif
+    return 0;
+}
+
+#ifdef MODULE_GNRC_EVENTLOOP
+/**
+ * @brief Handles an expired timer of a TCB in the shared GNRC thread.
+ *
+ * @param[in] event   The event of the timer.
+ */
+static void _handle_timeout(event_t *event)
+{
+    gnrc_tcp_timer_t *timer = (gnrc_tcp_timer_t *)event;
+
+    _handle_msg(&timer->msg);
+}
+
+void _eventloop_set_timer(gnrc_tcp_tcb_t *tcb, gnrc_tcp_timer_t *timer,
+                          uint32_t offset, uint16_t type)
+{
+    /* An expired timeout that was not handled yet is overridden */
+    _eventloop_remove_timer(timer);
+    timer->msg.type = type;
+    timer->msg.content.ptr = (void *)tcb;
+    timer->super.handler = _handle_timeout;
+    gnrc_eventloop_timeout_init(&timer->timeout, &timer->super);
+    event_timeout_set(&timer->timeout, offset);
+}
+
+void _eventloop_remove_timer(gnrc_tcp_timer_t *timer)
+{
+    event_timeout_clear(&timer->timeout);
+    gnrc_eventloop_cancel(&timer->super);
+}
+
+kernel_pid_t _eventloop_init(void)
+{
+    gnrc_tcp_pid = gnrc_eventloop_init();
+    /* The timers of TCP post events, so it handles no message types of its own */
+    gnrc_eventloop_register(&_layer, _layer_queue, TCP_EVENTLOOP_MSG_QUEUE_SIZE,
+                            _handle_msg, 1U, 0U);
+    gnrc_netreg_register(GNRC_NETTYPE_TCP, &_netreg);
+    return gnrc_tcp_pid;
+}
+#else
+void _eventloop_set_timer(gnrc_tcp_tcb_t *tcb, gnrc_tcp_timer_t *timer,
+                          uint32_t offset, uint16_t type)
+{
+    timer->msg.type = type;
+    timer->msg.content.ptr = (void *)tcb;
+    xtimer_set_msg(&timer->timer, offset, &timer->msg, gnrc_tcp_pid);
+}
+
+void _eventloop_remove_timer(gnrc_tcp_timer_t *timer)
+{
+    xtimer_remove(&timer->timer);
+}
+
 void *_event_loop(__attribute__((unused)) void *arg)
 {
     msg_t msg;
-    msg_t reply;
 
     /* Store pid */
     gnrc_tcp_pid = thread_getpid();
 
-    /* Setup reply message */
-    reply.type = GNRC_NETAPI_MSG_TYPE_ACK;
-    reply.content.value = (uint32_t)-ENOTSUP;
-
     /* Init message queue */
     msg_init_queue(_eventloop_msg_queue, TCP_EVENTLOOP_MSG_QUEUE_SIZE);
 
@@ -248,43 +413,9 @@ void *_event_loop(__attribute__((unused)) void *arg)
     /* dispatch NETAPI messages */
     while (1) {
         msg_receive(&msg);
-        switch (msg.type) {
-            /* Pass message up the network stack */
-            case GNRC_NETAPI_MSG_TYPE_RCV:
-                DEBUG("gnrc_tcp_eventloop.c : _event_loop() : GNRC_NETAPI_MSG_TYPE_RCV\n");
-                _receive((gnrc_pktsnip_t *)msg.content.ptr);
-                break;
-
-            /* Pass message down the network stack */
-            case GNRC_NETAPI_MSG_TYPE_SND:
-                DEBUG("gnrc_tcp_eventloop.c : _event_loop() : GNRC_NETAPI_MSG_TYPE_SND\n");
-                _send((gnrc_pktsnip_t *)msg.content.ptr);
-                break;
-
-            /* Reply to option set and set messages*/
-            case GNRC_NETAPI_MSG_TYPE_SET:
-            case GNRC_NETAPI_MSG_TYPE_GET:
-                msg_reply(&msg, &reply);
-                break;
-
-            /* Retransmission timer expired: Call FSM with retransmission event */
-            case MSG_TYPE_RETRANSMISSION:
-                DEBUG("gnrc_tcp_eventloop.c : _event_loop() : MSG_TYPE_RETRANSMISSION\n");
-                _fsm((gnrc_tcp_tcb_t *)msg.content.ptr, FSM_EVENT_TIMEOUT_RETRANSMIT,
-                     NULL, NULL, 0);
-                break;
-
-            /* Timewait timer expired: Call FSM with timewait event */
-            case MSG_TYPE_TIMEWAIT:
-                DEBUG("gnrc_tcp_eventloop.c : _event_loop() : MSG_TYPE_TIMEWAIT\n");
-                _fsm((gnrc_tcp_tcb_t *)msg.content.ptr, FSM_EVENT_TIMEOUT_TIMEWAIT,
-                     NULL, NULL, 0);
-                break;
-
-            default:
-                DEBUG("gnrc_tcp_eventloop.c : _event_loop() : received expected message\n");
-        }
+        _handle_msg(&msg);
     }
     /* Never reached */
     return NULL;
 }
+#endif
@@ -19,10 +19,12 @@
 
 #include <utlist.h>
 #include <errno.h>
+#include <string.h>
 #include "random.h"
 #include "net/af.h"
 #include "net/gnrc.h"
 #include "internal/common.h"
+#include "internal/eventloop.h"
 #include "internal/pkt.h"
 #include "internal/option.h"
 #include "internal/rcvbuf.h"
@@ -83,14 +85,334 @@ static uint16_t _get_random_local_port(void)
  */
 static int _clear_retransmit(gnrc_tcp_tcb_t *tcb)
 {
-    if (tcb->pkt_retransmit != NULL) {
-        gnrc_pktbuf_release(tcb->pkt_retransmit);
-        xtimer_remove(&(tcb->tim_tout));
-        tcb->pkt_retransmit = NULL;
+    if (tcb->pkt_retransmit_num > 0) {
+        for (uint8_t i = 0; i < tcb->pkt_retransmit_num; i++) {
+            gnrc_pktbuf_release(tcb->pkt_retransmit[i]);
+        }
+        _eventloop_remove_timer(&(tcb->tim_tout));
+        tcb->pkt_retransmit_num = 0;
     }
+    tcb->pkt_sacked = 0;
+    tcb->pkt_rexmit = 0;
+    tcb->status &= ~STATUS_RTT_MEASURE;
     return 0;
 }
 
+/**
+ * @brief Retransmits the oldest packet in the retransmit queue that is considered lost,
+ *        without backing off the retransmission timer.
+ *
+ * @note The oldest packet is always considered lost. Other packets are considered lost if
+ *       a later packet was selectively acknowledged. Every packet is retransmitted only
+ *       once per recovery.
+ *
+ * @param[in,out] tcb   TCB holding the retransmit queue.
+ */
+static void _retransmit_hole(gnrc_tcp_tcb_t *tcb)
+{
+    for (uint8_t i = 0; i < tcb->pkt_retransmit_num; i++) {
+        uint32_t bit = (1UL << i);
+
+        if ((tcb->pkt_sacked & bit) || (tcb->pkt_rexmit & bit)) {
+            continue;
+        }
+        if (i > 0 && (tcb->pkt_sacked >> i) == 0) {
+            return;
+        }
+        tcb->pkt_rexmit |= bit;
+
+        /* Every send attempt consumes a user */
+        gnrc_pktbuf_hold(tcb->pkt_retransmit[i], 1);
+        _pkt_send(tcb, tcb->pkt_retransmit[i], 0, true);
+        return;
+    }
+}
+
+/**
+ * @brief Copies the payload of a received packet, that was not received yet, into the
+ *        receive buffer.
+ *
+ * @param[in,out] tcb       TCB holding the connection information.
+ * @param[in]     pkt       Received packet, must not start after rcv_nxt.
+ * @param[in]     seg_seq   Sequence number of @p pkt.
+ */
+static void _rcv_payload(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const uint32_t seg_seq)
+{
+    gnrc_pktsnip_t *snp = NULL;
+    uint32_t skip = tcb->rcv_nxt - seg_seq;
+
+    LL_SEARCH_SCALAR(pkt, snp, type, GNRC_NETTYPE_UNDEF);
+    while (snp && snp->type == GNRC_NETTYPE_UNDEF) {
+        if (skip < snp->size) {
+            tcb->rcv_nxt += ringbuffer_add(&(tcb->rcv_buf), (char *) snp->data + skip,
+                                           snp->size - skip);
+            skip = 0;
+        }
+        else {
+            skip -= snp->size;
+        }
+        snp = snp->next;
+    }
+}
+
+/**
+ * @brief Keeps a packet that was received out of order until the data in front of it
+ *        was received.
+ *
+ * @param[in,out] tcb       TCB holding the connection information.
+ * @param[in]     pkt       Received packet.
+ * @param[in]     seg_seq   Sequence number of @p pkt.
+ */
+static void _rcv_ooo_add(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const uint32_t seg_seq)
+{
+    uint8_t pos = 0;
+
+    /* Keep queue ordered by sequence number, drop duplicates */
+    while (pos < tcb->pkt_ooo_num) {
+        uint32_t seq = _pkt_get_seq_num(tcb->pkt_ooo[pos]);
+        if (seq == seg_seq) {
+            return;
+        }
+        if (LSS_32_BIT(seg_seq, seq)) {
+            break;
+        }
+        pos++;
+    }
+    if (tcb->pkt_ooo_num >= GNRC_TCP_OOO_QUEUE_SIZE) {
+        DEBUG("gnrc_tcp_fsm.c : _rcv_ooo_add() : Out of order queue is full\n");
+        return;
+    }
+    gnrc_pktbuf_hold(pkt, 1);
+    memmove(&tcb->pkt_ooo[pos + 1], &tcb->pkt_ooo[pos],
+            (tcb->pkt_ooo_num - pos) * sizeof(tcb->pkt_ooo[0]));
+    tcb->pkt_ooo[pos] = pkt;
+    tcb->pkt_ooo_num++;
+}
+
+/**
+ * @brief Moves packets that were received out of order into the receive buffer, as soon
+ *        as they are in order.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+static void _rcv_ooo_drain(gnrc_tcp_tcb_t *tcb)
+{
+    uint8_t used = 0;
+
+    while (used < tcb->pkt_ooo_num) {
+        gnrc_pktsnip_t *pkt = tcb->pkt_ooo[used];
+        uint32_t seq = _pkt_get_seq_num(pkt);
+
+        /* Data in front of pkt is still missing */
+        if (LSS_32_BIT(tcb->rcv_nxt, seq)) {
+            break;
+        }
+        if (LSS_32_BIT(tcb->rcv_nxt, seq + _pkt_get_pay_len(pkt))) {
+            _rcv_payload(tcb, pkt, seq);
+        }
+        gnrc_pktbuf_release(pkt);
+        used++;
+    }
+    tcb->pkt_ooo_num -= used;
+    memmove(&tcb->pkt_ooo[0], &tcb->pkt_ooo[used], tcb->pkt_ooo_num * sizeof(tcb->pkt_ooo[0]));
+}
+
+/**
+ * @brief Clears packets that were received out of order.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+static void _rcv_ooo_clear(gnrc_tcp_tcb_t *tcb)
+{
+    for (uint8_t i = 0; i < tcb->pkt_ooo_num; i++) {
+        gnrc_pktbuf_release(tcb->pkt_ooo[i]);
+    }
+    tcb->pkt_ooo_num = 0;
+}
+
+/**
+ * @brief Gets the sender maximum segment size (SMSS) of a connection.
+ *
+ * @param[in] tcb   TCB holding the connection information.
+ *
+ * @returns   The smaller one of the peers MSS and our MSS.
+ */
+static uint32_t _smss(const gnrc_tcp_tcb_t *tcb)
+{
+    return (tcb->mss > 0 && tcb->mss < GNRC_TCP_MSS) ? tcb->mss : GNRC_TCP_MSS;
+}
+
+/**
+ * @brief Gets the largest send window a peer can announce.
+ *
+ * @param[in] tcb   TCB holding the connection information.
+ *
+ * @returns   The largest possible send window.
+ */
+static uint32_t _snd_wnd_max(const gnrc_tcp_tcb_t *tcb)
+{
+    return (uint32_t) UINT16_MAX << tcb->snd_wnd_scale;
+}
+
+/**
+ * @brief Sets the receive window to the free space in the receive buffer, as far as
+ *        it can be announced.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+static void _set_rcv_wnd(gnrc_tcp_tcb_t *tcb)
+{
+    uint32_t wnd_max = (uint32_t) UINT16_MAX << tcb->rcv_wnd_scale;
+    uint32_t wnd = ringbuffer_get_free(&(tcb->rcv_buf));
+
+    tcb->rcv_wnd = (wnd < wnd_max) ? wnd : wnd_max;
+}
+
+/**
+ * @brief Initializes congestion control (see RFC 5681, section 3.1).
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+static void _cong_init(gnrc_tcp_tcb_t *tcb)
+{
+    uint32_t smss = _smss(tcb);
+
+    /* Initial window */
+    if (smss > 2190) {
+        tcb->cwnd = 2 * smss;
+    }
+    else if (smss > 1095) {
+        tcb->cwnd = 3 * smss;
+    }
+    else {
+        tcb->cwnd = 4 * smss;
+    }
+    tcb->ssthresh = _snd_wnd_max(tcb);
+    tcb->dupacks = 0;
+    tcb->status &= ~(STATUS_RECOVERY | STATUS_FAST_RECOVERY);
+}
+
+/**
+ * @brief Updates the congestion window on acknowledgment of new data
+ *        (see RFC 5681, section 3.1 and RFC 6582).
+ *
+ * @pre snd_una was advanced by @p acked already.
+ *
+ * @param[in,out] tcb     TCB holding the connection information.
+ * @param[in]     acked   Number of newly acknowledged bytes.
+ */
+static void _cong_ack(gnrc_tcp_tcb_t *tcb, const uint32_t acked)
+{
+    uint32_t smss = _smss(tcb);
+
+    tcb->dupacks = 0;
+    if (tcb->status & STATUS_RECOVERY) {
+        /* Partial ACK: The next segment was lost as well, retransmit it without waiting
+         * for another timeout */
+        if (LSS_32_BIT(tcb->snd_una, tcb->recover)) {
+            _retransmit_hole(tcb);
+
+            /* Deflate by the acknowledged data, add back what the retransmission takes */
+            if (tcb->status & STATUS_FAST_RECOVERY) {
+                tcb->cwnd = (tcb->cwnd > acked) ? (tcb->cwnd - acked) : 0;
+                if (acked >= smss || tcb->cwnd < smss) {
+                    tcb->cwnd += smss;
+                }
+                return;
+            }
+        }
+        /* Full ACK: Leave recovery */
+        else {
+            tcb->status &= ~STATUS_RECOVERY;
+            if (tcb->status & STATUS_FAST_RECOVERY) {
+                uint32_t flight = tcb->snd_nxt - tcb->snd_una;
+
+                tcb->status &= ~STATUS_FAST_RECOVERY;
+                tcb->cwnd = (tcb->ssthresh < flight + smss) ? tcb->ssthresh : flight + smss;
+                return;
+            }
+        }
+    }
+
+    /* Slow start: Grow by up to one SMSS per ACK */
+    if (tcb->cwnd < tcb->ssthresh) {
+        tcb->cwnd += (acked < smss) ? acked : smss;
+    }
+    /* Congestion avoidance: Grow by about one SMSS per round trip */
+    else {
+        uint32_t inc = (smss * smss) / tcb->cwnd;
+        tcb->cwnd += (inc > 0) ? inc : 1;
+    }
+    if (tcb->cwnd > _snd_wnd_max(tcb)) {
+        tcb->cwnd = _snd_wnd_max(tcb);
+    }
+}
+
+/**
+ * @brief Closes the congestion window on a retransmission timeout
+ *        (see RFC 5681, section 3.1).
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+static void _cong_timeout(gnrc_tcp_tcb_t *tcb)
+{
+    uint32_t smss = _smss(tcb);
+    uint32_t flight = tcb->snd_nxt - tcb->snd_una;
+
+    /* Keep ssthresh if the same segment times out again */
+    if (tcb->retries == 0) {
+        tcb->ssthresh = (flight / 2 > 2 * smss) ? flight / 2 : 2 * smss;
+    }
+    tcb->cwnd = smss;
+
+    /* Everything sent up to now is suspect to be lost, SACK information could be outdated.
+     * The caller retransmits the oldest packet. */
+    tcb->recover = tcb->snd_nxt;
+    tcb->dupacks = 0;
+    tcb->pkt_sacked = 0;
+    tcb->pkt_rexmit = 1;
+    tcb->status |= STATUS_RECOVERY;
+    tcb->status &= ~STATUS_FAST_RECOVERY;
+}
+
+/**
+ * @brief Handles a duplicate ACK: Fast retransmit and fast recovery
+ *        (see RFC 5681, section 3.2 and RFC 6582).
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+static void _cong_dupack(gnrc_tcp_tcb_t *tcb)
+{
+    uint32_t smss = _smss(tcb);
+    uint32_t flight = tcb->snd_nxt - tcb->snd_una;
+
+    /* In fast recovery every duplicate ACK signals a segment that left the network.
+     * Selectively acknowledged segments tell which other segments were lost. */
+    if (tcb->status & STATUS_FAST_RECOVERY) {
+        tcb->cwnd += smss;
+        _retransmit_hole(tcb);
+        tcb->status |= STATUS_NOTIFY_USER;
+        return;
+    }
+
+    if (tcb->dupacks < UINT8_MAX) {
+        tcb->dupacks++;
+    }
+    /* Duplicate ACKs for data sent before a timeout don't trigger a fast retransmit */
+    if (tcb->dupacks < GNRC_TCP_DUPACK_THRESHOLD || (tcb->status & STATUS_RECOVERY)) {
+        return;
+    }
+
+    /* Fast retransmit, enter fast recovery */
+    tcb->ssthresh = (flight / 2 > 2 * smss) ? flight / 2 : 2 * smss;
+    tcb->recover = tcb->snd_nxt;
+    tcb->pkt_rexmit = 0;
+    tcb->status |= STATUS_RECOVERY | STATUS_FAST_RECOVERY;
+    _retransmit_hole(tcb);
+    tcb->cwnd = tcb->ssthresh + GNRC_TCP_DUPACK_THRESHOLD * smss;
+    tcb->status |= STATUS_NOTIFY_USER;
+}
+
 /**
  * @brief Restarts timewait timer.
  *
@@ -100,13 +422,158 @@ static int _clear_retransmit(gnrc_tcp_tcb_t *tcb)
  */
 static int _restart_timewait_timer(gnrc_tcp_tcb_t *tcb)
 {
-    xtimer_remove(&tcb->tim_tout);
-    tcb->msg_tout.type = MSG_TYPE_TIMEWAIT;
-    tcb->msg_tout.content.ptr = (void *)tcb;
-    xtimer_set_msg(&tcb->tim_tout, 2 * GNRC_TCP_MSL, &tcb->msg_tout, gnrc_tcp_pid);
+    _eventloop_set_timer(tcb, &tcb->tim_tout, 2 * GNRC_TCP_MSL, MSG_TYPE_TIMEWAIT);
     return 0;
 }
 
+/**
+ * @brief Acknowledges received data. Unless @p now is set, the ACK is delayed if no
+ *        earlier ACK is delayed already, so every second segment is acknowledged at
+ *        least (see RFC 1122, section 4.2.3.2).
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ * @param[in]     now   Send the ACK immediately.
+ */
+static void _snd_ack(gnrc_tcp_tcb_t *tcb, bool now)
+{
+    gnrc_pktsnip_t *out_pkt = NULL;
+    uint16_t seq_con = 0;
+
+    if (!now && (tcb->status & STATUS_DELAYED_ACK) && !(tcb->status & STATUS_ACK_PENDING)) {
+        tcb->status |= STATUS_ACK_PENDING;
+        _eventloop_set_timer(tcb, &tcb->tim_ack, GNRC_TCP_ACK_DELAY, MSG_TYPE_DELAYED_ACK);
+        return;
+    }
+    /* Sending the ACK clears a pending delayed ACK */
+    _pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK, tcb->snd_nxt, tcb->rcv_nxt, NULL, 0);
+    _pkt_send(tcb, out_pkt, seq_con, false);
+}
+
+/**
+ * @brief Discards data held back by Nagle's algorithm.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+static void _unsent_clear(gnrc_tcp_tcb_t *tcb)
+{
+    if (tcb->pkt_unsent != NULL) {
+        gnrc_pktbuf_release(tcb->pkt_unsent);
+        tcb->pkt_unsent = NULL;
+        tcb->unsent_len = 0;
+    }
+}
+
+/**
+ * @brief Appends data to the data held back by Nagle's algorithm.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ * @param[in]     buf   Data to append.
+ * @param[in]     len   Number of bytes in @p buf.
+ *
+ * @returns   Number of bytes appended, at most as many as fill up a segment.
+ */
+static size_t _unsent_append(gnrc_tcp_tcb_t *tcb, const uint8_t *buf, size_t len)
+{
+    if (tcb->pkt_unsent == NULL) {
+        tcb->pkt_unsent = gnrc_pktbuf_add(NULL, NULL, _smss(tcb), GNRC_NETTYPE_UNDEF);
+        if (tcb->pkt_unsent == NULL) {
+            DEBUG("gnrc_tcp_fsm.c : _unsent_append() : Can't allocate buffer\n");
+            return 0;
+        }
+        tcb->unsent_len = 0;
+    }
+    if (len > tcb->pkt_unsent->size - tcb->unsent_len) {
+        len = tcb->pkt_unsent->size - tcb->unsent_len;
+    }
+    memcpy((uint8_t *)tcb->pkt_unsent->data + tcb->unsent_len, buf, len);
+    tcb->unsent_len += len;
+    return len;
+}
+
+/**
+ * @brief Sends the data held back by Nagle's algorithm, as soon as everything sent
+ *        before was acknowledged or a full segment was collected (see RFC 1122,
+ *        section 4.2.3.4).
+ *
+ * @note The data is held back further, while the windows or the retransmit queue
+ *       do not allow sending it.
+ *
+ * @param[in,out] tcb     TCB holding the connection information.
+ * @param[in]     force   Send regardless of Nagle's algorithm, e.g. on close.
+ */
+static void _snd_unsent(gnrc_tcp_tcb_t *tcb, bool force)
+{
+    gnrc_pktsnip_t *out_pkt = NULL;
+    uint16_t seq_con = 0;
+    uint32_t wnd = 0;
+    uint32_t flight = 0;
+
+    if (tcb->pkt_unsent == NULL) {
+        return;
+    }
+    wnd = (tcb->snd_wnd < tcb->cwnd) ? tcb->snd_wnd : tcb->cwnd;
+    flight = tcb->snd_nxt - tcb->snd_una;
+    if (!force && (tcb->status & STATUS_NAGLE) && flight > 0 &&
+        tcb->unsent_len < tcb->pkt_unsent->size) {
+        return;
+    }
+    if (flight + tcb->unsent_len > wnd ||
+        tcb->pkt_retransmit_num >= GNRC_TCP_RETRANSMIT_QUEUE_SIZE) {
+        return;
+    }
+    if (_pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK | MSK_PSH, tcb->snd_nxt, tcb->rcv_nxt,
+                   tcb->pkt_unsent->data, tcb->unsent_len) < 0) {
+        return;
+    }
+    if (_pkt_setup_retransmit(tcb, out_pkt, false) < 0) {
+        gnrc_pktbuf_release(out_pkt);
+        return;
+    }
+    _pkt_send(tcb, out_pkt, seq_con, false);
+    _unsent_clear(tcb);
+}
+
+/**
+ * @brief Sends the FIN requested by the user. A FIN must be retransmitted until it is
+ *        acknowledged and follows all data, so it stays pending while data is held
+ *        back or the retransmit queue is full. It is sent as soon as an ACK allowed
+ *        both.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+static void _snd_fin(gnrc_tcp_tcb_t *tcb)
+{
+    gnrc_pktsnip_t *out_pkt = NULL;
+    uint16_t seq_con = 0;
+
+    if (!(tcb->status & STATUS_FIN_PENDING) || tcb->pkt_unsent != NULL ||
+        tcb->pkt_retransmit_num >= GNRC_TCP_RETRANSMIT_QUEUE_SIZE) {
+        return;
+    }
+    if (_pkt_build(tcb, &out_pkt, &seq_con, MSK_FIN_ACK, tcb->snd_nxt, tcb->rcv_nxt,
+                   NULL, 0) < 0) {
+        return;
+    }
+    if (_pkt_setup_retransmit(tcb, out_pkt, false) < 0) {
+        gnrc_pktbuf_release(out_pkt);
+        return;
+    }
+    _pkt_send(tcb, out_pkt, seq_con, false);
+    tcb->status &= ~STATUS_FIN_PENDING;
+}
+
+/**
+ * @brief Checks if our FIN was sent and everything up to it was acknowledged.
+ *
+ * @param[in] tcb   TCB holding the connection information.
+ *
+ * @returns   true if the FIN was acknowledged, false otherwise.
+ */
+static bool _fin_acked(const gnrc_tcp_tcb_t *tcb)
+{
+    return !(tcb->status & STATUS_FIN_PENDING) && tcb->snd_una == tcb->snd_nxt;
+}
+
 /**
  * @brief Transition from current FSM state into another state.
  *
@@ -123,8 +590,14 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
 
     switch (state) {
         case FSM_STATE_CLOSED:
-            /* Clear retransmit queue */
+            /* Clear retransmit queue and data received out of order */
             _clear_retransmit(tcb);
+            _rcv_ooo_clear(tcb);
+            _unsent_clear(tcb);
+
+            /* Stop delayed ACK timer, a FIN is not sent anymore */
+            tcb->status &= ~(STATUS_ACK_PENDING | STATUS_FIN_PENDING);
+            _eventloop_remove_timer(&(tcb->tim_ack));
 
             /* Remove connection from active connections */
             mutex_lock(&_list_tcb_lock);
@@ -191,8 +664,12 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
             mutex_unlock(&_list_tcb_lock);
             break;
 
-        case FSM_STATE_SYN_RCVD:
         case FSM_STATE_ESTABLISHED:
+            _cong_init(tcb);
+            tcb->status |= STATUS_NOTIFY_USER;
+            break;
+
+        case FSM_STATE_SYN_RCVD:
         case FSM_STATE_CLOSE_WAIT:
             tcb->status |= STATUS_NOTIFY_USER;
             break;
@@ -222,7 +699,13 @@ static int _fsm_call_open(gnrc_tcp_tcb_t *tcb)
     int ret = 0;
 
     DEBUG("gnrc_tcp_fsm.c : _fsm_call_open()\n");
-    tcb->rcv_wnd = GNRC_TCP_DEFAULT_WINDOW;
+
+    /* Forget about a previous connection using this TCB */
+    tcb->mss = 0;
+    tcb->retries = 0;
+    tcb->rtt_var = RTO_UNINITIALIZED;
+    tcb->srtt = RTO_UNINITIALIZED;
+    tcb->rto = RTO_UNINITIALIZED;
 
     if (tcb->status & STATUS_PASSIVE) {
         /* Passive open, T: CLOSED -> LISTEN */
@@ -230,6 +713,7 @@ static int _fsm_call_open(gnrc_tcp_tcb_t *tcb)
             _transition_to(tcb, FSM_STATE_CLOSED);
             return -ENOMEM;
         }
+        _set_rcv_wnd(tcb);
     }
     else {
         /* Active Open, set TCB values, send SYN, T: CLOSED -> SYN_SENT */
@@ -243,12 +727,20 @@ static int _fsm_call_open(gnrc_tcp_tcb_t *tcb)
             _transition_to(tcb, FSM_STATE_CLOSED);
             return ret;
         }
+        _set_rcv_wnd(tcb);
 
         /* Send SYN */
         gnrc_pktsnip_t *out_pkt = NULL;
         uint16_t seq_con = 0;
-        _pkt_build(tcb, &out_pkt, &seq_con, MSK_SYN, tcb->iss, 0, NULL, 0);
-        _pkt_setup_retransmit(tcb, out_pkt, false);
+        if (_pkt_build(tcb, &out_pkt, &seq_con, MSK_SYN, tcb->iss, 0, NULL, 0) < 0) {
+            _transition_to(tcb, FSM_STATE_CLOSED);
+            return -ENOMEM;
+        }
+        if (_pkt_setup_retransmit(tcb, out_pkt, false) < 0) {
+            gnrc_pktbuf_release(out_pkt);
+            _transition_to(tcb, FSM_STATE_CLOSED);
+            return -ENOMEM;
+        }
         _pkt_send(tcb, out_pkt, seq_con, false);
     }
     return ret;
@@ -257,6 +749,9 @@ static int _fsm_call_open(gnrc_tcp_tcb_t *tcb)
 /**
  * @brief FSM Handling function for sending data.
  *
+ * @note Sends as many segments as the send window, the congestion window and
+ *       the retransmit queue allow.
+ *
  * @param[in,out] tcb   TCB holding the connection information.
  * @param[in,out] buf   Buffer containing data to send.
  * @param[in]     len   Maximum Number of Bytes to send from @p buf.
@@ -267,24 +762,60 @@ static int _fsm_call_send(gnrc_tcp_tcb_t *tcb, void *buf, size_t len)
 {
     DEBUG("gnrc_tcp_fsm.c : _fsm_call_send()\n");
 
-    size_t payload = (tcb->snd_una + tcb->snd_wnd) - tcb->snd_nxt;
+    uint32_t smss = _smss(tcb);
+    size_t sent = 0;
+
+    /* Data held back before goes first: Fill up its segment with new data */
+    if (tcb->pkt_unsent != NULL) {
+        sent = _unsent_append(tcb, buf, len);
+        _snd_unsent(tcb, false);
+        if (tcb->pkt_unsent != NULL) {
+            return sent;
+        }
+    }
+
+    while (sent < len && tcb->pkt_retransmit_num < GNRC_TCP_RETRANSMIT_QUEUE_SIZE) {
+        uint32_t wnd = (tcb->snd_wnd < tcb->cwnd) ? tcb->snd_wnd : tcb->cwnd;
+        uint32_t flight = tcb->snd_nxt - tcb->snd_una;
+        size_t payload = len - sent;
 
-    /* Check if window is open and all packets were transmitted */
-    if (payload > 0 && tcb->snd_wnd > 0 && tcb->pkt_retransmit == NULL) {
         /* Calculate segment size */
-        payload = (payload < GNRC_TCP_MSS) ? payload : GNRC_TCP_MSS;
-        payload = (payload < tcb->mss) ? payload : tcb->mss;
-        payload = (payload < len) ? payload : len;
+        payload = (payload < smss) ? payload : smss;
+
+        /* Nagle: Hold back a small segment while sent data is unacknowledged */
+        if ((tcb->status & STATUS_NAGLE) && payload < smss && flight > 0) {
+            sent += _unsent_append(tcb, (uint8_t *) buf + sent, payload);
+            break;
+        }
+
+        /* Check if window is open */
+        if (flight >= wnd) {
+            break;
+        }
 
-        /* Calculate payload size for this segment */
+        /* Send less than that only if nothing is in flight: the next ACK opens the window */
+        if (payload > wnd - flight) {
+            if (flight > 0) {
+                break;
+            }
+            payload = wnd - flight;
+        }
+
+        /* Build, queue and send segment */
         gnrc_pktsnip_t *out_pkt = NULL;
         uint16_t seq_con = 0;
-        _pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK | MSK_PSH, tcb->snd_nxt, tcb->rcv_nxt, buf, payload);
-        _pkt_setup_retransmit(tcb, out_pkt, false);
+        if (_pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK | MSK_PSH, tcb->snd_nxt, tcb->rcv_nxt,
+                       (uint8_t *) buf + sent, payload) < 0) {
+            break;
+        }
+        if (_pkt_setup_retransmit(tcb, out_pkt, false) < 0) {
+            gnrc_pktbuf_release(out_pkt);
+            break;
+        }
         _pkt_send(tcb, out_pkt, seq_con, false);
-        return payload;
+        sent += payload;
     }
-    return 0;
+    return sent;
 }
 
 /**
@@ -309,7 +840,7 @@ static int _fsm_call_recv(gnrc_tcp_tcb_t *tcb, void *buf, size_t len)
 
     /* If receive buffer can store more than GNRC_TCP_MSS: open window to available buffer size */
     if (ringbuffer_get_free(&tcb->rcv_buf) >= GNRC_TCP_MSS) {
-        tcb->rcv_wnd = ringbuffer_get_free(&(tcb->rcv_buf));
+        _set_rcv_wnd(tcb);
 
         /* Send ACK to anounce window update */
         gnrc_pktsnip_t *out_pkt = NULL;
@@ -334,12 +865,12 @@ static int _fsm_call_close(gnrc_tcp_tcb_t *tcb)
     if (tcb->state == FSM_STATE_SYN_RCVD || tcb->state == FSM_STATE_ESTABLISHED ||
         tcb->state == FSM_STATE_CLOSE_WAIT) {
 
-        /* Send FIN packet */
-        gnrc_pktsnip_t *out_pkt = NULL;
-        uint16_t seq_con = 0;
-        _pkt_build(tcb, &out_pkt, &seq_con, MSK_FIN_ACK, tcb->snd_nxt, tcb->rcv_nxt, NULL, 0);
-        _pkt_setup_retransmit(tcb, out_pkt, false);
-        _pkt_send(tcb, out_pkt, seq_con, false);
+        /* Send data held back by Nagle's algorithm, as far as the windows allow */
+        _snd_unsent(tcb, true);
+
+        /* Send FIN packet, or defer it until the retransmit queue has room */
+        tcb->status |= STATUS_FIN_PENDING;
+        _snd_fin(tcb);
     }
 
     if (tcb->state == FSM_STATE_LISTEN) {
@@ -404,6 +935,7 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
     uint32_t seg_wnd = 0;            /* Receive window of the incomming packet */
     uint32_t seg_len = 0;            /* Segment length of the incomming packet */
     uint32_t pay_len = 0;            /* Payload length of the incomming packet */
+    bool ack_now = false;            /* Acknowledge payload without delay */
 
     DEBUG("gnrc_tcp_fsm.c : _fsm_rcvd_pkt()\n");
     /* Search for TCP header. */
@@ -421,6 +953,11 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
     seg_ack = byteorder_ntohl(tcp_hdr->ack_num);
     seg_wnd = byteorder_ntohs(tcp_hdr->window);
 
+    /* The window in a SYN is never scaled (see RFC 7323) */
+    if (!(ctl & MSK_SYN)) {
+        seg_wnd <<= tcb->snd_wnd_scale;
+    }
+
     /* Extract network layer header */
 #ifdef MODULE_GNRC_IPV6
     LL_SEARCH_SCALAR(in_pkt, snp, type, GNRC_NETTYPE_IPV6);
@@ -506,10 +1043,19 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
             tcb->snd_una = tcb->iss;
             tcb->snd_nxt = tcb->iss;
             tcb->snd_wnd = seg_wnd;
+            /* Window scaling was negotiated by the received SYN */
+            _set_rcv_wnd(tcb);
 
             /* Send SYN+ACK: seq_no = iss, ack_no = rcv_nxt, T: LISTEN -> SYN_RCVD */
-            _pkt_build(tcb, &out_pkt, &seq_con, MSK_SYN_ACK, tcb->iss, tcb->rcv_nxt, NULL, 0);
-            _pkt_setup_retransmit(tcb, out_pkt, false);
+            /* The peer retransmits its SYN, if there is no memory left for the SYN+ACK */
+            if (_pkt_build(tcb, &out_pkt, &seq_con, MSK_SYN_ACK, tcb->iss, tcb->rcv_nxt,
+                           NULL, 0) < 0) {
+                return 0;
+            }
+            if (_pkt_setup_retransmit(tcb, out_pkt, false) < 0) {
+                gnrc_pktbuf_release(out_pkt);
+                return 0;
+            }
             _pkt_send(tcb, out_pkt, seq_con, false);
             _transition_to(tcb, FSM_STATE_SYN_RCVD);
         }
@@ -555,6 +1101,9 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
             return 0;
 #endif
 
+            /* Window scaling was negotiated by the received SYN */
+            _set_rcv_wnd(tcb);
+
             /* SYN has been ACKed. Send ACK, T: SYN_SENT -> ESTABLISHED */
             if (tcb->snd_una > tcb->iss) {
                 _pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK, tcb->snd_nxt, tcb->rcv_nxt, NULL, 0);
@@ -563,8 +1112,15 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
             }
             /* Simultaneous SYN received. Send SYN+ACK, T: SYN_SENT -> SYN_RCVD */
             else {
-                _pkt_build(tcb, &out_pkt, &seq_con, MSK_SYN_ACK, tcb->iss, tcb->rcv_nxt, NULL, 0);
-                _pkt_setup_retransmit(tcb, out_pkt, false);
+                /* Our SYN is still queued for retransmission, so there is room for this */
+                if (_pkt_build(tcb, &out_pkt, &seq_con, MSK_SYN_ACK, tcb->iss, tcb->rcv_nxt,
+                               NULL, 0) < 0) {
+                    return 0;
+                }
+                if (_pkt_setup_retransmit(tcb, out_pkt, false) < 0) {
+                    gnrc_pktbuf_release(out_pkt);
+                    return 0;
+                }
                 _pkt_send(tcb, out_pkt, seq_con, false);
                 _transition_to(tcb, FSM_STATE_SYN_RCVD);
             }
@@ -632,8 +1188,20 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 tcb->state == FSM_STATE_CLOSING || tcb->state == FSM_STATE_LAST_ACK) {
                 /* Acknowledge previously sent data */
                 if (LSS_32_BIT(tcb->snd_una, seg_ack) && LEQ_32_BIT(seg_ack, tcb->snd_nxt)) {
+                    uint32_t acked = seg_ack - tcb->snd_una;
+
                     tcb->snd_una = seg_ack;
                     _pkt_acknowledge(tcb, seg_ack);
+                    _cong_ack(tcb, acked);
+
+                    /* Signal user after acknowledgment, the window may allow more data */
+                    tcb->status |= STATUS_NOTIFY_USER;
+                }
+                /* Duplicate ACK: The peer received a segment out of order */
+                else if (seg_ack == tcb->snd_una && pay_len == 0 &&
+                         !(ctl & (MSK_SYN | MSK_FIN)) && seg_wnd == tcb->snd_wnd &&
+                         tcb->pkt_retransmit_num > 0) {
+                    _cong_dupack(tcb);
                 }
                 /* ACK received for something not yet sent: Reply with pure ACK */
                 else if (LSS_32_BIT(tcb->snd_nxt, seg_ack)) {
@@ -657,25 +1225,25 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 /* Additional processing */
                 /* Check additionaly if previously sent FIN was acknowledged */
                 if (tcb->state == FSM_STATE_FIN_WAIT_1) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (_fin_acked(tcb)) {
                         _transition_to(tcb, FSM_STATE_FIN_WAIT_2);
                     }
                 }
-                /* If retransmission queue is empty, acknowledge close operation */
+                /* If everything was acknowledged, acknowledge close operation */
                 if (tcb->state == FSM_STATE_FIN_WAIT_2) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->snd_una == tcb->snd_nxt) {
                         /* Optional: Unblock user close operation */
                     }
                 }
                 /* If our FIN has been acknowledged: Transition to TIME_WAIT */
                 if (tcb->state == FSM_STATE_CLOSING) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (_fin_acked(tcb)) {
                         _transition_to(tcb, FSM_STATE_TIME_WAIT);
                     }
                 }
                 /* If our FIN was acknowledged and status is LAST_ACK: close connection */
                 if (tcb->state == FSM_STATE_LAST_ACK) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (_fin_acked(tcb)) {
                         _transition_to(tcb, FSM_STATE_CLOSED);
                         return 0;
                     }
@@ -690,36 +1258,54 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
             /* Check if state is valid for payload receiving */
             if (tcb->state == FSM_STATE_ESTABLISHED || tcb->state == FSM_STATE_FIN_WAIT_1 ||
                 tcb->state == FSM_STATE_FIN_WAIT_2) {
-                /* Search for begin of payload */
-                LL_SEARCH_SCALAR(in_pkt, snp, type, GNRC_NETTYPE_UNDEF);
-
-                /* Accept only data that is expected, to be received */
-                if (tcb->rcv_nxt == seg_seq) {
-                    /* Copy contents into receive buffer */
-                    while (snp && snp->type == GNRC_NETTYPE_UNDEF) {
-                        tcb->rcv_nxt += ringbuffer_add(&(tcb->rcv_buf), snp->data, snp->size);
-                        snp = snp->next;
-                    }
+                /* Accept data that continues the received data ... */
+                if (LEQ_32_BIT(seg_seq, tcb->rcv_nxt)) {
+                    /* Data that fills a gap is acknowledged immediately */
+                    ack_now = (tcb->pkt_ooo_num > 0);
+
+                    /* Copy contents into receive buffer, data received out of order
+                     * may follow now */
+                    _rcv_payload(tcb, in_pkt, seg_seq);
+                    _rcv_ooo_drain(tcb);
+
                     /* Shrink receive window */
-                    tcb->rcv_wnd = ringbuffer_get_free(&(tcb->rcv_buf));
+                    _set_rcv_wnd(tcb);
                     /* Notify owner because new data is available */
                     tcb->status |= STATUS_NOTIFY_USER;
                 }
-                /* Send ACK, if FIN processing sends ACK already */
-                /* NOTE: this is the place to add payload piggybagging in the future */
+                /* ... and keep data after a gap. The ACK below is a duplicate then, that
+                 * selectively acknowledges the kept data if SACK is permitted. */
+                else if (!(ctl & MSK_FIN)) {
+                    _rcv_ooo_add(tcb, in_pkt, seg_seq);
+                    ack_now = true;
+                }
+                /* Send ACK, if FIN processing sends ACK already. It may be delayed to be
+                 * piggybacked on data sent in the meantime. */
                 if (!(ctl & MSK_FIN)) {
-                    _pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK, tcb->snd_nxt, tcb->rcv_nxt,
-                               NULL, 0);
-                    _pkt_send(tcb, out_pkt, seq_con, false);
+                    _snd_ack(tcb, ack_now);
                 }
             }
         }
+        /* Send data held back and a pending FIN after it, the ACK may allow it now.
+         * After close, the data is not held back for Nagle's algorithm anymore. */
+        if (tcb->state == FSM_STATE_ESTABLISHED || tcb->state == FSM_STATE_CLOSE_WAIT ||
+            tcb->state == FSM_STATE_FIN_WAIT_1 || tcb->state == FSM_STATE_CLOSING ||
+            tcb->state == FSM_STATE_LAST_ACK) {
+            _snd_unsent(tcb, tcb->status & STATUS_FIN_PENDING);
+            _snd_fin(tcb);
+        }
         /* 7) Check FIN */
         if (ctl & MSK_FIN) {
             if (tcb->state == FSM_STATE_CLOSED || tcb->state == FSM_STATE_LISTEN ||
                 tcb->state == FSM_STATE_SYN_SENT) {
                 return 0;
             }
+            /* Data in front of the FIN is missing: Ignore FIN until it is retransmitted */
+            if (LSS_32_BIT(tcb->rcv_nxt, seg_seq + pay_len)) {
+                _pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK, tcb->snd_nxt, tcb->rcv_nxt, NULL, 0);
+                _pkt_send(tcb, out_pkt, seq_con, false);
+                return 0;
+            }
             /* Advance rcv_nxt over FIN bit */
             tcb->rcv_nxt = seg_seq + seg_len;
             _pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK, tcb->snd_nxt, tcb->rcv_nxt, NULL, 0);
@@ -729,7 +1315,7 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 _transition_to(tcb, FSM_STATE_CLOSE_WAIT);
             }
             else if (tcb->state == FSM_STATE_FIN_WAIT_1) {
-                if (tcb->pkt_retransmit == NULL) {
+                if (_fin_acked(tcb)) {
                     _transition_to(tcb, FSM_STATE_TIME_WAIT);
                 }
                 else {
@@ -771,9 +1357,17 @@ static int _fsm_timeout_timewait(gnrc_tcp_tcb_t *tcb)
 static int _fsm_timeout_retransmit(gnrc_tcp_tcb_t *tcb)
 {
     DEBUG("gnrc_tcp_fsm.c : _fsm_timeout_retransmit()\n");
-    if (tcb->pkt_retransmit != NULL) {
-        _pkt_setup_retransmit(tcb, tcb->pkt_retransmit, true);
-        _pkt_send(tcb, tcb->pkt_retransmit, 0, true);
+
+    /* Nobody waits for a half-open connection of a listen queue: Drop it eventually */
+    if (tcb->state == FSM_STATE_SYN_RCVD && tcb->queue != NULL &&
+        tcb->retries >= GNRC_TCP_SYN_ACK_RETRIES) {
+        _transition_to(tcb, FSM_STATE_CLOSED);
+        return 0;
+    }
+    if (tcb->pkt_retransmit_num > 0) {
+        _cong_timeout(tcb);
+        _pkt_setup_retransmit(tcb, tcb->pkt_retransmit[0], true);
+        _pkt_send(tcb, tcb->pkt_retransmit[0], 0, true);
     }
     else {
         DEBUG("gnrc_tcp_fsm.c : _fsm_timeout_retransmit() : Retransmit queue is empty\n");
@@ -795,6 +1389,24 @@ static int _fsm_timeout_connection(gnrc_tcp_tcb_t *tcb)
     return 0;
 }
 
+/**
+ * @brief FSM handling function for delayed ACKs.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ *
+ * @returns   Zero on success.
+ */
+static int _fsm_timeout_delayed_ack(gnrc_tcp_tcb_t *tcb)
+{
+    DEBUG("gnrc_tcp_fsm.c : _fsm_timeout_delayed_ack()\n");
+
+    /* The ACK might have been piggybacked in the meantime */
+    if (tcb->status & STATUS_ACK_PENDING) {
+        _snd_ack(tcb, true);
+    }
+    return 0;
+}
+
 /**
  * @brief FSM handling function for probe sending.
  *
@@ -877,6 +1489,9 @@ static int _fsm_unprotected(gnrc_tcp_tcb_t *tcb, fsm_event_t event, gnrc_pktsnip
         case FSM_EVENT_TIMEOUT_CONNECTION :
             ret = _fsm_timeout_connection(tcb);
             break;
+        case FSM_EVENT_TIMEOUT_DELAYED_ACK :
+            ret = _fsm_timeout_delayed_ack(tcb);
+            break;
         case FSM_EVENT_SEND_PROBE :
             ret = _fsm_send_probe(tcb);
             break;
@@ -902,6 +1517,21 @@ int _fsm(gnrc_tcp_tcb_t *tcb, fsm_event_t event, gnrc_pktsnip_t *in_pkt, void *b
         msg.type = MSG_TYPE_NOTIFY_USER;
         mbox_try_put(&(tcb->mbox), &msg);
     }
+
+    /* The listen queue takes care of its TCBs until they are accepted */
+    if (tcb->queue != NULL && !(tcb->status & STATUS_ACCEPTED) && event != FSM_EVENT_CALL_OPEN) {
+        /* Connection attempt failed: Listen again */
+        if (tcb->state == FSM_STATE_CLOSED) {
+            _fsm_call_open(tcb);
+        }
+        /* Connection established: Notify accepting thread */
+        else if ((tcb->status & STATUS_NOTIFY_USER) && (tcb->state == FSM_STATE_ESTABLISHED ||
+                                                        tcb->state == FSM_STATE_CLOSE_WAIT)) {
+            msg_t msg;
+            msg.type = MSG_TYPE_NOTIFY_USER;
+            mbox_try_put(&(tcb->queue->mbox), &msg);
+        }
+    }
     /* Unlock FSM */
     mutex_unlock(&(tcb->fsm_lock));
     return result;
@@ -17,15 +17,41 @@
  * @}
  */
 #include "internal/common.h"
+#include "internal/fsm.h"
 #include "internal/option.h"
+#include "internal/pkt.h"
+#include "internal/rcvbuf.h"
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
+/**
+ * @brief Reads an unaligned 32 bit value in network byte order from an option.
+ *
+ * @param[in] buf   Pointer to the value.
+ *
+ * @returns   The value in host byte order.
+ */
+static inline uint32_t _get_u32(const uint8_t *buf)
+{
+    return ((uint32_t) buf[0] << 24) | ((uint32_t) buf[1] << 16) |
+           ((uint32_t) buf[2] << 8) | buf[3];
+}
+
 int _option_parse(gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr)
 {
+    /* A new connection negotiates SACK and window scaling anew */
+    uint16_t ctl = byteorder_ntohs(hdr->off_ctl);
+    bool syn = (ctl & MSK_SYN) &&
+               (tcb->state == FSM_STATE_LISTEN || tcb->state == FSM_STATE_SYN_SENT);
+    if (syn) {
+        tcb->status &= ~(STATUS_SACK_PERMITTED | STATUS_WND_SCALE);
+        tcb->snd_wnd_scale = 0;
+        tcb->rcv_wnd_scale = 0;
+    }
+
     /* Extract offset value. Return if no options are set */
-    uint8_t offset = GET_OFFSET(byteorder_ntohs(hdr->off_ctl));
+    uint8_t offset = GET_OFFSET(ctl);
     if (offset <= TCP_HDR_OFFSET_MIN) {
         return 0;
     }
@@ -50,6 +76,17 @@ int _option_parse(gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr)
                 opt_left -= 1;
                 continue;
 
+            default:
+                break;
+        }
+
+        /* All other options have a length field that must fit into the header */
+        if ((opt_left < 2) || (option->length < 2) || (option->length > opt_left)) {
+            DEBUG("gnrc_tcp_option.c : _option_parse() : invalid option length.\n");
+            return -1;
+        }
+
+        switch (option->kind) {
             case TCP_OPTION_KIND_MSS:
                 if (option->length != TCP_OPTION_LENGTH_MSS) {
                     DEBUG("gnrc_tcp_option.c : _option_parse() : invalid MSS Option length.\n");
@@ -60,6 +97,50 @@ int _option_parse(gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr)
                       tcb->mss);
                 break;
 
+            case TCP_OPTION_KIND_WND_SCALE:
+                if (option->length != TCP_OPTION_LENGTH_WND_SCALE) {
+                    DEBUG("gnrc_tcp_option.c : _option_parse() : invalid Window Scale Option\
+                          length.\n");
+                    return -1;
+                }
+                /* Both sides scale their windows, if both sent the option */
+                if (GNRC_TCP_WND_SCALE && syn) {
+                    tcb->status |= STATUS_WND_SCALE;
+                    tcb->snd_wnd_scale = (option->value[0] < WND_SCALE_MAX) ? option->value[0]
+                                                                            : WND_SCALE_MAX;
+                    tcb->rcv_wnd_scale = _rcvbuf_get_wnd_scale(tcb);
+                }
+                DEBUG("gnrc_tcp_option.c : _option_parse() : Window Scale option found.\
+                      SHIFT=%"PRIu8"\n", option->value[0]);
+                break;
+
+            case TCP_OPTION_KIND_SACK_PERM:
+                if (option->length != TCP_OPTION_LENGTH_SACK_PERM) {
+                    DEBUG("gnrc_tcp_option.c : _option_parse() : invalid SACK-Permitted Option\
+                          length.\n");
+                    return -1;
+                }
+                if (GNRC_TCP_SACK && syn) {
+                    tcb->status |= STATUS_SACK_PERMITTED;
+                }
+                DEBUG("gnrc_tcp_option.c : _option_parse() : SACK-Permitted option found.\n");
+                break;
+
+            case TCP_OPTION_KIND_SACK:
+                if ((option->length < 2 + TCP_OPTION_LENGTH_SACK_BLOCK) ||
+                    ((option->length - 2) % TCP_OPTION_LENGTH_SACK_BLOCK) != 0) {
+                    DEBUG("gnrc_tcp_option.c : _option_parse() : invalid SACK Option length.\n");
+                    return -1;
+                }
+                if (tcb->status & STATUS_SACK_PERMITTED) {
+                    for (uint8_t i = 0; i < option->length - 2; i += TCP_OPTION_LENGTH_SACK_BLOCK) {
+                        _pkt_sack(tcb, _get_u32(&option->value[i]),
+                                  _get_u32(&option->value[i + 4]));
+                    }
+                }
+                DEBUG("gnrc_tcp_option.c : _option_parse() : SACK option found.\n");
+                break;
+
             default:
                 DEBUG("gnrc_tcp_option.c : _option_parse() : Unknown option found.\
                       KIND=%"PRIu8", LENGTH=%"PRIu8"\n", option->kind, option->length);
@@ -23,8 +23,10 @@
 #include "net/inet_csum.h"
 #include "net/gnrc.h"
 #include "internal/common.h"
+#include "internal/eventloop.h"
 #include "internal/option.h"
 #include "internal/pkt.h"
+#include "internal/rcvbuf.h"
 
 #ifdef MODULE_GNRC_IPV6
 #include "net/gnrc/ipv6.h"
@@ -46,6 +48,71 @@ static inline uint32_t _max(const uint32_t x, const uint32_t y)
   return (x > y) ? x : y;
 }
 
+/**
+ * @brief Shifts a bitmap of the retransmit queue after packets were removed from it.
+ *
+ * @param[in] map   Bitmap to shift.
+ * @param[in] num   Number of packets removed from the front of the queue.
+ *
+ * @returns   Shifted bitmap.
+ */
+static inline uint32_t _shift_map(const uint32_t map, const uint8_t num)
+{
+    return (num < 32) ? (map >> num) : 0;
+}
+
+/**
+ * @brief Collects SACK blocks from the packets received out of order.
+ *
+ * @param[in]  tcb      TCB holding the connection information.
+ * @param[out] blocks   Left and right edges of the blocks.
+ *
+ * @returns   Number of blocks in @p blocks.
+ */
+static uint8_t _get_sack_blocks(gnrc_tcp_tcb_t *tcb, uint32_t *blocks)
+{
+    uint8_t num = 0;
+
+    for (uint8_t i = 0; i < tcb->pkt_ooo_num; i++) {
+        uint32_t left = _pkt_get_seq_num(tcb->pkt_ooo[i]);
+        uint32_t right = left + _pkt_get_pay_len(tcb->pkt_ooo[i]);
+
+        /* Merge adjacent and overlapping segments into one block */
+        if (num > 0 && LEQ_32_BIT(left, blocks[2 * num - 1])) {
+            if (LSS_32_BIT(blocks[2 * num - 1], right)) {
+                blocks[2 * num - 1] = right;
+            }
+            continue;
+        }
+        if (num == SACK_BLOCKS_MAX) {
+            break;
+        }
+        blocks[2 * num] = left;
+        blocks[2 * num + 1] = right;
+        num++;
+    }
+    return num;
+}
+
+/**
+ * @brief (Re-)starts the retransmission timer with the current RTO.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+static void _setup_retransmit_timer(gnrc_tcp_tcb_t *tcb)
+{
+    /* Perform boundry checks on current RTO before usage */
+    if (tcb->rto < (int32_t) GNRC_TCP_RTO_LOWER_BOUND) {
+        tcb->rto = GNRC_TCP_RTO_LOWER_BOUND;
+    }
+    else if (tcb->rto > (int32_t) GNRC_TCP_RTO_UPPER_BOUND) {
+        tcb->rto = GNRC_TCP_RTO_UPPER_BOUND;
+    }
+
+    /* Setup retransmission timer, handled in TCPs context with ptr to TCB */
+    _eventloop_set_timer(tcb, &tcb->tim_tout, tcb->rto, MSG_TYPE_RETRANSMISSION);
+}
+
 int _pkt_build_reset_from_pkt(gnrc_pktsnip_t **out_pkt, gnrc_pktsnip_t *in_pkt)
 {
     tcp_hdr_t tcp_hdr_out;
@@ -147,6 +214,11 @@ int _pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt, uint16_t *seq_con,
     gnrc_pktsnip_t *tcp_snp = NULL;
     tcp_hdr_t tcp_hdr;
     uint8_t offset = TCP_HDR_OFFSET_MIN;
+    uint32_t sack[2 * SACK_BLOCKS_MAX];
+    uint8_t sack_num = 0;
+    bool sack_perm = false;
+    bool wnd_scale = false;
+    uint32_t wnd = tcb->rcv_wnd;
 
     /* Add payload, if supplied */
     if (payload != NULL && payload_len > 0) {
@@ -164,13 +236,35 @@ int _pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt, uint16_t *seq_con,
     tcp_hdr.checksum = byteorder_htons(0);
     tcp_hdr.seq_num = byteorder_htonl(seq_num);
     tcp_hdr.ack_num = byteorder_htonl(ack_num);
-    tcp_hdr.window = byteorder_htons(tcb->rcv_wnd);
+    /* The window in a SYN is never scaled (see RFC 7323) */
+    if (!(ctl & MSK_SYN)) {
+        wnd >>= tcb->rcv_wnd_scale;
+    }
+    tcp_hdr.window = byteorder_htons((wnd < UINT16_MAX) ? wnd : UINT16_MAX);
     tcp_hdr.urgent_ptr = byteorder_htons(0);
 
     /* Calculate option field size. */
     /* Add MSS option if SYN is sent */
     if (ctl & MSK_SYN) {
         offset += 1;
+
+        /* Add SACK-Permitted option, on SYN+ACK only if the peer permitted it as well */
+        if (GNRC_TCP_SACK && (!(ctl & MSK_ACK) || (tcb->status & STATUS_SACK_PERMITTED))) {
+            sack_perm = true;
+            offset += 1;
+        }
+        /* Add window scale option, on SYN+ACK only if the peer sent it as well */
+        if (GNRC_TCP_WND_SCALE && (!(ctl & MSK_ACK) || (tcb->status & STATUS_WND_SCALE))) {
+            wnd_scale = true;
+            offset += 1;
+        }
+    }
+    /* Add SACK option if data was received out of order */
+    else if ((ctl & MSK_ACK) && (tcb->status & STATUS_SACK_PERMITTED)) {
+        sack_num = _get_sack_blocks(tcb, sack);
+        if (sack_num > 0) {
+            offset += 1 + 2 * sack_num;
+        }
     }
     /* Set offset and control bit accordingly */
     tcp_hdr.off_ctl = byteorder_htons(_option_build_offset_control(offset, ctl));
@@ -196,6 +290,34 @@ int _pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt, uint16_t *seq_con,
             if (ctl & MSK_SYN) {
                 network_uint32_t mss_option = byteorder_htonl(_option_build_mss(GNRC_TCP_MSS));
                 memcpy(opt_ptr, &mss_option, sizeof(mss_option));
+                opt_ptr += sizeof(mss_option);
+                opt_left -= sizeof(mss_option);
+            }
+            /* Add window scale option */
+            if (wnd_scale) {
+                network_uint32_t ws_option =
+                    byteorder_htonl(_option_build_wnd_scale(_rcvbuf_get_wnd_scale(tcb)));
+                memcpy(opt_ptr, &ws_option, sizeof(ws_option));
+                opt_ptr += sizeof(ws_option);
+                opt_left -= sizeof(ws_option);
+            }
+            /* Add SACK-Permitted option */
+            if (sack_perm) {
+                network_uint32_t sack_perm_option = byteorder_htonl(_option_build_sack_perm());
+                memcpy(opt_ptr, &sack_perm_option, sizeof(sack_perm_option));
+                opt_ptr += sizeof(sack_perm_option);
+                opt_left -= sizeof(sack_perm_option);
+            }
+            /* Add SACK option */
+            if (sack_num > 0) {
+                network_uint32_t sack_option = byteorder_htonl(_option_build_sack(sack_num));
+                memcpy(opt_ptr, &sack_option, sizeof(sack_option));
+                opt_ptr += sizeof(sack_option);
+                for (uint8_t i = 0; i < 2 * sack_num; i++) {
+                    network_uint32_t edge = byteorder_htonl(sack[i]);
+                    memcpy(opt_ptr, &edge, sizeof(edge));
+                    opt_ptr += sizeof(edge);
+                }
             }
             /* Increase opt_ptr and decrease opt_left, if other options are added */
             /* NOTE: Add additional options here */
@@ -255,23 +377,51 @@ int _pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt, uint16_t *seq_con,
 int _pkt_send(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *out_pkt, const uint16_t seq_con,
               const bool retransmit)
 {
+    gnrc_pktsnip_t *snp = NULL;
+    bool acks_all = false;
+
     if (out_pkt == NULL) {
         DEBUG("gnrc_tcp_pkt.c : _pkt_send() : Packet to send is null\n");
         return -EINVAL;
     }
 
+    /* Check if the segment acknowledges everything received so far, before
+     * the packet is handed over and may be released */
+    LL_SEARCH_SCALAR(out_pkt, snp, type, GNRC_NETTYPE_TCP);
+    if (snp != NULL) {
+        tcp_hdr_t *hdr = (tcp_hdr_t *) snp->data;
+        acks_all = (byteorder_ntohs(hdr->off_ctl) & MSK_ACK) &&
+                   (byteorder_ntohl(hdr->ack_num) == tcb->rcv_nxt);
+    }
+
     /* If this is no retransmission, advance sequence number and measure time */
     if (!retransmit) {
-        tcb->retries = 0;
+        /* Only one segment per round trip is timed */
+        if (seq_con > 0 && !(tcb->status & STATUS_RTT_MEASURE)) {
+            tcb->status |= STATUS_RTT_MEASURE;
+            tcb->rtt_start = xtimer_now().ticks32;
+            tcb->rtt_seq = tcb->snd_nxt + seq_con;
+        }
         tcb->snd_nxt += seq_con;
-        tcb->rtt_start = xtimer_now().ticks32;
     }
     else {
+        /* Don't take samples while retransmitting (Karns Algorithm) */
+        tcb->status &= ~STATUS_RTT_MEASURE;
         tcb->retries += 1;
     }
 
     /* Pass packet down the network stack */
-    gnrc_netapi_send(gnrc_tcp_pid, out_pkt);
+    if (_eventloop_send(out_pkt) < 0) {
+        DEBUG("gnrc_tcp_pkt.c : _pkt_send() : Packet was dropped\n");
+        return -ENOBUFS;
+    }
+
+    /* The segment was sent and acknowledges everything received so far:
+     * A delayed ACK is obsolete */
+    if (acks_all && (tcb->status & STATUS_ACK_PENDING)) {
+        tcb->status &= ~STATUS_ACK_PENDING;
+        _eventloop_remove_timer(&(tcb->tim_ack));
+    }
     return 0;
 }
 
@@ -339,6 +489,14 @@ uint32_t _pkt_get_pay_len(gnrc_pktsnip_t *pkt)
     return seg_len;
 }
 
+uint32_t _pkt_get_seq_num(gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktsnip_t *snp = NULL;
+
+    LL_SEARCH_SCALAR(pkt, snp, type, GNRC_NETTYPE_TCP);
+    return byteorder_ntohl(((tcp_hdr_t *) snp->data)->seq_num);
+}
+
 int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool retransmit)
 {
     gnrc_pktsnip_t *snp = NULL;
@@ -351,9 +509,16 @@ int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool r
         return -EINVAL;
     }
 
-    /* Check if retransmit queue is full and pkt is not already in retransmit queue */
-    if (tcb->pkt_retransmit != NULL && tcb->pkt_retransmit != pkt) {
-        DEBUG("gnrc_tcp_pkt.c : _pkt_setup_retransmit() : Nothing to do\n");
+    /* Only the oldest packet in the retransmit queue is retransmitted */
+    if (retransmit) {
+        if (tcb->pkt_retransmit_num == 0 || tcb->pkt_retransmit[0] != pkt) {
+            DEBUG("gnrc_tcp_pkt.c : _pkt_setup_retransmit() : pkt is not queued first\n");
+            return -EINVAL;
+        }
+    }
+    /* Check if retransmit queue is full */
+    else if (tcb->pkt_retransmit_num >= GNRC_TCP_RETRANSMIT_QUEUE_SIZE) {
+        DEBUG("gnrc_tcp_pkt.c : _pkt_setup_retransmit() : Retransmit queue is full\n");
         return -ENOMEM;
     }
 
@@ -367,18 +532,14 @@ int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool r
         return 0;
     }
 
-    /* Assign pkt and increase users: every send attempt consumes a user */
-    tcb->pkt_retransmit = pkt;
+    /* Increase users: every send attempt consumes a user */
     gnrc_pktbuf_hold(pkt, 1);
 
-    /* RTO adjustment */
     if (!retransmit) {
-        /* If this is the first transmission: rto is 1 sec (Lower Bound) */
-        if (tcb->srtt == RTO_UNINITIALIZED || tcb->rtt_var == RTO_UNINITIALIZED) {
-            tcb->rto = GNRC_TCP_RTO_LOWER_BOUND;
-        }
-        else {
-            tcb->rto = tcb->srtt + _max(GNRC_TCP_RTO_GRANULARITY,  GNRC_TCP_RTO_K * tcb->rtt_var);
+        /* Append pkt to the queue. The timer is already running for older packets */
+        tcb->pkt_retransmit[tcb->pkt_retransmit_num++] = pkt;
+        if (tcb->pkt_retransmit_num > 1) {
+            return 0;
         }
     }
     else {
@@ -392,51 +553,48 @@ int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool r
             tcb->rtt_var = RTO_UNINITIALIZED;
         }
     }
-
-    /* Perform boundry checks on current RTO before usage */
-    if (tcb->rto < (int32_t) GNRC_TCP_RTO_LOWER_BOUND) {
-        tcb->rto = GNRC_TCP_RTO_LOWER_BOUND;
-    }
-    else if (tcb->rto > (int32_t) GNRC_TCP_RTO_UPPER_BOUND) {
-        tcb->rto = GNRC_TCP_RTO_UPPER_BOUND;
-    }
-
-    /* Setup retransmission timer, msg to TCP thread with ptr to TCB */
-    tcb->msg_tout.type = MSG_TYPE_RETRANSMISSION;
-    tcb->msg_tout.content.ptr = (void *) tcb;
-    xtimer_set_msg(&tcb->tim_tout, tcb->rto, &tcb->msg_tout, gnrc_tcp_pid);
+    _setup_retransmit_timer(tcb);
     return 0;
 }
 
 int _pkt_acknowledge(gnrc_tcp_tcb_t *tcb, const uint32_t ack)
 {
     uint32_t seg = 0;
-    gnrc_pktsnip_t *snp = NULL;
-    tcp_hdr_t *hdr;
+    uint8_t acked = 0;
 
     /* Retransmission queue is empty. Nothing to ACK there */
-    if (tcb->pkt_retransmit == NULL) {
+    if (tcb->pkt_retransmit_num == 0) {
         DEBUG("gnrc_tcp_pkt.c : _pkt_acknowledge() : There is no packet to ack\n");
         return -ENODATA;
     }
 
-    LL_SEARCH_SCALAR(tcb->pkt_retransmit, snp, type, GNRC_NETTYPE_TCP);
-    hdr = (tcp_hdr_t *) snp->data;
-
-    /* There must be a packet, waiting to be acknowledged. */
-    seg = byteorder_ntohl(hdr->seq_num) + _pkt_get_seg_len(tcb->pkt_retransmit) - 1;
-
-    /* If segment can be acknowledged -> stop timer, release packet from pktbuf and update rto. */
-    if (LSS_32_BIT(seg, ack)) {
-        xtimer_remove(&(tcb->tim_tout));
-        gnrc_pktbuf_release(tcb->pkt_retransmit);
-        tcb->pkt_retransmit = NULL;
+    /* Release all packets that are acknowledged completely, starting with the oldest */
+    while (acked < tcb->pkt_retransmit_num) {
+        seg = _pkt_get_seq_num(tcb->pkt_retransmit[acked]) +
+              _pkt_get_seg_len(tcb->pkt_retransmit[acked]) - 1;
+        if (!LSS_32_BIT(seg, ack)) {
+            break;
+        }
+        gnrc_pktbuf_release(tcb->pkt_retransmit[acked]);
+        acked++;
+    }
+    if (acked == 0) {
+        return 0;
+    }
+    tcb->pkt_retransmit_num -= acked;
+    memmove(&tcb->pkt_retransmit[0], &tcb->pkt_retransmit[acked],
+            tcb->pkt_retransmit_num * sizeof(tcb->pkt_retransmit[0]));
+    tcb->pkt_sacked = _shift_map(tcb->pkt_sacked, acked);
+    tcb->pkt_rexmit = _shift_map(tcb->pkt_rexmit, acked);
+    tcb->retries = 0;
 
-        /* Measure round trip time */
+    /* Measure round trip time, if the timed segment was acknowledged */
+    if ((tcb->status & STATUS_RTT_MEASURE) && LEQ_32_BIT(tcb->rtt_seq, ack)) {
         int32_t rtt = xtimer_now().ticks32 - tcb->rtt_start;
 
-        /* Use time only if ther was no timer overflow and no retransmission (Karns Alogrithm) */
-        if (tcb->retries == 0 && rtt > 0) {
+        tcb->status &= ~STATUS_RTT_MEASURE;
+        /* Use time only if ther was no timer overflow */
+        if (rtt > 0) {
             /* If this is the first sample taken */
             if (tcb->srtt == RTO_UNINITIALIZED && tcb->rtt_var == RTO_UNINITIALIZED) {
                 tcb->srtt = rtt;
@@ -449,11 +607,33 @@ int _pkt_acknowledge(gnrc_tcp_tcb_t *tcb, const uint32_t ack)
                 tcb->srtt = (tcb->srtt / GNRC_TCP_RTO_A_DIV) * (GNRC_TCP_RTO_A_DIV-1);
                 tcb->srtt += rtt / GNRC_TCP_RTO_A_DIV;
             }
+            tcb->rto = tcb->srtt + _max(GNRC_TCP_RTO_GRANULARITY, GNRC_TCP_RTO_K * tcb->rtt_var);
         }
     }
+
+    /* Stop timer if everything was acknowledged, restart it for the remaining packets if not */
+    if (tcb->pkt_retransmit_num == 0) {
+        _eventloop_remove_timer(&(tcb->tim_tout));
+    }
+    else {
+        _setup_retransmit_timer(tcb);
+    }
     return 0;
 }
 
+void _pkt_sack(gnrc_tcp_tcb_t *tcb, const uint32_t left, const uint32_t right)
+{
+    for (uint8_t i = 0; i < tcb->pkt_retransmit_num; i++) {
+        uint32_t seq = _pkt_get_seq_num(tcb->pkt_retransmit[i]);
+
+        /* Mark packets that are covered by the block completely */
+        if (LEQ_32_BIT(left, seq) &&
+            LEQ_32_BIT(seq + _pkt_get_seg_len(tcb->pkt_retransmit[i]), right)) {
+            tcb->pkt_sacked |= (1UL << i);
+        }
+    }
+}
+
 uint16_t _pkt_calc_csum(const gnrc_pktsnip_t *hdr, const gnrc_pktsnip_t *pseudo_hdr,
                         const gnrc_pktsnip_t *payload)
 {
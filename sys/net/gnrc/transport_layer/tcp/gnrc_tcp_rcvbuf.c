@@ -16,11 +16,17 @@
  * @author      Simon Brummer <simon.brummer@posteo.de>
  */
 #include <errno.h>
+#include <string.h>
+#include "internal/common.h"
 #include "internal/rcvbuf.h"
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
+#if RCVBUF_BLOCKS == 0
+#error "GNRC_TCP_RCV_BUF_POOL_SIZE must hold at least one GNRC_TCP_RCV_BUF_BLOCK_SIZE"
+#endif
+
 /**
  * @brief Internal struct holding receive buffers.
  */
@@ -33,46 +39,70 @@ void _rcvbuf_init(void)
 {
     DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_init() : entry\n");
     mutex_init(&(_static_buf.lock));
-    for (size_t i = 0; i < GNRC_TCP_RCV_BUFFERS; ++i) {
-        _static_buf.entries[i].used = 0;
-    }
+    memset(_static_buf.used, 0, sizeof(_static_buf.used));
 }
 
 /**
  * @brief Allocate receive buffer.
  *
+ * @param[in,out] blocks   Number of requested blocks. Set to the number of allocated
+ *                         blocks, if less than requested were free in one piece.
+ *
  * @returns   Not NULL if a receive buffer was allocated.
  *            NULL if allocation failed.
  */
-static void* _rcvbuf_alloc(void)
+static void* _rcvbuf_alloc(size_t *blocks)
 {
-    void *result = NULL;
+    size_t best_start = 0;
+    size_t best_len = 0;
+    size_t start = 0;
+
     DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_alloc() : Entry\n");
     mutex_lock(&(_static_buf.lock));
-    for (size_t i = 0; i < GNRC_TCP_RCV_BUFFERS; ++i) {
-        if (_static_buf.entries[i].used == 0) {
-            _static_buf.entries[i].used = 1;
-            result = (void *)(_static_buf.entries[i].buffer);
-            break;
+
+    /* Search first free area that is large enough, or else the largest one */
+    for (size_t i = 0; i <= RCVBUF_BLOCKS; ++i) {
+        if (i < RCVBUF_BLOCKS && !bf_isset(_static_buf.used, i)) {
+            if (i - start + 1 >= *blocks) {
+                best_start = start;
+                best_len = *blocks;
+                break;
+            }
+            continue;
         }
+        if (i - start > best_len) {
+            best_start = start;
+            best_len = i - start;
+        }
+        start = i + 1;
+    }
+
+    for (size_t i = best_start; i < best_start + best_len; ++i) {
+        bf_set(_static_buf.used, i);
     }
     mutex_unlock(&(_static_buf.lock));
-    return result;
+
+    *blocks = best_len;
+    if (best_len == 0) {
+        return NULL;
+    }
+    return (void *)&(_static_buf.pool[best_start * GNRC_TCP_RCV_BUF_BLOCK_SIZE]);
 }
 
 /**
  * @brief Release allocated receive buffer.
  *
- * @param[in] buf   Pointer to buffer that should be released.
+ * @param[in] buf    Pointer to buffer that should be released.
+ * @param[in] size   Size of @p buf.
  */
-static void _rcvbuf_free(void * const buf)
+static void _rcvbuf_free(void * const buf, size_t size)
 {
+    size_t first = ((uint8_t *) buf - _static_buf.pool) / GNRC_TCP_RCV_BUF_BLOCK_SIZE;
+
     DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_free() : Entry\n");
     mutex_lock(&(_static_buf.lock));
-    for (size_t i = 0; i < GNRC_TCP_RCV_BUFFERS; ++i) {
-        if ((_static_buf.entries[i].used == 1) && (buf == _static_buf.entries[i].buffer)) {
-            _static_buf.entries[i].used = 0;
-        }
+    for (size_t i = first; i < first + (size / GNRC_TCP_RCV_BUF_BLOCK_SIZE); ++i) {
+        bf_unset(_static_buf.used, i);
     }
     mutex_unlock(&(_static_buf.lock));
 }
@@ -80,13 +110,17 @@ static void _rcvbuf_free(void * const buf)
 int _rcvbuf_get_buffer(gnrc_tcp_tcb_t *tcb)
 {
     if (tcb->rcv_buf_raw == NULL) {
-        tcb->rcv_buf_raw = _rcvbuf_alloc();
+        size_t size = (tcb->rcv_buf_size) ? tcb->rcv_buf_size : GNRC_TCP_RCV_BUF_SIZE;
+        size_t blocks = (size + GNRC_TCP_RCV_BUF_BLOCK_SIZE - 1) / GNRC_TCP_RCV_BUF_BLOCK_SIZE;
+
+        tcb->rcv_buf_raw = _rcvbuf_alloc(&blocks);
         if (tcb->rcv_buf_raw == NULL) {
             DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_get_buffer() : Can't allocate rcv_buf_raw\n");
             return -ENOMEM;
         }
         else {
-            ringbuffer_init(&tcb->rcv_buf, (char *) tcb->rcv_buf_raw, GNRC_TCP_RCV_BUF_SIZE);
+            ringbuffer_init(&tcb->rcv_buf, (char *) tcb->rcv_buf_raw,
+                            blocks * GNRC_TCP_RCV_BUF_BLOCK_SIZE);
         }
     }
     return 0;
@@ -95,7 +129,17 @@ int _rcvbuf_get_buffer(gnrc_tcp_tcb_t *tcb)
 void _rcvbuf_release_buffer(gnrc_tcp_tcb_t *tcb)
 {
     if (tcb->rcv_buf_raw != NULL) {
-        _rcvbuf_free(tcb->rcv_buf_raw);
+        _rcvbuf_free(tcb->rcv_buf_raw, tcb->rcv_buf.size);
         tcb->rcv_buf_raw = NULL;
     }
 }
+
+uint8_t _rcvbuf_get_wnd_scale(const gnrc_tcp_tcb_t *tcb)
+{
+    uint8_t scale = 0;
+
+    while (scale < WND_SCALE_MAX && (tcb->rcv_buf.size >> scale) > UINT16_MAX) {
+        scale++;
+    }
+    return scale;
+}
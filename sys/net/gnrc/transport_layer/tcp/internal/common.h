@@ -49,8 +49,28 @@ extern "C" {
 #define STATUS_ALLOW_ANY_ADDR (1 << 1)
 #define STATUS_NOTIFY_USER    (1 << 2)
 #define STATUS_WAIT_FOR_MSG   (1 << 3)
+#define STATUS_RTT_MEASURE    (1 << 4)
+#define STATUS_RECOVERY       (1 << 5)
+#define STATUS_FAST_RECOVERY  (1 << 6)
+#define STATUS_SACK_PERMITTED (1 << 7)
+#define STATUS_WND_SCALE      (1 << 8)
+#define STATUS_ACCEPTED       (1 << 9)
+#define STATUS_DELAYED_ACK    (1 << 10)
+#define STATUS_NAGLE          (1 << 11)
+#define STATUS_ACK_PENDING    (1 << 12)
+#define STATUS_FIN_PENDING    (1 << 13)
 /** @} */
 
+/**
+ * @brief Maximum number of blocks in a sent SACK option.
+ */
+#define SACK_BLOCKS_MAX (3U)
+
+/**
+ * @brief Maximum shift count of the window scale option (see RFC 7323).
+ */
+#define WND_SCALE_MAX (14U)
+
 /**
  * @brief Defines for "eventloop" thread settings.
  * @{
@@ -89,6 +109,7 @@ extern "C" {
 #define MSG_TYPE_RETRANSMISSION     (GNRC_NETAPI_MSG_TYPE_ACK + 104)
 #define MSG_TYPE_TIMEWAIT           (GNRC_NETAPI_MSG_TYPE_ACK + 105)
 #define MSG_TYPE_NOTIFY_USER        (GNRC_NETAPI_MSG_TYPE_ACK + 106)
+#define MSG_TYPE_DELAYED_ACK        (GNRC_NETAPI_MSG_TYPE_ACK + 107)
 /** @} */
 
 /**
@@ -22,18 +22,66 @@
 #ifndef EVENTLOOP_H
 #define EVENTLOOP_H
 
+#include <stdint.h>
+#include "kernel_types.h"
+#include "net/gnrc/pkt.h"
+#include "net/gnrc/tcp/tcb.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+#if defined(MODULE_GNRC_EVENTLOOP) || defined(DOXYGEN)
+/**
+ * @brief Registers GNRC TCP as a layer of the shared GNRC thread.
+ *
+ * Only available with the module gnrc_eventloop.
+ *
+ * @returns   PID of the shared GNRC thread.
+ */
+kernel_pid_t _eventloop_init(void);
+#endif
+
+#if !defined(MODULE_GNRC_EVENTLOOP) || defined(DOXYGEN)
 /**
  * @brief GNRC TCPs main processing thread.
  *
+ * Not available with the module gnrc_eventloop.
+ *
  * @param[in] arg   Thread arguments (unused).
  *
  * @returns   Never, its an endless loop
  */
 void *_event_loop(__attribute__((unused)) void *arg);
+#endif
+
+/**
+ * @brief Passes a packet to GNRC TCPs processing context to send it.
+ *
+ * @param[in] pkt   Packet to send. Released if it could not be passed on.
+ *
+ * @returns   Zero on success.
+ *            -ENOBUFS if the queue of the processing context was full.
+ */
+int _eventloop_send(gnrc_pktsnip_t *pkt);
+
+/**
+ * @brief (Re)starts a timer of a TCB.
+ *
+ * @param[in] tcb       TCB the timer belongs to.
+ * @param[in,out] timer Timer of @p tcb.
+ * @param[in] offset    Timeout in microseconds.
+ * @param[in] type      Message type handled on expiry, e.g. MSG_TYPE_RETRANSMISSION.
+ */
+void _eventloop_set_timer(gnrc_tcp_tcb_t *tcb, gnrc_tcp_timer_t *timer,
+                          uint32_t offset, uint16_t type);
+
+/**
+ * @brief Stops a timer of a TCB.
+ *
+ * @param[in,out] timer Timer to stop.
+ */
+void _eventloop_remove_timer(gnrc_tcp_timer_t *timer);
 
 #ifdef __cplusplus
 }
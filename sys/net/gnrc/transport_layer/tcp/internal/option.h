@@ -44,6 +44,47 @@ static inline uint32_t _option_build_mss(uint16_t mss)
             ((uint32_t) TCP_OPTION_LENGTH_MSS << 16) | mss);
 }
 
+/**
+ * @brief Helper function to build the window scale option, padded to 4 bytes.
+ *
+ * @param[in] shift   Shift count that should be set.
+ *
+ * @returns   Window scale option value.
+ */
+static inline uint32_t _option_build_wnd_scale(uint8_t shift)
+{
+    return (((uint32_t) TCP_OPTION_KIND_NOP << 24) |
+            ((uint32_t) TCP_OPTION_KIND_WND_SCALE << 16) |
+            ((uint32_t) TCP_OPTION_LENGTH_WND_SCALE << 8) | shift);
+}
+
+/**
+ * @brief Helper function to build the SACK-Permitted option, padded to 4 bytes.
+ *
+ * @returns   SACK-Permitted option value.
+ */
+static inline uint32_t _option_build_sack_perm(void)
+{
+    return (((uint32_t) TCP_OPTION_KIND_NOP << 24) |
+            ((uint32_t) TCP_OPTION_KIND_NOP << 16) |
+            ((uint32_t) TCP_OPTION_KIND_SACK_PERM << 8) | TCP_OPTION_LENGTH_SACK_PERM);
+}
+
+/**
+ * @brief Helper function to build the head of the SACK option, padded to 4 bytes.
+ *
+ * @param[in] blocks   Number of SACK blocks following the option head.
+ *
+ * @returns   Head of the SACK option.
+ */
+static inline uint32_t _option_build_sack(uint8_t blocks)
+{
+    return (((uint32_t) TCP_OPTION_KIND_NOP << 24) |
+            ((uint32_t) TCP_OPTION_KIND_NOP << 16) |
+            ((uint32_t) TCP_OPTION_KIND_SACK << 8) |
+            (2 + blocks * TCP_OPTION_LENGTH_SACK_BLOCK));
+}
+
 /**
  * @brief Helper function to build the combined option and control flag field.
  *
@@ -71,8 +71,12 @@ int _pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt, uint16_t *seq_con,
  * @param[in]     seq_con      Sequence number consumption of the packet to send.
  * @param[in]     retransmit   Flag so mark that packet this is a retransmission.
  *
+ * A pending delayed ACK is cleared, if the packet was sent and acknowledges
+ * everything received so far.
+ *
  * @returns   Zero on success.
  *            -EINVAL if out_pkt was NULL.
+ *            -ENOBUFS if the packet could not be passed down the network stack.
  */
 int _pkt_send(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *out_pkt, const uint16_t seq_con,
               const bool retransmit);
@@ -107,21 +111,33 @@ uint32_t _pkt_get_seg_len(gnrc_pktsnip_t *pkt);
  */
 uint32_t _pkt_get_pay_len(gnrc_pktsnip_t *pkt);
 
+/**
+ * @brief Extracts the sequence number of a segment.
+ *
+ * @param[in] pkt   Packet to extract the sequence number from.
+ *
+ * @returns   Sequence number of @p pkt.
+ */
+uint32_t _pkt_get_seq_num(gnrc_pktsnip_t *pkt);
+
 /**
  * @brief Adds a packet to the retransmission mechanism.
  *
+ * @note A retransmission must be the oldest packet in the retransmission queue.
+ *       It backs off the retransmission timer.
+ *
  * @param[in,out] tcb          TCB holding the connection information.
  * @param[in]     pkt          Packet to add to the retransmission mechanism.
  * @param[in]     retransmit   Flag used to indicate that @p pkt is a retransmit.
  *
  * @returns   Zero on success.
  *            -ENOMEM if the retransmission queue is full.
- *            -EINVAL if pkt is null.
+ *            -EINVAL if pkt is null or a retransmit that is not queued first.
  */
 int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool retransmit);
 
 /**
- * @brief Acknowledges and removes packet from the retransmission mechanism.
+ * @brief Acknowledges and removes packets from the retransmission mechanism.
  *
  * @param[in,out] tcb   TCB holding the connection information.
  * @param[in]     ack   Acknowldegment number used to acknowledge packets.
@@ -131,6 +147,15 @@ int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool r
  */
 int _pkt_acknowledge(gnrc_tcp_tcb_t *tcb, const uint32_t ack);
 
+/**
+ * @brief Marks packets in the retransmission queue as selectively acknowledged.
+ *
+ * @param[in,out] tcb     TCB holding the connection information.
+ * @param[in]     left    Left edge of a SACK block.
+ * @param[in]     right   Right edge of a SACK block.
+ */
+void _pkt_sack(gnrc_tcp_tcb_t *tcb, const uint32_t left, const uint32_t right);
+
 /**
  * @brief Calculates checksum over payload, TCP header and network layer header.
  *
@@ -23,6 +23,7 @@
 #define RCVBUF_H
 
 #include <stdint.h>
+#include "bitfield.h"
 #include "mutex.h"
 #include "net/gnrc/tcp/config.h"
 #include "net/gnrc/tcp/tcb.h"
@@ -32,19 +33,18 @@ extern "C" {
 #endif
 
 /**
- * @brief Receive buffer entry.
+ * @brief Number of blocks in the receive buffer pool.
  */
-typedef struct rcvbuf_entry {
-    uint8_t used;                          /**< Flag: Is buffer in use? */
-    uint8_t buffer[GNRC_TCP_RCV_BUF_SIZE]; /**< Receive buffer storage */
-} rcvbuf_entry_t;
+#define RCVBUF_BLOCKS (GNRC_TCP_RCV_BUF_POOL_SIZE / GNRC_TCP_RCV_BUF_BLOCK_SIZE)
 
 /**
  * @brief   Stuct holding receive buffers.
  */
 typedef struct rcvbuf {
-    mutex_t lock;                                 /**< Lock for allocation synchronization */
-    rcvbuf_entry_t entries[GNRC_TCP_RCV_BUFFERS]; /**< Maintained receive buffers */
+    mutex_t lock;                     /**< Lock for allocation synchronization */
+    BITFIELD(used, RCVBUF_BLOCKS);    /**< Blocks that are part of a receive buffer */
+    /** Pool, the receive buffers are allocated from */
+    uint8_t pool[RCVBUF_BLOCKS * GNRC_TCP_RCV_BUF_BLOCK_SIZE];
 } rcvbuf_t;
 
 /**
@@ -55,10 +55,14 @@ void _rcvbuf_init(void);
 /**
  * @brief Allocate receive buffer and assign it to TCB.
  *
+ * @note The size of the receive buffer is tcb->rcv_buf_size, or GNRC_TCP_RCV_BUF_SIZE if
+ *       tcb->rcv_buf_size is zero. If the pool has not enough memory left, the buffer
+ *       is as large as the largest free area of the pool.
+ *
  * @param[in,out] tcb   TCB that aquires receive buffer.
  *
  * @returns   Zero  on success.
- *            -ENOMEM if all receive buffers are currently used.
+ *            -ENOMEM if the receive buffer pool is exhausted.
  */
 int _rcvbuf_get_buffer(gnrc_tcp_tcb_t *tcb);
 
@@ -69,6 +73,15 @@ int _rcvbuf_get_buffer(gnrc_tcp_tcb_t *tcb);
  */
 void _rcvbuf_release_buffer(gnrc_tcp_tcb_t *tcb);
 
+/**
+ * @brief Get the window scale shift count required to announce the whole receive buffer.
+ *
+ * @param[in] tcb   TCB holding the receive buffer.
+ *
+ * @returns   Window scale shift count.
+ */
+uint8_t _rcvbuf_get_wnd_scale(const gnrc_tcp_tcb_t *tcb);
+
 #ifdef __cplusplus
 }
 #endif
@@ -27,6 +27,9 @@
 #include "net/ipv6/hdr.h"
 #include "net/gnrc/udp.h"
 #include "net/gnrc.h"
+#ifdef MODULE_GNRC_EVENTLOOP
+#include "net/gnrc/eventloop.h"
+#endif
 #include "net/gnrc/icmpv6/error.h"
 #include "net/inet_csum.h"
 
@@ -34,6 +37,38 @@
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+static void _direct(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx);
+
+/**
+ * @brief   Callback data for handling UDP in the dispatching thread
+ */
+static gnrc_netreg_entry_cbd_t _direct_cbd = { .cb = _direct };
+
+/**
+ * @brief   Registry entry of UDP, set once UDP is initialized
+ */
+static gnrc_netreg_entry_t _netreg = GNRC_NETREG_ENTRY_INIT_CB(
+        GNRC_NETREG_DEMUX_CTX_ALL, &_direct_cbd
+    );
+static bool _registered = false;
+#elif defined(MODULE_GNRC_EVENTLOOP)
+static void _handle_msg(msg_t *msg);
+
+/**
+ * @brief   UDP's layer in the shared GNRC thread
+ */
+static gnrc_eventloop_layer_t _layer;
+static msg_t _layer_queue[GNRC_UDP_MSG_QUEUE_SIZE];
+
+/**
+ * @brief   Registry entry of UDP, set once UDP is initialized
+ */
+static gnrc_netreg_entry_t _netreg = GNRC_NETREG_ENTRY_INIT_CB(
+        GNRC_NETREG_DEMUX_CTX_ALL, &_layer.cbd
+    );
+static bool _registered = false;
+#else   /* MODULE_GNRC_NETAPI_DIRECT */
 /**
  * @brief   Save the UDP's thread PID for later reference
  */
@@ -47,32 +82,25 @@ static char _stack[GNRC_UDP_STACK_SIZE + THREAD_EXTRA_STACKSIZE_PRINTF];
 #else
 static char _stack[GNRC_UDP_STACK_SIZE];
 #endif
+#endif  /* MODULE_GNRC_NETAPI_DIRECT */
 
 /**
- * @brief   Calculate the UDP checksum dependent on the network protocol
+ * @brief   Complete the UDP checksum dependent on the network protocol
  *
  * @note    If the checksum turns out to be 0x0000, the function returns 0xffff
  *          as specified in RFC768
  *
- * @param[in] pkt           pointer to the packet in the packet buffer
+ * @param[in] csum          unnormalized checksum of the payload
+ * @param[in] hdr           pointer to the UDP header
  * @param[in] pseudo_hdr    pointer to the network layer header
- * @param[in] payload       pointer to the payload
+ * @param[in] len           length of the UDP header and its payload
  *
  * @return                  the checksum of the pkt in host byte order
  * @return                  0 on error
  */
-static uint16_t _calc_csum(gnrc_pktsnip_t *hdr, gnrc_pktsnip_t *pseudo_hdr,
-                           gnrc_pktsnip_t *payload)
+static uint16_t _finish_csum(uint16_t csum, gnrc_pktsnip_t *hdr,
+                             gnrc_pktsnip_t *pseudo_hdr, uint16_t len)
 {
-    uint16_t csum = 0;
-    uint16_t len = (uint16_t)hdr->size;
-
-    /* process the payload */
-    while (payload && payload != hdr && payload != pseudo_hdr) {
-        csum = inet_csum_slice(csum, (uint8_t *)(payload->data), payload->size, len);
-        len += (uint16_t)payload->size;
-        payload = payload->next;
-    }
     /* process applicable UDP header bytes */
     csum = inet_csum(csum, (uint8_t *)hdr->data, sizeof(udp_hdr_t));
 
@@ -99,6 +127,58 @@ static uint16_t _calc_csum(gnrc_pktsnip_t *hdr, gnrc_pktsnip_t *pseudo_hdr,
     }
 }
 
+/**
+ * @brief   Calculate the UDP checksum dependent on the network protocol
+ *
+ * @param[in] pkt           pointer to the packet in the packet buffer
+ * @param[in] pseudo_hdr    pointer to the network layer header
+ * @param[in] payload       pointer to the payload
+ *
+ * @return                  the checksum of the pkt in host byte order
+ * @return                  0 on error
+ */
+static uint16_t _calc_csum(gnrc_pktsnip_t *hdr, gnrc_pktsnip_t *pseudo_hdr,
+                           gnrc_pktsnip_t *payload)
+{
+    uint16_t csum = 0;
+    uint16_t len = (uint16_t)hdr->size;
+
+    /* process the payload */
+    while (payload && payload != hdr && payload != pseudo_hdr) {
+        csum = inet_csum_slice(csum, (uint8_t *)(payload->data), payload->size, len);
+        len += (uint16_t)payload->size;
+        payload = payload->next;
+    }
+    return _finish_csum(csum, hdr, pseudo_hdr, len);
+}
+
+/**
+ * @brief   Checks if all receivers on @p port verify the checksum themselves
+ *
+ * Only @ref net_sock_udp registers with a mailbox, and it verifies the
+ * checksum while it copies the payload out of the packet buffer. Without
+ * any receiver, the checksum is verified before the ICMPv6 error is sent.
+ */
+static bool _csum_deferred(uint32_t port)
+{
+#ifdef MODULE_GNRC_NETAPI_MBOX
+    gnrc_netreg_entry_t *entry = gnrc_netreg_lookup(GNRC_NETTYPE_UDP, port);
+
+    if (entry == NULL) {
+        return false;
+    }
+    for (; entry != NULL; entry = gnrc_netreg_getnext(entry)) {
+        if (entry->type != GNRC_NETREG_TYPE_MBOX) {
+            return false;
+        }
+    }
+    return true;
+#else
+    (void)port;
+    return false;
+#endif
+}
+
 static void _receive(gnrc_pktsnip_t *pkt)
 {
     gnrc_pktsnip_t *udp, *ipv6;
@@ -146,15 +226,27 @@ static void _receive(gnrc_pktsnip_t *pkt)
         gnrc_pktbuf_release(pkt);
         return;
     }
-    if (_calc_csum(udp, ipv6, pkt) != 0xFFFF) {
-        DEBUG("udp: received packet with invalid checksum, dropping it\n");
-        gnrc_pktbuf_release(pkt);
-        return;
-    }
 
     /* get port (netreg demux context) */
     port = (uint32_t)byteorder_ntohs(hdr->dst_port);
 
+    if (!(gnrc_netif_hdr_get_flag(pkt) & GNRC_NETIF_HDR_FLAGS_CSUM_VALID) &&
+        !_csum_deferred(port)) {
+        gnrc_pktsnip_t *netif = gnrc_pktsnip_search_type(pkt,
+                                                         GNRC_NETTYPE_NETIF);
+
+        if (_calc_csum(udp, ipv6, pkt) != 0xFFFF) {
+            DEBUG("udp: received packet with invalid checksum, dropping it\n");
+            gnrc_pktbuf_release(pkt);
+            return;
+        }
+        if (netif != NULL) {
+            /* spare receivers that verify checksums themselves the work */
+            ((gnrc_netif_hdr_t *)netif->data)->flags |=
+                GNRC_NETIF_HDR_FLAGS_CSUM_VALID;
+        }
+    }
+
     /* send payload to receivers */
     if (!gnrc_netapi_dispatch_receive(GNRC_NETTYPE_UDP, port, pkt)) {
         DEBUG("udp: unable to forward packet as no one is interested in it\n");
@@ -220,6 +312,43 @@ static void _send(gnrc_pktsnip_t *pkt)
     }
 }
 
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+static void _direct(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx)
+{
+    (void)ctx;
+    switch (cmd) {
+        case GNRC_NETAPI_MSG_TYPE_RCV:
+            DEBUG("udp: direct GNRC_NETAPI_MSG_TYPE_RCV\n");
+            _receive(pkt);
+            break;
+        case GNRC_NETAPI_MSG_TYPE_SND:
+            DEBUG("udp: direct GNRC_NETAPI_MSG_TYPE_SND\n");
+            _send(pkt);
+            break;
+        default:
+            DEBUG("udp: received unidentified command\n");
+            gnrc_pktbuf_release(pkt);
+            break;
+    }
+}
+#elif defined(MODULE_GNRC_EVENTLOOP)
+static void _handle_msg(msg_t *msg)
+{
+    switch (msg->type) {
+        case GNRC_NETAPI_MSG_TYPE_RCV:
+            DEBUG("udp: GNRC_NETAPI_MSG_TYPE_RCV\n");
+            _receive(msg->content.ptr);
+            break;
+        case GNRC_NETAPI_MSG_TYPE_SND:
+            DEBUG("udp: GNRC_NETAPI_MSG_TYPE_SND\n");
+            _send(msg->content.ptr);
+            break;
+        default:
+            DEBUG("udp: received unidentified message\n");
+            break;
+    }
+}
+#else   /* MODULE_GNRC_NETAPI_DIRECT */
 static void *_event_loop(void *arg)
 {
     (void)arg;
@@ -260,6 +389,7 @@ static void *_event_loop(void *arg)
     /* never reached */
     return NULL;
 }
+#endif  /* MODULE_GNRC_NETAPI_DIRECT */
 
 int gnrc_udp_calc_csum(gnrc_pktsnip_t *hdr, gnrc_pktsnip_t *pseudo_hdr)
 {
@@ -280,6 +410,42 @@ int gnrc_udp_calc_csum(gnrc_pktsnip_t *hdr, gnrc_pktsnip_t *pseudo_hdr)
     return 0;
 }
 
+int gnrc_udp_calc_csum_partial(gnrc_pktsnip_t *hdr, gnrc_pktsnip_t *pseudo_hdr)
+{
+    udp_hdr_t *udp;
+    uint16_t csum;
+
+    if ((hdr == NULL) || (pseudo_hdr == NULL)) {
+        return -EFAULT;
+    }
+    if (hdr->type != GNRC_NETTYPE_UDP) {
+        return -EBADMSG;
+    }
+
+    udp = hdr->data;
+    /* the checksum field holds the sum of the payload */
+    csum = byteorder_ntohs(udp->checksum);
+    udp->checksum.u16 = 0;
+    csum = _finish_csum(csum, hdr, pseudo_hdr, (uint16_t)gnrc_pkt_len(hdr));
+    if (csum == 0) {
+        return -ENOENT;
+    }
+    udp->checksum = byteorder_htons(csum);
+    return 0;
+}
+
+bool gnrc_udp_check_csum(gnrc_pktsnip_t *hdr, gnrc_pktsnip_t *pseudo_hdr,
+                         uint16_t payload_sum)
+{
+    udp_hdr_t *udp = hdr->data;
+
+    /* the payload precedes the UDP header in received packets, so take the
+     * length from the header */
+    return (byteorder_ntohs(udp->checksum) != 0) &&
+           (_finish_csum(payload_sum, hdr, pseudo_hdr,
+                         byteorder_ntohs(udp->length)) == 0xFFFF);
+}
+
 gnrc_pktsnip_t *gnrc_udp_hdr_build(gnrc_pktsnip_t *payload, uint16_t src,
                                    uint16_t dst)
 {
@@ -303,6 +469,25 @@ gnrc_pktsnip_t *gnrc_udp_hdr_build(gnrc_pktsnip_t *payload, uint16_t src,
 
 int gnrc_udp_init(void)
 {
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+    /* UDP is handled in the context of the dispatching thread, so no thread
+     * is started */
+    if (!_registered) {
+        gnrc_netreg_register(GNRC_NETTYPE_UDP, &_netreg);
+        _registered = true;
+    }
+    return KERNEL_PID_UNDEF;
+#elif defined(MODULE_GNRC_EVENTLOOP)
+    if (!_registered) {
+        gnrc_eventloop_init();
+        /* UDP uses no timers, so it handles no message types of its own */
+        gnrc_eventloop_register(&_layer, _layer_queue, GNRC_UDP_MSG_QUEUE_SIZE,
+                                _handle_msg, 1U, 0U);
+        gnrc_netreg_register(GNRC_NETTYPE_UDP, &_netreg);
+        _registered = true;
+    }
+    return gnrc_eventloop_pid;
+#else   /* MODULE_GNRC_NETAPI_DIRECT */
     /* check if thread is already running */
     if (_pid == KERNEL_PID_UNDEF) {
         /* start UDP thread */
@@ -310,4 +495,5 @@ int gnrc_udp_init(void)
                              THREAD_CREATE_STACKTEST, _event_loop, NULL, "udp");
     }
     return _pid;
+#endif  /* MODULE_GNRC_NETAPI_DIRECT */
 }
@@ -26,16 +26,15 @@
 #include "random.h"
 #include "net/netdev.h"
 #include "net/netopt.h"
+#include "thread.h"
 
 #include "net/csma_sender.h"
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
-#if ENABLE_DEBUG
-/* For PRIu16 etc. */
+/* For PRIu32 etc. */
 #include <inttypes.h>
-#endif
 
 const csma_sender_conf_t CSMA_SENDER_CONF_DEFAULT = {
     CSMA_SENDER_MIN_BE_DEFAULT,
@@ -114,24 +113,24 @@ static int send_if_cca(netdev_t *device, iolist_t *iolist)
     return -EBUSY;
 }
 
-/*------------------------- "EXPORTED" FUNCTIONS -------------------------*/
-
-int csma_sender_csma_ca_send(netdev_t *dev, iolist_t *iolist,
-                             const csma_sender_conf_t *conf)
+/**
+ * @brief Check if the transceiver does automatic CSMA/CA when sending
+ *
+ * @param[in] device    netdev device, needs to be already initialized
+ *
+ * @return              1 if the device does hardware CSMA/CA
+ * @return              0 if CSMA/CA must be done in software
+ * @return              -ENODEV if @p device is invalid
+ * @return              -ECANCELED if an internal driver error occurred
+ */
+static int hw_csma(netdev_t *device)
 {
     netopt_enable_t hwfeat;
 
-    assert(dev);
-    /* choose default configuration if none is given */
-    if (conf == NULL) {
-        conf = &CSMA_SENDER_CONF_DEFAULT;
-    }
-    /* Does the transceiver do automatic CSMA/CA when sending? */
-    int res = dev->driver->get(dev,
-                               NETOPT_CSMA,
-                               (void *) &hwfeat,
-                               sizeof(netopt_enable_t));
-    bool ok = false;
+    int res = device->driver->get(device,
+                                  NETOPT_CSMA,
+                                  (void *) &hwfeat,
+                                  sizeof(netopt_enable_t));
 
     switch (res) {
         case -ENODEV:
@@ -139,17 +138,49 @@ int csma_sender_csma_ca_send(netdev_t *dev, iolist_t *iolist,
             return -ENODEV;
         case -ENOTSUP:
             /* device doesn't make auto-CSMA/CA */
-            break;
+            return 0;
         case -EOVERFLOW: /* (normally impossible...*/
         case -ECANCELED:
             DEBUG("csma: !!! DEVICE DRIVER FAILURE! TRANSMISSION ABORTED!\n");
             /* internal driver error! */
             return -ECANCELED;
         default:
-            ok = (hwfeat == NETOPT_ENABLE);
+            return (hwfeat == NETOPT_ENABLE);
     }
+}
 
-    if (ok) {
+/**
+ * @brief Start the next backoff period of an asynchronous transmission
+ *
+ * @param[in] csma      state of the transmission
+ */
+static void start_backoff(csma_sender_t *csma)
+{
+    uint32_t bp = choose_backoff_period(csma->be, csma->conf);
+
+    DEBUG("csma: Backing off for %" PRIu32 " us.\n", bp);
+    csma->msg.type = CSMA_SENDER_MSG_TYPE_BACKOFF;
+    csma->msg.content.ptr = csma;
+    xtimer_set_msg(&csma->timer, bp, &csma->msg, csma->pid);
+}
+
+/*------------------------- "EXPORTED" FUNCTIONS -------------------------*/
+
+int csma_sender_csma_ca_send(netdev_t *dev, iolist_t *iolist,
+                             const csma_sender_conf_t *conf)
+{
+    assert(dev);
+    /* choose default configuration if none is given */
+    if (conf == NULL) {
+        conf = &CSMA_SENDER_CONF_DEFAULT;
+    }
+    /* Does the transceiver do automatic CSMA/CA when sending? */
+    int res = hw_csma(dev);
+
+    if (res < 0) {
+        return res;
+    }
+    if (res) {
         /* device does CSMA/CA all by itself: let it do its job */
         DEBUG("csma: Network device does hardware CSMA/CA\n");
         return dev->driver->send(dev, iolist);
@@ -193,6 +224,74 @@ int csma_sender_csma_ca_send(netdev_t *dev, iolist_t *iolist,
     return -EBUSY;
 }
 
+int csma_sender_csma_ca_send_async(csma_sender_t *csma, netdev_t *dev,
+                                   iolist_t *iolist,
+                                   const csma_sender_conf_t *conf)
+{
+    assert(csma && dev);
+    if (csma->iolist != NULL) {
+        DEBUG("csma: Still busy with the previous frame.\n");
+        return -EALREADY;
+    }
+    /* choose default configuration if none is given */
+    if (conf == NULL) {
+        conf = &CSMA_SENDER_CONF_DEFAULT;
+    }
+    /* Does the transceiver do automatic CSMA/CA when sending? */
+    int res = hw_csma(dev);
+
+    if (res < 0) {
+        return res;
+    }
+    if (res) {
+        /* device does CSMA/CA all by itself: let it do its job */
+        DEBUG("csma: Network device does hardware CSMA/CA\n");
+        return dev->driver->send(dev, iolist);
+    }
+
+    /* if we arrive here, then we must perform the CSMA/CA procedure
+       ourselves by software */
+    random_init(_xtimer_now());
+    DEBUG("csma: Starting asynchronous software CSMA/CA....\n");
+
+    csma->dev = dev;
+    csma->iolist = iolist;
+    csma->conf = conf;
+    csma->pid = thread_getpid();
+    csma->nb = 0;
+    csma->be = conf->min_be;
+    start_backoff(csma);
+    return 0;
+}
+
+int csma_sender_backoff_expired(csma_sender_t *csma)
+{
+    assert(csma && csma->iolist);
+
+    /* try to send after a CCA */
+    int res = send_if_cca(csma->dev, csma->iolist);
+
+    if (res == -EBUSY) {
+        /* medium is busy: increment CSMA counters */
+        csma->be++;
+        if (csma->be > csma->conf->max_be) {
+            csma->be = csma->conf->max_be;
+        }
+        csma->nb++;
+        /* ... and try again if we have no exceeded the retry limit */
+        if (csma->nb <= csma->conf->max_backoffs) {
+            start_backoff(csma);
+            return 0;
+        }
+        DEBUG("csma: Software CSMA/CA failure: medium never available.\n");
+    }
+    csma->iolist = NULL;
+    if ((res == -EBUSY) && (csma->dev->event_callback != NULL)) {
+        csma->dev->event_callback(csma->dev, NETDEV_EVENT_TX_MEDIUM_BUSY);
+    }
+    return res;
+}
+
 
 int csma_sender_cca_send(netdev_t *dev, iolist_t *iolist)
 {
@@ -30,6 +30,10 @@
 #include "xtimer.h"
 #include "timex.h"
 #include "utlist.h"
+#ifdef MODULE_FIB_TRIE
+#include "assert.h"
+#include "bitarithm.h"
+#endif
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
@@ -65,6 +69,344 @@ static void fib_lifetime_to_absolute(uint32_t ms, uint64_t *target)
     *target = xtimer_now_usec64() + (ms * US_PER_MS);
 }
 
+static int fib_remove(fib_table_t *table, fib_entry_t *entry);
+
+#ifdef MODULE_FIB_TRIE
+/*
+ * The key of an entry is the address size as first byte followed by the
+ * address, so addresses of different sizes never match. The key length of an
+ * entry is 8 bits plus its prefix length, the full address for host routes
+ * and 0 for the all zero (default route) address.
+ */
+
+/**
+ * @brief returns byte @p i of the key of an address
+ */
+static inline uint8_t fib_trie_key_byte(const uint8_t *addr, size_t addr_size,
+                                        unsigned i)
+{
+    return (i == 0) ? (uint8_t)addr_size : addr[i - 1];
+}
+
+/**
+ * @brief returns bit @p i of the key of an address, starting at the MSB
+ */
+static inline unsigned fib_trie_key_bit(const uint8_t *addr, size_t addr_size,
+                                        unsigned i)
+{
+    return (fib_trie_key_byte(addr, addr_size, i >> 3) >> (7 - (i & 7))) & 1;
+}
+
+/**
+ * @brief returns the first bit two keys differ in, at most @p len
+ */
+static unsigned fib_trie_diff(const uint8_t *a, size_t a_size,
+                              const uint8_t *b, size_t b_size, unsigned len)
+{
+    for (unsigned i = 0; (i << 3) < len; i++) {
+        uint8_t diff = fib_trie_key_byte(a, a_size, i) ^
+                       fib_trie_key_byte(b, b_size, i);
+
+        if (diff != 0) {
+            unsigned res = (i << 3) + 7 - bitarithm_msb(diff);
+
+            return (res < len) ? res : len;
+        }
+    }
+    return len;
+}
+
+/**
+ * @brief returns the key length of an entry in bits
+ */
+static uint16_t fib_trie_entry_len(fib_entry_t *entry)
+{
+    universal_address_container_t *global = entry->global;
+    size_t addr_bits = global->address_size << 3;
+    size_t prefix_len;
+
+    for (size_t i = 0; i < global->address_size; i++) {
+        if (global->address[i] != 0) {
+            if (!(entry->global_flags & FIB_FLAG_NET_PREFIX_MASK)) {
+                return 8 + addr_bits;
+            }
+            prefix_len = (entry->global_flags & FIB_FLAG_NET_PREFIX_MASK)
+                         >> FIB_FLAG_NET_PREFIX_SHIFT;
+            return 8 + ((prefix_len < addr_bits) ? prefix_len : addr_bits);
+        }
+    }
+    /* the all zero address is the default route */
+    return 8;
+}
+
+/**
+ * @brief returns an entry below @p node, all of them share the first
+ *        node->len bits of their key
+ */
+static fib_entry_t *fib_trie_any_entry(fib_trie_node_t *node)
+{
+    /* glue nodes always have two children */
+    while (node->entry == NULL) {
+        node = node->child[0];
+    }
+    return node->entry;
+}
+
+/**
+ * @brief returns the link pointing to @p node
+ */
+static fib_trie_node_t **fib_trie_link(fib_table_t *table,
+                                       fib_trie_node_t *node)
+{
+    fib_trie_node_t *parent = node->parent;
+
+    if (parent == NULL) {
+        return &table->trie_root;
+    }
+    return &parent->child[parent->child[1] == node];
+}
+
+/**
+ * @brief puts @p node in the place of @p old in the trie
+ */
+static void fib_trie_replace(fib_table_t *table, fib_trie_node_t *old,
+                             fib_trie_node_t *node)
+{
+    *fib_trie_link(table, old) = node;
+    node->parent = old->parent;
+    node->len = old->len;
+    for (unsigned i = 0; i < 2; i++) {
+        node->child[i] = old->child[i];
+        if (node->child[i] != NULL) {
+            node->child[i]->parent = node;
+        }
+    }
+}
+
+/**
+ * @brief returns a glue node to the free list of @p table
+ */
+static void fib_trie_free(fib_table_t *table, fib_trie_node_t *glue)
+{
+    glue->dup = table->trie_free;
+    table->trie_free = glue;
+}
+
+/**
+ * @brief adds an entry to the trie of the table
+ */
+static void fib_trie_insert(fib_table_t *table, fib_entry_t *entry)
+{
+    fib_trie_node_t *node = &entry->trie[0];
+    fib_trie_node_t **link = &table->trie_root;
+    fib_trie_node_t *parent = NULL;
+    uint8_t *addr = entry->global->address;
+    size_t addr_size = entry->global->address_size;
+
+    memset(node, 0, sizeof(*node));
+    node->entry = entry;
+    node->len = fib_trie_entry_len(entry);
+
+    while (*link != NULL) {
+        fib_trie_node_t *cur = *link;
+        fib_entry_t *other = fib_trie_any_entry(cur);
+        unsigned len = (node->len < cur->len) ? node->len : cur->len;
+        unsigned diff = fib_trie_diff(addr, addr_size, other->global->address,
+                                      other->global->address_size, len);
+
+        if (diff < len) {
+            /* the keys part before either ends: branch with a glue node */
+            fib_trie_node_t *glue = table->trie_free;
+
+            assert(glue != NULL);
+            table->trie_free = glue->dup;
+            memset(glue, 0, sizeof(*glue));
+            glue->len = diff;
+            glue->parent = parent;
+            glue->child[fib_trie_key_bit(addr, addr_size, diff)] = node;
+            glue->child[!fib_trie_key_bit(addr, addr_size, diff)] = cur;
+            cur->parent = glue;
+            node->parent = glue;
+            *link = glue;
+            return;
+        }
+        if (node->len == cur->len) {
+            if (cur->entry == NULL) {
+                /* the entry sits exactly at a branch */
+                fib_trie_replace(table, cur, node);
+                fib_trie_free(table, cur);
+            }
+            else {
+                /* same key, e.g. different addresses of one prefix */
+                node->parent = cur;
+                node->dup = cur->dup;
+                cur->dup = node;
+            }
+            return;
+        }
+        if (node->len < cur->len) {
+            /* the entry covers the subtrie */
+            node->parent = parent;
+            node->child[fib_trie_key_bit(other->global->address,
+                                         other->global->address_size,
+                                         node->len)] = cur;
+            cur->parent = node;
+            *link = node;
+            return;
+        }
+        parent = cur;
+        link = &cur->child[fib_trie_key_bit(addr, addr_size, cur->len)];
+    }
+    node->parent = parent;
+    *link = node;
+}
+
+/**
+ * @brief removes an entry from the trie of the table
+ */
+static void fib_trie_remove(fib_table_t *table, fib_entry_t *entry)
+{
+    fib_trie_node_t *node = &entry->trie[0];
+    fib_trie_node_t **link;
+    fib_trie_node_t *parent;
+
+    if (node->entry == NULL) {
+        /* not in the trie */
+        return;
+    }
+    node->entry = NULL;
+    link = fib_trie_link(table, node);
+    if (*link != node) {
+        /* only in the list of entries with the same key */
+        fib_trie_node_t *prev = node->parent;
+
+        while (prev->dup != node) {
+            prev = prev->dup;
+        }
+        prev->dup = node->dup;
+        return;
+    }
+    if (node->dup != NULL) {
+        /* the next entry with the same key takes the place of the node */
+        fib_trie_node_t *next = node->dup;
+
+        fib_trie_replace(table, node, next);
+        for (fib_trie_node_t *dup = next->dup; dup != NULL; dup = dup->dup) {
+            dup->parent = next;
+        }
+        return;
+    }
+    if ((node->child[0] != NULL) && (node->child[1] != NULL)) {
+        /* the branch remains */
+        fib_trie_node_t *glue = table->trie_free;
+
+        assert(glue != NULL);
+        table->trie_free = glue->dup;
+        glue->entry = NULL;
+        glue->dup = NULL;
+        fib_trie_replace(table, node, glue);
+        return;
+    }
+    parent = node->parent;
+    *link = (node->child[0] != NULL) ? node->child[0] : node->child[1];
+    if (*link != NULL) {
+        (*link)->parent = parent;
+    }
+    else if ((parent != NULL) && (parent->entry == NULL)) {
+        /* the glue node above is left with a single child */
+        fib_trie_node_t *child = (parent->child[0] != NULL) ? parent->child[0]
+                                                            : parent->child[1];
+
+        *fib_trie_link(table, parent) = child;
+        child->parent = parent->parent;
+        fib_trie_free(table, parent);
+    }
+}
+
+/**
+ * @brief resets the trie of a single hop table with cleared entries
+ */
+static void fib_trie_init(fib_table_t *table)
+{
+    table->trie_root = NULL;
+    table->trie_free = NULL;
+    for (size_t i = 0; i < table->size; ++i) {
+        fib_trie_free(table, &table->data.entries[i].trie[1]);
+    }
+}
+
+/**
+ * @brief looks up the entry with the longest prefix matching @p dst
+ *
+ * @return 0 if we found a next-hop prefix
+ *         1 if we found the exact address next-hop
+ *         -EHOSTUNREACH if no fitting next-hop is available
+ */
+static int fib_trie_lookup(fib_table_t *table, uint8_t *dst, size_t dst_size,
+                           fib_entry_t **entry)
+{
+    fib_trie_node_t *node = table->trie_root;
+    unsigned dst_len = 8 + (dst_size << 3);
+    int ret = -EHOSTUNREACH;
+
+    while ((node != NULL) && (node->len <= dst_len)) {
+        if (node->entry != NULL) {
+            universal_address_container_t *global = node->entry->global;
+
+            if (fib_trie_diff(dst, dst_size, global->address,
+                              global->address_size, node->len) < node->len) {
+                /* the whole subtrie shares the mismatching bits */
+                break;
+            }
+            for (fib_trie_node_t *dup = node; dup != NULL; dup = dup->dup) {
+                global = dup->entry->global;
+                if ((global->address_size == dst_size) &&
+                    (memcmp(global->address, dst, dst_size) == 0)) {
+                    *entry = dup->entry;
+                    return 1;
+                }
+            }
+            *entry = node->entry;
+            ret = 0;
+        }
+        if (node->len == dst_len) {
+            break;
+        }
+        node = node->child[fib_trie_key_bit(dst, dst_size, node->len)];
+    }
+    return ret;
+}
+
+/**
+ * @brief returns pointer to the entry for the given destination address
+ *
+ * @param[in] table                the FIB table to search in
+ * @param[in] dst                  the destination address
+ * @param[in] dst_size             the destination address size
+ * @param[out] entry_arr           the array to scribe the found match
+ * @param[in, out] entry_arr_size  the number of entries provided by entry_arr (should be always 1)
+ *                                 this value is overwritten with the actual found number
+ *
+ * @return 0 if we found a next-hop prefix
+ *         1 if we found the exact address next-hop
+ *         -EHOSTUNREACH if no fitting next-hop is available
+ */
+static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
+                          fib_entry_t **entry_arr, size_t *entry_arr_size)
+{
+    uint64_t now = xtimer_now_usec64();
+    int ret;
+
+    /* entries are only invalidated when found */
+    while (((ret = fib_trie_lookup(table, dst, dst_size, entry_arr)) >= 0) &&
+           (entry_arr[0]->lifetime != FIB_LIFETIME_NO_EXPIRE) &&
+           (entry_arr[0]->lifetime < now)) {
+        fib_remove(table, entry_arr[0]);
+    }
+    *entry_arr_size = (ret >= 0) ? 1 : 0;
+    return ret;
+}
+#else   /* MODULE_FIB_TRIE */
 /**
  * @brief returns pointer to the entry for the given destination address
  *
@@ -188,6 +530,7 @@ static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
     *entry_arr_size = count;
     return ret;
 }
+#endif  /* MODULE_FIB_TRIE */
 
 /**
  * @brief updates the next hop the lifetime and the interface id for a given entry
@@ -267,6 +610,9 @@ static int fib_create_entry(fib_table_t *table, kernel_pid_t iface_id,
                 else {
                     table->data.entries[i].lifetime = FIB_LIFETIME_NO_EXPIRE;
                 }
+#ifdef MODULE_FIB_TRIE
+                fib_trie_insert(table, &table->data.entries[i]);
+#endif
 
                 return 0;
             }
@@ -279,12 +625,18 @@ static int fib_create_entry(fib_table_t *table, kernel_pid_t iface_id,
 /**
  * @brief removes the given entry
  *
+ * @param[in] table the FIB table of the entry
  * @param[in] entry the entry to be removed
  *
  * @return 0 on success
  */
-static int fib_remove(fib_entry_t *entry)
+static int fib_remove(fib_table_t *table, fib_entry_t *entry)
 {
+#ifdef MODULE_FIB_TRIE
+    fib_trie_remove(table, entry);
+#else
+    (void)table;
+#endif
     if (entry->global != NULL) {
         universal_address_rem(entry->global);
     }
@@ -457,7 +809,7 @@ void fib_remove_entry(fib_table_t *table, uint8_t *dst, size_t dst_size)
 
     if (ret == 1) {
         /* we must take the according entry and update the values */
-        fib_remove(entry[0]);
+        fib_remove(table, entry[0]);
     }
     else {
         /* we have ambiguous entries, i.e. count > 1
@@ -477,7 +829,7 @@ void fib_flush(fib_table_t *table, kernel_pid_t interface)
     for (size_t i = 0; i < table->size; ++i) {
         if ((interface == KERNEL_PID_UNDEF) ||
             (interface == table->data.entries[i].iface_id)) {
-            fib_remove(&table->data.entries[i]);
+            fib_remove(table, &table->data.entries[i]);
         }
     }
 
@@ -596,6 +948,9 @@ void fib_init(fib_table_t *table)
     }
     else {
         memset(table->data.entries, 0, (table->size * sizeof(fib_entry_t)));
+#ifdef MODULE_FIB_TRIE
+        fib_trie_init(table);
+#endif
     }
     universal_address_init();
     mutex_unlock(&(table->mtx_access));
@@ -621,6 +976,9 @@ void fib_deinit(fib_table_t *table)
     }
     else {
         memset(table->data.entries, 0, (table->size * sizeof(fib_entry_t)));
+#ifdef MODULE_FIB_TRIE
+        fib_trie_init(table);
+#endif
     }
     universal_address_reset();
     mutex_unlock(&(table->mtx_access));
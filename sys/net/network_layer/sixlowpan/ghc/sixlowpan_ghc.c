@@ -0,0 +1,233 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @author  Martine Lenders <m.lenders@fu-berlin.de>
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "net/sixlowpan/ghc.h"
+
+/* longest backreference the compressor looks for, to bound its run time */
+#define MATCH_MAX           (64U)
+
+/* static part of the dictionary
+ * see https://tools.ietf.org/html/rfc7400#section-2 */
+static const uint8_t _static_dict[] = {
+    0x16, 0xfe, 0xfd, 0x17, 0xfe, 0xfd, 0x00, 0x01,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00,
+};
+
+/* returns the byte at position `pos` of the window that consists of the
+ * dictionary followed by `data` */
+static inline uint8_t _window(const uint8_t *dict, const uint8_t *data,
+                              size_t pos)
+{
+    return (pos < SIXLOWPAN_GHC_DICT_LEN) ? dict[pos]
+                                          : data[pos - SIXLOWPAN_GHC_DICT_LEN];
+}
+
+/* number of extension bytes needed for a backreference of length `len`
+ * `dist` bytes before the current position */
+static unsigned _ext_num(size_t len, size_t dist)
+{
+    unsigned na = (len - 2) / 8;            /* n bits needed */
+    unsigned sa = ((dist - len) / 8 + 14) / 15; /* ssss fields needed */
+
+    return (na > sa) ? na : sa;
+}
+
+void sixlowpan_ghc_dict_init(uint8_t *dict, const ipv6_addr_t *src,
+                             const ipv6_addr_t *dst)
+{
+    memcpy(dict, src, sizeof(ipv6_addr_t));
+    memcpy(dict + sizeof(ipv6_addr_t), dst, sizeof(ipv6_addr_t));
+    memcpy(dict + (2 * sizeof(ipv6_addr_t)), _static_dict,
+           sizeof(_static_dict));
+}
+
+/* writes pending literals in[start, end) to out, returns new output
+ * position or -ENOBUFS */
+static int _flush_literals(uint8_t *out, size_t out_len, size_t o,
+                           const uint8_t *in, size_t start, size_t end)
+{
+    while (start < end) {
+        size_t k = end - start;
+
+        if (k > SIXLOWPAN_GHC_LITERAL_MAX) {
+            k = SIXLOWPAN_GHC_LITERAL_MAX;
+        }
+        if ((o + 1 + k) > out_len) {
+            return -ENOBUFS;
+        }
+        out[o++] = (uint8_t)k;
+        memcpy(&out[o], &in[start], k);
+        o += k;
+        start += k;
+    }
+    return (int)o;
+}
+
+int sixlowpan_ghc_compress(uint8_t *out, size_t out_len,
+                           const uint8_t *in, size_t in_len,
+                           const uint8_t *dict)
+{
+    size_t i = 0, lit_start = 0;
+    int o = 0;
+
+    while (i < in_len) {
+        size_t cur = SIXLOWPAN_GHC_DICT_LEN + i;
+        size_t zeros = 0, best_len = 0, best_dist = 0;
+        int best_gain = 0;
+
+        while (((i + zeros) < in_len) && (in[i + zeros] == 0) &&
+               (zeros < SIXLOWPAN_GHC_ZEROS_MAX)) {
+            zeros++;
+        }
+        /* search window for the backreference that saves the most bytes */
+        for (size_t start = 0; start < cur; start++) {
+            size_t len = 0;
+
+            while (((i + len) < in_len) && (len < MATCH_MAX) &&
+                   (_window(dict, in, start + len) == in[i + len])) {
+                len++;
+            }
+            if (len >= 2) {
+                int gain = (int)len - 1 - (int)_ext_num(len, cur - start);
+
+                if (gain > best_gain) {
+                    best_gain = gain;
+                    best_len = len;
+                    best_dist = cur - start;
+                }
+            }
+        }
+        if ((zeros >= 2) && (((int)zeros - 1) >= best_gain)) {
+            if ((o = _flush_literals(out, out_len, o, in, lit_start, i)) < 0) {
+                return o;
+            }
+            if ((size_t)o >= out_len) {
+                return -ENOBUFS;
+            }
+            out[o++] = SIXLOWPAN_GHC_ZEROS | (zeros - 2);
+            i += zeros;
+            lit_start = i;
+        }
+        else if (best_gain > 0) {
+            size_t na = ((best_len - 2) / 8) * 8;
+            size_t sa = ((best_dist - best_len) / 8) * 8;
+
+            if ((o = _flush_literals(out, out_len, o, in, lit_start, i)) < 0) {
+                return o;
+            }
+            if (((size_t)o + 1 + _ext_num(best_len, best_dist)) > out_len) {
+                return -ENOBUFS;
+            }
+            /* distribute remaining arguments over extension bytes */
+            for (size_t n = na, s = sa; (n > 0) || (s > 0);) {
+                uint8_t ssss = (s / 8 > 15) ? 15 : (s / 8);
+
+                out[o++] = SIXLOWPAN_GHC_EXT | ((n > 0) ? SIXLOWPAN_GHC_EXT_N : 0) |
+                           ssss;
+                n -= (n > 0) ? 8 : 0;
+                s -= ssss * 8;
+            }
+            out[o++] = SIXLOWPAN_GHC_BACKREF |
+                       ((best_len - 2 - na) << 3) |
+                       (best_dist - best_len - sa);
+            i += best_len;
+            lit_start = i;
+        }
+        else {
+            /* keep as literal */
+            i++;
+        }
+    }
+    return _flush_literals(out, out_len, o, in, lit_start, i);
+}
+
+int sixlowpan_ghc_decompress(uint8_t *out, size_t out_len,
+                             const uint8_t *in, size_t in_len,
+                             const uint8_t *dict)
+{
+    size_t o = 0, na = 0, sa = 0;
+
+    for (size_t i = 0; i < in_len; i++) {
+        uint8_t code = in[i];
+
+        if (code == SIXLOWPAN_GHC_STOP) {
+            break;
+        }
+        else if (code <= SIXLOWPAN_GHC_LITERAL_MAX) {
+            if ((i + code) >= in_len) {
+                return -EINVAL;
+            }
+            if (out != NULL) {
+                if ((o + code) > out_len) {
+                    return -ENOBUFS;
+                }
+                memcpy(&out[o], &in[i + 1], code);
+            }
+            o += code;
+            i += code;
+        }
+        else if ((code & SIXLOWPAN_GHC_ZEROS_MASK) == SIXLOWPAN_GHC_ZEROS) {
+            size_t n = (code & ~SIXLOWPAN_GHC_ZEROS_MASK) + 2;
+
+            if (out != NULL) {
+                if ((o + n) > out_len) {
+                    return -ENOBUFS;
+                }
+                memset(&out[o], 0, n);
+            }
+            o += n;
+        }
+        else if ((code & SIXLOWPAN_GHC_EXT_MASK) == SIXLOWPAN_GHC_EXT) {
+            na += (code & SIXLOWPAN_GHC_EXT_N) ? 8 : 0;
+            sa += (code & 0x0f) * 8;
+        }
+        else if ((code & SIXLOWPAN_GHC_BACKREF_MASK) == SIXLOWPAN_GHC_BACKREF) {
+            size_t n = na + ((code >> 3) & 0x7) + 2;
+            size_t s = (code & 0x7) + sa + n;
+            size_t cur = SIXLOWPAN_GHC_DICT_LEN + o;
+
+            if (s > cur) {
+                /* reference before start of dictionary */
+                return -EINVAL;
+            }
+            if (out != NULL) {
+                if ((o + n) > out_len) {
+                    return -ENOBUFS;
+                }
+                /* copy byte-wise, source may span dictionary and output */
+                for (size_t j = 0; j < n; j++) {
+                    out[o + j] = _window(dict, out, cur - s + j);
+                }
+            }
+            o += n;
+            na = 0;
+            sa = 0;
+        }
+        else {
+            /* reserved bytecode */
+            return -EINVAL;
+        }
+    }
+    if ((na != 0) || (sa != 0)) {
+        /* extension bytes without backreference */
+        return -EINVAL;
+    }
+    return (int)o;
+}
+
+/** @} */
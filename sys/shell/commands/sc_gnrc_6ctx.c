@@ -30,7 +30,7 @@ void _del_cb(void *ptr)
 {
     gnrc_sixlowpan_ctx_t *ctx = ptr;
     uint8_t cid = ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK;
-    ctx->prefix_len = 0;
+    gnrc_sixlowpan_ctx_remove(cid);
     del_timer[cid].callback = NULL;
 }
 
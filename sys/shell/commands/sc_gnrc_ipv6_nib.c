@@ -13,6 +13,7 @@
  * @author  Martine Lenders <m.lenders@fu-berlin.de>
  */
 
+#include <inttypes.h>
 #include <stdio.h>
 
 #include "net/gnrc/ipv6/nib.h"
@@ -23,6 +24,9 @@ static void _usage(char **argv);
 static int _nib_neigh(int argc, char **argv);
 static int _nib_prefix(int argc, char **argv);
 static int _nib_route(int argc, char **argv);
+#if GNRC_IPV6_NIB_CONF_DCACHE
+static int _nib_dcache(int argc, char **argv);
+#endif
 
 int _gnrc_ipv6_nib(int argc, char **argv)
 {
@@ -41,6 +45,11 @@ int _gnrc_ipv6_nib(int argc, char **argv)
     else if (strcmp(argv[1], "route") == 0) {
         res = _nib_route(argc, argv);
     }
+#if GNRC_IPV6_NIB_CONF_DCACHE
+    else if (strcmp(argv[1], "dcache") == 0) {
+        res = _nib_dcache(argc, argv);
+    }
+#endif
     else {
         _usage(argv);
     }
@@ -49,7 +58,11 @@ int _gnrc_ipv6_nib(int argc, char **argv)
 
 static void _usage(char **argv)
 {
+#if GNRC_IPV6_NIB_CONF_DCACHE
+    printf("usage: %s {neigh|prefix|route|dcache|help} ...\n", argv[0]);
+#else
     printf("usage: %s {neigh|prefix|route|help} ...\n", argv[0]);
+#endif
 }
 
 static void _usage_nib_neigh(char **argv)
@@ -282,4 +295,28 @@ static int _nib_route(int argc, char **argv)
     return 0;
 }
 
+#if GNRC_IPV6_NIB_CONF_DCACHE
+static int _nib_dcache(int argc, char **argv)
+{
+    gnrc_ipv6_nib_dcache_stats_t stats;
+    uint32_t total;
+
+    if ((argc == 2) || (strcmp(argv[2], "show") == 0)) {
+        gnrc_ipv6_nib_dcache_get_stats(&stats);
+        total = stats.hits + stats.misses;
+        printf("hits: %" PRIu32 " misses: %" PRIu32 " hit rate: %" PRIu32 "%%\n",
+               stats.hits, stats.misses,
+               (total) ? (uint32_t)((100ULL * stats.hits) / total) : 0U);
+    }
+    else if (strcmp(argv[2], "flush") == 0) {
+        gnrc_ipv6_nib_dcache_invalidate();
+    }
+    else {
+        printf("usage: %s %s [show|flush|help]\n", argv[0], argv[1]);
+        return (strcmp(argv[2], "help") == 0) ? 0 : 1;
+    }
+    return 0;
+}
+#endif
+
 /** @} */
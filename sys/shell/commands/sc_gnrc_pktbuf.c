@@ -13,13 +13,40 @@
  * @author  Martine Lenders <m.lenders@fu-berlin.de>
  */
 
+#include <inttypes.h>
+#include <stdio.h>
+
 #include "net/gnrc/pktbuf.h"
 
+static void _print_netstats(void)
+{
+    netstats_pktbuf_t stats;
+    unsigned bin_size = NETSTATS_PKTBUF_FAIL_BIN0_SIZE;
+
+    gnrc_pktbuf_netstats_get(&stats);
+    printf("Statistics for packet buffer\n"
+           "  used: %" PRIu32 " bytes (high-water mark: %" PRIu32 " bytes)\n"
+           "  largest free block: %" PRIu32 " bytes in %" PRIu32 " free blocks\n"
+           "  mutex taken: %" PRIu32 " times for %" PRIu32 " us\n"
+           "  failed allocations by requested size:\n",
+           stats.used, stats.high_water, stats.largest_free, stats.holes,
+           stats.lock_count, stats.lock_time);
+    for (unsigned i = 0; i < (NETSTATS_PKTBUF_FAIL_BINS - 1); i++) {
+        printf("    <= %5u bytes: %" PRIu32 "\n", bin_size, stats.alloc_fails[i]);
+        bin_size <<= 1;
+    }
+    printf("     > %5u bytes: %" PRIu32 "\n", bin_size >> 1,
+           stats.alloc_fails[NETSTATS_PKTBUF_FAIL_BINS - 1]);
+}
+
 int _gnrc_pktbuf_cmd(int argc, char **argv)
 {
     (void)argc;
     (void)argv;
+    _print_netstats();
+#ifdef DEVELHELP
     gnrc_pktbuf_stats();
+#endif
     return 0;
 }
 
@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure the lookups in the FIB for different numbers of routes
+ *
+ * @author      Martine Lenders <m.lenders@fu-berlin.de>
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "benchmark.h"
+#include "net/fib.h"
+#include "net/fib/table.h"
+
+#ifndef BENCH_RUNS
+#define BENCH_RUNS          (10UL * 1000UL)
+#endif
+
+#define BENCH_ROUTES_MAX    (1024U)
+#define BENCH_ADDR_LEN      (16U)
+#define BENCH_PREFIX_LEN    (64U)
+/* containers of universal addresses can only be shared 255 times */
+#define BENCH_NEXT_HOPS     (8U)
+
+static fib_entry_t _entries[BENCH_ROUTES_MAX + 1];
+static fib_table_t _table = {
+    .data.entries = _entries,
+    .table_type = FIB_TABLE_TYPE_SH,
+};
+static uint8_t _next_hop[BENCH_ADDR_LEN] = { 0xfe, 0x80, [15] = 0x01 };
+static unsigned _fails;
+
+/* 2001:db8:x:y::/64 with x:y scattered over the 32 bits */
+static void _route_addr(uint8_t *addr, unsigned route)
+{
+    uint32_t id = route * 2654435761UL;
+
+    memset(addr, 0, BENCH_ADDR_LEN);
+    addr[0] = 0x20;
+    addr[1] = 0x01;
+    addr[2] = 0x0d;
+    addr[3] = 0xb8;
+    addr[4] = (uint8_t)(id >> 24);
+    addr[5] = (uint8_t)(id >> 16);
+    addr[6] = (uint8_t)(id >> 8);
+    addr[7] = (uint8_t)id;
+}
+
+static int _fill(unsigned routes)
+{
+    uint8_t addr[BENCH_ADDR_LEN] = { 0 };
+
+    _table.size = routes + 1;
+    fib_init(&_table);
+    /* default route */
+    if (fib_add_entry(&_table, 1, addr, sizeof(addr), 0, _next_hop,
+                      sizeof(_next_hop), 0,
+                      (uint32_t)FIB_LIFETIME_NO_EXPIRE) < 0) {
+        return -1;
+    }
+    for (unsigned i = 0; i < routes; i++) {
+        _route_addr(addr, i);
+        _next_hop[15] = 1 + (i % BENCH_NEXT_HOPS);
+        if (fib_add_entry(&_table, 1, addr, sizeof(addr),
+                          BENCH_PREFIX_LEN << FIB_FLAG_NET_PREFIX_SHIFT,
+                          _next_hop, sizeof(_next_hop), 0,
+                          (uint32_t)FIB_LIFETIME_NO_EXPIRE) < 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static void _lookup(uint8_t *dst)
+{
+    uint8_t next_hop[BENCH_ADDR_LEN];
+    size_t next_hop_size = sizeof(next_hop);
+    kernel_pid_t iface;
+    uint32_t next_hop_flags;
+
+    if (fib_get_next_hop(&_table, &iface, next_hop, &next_hop_size,
+                         &next_hop_flags, dst, BENCH_ADDR_LEN, 0) < 0) {
+        _fails++;
+    }
+}
+
+int main(void)
+{
+    static const unsigned routes[] = { 16, 128, BENCH_ROUTES_MAX };
+    uint8_t dst[BENCH_ADDR_LEN];
+    char name[32];
+
+    puts("Runtime of fib_get_next_hop()\n");
+    for (unsigned i = 0; i < sizeof(routes) / sizeof(routes[0]); i++) {
+        if (_fill(routes[i]) < 0) {
+            printf("Unable to add %u routes\n", routes[i]);
+            return 1;
+        }
+        /* the last route is the worst case for the linear search */
+        _route_addr(dst, routes[i] - 1);
+        dst[15] = 0x01;
+        snprintf(name, sizeof(name), "%4u routes", routes[i]);
+        BENCHMARK_FUNC(name, BENCH_RUNS, _lookup(dst));
+        fib_deinit(&_table);
+    }
+    if (_fails > 0) {
+        printf("%u lookups failed\n", _fails);
+        return 1;
+    }
+
+    puts("\n[SUCCESS]");
+    return 0;
+}
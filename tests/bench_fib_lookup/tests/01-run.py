@@ -0,0 +1,28 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2019 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+# The default timeout is not enough for the linear search on slower boards
+TIMEOUT = 60
+BENCHMARK_REGEXP = r"\s+{func}:\s+\d+us\s+---\s+\d*\.*\d+us per call\s+---\s+\d+ calls per sec"
+ROUTES = (16, 128, 1024)
+
+
+def testfunc(child):
+    child.expect_exact('Runtime of fib_get_next_hop()')
+    for routes in ROUTES:
+        name = "{:4} routes".format(routes)
+        child.expect(BENCHMARK_REGEXP.format(func=name), timeout=TIMEOUT)
+    child.expect_exact('[SUCCESS]')
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
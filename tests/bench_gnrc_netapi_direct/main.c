@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure the receive path of a UDP datagram through GNRC with
+ *              and without `gnrc_netapi_direct`
+ *
+ * @author      Martine Lenders <m.lenders@fu-berlin.de>
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "benchmark.h"
+#include "net/gnrc.h"
+#include "net/gnrc/ipv6.h"
+#include "net/gnrc/udp.h"
+#include "net/inet_csum.h"
+#include "net/ipv6/hdr.h"
+#include "net/protnum.h"
+#include "net/sock/udp.h"
+#include "net/udp.h"
+#include "sched.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef BENCH_RUNS
+#define BENCH_RUNS          (10UL * 1000UL)
+#endif
+
+#define BENCH_PAYLOAD_LEN   (16U)
+#define BENCH_PORT          (61616U)
+#define BENCH_HOP_LIMIT     (64U)
+
+#define BENCH_UDP_LEN       (sizeof(udp_hdr_t) + BENCH_PAYLOAD_LEN)
+
+/* IPv6 datagram as an interface would pass it up the stack */
+static uint8_t _frame[sizeof(ipv6_hdr_t) + BENCH_UDP_LEN];
+static uint8_t _buf[BENCH_PAYLOAD_LEN];
+static sock_udp_t _sock;
+static unsigned _fails;
+
+static void _init_frame(void)
+{
+    ipv6_hdr_t *ipv6 = (ipv6_hdr_t *)_frame;
+    udp_hdr_t *udp = (udp_hdr_t *)(ipv6 + 1);
+    uint16_t csum;
+
+    ipv6_hdr_set_version(ipv6);
+    ipv6->len = byteorder_htons(BENCH_UDP_LEN);
+    ipv6->nh = PROTNUM_UDP;
+    ipv6->hl = BENCH_HOP_LIMIT;
+    /* loopback, so no interface is needed */
+    ipv6->src = ipv6_addr_loopback;
+    ipv6->dst = ipv6_addr_loopback;
+    udp->src_port = byteorder_htons(BENCH_PORT);
+    udp->dst_port = byteorder_htons(BENCH_PORT);
+    udp->length = byteorder_htons(BENCH_UDP_LEN);
+    udp->checksum.u16 = 0;
+    memset(udp + 1, 0xa5, BENCH_PAYLOAD_LEN);
+    csum = inet_csum(0, (uint8_t *)udp, BENCH_UDP_LEN);
+    csum = ipv6_hdr_inet_csum(csum, ipv6, PROTNUM_UDP, BENCH_UDP_LEN);
+    udp->checksum = byteorder_htons((csum == 0xffff) ? csum : ~csum);
+}
+
+static unsigned _schedules(void)
+{
+    unsigned res = 0;
+
+    for (kernel_pid_t i = KERNEL_PID_FIRST; i <= KERNEL_PID_LAST; i++) {
+        res += sched_pidlist[i].schedules;
+    }
+    return res;
+}
+
+/* receives one datagram the way a network interface thread passes it up */
+static void _recv(void)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, _frame, sizeof(_frame),
+                                          GNRC_NETTYPE_IPV6);
+
+    if (pkt == NULL) {
+        _fails++;
+        return;
+    }
+    if (gnrc_netapi_dispatch_receive(GNRC_NETTYPE_IPV6,
+                                     GNRC_NETREG_DEMUX_CTX_ALL, pkt) == 0) {
+        gnrc_pktbuf_release(pkt);
+        _fails++;
+        return;
+    }
+    if (sock_udp_recv(&_sock, _buf, sizeof(_buf), SOCK_NO_TIMEOUT,
+                      NULL) != BENCH_PAYLOAD_LEN) {
+        _fails++;
+    }
+}
+
+#ifdef DEVELHELP
+static void _print_stack(const char *name, kernel_pid_t pid)
+{
+    thread_t *thread = (thread_t *)thread_get(pid);
+
+    if (thread == NULL) {
+        printf("%s stack: no thread\n", name);
+        return;
+    }
+    printf("%s stack: %u of %u bytes used\n", name,
+           (unsigned)(thread->stack_size -
+                      thread_measure_stack_free(thread->stack_start)),
+           (unsigned)thread->stack_size);
+}
+#endif
+
+int main(void)
+{
+    static const sock_udp_ep_t local = { .family = AF_INET6,
+                                         .port = BENCH_PORT };
+    kernel_pid_t udp_pid;
+    uint32_t time;
+    unsigned schedules;
+
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+    puts("Receive path of a UDP datagram with gnrc_netapi_direct\n");
+#else
+    puts("Receive path of a UDP datagram\n");
+#endif
+    _init_frame();
+    if (sock_udp_create(&_sock, &local, NULL, 0) < 0) {
+        puts("Unable to create sock");
+        return 1;
+    }
+    /* the network threads have a higher priority than the main thread, so
+     * every datagram was passed up to the sock before sock_udp_recv() is
+     * called. BENCHMARK_FUNC() disables interrupts, which would keep the
+     * network stack from handling the messages, so the time is taken by
+     * hand */
+    schedules = _schedules();
+    time = xtimer_now_usec();
+    for (unsigned long i = 0; i < BENCH_RUNS; i++) {
+        _recv();
+    }
+    time = xtimer_now_usec() - time;
+    schedules = _schedules() - schedules;
+    benchmark_print_time(time, BENCH_RUNS, "receive");
+    /* includes the switches to the idle thread and back, if any */
+    printf("context switches per datagram: %u.%02u\n",
+           (unsigned)(schedules / BENCH_RUNS),
+           (unsigned)(((schedules % BENCH_RUNS) * 100) / BENCH_RUNS));
+    /* returns the PID of the thread UDP is handled in */
+    udp_pid = gnrc_udp_init();
+#ifdef DEVELHELP
+    _print_stack("ipv6", gnrc_ipv6_pid);
+    _print_stack("udp", (udp_pid == gnrc_ipv6_pid) ? KERNEL_PID_UNDEF
+                                                   : udp_pid);
+#else
+    (void)udp_pid;
+#endif
+    sock_udp_close(&_sock);
+    if (_fails > 0) {
+        printf("%u datagrams were not received\n", _fails);
+        return 1;
+    }
+
+    puts("\n[SUCCESS]");
+    return 0;
+}
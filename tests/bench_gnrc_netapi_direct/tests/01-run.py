@@ -0,0 +1,26 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2019 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+# The default timeout is not enough for this test on some of the slower boards
+TIMEOUT = 60
+BENCHMARK_REGEXP = r"\s+{func}:\s+\d+us\s+---\s+\d*\.*\d+us per call\s+---\s+\d+ calls per sec"
+
+
+def testfunc(child):
+    child.expect(r'Receive path of a UDP datagram( with gnrc_netapi_direct)?')
+    child.expect(BENCHMARK_REGEXP.format(func="receive"), timeout=TIMEOUT)
+    child.expect(r"context switches per datagram: \d+\.\d+")
+    child.expect_exact('[SUCCESS]')
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
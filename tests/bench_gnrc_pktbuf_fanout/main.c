@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure runtime of delivering a packet to multiple subscribers
+ *
+ * @author      Martine Lenders <m.lenders@fu-berlin.de>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "benchmark.h"
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/netreg.h"
+#include "net/gnrc/pktbuf.h"
+
+#ifndef BENCH_RUNS
+#define BENCH_RUNS          (100UL * 1000UL)
+#endif
+
+#ifndef BENCH_SUBSCRIBERS
+#define BENCH_SUBSCRIBERS   (8U)
+#endif
+
+#define BENCH_DEMUX_CTX     (61616U)
+
+static gnrc_netreg_entry_cbd_t _cbd;
+static gnrc_netreg_entry_t _entries[BENCH_SUBSCRIBERS];
+static gnrc_pktsnip_t *_pkt;
+
+static void _release_cb(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx)
+{
+    (void)cmd;
+    (void)ctx;
+    gnrc_pktbuf_release(pkt);
+}
+
+static void _hold_release(unsigned subscribers)
+{
+    gnrc_pktbuf_hold(_pkt, subscribers);
+    for (unsigned i = 0; i < subscribers; i++) {
+        gnrc_pktbuf_release(_pkt);
+    }
+}
+
+static void _dispatch(void)
+{
+    /* keep packet for next run */
+    gnrc_pktbuf_hold(_pkt, 1);
+    gnrc_netapi_dispatch_receive(GNRC_NETTYPE_UNDEF, BENCH_DEMUX_CTX, _pkt);
+}
+
+int main(void)
+{
+    char name[32];
+
+    puts("Runtime of packet fan-out to N subscribers\n");
+
+    /* three snips as for a received UDP packet: payload, UDP, IPv6 */
+    _pkt = gnrc_pktbuf_add(NULL, NULL, 64, GNRC_NETTYPE_UNDEF);
+    _pkt = gnrc_pktbuf_add(_pkt, NULL, 8, GNRC_NETTYPE_UNDEF);
+    _pkt = gnrc_pktbuf_add(_pkt, NULL, 40, GNRC_NETTYPE_UNDEF);
+    if (_pkt == NULL) {
+        puts("Unable to allocate packet");
+        return 1;
+    }
+    _cbd.cb = _release_cb;
+    for (unsigned n = 1; n <= BENCH_SUBSCRIBERS; n++) {
+        snprintf(name, sizeof(name), "hold/release N=%u", n);
+        BENCHMARK_FUNC(name, BENCH_RUNS, _hold_release(n));
+    }
+    puts("");
+    for (unsigned n = 1; n <= BENCH_SUBSCRIBERS; n++) {
+        gnrc_netreg_entry_init_cb(&_entries[n - 1], BENCH_DEMUX_CTX, &_cbd);
+        gnrc_netreg_register(GNRC_NETTYPE_UNDEF, &_entries[n - 1]);
+        snprintf(name, sizeof(name), "dispatch N=%u", n);
+        BENCHMARK_FUNC(name, BENCH_RUNS, _dispatch());
+    }
+    gnrc_pktbuf_release(_pkt);
+
+    puts("\n[SUCCESS]");
+    return 0;
+}
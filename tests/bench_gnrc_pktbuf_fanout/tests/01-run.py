@@ -0,0 +1,31 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2019 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+# The default timeout is not enough for this test on some of the slower boards
+TIMEOUT = 30
+BENCHMARK_REGEXP = r"\s+{func}:\s+\d+us\s+---\s+\d*\.*\d+us per call\s+---\s+\d+ calls per sec"
+SUBSCRIBERS = 8
+
+
+def testfunc(child):
+    child.expect_exact('Runtime of packet fan-out to N subscribers')
+    for n in range(1, SUBSCRIBERS + 1):
+        child.expect(BENCHMARK_REGEXP.format(func="hold/release N={}".format(n)),
+                     timeout=TIMEOUT)
+    for n in range(1, SUBSCRIBERS + 1):
+        child.expect(BENCHMARK_REGEXP.format(func="dispatch N={}".format(n)),
+                     timeout=TIMEOUT)
+    child.expect_exact('[SUCCESS]')
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
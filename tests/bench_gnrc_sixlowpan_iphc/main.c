@@ -0,0 +1,423 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure 6LoWPAN IPHC encoding and decoding for common header
+ *              shapes
+ *
+ * @author      Martine Lenders <m.lenders@fu-berlin.de>
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "benchmark.h"
+#include "msg.h"
+#include "net/gnrc.h"
+#include "net/gnrc/ipv6/hdr.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/netif/ieee802154.h"
+#include "net/gnrc/sixlowpan/ctx.h"
+#include "net/gnrc/sixlowpan/iphc.h"
+#include "net/gnrc/udp.h"
+#include "net/netdev_test.h"
+#include "net/sixlowpan.h"
+#include "utlist.h"
+#include "xtimer.h"
+
+#ifndef BENCH_RUNS
+#define BENCH_RUNS          (10UL * 1000UL)
+#endif
+
+#define BENCH_PAYLOAD_LEN   (16U)
+#define BENCH_FRAME_MAX     (127U)
+#define BENCH_MAX_PDU_SIZE  (102U)
+#define BENCH_PORT          (5683U)
+#define BENCH_HOP_LIMIT     (64U)
+#define BENCH_MSG_QUEUE_SIZE    (4U)
+/* time to let the interface thread send everything queued up */
+#define BENCH_SETTLE_US     (10U * US_PER_MS)
+/* lower than the main thread, so the interface does not preempt the encoder */
+#define BENCH_NETIF_PRIO    (THREAD_PRIORITY_MAIN + 1)
+
+#define LOCAL_EUI64         { 0x02, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x00, 0x01 }
+#define REMOTE_EUI64        { 0x02, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x00, 0x02 }
+/* interface identifiers derived from the EUI-64s above */
+#define LOCAL_IID           0x00, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x00, 0x01
+#define REMOTE_IID          0x00, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x00, 0x02
+
+typedef struct {
+    const char *name;
+    ipv6_addr_t src;
+    ipv6_addr_t dst;
+    bool multicast;
+    uint8_t frame[BENCH_FRAME_MAX];     /* IPHC frame as sent by the encoder */
+    size_t frame_len;
+} _shape_t;
+
+static _shape_t _shapes[] = {
+    {
+        .name = "link-local",
+        .src = { .u8 = { 0xfe, 0x80, 0, 0, 0, 0, 0, 0, LOCAL_IID } },
+        .dst = { .u8 = { 0xfe, 0x80, 0, 0, 0, 0, 0, 0, REMOTE_IID } },
+    },
+    {
+        .name = "global ctx",
+        /* compressed with context 0 */
+        .src = { .u8 = { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0, LOCAL_IID } },
+        /* compressed with context 1 */
+        .dst = { .u8 = { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 1, REMOTE_IID } },
+    },
+    {
+        .name = "multicast",
+        .src = { .u8 = { 0xfe, 0x80, 0, 0, 0, 0, 0, 0, LOCAL_IID } },
+        .dst = IPV6_ADDR_ALL_NODES_LINK_LOCAL,
+        .multicast = true,
+    },
+};
+
+static char _netif_stack[THREAD_STACKSIZE_DEFAULT];
+static msg_t _msg_queue[BENCH_MSG_QUEUE_SIZE];
+static netdev_test_t _dev;
+static gnrc_netif_t *_netif;
+static const uint8_t _local_l2[] = LOCAL_EUI64;
+static const uint8_t _remote_l2[] = REMOTE_EUI64;
+static const uint8_t _payload[BENCH_PAYLOAD_LEN] = { 0xa5 };
+/* shape to store the next sent frame for, NULL to drop it */
+static _shape_t *volatile _capture;
+static unsigned _fails;
+
+static int _get_device_type(netdev_t *netdev, void *value, size_t max_len)
+{
+    assert(max_len == sizeof(uint16_t));
+    (void)netdev;
+
+    *((uint16_t *)value) = NETDEV_TYPE_IEEE802154;
+    return sizeof(uint16_t);
+}
+
+static int _get_proto(netdev_t *netdev, void *value, size_t max_len)
+{
+    assert(max_len == sizeof(gnrc_nettype_t));
+    (void)netdev;
+
+    *((gnrc_nettype_t *)value) = GNRC_NETTYPE_SIXLOWPAN;
+    return sizeof(gnrc_nettype_t);
+}
+
+static int _get_max_packet_size(netdev_t *netdev, void *value, size_t max_len)
+{
+    assert(max_len == sizeof(uint16_t));
+    (void)netdev;
+
+    *((uint16_t *)value) = BENCH_MAX_PDU_SIZE;
+    return sizeof(uint16_t);
+}
+
+static int _get_src_len(netdev_t *netdev, void *value, size_t max_len)
+{
+    assert(max_len == sizeof(uint16_t));
+    (void)netdev;
+
+    *((uint16_t *)value) = sizeof(_local_l2);
+    return sizeof(uint16_t);
+}
+
+static int _get_addr_long(netdev_t *netdev, void *value, size_t max_len)
+{
+    assert(max_len >= sizeof(_local_l2));
+    (void)netdev;
+
+    memcpy(value, _local_l2, sizeof(_local_l2));
+    return sizeof(_local_l2);
+}
+
+static int _send(netdev_t *netdev, const iolist_t *iolist)
+{
+    _shape_t *shape = _capture;
+    size_t len = 0;
+
+    (void)netdev;
+    if (shape == NULL) {
+        return iolist_size(iolist);
+    }
+    /* first entry is the MAC header */
+    for (const iolist_t *ptr = iolist->iol_next; ptr != NULL;
+         ptr = ptr->iol_next) {
+        if ((len + ptr->iol_len) > sizeof(shape->frame)) {
+            return iolist_size(iolist);
+        }
+        memcpy(&shape->frame[len], ptr->iol_base, ptr->iol_len);
+        len += ptr->iol_len;
+    }
+    /* only take the benchmark's own UDP datagrams, the network stack might
+     * send e.g. router solicitations on its own */
+    if ((len > 0) && sixlowpan_iphc_is(shape->frame) &&
+        (shape->frame[0] & SIXLOWPAN_IPHC1_NH)) {
+        shape->frame_len = len;
+        _capture = NULL;
+    }
+    return iolist_size(iolist);
+}
+
+static int _init_interface(void)
+{
+    netdev_test_setup(&_dev, NULL);
+    netdev_test_set_get_cb(&_dev, NETOPT_DEVICE_TYPE, _get_device_type);
+    netdev_test_set_get_cb(&_dev, NETOPT_PROTO, _get_proto);
+    netdev_test_set_get_cb(&_dev, NETOPT_MAX_PDU_SIZE, _get_max_packet_size);
+    netdev_test_set_get_cb(&_dev, NETOPT_SRC_LEN, _get_src_len);
+    netdev_test_set_get_cb(&_dev, NETOPT_ADDRESS_LONG, _get_addr_long);
+    netdev_test_set_send_cb(&_dev, _send);
+    _netif = gnrc_netif_ieee802154_create(_netif_stack, sizeof(_netif_stack),
+                                          BENCH_NETIF_PRIO, "bench_netif",
+                                          (netdev_t *)&_dev);
+    if (_netif == NULL) {
+        return -1;
+    }
+    /* wait for the interface thread to initialize */
+    xtimer_usleep(BENCH_SETTLE_US);
+    return 0;
+}
+
+static void _init_contexts(void)
+{
+    ipv6_addr_t prefix = { .u8 = { 0x20, 0x01, 0x0d, 0xb8 } };
+
+    /* 2001:db8::/64 */
+    gnrc_sixlowpan_ctx_update(0, &prefix, 64, UINT16_MAX, true);
+    /* 2001:db8::/32, shorter than and overlapping with the other two */
+    gnrc_sixlowpan_ctx_update(2, &prefix, 32, UINT16_MAX, true);
+    /* 2001:db8:0:1::/64 */
+    prefix.u8[7] = 1;
+    gnrc_sixlowpan_ctx_update(1, &prefix, 64, UINT16_MAX, true);
+}
+
+static gnrc_pktsnip_t *_build_tx(const _shape_t *shape)
+{
+    gnrc_pktsnip_t *pkt, *hdr;
+
+    pkt = gnrc_pktbuf_add(NULL, _payload, sizeof(_payload), GNRC_NETTYPE_UNDEF);
+    if (pkt == NULL) {
+        return NULL;
+    }
+    if ((hdr = gnrc_udp_hdr_build(pkt, BENCH_PORT, BENCH_PORT)) == NULL) {
+        goto error;
+    }
+    pkt = hdr;
+    if ((hdr = gnrc_ipv6_hdr_build(pkt, &shape->src, &shape->dst)) == NULL) {
+        goto error;
+    }
+    pkt = hdr;
+    ((ipv6_hdr_t *)pkt->data)->hl = BENCH_HOP_LIMIT;
+    if (shape->multicast) {
+        hdr = gnrc_netif_hdr_build(NULL, 0, NULL, 0);
+    }
+    else {
+        hdr = gnrc_netif_hdr_build(NULL, 0, _remote_l2, sizeof(_remote_l2));
+    }
+    if (hdr == NULL) {
+        goto error;
+    }
+    ((gnrc_netif_hdr_t *)hdr->data)->if_pid = _netif->pid;
+    if (shape->multicast) {
+        ((gnrc_netif_hdr_t *)hdr->data)->flags |= GNRC_NETIF_HDR_FLAGS_MULTICAST;
+    }
+    LL_PREPEND(pkt, hdr);
+    return pkt;
+
+error:
+    gnrc_pktbuf_release(pkt);
+    return NULL;
+}
+
+static gnrc_pktsnip_t *_build_rx(const _shape_t *shape)
+{
+    gnrc_pktsnip_t *sixlo, *netif;
+
+    sixlo = gnrc_pktbuf_add(NULL, shape->frame, shape->frame_len,
+                            GNRC_NETTYPE_SIXLOWPAN);
+    if (sixlo == NULL) {
+        return NULL;
+    }
+    if (shape->multicast) {
+        netif = gnrc_netif_hdr_build(_local_l2, sizeof(_local_l2), NULL, 0);
+    }
+    else {
+        netif = gnrc_netif_hdr_build(_local_l2, sizeof(_local_l2),
+                                     _remote_l2, sizeof(_remote_l2));
+    }
+    if (netif == NULL) {
+        gnrc_pktbuf_release(sixlo);
+        return NULL;
+    }
+    ((gnrc_netif_hdr_t *)netif->data)->if_pid = _netif->pid;
+    if (shape->multicast) {
+        ((gnrc_netif_hdr_t *)netif->data)->flags |= GNRC_NETIF_HDR_FLAGS_MULTICAST;
+    }
+    LL_APPEND(sixlo, netif);
+    return sixlo;
+}
+
+static void _alloc_tx(const _shape_t *shape)
+{
+    gnrc_pktsnip_t *pkt = _build_tx(shape);
+
+    if (pkt == NULL) {
+        _fails++;
+        return;
+    }
+    gnrc_pktbuf_release(pkt);
+}
+
+static void _encode(const _shape_t *shape)
+{
+    gnrc_pktsnip_t *pkt = _build_tx(shape);
+
+    if (pkt == NULL) {
+        _fails++;
+        return;
+    }
+    gnrc_sixlowpan_iphc_send(pkt, NULL, 0);
+}
+
+static void _alloc_rx(const _shape_t *shape)
+{
+    gnrc_pktsnip_t *pkt = _build_rx(shape);
+
+    if (pkt == NULL) {
+        _fails++;
+        return;
+    }
+    gnrc_pktbuf_release(pkt);
+}
+
+static void _decode(const _shape_t *shape)
+{
+    gnrc_pktsnip_t *pkt = _build_rx(shape);
+
+    if (pkt == NULL) {
+        _fails++;
+        return;
+    }
+    gnrc_sixlowpan_iphc_recv(pkt, NULL, 0);
+}
+
+/* the interface thread needs to run in between, which BENCHMARK_FUNC() would
+ * prevent by disabling interrupts, so the time is taken by hand */
+static void _bench(const _shape_t *shape, const char *func_name,
+                   void (*func)(const _shape_t *))
+{
+    char name[32];
+    uint32_t time;
+
+    snprintf(name, sizeof(name), "%s %s", shape->name, func_name);
+    time = xtimer_now_usec();
+    for (unsigned long i = 0; i < BENCH_RUNS; i++) {
+        func(shape);
+    }
+    benchmark_print_time(xtimer_now_usec() - time, BENCH_RUNS, name);
+}
+
+static bool _round_trip(_shape_t *shape)
+{
+    gnrc_pktsnip_t *pkt;
+    ipv6_hdr_t *ipv6_hdr;
+    udp_hdr_t *udp_hdr;
+    msg_t msg;
+    bool ok;
+
+    _capture = shape;
+    _encode(shape);
+    /* let the interface send the frame */
+    xtimer_usleep(BENCH_SETTLE_US);
+    _capture = NULL;
+    if (shape->frame_len == 0) {
+        return false;
+    }
+    _decode(shape);
+    if ((msg_try_receive(&msg) < 0) ||
+        (msg.type != GNRC_NETAPI_MSG_TYPE_RCV)) {
+        return false;
+    }
+    pkt = msg.content.ptr;
+    ipv6_hdr = pkt->data;
+    udp_hdr = (udp_hdr_t *)(ipv6_hdr + 1);
+    ok = (pkt->size == (sizeof(ipv6_hdr_t) + sizeof(udp_hdr_t) +
+                        sizeof(_payload))) &&
+         ipv6_addr_equal(&ipv6_hdr->src, &shape->src) &&
+         ipv6_addr_equal(&ipv6_hdr->dst, &shape->dst) &&
+         (ipv6_hdr->nh == PROTNUM_UDP) &&
+         (ipv6_hdr->hl == BENCH_HOP_LIMIT) &&
+         (byteorder_ntohs(udp_hdr->src_port) == BENCH_PORT) &&
+         (byteorder_ntohs(udp_hdr->dst_port) == BENCH_PORT) &&
+         (memcmp(udp_hdr + 1, _payload, sizeof(_payload)) == 0);
+    gnrc_pktbuf_release(pkt);
+    return ok;
+}
+
+int main(void)
+{
+    gnrc_netreg_entry_t reg = GNRC_NETREG_ENTRY_INIT_PID(
+            GNRC_NETREG_DEMUX_CTX_ALL, sched_active_pid
+        );
+    gnrc_netreg_entry_t *ipv6;
+
+    msg_init_queue(_msg_queue, BENCH_MSG_QUEUE_SIZE);
+    puts("Runtime of 6LoWPAN IPHC encoding and decoding\n");
+    if (_init_interface() < 0) {
+        puts("Unable to create interface");
+        return 1;
+    }
+    _init_contexts();
+    /* take the IPv6 thread out of the receive path: decoded datagrams go to
+     * the main thread for the round trip check and are dropped while
+     * measuring */
+    ipv6 = gnrc_netreg_lookup(GNRC_NETTYPE_IPV6, GNRC_NETREG_DEMUX_CTX_ALL);
+    if (ipv6 != NULL) {
+        gnrc_netreg_unregister(GNRC_NETTYPE_IPV6, ipv6);
+    }
+    gnrc_netreg_register(GNRC_NETTYPE_IPV6, &reg);
+    for (unsigned i = 0; i < (sizeof(_shapes) / sizeof(_shapes[0])); i++) {
+        if (_round_trip(&_shapes[i])) {
+            printf("%s: round trip OK\n", _shapes[i].name);
+        }
+        else {
+            printf("%s: round trip FAILED\n", _shapes[i].name);
+            _fails++;
+        }
+    }
+    gnrc_netreg_unregister(GNRC_NETTYPE_IPV6, &reg);
+    puts("");
+    for (unsigned i = 0; i < (sizeof(_shapes) / sizeof(_shapes[0])); i++) {
+        _bench(&_shapes[i], "alloc tx", _alloc_tx);
+        _bench(&_shapes[i], "encode", _encode);
+        /* let the interface drop the frames that made it into its queue */
+        xtimer_usleep(BENCH_SETTLE_US);
+        _bench(&_shapes[i], "alloc rx", _alloc_rx);
+        _bench(&_shapes[i], "decode", _decode);
+    }
+    if (ipv6 != NULL) {
+        gnrc_netreg_register(GNRC_NETTYPE_IPV6, ipv6);
+    }
+    if (_fails > 0) {
+        printf("%u runs FAILED\n", _fails);
+        return 1;
+    }
+
+    puts("\n[SUCCESS]");
+    return 0;
+}
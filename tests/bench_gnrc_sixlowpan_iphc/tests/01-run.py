@@ -0,0 +1,32 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2019 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+# The default timeout is not enough for this test on some of the slower boards
+TIMEOUT = 60
+BENCHMARK_REGEXP = r"\s+{func}:\s+\d+us\s+---\s+\d*\.*\d+us per call\s+---\s+\d+ calls per sec"
+SHAPES = ("link-local", "global ctx", "multicast")
+FUNCS = ("alloc tx", "encode", "alloc rx", "decode")
+
+
+def testfunc(child):
+    child.expect_exact('Runtime of 6LoWPAN IPHC encoding and decoding')
+    for shape in SHAPES:
+        child.expect_exact("{}: round trip OK".format(shape))
+    for shape in SHAPES:
+        for func in FUNCS:
+            name = "{} {}".format(shape, func)
+            child.expect(BENCHMARK_REGEXP.format(func=name), timeout=TIMEOUT)
+    child.expect_exact('[SUCCESS]')
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure the Internet checksum for different buffer sizes and
+ *              alignments
+ *
+ * @author      Martine Lenders <m.lenders@fu-berlin.de>
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "benchmark.h"
+#include "net/inet_csum.h"
+
+/* every measurement covers the same number of bytes, so that the runtimes
+ * can be compared directly; the largest size still needs at least 1000 runs
+ * for benchmark_print_time() */
+#define BENCH_BYTES         (1280UL * 1000UL)
+#define BENCH_SIZE_MAX      (1280U)
+#define BENCH_OFFSET_MAX    (3U)
+
+static uint32_t _src_words[(BENCH_SIZE_MAX + BENCH_OFFSET_MAX + 3) / 4];
+static uint32_t _dst_words[(BENCH_SIZE_MAX + BENCH_OFFSET_MAX + 3) / 4];
+static uint8_t *const _src = (uint8_t *)_src_words;
+static uint8_t *const _dst = (uint8_t *)_dst_words;
+/* keeps the compiler from optimizing away the calculations */
+static volatile uint16_t _sum;
+
+static uint16_t _ref_csum(const uint8_t *buf, size_t len)
+{
+    uint32_t csum = 0;
+
+    for (size_t i = 0; i < len; i++) {
+        csum += (i & 1) ? buf[i] : (uint16_t)(buf[i] << 8);
+    }
+    while (csum >> 16) {
+        csum = (csum & 0xffff) + (csum >> 16);
+    }
+    return csum;
+}
+
+int main(void)
+{
+    static const uint16_t sizes[] = { 16, 64, 256, BENCH_SIZE_MAX };
+    unsigned fails = 0;
+    char name[32];
+
+    for (unsigned i = 0; i < sizeof(_src_words); i++) {
+        _src[i] = (uint8_t)(0xff - (i * 7));
+    }
+
+    puts("Runtime of Internet checksum calculations\n");
+    for (unsigned i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        const uint16_t size = sizes[i];
+        const unsigned long runs = BENCH_BYTES / size;
+
+        for (unsigned offset = 0; offset <= BENCH_OFFSET_MAX; offset++) {
+            uint8_t *src = &_src[offset], *dst = &_dst[offset];
+            const uint16_t expected = _ref_csum(src, size);
+
+            snprintf(name, sizeof(name), "csum %4u B +%u", size, offset);
+            BENCHMARK_FUNC(name, runs, _sum = inet_csum(0, src, size));
+            fails += (_sum != expected);
+            snprintf(name, sizeof(name), "memcpy+csum %4u B +%u", size,
+                     offset);
+            BENCHMARK_FUNC(name, runs,
+                           (memcpy(dst, src, size),
+                            _sum = inet_csum(0, dst, size)));
+            snprintf(name, sizeof(name), "csum_copy %4u B +%u", size, offset);
+            BENCHMARK_FUNC(name, runs,
+                           _sum = inet_csum_copy(0, dst, src, size, 0));
+            fails += (_sum != expected) || (memcmp(dst, src, size) != 0);
+        }
+    }
+    if (fails > 0) {
+        printf("%u checksums were wrong\n", fails);
+        return 1;
+    }
+
+    puts("\n[SUCCESS]");
+    return 0;
+}
@@ -0,0 +1,33 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2019 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+# The default timeout is not enough on slower boards
+TIMEOUT = 60
+BENCHMARK_REGEXP = r"\s+{func}:\s+\d+us\s+---\s+\d*\.*\d+us per call\s+---\s+\d+ calls per sec"
+SIZES = (16, 64, 256, 1280)
+OFFSETS = range(4)
+FUNCS = ("csum", r"memcpy\+csum", "csum_copy")
+
+
+def testfunc(child):
+    child.expect_exact('Runtime of Internet checksum calculations')
+    for size in SIZES:
+        for offset in OFFSETS:
+            for func in FUNCS:
+                name = r"{} {:4} B \+{}".format(func, size, offset)
+                child.expect(BENCHMARK_REGEXP.format(func=name),
+                             timeout=TIMEOUT)
+    child.expect_exact('[SUCCESS]')
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure the savings of sock_udp_sendv() over sock_udp_send()
+ *
+ * @author      Martine Lenders <m.lenders@fu-berlin.de>
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "benchmark.h"
+#include "net/sock/udp.h"
+#include "xtimer.h"
+
+#ifndef BENCH_RUNS
+#define BENCH_RUNS          (10UL * 1000UL)
+#endif
+
+#define BENCH_HDR_LEN       (16U)
+#define BENCH_PAYLOAD_MAX   (1024U)
+#define BENCH_PORT          (61616U)
+
+static const uint8_t _payload[BENCH_PAYLOAD_MAX] = { 0xa5 };
+static uint8_t _buf[BENCH_HDR_LEN + BENCH_PAYLOAD_MAX];
+static sock_udp_t _sock;
+static unsigned _fails;
+
+static void _build_hdr(uint8_t *hdr, size_t payload_len)
+{
+    memset(hdr, 0, BENCH_HDR_LEN);
+    hdr[0] = (uint8_t)(payload_len >> 8);
+    hdr[1] = (uint8_t)payload_len;
+}
+
+static void _send(size_t payload_len)
+{
+    uint8_t hdr[BENCH_HDR_LEN];
+
+    _build_hdr(hdr, payload_len);
+    memcpy(_buf, hdr, sizeof(hdr));
+    memcpy(&_buf[sizeof(hdr)], _payload, payload_len);
+    if (sock_udp_send(&_sock, _buf, sizeof(hdr) + payload_len, NULL) < 0) {
+        _fails++;
+    }
+}
+
+/* BENCHMARK_FUNC() disables interrupts, which would keep the network stack
+ * from handling the messages, so the time is taken by hand */
+static void _bench(const char *name, void (*func)(size_t), size_t payload_len)
+{
+    uint32_t time = xtimer_now_usec();
+
+    for (unsigned long i = 0; i < BENCH_RUNS; i++) {
+        func(payload_len);
+    }
+    benchmark_print_time(xtimer_now_usec() - time, BENCH_RUNS, name);
+}
+
+static void _sendv(size_t payload_len)
+{
+    uint8_t hdr[BENCH_HDR_LEN];
+    iolist_t payload = { .iol_base = (void *)_payload, .iol_len = payload_len };
+    iolist_t snips = { .iol_next = &payload, .iol_base = hdr,
+                       .iol_len = sizeof(hdr) };
+
+    _build_hdr(hdr, payload_len);
+    if (sock_udp_sendv(&_sock, &snips, NULL) < 0) {
+        _fails++;
+    }
+}
+
+int main(void)
+{
+    static const size_t sizes[] = { 16, 128, 512, BENCH_PAYLOAD_MAX };
+    sock_udp_ep_t remote = { .family = AF_INET6, .port = BENCH_PORT };
+    char name[32];
+
+    puts("Runtime of sock_udp_send() vs sock_udp_sendv()\n");
+    /* documentation prefix, there is no route to it */
+    remote.addr.ipv6[0] = 0x20;
+    remote.addr.ipv6[1] = 0x01;
+    remote.addr.ipv6[2] = 0x0d;
+    remote.addr.ipv6[3] = 0xb8;
+    remote.addr.ipv6[15] = 0x01;
+    if (sock_udp_create(&_sock, NULL, &remote, 0) < 0) {
+        puts("Unable to create sock");
+        return 1;
+    }
+    for (unsigned i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        size_t len = BENCH_HDR_LEN + sizes[i];
+
+        snprintf(name, sizeof(name), "send %4u", (unsigned)sizes[i]);
+        _bench(name, _send, sizes[i]);
+        printf("%25s: %u bytes copied per message\n", name,
+               (unsigned)(2 * len));
+        snprintf(name, sizeof(name), "sendv %4u", (unsigned)sizes[i]);
+        _bench(name, _sendv, sizes[i]);
+        printf("%25s: %u bytes copied per message\n", name, (unsigned)len);
+    }
+    sock_udp_close(&_sock);
+    if (_fails > 0) {
+        printf("%u messages could not be sent\n", _fails);
+        return 1;
+    }
+
+    puts("\n[SUCCESS]");
+    return 0;
+}
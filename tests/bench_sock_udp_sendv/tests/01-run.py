@@ -0,0 +1,31 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2019 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+# The default timeout is not enough for this test on some of the slower boards
+TIMEOUT = 60
+BENCHMARK_REGEXP = r"\s+{func}:\s+\d+us\s+---\s+\d*\.*\d+us per call\s+---\s+\d+ calls per sec"
+SIZES = (16, 128, 512, 1024)
+
+
+def testfunc(child):
+    child.expect_exact('Runtime of sock_udp_send() vs sock_udp_sendv()')
+    for size in SIZES:
+        for func in ("send", "sendv"):
+            name = "{} {:4}".format(func, size)
+            child.expect(BENCHMARK_REGEXP.format(func=name), timeout=TIMEOUT)
+            child.expect_exact("{}: {} bytes copied per message".format(
+                name, (2 if func == "send" else 1) * (16 + size)))
+    child.expect_exact('[SUCCESS]')
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -0,0 +1,580 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       TCP bulk transfer benchmark for GNRC TCP, GNRC sock_tcp and
+ *              lwIP sock_tcp
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mutex.h"
+#include "net/ethertype.h"
+#include "net/ethernet/hdr.h"
+#include "net/ipv6/addr.h"
+#include "net/ipv6/hdr.h"
+#include "net/netdev.h"
+#include "net/protnum.h"
+#include "net/tcp.h"
+#include "sched.h"
+#include "shell.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifdef MODULE_SOCK_TCP
+#include "net/sock/tcp.h"
+#else
+#include "net/af.h"
+#include "net/gnrc/tcp.h"
+#endif
+#ifdef MODULE_LWIP
+#include "lwip/netif.h"
+#else
+#include "net/gnrc/netif.h"
+#endif
+
+/* Size of the chunks handed to the stack */
+#ifndef BENCH_CHUNK_SIZE
+#define BENCH_CHUNK_SIZE    (1024U)
+#endif
+
+/* Amount of data to transfer, if not given */
+#ifndef BENCH_NBYTE
+#define BENCH_NBYTE         (256UL * 1024UL)
+#endif
+
+/* Number of request/response transactions, if not given */
+#ifndef BENCH_RR_NUM
+#define BENCH_RR_NUM        (100U)
+#endif
+
+/* Size of a request and of its response, if not given */
+#ifndef BENCH_RR_SIZE
+#define BENCH_RR_SIZE       (64U)
+#endif
+
+/* Headers that are looked at in each frame */
+#define BENCH_HDRS_LEN      (sizeof(ethernet_hdr_t) + sizeof(ipv6_hdr_t) + \
+                             sizeof(tcp_hdr_t))
+
+/* Control bits in the off_ctl field of the TCP header */
+#define CTL_FIN             (0x0001U)
+#define CTL_SYN             (0x0002U)
+#define CTL_RST             (0x0004U)
+#define CTL_ACK             (0x0010U)
+
+#define SEQ_LSS(x, y)       ((int32_t)((x) - (y)) < 0)
+#define SEQ_LEQ(x, y)       ((int32_t)((x) - (y)) <= 0)
+
+static struct {
+    unsigned frames_out;    /* TCP frames sent */
+    unsigned frames_in;     /* TCP frames received */
+    uint32_t bytes_out;     /* bytes of TCP frames sent */
+    uint32_t bytes_in;      /* bytes of TCP frames received */
+    unsigned data_out;      /* segments with payload sent */
+    unsigned data_in;       /* segments with payload received */
+    unsigned acks_out;      /* segments without payload sent */
+    unsigned rexmits;       /* segments sent again */
+    unsigned rtt_num;       /* RTT samples */
+    uint32_t rtt_min;       /* smallest RTT sample in us */
+    uint32_t rtt_max;       /* largest RTT sample in us */
+    uint64_t rtt_sum;       /* sum of all RTT samples in us */
+    uint32_t snd_max;       /* end of the data sent so far */
+    uint32_t timed_end;     /* end of the timed segment */
+    uint32_t timed_start;   /* time the timed segment was sent at */
+    bool started;           /* snd_max is valid */
+    bool timing;            /* a segment is timed */
+} _stats;
+
+static mutex_t _stats_lock = MUTEX_INIT;
+static uint16_t _port;
+static netdev_driver_t _driver;
+static const netdev_driver_t *_orig_driver;
+static uint8_t _buf[BENCH_CHUNK_SIZE];
+static char _line_buf[SHELL_DEFAULT_BUFSIZE];
+
+#ifdef MODULE_SOCK_TCP
+static sock_tcp_t _sock;
+static sock_tcp_queue_t _queue;
+#else
+static gnrc_tcp_tcb_t _tcb;
+#endif
+
+/* Gathers the headers of a frame from an iolist */
+static size_t _gather(uint8_t *hdrs, const iolist_t *iolist)
+{
+    size_t len = 0;
+
+    for (; (iolist != NULL) && (len < BENCH_HDRS_LEN); iolist = iolist->iol_next) {
+        size_t part = BENCH_HDRS_LEN - len;
+
+        if (part > iolist->iol_len) {
+            part = iolist->iol_len;
+        }
+        memcpy(&hdrs[len], iolist->iol_base, part);
+        len += part;
+    }
+    return len;
+}
+
+/* Returns the TCP header of a frame of the benchmark connection */
+static tcp_hdr_t *_tcp_hdr(uint8_t *frame, size_t len, size_t *pay_len)
+{
+    ethernet_hdr_t *eth = (ethernet_hdr_t *)frame;
+    ipv6_hdr_t *ipv6 = (ipv6_hdr_t *)(eth + 1);
+    tcp_hdr_t *tcp = (tcp_hdr_t *)(ipv6 + 1);
+
+    if ((len < BENCH_HDRS_LEN) ||
+        (byteorder_ntohs(eth->type) != ETHERTYPE_IPV6) ||
+        (ipv6->nh != PROTNUM_TCP) ||
+        ((byteorder_ntohs(tcp->src_port) != _port) &&
+         (byteorder_ntohs(tcp->dst_port) != _port))) {
+        return NULL;
+    }
+    *pay_len = byteorder_ntohs(ipv6->len) -
+               (byteorder_ntohs(tcp->off_ctl) >> 12) * 4;
+    return tcp;
+}
+
+static void _account_out(tcp_hdr_t *tcp, size_t frame_len, size_t pay_len)
+{
+    uint16_t ctl = byteorder_ntohs(tcp->off_ctl);
+    uint32_t seq = byteorder_ntohl(tcp->seq_num);
+    uint32_t end = seq + pay_len + ((ctl & CTL_SYN) ? 1 : 0) +
+                   ((ctl & CTL_FIN) ? 1 : 0);
+
+    _stats.frames_out++;
+    _stats.bytes_out += frame_len;
+    if (pay_len > 0) {
+        _stats.data_out++;
+    }
+    else if (!(ctl & (CTL_SYN | CTL_FIN | CTL_RST))) {
+        _stats.acks_out++;
+    }
+    if (end == seq) {
+        return;
+    }
+    if (!_stats.started) {
+        _stats.started = true;
+        _stats.snd_max = seq;
+    }
+    if (SEQ_LSS(seq, _stats.snd_max)) {
+        /* don't take samples for retransmitted data (Karn's algorithm) */
+        _stats.rexmits++;
+        _stats.timing = false;
+        return;
+    }
+    _stats.snd_max = end;
+    if (!_stats.timing) {
+        _stats.timing = true;
+        _stats.timed_end = end;
+        _stats.timed_start = xtimer_now_usec();
+    }
+}
+
+static void _account_in(tcp_hdr_t *tcp, size_t frame_len, size_t pay_len)
+{
+    uint16_t ctl = byteorder_ntohs(tcp->off_ctl);
+
+    _stats.frames_in++;
+    _stats.bytes_in += frame_len;
+    if (pay_len > 0) {
+        _stats.data_in++;
+    }
+    if ((ctl & CTL_ACK) && _stats.timing &&
+        SEQ_LEQ(_stats.timed_end, byteorder_ntohl(tcp->ack_num))) {
+        uint32_t rtt = xtimer_now_usec() - _stats.timed_start;
+
+        _stats.timing = false;
+        if ((_stats.rtt_num == 0) || (rtt < _stats.rtt_min)) {
+            _stats.rtt_min = rtt;
+        }
+        if (rtt > _stats.rtt_max) {
+            _stats.rtt_max = rtt;
+        }
+        _stats.rtt_sum += rtt;
+        _stats.rtt_num++;
+    }
+}
+
+static int _send(netdev_t *dev, const iolist_t *iolist)
+{
+    uint8_t hdrs[BENCH_HDRS_LEN];
+    size_t len = _gather(hdrs, iolist);
+    size_t pay_len;
+    tcp_hdr_t *tcp = _tcp_hdr(hdrs, len, &pay_len);
+
+    if (tcp != NULL) {
+        mutex_lock(&_stats_lock);
+        _account_out(tcp, iolist_size(iolist), pay_len);
+        mutex_unlock(&_stats_lock);
+    }
+    return _orig_driver->send(dev, iolist);
+}
+
+static int _recv(netdev_t *dev, void *buf, size_t len, void *info)
+{
+    int res = _orig_driver->recv(dev, buf, len, info);
+    size_t pay_len;
+    tcp_hdr_t *tcp;
+
+    if ((buf != NULL) && (res > 0) &&
+        ((tcp = _tcp_hdr(buf, res, &pay_len)) != NULL)) {
+        mutex_lock(&_stats_lock);
+        _account_in(tcp, res, pay_len);
+        mutex_unlock(&_stats_lock);
+    }
+    return res;
+}
+
+/* Sums up the time all threads but the idle thread were running */
+static uint64_t _busy_usec(void)
+{
+    uint64_t ticks = 0;
+
+    for (kernel_pid_t pid = KERNEL_PID_FIRST; pid <= KERNEL_PID_LAST; pid++) {
+        volatile thread_t *thread = thread_get(pid);
+
+        if ((thread != NULL) && (thread->priority != THREAD_PRIORITY_IDLE)) {
+            ticks += sched_pidlist[pid].runtime_ticks;
+        }
+    }
+    return xtimer_usec_from_ticks64((xtimer_ticks64_t){ ticks });
+}
+
+static void _print_stats(const char *op, uint32_t nbyte, uint32_t time,
+                         uint64_t busy)
+{
+    mutex_lock(&_stats_lock);
+    printf("%s %" PRIu32 " byte in %" PRIu32 " us: %" PRIu32 " kbit/s goodput\n",
+           op, nbyte, time,
+           (time > 0) ? (uint32_t)(((uint64_t)nbyte * 8000) / time) : 0);
+    printf("Frames: %u sent (%" PRIu32 " byte), %u received (%" PRIu32 " byte)\n",
+           _stats.frames_out, _stats.bytes_out, _stats.frames_in, _stats.bytes_in);
+    printf("Segments: %u data sent, %u retransmitted, %u data received, "
+           "%u ACKs sent\n",
+           _stats.data_out, _stats.rexmits, _stats.data_in, _stats.acks_out);
+    printf("RTT: %u samples, min %" PRIu32 " us, avg %" PRIu32 " us, "
+           "max %" PRIu32 " us\n", _stats.rtt_num, _stats.rtt_min,
+           (_stats.rtt_num > 0) ? (uint32_t)(_stats.rtt_sum / _stats.rtt_num) : 0,
+           _stats.rtt_max);
+    mutex_unlock(&_stats_lock);
+    printf("CPU: %" PRIu32 " us busy, %" PRIu32 " ns per byte\n", (uint32_t)busy,
+           (nbyte > 0) ? (uint32_t)((busy * 1000) / nbyte) : 0);
+}
+
+static void _reset_stats(uint16_t port)
+{
+    mutex_lock(&_stats_lock);
+    memset(&_stats, 0, sizeof(_stats));
+    _port = port;
+    mutex_unlock(&_stats_lock);
+}
+
+#ifdef MODULE_SOCK_TCP
+static uint16_t _netif_id(void)
+{
+#ifdef MODULE_LWIP
+    return netif_list->num + 1;
+#else
+    return gnrc_netif_iter(NULL)->pid;
+#endif
+}
+
+static int _connect(const char *addr, uint16_t port)
+{
+    sock_tcp_ep_t remote = { .family = AF_INET6, .port = port };
+
+    if (ipv6_addr_from_str((ipv6_addr_t *)&remote.addr.ipv6, addr) == NULL) {
+        return -EINVAL;
+    }
+    if (ipv6_addr_is_link_local((ipv6_addr_t *)&remote.addr.ipv6)) {
+        remote.netif = _netif_id();
+    }
+    return sock_tcp_connect(&_sock, &remote, 0, 0);
+}
+
+static int _accept(uint16_t port)
+{
+    sock_tcp_ep_t local = { .family = AF_INET6, .port = port };
+    sock_tcp_t *sock;
+    int res;
+
+    if ((res = sock_tcp_listen(&_queue, &local, &_sock, 1, 0)) < 0) {
+        return res;
+    }
+    puts("Listening");
+    res = sock_tcp_accept(&_queue, &sock, SOCK_NO_TIMEOUT);
+    return res;
+}
+
+static ssize_t _write(const void *data, size_t len)
+{
+    return sock_tcp_write(&_sock, data, len);
+}
+
+static ssize_t _read(void *data, size_t len)
+{
+    return sock_tcp_read(&_sock, data, len, SOCK_NO_TIMEOUT);
+}
+
+static void _close(bool listening)
+{
+    sock_tcp_disconnect(&_sock);
+    if (listening) {
+        sock_tcp_stop_listen(&_queue);
+    }
+}
+#else
+static int _connect(const char *addr, uint16_t port)
+{
+    char addr_str[IPV6_ADDR_MAX_STR_LEN + sizeof("%65535")];
+    ipv6_addr_t remote;
+
+    if (ipv6_addr_from_str(&remote, addr) == NULL) {
+        return -EINVAL;
+    }
+    /* GNRC TCP expects the interface of link-local addresses after a '%' */
+    if (ipv6_addr_is_link_local(&remote)) {
+        snprintf(addr_str, sizeof(addr_str), "%s%%%u", addr,
+                 (unsigned)gnrc_netif_iter(NULL)->pid);
+        addr = addr_str;
+    }
+    gnrc_tcp_tcb_init(&_tcb);
+    return gnrc_tcp_open_active(&_tcb, AF_INET6, (char *)addr, port, 0);
+}
+
+static int _accept(uint16_t port)
+{
+    gnrc_tcp_tcb_init(&_tcb);
+    puts("Listening");
+    return gnrc_tcp_open_passive(&_tcb, AF_INET6, NULL, port);
+}
+
+static ssize_t _write(const void *data, size_t len)
+{
+    return gnrc_tcp_send(&_tcb, data, len, 0);
+}
+
+static ssize_t _read(void *data, size_t len)
+{
+    return gnrc_tcp_recv(&_tcb, data, len, GNRC_TCP_CONNECTION_TIMEOUT_DURATION);
+}
+
+static void _close(bool listening)
+{
+    (void)listening;
+    gnrc_tcp_close(&_tcb);
+}
+#endif
+
+static int _cmd_send(int argc, char **argv)
+{
+    uint32_t nbyte = BENCH_NBYTE;
+    uint32_t start, time;
+    uint64_t busy;
+    uint16_t port;
+    int res;
+
+    if (argc < 3) {
+        printf("usage: %s <addr> <port> [<nbyte>]\n", argv[0]);
+        return 1;
+    }
+    port = atoi(argv[2]);
+    if (argc > 3) {
+        nbyte = strtoul(argv[3], NULL, 10);
+    }
+    _reset_stats(port);
+    memset(_buf, 0xa5, sizeof(_buf));
+
+    start = xtimer_now_usec();
+    busy = _busy_usec();
+    if ((res = _connect(argv[1], port)) < 0) {
+        printf("Unable to connect: %d\n", res);
+        return 1;
+    }
+    for (uint32_t sent = 0; sent < nbyte; sent += res) {
+        size_t len = ((nbyte - sent) < sizeof(_buf)) ? (nbyte - sent) : sizeof(_buf);
+
+        if ((res = _write(_buf, len)) < 0) {
+            printf("Unable to send: %d\n", res);
+            _close(false);
+            return 1;
+        }
+    }
+    _close(false);
+    time = xtimer_now_usec() - start;
+    _print_stats("Sent", nbyte, time, _busy_usec() - busy);
+    return 0;
+}
+
+static int _cmd_recv(int argc, char **argv)
+{
+    uint32_t nbyte = 0;
+    uint32_t start, time;
+    uint64_t busy;
+    uint16_t port;
+    int res;
+
+    if (argc < 2) {
+        printf("usage: %s <port>\n", argv[0]);
+        return 1;
+    }
+    port = atoi(argv[1]);
+    _reset_stats(port);
+
+    if ((res = _accept(port)) < 0) {
+        printf("Unable to accept: %d\n", res);
+        return 1;
+    }
+    /* the handshake is not measured, the peer decides when to start */
+    start = xtimer_now_usec();
+    busy = _busy_usec();
+    while ((res = _read(_buf, sizeof(_buf))) > 0) {
+        nbyte += res;
+    }
+    time = xtimer_now_usec() - start;
+    _close(true);
+    if (res < 0) {
+        printf("Unable to receive: %d\n", res);
+        return 1;
+    }
+    _print_stats("Received", nbyte, time, _busy_usec() - busy);
+    return 0;
+}
+
+static void _print_per_transaction(unsigned num)
+{
+    unsigned out, in;
+
+    mutex_lock(&_stats_lock);
+    out = (_stats.frames_out * 100) / num;
+    in = (_stats.frames_in * 100) / num;
+    mutex_unlock(&_stats_lock);
+    printf("Transactions: %u, %u.%02u frames sent and %u.%02u received per "
+           "transaction\n", num, out / 100, out % 100, in / 100, in % 100);
+}
+
+static int _cmd_rr(int argc, char **argv)
+{
+    unsigned num = BENCH_RR_NUM;
+    size_t size = BENCH_RR_SIZE;
+    uint32_t start, time;
+    uint64_t busy;
+    uint16_t port;
+    int res = 0;
+
+    if (argc < 3) {
+        printf("usage: %s <addr> <port> [<num> [<size>]]\n", argv[0]);
+        return 1;
+    }
+    port = atoi(argv[2]);
+    if (argc > 3) {
+        num = strtoul(argv[3], NULL, 10);
+    }
+    if (argc > 4) {
+        size = strtoul(argv[4], NULL, 10);
+    }
+    if ((num == 0) || (size == 0) || (size > sizeof(_buf))) {
+        printf("num must not be 0, size must be 1 to %u\n", (unsigned)sizeof(_buf));
+        return 1;
+    }
+    _reset_stats(port);
+    memset(_buf, 0xa5, sizeof(_buf));
+
+    start = xtimer_now_usec();
+    busy = _busy_usec();
+    if ((res = _connect(argv[1], port)) < 0) {
+        printf("Unable to connect: %d\n", res);
+        return 1;
+    }
+    /* the peer echoes each request, the next request waits for the response */
+    for (unsigned i = 0; (i < num) && (res >= 0); i++) {
+        for (size_t sent = 0; (sent < size) && (res >= 0); sent += res) {
+            res = _write(_buf + sent, size - sent);
+        }
+        for (size_t rcvd = 0; (rcvd < size) && (res >= 0); rcvd += res) {
+            if ((res = _read(_buf + rcvd, size - rcvd)) == 0) {
+                res = -ECONNRESET;
+            }
+        }
+    }
+    _close(false);
+    if (res < 0) {
+        printf("Unable to exchange: %d\n", res);
+        return 1;
+    }
+    time = xtimer_now_usec() - start;
+    _print_stats("Exchanged", 2 * num * size, time, _busy_usec() - busy);
+    _print_per_transaction(num);
+    return 0;
+}
+
+static const shell_command_t shell_commands[] = {
+    { "bench_send", "send data to a TCP server", _cmd_send },
+    { "bench_recv", "receive data from a TCP client", _cmd_recv },
+    { "bench_rr", "exchange requests and responses with a TCP echo server", _cmd_rr },
+    { NULL, NULL, NULL }
+};
+
+int main(void)
+{
+    netdev_t *dev;
+    ipv6_addr_t addr;
+    char addr_str[IPV6_ADDR_MAX_STR_LEN];
+
+#ifdef MODULE_LWIP
+    struct netif *netif = netif_list;
+
+    if (netif == NULL) {
+        puts("No valid network interface found");
+        return 1;
+    }
+    dev = netif->state;
+    memcpy(&addr, netif_ip6_addr(netif, 0), sizeof(addr));
+#else
+    gnrc_netif_t *netif = gnrc_netif_iter(NULL);
+    ipv6_addr_t addrs[GNRC_NETIF_IPV6_ADDRS_NUMOF];
+    int res;
+
+    if (netif == NULL) {
+        puts("No valid network interface found");
+        return 1;
+    }
+    dev = netif->dev;
+    ipv6_addr_set_unspecified(&addr);
+    res = gnrc_netif_ipv6_addrs_get(netif, addrs, sizeof(addrs));
+    for (unsigned i = 0; i < (res / sizeof(ipv6_addr_t)); i++) {
+        if (ipv6_addr_is_link_local(&addrs[i])) {
+            addr = addrs[i];
+        }
+    }
+#endif
+
+    /* Look at all frames going over the interface */
+    _orig_driver = dev->driver;
+    _driver = *_orig_driver;
+    _driver.send = _send;
+    _driver.recv = _recv;
+    dev->driver = &_driver;
+
+    printf("Address: %s\n", ipv6_addr_to_str(addr_str, &addr, sizeof(addr_str)));
+    shell_run(shell_commands, _line_buf, sizeof(_line_buf));
+    return 0;
+}
@@ -0,0 +1,131 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2019 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import re
+import socket
+import subprocess
+import sys
+import threading
+
+from testrunner import run
+
+
+PORT = 12345
+NBYTE = 64 * 1024
+STATS_REGEXP = (
+    r"{op} {nbyte} byte in \d+ us: \d+ kbit/s goodput\s+"
+    r"Frames: \d+ sent \(\d+ byte\), \d+ received \(\d+ byte\)\s+"
+    r"Segments: \d+ data sent, \d+ retransmitted, \d+ data received, \d+ ACKs sent\s+"
+    r"RTT: \d+ samples, min \d+ us, avg \d+ us, max \d+ us\s+"
+    r"CPU: \d+ us busy, \d+ ns per byte"
+)
+RR_NUM = 100
+RR_SIZE = 64
+RR_REGEXP = (
+    r"Transactions: {num}, (?P<out>\d+\.\d+) frames sent and "
+    r"(?P<in>\d+\.\d+) received per transaction"
+)
+
+
+def get_bridge(tap):
+    output = subprocess.check_output(["bridge", "link"]).decode("utf-8")
+    for line in output.splitlines():
+        m = re.search(r"{}.+master\s+(?P<master>[^\s]+)".format(tap), line)
+        if m is not None:
+            return m.group("master")
+    return tap
+
+
+def get_link_local(iface):
+    with open("/proc/net/if_inet6") as f:
+        for line in f:
+            fields = line.split()
+            if fields[5] == iface and fields[0].startswith("fe80"):
+                return ":".join(fields[0][i:i + 4] for i in range(0, 32, 4))
+    return None
+
+
+def host_send(addr, iface):
+    sock = socket.create_connection((addr, PORT, 0, socket.if_nametoindex(iface)),
+                                    timeout=10)
+    sock.sendall(b"\xa5" * NBYTE)
+    sock.close()
+
+
+def host_recv(server, result):
+    conn, _ = server.accept()
+    conn.settimeout(10)
+    nbyte = 0
+    while True:
+        chunk = conn.recv(4096)
+        if not chunk:
+            break
+        nbyte += len(chunk)
+    conn.close()
+    result.append(nbyte)
+
+
+def host_echo(server):
+    conn, _ = server.accept()
+    conn.settimeout(10)
+    while True:
+        chunk = conn.recv(4096)
+        if not chunk:
+            break
+        conn.sendall(chunk)
+    conn.close()
+
+
+def testfunc(child):
+    iface = get_bridge(os.environ["TAP"])
+
+    child.expect(r"Address: (?P<addr>[0-9a-f:]+)")
+    addr = child.match.group("addr")
+
+    # node receives
+    child.sendline("bench_recv {}".format(PORT))
+    child.expect_exact("Listening")
+    host_send(addr, iface)
+    child.expect(STATS_REGEXP.format(op="Received", nbyte=NBYTE))
+
+    # node sends
+    server = socket.socket(socket.AF_INET6, socket.SOCK_STREAM)
+    server.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    server.bind(("::", PORT))
+    server.listen(1)
+    result = []
+    thread = threading.Thread(target=host_recv, args=(server, result))
+    thread.start()
+    child.sendline("bench_send {} {} {}".format(get_link_local(iface), PORT, NBYTE))
+    child.expect(STATS_REGEXP.format(op="Sent", nbyte=NBYTE))
+    thread.join()
+    server.close()
+    assert result == [NBYTE]
+
+    # request/response: the ACK of each response is sent with the next
+    # request, so the node sends less than one ACK per response
+    server = socket.socket(socket.AF_INET6, socket.SOCK_STREAM)
+    server.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    server.bind(("::", PORT))
+    server.listen(1)
+    thread = threading.Thread(target=host_echo, args=(server,))
+    thread.start()
+    child.sendline("bench_rr {} {} {} {}".format(get_link_local(iface), PORT,
+                                                 RR_NUM, RR_SIZE))
+    child.expect(STATS_REGEXP.format(op="Exchanged", nbyte=2 * RR_NUM * RR_SIZE))
+    child.expect(RR_REGEXP.format(num=RR_NUM))
+    print("Frames sent per transaction: {}".format(child.match.group("out")))
+    assert float(child.match.group("out")) < 1.5
+    thread.join()
+    server.close()
+    print("SUCCESS")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=60))
@@ -0,0 +1,254 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests the shared thread of `gnrc_eventloop`
+ *
+ * @author      Martine Lenders <m.lenders@fu-berlin.de>
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdio.h>
+
+#include "msg.h"
+#include "net/gnrc.h"
+#include "net/gnrc/eventloop.h"
+#include "net/gnrc/ipv6.h"
+#include "net/gnrc/sixlowpan/config.h"
+#include "net/gnrc/tcp.h"
+#include "net/gnrc/udp.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define TEST_MSG_TYPE_A         (0x7f00U)
+#define TEST_MSG_TYPE_B         (0x7f10U)
+#define TEST_MBOX_SIZE          (4U)
+#define TEST_DEMUX_CTX          (0x1234U)
+#define TEST_TIMEOUT            (10U * US_PER_MS)
+/* number of messages the separate IPv6 and 6LoWPAN threads could queue */
+#define TEST_TIMER_MSGS         (GNRC_IPV6_MSG_QUEUE_SIZE + \
+                                 GNRC_SIXLOWPAN_MSG_QUEUE_SIZE)
+
+typedef struct {
+    unsigned pkts;
+    unsigned msgs;
+} _layer_stats_t;
+
+static char _burst_stack[THREAD_STACKSIZE_DEFAULT];
+static gnrc_eventloop_layer_t _layer_a, _layer_b;
+static msg_t _queue_a[TEST_MBOX_SIZE], _queue_b[TEST_MBOX_SIZE];
+static gnrc_netreg_entry_t _netreg_a;
+static _layer_stats_t _stats_a, _stats_b;
+static unsigned _burst_pkts, _burst_msgs;
+static unsigned _timeouts;
+static event_timeout_t _timeout;
+
+static void _handle_timeout(event_t *event)
+{
+    (void)event;
+    _timeouts++;
+}
+
+static event_t _timeout_event = { .handler = _handle_timeout };
+
+static void _handle(_layer_stats_t *stats, msg_t *msg)
+{
+    switch (msg->type) {
+        case GNRC_NETAPI_MSG_TYPE_RCV:
+        case GNRC_NETAPI_MSG_TYPE_SND:
+            stats->pkts++;
+            gnrc_pktbuf_release(msg->content.ptr);
+            break;
+        default:
+            stats->msgs++;
+            break;
+    }
+}
+
+static void _handle_a(msg_t *msg)
+{
+    _handle(&_stats_a, msg);
+}
+
+static void _handle_b(msg_t *msg)
+{
+    _handle(&_stats_b, msg);
+}
+
+static void _reset(void)
+{
+    _stats_a.pkts = 0;
+    _stats_a.msgs = 0;
+    _stats_b.pkts = 0;
+    _stats_b.msgs = 0;
+}
+
+static void _expect(const char *test, int cond)
+{
+    if (!cond) {
+        printf("%s: FAILED\n", test);
+        while (1) {}
+    }
+    printf("%s: OK\n", test);
+}
+
+static void *_burst(void *arg)
+{
+    (void)arg;
+    /* runs before the shared thread: fill the mailbox of layer A beyond its
+     * capacity, then send the messages the layers' timers could have sent */
+    for (unsigned i = 0; i <= TEST_MBOX_SIZE; i++) {
+        gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, NULL, 8,
+                                              GNRC_NETTYPE_UNDEF);
+
+        if (pkt == NULL) {
+            break;
+        }
+        if (gnrc_eventloop_put(&_layer_a, GNRC_NETAPI_MSG_TYPE_RCV,
+                               pkt) < 1) {
+            gnrc_pktbuf_release(pkt);
+        }
+        else {
+            _burst_pkts++;
+        }
+    }
+    for (unsigned i = 0; i < TEST_TIMER_MSGS; i++) {
+        msg_t msg = { .type = TEST_MSG_TYPE_B + (i % 2) };
+
+        _burst_msgs += msg_try_send(&msg, gnrc_eventloop_pid);
+    }
+    return NULL;
+}
+
+static void test_msg_routing(void)
+{
+    msg_t msg = { .type = TEST_MSG_TYPE_A };
+
+    _reset();
+    msg_send(&msg, gnrc_eventloop_pid);
+    msg.type = TEST_MSG_TYPE_B + 1;
+    msg_send(&msg, gnrc_eventloop_pid);
+    /* queueing the messages only marked the shared thread as pending */
+    thread_yield_higher();
+    _expect("test_msg_routing", (_stats_a.msgs == 1) && (_stats_b.msgs == 1));
+}
+
+static void test_pkt_routing(void)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, NULL, 8, GNRC_NETTYPE_TEST);
+
+    _reset();
+    _expect("test_pkt_routing",
+            (pkt != NULL) &&
+            (gnrc_netapi_dispatch_receive(GNRC_NETTYPE_TEST, TEST_DEMUX_CTX,
+                                          pkt) == 1) &&
+            (_stats_a.pkts == 1) && (_stats_b.pkts == 0) &&
+            gnrc_pktbuf_is_empty());
+}
+
+static void test_get_set(void)
+{
+    uint16_t val = 0;
+
+    _expect("test_get_set",
+            (gnrc_netapi_get(gnrc_eventloop_pid, NETOPT_MAX_PDU_SIZE, 0,
+                             &val, sizeof(val)) == -ENOTSUP) &&
+            (gnrc_netapi_set(gnrc_eventloop_pid, NETOPT_MAX_PDU_SIZE, 0,
+                             &val, sizeof(val)) == -ENOTSUP));
+}
+
+static void test_burst(void)
+{
+    _reset();
+    thread_create(_burst_stack, sizeof(_burst_stack), GNRC_EVENTLOOP_PRIO - 1,
+                  THREAD_CREATE_STACKTEST, _burst, NULL, "burst");
+    /* the shared thread handled everything before the main thread is
+     * scheduled again */
+    _expect("test_burst",
+            (_burst_pkts == TEST_MBOX_SIZE) &&
+            (_burst_msgs == TEST_TIMER_MSGS) &&
+            (_stats_a.pkts == TEST_MBOX_SIZE) &&
+            (_stats_b.msgs == TEST_TIMER_MSGS) &&
+            gnrc_pktbuf_is_empty());
+}
+
+static void test_timeout(void)
+{
+    bool expired;
+
+    _timeouts = 0;
+    gnrc_eventloop_timeout_init(&_timeout, &_timeout_event);
+    event_timeout_set(&_timeout, TEST_TIMEOUT);
+    xtimer_usleep(2 * TEST_TIMEOUT);
+    expired = (_timeouts == 1);
+    /* a cleared and cancelled timeout is not handled */
+    event_timeout_set(&_timeout, TEST_TIMEOUT);
+    event_timeout_clear(&_timeout);
+    gnrc_eventloop_cancel(&_timeout_event);
+    xtimer_usleep(2 * TEST_TIMEOUT);
+    _expect("test_timeout", expired && (_timeouts == 1));
+}
+
+static void test_tcp(void)
+{
+    gnrc_netreg_entry_t *entry = gnrc_netreg_lookup(GNRC_NETTYPE_TCP,
+                                                    GNRC_NETREG_DEMUX_CTX_ALL);
+
+    /* TCP was started by auto_init as a layer of the shared thread */
+    _expect("test_tcp",
+            (entry != NULL) && (entry->type == GNRC_NETREG_TYPE_CB) &&
+            (gnrc_tcp_init() == -1));
+}
+
+static void print_ram(void)
+{
+    /* IPv6, 6LoWPAN and UDP each had a thread with a stack and a message
+     * queue; now they share one thread and keep their queues as mailboxes */
+    unsigned threads = GNRC_IPV6_STACK_SIZE + GNRC_SIXLOWPAN_STACK_SIZE +
+                       GNRC_UDP_STACK_SIZE +
+                       (3 * sizeof(thread_t)) +
+                       ((GNRC_IPV6_MSG_QUEUE_SIZE +
+                         GNRC_SIXLOWPAN_MSG_QUEUE_SIZE +
+                         GNRC_UDP_MSG_QUEUE_SIZE) * sizeof(msg_t));
+    unsigned eventloop = GNRC_EVENTLOOP_STACK_SIZE + sizeof(thread_t) +
+                         ((GNRC_IPV6_MSG_QUEUE_SIZE +
+                           GNRC_SIXLOWPAN_MSG_QUEUE_SIZE +
+                           GNRC_UDP_MSG_QUEUE_SIZE +
+                           TEST_TIMER_MSGS) * sizeof(msg_t)) +
+                         (3 * sizeof(gnrc_eventloop_layer_t));
+
+    printf("RAM of separate threads: %u bytes\n", threads);
+    printf("RAM of shared thread: %u bytes\n", eventloop);
+}
+
+int main(void)
+{
+    gnrc_eventloop_register(&_layer_a, _queue_a, TEST_MBOX_SIZE, _handle_a,
+                            TEST_MSG_TYPE_A, TEST_MSG_TYPE_A + 0xf);
+    gnrc_eventloop_register(&_layer_b, _queue_b, TEST_MBOX_SIZE, _handle_b,
+                            TEST_MSG_TYPE_B, TEST_MSG_TYPE_B + 0xf);
+    gnrc_netreg_entry_init_cb(&_netreg_a, TEST_DEMUX_CTX, &_layer_a.cbd);
+    gnrc_netreg_register(GNRC_NETTYPE_TEST, &_netreg_a);
+
+    test_msg_routing();
+    test_pkt_routing();
+    test_get_set();
+    test_burst();
+    test_timeout();
+    test_tcp();
+    print_ram();
+
+    puts("[SUCCESS]");
+    return 0;
+}
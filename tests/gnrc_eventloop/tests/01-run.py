@@ -0,0 +1,28 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2019 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("test_msg_routing: OK")
+    child.expect_exact("test_pkt_routing: OK")
+    child.expect_exact("test_get_set: OK")
+    child.expect_exact("test_burst: OK")
+    child.expect_exact("test_timeout: OK")
+    child.expect_exact("test_tcp: OK")
+    child.expect(r"RAM of separate threads: (\d+) bytes")
+    threads = int(child.match.group(1))
+    child.expect(r"RAM of shared thread: (\d+) bytes")
+    assert int(child.match.group(1)) < threads
+    child.expect_exact("[SUCCESS]")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -28,6 +28,7 @@
 #include "net/ethernet.h"
 #include "net/gnrc.h"
 #include "net/gnrc/ipv6/nib.h"
+#include "net/gnrc/ipv6/nib/dcache.h"
 #include "net/gnrc/ipv6/nib/nc.h"
 #include "net/gnrc/netif/internal.h"
 #include "net/ndp.h"
@@ -224,6 +225,116 @@ static void test_get_next_hop_l2addr__link_local_static_conf(void)
     TEST_ASSERT(gnrc_pktbuf_is_empty());
 }
 
+#if GNRC_IPV6_NIB_CONF_DCACHE
+static void test_get_next_hop_l2addr__dcache_hit(void)
+{
+    gnrc_ipv6_nib_nc_t nce;
+    gnrc_ipv6_nib_dcache_stats_t before, after;
+
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_nc_set(&_rem_ll, _mock_netif->pid,
+                                                  _rem_l2, sizeof(_rem_l2)));
+    gnrc_ipv6_nib_dcache_get_stats(&before);
+    /* first lookup fills the cache, second one is served by it */
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_get_next_hop_l2addr(&_rem_ll,
+                                                               _mock_netif,
+                                                               NULL, &nce));
+    memset(&nce, 0, sizeof(nce));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_get_next_hop_l2addr(&_rem_ll,
+                                                               _mock_netif,
+                                                               NULL, &nce));
+    gnrc_ipv6_nib_dcache_get_stats(&after);
+    TEST_ASSERT_EQUAL_INT(before.misses + 1, after.misses);
+    TEST_ASSERT_EQUAL_INT(before.hits + 1, after.hits);
+    TEST_ASSERT_MESSAGE((memcmp(&_rem_ll, &nce.ipv6, sizeof(_rem_ll)) == 0),
+                        "_rem_ll != nce.ipv6");
+    TEST_ASSERT_EQUAL_INT(sizeof(_rem_l2), nce.l2addr_len);
+    TEST_ASSERT_MESSAGE((memcmp(&_rem_l2, &nce.l2addr, nce.l2addr_len) == 0),
+                        "_rem_l2 != nce.l2addr");
+    TEST_ASSERT_EQUAL_INT(_mock_netif->pid, gnrc_ipv6_nib_nc_get_iface(&nce));
+    TEST_ASSERT_EQUAL_INT(0, msg_avail());
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_get_next_hop_l2addr__dcache_miss(void)
+{
+    gnrc_ipv6_nib_nc_t nce;
+    gnrc_ipv6_nib_dcache_stats_t before, after;
+
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_nc_set(&_rem_ll, _mock_netif->pid,
+                                                  _rem_l2, sizeof(_rem_l2)));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_get_next_hop_l2addr(&_rem_ll,
+                                                               _mock_netif,
+                                                               NULL, &nce));
+    gnrc_ipv6_nib_dcache_get_stats(&before);
+    /* other destination without route is neither served by nor added to the
+     * cache */
+    TEST_ASSERT_EQUAL_INT(-ENETUNREACH,
+                          gnrc_ipv6_nib_get_next_hop_l2addr(&_rem_gb, NULL,
+                                                            NULL, &nce));
+    TEST_ASSERT_EQUAL_INT(-ENETUNREACH,
+                          gnrc_ipv6_nib_get_next_hop_l2addr(&_rem_gb, NULL,
+                                                            NULL, &nce));
+    gnrc_ipv6_nib_dcache_get_stats(&after);
+    TEST_ASSERT_EQUAL_INT(before.misses + 2, after.misses);
+    TEST_ASSERT_EQUAL_INT(before.hits, after.hits);
+    TEST_ASSERT_EQUAL_INT(0, msg_avail());
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_get_next_hop_l2addr__dcache_invalidated_by_nc(void)
+{
+    static const uint8_t new_l2[] = { _LL0, _LL1, _LL2, _LL3, _LL4, _LL5 + 2 };
+    gnrc_ipv6_nib_nc_t nce;
+    gnrc_ipv6_nib_dcache_stats_t before, after;
+
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_nc_set(&_rem_ll, _mock_netif->pid,
+                                                  _rem_l2, sizeof(_rem_l2)));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_get_next_hop_l2addr(&_rem_ll,
+                                                               _mock_netif,
+                                                               NULL, &nce));
+    gnrc_ipv6_nib_nc_del(&_rem_ll, _mock_netif->pid);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_nc_set(&_rem_ll, _mock_netif->pid,
+                                                  new_l2, sizeof(new_l2)));
+    gnrc_ipv6_nib_dcache_get_stats(&before);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_get_next_hop_l2addr(&_rem_ll,
+                                                               _mock_netif,
+                                                               NULL, &nce));
+    gnrc_ipv6_nib_dcache_get_stats(&after);
+    TEST_ASSERT_EQUAL_INT(before.misses + 1, after.misses);
+    TEST_ASSERT_EQUAL_INT(before.hits, after.hits);
+    TEST_ASSERT_EQUAL_INT(sizeof(new_l2), nce.l2addr_len);
+    TEST_ASSERT_MESSAGE((memcmp(&new_l2, &nce.l2addr, nce.l2addr_len) == 0),
+                        "new_l2 != nce.l2addr");
+    TEST_ASSERT_EQUAL_INT(0, msg_avail());
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_get_next_hop_l2addr__dcache_invalidated_by_addr(void)
+{
+    gnrc_ipv6_nib_nc_t nce;
+    gnrc_ipv6_nib_dcache_stats_t before, after;
+
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_nc_set(&_rem_ll, _mock_netif->pid,
+                                                  _rem_l2, sizeof(_rem_l2)));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_get_next_hop_l2addr(&_rem_ll,
+                                                               _mock_netif,
+                                                               NULL, &nce));
+    /* a new address may change the source address selection */
+    TEST_ASSERT(gnrc_netif_ipv6_addr_add_internal(_mock_netif, &_loc_gb,
+                        _LOC_GB_PFX_LEN,
+                        GNRC_NETIF_IPV6_ADDRS_FLAGS_STATE_VALID) >= 0);
+    gnrc_ipv6_nib_dcache_get_stats(&before);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_get_next_hop_l2addr(&_rem_ll,
+                                                               _mock_netif,
+                                                               NULL, &nce));
+    gnrc_ipv6_nib_dcache_get_stats(&after);
+    TEST_ASSERT_EQUAL_INT(before.misses + 1, after.misses);
+    TEST_ASSERT_EQUAL_INT(before.hits, after.hits);
+    TEST_ASSERT_MESSAGE((memcmp(&_rem_l2, &nce.l2addr, nce.l2addr_len) == 0),
+                        "_rem_l2 != nce.l2addr");
+}
+#endif  /* GNRC_IPV6_NIB_CONF_DCACHE */
+
 void _simulate_ndp_handshake(const ipv6_addr_t *src, const ipv6_addr_t *dst,
                              uint8_t adv_flags)
 {
@@ -1295,6 +1406,12 @@ static Test *tests_gnrc_ipv6_nib(void)
         new_TestFixture(test_get_next_hop_l2addr__link_local_after_handshake_iface),
         new_TestFixture(test_get_next_hop_l2addr__link_local_after_handshake_iface_router),
         new_TestFixture(test_get_next_hop_l2addr__link_local_after_handshake_no_iface),
+#if GNRC_IPV6_NIB_CONF_DCACHE
+        new_TestFixture(test_get_next_hop_l2addr__dcache_hit),
+        new_TestFixture(test_get_next_hop_l2addr__dcache_miss),
+        new_TestFixture(test_get_next_hop_l2addr__dcache_invalidated_by_nc),
+        new_TestFixture(test_get_next_hop_l2addr__dcache_invalidated_by_addr),
+#endif
         new_TestFixture(test_handle_pkt__unknown_type),
         new_TestFixture(test_handle_pkt__nbr_sol__invalid_hl),
         new_TestFixture(test_handle_pkt__nbr_sol__invalid_code),
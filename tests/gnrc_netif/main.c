@@ -61,6 +61,15 @@ static int _set_netdev_address_long(netdev_t *dev, const void *value,
 static int _get_netdev_src_len(netdev_t *dev, void *value, size_t max_len);
 static int _set_netdev_src_len(netdev_t *dev, const void *value,
                                size_t value_len);
+static int _get_netdev_csum_offload(netdev_t *dev, void *value,
+                                    size_t max_len);
+static int _set_netdev_csum_offload(netdev_t *dev, const void *value,
+                                    size_t value_len);
+static int _set_netdev_tx_csum_offload(netdev_t *dev, const void *value,
+                                       size_t value_len);
+
+/* number of frames the ethernet device was told to complete the checksum of */
+static unsigned ethernet_tx_csum_offloads = 0;
 
 static const gnrc_netif_ops_t default_ops = {
     .init = _test_init,
@@ -956,6 +965,58 @@ static void test_netapi_set__6LO_IPHC(void)
     TEST_ASSERT(netifs[0]->flags & GNRC_NETIF_FLAGS_6LO_HC);
 }
 
+static void test_netapi_set__CSUM_OFFLOAD(void)
+{
+    netopt_enable_t value = NETOPT_ENABLE;
+
+    /* the device did not offer checksum offloading on creation */
+    TEST_ASSERT(!(ethernet_netif->flags & GNRC_NETIF_FLAGS_CSUM_OFFLOAD));
+    TEST_ASSERT_EQUAL_INT(sizeof(value),
+                          gnrc_netapi_set(ethernet_netif->pid,
+                                          NETOPT_CSUM_OFFLOAD, 0,
+                                          &value, sizeof(value)));
+    TEST_ASSERT(ethernet_netif->flags & GNRC_NETIF_FLAGS_CSUM_OFFLOAD);
+    value = NETOPT_DISABLE;
+    TEST_ASSERT_EQUAL_INT(sizeof(value),
+                          gnrc_netapi_set(ethernet_netif->pid,
+                                          NETOPT_CSUM_OFFLOAD, 0,
+                                          &value, sizeof(value)));
+    TEST_ASSERT(!(ethernet_netif->flags & GNRC_NETIF_FLAGS_CSUM_OFFLOAD));
+    /* a device without checksum offloading refuses */
+    value = NETOPT_ENABLE;
+    TEST_ASSERT_EQUAL_INT(-ENOTSUP,
+                          gnrc_netapi_set(ieee802154_netif->pid,
+                                          NETOPT_CSUM_OFFLOAD, 0,
+                                          &value, sizeof(value)));
+    TEST_ASSERT(!(ieee802154_netif->flags & GNRC_NETIF_FLAGS_CSUM_OFFLOAD));
+}
+
+static void test_send__ethernet_csum_offload(void)
+{
+    uint8_t dst[] = { LA1, LA2, LA3, LA4, LA5, LA6 + 1 };
+
+    ethernet_tx_csum_offloads = 0;
+    for (unsigned i = 0; i < 2; i++) {
+        gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, "ABCDEFG",
+                                              sizeof("ABCDEFG"),
+                                              GNRC_NETTYPE_UNDEF);
+        gnrc_pktsnip_t *netif;
+
+        TEST_ASSERT_NOT_NULL(pkt);
+        netif = gnrc_netif_hdr_build(NULL, 0, dst, sizeof(dst));
+        TEST_ASSERT_NOT_NULL(netif);
+        if (i > 0) {
+            gnrc_netif_hdr_t *hdr = netif->data;
+
+            hdr->flags |= GNRC_NETIF_HDR_FLAGS_CSUM_OFFLOAD;
+        }
+        LL_PREPEND(pkt, netif);
+        TEST_ASSERT(ethernet_netif->ops->send(ethernet_netif, pkt) > 0);
+        /* only the marked packet is offloaded to the device */
+        TEST_ASSERT_EQUAL_INT(i, ethernet_tx_csum_offloads);
+    }
+}
+
 static void test_netapi_set__ADDRESS(void)
 {
     static const uint8_t exp_ethernet[] = ETHERNET_SRC;
@@ -1531,6 +1592,8 @@ static Test *embunit_tests_gnrc_netif(void)
         new_TestFixture(test_netapi_set__IPV6_GROUP_LEAVE),
         new_TestFixture(test_netapi_set__MAX_PACKET_SIZE),
         new_TestFixture(test_netapi_set__6LO_IPHC),
+        new_TestFixture(test_netapi_set__CSUM_OFFLOAD),
+        new_TestFixture(test_send__ethernet_csum_offload),
         new_TestFixture(test_netapi_set__ADDRESS),
         new_TestFixture(test_netapi_set__ADDRESS_LONG),
         new_TestFixture(test_netapi_set__SRC_LEN),
@@ -1565,6 +1628,13 @@ int main(void)
                            _get_netdev_src_len);
     netdev_test_set_set_cb((netdev_test_t *)ieee802154_dev, NETOPT_SRC_LEN,
                            _set_netdev_src_len);
+    netdev_test_set_get_cb((netdev_test_t *)ethernet_dev, NETOPT_CSUM_OFFLOAD,
+                           _get_netdev_csum_offload);
+    netdev_test_set_set_cb((netdev_test_t *)ethernet_dev, NETOPT_CSUM_OFFLOAD,
+                           _set_netdev_csum_offload);
+    netdev_test_set_set_cb((netdev_test_t *)ethernet_dev,
+                           NETOPT_TX_CSUM_OFFLOAD,
+                           _set_netdev_tx_csum_offload);
     TESTS_START();
     TESTS_RUN(embunit_tests_gnrc_netif());
     TESTS_END();
@@ -1607,6 +1677,7 @@ static uint8_t ethernet_l2addr[] = ETHERNET_SRC;
 static uint8_t ieee802154_l2addr_long[] = IEEE802154_LONG_SRC;
 static uint8_t ieee802154_l2addr_short[] = IEEE802154_SHORT_SRC;
 static uint16_t ieee802154_l2addr_len = 8U;
+static netopt_enable_t ethernet_csum_offload = NETOPT_DISABLE;
 
 static int _get_netdev_address(netdev_t *dev, void *value, size_t max_len)
 {
@@ -1688,3 +1759,44 @@ static int _set_netdev_src_len(netdev_t *dev, const void *value,
     }
     return -ENOTSUP;
 }
+
+static int _get_netdev_csum_offload(netdev_t *dev, void *value,
+                                    size_t max_len)
+{
+    (void)max_len;
+
+    if (dev == ethernet_dev) {
+        assert(max_len == sizeof(netopt_enable_t));
+        *((netopt_enable_t *)value) = ethernet_csum_offload;
+        return sizeof(netopt_enable_t);
+    }
+    return -ENOTSUP;
+}
+
+static int _set_netdev_csum_offload(netdev_t *dev, const void *value,
+                                    size_t value_len)
+{
+    (void)value_len;
+
+    if (dev == ethernet_dev) {
+        assert(value_len == sizeof(netopt_enable_t));
+        ethernet_csum_offload = *((netopt_enable_t *)value);
+        return sizeof(netopt_enable_t);
+    }
+    return -ENOTSUP;
+}
+
+static int _set_netdev_tx_csum_offload(netdev_t *dev, const void *value,
+                                       size_t value_len)
+{
+    (void)value_len;
+
+    if (dev == ethernet_dev) {
+        assert(value_len == sizeof(netopt_enable_t));
+        if (*((netopt_enable_t *)value) == NETOPT_ENABLE) {
+            ethernet_tx_csum_offloads++;
+        }
+        return sizeof(netopt_enable_t);
+    }
+    return -ENOTSUP;
+}
@@ -0,0 +1,381 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests the asynchronous software CSMA/CA of csma_sender and
+ *              gnrc_netif_ieee802154
+ *
+ * @author      Martine Lenders <m.lenders@fu-berlin.de>
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <limits.h>
+#include <string.h>
+
+#include "embUnit.h"
+#include "net/csma_sender.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/netif/ieee802154.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/sixlowpan.h"
+#include "net/ieee802154.h"
+#include "net/netdev_test.h"
+#include "net/sixlowpan.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define TEST_MSG_QUEUE_SIZE     (4U)
+#define TEST_MAX_BACKOFFS       (2U)
+#define TEST_PAYLOAD            "ABCDEFG"
+#define TEST_DATAGRAM_SIZE      (1280U)
+#define TEST_WAIT_STEP          (10U * US_PER_MS)
+#define TEST_WAIT_STEPS         (100U)
+
+static const uint8_t _loc_l2[] = { 0xce, 0xab, 0xfe, 0xad,
+                                   0xf7, 0x26, 0xef, 0xa4 };
+static const uint8_t _rem_l2[] = { 0xce, 0xab, 0xfe, 0xad,
+                                   0xf7, 0x26, 0xef, 0xa5 };
+static const csma_sender_conf_t _conf = {
+    .min_be = CSMA_SENDER_MIN_BE_DEFAULT,
+    .max_be = CSMA_SENDER_MAX_BE_DEFAULT,
+    .max_backoffs = TEST_MAX_BACKOFFS,
+    .backoff_period = CSMA_SENDER_BACKOFF_PERIOD_UNIT,
+};
+
+static msg_t _msg_queue[TEST_MSG_QUEUE_SIZE];
+static netdev_test_t _dev;
+static netdev_test_t _mock_netdev;
+static gnrc_netif_t *_mock_netif;
+static char _mock_netif_stack[THREAD_STACKSIZE_DEFAULT];
+static csma_sender_t _csma;
+static uint8_t _frame[] = TEST_PAYLOAD;
+static iolist_t _iolist = { .iol_base = _frame, .iol_len = sizeof(_frame) };
+
+/* number of CCAs that still report a busy medium */
+static unsigned _busy_ccas;
+static unsigned _ccas;
+static unsigned _sent;
+static unsigned _medium_busy_events;
+/* number of datagram bytes received in 6LoWPAN fragments */
+static size_t _frag_bytes;
+static bool _count_frag_bytes;
+static uint8_t _frame_buf[IEEE802154_FRAME_LEN_MAX];
+static uint16_t _max_frag_size;
+
+static void _set_up(void)
+{
+    memset(&_csma, 0, sizeof(_csma));
+    _busy_ccas = 0;
+    _ccas = 0;
+    _sent = 0;
+    _medium_busy_events = 0;
+    _frag_bytes = 0;
+    _count_frag_bytes = false;
+}
+
+/* waits for the next backoff timeout of the asynchronous CSMA/CA */
+static void _wait_backoff(const csma_sender_t *csma)
+{
+    msg_t msg;
+
+    msg_receive(&msg);
+    TEST_ASSERT_EQUAL_INT(CSMA_SENDER_MSG_TYPE_BACKOFF, msg.type);
+    TEST_ASSERT(msg.content.ptr == csma);
+}
+
+static void test_csma_async__busy_then_send(void)
+{
+    _busy_ccas = TEST_MAX_BACKOFFS;
+    TEST_ASSERT_EQUAL_INT(0, csma_sender_csma_ca_send_async(
+                                &_csma, &_dev.netdev.netdev, &_iolist, &_conf
+                            ));
+    /* no CCA before the first backoff period */
+    TEST_ASSERT_EQUAL_INT(0, _ccas);
+    for (unsigned i = 0; i < TEST_MAX_BACKOFFS; i++) {
+        _wait_backoff(&_csma);
+        TEST_ASSERT_EQUAL_INT(0, csma_sender_backoff_expired(&_csma));
+        TEST_ASSERT_EQUAL_INT(0, _sent);
+    }
+    _wait_backoff(&_csma);
+    TEST_ASSERT_EQUAL_INT(sizeof(_frame), csma_sender_backoff_expired(&_csma));
+    TEST_ASSERT_EQUAL_INT(TEST_MAX_BACKOFFS + 1, _ccas);
+    TEST_ASSERT_EQUAL_INT(1, _sent);
+    TEST_ASSERT_EQUAL_INT(0, _medium_busy_events);
+    TEST_ASSERT_NULL(_csma.iolist);
+}
+
+static void test_csma_async__EALREADY(void)
+{
+    _busy_ccas = 0;
+    TEST_ASSERT_EQUAL_INT(0, csma_sender_csma_ca_send_async(
+                                &_csma, &_dev.netdev.netdev, &_iolist, &_conf
+                            ));
+    TEST_ASSERT_EQUAL_INT(-EALREADY, csma_sender_csma_ca_send_async(
+                                &_csma, &_dev.netdev.netdev, &_iolist, &_conf
+                            ));
+    _wait_backoff(&_csma);
+    TEST_ASSERT_EQUAL_INT(sizeof(_frame), csma_sender_backoff_expired(&_csma));
+    TEST_ASSERT_EQUAL_INT(1, _sent);
+}
+
+static void test_csma_async__medium_busy(void)
+{
+    _busy_ccas = UINT_MAX;
+    TEST_ASSERT_EQUAL_INT(0, csma_sender_csma_ca_send_async(
+                                &_csma, &_dev.netdev.netdev, &_iolist, &_conf
+                            ));
+    for (unsigned i = 0; i < TEST_MAX_BACKOFFS; i++) {
+        _wait_backoff(&_csma);
+        TEST_ASSERT_EQUAL_INT(0, csma_sender_backoff_expired(&_csma));
+        TEST_ASSERT_EQUAL_INT(0, _medium_busy_events);
+    }
+    _wait_backoff(&_csma);
+    TEST_ASSERT_EQUAL_INT(-EBUSY, csma_sender_backoff_expired(&_csma));
+    TEST_ASSERT_EQUAL_INT(TEST_MAX_BACKOFFS + 1, _ccas);
+    TEST_ASSERT_EQUAL_INT(0, _sent);
+    /* signaled like by a device with hardware-assisted CSMA/CA */
+    TEST_ASSERT_EQUAL_INT(1, _medium_busy_events);
+    TEST_ASSERT_NULL(_csma.iolist);
+}
+
+static gnrc_pktsnip_t *_build_pkt(void)
+{
+    gnrc_pktsnip_t *netif, *pkt;
+
+    pkt = gnrc_pktbuf_add(NULL, TEST_PAYLOAD, sizeof(TEST_PAYLOAD),
+                          GNRC_NETTYPE_UNDEF);
+    if (pkt == NULL) {
+        return NULL;
+    }
+    netif = gnrc_netif_hdr_build(NULL, 0, _rem_l2, sizeof(_rem_l2));
+    if (netif == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    netif->next = pkt;
+    return netif;
+}
+
+static void test_netif_csma_async__ENOBUFS(void)
+{
+    gnrc_pktsnip_t *pkt;
+    msg_t msg;
+
+    /* The frames are sent from this thread instead of the interface's, so
+     * the backoff timeouts come here, too, and the interface's state only
+     * changes in between the calls below */
+    _busy_ccas = 1;
+    TEST_ASSERT_NOT_NULL((pkt = _build_pkt()));
+    TEST_ASSERT_EQUAL_INT(0, _mock_netif->ops->send(_mock_netif, pkt));
+    TEST_ASSERT(_mock_netif->mac.csma_pkt == pkt);
+    /* queue frames while the first one is backing off ... */
+    for (unsigned i = 0; i < GNRC_NETIF_CSMA_ASYNC_QUEUE_SIZE; i++) {
+        TEST_ASSERT_NOT_NULL((pkt = _build_pkt()));
+        TEST_ASSERT_EQUAL_INT(0, _mock_netif->ops->send(_mock_netif, pkt));
+    }
+    /* ... until the queue is full */
+    TEST_ASSERT_NOT_NULL((pkt = _build_pkt()));
+    TEST_ASSERT_EQUAL_INT(-ENOBUFS, _mock_netif->ops->send(_mock_netif, pkt));
+    TEST_ASSERT_EQUAL_INT(0, _sent);
+    /* the busy medium delays the first frame by another backoff period,
+     * then each frame is sent after its own */
+    while (_sent < (GNRC_NETIF_CSMA_ASYNC_QUEUE_SIZE + 1)) {
+        msg_receive(&msg);
+        TEST_ASSERT_EQUAL_INT(CSMA_SENDER_MSG_TYPE_BACKOFF, msg.type);
+        _mock_netif->ops->msg_handler(_mock_netif, &msg);
+    }
+    TEST_ASSERT_EQUAL_INT(GNRC_NETIF_CSMA_ASYNC_QUEUE_SIZE + 2, _ccas);
+    TEST_ASSERT_NULL(_mock_netif->mac.csma_pkt);
+    TEST_ASSERT_NULL(gnrc_priority_pktqueue_head(&_mock_netif->mac.csma_queue));
+    TEST_ASSERT_MESSAGE(gnrc_pktbuf_is_empty(), "Packet buffer is not empty");
+}
+
+static void test_netif_csma_async__fragmented(void)
+{
+    static uint8_t datagram[TEST_DATAGRAM_SIZE];
+    gnrc_pktsnip_t *netif, *pkt;
+    unsigned steps = 0;
+
+    /* The fragments are sent to the interface back-to-back, while it backs
+     * off for the first one */
+    _count_frag_bytes = true;
+    memset(datagram, 0x5a, sizeof(datagram));
+    TEST_ASSERT_NOT_NULL((pkt = gnrc_pktbuf_add(NULL, datagram, sizeof(datagram),
+                                                GNRC_NETTYPE_UNDEF)));
+    TEST_ASSERT_NOT_NULL((netif = gnrc_netif_hdr_build(NULL, 0, _rem_l2,
+                                                       sizeof(_rem_l2))));
+    ((gnrc_netif_hdr_t *)netif->data)->if_pid = _mock_netif->pid;
+    netif->next = pkt;
+    TEST_ASSERT(gnrc_netapi_send(gnrc_sixlowpan_get_pid(), netif) > 0);
+    while (((_frag_bytes < TEST_DATAGRAM_SIZE) || !gnrc_pktbuf_is_empty()) &&
+           (steps++ < TEST_WAIT_STEPS)) {
+        xtimer_usleep(TEST_WAIT_STEP);
+    }
+    /* no fragment was dropped */
+    TEST_ASSERT_EQUAL_INT(TEST_DATAGRAM_SIZE, _frag_bytes);
+    TEST_ASSERT_NULL(_mock_netif->mac.csma_pkt);
+    TEST_ASSERT_MESSAGE(gnrc_pktbuf_is_empty(), "Packet buffer is not empty");
+}
+
+static void run_unittests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_csma_async__busy_then_send),
+        new_TestFixture(test_csma_async__EALREADY),
+        new_TestFixture(test_csma_async__medium_busy),
+        new_TestFixture(test_netif_csma_async__ENOBUFS),
+        new_TestFixture(test_netif_csma_async__fragmented),
+    };
+
+    EMB_UNIT_TESTCALLER(csma_async_tests, _set_up, NULL, fixtures);
+    TESTS_START();
+    TESTS_RUN((Test *)&csma_async_tests);
+    TESTS_END();
+}
+
+/* adds the datagram bytes carried in a 6LoWPAN fragment to _frag_bytes */
+static void _count_frag(const iolist_t *iolist)
+{
+    size_t len = 0, mhr_len;
+    sixlowpan_frag_t *frag;
+
+    for (; iolist != NULL; iolist = iolist->iol_next) {
+        assert((len + iolist->iol_len) <= sizeof(_frame_buf));
+        memcpy(&_frame_buf[len], iolist->iol_base, iolist->iol_len);
+        len += iolist->iol_len;
+    }
+    mhr_len = ieee802154_get_frame_hdr_len(_frame_buf);
+    assert((mhr_len > 0) && (mhr_len < len));
+    frag = (sixlowpan_frag_t *)&_frame_buf[mhr_len];
+    if ((frag->disp_size.u8[0] & SIXLOWPAN_FRAG_DISP_MASK) ==
+        SIXLOWPAN_FRAG_1_DISP) {
+        /* followed by the uncompressed IPv6 dispatch */
+        _frag_bytes += len - mhr_len - sizeof(sixlowpan_frag_t) - 1;
+    }
+    else if ((frag->disp_size.u8[0] & SIXLOWPAN_FRAG_DISP_MASK) ==
+             SIXLOWPAN_FRAG_N_DISP) {
+        _frag_bytes += len - mhr_len - sizeof(sixlowpan_frag_n_t);
+    }
+}
+
+static int _mock_send(netdev_t *dev, const iolist_t *iolist)
+{
+    (void)dev;
+    if (_count_frag_bytes) {
+        _count_frag(iolist);
+    }
+    _sent++;
+    return iolist_size(iolist);
+}
+
+static int _mock_get_channel_clear(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    assert(max_len == sizeof(netopt_enable_t));
+    _ccas++;
+    if (_busy_ccas > 0) {
+        _busy_ccas--;
+        *((netopt_enable_t *)value) = NETOPT_DISABLE;
+    }
+    else {
+        *((netopt_enable_t *)value) = NETOPT_ENABLE;
+    }
+    return sizeof(netopt_enable_t);
+}
+
+static void _mock_event_cb(netdev_t *dev, netdev_event_t event)
+{
+    (void)dev;
+    if (event == NETDEV_EVENT_TX_MEDIUM_BUSY) {
+        _medium_busy_events++;
+    }
+}
+
+static int _mock_get_device_type(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    assert(max_len == sizeof(uint16_t));
+    *((uint16_t *)value) = NETDEV_TYPE_IEEE802154;
+    return sizeof(uint16_t);
+}
+
+static int _mock_get_max_packet_size(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    assert(max_len == sizeof(uint16_t));
+    *((uint16_t *)value) = IEEE802154_FRAME_LEN_MAX - IEEE802154_MAX_HDR_LEN -
+                           IEEE802154_FCS_LEN;
+    return sizeof(uint16_t);
+}
+
+static int _mock_get_src_len(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    assert(max_len == sizeof(uint16_t));
+    *((uint16_t *)value) = IEEE802154_LONG_ADDRESS_LEN;
+    return sizeof(uint16_t);
+}
+
+static int _mock_get_address_long(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    assert(max_len >= sizeof(_loc_l2));
+    memcpy(value, _loc_l2, sizeof(_loc_l2));
+    return sizeof(_loc_l2);
+}
+
+static void _mock_init(netdev_test_t *dev)
+{
+    netdev_test_setup(dev, 0);
+    netdev_test_set_send_cb(dev, _mock_send);
+    netdev_test_set_get_cb(dev, NETOPT_IS_CHANNEL_CLR,
+                           _mock_get_channel_clear);
+    netdev_test_set_get_cb(dev, NETOPT_DEVICE_TYPE, _mock_get_device_type);
+    netdev_test_set_get_cb(dev, NETOPT_MAX_PDU_SIZE,
+                           _mock_get_max_packet_size);
+    netdev_test_set_get_cb(dev, NETOPT_SRC_LEN, _mock_get_src_len);
+    netdev_test_set_get_cb(dev, NETOPT_ADDRESS_LONG, _mock_get_address_long);
+}
+
+int main(void)
+{
+    /* no auto-init, so xtimer and the packet buffer need to be initialized
+     * manually */
+    xtimer_init();
+    gnrc_pktbuf_init();
+    /* backoff timeouts are sent to this thread */
+    msg_init_queue(_msg_queue, TEST_MSG_QUEUE_SIZE);
+    /* device for csma_sender on its own */
+    _mock_init(&_dev);
+    _dev.netdev.netdev.event_callback = _mock_event_cb;
+    /* device for gnrc_netif_ieee802154 */
+    _mock_init(&_mock_netdev);
+    _mock_netif = gnrc_netif_ieee802154_create(
+            _mock_netif_stack, THREAD_STACKSIZE_DEFAULT, GNRC_NETIF_PRIO,
+            "mockup_wpan", &_mock_netdev.netdev.netdev
+        );
+    assert(_mock_netif != NULL);
+    /* no IPv6 to set the fragment size from the device's */
+    _max_frag_size = IEEE802154_FRAME_LEN_MAX - IEEE802154_MAX_HDR_LEN -
+                     IEEE802154_FCS_LEN;
+    gnrc_netapi_set(_mock_netif->pid, NETOPT_MAX_PDU_SIZE,
+                    GNRC_NETTYPE_SIXLOWPAN, &_max_frag_size,
+                    sizeof(_max_frag_size));
+    gnrc_sixlowpan_init();
+    run_unittests();
+    return 0;
+}
@@ -33,7 +33,8 @@
 #define TEST_TAG                (0x690e)
 #define TEST_PAGE               (0)
 #define TEST_RECEIVE_TIMEOUT    (100U)
-#define TEST_GC_TIMEOUT         (RBUF_TIMEOUT + TEST_RECEIVE_TIMEOUT)
+#define TEST_GC_TIMEOUT         (RBUF_TIMEOUT + RBUF_WHEEL_TICK + \
+                                 TEST_RECEIVE_TIMEOUT)
 
 /* test date taken from an experimental run (uncompressed ICMPv6 echo reply with
  * 300 byte payload)*/
@@ -183,7 +184,11 @@ static inline void _set_fragment_offset(void *frag, uint16_t offset)
 
 static void _set_up(void)
 {
+    msg_t msg;
+
     rbuf_reset();
+    /* drop garbage collection messages of previous tests */
+    while (msg_try_receive(&msg) > 0) {}
     gnrc_pktbuf_init();
     gnrc_netif_hdr_init(&_test_netif_hdr.hdr,
                         GNRC_NETIF_HDR_L2ADDR_MAX_LEN,
@@ -235,10 +240,14 @@ static void _test_entry(const gnrc_sixlowpan_rbuf_t *entry,
                         "entry->super.dst != TEST_NETIF_HDR_DST");
     TEST_ASSERT_EQUAL_INT(TEST_TAG, entry->super.tag);
     TEST_ASSERT_EQUAL_INT(exp_current_size, entry->super.current_size);
-    TEST_ASSERT_NOT_NULL(entry->super.ints);
-    TEST_ASSERT_NULL(entry->super.ints->next);
-    TEST_ASSERT_EQUAL_INT(exp_int_start, entry->super.ints->start);
-    TEST_ASSERT_EQUAL_INT(exp_int_end, entry->super.ints->end);
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_FRAG_RBUF_UNITS; i++) {
+        bool exp_received = ((exp_int_start / 8U) <= i) &&
+                            (i <= (exp_int_end / 8U));
+
+        TEST_ASSERT_MESSAGE(exp_received ==
+                            bf_isset((uint8_t *)entry->received, i),
+                            "Unexpected received bitmap");
+    }
 }
 
 static void _check_pktbuf(const gnrc_sixlowpan_rbuf_t *entry)
@@ -511,11 +520,10 @@ static void test_rbuf_gc__manually(void)
 
     TEST_ASSERT_NOT_NULL(pkt);
     rbuf_add(&_test_netif_hdr.hdr, pkt, TEST_FRAGMENT1_OFFSET, TEST_PAGE);
-    /* discarding const qualifier intentionally to override `arrival` */
     entry = (gnrc_sixlowpan_rbuf_t *)_first_non_empty_rbuf();
     TEST_ASSERT_NOT_NULL(entry);
-    /* set arrival RBUF_TIMEOUT into the past */
-    entry->super.arrival -= RBUF_TIMEOUT;
+    /* wait until the entry timed out, then advance the timer wheel */
+    xtimer_usleep(RBUF_TIMEOUT);
     rbuf_gc();
     /* reassembly buffer is now empty */
     TEST_ASSERT_NULL(_first_non_empty_rbuf());
@@ -527,21 +535,26 @@ static void test_rbuf_gc__timed(void)
     msg_t msg;
     gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, _fragment1, sizeof(_fragment1),
                                           GNRC_NETTYPE_SIXLOWPAN);
-    gnrc_sixlowpan_rbuf_t *entry;
+    uint32_t start;
 
     TEST_ASSERT_NOT_NULL(pkt);
     rbuf_add(&_test_netif_hdr.hdr, pkt, TEST_FRAGMENT1_OFFSET, TEST_PAGE);
-    /* discarding const qualifier intentionally to override `arrival` */
-    entry = (gnrc_sixlowpan_rbuf_t *)_first_non_empty_rbuf();
-    TEST_ASSERT_NOT_NULL(entry);
-    TEST_ASSERT_MESSAGE(
-            xtimer_msg_receive_timeout(&msg, TEST_GC_TIMEOUT) >= 0,
-            "Waiting for GC timer timed out"
-        );
-    TEST_ASSERT_EQUAL_INT(GNRC_SIXLOWPAN_MSG_FRAG_GC_RBUF, msg.type);
-    rbuf_gc();
-    /* reassembly buffer is now empty */
-    TEST_ASSERT_NULL(_first_non_empty_rbuf());
+    TEST_ASSERT_NOT_NULL(_first_non_empty_rbuf());
+    start = xtimer_now_usec();
+    /* the garbage collection timer ticks until the entry timed out */
+    while (_first_non_empty_rbuf() != NULL) {
+        TEST_ASSERT_MESSAGE(
+                xtimer_msg_receive_timeout(&msg, TEST_GC_TIMEOUT) >= 0,
+                "Waiting for GC timer timed out"
+            );
+        TEST_ASSERT_EQUAL_INT(GNRC_SIXLOWPAN_MSG_FRAG_GC_RBUF, msg.type);
+        rbuf_gc();
+        TEST_ASSERT_MESSAGE((xtimer_now_usec() - start) <= TEST_GC_TIMEOUT,
+                            "Entry was not garbage collected in time");
+    }
+    TEST_ASSERT_MESSAGE((xtimer_now_usec() - start) >=
+                        (RBUF_TIMEOUT - RBUF_WHEEL_TICK),
+                        "Entry was garbage collected too early");
     _check_pktbuf(NULL);
 }
 
@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests 6LoWPAN Selective Fragment Recovery over lossy links
+ *
+ * Two socket_zep interfaces are connected to each other. A datagram is sent
+ * from the first to the second interface while both drop frames according to
+ * a deterministic loss model. As long as the second interface is not known to
+ * support SFR, the datagram is fragmented according to RFC 4944 instead.
+ *
+ * @author      Martine Lenders <m.lenders@fu-berlin.de>
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "msg.h"
+#include "net/gnrc.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/sixlowpan.h"
+#include "net/gnrc/sixlowpan/config.h"
+#include "net/gnrc/sixlowpan/frag/sfr.h"
+#include "socket_zep.h"
+#include "xtimer.h"
+
+#define TEST_PAYLOAD_SIZE   (1000U)
+#define TEST_MAX_FRAG_SIZE  (64U)
+#define TEST_TIMEOUT        (5U * US_PER_SEC)
+#define TEST_MSG_QUEUE_SIZE (4U)
+
+typedef struct {
+    unsigned every;     /* lose every n-th frame, 0 for no loss */
+    unsigned frames;    /* number of frames sent */
+    unsigned lost;      /* number of frames lost */
+} _loss_t;
+
+typedef struct {
+    const char *name;
+    unsigned sender_loss;
+    unsigned receiver_loss;
+    bool sfr;           /* receiver is known to support SFR */
+} _scenario_t;
+
+static const _scenario_t _scenarios[] = {
+    { .name = "receiver not known to support SFR", .sender_loss = 0,
+      .receiver_loss = 0, .sfr = false },
+    { .name = "no loss", .sender_loss = 0, .receiver_loss = 0, .sfr = true },
+    { .name = "sender loses every 4th frame", .sender_loss = 4,
+      .receiver_loss = 0, .sfr = true },
+    { .name = "sender loses every 3rd frame, receiver every 2nd frame",
+      .sender_loss = 3, .receiver_loss = 2, .sfr = true },
+};
+
+static msg_t _msg_queue[TEST_MSG_QUEUE_SIZE];
+static uint8_t _payload[TEST_PAYLOAD_SIZE];
+static _loss_t _losses[2];
+static gnrc_netif_t *_netifs[2];
+
+static bool _loss_cb(const iolist_t *iolist, void *arg)
+{
+    _loss_t *loss = arg;
+
+    (void)iolist;
+    loss->frames++;
+    if ((loss->every > 0) && ((loss->frames % loss->every) == 0)) {
+        loss->lost++;
+        return true;
+    }
+    return false;
+}
+
+static bool _run(const _scenario_t *scenario)
+{
+    uint8_t dst[IEEE802154_LONG_ADDRESS_LEN];
+    gnrc_pktsnip_t *pkt, *netif;
+    msg_t msg;
+    int res;
+
+    printf("Scenario: %s\n", scenario->name);
+    _losses[0] = (_loss_t){ .every = scenario->sender_loss };
+    _losses[1] = (_loss_t){ .every = scenario->receiver_loss };
+    res = gnrc_netapi_get(_netifs[1]->pid, NETOPT_ADDRESS_LONG, 0,
+                          dst, sizeof(dst));
+    if (res < 0) {
+        puts("Unable to get address of receiving interface");
+        return false;
+    }
+    if (scenario->sfr) {
+        gnrc_sixlowpan_frag_sfr_peer_add(_netifs[0], dst, res);
+    }
+    pkt = gnrc_pktbuf_add(NULL, _payload, sizeof(_payload), GNRC_NETTYPE_UNDEF);
+    netif = gnrc_netif_hdr_build(NULL, 0, dst, res);
+    if ((pkt == NULL) || (netif == NULL)) {
+        puts("Unable to allocate packet");
+        return false;
+    }
+    ((gnrc_netif_hdr_t *)netif->data)->if_pid = _netifs[0]->pid;
+    LL_PREPEND(pkt, netif);
+    if (gnrc_netapi_send(gnrc_sixlowpan_get_pid(), pkt) < 1) {
+        puts("Unable to send packet");
+        gnrc_pktbuf_release(pkt);
+        return false;
+    }
+    while (xtimer_msg_receive_timeout(&msg, TEST_TIMEOUT) >= 0) {
+        if (msg.type == GNRC_NETAPI_MSG_TYPE_RCV) {
+            gnrc_pktsnip_t *rcv = msg.content.ptr;
+            unsigned size = rcv->size;
+            bool ok = (size == sizeof(_payload)) &&
+                      (memcmp(rcv->data, _payload, sizeof(_payload)) == 0);
+
+            gnrc_pktbuf_release(rcv);
+            printf("Received %u bytes: %s\n", size,
+                   ok ? "content OK" : "content MISMATCH");
+            printf("Frames sent (lost): sender %u (%u), receiver %u (%u)\n",
+                   _losses[0].frames, _losses[0].lost,
+                   _losses[1].frames, _losses[1].lost);
+            /* only SFR makes the receiver send RFRAG-ACKs */
+            if ((_losses[1].frames > 0) != scenario->sfr) {
+                printf("Unexpected fragmentation: %s\n",
+                       scenario->sfr ? "RFC 4944" : "SFR");
+                ok = false;
+            }
+            /* let the final RFRAG-ACK (or its retransmissions) settle */
+            xtimer_usleep(GNRC_SIXLOWPAN_FRAG_SFR_ARQ_TIMEOUT_US *
+                          (GNRC_SIXLOWPAN_FRAG_SFR_FRAG_RETRIES + 1));
+            return ok;
+        }
+    }
+    puts("Timeout: datagram not received");
+    return false;
+}
+
+int main(void)
+{
+    gnrc_netreg_entry_t reg = GNRC_NETREG_ENTRY_INIT_PID(
+            GNRC_NETREG_DEMUX_CTX_ALL, sched_active_pid
+        );
+    uint16_t max_frag_size = TEST_MAX_FRAG_SIZE;
+    unsigned failed = 0;
+
+    msg_init_queue(_msg_queue, TEST_MSG_QUEUE_SIZE);
+    for (unsigned i = 0; i < TEST_PAYLOAD_SIZE; i++) {
+        _payload[i] = (uint8_t)(i * 7);
+    }
+    _netifs[0] = gnrc_netif_iter(NULL);
+    _netifs[1] = gnrc_netif_iter(_netifs[0]);
+    if ((_netifs[0] == NULL) || (_netifs[1] == NULL)) {
+        puts("Two interfaces required");
+        return 1;
+    }
+    for (unsigned i = 0; i < 2; i++) {
+        gnrc_netapi_set(_netifs[i]->pid, NETOPT_MAX_PDU_SIZE,
+                        GNRC_NETTYPE_SIXLOWPAN, &max_frag_size,
+                        sizeof(max_frag_size));
+        socket_zep_set_loss_cb((socket_zep_t *)_netifs[i]->dev, _loss_cb,
+                               &_losses[i]);
+    }
+    gnrc_netreg_register(GNRC_NETTYPE_UNDEF, &reg);
+    for (unsigned i = 0; i < (sizeof(_scenarios) / sizeof(_scenarios[0])); i++) {
+        if (!_run(&_scenarios[i])) {
+            failed++;
+        }
+    }
+    if (failed) {
+        printf("%u scenarios FAILED\n", failed);
+    }
+    else {
+        puts("ALL TESTS SUCCESSFUL");
+    }
+    return 0;
+}
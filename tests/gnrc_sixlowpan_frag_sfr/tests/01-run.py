@@ -0,0 +1,26 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2019 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+SCENARIOS = 4
+
+
+def testfunc(child):
+    for _ in range(SCENARIOS):
+        child.expect(r"Scenario: .+\r?\n")
+        child.expect_exact("Received 1000 bytes: content OK")
+        child.expect(r"Frames sent \(lost\): sender \d+ \(\d+\), "
+                     r"receiver \d+ \(\d+\)")
+    child.expect_exact("ALL TESTS SUCCESSFUL")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=30))
@@ -0,0 +1,556 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests the virtual reassembly buffer of 6LoWPAN fragmentation
+ *
+ * @author      Martine Lenders <m.lenders@fu-berlin.de>
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <string.h>
+
+#include "embUnit.h"
+#include "net/gnrc/ipv6/nib.h"
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/netif/ieee802154.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/sixlowpan/frag.h"
+#include "net/gnrc/sixlowpan/frag/sfr.h"
+#include "net/gnrc/sixlowpan/frag/vrb.h"
+#include "net/ieee802154.h"
+#include "net/ipv6/hdr.h"
+#include "net/netdev_test.h"
+#include "net/protnum.h"
+#include "net/sixlowpan.h"
+#include "net/sixlowpan/sfr.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define TEST_SRC                { 0xb3, 0x47, 0x60, 0x49, \
+                                  0x78, 0xfe, 0x95, 0x48 }
+#define TEST_DST                { 0xa4, 0xf2, 0xd2, 0xc9, \
+                                  0x54, 0x54, 0x54, 0x54 }
+#define TEST_OUT_DST            { 0x5a, 0x3d, 0xe6, 0x0b, \
+                                  0x1e, 0xbb, 0xc4, 0x0f }
+#define TEST_TAG                (0x690e)
+#define TEST_DATAGRAM_SIZE      (348U)
+#define TEST_FRAGMENT_OFFSET    (96U)
+#define TEST_FRAGMENT_SIZE      (96U)
+#define TEST_RECEIVE_TIMEOUT    (100U)
+/* global destination of the forwarded datagram: 2001:db8::1 */
+#define TEST_FWD_DST            { { 0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x00, \
+                                    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01 } }
+/* global source of the forwarded datagram: 2001:db8::2 */
+#define TEST_FWD_SRC            { { 0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x00, \
+                                    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02 } }
+#define TEST_FWD_HL             (65U)
+#define TEST_FWD_PAYLOAD_SIZE   (32U)
+#define TEST_FWD_DATAGRAM_SIZE  (sizeof(ipv6_hdr_t) + 3 * TEST_FWD_PAYLOAD_SIZE)
+#define TEST_MSG_TYPE_SENT      (0x8e1f)
+
+static const uint8_t _test_src[] = TEST_SRC;
+static const uint8_t _test_dst[] = TEST_DST;
+static const uint8_t _test_out_dst[] = TEST_OUT_DST;
+static gnrc_sixlowpan_rbuf_base_t _test_base;
+static gnrc_netif_t _test_out_netif;
+static msg_t _msg_queue[2];
+
+static netdev_test_t _mock_netdev;
+static gnrc_netif_t *_mock_netif;
+static char _mock_netif_stack[THREAD_STACKSIZE_DEFAULT];
+static kernel_pid_t _main_pid;
+static uint8_t _mock_frame[IEEE802154_FRAME_LEN_MAX];
+static size_t _mock_frame_len;
+
+static void _set_up(void)
+{
+    gnrc_sixlowpan_frag_vrb_reset();
+    gnrc_pktbuf_init();
+    memset(&_test_base, 0, sizeof(_test_base));
+    memcpy(_test_base.src, _test_src, sizeof(_test_src));
+    memcpy(_test_base.dst, _test_dst, sizeof(_test_dst));
+    _test_base.src_len = sizeof(_test_src);
+    _test_base.dst_len = sizeof(_test_dst);
+    _test_base.tag = TEST_TAG;
+    _test_base.datagram_size = TEST_DATAGRAM_SIZE;
+    /* fragments "sent" over the interface are received by this thread */
+    _test_out_netif.pid = thread_getpid();
+}
+
+static gnrc_sixlowpan_frag_vrb_t *_add_entry(void)
+{
+    return gnrc_sixlowpan_frag_vrb_add(&_test_base, &_test_out_netif,
+                                       _test_out_dst, sizeof(_test_out_dst));
+}
+
+static gnrc_sixlowpan_frag_vrb_t *_get_entry(void)
+{
+    return gnrc_sixlowpan_frag_vrb_get(_test_src, sizeof(_test_src),
+                                       _test_dst, sizeof(_test_dst),
+                                       TEST_DATAGRAM_SIZE, TEST_TAG);
+}
+
+static gnrc_pktsnip_t *_build_fragment(size_t frag_size)
+{
+    gnrc_pktsnip_t *netif, *pkt;
+    sixlowpan_frag_n_t *frag;
+
+    netif = gnrc_netif_hdr_build(_test_src, sizeof(_test_src),
+                                 _test_dst, sizeof(_test_dst));
+    if (netif == NULL) {
+        return NULL;
+    }
+    pkt = gnrc_pktbuf_add(netif, NULL, sizeof(sixlowpan_frag_n_t) + frag_size,
+                          GNRC_NETTYPE_SIXLOWPAN);
+    if (pkt == NULL) {
+        gnrc_pktbuf_release(netif);
+        return NULL;
+    }
+    frag = pkt->data;
+    frag->disp_size = byteorder_htons(TEST_DATAGRAM_SIZE);
+    frag->disp_size.u8[0] |= SIXLOWPAN_FRAG_N_DISP;
+    frag->tag = byteorder_htons(TEST_TAG);
+    frag->offset = TEST_FRAGMENT_OFFSET / 8;
+    return pkt;
+}
+
+static gnrc_pktsnip_t *_recv_forwarded(void)
+{
+    msg_t msg;
+
+    if ((xtimer_msg_receive_timeout(&msg, TEST_RECEIVE_TIMEOUT) < 0) ||
+        (msg.type != GNRC_NETAPI_MSG_TYPE_SND)) {
+        return NULL;
+    }
+    return msg.content.ptr;
+}
+
+static void _forward_fragment(gnrc_sixlowpan_frag_vrb_t *vrbe)
+{
+    gnrc_pktsnip_t *pkt = _build_fragment(TEST_FRAGMENT_SIZE);
+
+    TEST_ASSERT_NOT_NULL(pkt);
+    gnrc_sixlowpan_frag_vrb_forward(vrbe, pkt, TEST_FRAGMENT_SIZE);
+}
+
+static void test_vrb_add__success(void)
+{
+    gnrc_sixlowpan_frag_vrb_t *vrbe = _add_entry();
+
+    TEST_ASSERT_NOT_NULL(vrbe);
+    TEST_ASSERT_EQUAL_INT(sizeof(_test_src), vrbe->super.src_len);
+    TEST_ASSERT(memcmp(vrbe->super.src, _test_src, sizeof(_test_src)) == 0);
+    TEST_ASSERT_EQUAL_INT(TEST_TAG, vrbe->super.tag);
+    TEST_ASSERT_EQUAL_INT(TEST_DATAGRAM_SIZE, vrbe->super.datagram_size);
+    TEST_ASSERT_EQUAL_INT(0, vrbe->super.current_size);
+    TEST_ASSERT(&_test_out_netif == vrbe->out_netif);
+    TEST_ASSERT_EQUAL_INT(sizeof(_test_out_dst), vrbe->out_dst_len);
+    TEST_ASSERT(memcmp(vrbe->out_dst, _test_out_dst,
+                       sizeof(_test_out_dst)) == 0);
+}
+
+static void test_vrb_add__full(void)
+{
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_FRAG_VRB_SIZE; i++) {
+        _test_base.tag++;
+        TEST_ASSERT_NOT_NULL(_add_entry());
+    }
+    _test_base.tag++;
+    TEST_ASSERT_NULL(_add_entry());
+}
+
+static void test_vrb_get__success(void)
+{
+    gnrc_sixlowpan_frag_vrb_t *vrbe = _add_entry();
+
+    TEST_ASSERT_NOT_NULL(vrbe);
+    TEST_ASSERT(vrbe == _get_entry());
+}
+
+static void test_vrb_get__not_found(void)
+{
+    TEST_ASSERT_NOT_NULL(_add_entry());
+    TEST_ASSERT_NULL(gnrc_sixlowpan_frag_vrb_get(_test_src, sizeof(_test_src),
+                                                 _test_dst, sizeof(_test_dst),
+                                                 TEST_DATAGRAM_SIZE,
+                                                 TEST_TAG + 1));
+    TEST_ASSERT_NULL(gnrc_sixlowpan_frag_vrb_get(_test_dst, sizeof(_test_dst),
+                                                 _test_dst, sizeof(_test_dst),
+                                                 TEST_DATAGRAM_SIZE, TEST_TAG));
+    TEST_ASSERT_NULL(gnrc_sixlowpan_frag_vrb_get(_test_src, 2,
+                                                 _test_dst, sizeof(_test_dst),
+                                                 TEST_DATAGRAM_SIZE, TEST_TAG));
+    /* same source and tag, but a different datagram */
+    TEST_ASSERT_NULL(gnrc_sixlowpan_frag_vrb_get(_test_src, sizeof(_test_src),
+                                                 _test_src, sizeof(_test_src),
+                                                 TEST_DATAGRAM_SIZE, TEST_TAG));
+    TEST_ASSERT_NULL(gnrc_sixlowpan_frag_vrb_get(_test_src, sizeof(_test_src),
+                                                 _test_dst, 2,
+                                                 TEST_DATAGRAM_SIZE, TEST_TAG));
+    TEST_ASSERT_NULL(gnrc_sixlowpan_frag_vrb_get(_test_src, sizeof(_test_src),
+                                                 _test_dst, sizeof(_test_dst),
+                                                 TEST_DATAGRAM_SIZE + 8,
+                                                 TEST_TAG));
+}
+
+static void test_vrb_rm(void)
+{
+    gnrc_sixlowpan_frag_vrb_t *vrbe = _add_entry();
+
+    TEST_ASSERT_NOT_NULL(vrbe);
+    gnrc_sixlowpan_frag_vrb_rm(vrbe);
+    TEST_ASSERT_NULL(_get_entry());
+}
+
+static void test_vrb_gc(void)
+{
+    gnrc_sixlowpan_frag_vrb_t *vrbe = _add_entry();
+
+    TEST_ASSERT_NOT_NULL(vrbe);
+    gnrc_sixlowpan_frag_vrb_gc();
+    TEST_ASSERT(vrbe == _get_entry());
+    vrbe->super.arrival -= GNRC_SIXLOWPAN_FRAG_VRB_TIMEOUT_US + 1;
+    gnrc_sixlowpan_frag_vrb_gc();
+    TEST_ASSERT_NULL(_get_entry());
+}
+
+static void test_vrb_forward__more_data(void)
+{
+    gnrc_sixlowpan_frag_vrb_t *vrbe = _add_entry();
+    gnrc_pktsnip_t *pkt;
+    gnrc_netif_hdr_t *netif_hdr;
+    sixlowpan_frag_n_t *frag;
+
+    TEST_ASSERT_NOT_NULL(vrbe);
+    _forward_fragment(vrbe);
+    pkt = _recv_forwarded();
+    TEST_ASSERT_MESSAGE(pkt != NULL, "Forwarded fragment was not sent");
+    TEST_ASSERT_EQUAL_INT(GNRC_NETTYPE_NETIF, pkt->type);
+    netif_hdr = pkt->data;
+    TEST_ASSERT_EQUAL_INT(_test_out_netif.pid, netif_hdr->if_pid);
+    TEST_ASSERT_EQUAL_INT(0, netif_hdr->src_l2addr_len);
+    TEST_ASSERT_EQUAL_INT(sizeof(_test_out_dst), netif_hdr->dst_l2addr_len);
+    TEST_ASSERT(memcmp(gnrc_netif_hdr_get_dst_addr(netif_hdr), _test_out_dst,
+                       sizeof(_test_out_dst)) == 0);
+    TEST_ASSERT(netif_hdr->flags & GNRC_NETIF_HDR_FLAGS_MORE_DATA);
+    TEST_ASSERT_NOT_NULL(pkt->next);
+    TEST_ASSERT_NULL(pkt->next->next);
+    frag = pkt->next->data;
+    TEST_ASSERT_EQUAL_INT(vrbe->out_tag, byteorder_ntohs(frag->tag));
+    TEST_ASSERT_EQUAL_INT(TEST_FRAGMENT_OFFSET / 8, frag->offset);
+    TEST_ASSERT_EQUAL_INT(TEST_FRAGMENT_SIZE, vrbe->super.current_size);
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT_MESSAGE(gnrc_pktbuf_is_empty(), "Packet buffer is not empty");
+}
+
+static void test_vrb_forward__complete(void)
+{
+    gnrc_sixlowpan_frag_vrb_t *vrbe = _add_entry();
+    gnrc_pktsnip_t *pkt;
+
+    TEST_ASSERT_NOT_NULL(vrbe);
+    vrbe->super.current_size = TEST_DATAGRAM_SIZE - TEST_FRAGMENT_SIZE;
+    _forward_fragment(vrbe);
+    pkt = _recv_forwarded();
+    TEST_ASSERT_MESSAGE(pkt != NULL, "Forwarded fragment was not sent");
+    TEST_ASSERT(!(((gnrc_netif_hdr_t *)pkt->data)->flags &
+                  GNRC_NETIF_HDR_FLAGS_MORE_DATA));
+    /* entry is removed with the last fragment */
+    TEST_ASSERT_NULL(_get_entry());
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT_MESSAGE(gnrc_pktbuf_is_empty(), "Packet buffer is not empty");
+}
+
+/* IPHC header with all fields inline but traffic class and flow label, and
+ * the first part of the payload */
+#define TEST_FWD_1ST_FRAG_SIZE  (4 + 2 * sizeof(ipv6_addr_t) + TEST_FWD_PAYLOAD_SIZE)
+
+static void _set_1st_fragment_payload(uint8_t *iphc)
+{
+    static const ipv6_addr_t src = TEST_FWD_SRC, dst = TEST_FWD_DST;
+
+    *(iphc++) = SIXLOWPAN_IPHC1_DISP | SIXLOWPAN_IPHC1_TF;
+    *(iphc++) = 0;
+    *(iphc++) = PROTNUM_IPV6_NONXT;
+    *(iphc++) = TEST_FWD_HL;
+    memcpy(iphc, &src, sizeof(src));
+    iphc += sizeof(src);
+    memcpy(iphc, &dst, sizeof(dst));
+    iphc += sizeof(dst);
+    memset(iphc, 0xa5, TEST_FWD_PAYLOAD_SIZE);
+}
+
+static gnrc_pktsnip_t *_build_1st_fragment(size_t frag_hdr_size)
+{
+    gnrc_pktsnip_t *netif, *pkt;
+    gnrc_netif_hdr_t *netif_hdr;
+
+    netif = gnrc_netif_hdr_build(_test_src, sizeof(_test_src),
+                                 _test_dst, sizeof(_test_dst));
+    if (netif == NULL) {
+        return NULL;
+    }
+    netif_hdr = netif->data;
+    netif_hdr->if_pid = _mock_netif->pid;
+    pkt = gnrc_pktbuf_add(netif, NULL, frag_hdr_size + TEST_FWD_1ST_FRAG_SIZE,
+                          GNRC_NETTYPE_SIXLOWPAN);
+    if (pkt == NULL) {
+        gnrc_pktbuf_release(netif);
+        return NULL;
+    }
+    _set_1st_fragment_payload((uint8_t *)pkt->data + frag_hdr_size);
+    return pkt;
+}
+
+static gnrc_pktsnip_t *_build_frag1(void)
+{
+    gnrc_pktsnip_t *pkt = _build_1st_fragment(sizeof(sixlowpan_frag_t));
+    sixlowpan_frag_t *frag;
+
+    if (pkt == NULL) {
+        return NULL;
+    }
+    frag = pkt->data;
+    frag->disp_size = byteorder_htons(TEST_FWD_DATAGRAM_SIZE);
+    frag->disp_size.u8[0] |= SIXLOWPAN_FRAG_1_DISP;
+    frag->tag = byteorder_htons(TEST_TAG);
+    return pkt;
+}
+
+static void test_vrb_forward_1st_frag(void)
+{
+    static const ipv6_addr_t dst = TEST_FWD_DST;
+    gnrc_sixlowpan_frag_vrb_t *vrbe;
+    gnrc_pktsnip_t *pkt;
+    sixlowpan_frag_t *frag;
+    uint8_t out_dst[IEEE802154_LONG_ADDRESS_LEN];
+    uint8_t *iphc;
+    size_t mhr_len;
+    le_uint16_t pan;
+    msg_t msg;
+
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_nc_set(&dst, _mock_netif->pid,
+                                                  _test_out_dst,
+                                                  sizeof(_test_out_dst)));
+    pkt = _build_frag1();
+    TEST_ASSERT_NOT_NULL(pkt);
+    gnrc_sixlowpan_frag_recv(pkt, NULL, 0);
+    TEST_ASSERT_MESSAGE((xtimer_msg_receive_timeout(&msg,
+                                                    TEST_RECEIVE_TIMEOUT) >= 0) &&
+                        (msg.type == TEST_MSG_TYPE_SENT),
+                        "First fragment was not forwarded");
+    /* the datagram is not reassembled but has an entry for its other
+     * fragments */
+    vrbe = gnrc_sixlowpan_frag_vrb_get(_test_src, sizeof(_test_src),
+                                       _test_dst, sizeof(_test_dst),
+                                       TEST_FWD_DATAGRAM_SIZE, TEST_TAG);
+    TEST_ASSERT_NOT_NULL(vrbe);
+    TEST_ASSERT_EQUAL_INT(sizeof(ipv6_hdr_t) + TEST_FWD_PAYLOAD_SIZE,
+                          vrbe->super.current_size);
+    /* sent to the next hop from the neighbor cache */
+    mhr_len = ieee802154_get_frame_hdr_len(_mock_frame);
+    TEST_ASSERT(mhr_len > 0);
+    TEST_ASSERT_EQUAL_INT(sizeof(out_dst),
+                          ieee802154_get_dst(_mock_frame, out_dst, &pan));
+    TEST_ASSERT(memcmp(out_dst, _test_out_dst, sizeof(out_dst)) == 0);
+    /* with the datagram size of the original and the new tag */
+    frag = (sixlowpan_frag_t *)&_mock_frame[mhr_len];
+    TEST_ASSERT_EQUAL_INT(SIXLOWPAN_FRAG_1_DISP,
+                          frag->disp_size.u8[0] & SIXLOWPAN_FRAG_DISP_MASK);
+    TEST_ASSERT_EQUAL_INT(TEST_FWD_DATAGRAM_SIZE,
+                          byteorder_ntohs(frag->disp_size) &
+                          SIXLOWPAN_FRAG_SIZE_MASK);
+    TEST_ASSERT_EQUAL_INT(vrbe->out_tag, byteorder_ntohs(frag->tag));
+    /* recompressed: the decremented hop limit of 64 is elided now */
+    iphc = (uint8_t *)(frag + 1);
+    TEST_ASSERT(sixlowpan_iphc_is(iphc));
+    TEST_ASSERT_EQUAL_INT(0x02, iphc[0] & SIXLOWPAN_IPHC1_HL);
+    TEST_ASSERT_EQUAL_INT(sizeof(sixlowpan_frag_t) + 3 +
+                          2 * sizeof(ipv6_addr_t) + TEST_FWD_PAYLOAD_SIZE,
+                          _mock_frame_len - mhr_len);
+    TEST_ASSERT_EQUAL_INT(0xa5, _mock_frame[_mock_frame_len - 1]);
+    TEST_ASSERT_MESSAGE(gnrc_pktbuf_is_empty(), "Packet buffer is not empty");
+}
+
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+static void test_vrb_forward_1st_frag__sfr(void)
+{
+    static const ipv6_addr_t dst = TEST_FWD_DST;
+    gnrc_sixlowpan_rbuf_t *rbuf;
+    gnrc_pktsnip_t *pkt;
+    sixlowpan_sfr_rfrag_t *rfrag;
+    sixlowpan_sfr_ack_t *ack;
+    size_t mhr_len;
+    msg_t msg;
+
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_nc_set(&dst, _mock_netif->pid,
+                                                  _test_out_dst,
+                                                  sizeof(_test_out_dst)));
+    pkt = _build_1st_fragment(sizeof(sixlowpan_sfr_rfrag_t));
+    TEST_ASSERT_NOT_NULL(pkt);
+    rfrag = pkt->data;
+    sixlowpan_sfr_rfrag_set_disp(rfrag, (uint8_t)TEST_TAG);
+    sixlowpan_sfr_rfrag_set_ack_req(rfrag);
+    sixlowpan_sfr_rfrag_set_frag_size(rfrag, TEST_FWD_1ST_FRAG_SIZE);
+    sixlowpan_sfr_rfrag_set_offset(rfrag, TEST_FWD_DATAGRAM_SIZE);
+    gnrc_sixlowpan_frag_sfr_recv(pkt, NULL, 0);
+    TEST_ASSERT_MESSAGE((xtimer_msg_receive_timeout(&msg,
+                                                    TEST_RECEIVE_TIMEOUT) >= 0) &&
+                        (msg.type == TEST_MSG_TYPE_SENT),
+                        "First fragment was not acknowledged");
+    /* RFRAGs are acknowledged by the reassembling node, so the first one is
+     * reassembled and not forwarded */
+    mhr_len = ieee802154_get_frame_hdr_len(_mock_frame);
+    TEST_ASSERT(mhr_len > 0);
+    ack = (sixlowpan_sfr_ack_t *)&_mock_frame[mhr_len];
+    TEST_ASSERT(sixlowpan_sfr_ack_is(&ack->base));
+    TEST_ASSERT_EQUAL_INT(SIXLOWPAN_SFR_ACK_BITMAP_BIT(0),
+                          sixlowpan_sfr_ack_get_bitmap(ack));
+    TEST_ASSERT_NULL(gnrc_sixlowpan_frag_vrb_get(_test_src, sizeof(_test_src),
+                                                 _test_dst, sizeof(_test_dst),
+                                                 TEST_FWD_DATAGRAM_SIZE,
+                                                 (uint8_t)TEST_TAG));
+    pkt = gnrc_netif_hdr_build(_test_src, sizeof(_test_src),
+                               _test_dst, sizeof(_test_dst));
+    TEST_ASSERT_NOT_NULL(pkt);
+    rbuf = gnrc_sixlowpan_frag_rbuf_get_sfr(pkt->data, (uint8_t)TEST_TAG, 0, 0);
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT_NOT_NULL(rbuf);
+    TEST_ASSERT_EQUAL_INT(sizeof(ipv6_hdr_t) + TEST_FWD_PAYLOAD_SIZE,
+                          rbuf->super.current_size);
+    gnrc_pktbuf_release(rbuf->pkt);
+    gnrc_sixlowpan_frag_rbuf_remove(rbuf);
+    TEST_ASSERT_MESSAGE(gnrc_pktbuf_is_empty(), "Packet buffer is not empty");
+}
+#endif
+
+static void run_unittests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_vrb_add__success),
+        new_TestFixture(test_vrb_add__full),
+        new_TestFixture(test_vrb_get__success),
+        new_TestFixture(test_vrb_get__not_found),
+        new_TestFixture(test_vrb_rm),
+        new_TestFixture(test_vrb_gc),
+        new_TestFixture(test_vrb_forward__more_data),
+        new_TestFixture(test_vrb_forward__complete),
+        new_TestFixture(test_vrb_forward_1st_frag),
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+        new_TestFixture(test_vrb_forward_1st_frag__sfr),
+#endif
+    };
+
+    EMB_UNIT_TESTCALLER(sixlo_frag_vrb_tests, _set_up, NULL, fixtures);
+    TESTS_START();
+    TESTS_RUN((Test *)&sixlo_frag_vrb_tests);
+    TESTS_END();
+}
+
+static int _mock_send(netdev_t *dev, const iolist_t *iolist)
+{
+    msg_t msg = { .type = TEST_MSG_TYPE_SENT };
+
+    (void)dev;
+    _mock_frame_len = 0;
+    for (; iolist != NULL; iolist = iolist->iol_next) {
+        if ((_mock_frame_len + iolist->iol_len) > sizeof(_mock_frame)) {
+            return -ENOBUFS;
+        }
+        memcpy(&_mock_frame[_mock_frame_len], iolist->iol_base,
+               iolist->iol_len);
+        _mock_frame_len += iolist->iol_len;
+    }
+    msg_send(&msg, _main_pid);
+    return _mock_frame_len;
+}
+
+static int _mock_get_device_type(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    assert(max_len == sizeof(uint16_t));
+    *((uint16_t *)value) = NETDEV_TYPE_IEEE802154;
+    return sizeof(uint16_t);
+}
+
+static int _mock_get_max_packet_size(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    assert(max_len == sizeof(uint16_t));
+    *((uint16_t *)value) = IEEE802154_FRAME_LEN_MAX - IEEE802154_MAX_HDR_LEN -
+                           IEEE802154_FCS_LEN;
+    return sizeof(uint16_t);
+}
+
+static int _mock_get_src_len(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    assert(max_len == sizeof(uint16_t));
+    *((uint16_t *)value) = IEEE802154_LONG_ADDRESS_LEN;
+    return sizeof(uint16_t);
+}
+
+static int _mock_get_address_long(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    assert(max_len >= sizeof(_test_dst));
+    memcpy(value, _test_dst, sizeof(_test_dst));
+    return sizeof(_test_dst);
+}
+
+static int _mock_get_proto(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    assert(max_len == sizeof(gnrc_nettype_t));
+    *((gnrc_nettype_t *)value) = GNRC_NETTYPE_SIXLOWPAN;
+    return sizeof(gnrc_nettype_t);
+}
+
+/* interface the first fragment of a datagram is forwarded over */
+static void _mock_netif_init(void)
+{
+    netdev_test_setup(&_mock_netdev, 0);
+    netdev_test_set_send_cb(&_mock_netdev, _mock_send);
+    netdev_test_set_get_cb(&_mock_netdev, NETOPT_DEVICE_TYPE,
+                           _mock_get_device_type);
+    netdev_test_set_get_cb(&_mock_netdev, NETOPT_MAX_PDU_SIZE,
+                           _mock_get_max_packet_size);
+    netdev_test_set_get_cb(&_mock_netdev, NETOPT_SRC_LEN,
+                           _mock_get_src_len);
+    netdev_test_set_get_cb(&_mock_netdev, NETOPT_ADDRESS_LONG,
+                           _mock_get_address_long);
+    netdev_test_set_get_cb(&_mock_netdev, NETOPT_PROTO,
+                           _mock_get_proto);
+    gnrc_ipv6_nib_init();
+    _mock_netif = gnrc_netif_ieee802154_create(
+            _mock_netif_stack, THREAD_STACKSIZE_DEFAULT, GNRC_NETIF_PRIO,
+            "mockup_wpan", &_mock_netdev.netdev.netdev
+        );
+    assert(_mock_netif != NULL);
+}
+
+int main(void)
+{
+    /* no auto-init, so xtimer needs to be initialized manually */
+    xtimer_init();
+    /* forwarded fragments are sent to this thread */
+    _main_pid = thread_getpid();
+    msg_init_queue(_msg_queue, sizeof(_msg_queue) / sizeof(_msg_queue[0]));
+    _mock_netif_init();
+    run_unittests();
+    return 0;
+}
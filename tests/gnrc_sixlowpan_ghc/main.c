@@ -0,0 +1,439 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests Generic Header Compression with IPHC and its
+ *              negotiation with the 6LoWPAN capability indication option
+ *
+ * @author      Martine Lenders <m.lenders@fu-berlin.de>
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <string.h>
+
+#include "embUnit.h"
+#include "net/gnrc/ipv6/hdr.h"
+#include "net/gnrc/ipv6/nib.h"
+#include "net/gnrc/ndp.h"
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/netif/ieee802154.h"
+#include "net/gnrc/netif/internal.h"
+#include "net/gnrc/netreg.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/sixlowpan/ghc.h"
+#include "net/gnrc/sixlowpan/iphc.h"
+#include "net/icmpv6.h"
+#include "net/ieee802154.h"
+#include "net/ndp.h"
+#include "net/netdev_test.h"
+#include "net/protnum.h"
+#include "net/sixlowpan.h"
+#include "net/sixlowpan/nd.h"
+#include "net/udp.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define _LL0            (0xce)
+#define _LL1            (0xab)
+#define _LL2            (0xfe)
+#define _LL3            (0xad)
+#define _LL4            (0xf7)
+#define _LL5            (0x26)
+#define _LL6            (0xef)
+#define _LL7            (0xa4)
+
+#define TEST_PAYLOAD_SIZE       (40U)
+#define TEST_RECEIVE_TIMEOUT    (10000U)
+#define TEST_MSG_TYPE_SENT      (0x8e20)
+#define TEST_MSG_QUEUE_SIZE     (4U)
+/* GHC NHC ID or UDP NHC ID follow the IPHC header when both addresses are
+ * derived from the link-layer addresses and no field is carried inline */
+#define TEST_NHC_IDX            (SIXLOWPAN_IPHC_HDR_LEN)
+
+static const uint8_t _loc_l2[] = { _LL0, _LL1, _LL2, _LL3,
+                                   _LL4, _LL5, _LL6, _LL7 };
+static const ipv6_addr_t _loc_ll = { {
+                0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            _LL0 ^ 2, _LL1, _LL2, _LL3, _LL4, _LL5, _LL6, _LL7
+        } };
+static const uint8_t _rem_l2[] = { _LL0, _LL1, _LL2, _LL3,
+                                   _LL4, _LL5, _LL6, _LL7 + 1 };
+static const ipv6_addr_t _rem_ll = { {
+                0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            _LL0 ^ 2, _LL1, _LL2, _LL3, _LL4, _LL5, _LL6, _LL7 + 1
+        } };
+
+static uint8_t _buffer[sizeof(ipv6_hdr_t) + sizeof(ndp_rtr_adv_t) +
+                       sizeof(ndp_opt_t) + sizeof(_rem_l2) +
+                       sizeof(sixlowpan_nd_opt_6cio_t)];
+static ipv6_hdr_t *ipv6 = (ipv6_hdr_t *)&_buffer[0];
+static icmpv6_hdr_t *icmpv6 = (icmpv6_hdr_t *)&_buffer[sizeof(ipv6_hdr_t)];
+static uint8_t _ul[sizeof(udp_hdr_t) + TEST_PAYLOAD_SIZE];
+
+static msg_t _msg_queue[TEST_MSG_QUEUE_SIZE];
+static netdev_test_t _mock_netdev;
+static gnrc_netif_t *_mock_netif;
+static char _mock_netif_stack[THREAD_STACKSIZE_DEFAULT];
+static gnrc_netreg_entry_t _dumper;
+static kernel_pid_t _main_pid;
+static uint8_t _mock_frame[IEEE802154_FRAME_LEN_MAX];
+static size_t _mock_frame_len;
+
+static void _drain_msg_queue(void)
+{
+    msg_t msg;
+
+    while (msg_try_receive(&msg) > 0) {
+        if ((msg.type == GNRC_NETAPI_MSG_TYPE_SND) ||
+            (msg.type == GNRC_NETAPI_MSG_TYPE_RCV)) {
+            gnrc_pktbuf_release(msg.content.ptr);
+        }
+    }
+}
+
+static void _set_up(void)
+{
+    gnrc_sixlowpan_ghc_peer_set(_mock_netif, _rem_l2, sizeof(_rem_l2),
+                                false);
+    _drain_msg_queue();
+    memset(_buffer, 0, sizeof(_buffer));
+}
+
+/* puts a router advertisement from _rem_ll into _buffer and returns the
+ * length of its ICMPv6 part */
+static size_t _set_rtr_adv(bool ghc)
+{
+    ndp_rtr_adv_t *rtr_adv = (ndp_rtr_adv_t *)icmpv6;
+    ndp_opt_t *sl2ao = (ndp_opt_t *)(rtr_adv + 1);
+    size_t icmpv6_len = sizeof(ndp_rtr_adv_t);
+
+    ipv6_hdr_set_version(ipv6);
+    ipv6->hl = NDP_HOP_LIMIT;
+    memcpy(&ipv6->src, &_rem_ll, sizeof(ipv6->src));
+    memcpy(&ipv6->dst, &_loc_ll, sizeof(ipv6->dst));
+    rtr_adv->type = ICMPV6_RTR_ADV;
+    rtr_adv->code = 0;
+    /* the router lifetime stays 0 so it is not used as default router */
+    sl2ao->type = NDP_OPT_SL2A;
+    sl2ao->len = 2;
+    memcpy(sl2ao + 1, _rem_l2, sizeof(_rem_l2));
+    icmpv6_len += sizeof(ndp_opt_t) + sizeof(_rem_l2);
+    if (ghc) {
+        sixlowpan_nd_opt_6cio_t *cio;
+
+        cio = (sixlowpan_nd_opt_6cio_t *)&_buffer[sizeof(ipv6_hdr_t) +
+                                                  icmpv6_len];
+        cio->type = NDP_OPT_6CIO;
+        cio->len = SIXLOWPAN_ND_OPT_6CIO_LEN;
+        cio->resv_flags = byteorder_htons(SIXLOWPAN_ND_OPT_6CIO_FLAGS_G);
+        icmpv6_len += sizeof(sixlowpan_nd_opt_6cio_t);
+    }
+    return icmpv6_len;
+}
+
+static void _handle_rtr_adv(bool ghc)
+{
+    size_t icmpv6_len = _set_rtr_adv(ghc);
+
+    gnrc_ipv6_nib_handle_pkt(_mock_netif, ipv6, icmpv6, icmpv6_len);
+}
+
+static gnrc_pktsnip_t *_build_udp(const uint8_t *dst_l2, size_t dst_l2_len)
+{
+    gnrc_pktsnip_t *netif, *pkt;
+    ipv6_hdr_t *ipv6_hdr;
+
+    /* as when forwarded: UDP header and payload in one snip */
+    pkt = gnrc_pktbuf_add(NULL, _ul, sizeof(_ul), GNRC_NETTYPE_UNDEF);
+    if (pkt == NULL) {
+        return NULL;
+    }
+    if ((netif = gnrc_ipv6_hdr_build(pkt, &_loc_ll, &_rem_ll)) == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    pkt = netif;
+    ipv6_hdr = pkt->data;
+    ipv6_hdr->nh = PROTNUM_UDP;
+    ipv6_hdr->hl = 64;
+    ipv6_hdr->len = byteorder_htons(sizeof(_ul));
+    netif = gnrc_netif_hdr_build(NULL, 0, dst_l2, dst_l2_len);
+    if (netif == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    ((gnrc_netif_hdr_t *)netif->data)->if_pid = _mock_netif->pid;
+    netif->next = pkt;
+    return netif;
+}
+
+/* sends a UDP datagram to _rem_l2 and returns its 6LoWPAN frame payload */
+static uint8_t *_send_udp(size_t *len)
+{
+    gnrc_pktsnip_t *pkt = _build_udp(_rem_l2, sizeof(_rem_l2));
+    size_t mhr_len;
+    msg_t msg;
+
+    if (pkt == NULL) {
+        return NULL;
+    }
+    gnrc_sixlowpan_iphc_send(pkt, NULL, 0);
+    if ((xtimer_msg_receive_timeout(&msg, TEST_RECEIVE_TIMEOUT) < 0) ||
+        (msg.type != TEST_MSG_TYPE_SENT)) {
+        return NULL;
+    }
+    if ((mhr_len = ieee802154_get_frame_hdr_len(_mock_frame)) == 0) {
+        return NULL;
+    }
+    *len = _mock_frame_len - mhr_len;
+    return &_mock_frame[mhr_len];
+}
+
+static void test_6cio__rtr_adv_ghc(void)
+{
+    gnrc_pktsnip_t *netif = gnrc_netif_hdr_build(NULL, 0, _rem_l2,
+                                                 sizeof(_rem_l2));
+
+    TEST_ASSERT_NOT_NULL(netif);
+    TEST_ASSERT(!gnrc_sixlowpan_ghc_use(_mock_netif, netif->data));
+    _handle_rtr_adv(true);
+    TEST_ASSERT(gnrc_sixlowpan_ghc_use(_mock_netif, netif->data));
+    /* an RA without 6CIO revokes the capability */
+    _handle_rtr_adv(false);
+    TEST_ASSERT(!gnrc_sixlowpan_ghc_use(_mock_netif, netif->data));
+    gnrc_pktbuf_release(netif);
+}
+
+static void test_6cio__rtr_sol(void)
+{
+    gnrc_pktsnip_t *pkt = NULL;
+    bool cio_found = false;
+    msg_t msg;
+
+    gnrc_ndp_rtr_sol_send(_mock_netif, NULL);
+    while (xtimer_msg_receive_timeout(&msg, TEST_RECEIVE_TIMEOUT) >= 0) {
+        if (msg.type == GNRC_NETAPI_MSG_TYPE_SND) {
+            pkt = msg.content.ptr;
+            break;
+        }
+    }
+    TEST_ASSERT_MESSAGE(pkt != NULL, "Router solicitation was not sent");
+    for (gnrc_pktsnip_t *ptr = pkt; ptr != NULL; ptr = ptr->next) {
+        sixlowpan_nd_opt_6cio_t *cio = ptr->data;
+
+        if ((ptr->size == sizeof(sixlowpan_nd_opt_6cio_t)) &&
+            (cio->type == NDP_OPT_6CIO)) {
+            TEST_ASSERT_EQUAL_INT(SIXLOWPAN_ND_OPT_6CIO_LEN, cio->len);
+            TEST_ASSERT(sixlowpan_nd_opt_6cio_is_ghc(cio));
+            cio_found = true;
+        }
+    }
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT_MESSAGE(cio_found, "Router solicitation has no 6CIO");
+}
+
+static void test_iphc_ghc__not_capable(void)
+{
+    uint8_t *sixlo;
+    size_t len;
+
+    sixlo = _send_udp(&len);
+    TEST_ASSERT_MESSAGE(sixlo != NULL, "Datagram was not sent");
+    TEST_ASSERT(sixlowpan_iphc_is(sixlo));
+    /* UDP NHC, not GHC */
+    TEST_ASSERT_EQUAL_INT(0xf0, sixlo[TEST_NHC_IDX] & 0xf8);
+}
+
+static void test_iphc_ghc__send_recv(void)
+{
+    gnrc_pktsnip_t *netif, *sixlo;
+    ipv6_hdr_t *ipv6_hdr;
+    uint8_t *frame;
+    size_t len;
+    msg_t msg;
+
+    _handle_rtr_adv(true);
+    frame = _send_udp(&len);
+    TEST_ASSERT_MESSAGE(frame != NULL, "Datagram was not sent");
+    TEST_ASSERT(sixlowpan_iphc_is(frame));
+    TEST_ASSERT_EQUAL_INT(SIXLOWPAN_GHC_NHC_UDP, frame[TEST_NHC_IDX]);
+    /* shorter than IPHC, UDP NHC with inline ports and checksum and the
+     * payload */
+    TEST_ASSERT(len < (TEST_NHC_IDX + 7 + TEST_PAYLOAD_SIZE));
+
+    /* receive the frame as the neighbor */
+    netif = gnrc_netif_hdr_build(_loc_l2, sizeof(_loc_l2),
+                                 _rem_l2, sizeof(_rem_l2));
+    TEST_ASSERT_NOT_NULL(netif);
+    ((gnrc_netif_hdr_t *)netif->data)->if_pid = _mock_netif->pid;
+    sixlo = gnrc_pktbuf_add(netif, frame, len, GNRC_NETTYPE_SIXLOWPAN);
+    TEST_ASSERT_NOT_NULL(sixlo);
+    gnrc_sixlowpan_iphc_recv(sixlo, NULL, 0);
+    TEST_ASSERT_MESSAGE((xtimer_msg_receive_timeout(&msg,
+                                                    TEST_RECEIVE_TIMEOUT) >= 0) &&
+                        (msg.type == GNRC_NETAPI_MSG_TYPE_RCV),
+                        "Datagram was not received");
+    sixlo = msg.content.ptr;
+    TEST_ASSERT_EQUAL_INT(GNRC_NETTYPE_IPV6, sixlo->type);
+    TEST_ASSERT_EQUAL_INT(sizeof(ipv6_hdr_t) + sizeof(_ul), sixlo->size);
+    ipv6_hdr = sixlo->data;
+    TEST_ASSERT(ipv6_addr_equal(&_loc_ll, &ipv6_hdr->src));
+    TEST_ASSERT(ipv6_addr_equal(&_rem_ll, &ipv6_hdr->dst));
+    TEST_ASSERT_EQUAL_INT(PROTNUM_UDP, ipv6_hdr->nh);
+    TEST_ASSERT_EQUAL_INT(64, ipv6_hdr->hl);
+    TEST_ASSERT_EQUAL_INT(sizeof(_ul), byteorder_ntohs(ipv6_hdr->len));
+    TEST_ASSERT(memcmp(ipv6_hdr + 1, _ul, sizeof(_ul)) == 0);
+    gnrc_pktbuf_release(sixlo);
+    TEST_ASSERT_MESSAGE(gnrc_pktbuf_is_empty(), "Packet buffer is not empty");
+}
+
+static void test_iphc_ghc__iid_error(void)
+{
+    static const uint8_t invalid_l2[] = { _LL0, _LL1, _LL2 };
+    gnrc_pktsnip_t *pkt;
+
+    /* GHC space is allocated before the destination's IID is derived */
+    gnrc_sixlowpan_ghc_peer_set(_mock_netif, invalid_l2, sizeof(invalid_l2),
+                                true);
+    pkt = _build_udp(invalid_l2, sizeof(invalid_l2));
+    TEST_ASSERT_NOT_NULL(pkt);
+    gnrc_sixlowpan_iphc_send(pkt, NULL, 0);
+    gnrc_sixlowpan_ghc_peer_set(_mock_netif, invalid_l2, sizeof(invalid_l2),
+                                false);
+    TEST_ASSERT_MESSAGE(gnrc_pktbuf_is_empty(), "Packet buffer is not empty");
+}
+
+static void run_unittests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_6cio__rtr_adv_ghc),
+        new_TestFixture(test_6cio__rtr_sol),
+        new_TestFixture(test_iphc_ghc__not_capable),
+        new_TestFixture(test_iphc_ghc__send_recv),
+        new_TestFixture(test_iphc_ghc__iid_error),
+    };
+
+    EMB_UNIT_TESTCALLER(sixlo_ghc_tests, _set_up, NULL, fixtures);
+    TESTS_START();
+    TESTS_RUN((Test *)&sixlo_ghc_tests);
+    TESTS_END();
+}
+
+static int _mock_send(netdev_t *dev, const iolist_t *iolist)
+{
+    msg_t msg = { .type = TEST_MSG_TYPE_SENT };
+
+    (void)dev;
+    _mock_frame_len = 0;
+    for (; iolist != NULL; iolist = iolist->iol_next) {
+        if ((_mock_frame_len + iolist->iol_len) > sizeof(_mock_frame)) {
+            return -ENOBUFS;
+        }
+        memcpy(&_mock_frame[_mock_frame_len], iolist->iol_base,
+               iolist->iol_len);
+        _mock_frame_len += iolist->iol_len;
+    }
+    msg_send(&msg, _main_pid);
+    return _mock_frame_len;
+}
+
+static int _mock_get_device_type(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    assert(max_len == sizeof(uint16_t));
+    *((uint16_t *)value) = NETDEV_TYPE_IEEE802154;
+    return sizeof(uint16_t);
+}
+
+static int _mock_get_max_packet_size(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    assert(max_len == sizeof(uint16_t));
+    *((uint16_t *)value) = IEEE802154_FRAME_LEN_MAX - IEEE802154_MAX_HDR_LEN -
+                           IEEE802154_FCS_LEN;
+    return sizeof(uint16_t);
+}
+
+static int _mock_get_src_len(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    assert(max_len == sizeof(uint16_t));
+    *((uint16_t *)value) = IEEE802154_LONG_ADDRESS_LEN;
+    return sizeof(uint16_t);
+}
+
+static int _mock_get_address_long(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    assert(max_len >= sizeof(_loc_l2));
+    memcpy(value, _loc_l2, sizeof(_loc_l2));
+    return sizeof(_loc_l2);
+}
+
+static int _mock_get_proto(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    assert(max_len == sizeof(gnrc_nettype_t));
+    *((gnrc_nettype_t *)value) = GNRC_NETTYPE_SIXLOWPAN;
+    return sizeof(gnrc_nettype_t);
+}
+
+static void _mock_netif_init(void)
+{
+    netdev_test_setup(&_mock_netdev, 0);
+    netdev_test_set_send_cb(&_mock_netdev, _mock_send);
+    netdev_test_set_get_cb(&_mock_netdev, NETOPT_DEVICE_TYPE,
+                           _mock_get_device_type);
+    netdev_test_set_get_cb(&_mock_netdev, NETOPT_MAX_PDU_SIZE,
+                           _mock_get_max_packet_size);
+    netdev_test_set_get_cb(&_mock_netdev, NETOPT_SRC_LEN,
+                           _mock_get_src_len);
+    netdev_test_set_get_cb(&_mock_netdev, NETOPT_ADDRESS_LONG,
+                           _mock_get_address_long);
+    netdev_test_set_get_cb(&_mock_netdev, NETOPT_PROTO,
+                           _mock_get_proto);
+    gnrc_ipv6_nib_init();
+    _mock_netif = gnrc_netif_ieee802154_create(
+            _mock_netif_stack, THREAD_STACKSIZE_DEFAULT, GNRC_NETIF_PRIO,
+            "mockup_wpan", &_mock_netdev.netdev.netdev
+        );
+    assert(_mock_netif != NULL);
+    /* source address for the router solicitation */
+    gnrc_netif_ipv6_addr_add_internal(_mock_netif, &_loc_ll, 64U,
+                                      GNRC_NETIF_IPV6_ADDRS_FLAGS_STATE_VALID);
+    /* catch router solicitations and received datagrams */
+    gnrc_netreg_entry_init_pid(&_dumper, GNRC_NETREG_DEMUX_CTX_ALL,
+                               _main_pid);
+    gnrc_netreg_register(GNRC_NETTYPE_NDP, &_dumper);
+    gnrc_netreg_register(GNRC_NETTYPE_IPV6, &_dumper);
+}
+
+int main(void)
+{
+    /* no auto-init, so xtimer and the packet buffer need to be initialized
+     * manually */
+    xtimer_init();
+    gnrc_pktbuf_init();
+    _main_pid = thread_getpid();
+    msg_init_queue(_msg_queue, TEST_MSG_QUEUE_SIZE);
+    for (unsigned i = 0; i < sizeof(_ul); i++) {
+        /* compressible: repeats every 8 bytes */
+        _ul[i] = (uint8_t)(i % 8);
+    }
+    _mock_netif_init();
+    run_unittests();
+    return 0;
+}
@@ -587,6 +587,27 @@ static void test_sock_ip_send__no_sock(void)
     assert(_check_net());
 }
 
+static void test_sock_ip_sendv(void)
+{
+    static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR_LOCAL };
+    static const ipv6_addr_t dst_addr = { .u8 = _TEST_ADDR_REMOTE };
+    static const sock_ip_ep_t local = { .addr = { .ipv6 = _TEST_ADDR_LOCAL },
+                                        .family = AF_INET6,
+                                        .netif = _TEST_NETIF };
+    static const sock_ip_ep_t remote = { .addr = { .ipv6 = _TEST_ADDR_REMOTE },
+                                         .family = AF_INET6 };
+    iolist_t tail = { .iol_base = "CD", .iol_len = sizeof("CD") };
+    iolist_t head = { .iol_next = &tail, .iol_base = "AB", .iol_len = 2 };
+
+    assert(0 == sock_ip_create(&_sock, &local, &remote, _TEST_PROTO,
+                               SOCK_FLAGS_REUSE_EP));
+    assert(sizeof("ABCD") == sock_ip_sendv(&_sock, &head, _TEST_PROTO, NULL));
+    assert(_check_packet(&src_addr, &dst_addr, _TEST_PROTO, "ABCD",
+                         sizeof("ABCD"), _TEST_NETIF));
+    xtimer_usleep(1000);    /* let GNRC stack finish */
+    assert(_check_net());
+}
+
 int main(void)
 {
     _net_init();
@@ -632,6 +653,7 @@ int main(void)
     CALL(test_sock_ip_send__unsocketed());
     CALL(test_sock_ip_send__no_sock_no_netif());
     CALL(test_sock_ip_send__no_sock());
+    CALL(test_sock_ip_sendv());
 
     puts("ALL TESTS SUCCESSFUL");
 
@@ -0,0 +1,317 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test for GNRC's TCP socks
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "msg.h"
+#include "net/gnrc/tcp.h"
+#include "net/ipv6/addr.h"
+#include "net/sock/tcp.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define _TEST_PORT          (0x2c94)
+#define _TEST_TIMEOUT       (100000U)
+/* longer than the connection timeout of GNRC TCP */
+#define _TEST_IDLE          (2 * GNRC_TCP_CONNECTION_TIMEOUT_DURATION)
+#define _TEST_DATA          "Hello!"
+
+#define _QUEUE_SIZE         (1)
+#define _MSG_QUEUE_SIZE     (4)
+
+#define _PEER_MSG_LISTEN    (0xe307)
+#define _PEER_MSG_ACCEPT    (0xe308)
+#define _PEER_MSG_CONNECT   (0xe309)
+#define _PEER_MSG_WRITE     (0xe30a)
+#define _PEER_MSG_WRITE_IDLE (0xe30b)
+#define _PEER_MSG_CLOSE     (0xe30c)
+#define _PEER_MSG_STOP      (0xe30d)
+#define _PEER_MSG_ACCEPT_STOPPED (0xe30e)
+
+static const sock_tcp_ep_t _local = { .family = AF_INET6,
+                                      .port = _TEST_PORT,
+                                      .netif = SOCK_ADDR_ANY_NETIF };
+static const sock_tcp_ep_t _remote = { .addr = { .ipv6 = { [15] = 1 } },
+                                       .family = AF_INET6,
+                                       .port = _TEST_PORT,
+                                       .netif = SOCK_ADDR_ANY_NETIF };
+
+static uint8_t _buf[16];
+static sock_tcp_t _sock;
+static sock_tcp_t _queue_array[_QUEUE_SIZE];
+static sock_tcp_queue_t _queue;
+
+static char _peer_stack[THREAD_STACKSIZE_DEFAULT];
+static msg_t _peer_msg_queue[_MSG_QUEUE_SIZE];
+static sock_tcp_t _peer_client;
+static sock_tcp_t _peer_queue_array[_QUEUE_SIZE];
+static sock_tcp_queue_t _peer_queue;
+static sock_tcp_t *_peer_sock;
+static kernel_pid_t _peer;
+static int _peer_accept_res;
+
+#define CALL(fn)            puts("Calling " # fn); fn; tear_down()
+
+static void tear_down(void)
+{
+    msg_t msg = { .type = _PEER_MSG_STOP };
+
+    /* wait until the peer closed all its connections */
+    msg_send_receive(&msg, &msg, _peer);
+    sock_tcp_disconnect(&_sock);
+    sock_tcp_stop_listen(&_queue);
+    memset(&_sock, 0, sizeof(_sock));
+    memset(&_queue, 0, sizeof(_queue));
+}
+
+static void _peer_listen(void)
+{
+    msg_t msg = { .type = _PEER_MSG_LISTEN };
+
+    msg_send_receive(&msg, &msg, _peer);
+    assert(msg.content.value == 0);
+    msg.type = _PEER_MSG_ACCEPT;
+    msg_send(&msg, _peer);
+}
+
+static void _connect(void)
+{
+    _peer_listen();
+    assert(0 == sock_tcp_connect(&_sock, &_remote, 0, 0));
+}
+
+static void test_tcp_connect6__ECONNREFUSED(void)
+{
+    assert(-ECONNREFUSED == sock_tcp_connect(&_sock, &_remote, 0, 0));
+}
+
+static void test_tcp_connect6__success(void)
+{
+    sock_tcp_ep_t ep;
+
+    _connect();
+    assert(0 == sock_tcp_get_remote(&_sock, &ep));
+    assert(AF_INET6 == ep.family);
+    assert(ipv6_addr_is_loopback((ipv6_addr_t *)&ep.addr.ipv6));
+    assert(_TEST_PORT == ep.port);
+}
+
+static void test_tcp_accept6__EAGAIN(void)
+{
+    sock_tcp_t *sock;
+
+    assert(0 == sock_tcp_listen(&_queue, &_local, _queue_array, _QUEUE_SIZE, 0));
+    assert(-EAGAIN == sock_tcp_accept(&_queue, &sock, 0));
+}
+
+static void test_tcp_accept6__ETIMEDOUT(void)
+{
+    sock_tcp_t *sock;
+
+    assert(0 == sock_tcp_listen(&_queue, &_local, _queue_array, _QUEUE_SIZE, 0));
+    puts(" * Calling sock_tcp_accept()");
+    assert(-ETIMEDOUT == sock_tcp_accept(&_queue, &sock, _TEST_TIMEOUT));
+    printf(" * (timed out with timeout %u)\n", _TEST_TIMEOUT);
+}
+
+static void test_tcp_accept6__full_backlog(void)
+{
+    msg_t msg = { .type = _PEER_MSG_CONNECT };
+    sock_tcp_ep_t ep, peer_ep;
+    sock_tcp_t *sock;
+
+    assert(0 == sock_tcp_listen(&_queue, &_local, _queue_array, _QUEUE_SIZE, 0));
+    /* the peer's connection takes the only TCB of the queue ... */
+    msg_send_receive(&msg, &msg, _peer);
+    assert(msg.content.value == 0);
+    /* ... so a second connection is refused until it is accepted */
+    assert(-ECONNREFUSED == sock_tcp_connect(&_sock, &_remote, 0, 0));
+    assert(0 == sock_tcp_accept(&_queue, &sock, 0));
+    assert(0 == sock_tcp_get_remote(sock, &ep));
+    assert(0 == sock_tcp_get_local(&_peer_client, &peer_ep));
+    assert(ipv6_addr_is_loopback((ipv6_addr_t *)&ep.addr.ipv6));
+    assert(peer_ep.port == ep.port);
+    sock_tcp_disconnect(sock);
+}
+
+static void test_tcp_accept6__stop_listen(void)
+{
+    msg_t msg = { .type = _PEER_MSG_LISTEN };
+
+    msg_send_receive(&msg, &msg, _peer);
+    assert(msg.content.value == 0);
+    /* the peer waits in sock_tcp_accept() without timeout ... */
+    msg.type = _PEER_MSG_ACCEPT_STOPPED;
+    msg_send(&msg, _peer);
+    /* ... until another thread stops its queue */
+    sock_tcp_stop_listen(&_peer_queue);
+    assert(-EINVAL == _peer_accept_res);
+}
+
+static void test_tcp_read6__ENOTCONN(void)
+{
+    assert(-ENOTCONN == sock_tcp_read(&_sock, _buf, sizeof(_buf), SOCK_NO_TIMEOUT));
+}
+
+static void test_tcp_read6__EAGAIN(void)
+{
+    _connect();
+    assert(-EAGAIN == sock_tcp_read(&_sock, _buf, sizeof(_buf), 0));
+}
+
+static void test_tcp_read6__ETIMEDOUT(void)
+{
+    _connect();
+    puts(" * Calling sock_tcp_read()");
+    assert(-ETIMEDOUT == sock_tcp_read(&_sock, _buf, sizeof(_buf), _TEST_TIMEOUT));
+    printf(" * (timed out with timeout %u)\n", _TEST_TIMEOUT);
+}
+
+static void test_tcp_read6__success(void)
+{
+    msg_t msg = { .type = _PEER_MSG_WRITE };
+
+    _connect();
+    msg_send(&msg, _peer);
+    assert((ssize_t)sizeof(_TEST_DATA) == sock_tcp_read(&_sock, _buf, sizeof(_buf),
+                                                        SOCK_NO_TIMEOUT));
+    assert(memcmp(_TEST_DATA, _buf, sizeof(_TEST_DATA)) == 0);
+}
+
+static void test_tcp_read6__success_idle(void)
+{
+    msg_t msg = { .type = _PEER_MSG_WRITE_IDLE };
+
+    _connect();
+    /* the peer writes after the connection timeout expired: waiting without
+     * timeout must not abort the idle connection */
+    msg_send(&msg, _peer);
+    assert((ssize_t)sizeof(_TEST_DATA) == sock_tcp_read(&_sock, _buf, sizeof(_buf),
+                                                        SOCK_NO_TIMEOUT));
+    assert(memcmp(_TEST_DATA, _buf, sizeof(_TEST_DATA)) == 0);
+}
+
+static void test_tcp_read6__closed(void)
+{
+    msg_t msg = { .type = _PEER_MSG_CLOSE };
+
+    _connect();
+    msg_send(&msg, _peer);
+    /* the peer closed the connection: end of stream */
+    assert(0 == sock_tcp_read(&_sock, _buf, sizeof(_buf), SOCK_NO_TIMEOUT));
+}
+
+static void test_tcp_write6__ENOTCONN(void)
+{
+    assert(-ENOTCONN == sock_tcp_write(&_sock, _TEST_DATA, sizeof(_TEST_DATA)));
+}
+
+static void *_peer_func(void *arg)
+{
+    msg_t msg, reply;
+
+    (void)arg;
+    msg_init_queue(_peer_msg_queue, _MSG_QUEUE_SIZE);
+    while (1) {
+        msg_receive(&msg);
+        reply.content.value = 0;
+        switch (msg.type) {
+            case _PEER_MSG_LISTEN: {
+                static const sock_tcp_ep_t local = { .family = AF_INET6,
+                                                     .port = _TEST_PORT };
+
+                reply.content.value = sock_tcp_listen(&_peer_queue, &local,
+                                                      _peer_queue_array,
+                                                      _QUEUE_SIZE, 0);
+                break;
+            }
+            case _PEER_MSG_ACCEPT:
+                assert(0 == sock_tcp_accept(&_peer_queue, &_peer_sock,
+                                            SOCK_NO_TIMEOUT));
+                break;
+            case _PEER_MSG_ACCEPT_STOPPED: {
+                sock_tcp_t *sock;
+
+                _peer_accept_res = sock_tcp_accept(&_peer_queue, &sock, SOCK_NO_TIMEOUT);
+                break;
+            }
+            case _PEER_MSG_CONNECT:
+                reply.content.value = sock_tcp_connect(&_peer_client, &_remote,
+                                                       0, 0);
+                break;
+            case _PEER_MSG_WRITE_IDLE:
+                xtimer_usleep(_TEST_IDLE);
+                /* falls through */
+            case _PEER_MSG_WRITE:
+                assert((ssize_t)sizeof(_TEST_DATA) ==
+                       sock_tcp_write(_peer_sock, _TEST_DATA, sizeof(_TEST_DATA)));
+                break;
+            case _PEER_MSG_CLOSE:
+                sock_tcp_disconnect(_peer_sock);
+                _peer_sock = NULL;
+                break;
+            case _PEER_MSG_STOP:
+                if (_peer_sock != NULL) {
+                    sock_tcp_disconnect(_peer_sock);
+                    _peer_sock = NULL;
+                }
+                sock_tcp_disconnect(&_peer_client);
+                sock_tcp_stop_listen(&_peer_queue);
+                memset(&_peer_client, 0, sizeof(_peer_client));
+                memset(&_peer_queue, 0, sizeof(_peer_queue));
+                break;
+            default:
+                break;
+        }
+        /* only fails for messages that were not sent with msg_send_receive() */
+        msg_reply(&msg, &reply);
+    }
+    return NULL;
+}
+
+int main(void)
+{
+    _peer = thread_create(_peer_stack, sizeof(_peer_stack),
+                          THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                          _peer_func, NULL, "tcp_peer");
+    assert(_peer > 0);
+    tear_down();
+
+    CALL(test_tcp_connect6__ECONNREFUSED());
+    CALL(test_tcp_connect6__success());
+    CALL(test_tcp_accept6__EAGAIN());
+    CALL(test_tcp_accept6__ETIMEDOUT());
+    CALL(test_tcp_accept6__full_backlog());
+    CALL(test_tcp_accept6__stop_listen());
+    CALL(test_tcp_read6__ENOTCONN());
+    CALL(test_tcp_read6__EAGAIN());
+    CALL(test_tcp_read6__ETIMEDOUT());
+    CALL(test_tcp_read6__success());
+    CALL(test_tcp_read6__success_idle());
+    CALL(test_tcp_read6__closed());
+    CALL(test_tcp_write6__ENOTCONN());
+
+    puts("ALL TESTS SUCCESSFUL");
+
+    return 0;
+}
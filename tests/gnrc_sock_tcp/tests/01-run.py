@@ -0,0 +1,35 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2019 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("Calling test_tcp_connect6__ECONNREFUSED()")
+    child.expect_exact("Calling test_tcp_connect6__success()")
+    child.expect_exact("Calling test_tcp_accept6__EAGAIN()")
+    child.expect_exact("Calling test_tcp_accept6__ETIMEDOUT()")
+    child.expect_exact(" * Calling sock_tcp_accept()")
+    child.expect(r" \* \(timed out with timeout \d+\)")
+    child.expect_exact("Calling test_tcp_accept6__full_backlog()")
+    child.expect_exact("Calling test_tcp_accept6__stop_listen()")
+    child.expect_exact("Calling test_tcp_read6__ENOTCONN()")
+    child.expect_exact("Calling test_tcp_read6__EAGAIN()")
+    child.expect_exact("Calling test_tcp_read6__ETIMEDOUT()")
+    child.expect_exact(" * Calling sock_tcp_read()")
+    child.expect(r" \* \(timed out with timeout \d+\)")
+    child.expect_exact("Calling test_tcp_read6__success()")
+    child.expect_exact("Calling test_tcp_read6__success_idle()")
+    child.expect_exact("Calling test_tcp_read6__closed()")
+    child.expect_exact("Calling test_tcp_write6__ENOTCONN()")
+    child.expect_exact(u"ALL TESTS SUCCESSFUL")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=60))
@@ -22,6 +22,7 @@
 #include <stdint.h>
 #include <stdio.h>
 
+#include "net/gnrc/pktbuf.h"
 #include "net/sock/udp.h"
 #include "xtimer.h"
 
@@ -234,6 +235,23 @@ static void test_sock_udp_recv__ENOBUFS(void)
     assert(_check_net());
 }
 
+static void test_sock_udp_recv__EBADMSG(void)
+{
+    static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR_REMOTE };
+    static const ipv6_addr_t dst_addr = { .u8 = _TEST_ADDR_LOCAL };
+    static const sock_udp_ep_t local = { .family = AF_INET6,
+                                         .port = _TEST_PORT_LOCAL };
+
+    assert(0 == sock_udp_create(&_sock, &local, NULL, SOCK_FLAGS_REUSE_EP));
+    assert(_inject_packet_bad_csum(&src_addr, &dst_addr, _TEST_PORT_REMOTE,
+                                   _TEST_PORT_LOCAL, "ABCD", sizeof("ABCD"),
+                                   _TEST_NETIF));
+    assert(-EBADMSG == sock_udp_recv(&_sock, _test_buffer,
+                                     sizeof(_test_buffer), SOCK_NO_TIMEOUT,
+                                     NULL));
+    assert(_check_net());
+}
+
 static void test_sock_udp_recv__EPROTO(void)
 {
     static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR_WRONG };
@@ -421,6 +439,95 @@ static void test_sock_udp_recv__non_blocking(void)
     assert(_check_net());
 }
 
+static void test_sock_udp_recv_buf(void)
+{
+    static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR_REMOTE };
+    static const ipv6_addr_t dst_addr = { .u8 = _TEST_ADDR_LOCAL };
+    static const sock_udp_ep_t local = { .family = AF_INET6,
+                                         .port = _TEST_PORT_LOCAL };
+    sock_udp_ep_t result;
+    void *data = NULL, *ctx = NULL;
+
+    assert(0 == sock_udp_create(&_sock, &local, NULL, SOCK_FLAGS_REUSE_EP));
+    assert(_inject_packet(&src_addr, &dst_addr, _TEST_PORT_REMOTE,
+                          _TEST_PORT_LOCAL, "ABCD", sizeof("ABCD"),
+                          _TEST_NETIF));
+    assert(sizeof("ABCD") == sock_udp_recv_buf(&_sock, &data, &ctx,
+                                               SOCK_NO_TIMEOUT, &result));
+    assert(data != NULL);
+    assert(ctx != NULL);
+    assert(memcmp(data, "ABCD", sizeof("ABCD")) == 0);
+    assert(AF_INET6 == result.family);
+    assert(memcmp(&result.addr, &src_addr, sizeof(result.addr)) == 0);
+    assert(_TEST_PORT_REMOTE == result.port);
+    assert(_TEST_NETIF == result.netif);
+    assert(0 == sock_udp_recv_buf(&_sock, &data, &ctx, SOCK_NO_TIMEOUT,
+                                  NULL));
+    assert(data == NULL);
+    assert(ctx == NULL);
+    assert(_check_net());
+}
+
+static void test_sock_udp_recv_buf__chunked(void)
+{
+    static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR_REMOTE };
+    static const ipv6_addr_t dst_addr = { .u8 = _TEST_ADDR_LOCAL };
+    static const sock_udp_ep_t local = { .family = AF_INET6,
+                                         .port = _TEST_PORT_LOCAL };
+    void *data = NULL, *ctx = NULL;
+
+    assert(0 == sock_udp_create(&_sock, &local, NULL, SOCK_FLAGS_REUSE_EP));
+    assert(_inject_packet_chunked(&src_addr, &dst_addr, _TEST_PORT_REMOTE,
+                                  _TEST_PORT_LOCAL, "ABCDEFGH", 8, 3,
+                                  _TEST_NETIF));
+    assert(3 == sock_udp_recv_buf(&_sock, &data, &ctx, SOCK_NO_TIMEOUT,
+                                  NULL));
+    assert(memcmp(data, "ABC", 3) == 0);
+    assert(ctx != NULL);
+    assert(5 == sock_udp_recv_buf(&_sock, &data, &ctx, SOCK_NO_TIMEOUT,
+                                  NULL));
+    assert(memcmp(data, "DEFGH", 5) == 0);
+    assert(ctx != NULL);
+    assert(0 == sock_udp_recv_buf(&_sock, &data, &ctx, SOCK_NO_TIMEOUT,
+                                  NULL));
+    assert(data == NULL);
+    assert(ctx == NULL);
+    assert(_check_net());
+}
+
+static void test_sock_udp_recv_buf__empty(void)
+{
+    static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR_REMOTE };
+    static const ipv6_addr_t dst_addr = { .u8 = _TEST_ADDR_LOCAL };
+    static const sock_udp_ep_t local = { .family = AF_INET6,
+                                         .port = _TEST_PORT_LOCAL };
+    sock_udp_ep_t result;
+    void *data = NULL, *ctx = NULL;
+
+    assert(0 == sock_udp_create(&_sock, &local, NULL, SOCK_FLAGS_REUSE_EP));
+    assert(_inject_packet(&src_addr, &dst_addr, _TEST_PORT_REMOTE,
+                          _TEST_PORT_LOCAL, "", 0, _TEST_NETIF));
+    assert(0 == sock_udp_recv_buf(&_sock, &data, &ctx, SOCK_NO_TIMEOUT,
+                                  &result));
+    assert(data == NULL);
+    assert(ctx == NULL);
+    assert(_TEST_PORT_REMOTE == result.port);
+    assert(_check_net());
+}
+
+static void test_sock_udp_recv_buf__EAGAIN(void)
+{
+    static const sock_udp_ep_t local = { .family = AF_INET6, .netif = _TEST_NETIF,
+                                         .port = _TEST_PORT_LOCAL };
+    void *data, *ctx = NULL;
+
+    assert(0 == sock_udp_create(&_sock, &local, NULL, SOCK_FLAGS_REUSE_EP));
+
+    assert(-EAGAIN == sock_udp_recv_buf(&_sock, &data, &ctx, 0, NULL));
+    assert(ctx == NULL);
+    assert(_check_net());
+}
+
 static void test_sock_udp_send__EAFNOSUPPORT(void)
 {
     static const sock_udp_ep_t remote = { .addr = { .ipv6 = _TEST_ADDR_REMOTE },
@@ -693,6 +800,55 @@ static void test_sock_udp_send__no_sock(void)
     assert(_check_net());
 }
 
+static void test_sock_udp_sendv(void)
+{
+    static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR_LOCAL };
+    static const ipv6_addr_t dst_addr = { .u8 = _TEST_ADDR_REMOTE };
+    static const sock_udp_ep_t local = { .addr = { .ipv6 = _TEST_ADDR_LOCAL },
+                                         .family = AF_INET6,
+                                         .netif = _TEST_NETIF,
+                                         .port = _TEST_PORT_LOCAL };
+    static const sock_udp_ep_t remote = { .addr = { .ipv6 = _TEST_ADDR_REMOTE },
+                                          .family = AF_INET6,
+                                          .port = _TEST_PORT_REMOTE };
+    iolist_t tail = { .iol_base = "CD", .iol_len = sizeof("CD") };
+    iolist_t head = { .iol_next = &tail, .iol_base = "AB", .iol_len = 2 };
+
+    assert(0 == sock_udp_create(&_sock, &local, &remote, SOCK_FLAGS_REUSE_EP));
+    assert(sizeof("ABCD") == sock_udp_sendv(&_sock, &head, NULL));
+    assert(_check_packet(&src_addr, &dst_addr, _TEST_PORT_LOCAL,
+                         _TEST_PORT_REMOTE, "ABCD", sizeof("ABCD"),
+                         _TEST_NETIF, false));
+    xtimer_usleep(1000);    /* let GNRC stack finish */
+    assert(_check_net());
+}
+
+static void test_sock_udp_sendv__pktbuf(void)
+{
+    static const sock_udp_ep_t local = { .addr = { .ipv6 = _TEST_ADDR_LOCAL },
+                                         .family = AF_INET6,
+                                         .netif = _TEST_NETIF,
+                                         .port = _TEST_PORT_LOCAL };
+    static const sock_udp_ep_t remote = { .addr = { .ipv6 = _TEST_ADDR_REMOTE },
+                                          .family = AF_INET6,
+                                          .port = _TEST_PORT_REMOTE };
+    gnrc_pktsnip_t *tail;
+    iolist_t head = { .iol_base = "AB", .iol_len = 2 };
+
+    assert(0 == sock_udp_create(&_sock, &local, &remote, SOCK_FLAGS_REUSE_EP));
+    tail = gnrc_pktbuf_add(NULL, "CD", sizeof("CD"), GNRC_NETTYPE_UNDEF);
+    assert(tail != NULL);
+    /* gnrc_pktsnip_t starts like iolist_t */
+    head.iol_next = (iolist_t *)tail;
+    assert(sizeof("ABCD") == sock_udp_sendv(&_sock, &head, NULL));
+    /* the snip was linked, not copied */
+    assert(_check_packet_linked("AB", 2, tail));
+    assert(tail->users == 1);
+    gnrc_pktbuf_release(tail);
+    xtimer_usleep(1000);    /* let GNRC stack finish */
+    assert(_check_net());
+}
+
 int main(void)
 {
     _net_init();
@@ -715,6 +871,7 @@ int main(void)
     CALL(test_sock_udp_recv__EADDRNOTAVAIL());
     CALL(test_sock_udp_recv__EAGAIN());
     CALL(test_sock_udp_recv__ENOBUFS());
+    CALL(test_sock_udp_recv__EBADMSG());
     CALL(test_sock_udp_recv__EPROTO());
     CALL(test_sock_udp_recv__ETIMEDOUT());
     CALL(test_sock_udp_recv__socketed());
@@ -724,6 +881,10 @@ int main(void)
     CALL(test_sock_udp_recv__unsocketed_with_remote());
     CALL(test_sock_udp_recv__with_timeout());
     CALL(test_sock_udp_recv__non_blocking());
+    CALL(test_sock_udp_recv_buf());
+    CALL(test_sock_udp_recv_buf__chunked());
+    CALL(test_sock_udp_recv_buf__empty());
+    CALL(test_sock_udp_recv_buf__EAGAIN());
     _prepare_send_checks();
     CALL(test_sock_udp_send__EAFNOSUPPORT());
     CALL(test_sock_udp_send__EINVAL_addr());
@@ -741,6 +902,8 @@ int main(void)
     CALL(test_sock_udp_send__unsocketed());
     CALL(test_sock_udp_send__no_sock_no_netif());
     CALL(test_sock_udp_send__no_sock());
+    CALL(test_sock_udp_sendv());
+    CALL(test_sock_udp_sendv__pktbuf());
 
     puts("ALL TESTS SUCCESSFUL");
 
@@ -21,6 +21,7 @@
 #include "net/gnrc/netif/hdr.h"
 #include "net/gnrc/netreg.h"
 #include "net/gnrc/udp.h"
+#include "net/inet_csum.h"
 #include "net/sock.h"
 #include "sched.h"
 
@@ -110,6 +111,43 @@ bool _inject_packet(const ipv6_addr_t *src, const ipv6_addr_t *dst,
                                          GNRC_NETREG_DEMUX_CTX_ALL, pkt) > 0);
 }
 
+bool _inject_packet_bad_csum(const ipv6_addr_t *src, const ipv6_addr_t *dst,
+                             uint16_t src_port, uint16_t dst_port,
+                             void *data, size_t data_len, uint16_t netif)
+{
+    gnrc_pktsnip_t *pkt = _build_udp_packet(src, dst, src_port, dst_port,
+                                            data, data_len, netif);
+
+    if (pkt == NULL) {
+        return false;
+    }
+    /* corrupt the payload after the checksum was calculated */
+    ((uint8_t *)pkt->data)[sizeof(udp_hdr_t)] ^= 0xff;
+    return (gnrc_netapi_dispatch_receive(GNRC_NETTYPE_UDP,
+                                         GNRC_NETREG_DEMUX_CTX_ALL, pkt) > 0);
+}
+
+bool _inject_packet_chunked(const ipv6_addr_t *src, const ipv6_addr_t *dst,
+                            uint16_t src_port, uint16_t dst_port,
+                            void *data, size_t data_len, size_t chunk_len,
+                            uint16_t netif)
+{
+    gnrc_pktsnip_t *pkt = _build_udp_packet(src, dst, src_port, dst_port,
+                                            data, data_len, netif);
+
+    if (pkt == NULL) {
+        return false;
+    }
+    /* do what gnrc_udp does on reception and split the payload further */
+    if ((gnrc_pktbuf_mark(pkt, sizeof(udp_hdr_t), GNRC_NETTYPE_UDP) == NULL) ||
+        (gnrc_pktbuf_mark(pkt, chunk_len, GNRC_NETTYPE_UNDEF) == NULL)) {
+        gnrc_pktbuf_release(pkt);
+        return false;
+    }
+    pkt->type = GNRC_NETTYPE_UNDEF;
+    return (gnrc_netapi_dispatch_receive(GNRC_NETTYPE_UDP, dst_port, pkt) > 0);
+}
+
 bool _check_net(void)
 {
     return (gnrc_pktbuf_is_sane() && gnrc_pktbuf_is_empty());
@@ -127,6 +165,7 @@ bool _check_packet(const ipv6_addr_t *src, const ipv6_addr_t *dst,
                    bool random_src_port)
 {
     gnrc_pktsnip_t *pkt, *ipv6, *udp;
+    gnrc_netif_hdr_t *netif_hdr;
     ipv6_hdr_t *ipv6_hdr;
     udp_hdr_t *udp_hdr;
     msg_t msg;
@@ -136,21 +175,20 @@ bool _check_packet(const ipv6_addr_t *src, const ipv6_addr_t *dst,
         return false;
     }
     pkt = msg.content.ptr;
-    if (iface != SOCK_ADDR_ANY_NETIF) {
-        gnrc_netif_hdr_t *netif_hdr;
-
-        if (pkt->type != GNRC_NETTYPE_NETIF) {
-            return _res(pkt, false);
-        }
-        netif_hdr = pkt->data;
-        if (netif_hdr->if_pid != (int)iface) {
-            return _res(pkt, false);
-        }
-        ipv6 = pkt->next;
+    /* the netif header carries the flag for the payload sum in the UDP
+     * header, even without interface */
+    if (pkt->type != GNRC_NETTYPE_NETIF) {
+        return _res(pkt, false);
     }
-    else {
-        ipv6 = pkt;
+    netif_hdr = pkt->data;
+    if (((iface == SOCK_ADDR_ANY_NETIF) &&
+         (netif_hdr->if_pid != KERNEL_PID_UNDEF)) ||
+        ((iface != SOCK_ADDR_ANY_NETIF) &&
+         (netif_hdr->if_pid != (int)iface)) ||
+        !(netif_hdr->flags & GNRC_NETIF_HDR_FLAGS_CSUM_PAYLOAD)) {
+        return _res(pkt, false);
     }
+    ipv6 = pkt->next;
     if (ipv6->type != GNRC_NETTYPE_IPV6) {
         return _res(pkt, false);
     }
@@ -165,7 +203,29 @@ bool _check_packet(const ipv6_addr_t *src, const ipv6_addr_t *dst,
                 (ipv6_hdr->nh == PROTNUM_UDP) &&
                 (random_src_port || (src_port == byteorder_ntohs(udp_hdr->src_port))) &&
                 (dst_port == byteorder_ntohs(udp_hdr->dst_port)) &&
+                (byteorder_ntohs(udp_hdr->checksum) ==
+                 inet_csum(0, data, data_len)) &&
                 (udp->next != NULL) &&
                 (data_len == udp->next->size) &&
                 (memcmp(data, udp->next->data, data_len) == 0));
 }
+
+bool _check_packet_linked(void *data, size_t data_len,
+                          const gnrc_pktsnip_t *tail)
+{
+    gnrc_pktsnip_t *pkt, *udp;
+    msg_t msg;
+
+    msg_receive(&msg);
+    if (msg.type != GNRC_NETAPI_MSG_TYPE_SND) {
+        return false;
+    }
+    pkt = msg.content.ptr;
+    udp = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_UDP);
+    if ((udp == NULL) || (udp->next == NULL)) {
+        return _res(pkt, false);
+    }
+    return _res(pkt, (data_len == udp->next->size) &&
+                (memcmp(data, udp->next->data, data_len) == 0) &&
+                (udp->next->next == tail));
+}
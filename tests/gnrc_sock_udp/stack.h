@@ -23,6 +23,7 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+#include "net/gnrc/pkt.h"
 #include "net/ipv6/addr.h"
 
 #ifdef __cplusplus
@@ -57,6 +58,50 @@ bool _inject_packet(const ipv6_addr_t *src, const ipv6_addr_t *dst,
                     uint16_t src_port, uint16_t dst_port,
                     void *data, size_t data_len, uint16_t netif);
 
+/**
+ * @brief   Injects a received UDP packet with an invalid checksum into the
+ *          stack
+ *
+ * @param[in] src       The source address of the UDP packet
+ * @param[in] dst       The destination address of the UDP packet
+ * @param[in] src_port  The source port of the UDP packet
+ * @param[in] dst_port  The destination port of the UDP packet
+ * @param[in] data      The payload of the UDP packet, must not be empty
+ * @param[in] data_len  The payload length of the UDP packet
+ * @param[in] netif     The interface the packet came over
+ *
+ * @return  true, if packet was successfully injected
+ * @return  false, if an error occured during injection
+ */
+bool _inject_packet_bad_csum(const ipv6_addr_t *src, const ipv6_addr_t *dst,
+                             uint16_t src_port, uint16_t dst_port,
+                             void *data, size_t data_len, uint16_t netif);
+
+/**
+ * @brief   Injects a received UDP packet with its payload split in two snips
+ *          directly into the sock layer
+ *
+ * The payload snip containing the last `data_len - chunk_len` bytes precedes
+ * the one containing the first @p chunk_len bytes.
+ *
+ * @param[in] src       The source address of the UDP packet
+ * @param[in] dst       The destination address of the UDP packet
+ * @param[in] src_port  The source port of the UDP packet
+ * @param[in] dst_port  The destination port of the UDP packet
+ * @param[in] data      The payload of the UDP packet
+ * @param[in] data_len  The payload length of the UDP packet
+ * @param[in] chunk_len Length of the second payload snip, must be less than
+ *                      @p data_len
+ * @param[in] netif     The interface the packet came over
+ *
+ * @return  true, if packet was successfully injected
+ * @return  false, if an error occured during injection
+ */
+bool _inject_packet_chunked(const ipv6_addr_t *src, const ipv6_addr_t *dst,
+                            uint16_t src_port, uint16_t dst_port,
+                            void *data, size_t data_len, size_t chunk_len,
+                            uint16_t netif);
+
 /**
  * @brief   Checks networking state (e.g. packet buffer state)
  *
@@ -87,6 +132,20 @@ bool _check_packet(const ipv6_addr_t *src, const ipv6_addr_t *dst,
                    bool random_src_port);
 
 
+/**
+ * @brief   Checks if a UDP packet was sent with a copied payload snip
+ *          followed by a given snip
+ *
+ * @param[in] data      Expected content of the copied payload snip
+ * @param[in] data_len  Expected length of the copied payload snip
+ * @param[in] tail      The snip expected to follow the copied one
+ *
+ * @return  true, if all parameters match as expected
+ * @return  false, if not.
+ */
+bool _check_packet_linked(void *data, size_t data_len,
+                          const gnrc_pktsnip_t *tail);
+
 #ifdef __cplusplus
 }
 #endif
@@ -23,6 +23,7 @@ def testfunc(child):
     child.expect_exact(u"Calling test_sock_udp_recv__EADDRNOTAVAIL()")
     child.expect_exact(u"Calling test_sock_udp_recv__EAGAIN()")
     child.expect_exact(u"Calling test_sock_udp_recv__ENOBUFS()")
+    child.expect_exact(u"Calling test_sock_udp_recv__EBADMSG()")
     child.expect_exact(u"Calling test_sock_udp_recv__EPROTO()")
     child.expect_exact(u"Calling test_sock_udp_recv__ETIMEDOUT()")
     child.expect_exact(u" * Calling sock_udp_recv()")
@@ -33,6 +34,10 @@ def testfunc(child):
     child.expect_exact(u"Calling test_sock_udp_recv__unsocketed_with_remote()")
     child.expect_exact(u"Calling test_sock_udp_recv__with_timeout()")
     child.expect_exact(u"Calling test_sock_udp_recv__non_blocking()")
+    child.expect_exact(u"Calling test_sock_udp_recv_buf()")
+    child.expect_exact(u"Calling test_sock_udp_recv_buf__chunked()")
+    child.expect_exact(u"Calling test_sock_udp_recv_buf__empty()")
+    child.expect_exact(u"Calling test_sock_udp_recv_buf__EAGAIN()")
     child.expect_exact(u"Calling test_sock_udp_send__EAFNOSUPPORT()")
     child.expect_exact(u"Calling test_sock_udp_send__EINVAL_addr()")
     child.expect_exact(u"Calling test_sock_udp_send__EINVAL_netif()")
@@ -49,6 +54,8 @@ def testfunc(child):
     child.expect_exact(u"Calling test_sock_udp_send__unsocketed()")
     child.expect_exact(u"Calling test_sock_udp_send__no_sock_no_netif()")
     child.expect_exact(u"Calling test_sock_udp_send__no_sock()")
+    child.expect_exact(u"Calling test_sock_udp_sendv()")
+    child.expect_exact(u"Calling test_sock_udp_sendv__pktbuf()")
     child.expect_exact(u"ALL TESTS SUCCESSFUL")
 
 
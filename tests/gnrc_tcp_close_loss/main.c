@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief   Tests that GNRC TCP retransmits a lost FIN sent behind several
+ *          data segments
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <errno.h>
+#include "net/af.h"
+#include "net/ipv6/hdr.h"
+#include "net/protnum.h"
+#include "net/tcp.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/tcp.h"
+#include "xtimer.h"
+
+/* Port to listen on */
+#ifndef SERVER_PORT
+#define SERVER_PORT (8080)
+#endif
+
+/* Amount of data to transmit, more than fits into the retransmit queue */
+#ifndef NBYTE
+#define NBYTE (8 * GNRC_TCP_MSS)
+#endif
+
+/* Test pattern used by server application */
+#ifndef TEST_PATERN_SRV
+#define TEST_PATERN_SRV (0xA7)
+#endif
+
+/* Data segment (counted from 1) that is dropped on its first transmission */
+#define DROP_SEGMENT    (NBYTE / GNRC_TCP_MSS)
+
+/* FIN flag in the TCP header */
+#define TCP_FIN         (0x0001)
+
+static struct {
+    uint32_t seq;
+    uint32_t time;
+    unsigned num;
+} _fin, _seg;
+
+static unsigned _segments;
+static netdev_driver_t _driver;
+static const netdev_driver_t *_orig_driver;
+static uint8_t _buf[NBYTE];
+
+static int _send(netdev_t *dev, const iolist_t *iolist)
+{
+    /* iolist contains the link layer header, followed by the packet snips */
+    const iolist_t *ipv6 = iolist->iol_next;
+    const iolist_t *tcp = (ipv6) ? ipv6->iol_next : NULL;
+
+    if (tcp && ipv6->iol_len == sizeof(ipv6_hdr_t) && tcp->iol_len >= sizeof(tcp_hdr_t) &&
+        ((ipv6_hdr_t *)ipv6->iol_base)->nh == PROTNUM_TCP) {
+        ipv6_hdr_t *ipv6_hdr = ipv6->iol_base;
+        tcp_hdr_t *tcp_hdr = tcp->iol_base;
+        uint16_t off_ctl = byteorder_ntohs(tcp_hdr->off_ctl);
+        unsigned hdr_len = (off_ctl >> 12) * 4;
+        uint32_t seq = byteorder_ntohl(tcp_hdr->seq_num);
+
+        if (off_ctl & TCP_FIN) {
+            /* Drop the first transmission of the FIN */
+            if (_fin.num++ == 0) {
+                _fin.seq = seq;
+                _fin.time = xtimer_now_usec();
+                puts("Dropped FIN");
+                return iolist_size(iolist);
+            }
+            if (_fin.num == 2) {
+                printf("Retransmitted FIN after %" PRIu32 " us\n",
+                       xtimer_now_usec() - _fin.time);
+            }
+        }
+        /* Only look at segments carrying data */
+        else if (byteorder_ntohs(ipv6_hdr->len) > hdr_len) {
+            if (_seg.num > 0 && _seg.seq == seq) {
+                printf("Retransmitted segment %u after %" PRIu32 " us\n", DROP_SEGMENT,
+                       xtimer_now_usec() - _seg.time);
+            }
+            else if (++_segments == DROP_SEGMENT) {
+                _seg.num++;
+                _seg.seq = seq;
+                _seg.time = xtimer_now_usec();
+                printf("Dropped segment %u\n", DROP_SEGMENT);
+                return iolist_size(iolist);
+            }
+        }
+    }
+    return _orig_driver->send(dev, iolist);
+}
+
+int main(void)
+{
+    gnrc_netif_t *netif;
+    ipv6_addr_t addrs[GNRC_NETIF_IPV6_ADDRS_NUMOF];
+    char addr_str[IPV6_ADDR_MAX_STR_LEN];
+    gnrc_tcp_tcb_t tcb;
+    int res;
+
+    if (!(netif = gnrc_netif_iter(NULL))) {
+        printf("No valid network interface found\n");
+        return 1;
+    }
+
+    /* Intercept all packets sent over the interface */
+    _orig_driver = netif->dev->driver;
+    _driver = *_orig_driver;
+    _driver.send = _send;
+    netif->dev->driver = &_driver;
+
+    res = gnrc_netif_ipv6_addrs_get(netif, addrs, sizeof(addrs));
+    for (unsigned i = 0; i < (res / sizeof(ipv6_addr_t)); i++) {
+        if (ipv6_addr_is_link_local(&addrs[i])) {
+            ipv6_addr_to_str(addr_str, &addrs[i], sizeof(addr_str));
+        }
+    }
+
+    for (size_t i = 0; i < sizeof(_buf); ++i) {
+        _buf[i] = TEST_PATERN_SRV;
+    }
+
+    gnrc_tcp_tcb_init(&tcb);
+    printf("Listening on [%s]:%u\n", addr_str, SERVER_PORT);
+    if ((res = gnrc_tcp_open_passive(&tcb, AF_INET6, NULL, SERVER_PORT)) < 0) {
+        printf("gnrc_tcp_open_passive() : %d\n", res);
+        return 1;
+    }
+    puts("Connected");
+
+    for (size_t sent = 0; sent < sizeof(_buf); sent += res) {
+        res = gnrc_tcp_send(&tcb, _buf + sent, sizeof(_buf) - sent, 0);
+        if (res < 0) {
+            printf("gnrc_tcp_send() : %d\n", res);
+            gnrc_tcp_abort(&tcb);
+            return 1;
+        }
+    }
+    /* Returns after the FIN was acknowledged and TIME_WAIT expired */
+    gnrc_tcp_close(&tcb);
+    printf("FIN sent %u times\n", _fin.num);
+    printf("Sent %u byte\n", (unsigned)sizeof(_buf));
+    return 0;
+}
@@ -0,0 +1,70 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2019 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import re
+import socket
+import subprocess
+import sys
+import time
+
+from testrunner import run
+
+
+NBYTE = 8 * 1220
+TEST_PATERN_SRV = b"\xa7"
+# The FIN is recovered by the retransmission timeout, which is at least 1 s
+MAX_RECOVERY_US = 5000000
+
+
+def get_bridge(tap):
+    output = subprocess.check_output(["bridge", "link"]).decode("utf-8")
+    for line in output.splitlines():
+        m = re.search(r"{}.+master\s+(?P<master>[^\s]+)".format(tap), line)
+        if m is not None:
+            return m.group("master")
+    return tap
+
+
+def testfunc(child):
+    tap = get_bridge(os.environ["TAP"])
+
+    child.expect(r"Listening on \[(?P<addr>[0-9a-f:]+)\]:(?P<port>\d+)")
+    addr = child.match.group("addr")
+    port = int(child.match.group("port"))
+
+    sock = socket.socket(socket.AF_INET6, socket.SOCK_STREAM)
+    sock.settimeout(10)
+    sock.connect((addr, port, 0, socket.if_nametoindex(tap)))
+    start = time.time()
+    child.expect_exact("Connected")
+
+    # The stream only ends, if the lost FIN was retransmitted
+    data = b""
+    while True:
+        chunk = sock.recv(4096)
+        if not chunk:
+            break
+        data += chunk
+    duration = time.time() - start
+    sock.close()
+    assert data == TEST_PATERN_SRV * NBYTE
+    print("Received {} byte in {:.3f} s: {:.1f} kbit/s goodput"
+          .format(len(data), duration, len(data) * 8 / duration / 1000))
+
+    child.expect_exact("Dropped FIN")
+    child.expect(r"Retransmitted FIN after (?P<delay>\d+) us")
+    assert int(child.match.group("delay")) < MAX_RECOVERY_US
+    child.expect(r"FIN sent (?P<num>\d+) times")
+    assert int(child.match.group("num")) >= 2
+    child.expect_exact("Sent {} byte".format(NBYTE))
+    print("SUCCESS")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=60))
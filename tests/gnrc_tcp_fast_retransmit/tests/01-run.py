@@ -0,0 +1,62 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2019 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import re
+import socket
+import subprocess
+import sys
+
+from testrunner import run
+
+
+DROPPED_SEGMENTS = 2
+NBYTE = 16 * 1220
+TEST_PATERN_SRV = b"\xa7"
+MAX_RECOVERY_US = 1000000
+
+
+def get_bridge(tap):
+    output = subprocess.check_output(["bridge", "link"]).decode("utf-8")
+    for line in output.splitlines():
+        m = re.search(r"{}.+master\s+(?P<master>[^\s]+)".format(tap), line)
+        if m is not None:
+            return m.group("master")
+    return tap
+
+
+def testfunc(child):
+    tap = get_bridge(os.environ["TAP"])
+
+    child.expect(r"Listening on \[(?P<addr>[0-9a-f:]+)\]:(?P<port>\d+)")
+    addr = child.match.group("addr")
+    port = int(child.match.group("port"))
+
+    sock = socket.socket(socket.AF_INET6, socket.SOCK_STREAM)
+    sock.settimeout(10)
+    sock.connect((addr, port, 0, socket.if_nametoindex(tap)))
+    child.expect_exact("Connected")
+
+    data = b""
+    while True:
+        chunk = sock.recv(4096)
+        if not chunk:
+            break
+        data += chunk
+    sock.close()
+    assert data == TEST_PATERN_SRV * NBYTE
+
+    for _ in range(DROPPED_SEGMENTS):
+        child.expect(r"Retransmitted segment \d+ after (?P<delay>\d+) us")
+        assert int(child.match.group("delay")) < MAX_RECOVERY_US
+    child.expect_exact("Sent {} byte".format(NBYTE))
+    print("SUCCESS")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=30))
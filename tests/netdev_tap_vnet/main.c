@@ -0,0 +1,254 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests the checksum offloading of netdev_tap via virtio-net
+ *              headers
+ *
+ * @author      Martine Lenders <m.lenders@fu-berlin.de>
+ *
+ * @}
+ */
+
+#include <stddef.h>
+#include <string.h>
+
+#include "byteorder.h"
+#include "embUnit.h"
+#include "net/ethernet/hdr.h"
+#include "net/ethertype.h"
+#include "net/inet_csum.h"
+#include "net/ipv6/hdr.h"
+#include "net/protnum.h"
+#include "net/udp.h"
+
+#include "netdev_tap_vnet.h"
+
+#define TEST_PAYLOAD_LEN    (13U)
+#define TEST_UDP_LEN        (sizeof(udp_hdr_t) + TEST_PAYLOAD_LEN)
+#define TEST_CSUM_START     (sizeof(ethernet_hdr_t) + sizeof(ipv6_hdr_t))
+#define TEST_FRAME_LEN      (TEST_CSUM_START + TEST_UDP_LEN)
+#define TEST_CSUM_ORIG      (0x5a5aU)
+
+static const ipv6_addr_t _src = { .u8 = { 0xfe, 0x80, 0, 0, 0, 0, 0, 0,
+                                          0, 0, 0, 0, 0, 0, 0, 1 } };
+
+static ethernet_hdr_t _eth;
+static ipv6_hdr_t _ipv6;
+static udp_hdr_t _udp;
+static uint8_t _payload[TEST_PAYLOAD_LEN];
+/* the frame as the host assembles it from the I/O list */
+static uint8_t _frame[TEST_FRAME_LEN];
+
+static iolist_t _iol_payload = { .iol_base = _payload,
+                                 .iol_len = sizeof(_payload) };
+static iolist_t _iol_udp = { .iol_next = &_iol_payload, .iol_base = &_udp,
+                             .iol_len = sizeof(_udp) };
+static iolist_t _iol_ipv6 = { .iol_next = &_iol_udp, .iol_base = &_ipv6,
+                              .iol_len = sizeof(_ipv6) };
+static iolist_t _iol_eth = { .iol_next = &_iol_ipv6, .iol_base = &_eth,
+                             .iol_len = sizeof(_eth) };
+
+static void set_up(void)
+{
+    memset(&_eth, 0, sizeof(_eth));
+    _eth.type = byteorder_htons(ETHERTYPE_IPV6);
+    memset(&_ipv6, 0, sizeof(_ipv6));
+    ipv6_hdr_set_version(&_ipv6);
+    _ipv6.len = byteorder_htons(TEST_UDP_LEN);
+    _ipv6.nh = PROTNUM_UDP;
+    _ipv6.hl = 64;
+    _ipv6.src = _src;
+    _ipv6.dst = ipv6_addr_all_nodes_link_local;
+    _udp.src_port = byteorder_htons(61616);
+    _udp.dst_port = byteorder_htons(61617);
+    _udp.length = byteorder_htons(TEST_UDP_LEN);
+    _udp.checksum = byteorder_htons(TEST_CSUM_ORIG);
+    for (unsigned i = 0; i < sizeof(_payload); i++) {
+        _payload[i] = i * 7;
+    }
+}
+
+static void _assemble(void)
+{
+    uint8_t *ptr = _frame;
+
+    for (const iolist_t *iol = &_iol_eth; iol != NULL; iol = iol->iol_next) {
+        memcpy(ptr, iol->iol_base, iol->iol_len);
+        ptr += iol->iol_len;
+    }
+}
+
+/* UDP checksum of _frame, calculated with the checksum field set to 0 */
+static uint16_t _udp_csum(void)
+{
+    udp_hdr_t udp;
+    uint16_t csum;
+
+    memcpy(&udp, &_frame[TEST_CSUM_START], sizeof(udp));
+    udp.checksum.u16 = 0;
+    csum = inet_csum(0, (uint8_t *)&udp, sizeof(udp));
+    csum = inet_csum(csum, &_frame[TEST_CSUM_START + sizeof(udp)],
+                     TEST_PAYLOAD_LEN);
+    csum = ipv6_hdr_inet_csum(csum, &_ipv6, PROTNUM_UDP, TEST_UDP_LEN);
+    csum = ~csum;
+    return (csum == 0) ? 0xffff : csum;
+}
+
+static void test_send_csum__udp(void)
+{
+    struct virtio_net_hdr vnet = { .gso_type = VIRTIO_NET_HDR_GSO_NONE };
+    uint16_t orig, csum;
+    uint8_t *field;
+
+    field = netdev_tap_vnet_send_csum(&_iol_eth, &vnet, &orig);
+    TEST_ASSERT(field == (uint8_t *)&_udp.checksum);
+    TEST_ASSERT_EQUAL_INT(TEST_CSUM_ORIG, byteorder_ntohs(
+                              *((network_uint16_t *)&orig)));
+    TEST_ASSERT_EQUAL_INT(VIRTIO_NET_HDR_F_NEEDS_CSUM, vnet.flags);
+    TEST_ASSERT_EQUAL_INT(TEST_CSUM_START, vnet.csum_start);
+    TEST_ASSERT_EQUAL_INT(offsetof(udp_hdr_t, checksum), vnet.csum_offset);
+    /* do what the host does: sum up from csum_start on, the checksum field
+     * contains the pseudo-header checksum */
+    _assemble();
+    csum = ~inet_csum(0, &_frame[vnet.csum_start],
+                      TEST_FRAME_LEN - vnet.csum_start);
+    TEST_ASSERT_EQUAL_INT(_udp_csum(), (csum == 0) ? 0xffff : csum);
+    /* restoring the field is up to the caller, as netdev_tap does */
+    memcpy(field, &orig, sizeof(orig));
+    TEST_ASSERT_EQUAL_INT(TEST_CSUM_ORIG, byteorder_ntohs(_udp.checksum));
+}
+
+static void test_send_csum__no_ipv6(void)
+{
+    struct virtio_net_hdr vnet = { .gso_type = VIRTIO_NET_HDR_GSO_NONE };
+    uint16_t orig;
+
+    _eth.type = byteorder_htons(ETHERTYPE_IPV4);
+    TEST_ASSERT_NULL(netdev_tap_vnet_send_csum(&_iol_eth, &vnet, &orig));
+    TEST_ASSERT_EQUAL_INT(0, vnet.flags);
+    TEST_ASSERT_EQUAL_INT(TEST_CSUM_ORIG, byteorder_ntohs(_udp.checksum));
+}
+
+static void test_send_csum__no_upper_layer_csum(void)
+{
+    struct virtio_net_hdr vnet = { .gso_type = VIRTIO_NET_HDR_GSO_NONE };
+    uint16_t orig;
+
+    _ipv6.nh = PROTNUM_IPV6_NONXT;
+    TEST_ASSERT_NULL(netdev_tap_vnet_send_csum(&_iol_eth, &vnet, &orig));
+    TEST_ASSERT_EQUAL_INT(0, vnet.flags);
+}
+
+static void test_send_csum__split_field(void)
+{
+    struct virtio_net_hdr vnet = { .gso_type = VIRTIO_NET_HDR_GSO_NONE };
+    iolist_t iol_udp2 = { .iol_next = &_iol_payload,
+                          .iol_base = ((uint8_t *)&_udp) + 7,
+                          .iol_len = sizeof(_udp) - 7 };
+    iolist_t iol_udp1 = { .iol_next = &iol_udp2, .iol_base = &_udp,
+                          .iol_len = 7 };
+    iolist_t iol_ipv6 = { .iol_next = &iol_udp1, .iol_base = &_ipv6,
+                          .iol_len = sizeof(_ipv6) };
+    iolist_t iol_eth = { .iol_next = &iol_ipv6, .iol_base = &_eth,
+                         .iol_len = sizeof(_eth) };
+    uint16_t orig;
+
+    TEST_ASSERT_NULL(netdev_tap_vnet_send_csum(&iol_eth, &vnet, &orig));
+    TEST_ASSERT_EQUAL_INT(0, vnet.flags);
+    TEST_ASSERT_EQUAL_INT(TEST_CSUM_ORIG, byteorder_ntohs(_udp.checksum));
+}
+
+static void test_recv_csum__needs_csum(void)
+{
+    struct virtio_net_hdr vnet = {
+        .flags = VIRTIO_NET_HDR_F_NEEDS_CSUM,
+        .csum_start = TEST_CSUM_START,
+        .csum_offset = offsetof(udp_hdr_t, checksum),
+    };
+    netdev_eth_rx_info_t info = { .flags = 0 };
+    struct virtio_net_hdr send_vnet;
+    uint16_t orig;
+
+    /* the host leaves the pseudo-header checksum in the field, just as we
+     * do on send */
+    netdev_tap_vnet_send_csum(&_iol_eth, &send_vnet, &orig);
+    _assemble();
+    netdev_tap_vnet_recv_csum(&vnet, _frame, sizeof(_frame), &info);
+    TEST_ASSERT_EQUAL_INT(NETDEV_ETH_RX_INFO_FLAG_CSUM_VALID, info.flags);
+    TEST_ASSERT_EQUAL_INT(_udp_csum(), byteorder_ntohs(
+                              ((udp_hdr_t *)&_frame[TEST_CSUM_START])->checksum));
+}
+
+static void test_recv_csum__needs_csum_truncated(void)
+{
+    struct virtio_net_hdr vnet = {
+        .flags = VIRTIO_NET_HDR_F_NEEDS_CSUM,
+        .csum_start = TEST_CSUM_START,
+        .csum_offset = offsetof(udp_hdr_t, checksum),
+    };
+    netdev_eth_rx_info_t info = { .flags = 0 };
+
+    _assemble();
+    netdev_tap_vnet_recv_csum(&vnet, _frame, TEST_CSUM_START + 4, &info);
+    TEST_ASSERT_EQUAL_INT(0, info.flags);
+}
+
+static void test_recv_csum__data_valid(void)
+{
+    struct virtio_net_hdr vnet = { .flags = VIRTIO_NET_HDR_F_DATA_VALID };
+    netdev_eth_rx_info_t info = { .flags = 0 };
+
+    _assemble();
+    netdev_tap_vnet_recv_csum(&vnet, _frame, sizeof(_frame), &info);
+    TEST_ASSERT_EQUAL_INT(NETDEV_ETH_RX_INFO_FLAG_CSUM_VALID, info.flags);
+    TEST_ASSERT_EQUAL_INT(TEST_CSUM_ORIG, byteorder_ntohs(
+                              ((udp_hdr_t *)&_frame[TEST_CSUM_START])->checksum));
+    /* without rx info, e.g. when offloading is disabled */
+    netdev_tap_vnet_recv_csum(&vnet, _frame, sizeof(_frame), NULL);
+}
+
+static void test_recv_csum__unverified(void)
+{
+    struct virtio_net_hdr vnet = { .flags = 0 };
+    netdev_eth_rx_info_t info = { .flags = 0 };
+
+    _assemble();
+    netdev_tap_vnet_recv_csum(&vnet, _frame, sizeof(_frame), &info);
+    TEST_ASSERT_EQUAL_INT(0, info.flags);
+}
+
+static Test *tests_netdev_tap_vnet(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_send_csum__udp),
+        new_TestFixture(test_send_csum__no_ipv6),
+        new_TestFixture(test_send_csum__no_upper_layer_csum),
+        new_TestFixture(test_send_csum__split_field),
+        new_TestFixture(test_recv_csum__needs_csum),
+        new_TestFixture(test_recv_csum__needs_csum_truncated),
+        new_TestFixture(test_recv_csum__data_valid),
+        new_TestFixture(test_recv_csum__unverified),
+    };
+
+    EMB_UNIT_TESTCALLER(netdev_tap_vnet_tests, set_up, NULL, fixtures);
+
+    return (Test *)&netdev_tap_vnet_tests;
+}
+
+int main(void)
+{
+    TESTS_START();
+    TESTS_RUN(tests_netdev_tap_vnet());
+    TESTS_END();
+    return 0;
+}
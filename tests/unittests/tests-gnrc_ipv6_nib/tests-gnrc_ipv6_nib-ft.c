@@ -178,6 +178,49 @@ static void test_nib_ft_get__success4(void)
     TEST_ASSERT_EQUAL_INT(IFACE, fte.iface);
 }
 
+/*
+ * Adds routes with nested prefixes of different lengths in mixed order and
+ * removes one in the middle, then tries to get addresses that only match the
+ * first bits of the routes.
+ * Expected result: gnrc_ipv6_nib_ft_get() returns the route with the longest
+ * matching prefix
+ */
+static void test_nib_ft_get__success5(void)
+{
+    static const unsigned dst_lens[] = { 64, 40, 128, 96, 48 };
+    gnrc_ipv6_nib_ft_t fte;
+    /* all bits after the global prefix are set, so a route only matches up
+     * to its prefix length */
+    ipv6_addr_t dst = { .u64 = { { .u8 = GLOBAL_PREFIX },
+                                 { .u64 = UINT64_MAX } } };
+    static const ipv6_addr_t next_hop = { .u64 = { { .u8 = LINK_LOCAL_PREFIX },
+                                                 { .u64 = TEST_UINT64 } } };
+
+    memset(&dst.u8[4], 0xff, 4);
+    for (unsigned i = 0; i < (sizeof(dst_lens) / sizeof(dst_lens[0])); i++) {
+        TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_ft_add(&dst, dst_lens[i],
+                                                      &next_hop, IFACE, 0));
+    }
+    for (unsigned i = 0; i < (sizeof(dst_lens) / sizeof(dst_lens[0])); i++) {
+        ipv6_addr_t addr = dst;
+
+        if (dst_lens[i] < 128) {
+            bf_toggle(addr.u8, dst_lens[i]);
+        }
+        TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_ft_get(&addr, NULL, &fte));
+        TEST_ASSERT_EQUAL_INT(dst_lens[i], fte.dst_len);
+        TEST_ASSERT(ipv6_addr_match_prefix(&addr, &fte.dst) >= fte.dst_len);
+        TEST_ASSERT(ipv6_addr_equal(&next_hop, &fte.next_hop));
+    }
+    gnrc_ipv6_nib_ft_del(&dst, 64);
+    bf_toggle(dst.u8, 64);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_ft_get(&dst, NULL, &fte));
+    TEST_ASSERT_EQUAL_INT(48, fte.dst_len);
+    bf_toggle(dst.u8, 64);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_ft_get(&dst, NULL, &fte));
+    TEST_ASSERT_EQUAL_INT(128, fte.dst_len);
+}
+
 /*
  * Tries to create a forwarding table entry for the default route (::) with
  * NULL as next hop.
@@ -727,6 +770,7 @@ Test *tests_gnrc_ipv6_nib_ft_tests(void)
         new_TestFixture(test_nib_ft_get__success2),
         new_TestFixture(test_nib_ft_get__success3),
         new_TestFixture(test_nib_ft_get__success4),
+        new_TestFixture(test_nib_ft_get__success5),
         new_TestFixture(test_nib_ft_add__EINVAL_def_route_next_hop_NULL),
         new_TestFixture(test_nib_ft_add__EINVAL_iface0),
         new_TestFixture(test_nib_ft_add__ENOMEM_diff_def_router),
@@ -497,6 +497,47 @@ static void test_nib_nc_add__success_full_but_garbage_collectible(void)
     }
 }
 
+/*
+ * Creates GNRC_IPV6_NIB_NUMOF neighbor cache entries with different IP
+ * addresses, looks up the first one and then adds another one.
+ * Expected result: the first entry is replaced, unless
+ * GNRC_IPV6_NIB_CONF_HASHED != 0. In that case the looked up entry is spared
+ * and the second one is replaced
+ */
+static void test_nib_nc_add__cache_out_used(void)
+{
+    _nib_onl_entry_t *first = NULL, *second = NULL, *node;
+    ipv6_addr_t addr = { .u64 = { { .u8 = GLOBAL_PREFIX },
+                                  { .u64 = TEST_UINT64 } } };
+    ipv6_addr_t first_addr;
+
+    for (int i = 0; i < GNRC_IPV6_NIB_NUMOF; i++) {
+        TEST_ASSERT_NOT_NULL((node = _nib_nc_add(&addr, IFACE,
+                                                 GNRC_IPV6_NIB_NC_INFO_NUD_STATE_STALE)));
+        if (i == 0) {
+            first = node;
+            first_addr = addr;
+        }
+        else if (i == 1) {
+            second = node;
+        }
+        addr.u64[1].u64++;
+    }
+    TEST_ASSERT(first == _nib_onl_get(&first_addr, IFACE));
+    TEST_ASSERT_NOT_NULL((node = _nib_nc_add(&addr, IFACE,
+                                             GNRC_IPV6_NIB_NC_INFO_NUD_STATE_STALE)));
+    TEST_ASSERT(ipv6_addr_equal(&addr, &node->ipv6));
+#if GNRC_IPV6_NIB_CONF_HASHED
+    TEST_ASSERT(second == node);
+    TEST_ASSERT(first == _nib_onl_get(&first_addr, IFACE));
+#else
+    (void)second;
+    TEST_ASSERT(first == node);
+    TEST_ASSERT_NULL(_nib_onl_get(&first_addr, IFACE));
+#endif
+    TEST_ASSERT(node == _nib_onl_get(&addr, IFACE));
+}
+
 /*
  * Creates GNRC_IPV6_NIB_NUMOF neighbor cache entries with different IP
  * addresses and a garbage-collectible AR state and then tries to add
@@ -1948,6 +1989,51 @@ static void test_nib_abr_iter__three_elem_middle_removed(void)
 }
 #endif
 
+#if GNRC_IPV6_NIB_CONF_DCACHE
+/*
+ * Adds a destination cache entry and looks it up again, both via the same and
+ * via another requested interface.
+ * Expected result: only the lookup with the same requested interface returns
+ * the entry with the given values
+ */
+static void test_nib_dcache_add__success(void)
+{
+    _nib_dcache_entry_t *entry;
+    static const ipv6_addr_t next_hop = { .u64 = { { .u8 = LINK_LOCAL_PREFIX },
+                                                 { .u64 = TEST_UINT64 } } };
+    static const ipv6_addr_t dst = { .u64 = { { .u8 = GLOBAL_PREFIX },
+                                            { .u64 = TEST_UINT64 } } };
+
+    TEST_ASSERT_NULL(_nib_dcache_get(&dst, 0));
+    _nib_dcache_add(&dst, 0, IFACE, &next_hop, GLOBAL_PREFIX_LEN);
+    TEST_ASSERT_NULL(_nib_dcache_get(&dst, IFACE));
+    TEST_ASSERT_NOT_NULL((entry = _nib_dcache_get(&dst, 0)));
+    TEST_ASSERT(ipv6_addr_equal(&dst, &entry->dst));
+    TEST_ASSERT(ipv6_addr_equal(&next_hop, &entry->next_hop));
+    TEST_ASSERT(ipv6_addr_is_unspecified(&entry->src));
+    TEST_ASSERT_EQUAL_INT(IFACE, entry->iface);
+    TEST_ASSERT_EQUAL_INT(GLOBAL_PREFIX_LEN, entry->route_len);
+}
+
+/*
+ * Adds a destination cache entry and changes the NIB by adding a route.
+ * Expected result: the destination cache entry is not found anymore
+ */
+static void test_nib_dcache_get__invalidated(void)
+{
+    static const ipv6_addr_t next_hop = { .u64 = { { .u8 = LINK_LOCAL_PREFIX },
+                                                 { .u64 = TEST_UINT64 } } };
+    static const ipv6_addr_t dst = { .u64 = { { .u8 = GLOBAL_PREFIX },
+                                            { .u64 = TEST_UINT64 } } };
+
+    _nib_dcache_add(&dst, 0, IFACE, &next_hop, GLOBAL_PREFIX_LEN);
+    TEST_ASSERT_NOT_NULL(_nib_dcache_get(&dst, 0));
+    TEST_ASSERT_NOT_NULL(_nib_ft_add(&next_hop, IFACE, &dst,
+                                     GLOBAL_PREFIX_LEN));
+    TEST_ASSERT_NULL(_nib_dcache_get(&dst, 0));
+}
+#endif
+
 static void test_retrans_exp_backoff(void)
 {
     TEST_ASSERT_EQUAL_INT(0,
@@ -2026,6 +2112,7 @@ Test *tests_gnrc_ipv6_nib_internal_tests(void)
         new_TestFixture(test_nib_nc_add__success_duplicate),
         new_TestFixture(test_nib_nc_add__success),
         new_TestFixture(test_nib_nc_add__success_full_but_garbage_collectible),
+        new_TestFixture(test_nib_nc_add__cache_out_used),
         new_TestFixture(test_nib_nc_add__cache_out_crash),
         new_TestFixture(test_nib_nc_remove__uncleared),
         new_TestFixture(test_nib_nc_remove__cleared),
@@ -2098,6 +2185,10 @@ Test *tests_gnrc_ipv6_nib_internal_tests(void)
         new_TestFixture(test_nib_abr_iter__one_elem),
         new_TestFixture(test_nib_abr_iter__three_elem),
         new_TestFixture(test_nib_abr_iter__three_elem_middle_removed),
+#endif
+#if GNRC_IPV6_NIB_CONF_DCACHE
+        new_TestFixture(test_nib_dcache_add__success),
+        new_TestFixture(test_nib_dcache_get__invalidated),
 #endif
         new_TestFixture(test_retrans_exp_backoff),
     };
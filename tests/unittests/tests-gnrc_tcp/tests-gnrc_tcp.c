@@ -0,0 +1,315 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <errno.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "net/gnrc.h"
+#include "net/gnrc/tcp.h"
+#include "net/ipv6/hdr.h"
+#include "net/tcp.h"
+
+#include "internal/common.h"
+#include "internal/fsm.h"
+#include "internal/option.h"
+#include "internal/pkt.h"
+#include "internal/rcvbuf.h"
+
+#include "tests-gnrc_tcp.h"
+
+#define TEST_SEQ        (0x10000000U)
+#define TEST_ACK        (0x20000000U)
+
+#define TEST_TCBS_NUMOF (RCVBUF_BLOCKS + 1)
+
+static gnrc_tcp_tcb_t _tcbs[TEST_TCBS_NUMOF];
+
+/* TCP header followed by a window scale option */
+static union {
+    tcp_hdr_t hdr;
+    uint8_t raw[sizeof(tcp_hdr_t) + sizeof(uint32_t)];
+} _syn;
+
+static void set_up(void)
+{
+    for (unsigned i = 0; i < TEST_TCBS_NUMOF; i++) {
+        gnrc_tcp_tcb_init(&_tcbs[i]);
+    }
+}
+
+static void tear_down(void)
+{
+    for (unsigned i = 0; i < TEST_TCBS_NUMOF; i++) {
+        _rcvbuf_release_buffer(&_tcbs[i]);
+    }
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void _init_syn(uint16_t ctl, uint8_t len, uint8_t shift)
+{
+    uint8_t *opt = _syn.raw + sizeof(tcp_hdr_t);
+
+    memset(&_syn, 0, sizeof(_syn));
+    _syn.hdr.off_ctl = byteorder_htons(_option_build_offset_control(TCP_HDR_OFFSET_MIN + 1,
+                                                                    ctl));
+    opt[0] = TCP_OPTION_KIND_NOP;
+    opt[1] = TCP_OPTION_KIND_WND_SCALE;
+    opt[2] = len;
+    opt[3] = shift;
+}
+
+static void test_gnrc_tcp__rcvbuf_exhausted(void)
+{
+    unsigned i;
+
+    /* The pool holds GNRC_TCP_RCV_BUFFERS default sized buffers */
+    for (i = 0; i < GNRC_TCP_RCV_BUFFERS; i++) {
+        TEST_ASSERT_EQUAL_INT(0, _rcvbuf_get_buffer(&_tcbs[i]));
+        TEST_ASSERT_NOT_NULL(_tcbs[i].rcv_buf_raw);
+        TEST_ASSERT_EQUAL_INT(GNRC_TCP_RCV_BUF_SIZE, _tcbs[i].rcv_buf.size);
+    }
+    TEST_ASSERT_EQUAL_INT(-ENOMEM, _rcvbuf_get_buffer(&_tcbs[i]));
+    TEST_ASSERT_NULL(_tcbs[i].rcv_buf_raw);
+}
+
+static void test_gnrc_tcp__rcvbuf_release(void)
+{
+    uint8_t *buf;
+
+    for (unsigned i = 0; i < GNRC_TCP_RCV_BUFFERS; i++) {
+        TEST_ASSERT_EQUAL_INT(0, _rcvbuf_get_buffer(&_tcbs[i]));
+    }
+    /* A released buffer is handed out again */
+    buf = _tcbs[1].rcv_buf_raw;
+    _rcvbuf_release_buffer(&_tcbs[1]);
+    TEST_ASSERT_NULL(_tcbs[1].rcv_buf_raw);
+    TEST_ASSERT_EQUAL_INT(0, _rcvbuf_get_buffer(&_tcbs[GNRC_TCP_RCV_BUFFERS]));
+    TEST_ASSERT(buf == _tcbs[GNRC_TCP_RCV_BUFFERS].rcv_buf_raw);
+    /* Releasing a TCB without buffer does nothing */
+    _rcvbuf_release_buffer(&_tcbs[1]);
+    TEST_ASSERT_EQUAL_INT(-ENOMEM, _rcvbuf_get_buffer(&_tcbs[1]));
+}
+
+static void test_gnrc_tcp__rcvbuf_largest_free(void)
+{
+    /* Occupy the second block, so the largest free area is behind it */
+    TEST_ASSERT_EQUAL_INT(0, _rcvbuf_get_buffer(&_tcbs[0]));
+    TEST_ASSERT_EQUAL_INT(0, _rcvbuf_get_buffer(&_tcbs[1]));
+    _rcvbuf_release_buffer(&_tcbs[0]);
+
+    /* Less than requested is free in one piece: The largest free area is allocated */
+    _tcbs[2].rcv_buf_size = GNRC_TCP_RCV_BUF_POOL_SIZE;
+    TEST_ASSERT_EQUAL_INT(0, _rcvbuf_get_buffer(&_tcbs[2]));
+    TEST_ASSERT_EQUAL_INT((RCVBUF_BLOCKS - 2) * GNRC_TCP_RCV_BUF_BLOCK_SIZE,
+                          _tcbs[2].rcv_buf.size);
+
+    /* The first block is left */
+    _tcbs[3].rcv_buf_size = GNRC_TCP_RCV_BUF_POOL_SIZE;
+    TEST_ASSERT_EQUAL_INT(0, _rcvbuf_get_buffer(&_tcbs[3]));
+    TEST_ASSERT_EQUAL_INT(GNRC_TCP_RCV_BUF_BLOCK_SIZE, _tcbs[3].rcv_buf.size);
+    TEST_ASSERT_EQUAL_INT(-ENOMEM, _rcvbuf_get_buffer(&_tcbs[0]));
+
+    /* Released areas are merged again */
+    _rcvbuf_release_buffer(&_tcbs[1]);
+    _rcvbuf_release_buffer(&_tcbs[2]);
+    _rcvbuf_release_buffer(&_tcbs[3]);
+    _tcbs[0].rcv_buf_size = GNRC_TCP_RCV_BUF_POOL_SIZE;
+    TEST_ASSERT_EQUAL_INT(0, _rcvbuf_get_buffer(&_tcbs[0]));
+    TEST_ASSERT_EQUAL_INT(GNRC_TCP_RCV_BUF_POOL_SIZE, _tcbs[0].rcv_buf.size);
+}
+
+static void test_gnrc_tcp__rcvbuf_round_up(void)
+{
+    /* Buffers are allocated in whole blocks */
+    _tcbs[0].rcv_buf_size = GNRC_TCP_RCV_BUF_BLOCK_SIZE + 1;
+    TEST_ASSERT_EQUAL_INT(0, _rcvbuf_get_buffer(&_tcbs[0]));
+    TEST_ASSERT_EQUAL_INT(2 * GNRC_TCP_RCV_BUF_BLOCK_SIZE, _tcbs[0].rcv_buf.size);
+}
+
+static void test_gnrc_tcp__wnd_scale_shift_count(void)
+{
+    gnrc_tcp_tcb_t *tcb = &_tcbs[0];
+
+    tcb->rcv_buf.size = UINT16_MAX;
+    TEST_ASSERT_EQUAL_INT(0, _rcvbuf_get_wnd_scale(tcb));
+    tcb->rcv_buf.size = UINT16_MAX + 1;
+    TEST_ASSERT_EQUAL_INT(1, _rcvbuf_get_wnd_scale(tcb));
+    tcb->rcv_buf.size = 1UL << 20;
+    TEST_ASSERT_EQUAL_INT(5, _rcvbuf_get_wnd_scale(tcb));
+    tcb->rcv_buf.size = UINT32_MAX;
+    TEST_ASSERT_EQUAL_INT(WND_SCALE_MAX, _rcvbuf_get_wnd_scale(tcb));
+    tcb->rcv_buf.size = 0;
+}
+
+static void test_gnrc_tcp__wnd_scale_negotiate(void)
+{
+    gnrc_tcp_tcb_t *tcb = &_tcbs[0];
+
+    tcb->state = FSM_STATE_LISTEN;
+    tcb->rcv_buf.size = 1UL << 20;
+    _init_syn(MSK_SYN, TCP_OPTION_LENGTH_WND_SCALE, 7);
+    TEST_ASSERT_EQUAL_INT(0, _option_parse(tcb, &_syn.hdr));
+    TEST_ASSERT(tcb->status & STATUS_WND_SCALE);
+    TEST_ASSERT_EQUAL_INT(7, tcb->snd_wnd_scale);
+    TEST_ASSERT_EQUAL_INT(5, tcb->rcv_wnd_scale);
+
+    /* Shift counts above 14 are treated as 14 */
+    tcb->state = FSM_STATE_SYN_SENT;
+    _init_syn(MSK_SYN_ACK, TCP_OPTION_LENGTH_WND_SCALE, 15);
+    TEST_ASSERT_EQUAL_INT(0, _option_parse(tcb, &_syn.hdr));
+    TEST_ASSERT_EQUAL_INT(WND_SCALE_MAX, tcb->snd_wnd_scale);
+
+    /* The option is ignored outside of the connection setup */
+    tcb->state = FSM_STATE_ESTABLISHED;
+    _init_syn(MSK_ACK, TCP_OPTION_LENGTH_WND_SCALE, 3);
+    TEST_ASSERT_EQUAL_INT(0, _option_parse(tcb, &_syn.hdr));
+    TEST_ASSERT_EQUAL_INT(WND_SCALE_MAX, tcb->snd_wnd_scale);
+
+    /* A SYN without the option disables window scaling on both sides */
+    tcb->state = FSM_STATE_LISTEN;
+    _init_syn(MSK_SYN, TCP_OPTION_LENGTH_WND_SCALE, 0);
+    _syn.hdr.off_ctl = byteorder_htons(_option_build_offset_control(TCP_HDR_OFFSET_MIN,
+                                                                    MSK_SYN));
+    TEST_ASSERT_EQUAL_INT(0, _option_parse(tcb, &_syn.hdr));
+    TEST_ASSERT(!(tcb->status & STATUS_WND_SCALE));
+    TEST_ASSERT_EQUAL_INT(0, tcb->snd_wnd_scale);
+    TEST_ASSERT_EQUAL_INT(0, tcb->rcv_wnd_scale);
+
+    /* Malformed option */
+    _init_syn(MSK_SYN, TCP_OPTION_LENGTH_WND_SCALE + 1, 7);
+    TEST_ASSERT_EQUAL_INT(-1, _option_parse(tcb, &_syn.hdr));
+    tcb->rcv_buf.size = 0;
+}
+
+static void test_gnrc_tcp__option_length(void)
+{
+    gnrc_tcp_tcb_t *tcb = &_tcbs[0];
+    uint8_t *opt = _syn.raw + sizeof(tcp_hdr_t);
+
+    tcb->state = FSM_STATE_ESTABLISHED;
+    tcb->status |= STATUS_SACK_PERMITTED;
+    /* SACK option running past the end of the header */
+    _init_syn(MSK_ACK, 2 + TCP_OPTION_LENGTH_SACK_BLOCK, 0);
+    opt[1] = TCP_OPTION_KIND_SACK;
+    TEST_ASSERT_EQUAL_INT(-1, _option_parse(tcb, &_syn.hdr));
+
+    /* Options without space for their length field */
+    _init_syn(MSK_ACK, TCP_OPTION_KIND_NOP, TCP_OPTION_KIND_NOP);
+    opt[1] = TCP_OPTION_KIND_NOP;
+    opt[3] = TCP_OPTION_KIND_MSS;
+    TEST_ASSERT_EQUAL_INT(-1, _option_parse(tcb, &_syn.hdr));
+
+    /* Unknown options with a length too short to make progress */
+    _init_syn(MSK_ACK, 0, 0);
+    opt[1] = 0xff;
+    TEST_ASSERT_EQUAL_INT(-1, _option_parse(tcb, &_syn.hdr));
+    tcb->status &= ~STATUS_SACK_PERMITTED;
+}
+
+static void test_gnrc_tcp__wnd_scale_announce(void)
+{
+    gnrc_tcp_tcb_t *tcb = &_tcbs[0];
+    gnrc_pktsnip_t *pkt = NULL, *tcp;
+    uint16_t seq_con = 0;
+    tcp_hdr_t *hdr;
+    uint8_t *opt;
+
+    tcb->rcv_buf.size = 1UL << 20;
+    tcb->rcv_wnd = 0x40000;
+    tcb->rcv_wnd_scale = 3;
+    tcb->status |= STATUS_WND_SCALE;
+
+    /* The window of a SYN is not scaled and it carries our shift count */
+    TEST_ASSERT_EQUAL_INT(0, _pkt_build(tcb, &pkt, &seq_con, MSK_SYN, TEST_SEQ, 0,
+                                        NULL, 0));
+    TEST_ASSERT_NOT_NULL((tcp = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_TCP)));
+    hdr = tcp->data;
+    TEST_ASSERT_EQUAL_INT(UINT16_MAX, byteorder_ntohs(hdr->window));
+    opt = (uint8_t *)(hdr + 1);
+    for (; opt < (uint8_t *)tcp->data + tcp->size; opt++) {
+        if (opt[0] == TCP_OPTION_KIND_WND_SCALE) {
+            break;
+        }
+    }
+    TEST_ASSERT(opt < (uint8_t *)tcp->data + tcp->size);
+    TEST_ASSERT_EQUAL_INT(TCP_OPTION_LENGTH_WND_SCALE, opt[1]);
+    TEST_ASSERT_EQUAL_INT(5, opt[2]);
+    gnrc_pktbuf_release(pkt);
+
+    /* Other segments announce the scaled window */
+    TEST_ASSERT_EQUAL_INT(0, _pkt_build(tcb, &pkt, &seq_con, MSK_ACK, TEST_SEQ, TEST_ACK,
+                                        NULL, 0));
+    TEST_ASSERT_NOT_NULL((tcp = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_TCP)));
+    hdr = tcp->data;
+    TEST_ASSERT_EQUAL_INT(0x40000 >> 3, byteorder_ntohs(hdr->window));
+    gnrc_pktbuf_release(pkt);
+    tcb->rcv_buf.size = 0;
+}
+
+static void test_gnrc_tcp__wnd_scale_apply(void)
+{
+    gnrc_tcp_tcb_t *tcb = &_tcbs[0];
+    ipv6_hdr_t ipv6_hdr;
+    gnrc_pktsnip_t ipv6 = { .type = GNRC_NETTYPE_IPV6, .data = &ipv6_hdr,
+                            .size = sizeof(ipv6_hdr), .users = 1 };
+    gnrc_pktsnip_t tcp = { .type = GNRC_NETTYPE_TCP, .data = &_syn.hdr,
+                           .size = sizeof(tcp_hdr_t), .next = &ipv6, .users = 1 };
+
+    memset(&ipv6_hdr, 0, sizeof(ipv6_hdr));
+    tcb->state = FSM_STATE_ESTABLISHED;
+    tcb->snd_una = TEST_SEQ;
+    tcb->snd_nxt = TEST_SEQ;
+    tcb->rcv_nxt = TEST_ACK;
+    tcb->rcv_wnd = GNRC_TCP_DEFAULT_WINDOW;
+    tcb->snd_wl1 = TEST_ACK - 1;
+    tcb->snd_wl2 = TEST_SEQ;
+    tcb->snd_wnd_scale = 4;
+
+    /* The window announced by the peer is shifted by its shift count */
+    memset(&_syn, 0, sizeof(_syn));
+    _syn.hdr.off_ctl = byteorder_htons(_option_build_offset_control(TCP_HDR_OFFSET_MIN,
+                                                                    MSK_ACK));
+    _syn.hdr.seq_num = byteorder_htonl(TEST_ACK);
+    _syn.hdr.ack_num = byteorder_htonl(TEST_SEQ);
+    _syn.hdr.window = byteorder_htons(1000);
+    TEST_ASSERT_EQUAL_INT(0, _fsm(tcb, FSM_EVENT_RCVD_PKT, &tcp, NULL, 0));
+    TEST_ASSERT_EQUAL_INT(FSM_STATE_ESTABLISHED, tcb->state);
+    TEST_ASSERT_EQUAL_INT(1000 << 4, tcb->snd_wnd);
+}
+
+Test *tests_gnrc_tcp_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_gnrc_tcp__rcvbuf_exhausted),
+        new_TestFixture(test_gnrc_tcp__rcvbuf_release),
+        new_TestFixture(test_gnrc_tcp__rcvbuf_largest_free),
+        new_TestFixture(test_gnrc_tcp__rcvbuf_round_up),
+        new_TestFixture(test_gnrc_tcp__wnd_scale_shift_count),
+        new_TestFixture(test_gnrc_tcp__wnd_scale_negotiate),
+        new_TestFixture(test_gnrc_tcp__option_length),
+        new_TestFixture(test_gnrc_tcp__wnd_scale_announce),
+        new_TestFixture(test_gnrc_tcp__wnd_scale_apply),
+    };
+
+    EMB_UNIT_TESTCALLER(gnrc_tcp_tests, set_up, tear_down, fixtures);
+
+    return (Test *)&gnrc_tcp_tests;
+}
+
+void tests_gnrc_tcp(void)
+{
+    TESTS_RUN(tests_gnrc_tcp_tests());
+}
+/** @} */
@@ -13,6 +13,7 @@
  */
 #include <errno.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "embUnit.h"
 
@@ -165,6 +166,93 @@ static void test_inet_csum__empty_app_buffer(void)
     TEST_ASSERT_EQUAL_INT(hdr_expected, pyld_sum);
 }
 
+/* reference: sum up one 16-bit word in network byte order per step */
+static uint16_t _ref_csum(uint16_t sum, const uint8_t *buf, size_t len)
+{
+    uint32_t csum = sum;
+
+    for (size_t i = 0; i < len; i++) {
+        csum += (i & 1) ? buf[i] : (uint16_t)(buf[i] << 8);
+    }
+    while (csum >> 16) {
+        csum = (csum & 0xffff) + (csum >> 16);
+    }
+    return csum;
+}
+
+static void _fill(uint8_t *buf, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        /* keep it dense in ones to provoke carries */
+        buf[i] = (uint8_t)(0xff - (i * 7));
+    }
+}
+
+static void test_inet_csum__all_alignments(void)
+{
+    uint8_t data[80];
+
+    _fill(data, sizeof(data));
+    for (unsigned offset = 0; offset < 8; offset++) {
+        for (unsigned len = 0; len <= (sizeof(data) - offset); len++) {
+            TEST_ASSERT_EQUAL_INT(_ref_csum(0xf00f, &data[offset], len),
+                                  inet_csum(0xf00f, &data[offset], len));
+        }
+    }
+}
+
+static void test_inet_csum__slices_all_alignments(void)
+{
+    uint8_t data[64];
+    uint16_t expected;
+
+    _fill(data, sizeof(data));
+    expected = _ref_csum(0, data, sizeof(data));
+    for (unsigned split = 0; split <= sizeof(data); split++) {
+        uint16_t sum = inet_csum_slice(0, data, split, 0);
+
+        sum = inet_csum_slice(sum, &data[split], sizeof(data) - split, split);
+        TEST_ASSERT_EQUAL_INT(expected, sum);
+    }
+}
+
+static void test_inet_csum_copy__all_alignments(void)
+{
+    uint8_t src[72], dst[72];
+
+    _fill(src, sizeof(src));
+    for (unsigned src_off = 0; src_off < 8; src_off++) {
+        for (unsigned dst_off = 0; dst_off < 8; dst_off++) {
+            size_t len = sizeof(src) - 8;
+
+            memset(dst, 0, sizeof(dst));
+            TEST_ASSERT_EQUAL_INT(_ref_csum(0, &src[src_off], len),
+                                  inet_csum_copy(0, &dst[dst_off],
+                                                 &src[src_off], len, 0));
+            TEST_ASSERT_EQUAL_INT(0, memcmp(&dst[dst_off], &src[src_off], len));
+            /* nothing was written outside of the destination */
+            for (unsigned i = 0; i < dst_off; i++) {
+                TEST_ASSERT_EQUAL_INT(0, dst[i]);
+            }
+            for (unsigned i = dst_off + len; i < sizeof(dst); i++) {
+                TEST_ASSERT_EQUAL_INT(0, dst[i]);
+            }
+        }
+    }
+}
+
+static void test_inet_csum_copy__odd_accum_len(void)
+{
+    uint8_t src[33], dst[33];
+    uint16_t sum;
+
+    _fill(src, sizeof(src));
+    sum = inet_csum_copy(0, dst, src, 5, 0);
+    sum = inet_csum_copy(sum, &dst[5], &src[5], sizeof(src) - 5, 5);
+    TEST_ASSERT_EQUAL_INT(_ref_csum(0, src, sizeof(src)), sum);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(dst, src, sizeof(src)));
+}
+
 Test *tests_inet_csum_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -176,6 +264,10 @@ Test *tests_inet_csum_tests(void)
         new_TestFixture(test_inet_csum__odd_len),
         new_TestFixture(test_inet_csum__two_app_snips),
         new_TestFixture(test_inet_csum__empty_app_buffer),
+        new_TestFixture(test_inet_csum__all_alignments),
+        new_TestFixture(test_inet_csum__slices_all_alignments),
+        new_TestFixture(test_inet_csum_copy__all_alignments),
+        new_TestFixture(test_inet_csum_copy__odd_accum_len),
     };
 
     EMB_UNIT_TESTCALLER(inet_csum_tests, NULL, NULL, fixtures);
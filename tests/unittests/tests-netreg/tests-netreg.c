@@ -12,8 +12,10 @@
  * @file
  */
 #include <errno.h>
+#include <stdio.h>
 
 #include "embUnit.h"
+#include "xtimer.h"
 
 #include "net/gnrc/netreg.h"
 #include "net/gnrc/nettype.h"
@@ -26,6 +28,11 @@ static gnrc_netreg_entry_t entries[] = {
     GNRC_NETREG_ENTRY_INIT_PID(TEST_UINT16, TEST_UINT8 + 1)
 };
 
+#define BENCH_ENTRIES       (64U)
+#define BENCH_LOOKUPS       (10000U)
+
+static gnrc_netreg_entry_t bench_entries[BENCH_ENTRIES];
+
 static void set_up(void)
 {
     gnrc_netreg_init();
@@ -139,6 +146,52 @@ void test_netreg_getnext__2_entries(void)
     TEST_ASSERT_NOT_NULL(gnrc_netreg_getnext(res));
 }
 
+void test_netreg_getnext__other_ctx(void)
+{
+    gnrc_netreg_entry_t other = GNRC_NETREG_ENTRY_INIT_PID(TEST_UINT16 + 1,
+                                                           TEST_UINT8);
+    gnrc_netreg_entry_t *res = NULL;
+
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST, &entries[0]));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST, &other));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST, &entries[1]));
+    TEST_ASSERT_EQUAL_INT(2, gnrc_netreg_num(GNRC_NETTYPE_TEST, TEST_UINT16));
+    TEST_ASSERT_EQUAL_INT(1, gnrc_netreg_num(GNRC_NETTYPE_TEST, TEST_UINT16 + 1));
+    TEST_ASSERT_NOT_NULL((res = gnrc_netreg_lookup(GNRC_NETTYPE_TEST, TEST_UINT16)));
+    TEST_ASSERT(res == &entries[1]);
+    TEST_ASSERT_NOT_NULL((res = gnrc_netreg_getnext(res)));
+    TEST_ASSERT(res == &entries[0]);
+    TEST_ASSERT_NULL(gnrc_netreg_getnext(res));
+    TEST_ASSERT((res = gnrc_netreg_lookup(GNRC_NETTYPE_TEST, TEST_UINT16 + 1)) == &other);
+    TEST_ASSERT_NULL(gnrc_netreg_getnext(res));
+}
+
+void test_netreg_lookup__bench(void)
+{
+    uint32_t start, time;
+    unsigned found = 0;
+
+    for (unsigned i = 0; i < BENCH_ENTRIES; i++) {
+        /* spread like bound UDP ports */
+        gnrc_netreg_entry_init_pid(&bench_entries[i], TEST_UINT16 + (i * 7),
+                                   TEST_UINT8);
+        TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST,
+                                                      &bench_entries[i]));
+    }
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < BENCH_LOOKUPS; i++) {
+        uint32_t demux_ctx = TEST_UINT16 + ((i % BENCH_ENTRIES) * 7);
+
+        if (gnrc_netreg_lookup(GNRC_NETTYPE_TEST, demux_ctx) != NULL) {
+            found++;
+        }
+    }
+    time = xtimer_now_usec() - start;
+    TEST_ASSERT_EQUAL_INT(BENCH_LOOKUPS, found);
+    printf("\nnetreg: %u lookups in %u entries took %" PRIu32 " us\n",
+           BENCH_LOOKUPS, BENCH_ENTRIES, time);
+}
+
 Test *tests_netreg_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -155,6 +208,8 @@ Test *tests_netreg_tests(void)
         new_TestFixture(test_netreg_num__2_entries),
         new_TestFixture(test_netreg_getnext__NULL),
         new_TestFixture(test_netreg_getnext__2_entries),
+        new_TestFixture(test_netreg_getnext__other_ctx),
+        new_TestFixture(test_netreg_lookup__bench),
     };
 
     EMB_UNIT_TESTCALLER(netreg_tests, set_up, NULL, fixtures);
@@ -202,6 +202,7 @@ static void test_pktbuf_add__memfull(void)
 }
 #endif
 
+#ifndef MODULE_GNRC_PKTBUF_SLAB     /* GNRC_PKTBUF_SIZE does not apply for gnrc_pktbuf_slab */
 static void test_pktbuf_add__success(void)
 {
     gnrc_pktsnip_t *pkt, *pkt_prev = NULL;
@@ -225,6 +226,7 @@ static void test_pktbuf_add__success(void)
     }
     TEST_ASSERT(gnrc_pktbuf_is_sane());
 }
+#endif
 
 static void test_pktbuf_add__packed_struct(void)
 {
@@ -245,7 +247,8 @@ static void test_pktbuf_add__packed_struct(void)
     TEST_ASSERT_EQUAL_INT(data.s64, data_cpy->s64);
 }
 
-#ifndef MODULE_GNRC_PKTBUF_MALLOC   /* alignment-handling left to malloc, so no certainty here */
+/* alignment-handling left to malloc or size classes, so no certainty here */
+#if !defined(MODULE_GNRC_PKTBUF_MALLOC) && !defined(MODULE_GNRC_PKTBUF_SLAB)
 static void test_pktbuf_add__unaligned_in_aligned_hole(void)
 {
     gnrc_pktsnip_t *pkt1 = gnrc_pktbuf_add(NULL, NULL, 8, GNRC_NETTYPE_TEST);
@@ -266,6 +269,27 @@ static void test_pktbuf_add__unaligned_in_aligned_hole(void)
 }
 #endif
 
+#ifdef MODULE_GNRC_PKTBUF_SLAB
+static void test_pktbuf_add__slab_class_exhausted(void)
+{
+    gnrc_pktsnip_t *pkt = NULL;
+
+    /* exhaust smallest size class */
+    for (unsigned i = 0; i < GNRC_PKTBUF_SLAB_CLASS0_NUMOF; i++) {
+        pkt = gnrc_pktbuf_add(pkt, NULL, GNRC_PKTBUF_SLAB_CLASS0_SIZE,
+                              GNRC_NETTYPE_TEST);
+        TEST_ASSERT_NOT_NULL(pkt);
+    }
+    /* next allocation falls back to a larger class */
+    pkt = gnrc_pktbuf_add(pkt, NULL, 1, GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT_NOT_NULL(pkt->data);
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+#endif
+
 static void test_pktbuf_add__0_sized_release(void)
 {
     gnrc_pktsnip_t *pkt1 = gnrc_pktbuf_add(NULL, NULL, 0, GNRC_NETTYPE_TEST);
@@ -653,7 +677,7 @@ static void test_pktbuf_realloc_data__success3(void)
     TEST_ASSERT(gnrc_pktbuf_is_empty());
 }
 
-#ifndef MODULE_GNRC_PKTBUF_MALLOC
+#if !defined(MODULE_GNRC_PKTBUF_MALLOC) && !defined(MODULE_GNRC_PKTBUF_SLAB)
 static void test_pktbuf_merge_data__memfull(void)
 {
     gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, NULL, (GNRC_PKTBUF_SIZE / 4),
@@ -813,7 +837,7 @@ static void test_pktbuf_start_write__pkt_users_2(void)
     TEST_ASSERT(gnrc_pktbuf_is_empty());
 }
 
-#ifndef MODULE_GNRC_PKTBUF_MALLOC
+#if !defined(MODULE_GNRC_PKTBUF_MALLOC) && !defined(MODULE_GNRC_PKTBUF_SLAB)
 static void test_pktbuf_reverse_snips__too_full(void)
 {
     gnrc_pktsnip_t *pkt, *pkt_next, *pkt_huge;
@@ -852,6 +876,37 @@ static void test_pktbuf_reverse_snips__success(void)
     TEST_ASSERT(gnrc_pktbuf_is_empty());
 }
 
+static void test_pktbuf_netstats_get(void)
+{
+    netstats_pktbuf_t stats;
+    gnrc_pktsnip_t *pkt;
+#ifndef MODULE_GNRC_PKTBUF_MALLOC   /* heap layout is unknown to gnrc_pktbuf_malloc */
+    uint32_t largest_free;
+#endif
+
+    gnrc_pktbuf_netstats_get(&stats);
+    TEST_ASSERT_EQUAL_INT(0, stats.used);
+#ifndef MODULE_GNRC_PKTBUF_MALLOC
+    TEST_ASSERT(stats.largest_free > 0);
+    largest_free = stats.largest_free;
+#endif
+    TEST_ASSERT_NOT_NULL((pkt = gnrc_pktbuf_add(NULL, TEST_STRING16,
+                                                sizeof(TEST_STRING16),
+                                                GNRC_NETTYPE_TEST)));
+    gnrc_pktbuf_netstats_get(&stats);
+    TEST_ASSERT(stats.used >= sizeof(TEST_STRING16) + sizeof(gnrc_pktsnip_t));
+#ifndef MODULE_GNRC_PKTBUF_MALLOC
+    TEST_ASSERT(stats.largest_free <= largest_free);
+    TEST_ASSERT(stats.holes > 0);
+#endif
+#ifdef MODULE_NETSTATS_PKTBUF
+    TEST_ASSERT(stats.high_water >= stats.used);
+#endif
+    gnrc_pktbuf_release(pkt);
+    gnrc_pktbuf_netstats_get(&stats);
+    TEST_ASSERT_EQUAL_INT(0, stats.used);
+}
+
 Test *tests_pktbuf_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -866,10 +921,15 @@ Test *tests_pktbuf_tests(void)
 #ifndef MODULE_GNRC_PKTBUF_MALLOC
         new_TestFixture(test_pktbuf_add__memfull),
 #endif
+#ifndef MODULE_GNRC_PKTBUF_SLAB
         new_TestFixture(test_pktbuf_add__success),
+#endif
         new_TestFixture(test_pktbuf_add__packed_struct),
-#ifndef MODULE_GNRC_PKTBUF_MALLOC
+#if !defined(MODULE_GNRC_PKTBUF_MALLOC) && !defined(MODULE_GNRC_PKTBUF_SLAB)
         new_TestFixture(test_pktbuf_add__unaligned_in_aligned_hole),
+#endif
+#ifdef MODULE_GNRC_PKTBUF_SLAB
+        new_TestFixture(test_pktbuf_add__slab_class_exhausted),
 #endif
         new_TestFixture(test_pktbuf_add__0_sized_release),
         new_TestFixture(test_pktbuf_mark__pkt_NULL__size_0),
@@ -892,7 +952,7 @@ Test *tests_pktbuf_tests(void)
         new_TestFixture(test_pktbuf_realloc_data__success),
         new_TestFixture(test_pktbuf_realloc_data__success2),
         new_TestFixture(test_pktbuf_realloc_data__success3),
-#ifndef MODULE_GNRC_PKTBUF_MALLOC
+#if !defined(MODULE_GNRC_PKTBUF_MALLOC) && !defined(MODULE_GNRC_PKTBUF_SLAB)
         new_TestFixture(test_pktbuf_merge_data__memfull),
 #endif /* MODULE_GNRC_PKTBUF_MALLOC */
         new_TestFixture(test_pktbuf_merge_data__success1),
@@ -906,10 +966,11 @@ Test *tests_pktbuf_tests(void)
         new_TestFixture(test_pktbuf_start_write__NULL),
         new_TestFixture(test_pktbuf_start_write__pkt_users_1),
         new_TestFixture(test_pktbuf_start_write__pkt_users_2),
-#ifndef MODULE_GNRC_PKTBUF_MALLOC
+#if !defined(MODULE_GNRC_PKTBUF_MALLOC) && !defined(MODULE_GNRC_PKTBUF_SLAB)
         new_TestFixture(test_pktbuf_reverse_snips__too_full),
 #endif /* MODULE_GNRC_PKTBUF_MALLOC */
         new_TestFixture(test_pktbuf_reverse_snips__success),
+        new_TestFixture(test_pktbuf_netstats_get),
     };
 
     EMB_UNIT_TESTCALLER(gnrc_pktbuf_tests, set_up, NULL, fixtures);
@@ -156,6 +156,41 @@ static void test_sixlowpan_ctx_lookup_addr__other_addr_other_prefix(void)
     TEST_ASSERT_NULL(gnrc_sixlowpan_ctx_lookup_addr(&addr));
 }
 
+static void test_sixlowpan_ctx_lookup_addr__longest_prefix(void)
+{
+    ipv6_addr_t addr = DEFAULT_TEST_PREFIX;
+    gnrc_sixlowpan_ctx_t *ctx;
+
+    /* add context DEFAULT_TEST_PREFIX to DEFAULT_TEST_ID */
+    test_sixlowpan_ctx_update__success();
+    TEST_ASSERT_NOT_NULL(gnrc_sixlowpan_ctx_update(OTHER_TEST_ID, &addr, 32,
+                                                   TEST_UINT16, true));
+    TEST_ASSERT_NOT_NULL((ctx = gnrc_sixlowpan_ctx_lookup_addr(&addr)));
+    TEST_ASSERT_EQUAL_INT(DEFAULT_TEST_ID,
+                          ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK);
+    /* make OTHER_TEST_ID the longer prefix */
+    TEST_ASSERT_NOT_NULL(gnrc_sixlowpan_ctx_update(OTHER_TEST_ID, &addr, 64,
+                                                   TEST_UINT16, true));
+    TEST_ASSERT_NOT_NULL((ctx = gnrc_sixlowpan_ctx_lookup_addr(&addr)));
+    TEST_ASSERT_EQUAL_INT(OTHER_TEST_ID,
+                          ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK);
+}
+
+static void test_sixlowpan_ctx_lookup_addr__update_after_miss(void)
+{
+    ipv6_addr_t addr = WRONG_TEST_PREFIX;
+    gnrc_sixlowpan_ctx_t *ctx;
+
+    /* add context DEFAULT_TEST_PREFIX to DEFAULT_TEST_ID */
+    test_sixlowpan_ctx_update__success();
+    TEST_ASSERT_NULL(gnrc_sixlowpan_ctx_lookup_addr(&addr));
+    TEST_ASSERT_NOT_NULL(gnrc_sixlowpan_ctx_update(OTHER_TEST_ID, &addr, 64,
+                                                   TEST_UINT16, true));
+    TEST_ASSERT_NOT_NULL((ctx = gnrc_sixlowpan_ctx_lookup_addr(&addr)));
+    TEST_ASSERT_EQUAL_INT(OTHER_TEST_ID,
+                          ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK);
+}
+
 static void test_sixlowpan_ctx_lookup_id__empty(void)
 {
     TEST_ASSERT_NULL(gnrc_sixlowpan_ctx_lookup_id(DEFAULT_TEST_ID));
@@ -195,6 +230,25 @@ static void test_sixlowpan_ctx_remove(void)
     TEST_ASSERT_NULL(gnrc_sixlowpan_ctx_lookup_addr(&addr));
 }
 
+static void test_sixlowpan_ctx_lookup_addr__invalidated(void)
+{
+    ipv6_addr_t addr = DEFAULT_TEST_PREFIX;
+    gnrc_sixlowpan_ctx_t *ctx;
+
+    /* add context DEFAULT_TEST_PREFIX to DEFAULT_TEST_ID */
+    test_sixlowpan_ctx_update__success();
+    TEST_ASSERT_NOT_NULL((ctx = gnrc_sixlowpan_ctx_update(OTHER_TEST_ID, &addr,
+                                                          32, TEST_UINT16,
+                                                          true)));
+    TEST_ASSERT_NOT_NULL(gnrc_sixlowpan_ctx_lookup_addr(&addr));
+    /* invalidate the longer context without removing it */
+    gnrc_sixlowpan_ctx_lookup_id(DEFAULT_TEST_ID)->prefix_len = 0;
+    TEST_ASSERT((ctx == gnrc_sixlowpan_ctx_lookup_addr(&addr)));
+    ctx->prefix_len = 0;
+    addr.u8[0] ^= 0xff;
+    TEST_ASSERT_NULL(gnrc_sixlowpan_ctx_lookup_addr(&addr));
+}
+
 Test *tests_sixlowpan_ctx_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -207,6 +261,9 @@ Test *tests_sixlowpan_ctx_tests(void)
         new_TestFixture(test_sixlowpan_ctx_lookup_addr__same_addr),
         new_TestFixture(test_sixlowpan_ctx_lookup_addr__other_addr_same_prefix),
         new_TestFixture(test_sixlowpan_ctx_lookup_addr__other_addr_other_prefix),
+        new_TestFixture(test_sixlowpan_ctx_lookup_addr__longest_prefix),
+        new_TestFixture(test_sixlowpan_ctx_lookup_addr__update_after_miss),
+        new_TestFixture(test_sixlowpan_ctx_lookup_addr__invalidated),
         new_TestFixture(test_sixlowpan_ctx_lookup_id__empty),
         new_TestFixture(test_sixlowpan_ctx_lookup_id__wrong_id),
         new_TestFixture(test_sixlowpan_ctx_lookup_id__success),
@@ -0,0 +1,243 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <errno.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "net/sixlowpan/ghc.h"
+
+#include "tests-sixlowpan_ghc.h"
+
+#define TEST_SRC    { { 0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, \
+                        0x02, 0x12, 0x4b, 0x00, 0x06, 0x13, 0x0e, 0x8a } }
+#define TEST_DST    { { 0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, \
+                        0x02, 0x12, 0x4b, 0x00, 0x06, 0x13, 0x0f, 0x01 } }
+
+static const ipv6_addr_t _src = TEST_SRC;
+static const ipv6_addr_t _dst = TEST_DST;
+static uint8_t _dict[SIXLOWPAN_GHC_DICT_LEN];
+static uint8_t _buf[128];
+
+static void set_up(void)
+{
+    sixlowpan_ghc_dict_init(_dict, &_src, &_dst);
+    memset(_buf, 0xff, sizeof(_buf));
+}
+
+static void test_sixlowpan_ghc_dict_init(void)
+{
+    static const uint8_t static_dict[] = {
+        0x16, 0xfe, 0xfd, 0x17, 0xfe, 0xfd, 0x00, 0x01,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00,
+    };
+
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&_dict[0], &_src, sizeof(_src)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&_dict[16], &_dst, sizeof(_dst)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&_dict[32], static_dict,
+                                    sizeof(static_dict)));
+}
+
+static void test_sixlowpan_ghc_nhc_is(void)
+{
+    TEST_ASSERT(sixlowpan_ghc_nhc_is(SIXLOWPAN_GHC_NHC_UDP));
+    TEST_ASSERT(sixlowpan_ghc_nhc_is(SIXLOWPAN_GHC_NHC_ICMPV6));
+    TEST_ASSERT(!sixlowpan_ghc_nhc_is(0xf0));   /* UDP NHC */
+    TEST_ASSERT(!sixlowpan_ghc_nhc_is(0xe0));   /* extension header NHC */
+}
+
+static void test_sixlowpan_ghc_decompress_literal(void)
+{
+    static const uint8_t in[] = { 0x03, 'a', 'b', 'c' };
+
+    TEST_ASSERT_EQUAL_INT(3, sixlowpan_ghc_decompress(_buf, sizeof(_buf), in,
+                                                      sizeof(in), _dict));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_buf, "abc", 3));
+}
+
+static void test_sixlowpan_ghc_decompress_zeros(void)
+{
+    static const uint8_t in[] = { 0x01, 0x2a, 0x82, 0x8f };
+    static const uint8_t exp[22] = { 0x2a };
+
+    TEST_ASSERT_EQUAL_INT(sizeof(exp),
+                          sixlowpan_ghc_decompress(_buf, sizeof(_buf), in,
+                                                   sizeof(in), _dict));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_buf, exp, sizeof(exp)));
+}
+
+static void test_sixlowpan_ghc_decompress_backref_dict(void)
+{
+    /* copy the destination address (16 bytes, 32 bytes back from the end of
+     * the dictionary): n = 8 + 6 + 2, s = 16 + 0 + n */
+    static const uint8_t in[] = { 0xb2, 0xf0 };
+
+    TEST_ASSERT_EQUAL_INT(sizeof(_dst),
+                          sixlowpan_ghc_decompress(_buf, sizeof(_buf), in,
+                                                   sizeof(in), _dict));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_buf, &_dst, sizeof(_dst)));
+}
+
+static void test_sixlowpan_ghc_decompress_backref_data(void)
+{
+    /* "ab" followed by three backreferences to the preceding two bytes:
+     * n = 0 + 0 + 2, s = 0 + 0 + n */
+    static const uint8_t in[] = { 0x02, 'a', 'b', 0xc0, 0xc0, 0xc0 };
+
+    TEST_ASSERT_EQUAL_INT(8, sixlowpan_ghc_decompress(_buf, sizeof(_buf), in,
+                                                      sizeof(in), _dict));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_buf, "abababab", 8));
+}
+
+static void test_sixlowpan_ghc_decompress_stop(void)
+{
+    static const uint8_t in[] = { 0x01, 'x', SIXLOWPAN_GHC_STOP, 0x01, 'y' };
+
+    TEST_ASSERT_EQUAL_INT(1, sixlowpan_ghc_decompress(_buf, sizeof(_buf), in,
+                                                      sizeof(in), _dict));
+    TEST_ASSERT_EQUAL_INT('x', _buf[0]);
+}
+
+static void test_sixlowpan_ghc_decompress_length_only(void)
+{
+    static const uint8_t in[] = { 0x02, 'a', 'b', 0x8f, 0xb2, 0xf0 };
+
+    TEST_ASSERT_EQUAL_INT(2 + 17 + 16,
+                          sixlowpan_ghc_decompress(NULL, 0, in, sizeof(in),
+                                                   _dict));
+}
+
+static void test_sixlowpan_ghc_decompress_reserved(void)
+{
+    static const uint8_t in1[] = { 0x60 };
+    static const uint8_t in2[] = { 0x91 };
+
+    TEST_ASSERT_EQUAL_INT(-EINVAL,
+                          sixlowpan_ghc_decompress(_buf, sizeof(_buf), in1,
+                                                   sizeof(in1), _dict));
+    TEST_ASSERT_EQUAL_INT(-EINVAL,
+                          sixlowpan_ghc_decompress(_buf, sizeof(_buf), in2,
+                                                   sizeof(in2), _dict));
+}
+
+static void test_sixlowpan_ghc_decompress_malformed(void)
+{
+    /* truncated literal */
+    static const uint8_t in1[] = { 0x05, 'a' };
+    /* extension byte without backreference */
+    static const uint8_t in2[] = { 0x01, 'a', 0xa1 };
+    /* backreference before start of dictionary */
+    static const uint8_t in3[] = { 0xaf, 0xc0 };
+
+    TEST_ASSERT_EQUAL_INT(-EINVAL,
+                          sixlowpan_ghc_decompress(_buf, sizeof(_buf), in1,
+                                                   sizeof(in1), _dict));
+    TEST_ASSERT_EQUAL_INT(-EINVAL,
+                          sixlowpan_ghc_decompress(_buf, sizeof(_buf), in2,
+                                                   sizeof(in2), _dict));
+    TEST_ASSERT_EQUAL_INT(-EINVAL,
+                          sixlowpan_ghc_decompress(_buf, sizeof(_buf), in3,
+                                                   sizeof(in3), _dict));
+}
+
+static void test_sixlowpan_ghc_decompress_enobufs(void)
+{
+    static const uint8_t in[] = { 0x03, 'a', 'b', 'c', 0x82, 0xb2, 0xf0 };
+
+    TEST_ASSERT_EQUAL_INT(-ENOBUFS,
+                          sixlowpan_ghc_decompress(_buf, 2, in, sizeof(in),
+                                                   _dict));
+    TEST_ASSERT_EQUAL_INT(-ENOBUFS,
+                          sixlowpan_ghc_decompress(_buf, 5, in, sizeof(in),
+                                                   _dict));
+    TEST_ASSERT_EQUAL_INT(-ENOBUFS,
+                          sixlowpan_ghc_decompress(_buf, 20, in, sizeof(in),
+                                                   _dict));
+}
+
+static void test_sixlowpan_ghc_compress_roundtrip(void)
+{
+    /* ICMPv6 echo request with payload that repeats parts of the addresses */
+    static const uint8_t in[] = {
+        0x80, 0x00, 0x3b, 0x1c, 0x00, 0x2a, 0x00, 0x01,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x02, 0x12, 0x4b, 0x00, 0x06, 0x13, 0x0f, 0x01,
+        0xde, 0xad, 0xbe, 0xef, 0xde, 0xad, 0xbe, 0xef,
+        0xde, 0xad, 0xbe, 0xef, 0x00, 0x00, 0x00, 0x00,
+    };
+    uint8_t out[sizeof(in)];
+    int res;
+
+    res = sixlowpan_ghc_compress(_buf, sizeof(_buf), in, sizeof(in), _dict);
+    TEST_ASSERT(res > 0);
+    TEST_ASSERT(res < (int)sizeof(in));
+    TEST_ASSERT_EQUAL_INT(sizeof(in),
+                          sixlowpan_ghc_decompress(out, sizeof(out), _buf, res,
+                                                   _dict));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(out, in, sizeof(in)));
+}
+
+static void test_sixlowpan_ghc_compress_incompressible(void)
+{
+    static const uint8_t in[] = { 0x11, 0x22, 0x33, 0x44, 0x55 };
+    uint8_t out[sizeof(in)];
+
+    /* one literal bytecode */
+    TEST_ASSERT_EQUAL_INT(sizeof(in) + 1,
+                          sixlowpan_ghc_compress(_buf, sizeof(_buf), in,
+                                                 sizeof(in), _dict));
+    TEST_ASSERT_EQUAL_INT(sizeof(in),
+                          sixlowpan_ghc_decompress(out, sizeof(out), _buf,
+                                                   sizeof(in) + 1, _dict));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(out, in, sizeof(in)));
+}
+
+static void test_sixlowpan_ghc_compress_enobufs(void)
+{
+    static const uint8_t in[] = { 0x11, 0x22, 0x33, 0x44, 0x55 };
+
+    TEST_ASSERT_EQUAL_INT(-ENOBUFS,
+                          sixlowpan_ghc_compress(_buf, sizeof(in), in,
+                                                 sizeof(in), _dict));
+}
+
+Test *tests_sixlowpan_ghc_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_sixlowpan_ghc_dict_init),
+        new_TestFixture(test_sixlowpan_ghc_nhc_is),
+        new_TestFixture(test_sixlowpan_ghc_decompress_literal),
+        new_TestFixture(test_sixlowpan_ghc_decompress_zeros),
+        new_TestFixture(test_sixlowpan_ghc_decompress_backref_dict),
+        new_TestFixture(test_sixlowpan_ghc_decompress_backref_data),
+        new_TestFixture(test_sixlowpan_ghc_decompress_stop),
+        new_TestFixture(test_sixlowpan_ghc_decompress_length_only),
+        new_TestFixture(test_sixlowpan_ghc_decompress_reserved),
+        new_TestFixture(test_sixlowpan_ghc_decompress_malformed),
+        new_TestFixture(test_sixlowpan_ghc_decompress_enobufs),
+        new_TestFixture(test_sixlowpan_ghc_compress_roundtrip),
+        new_TestFixture(test_sixlowpan_ghc_compress_incompressible),
+        new_TestFixture(test_sixlowpan_ghc_compress_enobufs),
+    };
+
+    EMB_UNIT_TESTCALLER(sixlowpan_ghc_tests, set_up, NULL, fixtures);
+
+    return (Test *)&sixlowpan_ghc_tests;
+}
+
+void tests_sixlowpan_ghc(void)
+{
+    TESTS_RUN(tests_sixlowpan_ghc_tests());
+}
+/** @} */
@@ -0,0 +1,37 @@
+/*
+ * Copyright (C) 2019 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @addtogroup  unittests
+ * @{
+ *
+ * @file
+ * @brief       Unittests for the ``sixlowpan_ghc`` module
+ *
+ * @author      Martine Lenders <m.lenders@fu-berlin.de>
+ */
+#ifndef TESTS_SIXLOWPAN_GHC_H
+#define TESTS_SIXLOWPAN_GHC_H
+
+#include "embUnit.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   The entry point of this test suite.
+ */
+void tests_sixlowpan_ghc(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TESTS_SIXLOWPAN_GHC_H */
+/** @} */